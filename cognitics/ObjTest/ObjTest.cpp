@@ -43,6 +43,7 @@ int main(int argc, char **argv)
     logger << ccl::LINFO;
     GDALAllRegister();
     ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
+    ccl::Log::instance()->setLevel(ccl::LINFO);
     //std::string rootCDBOutput = "E:/TestData/output/cdbRefactored2";
     //std::string objRootDir = "E:/TestData/MUTC_50m_OBJ";
     //std::string rootCDBOutput = "j:/output/pinehurst_cdb";
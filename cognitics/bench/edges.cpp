@@ -0,0 +1,179 @@
+#include <sfa/EdgeIntersector.h>
+#include <sfa/EdgeNode.h>
+#include <sfa/Point.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Intersects synthetic edge sets with sfa::EdgeIntersector as GeometryGraph does: a random
+// walk "coastline" cut into edges of 64 segments against a lattice of square "footprints",
+// and the coastline against itself (the self test). Half the segments are coastline and half
+// footprints, at the same density for every size, from 1e3 segments up by 10x. Up to a limit
+// the brute force loops the sweep replaced run on a second copy, and the split points of
+// every edge must match.
+//
+//   bench-edges [max segments] [brute force max segments]
+
+namespace
+{
+    template <typename F>
+    double Milliseconds(F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    class BruteForceIntersector : public sfa::EdgeIntersector
+    {
+    public:
+        BruteForceIntersector(const sfa::EdgeNodeList& A, const sfa::EdgeNodeList& B, bool selfTest)
+        {
+            for(int ea = 0; ea < int(A.size()); ++ea)
+            {
+                for(int eb = (selfTest ? ea : 0); eb < int(B.size()); ++eb)
+                {
+                    for(int i = 0; i < A[ea]->getNumPoints() - 1; ++i)
+                    {
+                        for(int j = 0; j < B[eb]->getNumPoints() - 1; ++j)
+                            addIntersection(A[ea], i, B[eb], j);
+                    }
+                }
+            }
+        }
+    };
+
+    struct EdgeSets
+    {
+        sfa::EdgeNodeList coastline;
+        sfa::EdgeNodeList footprints;
+
+        ~EdgeSets()
+        {
+            for(auto edge : coastline)
+                delete edge;
+            for(auto edge : footprints)
+                delete edge;
+        }
+    };
+
+    // The same segments for the same count, so the sweep and brute force runs get equal input.
+    void Build(int segments, EdgeSets& sets)
+    {
+        double side = std::sqrt(double(segments));
+        std::mt19937 random(12345);
+        std::uniform_real_distribution<double> turn(-0.6, 0.6);
+
+        int coastline_segments = segments / 2;
+        double x = side * 0.5;
+        double y = side * 0.5;
+        double heading = 0.3;
+        sfa::EdgeNode* edge = nullptr;
+        for(int i = 0; i < coastline_segments; ++i)
+        {
+            if(!edge || (edge->getNumPoints() > 64))
+            {
+                edge = new sfa::EdgeNode(sfa::Label(), sfa::Label(), sfa::Label(), 0);
+                edge->addPoint(sfa::Point(x, y));
+                sets.coastline.push_back(edge);
+            }
+            heading += turn(random);
+            double nx = x + std::cos(heading);
+            double ny = y + std::sin(heading);
+            if((nx < 0) || (nx > side) || (ny < 0) || (ny > side))
+            {
+                heading += 3.14159265358979;
+                nx = x + std::cos(heading);
+                ny = y + std::sin(heading);
+            }
+            x = nx;
+            y = ny;
+            edge->addPoint(sfa::Point(x, y));
+        }
+
+        int count = std::max<int>(1, (segments - coastline_segments) / 4);
+        int per_row = int(std::ceil(std::sqrt(double(count))));
+        double spacing = side / per_row;
+        double size = spacing * 0.6;
+        for(int i = 0; i < count; ++i)
+        {
+            double fx = (i % per_row) * spacing + spacing * 0.2;
+            double fy = (i / per_row) * spacing + spacing * 0.2;
+            sfa::EdgeNode* ring = new sfa::EdgeNode(sfa::Label(), sfa::Label(), sfa::Label(), 1);
+            ring->addPoint(sfa::Point(fx, fy));
+            ring->addPoint(sfa::Point(fx + size, fy));
+            ring->addPoint(sfa::Point(fx + size, fy + size));
+            ring->addPoint(sfa::Point(fx, fy + size));
+            ring->addPoint(sfa::Point(fx, fy));
+            sets.footprints.push_back(ring);
+        }
+    }
+
+    // Splits every edge at its intersections (once; split() adds children on every call) and
+    // appends the start of each piece and whether the edge is isolated.
+    size_t Split(const sfa::EdgeNodeList& edges, std::vector<double>& points)
+    {
+        size_t splits = 0;
+        for(auto edge : edges)
+        {
+            auto children = edge->split();
+            for(auto child : children)
+            {
+                points.push_back(child->getStartPoint()->getPoint()->X());
+                points.push_back(child->getStartPoint()->getPoint()->Y());
+            }
+            points.push_back(edge->isIsolated() ? 1 : 0);
+            splits += children.size() - 1;
+        }
+        return splits;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int max_segments = (argc > 1) ? std::max<int>(atoi(argv[1]), 1000) : 1000000;
+    int brute_max_segments = (argc > 2) ? atoi(argv[2]) : 10000;
+
+    printf("bench-edges: up to %d segments, brute force up to %d\n", max_segments, brute_max_segments);
+    printf("%-10s %-10s %12s %12s %10s %s\n", "segments", "test", "sweep ms", "brute ms", "splits", "result");
+    bool all_match = true;
+    for(int segments = 1000; segments <= max_segments; segments *= 10)
+    {
+        for(int self = 0; self < 2; ++self)
+        {
+            const char* test = self ? "self" : "footprints";
+            EdgeSets sweep;
+            Build(segments, sweep);
+            auto& sweep_b = self ? sweep.coastline : sweep.footprints;
+            auto sweep_ms = Milliseconds([&]() { sfa::EdgeIntersector(sweep.coastline, sweep_b, self != 0); });
+
+            auto sweep_points = std::vector<double>();
+            size_t splits = Split(sweep.coastline, sweep_points);
+            if(!self)
+                splits += Split(sweep.footprints, sweep_points);
+            if(segments > brute_max_segments)
+            {
+                printf("%-10d %-10s %12.1f %12s %10zu\n", segments, test, sweep_ms, "-", splits);
+                continue;
+            }
+            EdgeSets brute;
+            Build(segments, brute);
+            auto& brute_b = self ? brute.coastline : brute.footprints;
+            auto brute_ms = Milliseconds([&]() { BruteForceIntersector(brute.coastline, brute_b, self != 0); });
+
+            auto brute_points = std::vector<double>();
+            Split(brute.coastline, brute_points);
+            if(!self)
+                Split(brute.footprints, brute_points);
+            bool match = (sweep_points == brute_points);
+            all_match = all_match && match;
+            printf("%-10d %-10s %12.1f %12.1f %10zu %s\n", segments, test, sweep_ms, brute_ms, splits, match ? "match" : "MISMATCH");
+        }
+    }
+    return all_match ? 0 : 1;
+}
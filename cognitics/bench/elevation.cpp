@@ -0,0 +1,136 @@
+#include <ccl/gdal.h>
+#include <cdb_util/cdb_util.h>
+#include <elev/Elevation_DSM.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Samples CDB elevation tiles from a synthetic 1-degree GeoTIFF through Elevation_DSM,
+// once per post with Get(sfa::Point *) as the tile builders used to and once with the
+// batch GetGrid() that BuildElevationTileFloatsFromSampler2 uses now. Both paths use a
+// fresh sampler and data source manager so neither starts with a warm block cache; the
+// results must match post for post.
+//
+//   bench-elevation [lod] [source size] [tif path]
+
+namespace
+{
+    template <typename F>
+    double Milliseconds(F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Report(const char* name, double ms, size_t posts)
+    {
+        printf("%-20s %10.1f ms  %7.2f Mposts/s\n", name, ms, posts / (ms * 1000.0));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int lod = (argc > 1) ? std::min<int>(std::max<int>(atoi(argv[1]), 0), 6) : 2;
+    int source_size = (argc > 2) ? std::max<int>(atoi(argv[2]), 16) : 4096;
+    std::string filename = (argc > 3) ? argv[3] : "bench-elevation.tif";
+
+    cognitics::gdal::init(argv[0]);
+
+    auto info = cognitics::cdb::RasterInfo();
+    info.Width = source_size;
+    info.Height = source_size;
+    info.North = 33.0;
+    info.South = 32.0;
+    info.West = -118.0;
+    info.East = -117.0;
+    info.PixelSizeX = (info.East - info.West) / source_size;
+    info.PixelSizeY = (info.South - info.North) / source_size;
+    info.OriginX = info.West + (0.5 * info.PixelSizeX);
+    info.OriginY = info.North + (0.5 * info.PixelSizeY);
+    auto source = std::vector<float>(size_t(source_size) * source_size);
+    for(int y = 0; y < source_size; ++y)
+    {
+        for(int x = 0; x < source_size; ++x)
+            source[size_t(y) * source_size + x] = float(200.0 + 150.0 * std::sin(x * 0.01) * std::cos(y * 0.013) + ((x * y) % 7));
+    }
+    if(!cognitics::cdb::WriteFloatsToTIF(filename, info, source))
+    {
+        printf("unable to write %s\n", filename.c_str());
+        return 1;
+    }
+
+    // every tile of the geocell at lod
+    auto tiles = std::vector<cognitics::cdb::TileInfo>();
+    int rows = cognitics::cdb::RowsForLOD(lod);
+    for(int uref = 0; uref < rows; ++uref)
+    {
+        for(int rref = 0; rref < rows; ++rref)
+        {
+            auto tileinfo = cognitics::cdb::TileInfo();
+            tileinfo.latitude = 32;
+            tileinfo.longitude = -118;
+            tileinfo.dataset = 1;
+            tileinfo.selector1 = 1;
+            tileinfo.selector2 = 1;
+            tileinfo.lod = lod;
+            tileinfo.uref = uref;
+            tileinfo.rref = rref;
+            tiles.push_back(tileinfo);
+        }
+    }
+    int dim = cognitics::cdb::TileDimensionForLod(lod);
+    size_t posts = tiles.size() * size_t(dim) * dim;
+    printf("bench-elevation: %dx%d source, LOD %d, %d tiles of %dx%d\n", source_size, source_size, lod, int(tiles.size()), dim, dim);
+
+    auto per_point = std::vector<float>(posts, -32767.0f);
+    auto batch = std::vector<float>(posts, -32767.0f);
+    auto sample = [&](std::vector<float>& result, bool batched) {
+        elev::DataSourceManager dsm(256 * 1024 * 1024);
+        dsm.AddFile_Raster_GDAL(filename);
+        dsm.generateBSP();
+        elev::Elevation_DSM sampler(&dsm, elev::ELEVATION_BILINEAR);
+        for(size_t t = 0; t < tiles.size(); ++t)
+        {
+            auto zs = &result[t * dim * dim];
+            double north, south, east, west;
+            std::tie(north, south, east, west) = cognitics::cdb::NSEWBoundsForTileInfo(tiles[t]);
+            double spacing_x = (east - west) / dim;
+            double spacing_y = (north - south) / dim;
+            if(batched)
+            {
+                sampler.GetGrid(west, south, spacing_x, spacing_y, dim, dim, zs);
+                continue;
+            }
+            for(int row = 0; row < dim; ++row)
+            {
+                for(int col = 0; col < dim; ++col)
+                {
+                    sfa::Point p(west + (col * spacing_x), south + (row * spacing_y));
+                    if(sampler.Get(&p))
+                        zs[(row * dim) + col] = float(p.Z());
+                }
+            }
+        }
+    };
+    auto per_point_ms = Milliseconds([&]() { sample(per_point, false); });
+    auto batch_ms = Milliseconds([&]() { sample(batch, true); });
+
+    size_t mismatches = 0;
+    for(size_t i = 0; i < posts; ++i)
+    {
+        if(per_point[i] != batch[i])
+            ++mismatches;
+    }
+
+    Report("Get(sfa::Point *)", per_point_ms, posts);
+    Report("GetGrid", batch_ms, posts);
+    printf("speedup %.1fx, %zu of %zu posts differ\n", per_point_ms / batch_ms, mismatches, posts);
+    std::remove(filename.c_str());
+    return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include <ctl/ctl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Triangulates synthetic 30 m terrain grids with the post counts of LOD 0 and up, once with
+// ctl::GridTIN as TerrainGenerator::triangulateTerrain does without constraints and once by
+// shuffled insertion into a ctl::DelaunayTriangulation, the path it used before and still
+// takes when constraint edges are cut in. The CDT above 257x257 posts takes minutes; limit
+// it with the last argument.
+//
+//   bench-gridtin [max lod] [tolerance] [cdt max lod]
+
+namespace
+{
+    template <typename F>
+    double Milliseconds(F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    ctl::TIN* TriangulateCDT(const ctl::GridTIN& grid, const ctl::PointList& gamingArea, double tolerance)
+    {
+        ctl::PointList boundaryPoints;
+        ctl::PointList workingPoints;
+        int rows = grid.getNumRows();
+        int cols = grid.getNumColumns();
+        for(int row = 0; row < rows; ++row)
+        {
+            for(int col = 0; col < cols; ++col)
+            {
+                bool boundary = (row == 0) || (col == 0) || (row == rows - 1) || (col == cols - 1);
+                (boundary ? boundaryPoints : workingPoints).push_back(grid.getPoint(row, col));
+            }
+        }
+        ctl::DelaunayTriangulation dt(gamingArea, std::max(100, (rows * cols) / 8));
+        std::random_shuffle(boundaryPoints.begin(), boundaryPoints.end());
+        std::random_shuffle(workingPoints.begin(), workingPoints.end());
+        size_t i = 0;
+        size_t j = 0;
+        while(i < boundaryPoints.size() || j < workingPoints.size())
+        {
+            if(i < boundaryPoints.size())
+                dt.InsertConstrainedPoint(boundaryPoints[i++]);
+            if(j < workingPoints.size())
+                dt.InsertWorkingPoint(workingPoints[j++]);
+        }
+        if(tolerance > 0)
+            dt.Simplify(1, float(tolerance));
+        return new ctl::TIN(&dt);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int max_lod = (argc > 1) ? std::min<int>(std::max<int>(atoi(argv[1]), 0), 6) : 6;
+    double tolerance = (argc > 2) ? atof(argv[2]) : 0.05;
+    int cdt_max_lod = (argc > 3) ? atoi(argv[3]) : 3;
+
+    printf("bench-gridtin: tolerance %g, CDT up to LOD %d\n", tolerance, cdt_max_lod);
+    printf("%-4s %-10s %10s %10s %12s %10s\n", "lod", "posts", "grid ms", "grid tris", "CDT ms", "CDT tris");
+    for(int lod = 0; lod <= max_lod; ++lod)
+    {
+        int posts = (8 << lod) + 1;
+        auto xs = std::vector<double>(posts);
+        auto ys = std::vector<double>(posts);
+        auto zs = std::vector<double>(size_t(posts) * posts);
+        for(int i = 0; i < posts; ++i)
+        {
+            xs[i] = i * 30.0;
+            ys[i] = i * 30.0;
+        }
+        for(int row = 0; row < posts; ++row)
+        {
+            for(int col = 0; col < posts; ++col)
+                zs[size_t(row) * posts + col] = 100.0 + 40.0 * std::sin(col * 0.05) * std::cos(row * 0.07) + ((row < posts / 2) ? 0.0 : 0.02 * col);
+        }
+        auto grid = ctl::GridTIN(xs, ys, zs);
+
+        ctl::TIN grid_tin;
+        auto grid_ms = Milliseconds([&]() { grid.Triangulate(grid_tin, tolerance); });
+        printf("%-4d %4dx%-5d %10.1f %10zu", lod, posts, posts, grid_ms, grid_tin.triangles.size() / 3);
+
+        if(lod > cdt_max_lod)
+        {
+            printf(" %12s %10s\n", "-", "-");
+            continue;
+        }
+        ctl::PointList gamingArea;
+        gamingArea.push_back(grid.getPoint(0, 0));
+        gamingArea.push_back(grid.getPoint(0, posts - 1));
+        gamingArea.push_back(grid.getPoint(posts - 1, posts - 1));
+        gamingArea.push_back(grid.getPoint(posts - 1, 0));
+        ctl::TIN* cdt_tin = nullptr;
+        auto cdt_ms = Milliseconds([&]() { cdt_tin = TriangulateCDT(grid, gamingArea, tolerance); });
+        printf(" %12.1f %10zu\n", cdt_ms, cdt_tin->triangles.size() / 3);
+        delete cdt_tin;
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <ccl/gdal.h>
+#include <cdb_util/cdb_util.h>
+#include <sfa/Feature.h>
+#include <sfa/LineString.h>
+#include <sfa/Point.h>
+#include <sfa/Polygon.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Injects a synthetic polygon layer over 2x2 geocells into two scratch CDBs through
+// CDBInjector::InjectFeatures, once with every feature binned in memory and once with a
+// small feature_limit so the bins are spilled to disk and merged back per tile. Some of the
+// polygons straddle tile and geocell edges, so both runs clip. Every tile shapefile must
+// hold the same features in the same order in both CDBs.
+//
+//   bench-inject [features] [feature limit] [work path]
+
+namespace
+{
+    template <typename F>
+    double Milliseconds(F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    sfa::Feature* MakeFeature(int id, double x, double y, double size)
+    {
+        auto ring = new sfa::LineString;
+        ring->addPoint(sfa::Point(x, y));
+        ring->addPoint(sfa::Point(x, y + size));
+        ring->addPoint(sfa::Point(x + size, y + size));
+        ring->addPoint(sfa::Point(x + size, y));
+        ring->addPoint(sfa::Point(x, y));
+        auto polygon = new sfa::Polygon;
+        polygon->addRing(ring);
+        auto feature = new sfa::Feature;
+        feature->geometry = polygon;
+        feature->setAttribute("ID", id);
+        return feature;
+    }
+
+    bool Inject(const std::string& cdb, const std::string& source, size_t feature_limit)
+    {
+        auto injector = cognitics::cdb::CDBInjector();
+        injector.cdb = cdb;
+        injector.dataset = 100;
+        injector.feature_limit = feature_limit;
+        return injector.InjectFeatures(source);
+    }
+
+    std::vector<std::string> TileFiles(const std::string& cdb)
+    {
+        auto result = std::vector<std::string>();
+        std::error_code ec;
+        for(auto it = std::filesystem::recursive_directory_iterator(cdb + "/Tiles", ec); !ec && (it != std::filesystem::recursive_directory_iterator()); it.increment(ec))
+        {
+            if(it->path().extension() == ".shp")
+                result.push_back(std::filesystem::relative(it->path(), cdb).generic_string());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int count = (argc > 1) ? std::max<int>(atoi(argv[1]), 1) : 100000;
+    size_t feature_limit = (argc > 2) ? std::max<int>(atoi(argv[2]), 1) : 10000;
+    std::string path = (argc > 3) ? argv[3] : "bench-inject";
+
+    cognitics::gdal::init(argv[0]);
+
+    std::error_code ec;
+    std::filesystem::remove_all(path, ec);
+    std::filesystem::create_directories(path, ec);
+    auto source = path + "/source.shp";
+    auto features = std::vector<sfa::Feature*>();
+    int side = int(std::ceil(std::sqrt(double(count))));
+    double step = 2.0 / side;
+    for(int i = 0; i < count; ++i)
+    {
+        // a square lattice over lat 32-34, lon -118 to -116; every 50th polygon is large
+        double x = -118.0 + step * (i % side);
+        double y = 32.0 + step * (i / side);
+        features.push_back(MakeFeature(i, x, y, (i % 50 == 0) ? 0.3 : step * 0.5));
+    }
+    bool written = cognitics::cdb::WriteFeaturesToOGRFile(source, features);
+    for(auto feature : features)
+        delete feature;
+    if(!written)
+    {
+        printf("unable to write %s\n", source.c_str());
+        return 1;
+    }
+
+    auto memory_cdb = path + "/memory";
+    auto spill_cdb = path + "/spill";
+    bool memory_ok = false;
+    bool spill_ok = false;
+    auto memory_ms = Milliseconds([&]() { memory_ok = Inject(memory_cdb, source, 0); });
+    auto spill_ms = Milliseconds([&]() { spill_ok = Inject(spill_cdb, source, feature_limit); });
+    printf("bench-inject: %d features, feature limit %zu\n", count, feature_limit);
+    printf("%-20s %10.1f ms%s\n", "in memory", memory_ms, memory_ok ? "" : "  (failed)");
+    printf("%-20s %10.1f ms%s\n", "spilled", spill_ms, spill_ok ? "" : "  (failed)");
+
+    auto memory_tiles = TileFiles(memory_cdb);
+    auto spill_tiles = TileFiles(spill_cdb);
+    size_t mismatches = 0;
+    size_t compared = 0;
+    if(memory_tiles != spill_tiles)
+    {
+        printf("tile files differ: %zu in memory, %zu spilled\n", memory_tiles.size(), spill_tiles.size());
+        ++mismatches;
+    }
+    for(auto& tile : memory_tiles)
+    {
+        if(!std::binary_search(spill_tiles.begin(), spill_tiles.end(), tile))
+            continue;
+        auto a = cognitics::cdb::FeaturesForOGRFile(memory_cdb + "/" + tile);
+        auto b = cognitics::cdb::FeaturesForOGRFile(spill_cdb + "/" + tile);
+        if(a.size() != b.size())
+        {
+            printf("%s: %zu features in memory, %zu spilled\n", tile.c_str(), a.size(), b.size());
+            ++mismatches;
+        }
+        for(size_t i = 0, c = std::min(a.size(), b.size()); i < c; ++i)
+        {
+            ++compared;
+            bool same = (a[i]->attributes.getAttributeAsInt("ID") == b[i]->attributes.getAttributeAsInt("ID"));
+            if(same && a[i]->geometry && b[i]->geometry)
+                same = (a[i]->geometry->asText() == b[i]->geometry->asText());
+            if(!same)
+                ++mismatches;
+        }
+        for(auto feature : a)
+            delete feature;
+        for(auto feature : b)
+            delete feature;
+    }
+    printf("%zu tiles, %zu features compared, %zu mismatches\n", memory_tiles.size(), compared, mismatches);
+    std::filesystem::remove_all(path, ec);
+    return (memory_ok && spill_ok && (mismatches == 0)) ? 0 : 1;
+}
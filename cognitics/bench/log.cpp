@@ -0,0 +1,74 @@
+#include <ccl/LogStream.h>
+#include <ccl/ObjLog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Cost of ccl::ObjLog statements with a LogStream attached at LINFO: a disabled LDEBUG
+// statement written with plain << and with CCL_LOG, and an enabled LINFO statement for
+// reference. Output goes to a stream that is discarded. Pass a thread count to run the
+// same loops on several threads sharing one ObjLog.
+//
+//   bench-log [iterations] [threads]
+
+namespace
+{
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+    };
+
+    template <typename F>
+    double NanosecondsPerStatement(int iterations, int threads, F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto workers = std::vector<std::thread>();
+        for(int t = 0; t < threads; ++t)
+            workers.emplace_back([&]() { func(iterations); });
+        for(auto& worker : workers)
+            worker.join();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / (double(iterations) * threads);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::max<int>(atoi(argv[1]), 1) : 10000000;
+    int threads = (argc > 2) ? std::max<int>(atoi(argv[2]), 1) : 1;
+
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LINFO, null_stream)));
+
+    ccl::ObjLog log;
+    log.init("bench", nullptr);
+    volatile double value = 2.5;
+
+    auto plain = NanosecondsPerStatement(iterations, threads, [&](int n) {
+        for(int i = 0; i < n; ++i)
+            log << ccl::LDEBUG << "v " << i << " x " << value << log.endl;
+    });
+    auto gated = NanosecondsPerStatement(iterations, threads, [&](int n) {
+        for(int i = 0; i < n; ++i)
+            CCL_LOG(log, ccl::LDEBUG) << "v " << i << " x " << value << log.endl;
+    });
+    int enabled_iterations = std::max<int>(iterations / 100, 1);
+    auto enabled = NanosecondsPerStatement(enabled_iterations, threads, [&](int n) {
+        for(int i = 0; i < n; ++i)
+            log << ccl::LINFO << "v " << i << " x " << value << log.endl;
+    });
+
+    printf("bench-log: %d iterations, %d thread(s), observer at info\n", iterations, threads);
+    printf("%-32s %8.2f ns\n", "disabled debug, <<", plain);
+    printf("%-32s %8.2f ns\n", "disabled debug, CCL_LOG", gated);
+    printf("%-32s %8.2f ns\n", "enabled info, <<", enabled);
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <ip/PyramidReduce.h>
+#include <ip/WarpPerspective.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Builds every parent tile of one geocell pyramid above a given LOD from four 1024x1024
+// children, once with the 2:1 reductions cdb_lod uses for aligned children and once with
+// the warps GDALRasterSampler runs for each child file (cubic for imagery, the bilinear
+// composite for elevation). Only the pixel work is timed: the sampler path also pays for
+// opening and reading every child through GDAL, so the real difference is larger.
+//
+//   bench-reduce [child lod] [iterations]
+
+namespace
+{
+    const int dim = 1024;
+    const int half = dim / 2;
+    const float nodata = -32767.0f;
+
+    template <typename F>
+    double Milliseconds(int iterations, F func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; ++i)
+            func();
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / iterations;
+    }
+
+    // Places child (qx, qy) of a 2x2 block in its quadrant of the parent.
+    void QuadrantTransform(int qx, int qy, double coeffs[3][3])
+    {
+        double x0 = qx * half;
+        double y0 = qy * half;
+        double x1 = x0 + (half - 0.5);
+        double y1 = y0 + (half - 0.5);
+        double quad[4][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+        ip::GetPerspectiveTransform(dim, dim, quad, coeffs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int child_lod = (argc > 1) ? std::min<int>(std::max<int>(atoi(argv[1]), 1), 6) : 3;
+    int iterations = (argc > 2) ? std::max<int>(atoi(argv[2]), 1) : 1;
+
+    // One tile's worth of children stands in for every child in the geocell.
+    auto rgb = std::vector<unsigned char>(size_t(dim) * dim * 3);
+    auto floats = std::vector<float>(size_t(dim) * dim);
+    for(int y = 0; y < dim; ++y)
+    {
+        for(int x = 0; x < dim; ++x)
+        {
+            auto i = size_t(y) * dim + x;
+            rgb[i * 3 + 0] = (unsigned char)(1 + ((x * 7 + y * 3) % 255));
+            rgb[i * 3 + 1] = (unsigned char)(1 + (((x ^ y) * 5) % 255));
+            rgb[i * 3 + 2] = (unsigned char)(((x / 16 + y / 16) & 1) ? 250 : 5);
+            floats[i] = 100.0f + 0.25f * x - 0.125f * y + ((x * y) % 17);
+        }
+    }
+
+    int parents = 0;
+    for(int lod = 0; lod < child_lod; ++lod)
+        parents += 1 << (2 * lod);
+
+    double coeffs[4][3][3];
+    for(int q = 0; q < 4; ++q)
+        QuadrantTransform(q % 2, q / 2, coeffs[q]);
+
+    auto rgb_out = std::vector<unsigned char>(size_t(dim) * dim * 3);
+    auto float_out = std::vector<float>(size_t(dim) * dim);
+    auto filled = std::vector<unsigned char>(size_t(dim) * dim);
+
+    printf("bench-reduce: geocell pyramid from LOD %d, %d parent tiles, %d iterations\n", child_lod, parents, iterations);
+    printf("reduce ISA %s, warp ISA %s\n", ip::Reduce2x2ISA(), ip::WarpPerspectiveISA());
+
+    auto reduce_rgb = Milliseconds(iterations, [&]() {
+        for(int p = 0; p < parents; ++p)
+        {
+            for(int q = 0; q < 4; ++q)
+            {
+                size_t offset = ((size_t(q / 2) * half * dim) + (q % 2) * half) * 3;
+                ip::Reduce2x2_8u_C3(rgb.data(), dim * 3, &rgb_out[offset], half, half, dim * 3);
+            }
+        }
+    });
+    auto warp_rgb = Milliseconds(iterations, [&]() {
+        for(int p = 0; p < parents; ++p)
+        {
+            for(int q = 0; q < 4; ++q)
+                ip::WarpPerspective_8u_C3(rgb.data(), dim, dim, dim * 3, rgb_out.data(), dim, dim, dim * 3, coeffs[q], ip::WARP_CUBIC);
+        }
+    });
+    auto reduce_float = Milliseconds(iterations, [&]() {
+        for(int p = 0; p < parents; ++p)
+        {
+            for(int q = 0; q < 4; ++q)
+            {
+                size_t offset = (size_t(q / 2) * half * dim) + (q % 2) * half;
+                ip::Reduce2x2Mean_32f_C1(floats.data(), dim * sizeof(float), &float_out[offset], half, half, dim * sizeof(float), nodata);
+            }
+        }
+    });
+    auto warp_float = Milliseconds(iterations, [&]() {
+        for(int p = 0; p < parents; ++p)
+        {
+            std::fill(filled.begin(), filled.end(), 0);
+            for(int q = 0; q < 4; ++q)
+                ip::WarpComposite_32f_C1(floats.data(), dim, dim, dim * sizeof(float), float_out.data(), dim, dim, dim * sizeof(float), filled.data(), dim, coeffs[q], nodata);
+        }
+    });
+
+    printf("%-24s %10.1f ms  %7.2f ms/tile\n", "imagery reduce 2x2", reduce_rgb, reduce_rgb / parents);
+    printf("%-24s %10.1f ms  %7.2f ms/tile\n", "imagery sampler warp", warp_rgb, warp_rgb / parents);
+    printf("%-24s %10.1f ms  %7.2f ms/tile\n", "elevation reduce 2x2", reduce_float, reduce_float / parents);
+    printf("%-24s %10.1f ms  %7.2f ms/tile\n", "elevation sampler warp", warp_float, warp_float / parents);
+    printf("speedup: imagery %.1fx, elevation %.1fx\n", warp_rgb / reduce_rgb, warp_float / reduce_float);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <ip/WarpPerspective.h>
+
+#ifndef COG_NO_IPP
+#include "ipp.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Times ip::WarpPerspective against the IPP warps GDALRasterSampler uses, on a synthetic
+// source tile warped into a 1024x1024 destination with a mild perspective. Run it again
+// with COG_WARP_ISA=scalar (or sse4.1) to compare the kernel tiers; the checksums printed
+// for the native warps must match between tiers for bilinear and cubic 8u C3.
+//
+//   bench-warp [iterations]
+
+#ifndef COG_NO_IPP
+// Defined in GDALRasterSampler.cpp; the sampler calls these once per source file.
+IppStatus WarpPerspective_8u_C3R(Ipp8u *pSrc, IppiSize srcSize, Ipp32s srcStep, Ipp8u *pDst, IppiSize dstSize, Ipp32s dstStep, const double coeffs[3][3], IppiInterpolationType interpolation);
+IppStatus WarpPerspective_32f_C1R(Ipp32f *pSrc, IppiSize srcSize, Ipp32s srcStep, Ipp32f *pDst, IppiSize dstSize, Ipp32s dstStep, const double coeffs[3][3], IppiInterpolationType interpolation);
+#endif
+
+namespace
+{
+    const int src_width = 1100;
+    const int src_height = 1100;
+    const int dst_width = 1024;
+    const int dst_height = 1024;
+
+    template <typename F>
+    double MillisecondsPerCall(int iterations, F func)
+    {
+        func();
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; ++i)
+            func();
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / iterations;
+    }
+
+    template <typename T>
+    unsigned long long Checksum(const std::vector<T>& buffer)
+    {
+        unsigned long long sum = 1469598103934665603ULL;
+        auto bytes = (const unsigned char*)buffer.data();
+        for(size_t i = 0, c = buffer.size() * sizeof(T); i < c; ++i)
+            sum = (sum ^ bytes[i]) * 1099511628211ULL;
+        return sum;
+    }
+
+    void Report(const std::string& name, double ms, unsigned long long checksum)
+    {
+        printf("%-28s %9.3f ms  %6.1f Mpix/s  %016llx\n", name.c_str(), ms, (dst_width * dst_height) / (ms * 1000.0), checksum);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = (argc > 1) ? std::max<int>(atoi(argv[1]), 1) : 20;
+
+    auto rgb = std::vector<unsigned char>(src_width * src_height * 3);
+    auto floats = std::vector<float>(src_width * src_height);
+    for(int y = 0; y < src_height; ++y)
+    {
+        for(int x = 0; x < src_width; ++x)
+        {
+            auto i = y * src_width + x;
+            rgb[i * 3 + 0] = (unsigned char)(x * 7 + y * 3);
+            rgb[i * 3 + 1] = (unsigned char)((x ^ y) * 5);
+            rgb[i * 3 + 2] = (unsigned char)(((x / 16 + y / 16) & 1) ? 250 : 5);
+            floats[i] = 100.0f + 0.25f * x - 0.125f * y + ((x * y) % 17);
+        }
+    }
+
+    // ul, ur, lr, ll of the source in destination pixels; slightly larger than the destination
+    // so every destination pixel is written, as for a source that covers the whole tile
+    double quad[4][2] = { { -20.0, -30.0 }, { 1050.0, -10.0 }, { 1060.0, 1045.0 }, { -35.0, 1030.0 } };
+    double coeffs[3][3];
+    if(!ip::GetPerspectiveTransform(src_width, src_height, quad, coeffs))
+    {
+        printf("GetPerspectiveTransform failed\n");
+        return 1;
+    }
+
+    printf("bench-warp: %dx%d -> %dx%d, %d iterations, native ISA %s\n", src_width, src_height, dst_width, dst_height, iterations, ip::WarpPerspectiveISA());
+
+    auto rgb_out = std::vector<unsigned char>(dst_width * dst_height * 3);
+    auto float_out = std::vector<float>(dst_width * dst_height);
+    const char* names[] = { "nearest", "linear", "cubic" };
+    const ip::WarpInterpolation native_modes[] = { ip::WARP_NEAREST, ip::WARP_LINEAR, ip::WARP_CUBIC };
+    for(int m = 0; m < 3; ++m)
+    {
+        auto ms = MillisecondsPerCall(iterations, [&]() {
+            ip::WarpPerspective_8u_C3(rgb.data(), src_width, src_height, src_width * 3, rgb_out.data(), dst_width, dst_height, dst_width * 3, coeffs, native_modes[m]);
+        });
+        Report(std::string("native 8u C3 ") + names[m], ms, Checksum(rgb_out));
+    }
+    for(int m = 0; m < 3; ++m)
+    {
+        auto ms = MillisecondsPerCall(iterations, [&]() {
+            ip::WarpPerspective_32f_C1(floats.data(), src_width, src_height, src_width * 4, float_out.data(), dst_width, dst_height, dst_width * 4, coeffs, native_modes[m]);
+        });
+        Report(std::string("native 32f C1 ") + names[m], ms, Checksum(float_out));
+    }
+    {
+        auto filled = std::vector<unsigned char>(dst_width * dst_height);
+        auto ms = MillisecondsPerCall(iterations, [&]() {
+            std::fill(filled.begin(), filled.end(), 0);
+            ip::WarpComposite_32f_C1(floats.data(), src_width, src_height, src_width * 4, float_out.data(), dst_width, dst_height, dst_width * 4, filled.data(), dst_width, coeffs, -32767.0f);
+        });
+        Report("native 32f C1 composite", ms, Checksum(float_out));
+    }
+
+#ifndef COG_NO_IPP
+    const IppiInterpolationType ipp_modes[] = { ippNearest, ippLinear, ippCubic };
+    IppiSize src_size = { src_width, src_height };
+    IppiSize dst_size = { dst_width, dst_height };
+    for(int m = 0; m < 3; ++m)
+    {
+        auto ms = MillisecondsPerCall(iterations, [&]() {
+            WarpPerspective_8u_C3R(rgb.data(), src_size, src_width * 3, rgb_out.data(), dst_size, dst_width * 3, coeffs, ipp_modes[m]);
+        });
+        Report(std::string("ipp 8u C3 ") + names[m], ms, Checksum(rgb_out));
+    }
+    for(int m = 0; m < 3; ++m)
+    {
+        auto ms = MillisecondsPerCall(iterations, [&]() {
+            WarpPerspective_32f_C1R(floats.data(), src_size, src_width * 4, float_out.data(), dst_size, dst_width * 4, coeffs, ipp_modes[m]);
+        });
+        Report(std::string("ipp 32f C1 ") + names[m], ms, Checksum(float_out));
+    }
+#else
+    printf("IPP not compiled in (COG_USE_IPP=OFF); native warps only\n");
+#endif
+    return 0;
+}
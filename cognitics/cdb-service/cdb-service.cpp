@@ -6,17 +6,21 @@
 #include <ccl/ArgumentParser.h>
 
 #include <cstdlib>
+#include <iostream>
 #include <fstream>
 #include <chrono>
 
 int main(int argc, char** argv)
 {
-    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
-
     auto args = cognitics::ArgumentParser();
-    args.AddOption("logfile", 1, "<filename>", "filename for log output");
+    args.AddOption("logfile", 1, "<filename>", "filename for debug log output");
+    args.AddOption("loglevel", 1, "<level>", "most verbose level logged: emerg ... debug (default: info, debug with -logfile)");
     args.AddOption("bind", 1, "<bind string>", "bind string (port or ip:port)");
     args.AddOption("cdb", 1, "<cdbpath>", "path to CDB");
+    args.AddOption("threads", 1, "<N>", "number of request threads (default: 16)");
+    args.AddOption("cache-mb", 1, "<N>", "megabytes of GetMap responses to keep in memory (default: 256, 0 to disable)");
+    args.AddOption("cache-dir", 1, "<path>", "directory for an on-disk GetMap response cache");
+    args.AddOption("block-cache-mb", 1, "<N>", "megabytes of decoded source blocks kept between requests (default: 512)");
     if(args.Parse(argc, argv) == EXIT_FAILURE)
         return EXIT_FAILURE;
 
@@ -27,12 +31,30 @@ int main(int argc, char** argv)
         logfile.open(logfn.c_str(), std::ios::out);
         ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, logfile)));
     }
+    // Without -loglevel, the logfile gets debug output and the console stays at info.
+    bool debug_to_logfile = logfile.is_open() && !args.Option("loglevel");
+    ccl::LOGLEVEL loglevel = debug_to_logfile ? ccl::LDEBUG : ccl::LINFO;
+    if(args.Option("loglevel") && !ccl::Log::parseLevel(args.Parameters("loglevel").at(0), loglevel))
+    {
+        std::cerr << "invalid log level: " << args.Parameters("loglevel").at(0) << "\n";
+        return EXIT_FAILURE;
+    }
+    ccl::Log::instance()->setLevel(loglevel);
+    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(debug_to_logfile ? ccl::LINFO : ccl::LDEBUG)));
 
     auto params = cognitics::cdb::cdb_service_parameters();
     if(args.Option("cdb"))
         params.cdb = args.Parameters("cdb").at(0);
     if(args.Option("bind"))
         params.bind = args.Parameters("bind").at(0);
+    if(args.Option("threads"))
+        params.threads = std::stoi(args.Parameters("threads").at(0));
+    if(args.Option("cache-mb"))
+        params.cache_megabytes = std::stoul(args.Parameters("cache-mb").at(0));
+    if(args.Option("cache-dir"))
+        params.cache_dir = args.Parameters("cache-dir").at(0);
+    if(args.Option("block-cache-mb"))
+        params.block_cache_megabytes = std::stoul(args.Parameters("block-cache-mb").at(0));
 
     ccl::ObjLog log;
     log << args.Report() << log.endl;
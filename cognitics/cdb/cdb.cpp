@@ -36,6 +36,7 @@ void cout_global_options()
 {
     std::cout << "    Options:\n";
     std::cout << "        -logfile <filename>    logfile for debug output\n";
+    std::cout << "        -loglevel <level>      most verbose level logged: emerg ... debug (default: info, debug with -logfile)\n";
 }
 
 int usage(const std::string& error = "")
@@ -67,6 +68,13 @@ int usage_inject(const std::string& error = "")
     std::cout << "        -workers <#>             number of worker threads (default: 8)\n";
     std::cout << "        -insert                  insert target tile data (GS/GT point features only)\n";
     std::cout << "        -previous-cdb <path>     path to previous version CDB\n";
+    std::cout << "        -pipeline                decode/warp/encode raster tiles on separate thread pools\n";
+    std::cout << "        -decode-workers <#>      pipeline source decode threads (default: 2)\n";
+    std::cout << "        -encode-workers <#>      pipeline tile encode threads (default: 4)\n";
+    std::cout << "        -cache-mb <#>            pipeline shared block cache budget in MB (default: 1024)\n";
+    std::cout << "        -minmax                  also write MinMaxElevation from each Elevation 001 001 tile\n";
+    std::cout << "        -source-catalog <file>   source raster metadata cache (default: <cdbpath>/.source_catalog)\n";
+    std::cout << "        -feature-limit <#>       vector features held in memory before spilling to disk (default: 4000000, 0 for no limit)\n";
     std::cout << "    Supported Components (dataset cs1 cs2):\n";
     std::cout << "        Imagery 001 001\n";
     std::cout << "        Imagery 003 001-012\n";
@@ -121,6 +129,8 @@ int usage_build(const std::string& error = "")
         std::cerr << "\nERROR: " << error << "\n\n";
     std::cout << "Usage: " << args[0] << " [options] <cdbpath> BUILD [command_options] <dataset> <cs1> <cs2>\n";
     cout_global_options();
+    std::cout << "    Command Options:\n";
+    std::cout << "        -workers <#>           number of worker threads (default: 8)\n";
     std::cout << "    Supported Components (dataset cs1 cs2):\n";
     std::cout << "        MinMaxElevation 001\n";
     return error.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -134,6 +144,8 @@ int usage_lod(const std::string& error = "")
     cout_global_options();
     std::cout << "    Command Options:\n";
     std::cout << "        -workers <#>           number of worker threads (default: 8)\n";
+    std::cout << "        -minmax <#>            also write MinMaxElevation for rebuilt Elevation 001 001 tiles\n";
+    std::cout << "                               at least this many LODs above the finest elevation (BUILD uses 2)\n";
     std::cout << "    Supported Components:\n";
     std::cout << "        Elevation 001 001\n";
     std::cout << "        Elevation 100 001\n";
@@ -230,6 +242,13 @@ int main_inject(size_t arg_start)
     int cs1 { 0 };
     int cs2 { 0 };
     bool insert = false;
+    bool pipeline = false;
+    bool minmax = false;
+    std::string source_catalog;
+    int decode_workers { 2 };
+    int encode_workers { 4 };
+    int cache_mb { 1024 };
+    int feature_limit { 4000000 };
     auto previous_cdb = std::string();
     auto models = std::string();
     auto textures = std::string();
@@ -268,11 +287,61 @@ int main_inject(size_t arg_start)
             workers = to_int(args[argi], 8);
             continue;
         }
+        if(args[argi] == "-feature-limit")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_inject("Missing feature limit");
+            feature_limit = std::max<int>(to_int(args[argi], 4000000), 0);
+            continue;
+        }
         if(args[argi] == "-insert")
         {
             insert = true;
             continue;
         }
+        if(args[argi] == "-pipeline")
+        {
+            pipeline = true;
+            continue;
+        }
+        if(args[argi] == "-minmax")
+        {
+            minmax = true;
+            continue;
+        }
+        if(args[argi] == "-source-catalog")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_inject("Missing source catalog filename");
+            source_catalog = args[argi];
+            continue;
+        }
+        if(args[argi] == "-decode-workers")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_inject("Missing decode thread count");
+            decode_workers = to_int(args[argi], 2);
+            continue;
+        }
+        if(args[argi] == "-encode-workers")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_inject("Missing encode thread count");
+            encode_workers = to_int(args[argi], 4);
+            continue;
+        }
+        if(args[argi] == "-cache-mb")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_inject("Missing block cache size");
+            cache_mb = to_int(args[argi], 1024);
+            continue;
+        }
         if(args[argi] == "-previous-cdb")
         {
             ++argi;
@@ -335,6 +404,12 @@ int main_inject(size_t arg_start)
     params.west = west;
     params.cs1 = cs1;
     params.cs2 = cs2;
+    params.pipeline = pipeline;
+    params.minmax = minmax;
+    params.source_catalog = source_catalog;
+    params.decode_workers = decode_workers;
+    params.encode_workers = encode_workers;
+    params.block_cache_megabytes = size_t(std::max<int>(cache_mb, 1));
     if(lod == 24)
         lod = 0;
 
@@ -346,8 +421,10 @@ int main_inject(size_t arg_start)
     injector.cs2 = cs2;
     injector.lod = lod;
     injector.insert = insert;
+    injector.workers = workers;
     injector.models_path = models;
     injector.textures_path = textures;
+    injector.feature_limit = size_t(feature_limit);
 
     if(insert && (dataset != 100) && (dataset != 101))
         return usage_inject("Insert not supported for component: " + cognitics::cdb::DatasetName(dataset) + " " + std::to_string(cs1) + " " + std::to_string(cs2));
@@ -466,11 +543,20 @@ int main_build(size_t arg_start)
     double south { -DBL_MAX };
     double east { DBL_MAX };
     double west { -DBL_MAX };
+    int workers { 8 };
     int dataset { 0 };
     int cs1 { 0 };
     int cs2 { 0 };
     for(size_t argi = arg_start, argc = args.size(); argi < argc; ++argi)
     {
+        if(args[argi] == "-workers")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_build("Missing worker thread count");
+            workers = to_int(args[argi], 8);
+            continue;
+        }
         if(dataset == 0)
         {
             dataset = to_int(args[argi], 0);
@@ -497,7 +583,7 @@ int main_build(size_t arg_start)
     }
     if((dataset == 2) && (cs1 == 1))    // MinMaxElevation
     {
-        cognitics::cdb::BuildMinMaxElevation(cdb, 2);
+        cognitics::cdb::BuildMinMaxElevation(cdb, 2, workers);
         return EXIT_SUCCESS;
     }
     else
@@ -510,6 +596,7 @@ int main_build(size_t arg_start)
 int main_lod(size_t arg_start)
 {
     int workers { 8 };
+    int minmax_lod_offset { -1 };
     int dataset { 0 };
     int cs1 { 0 };
     int cs2 { 0 };
@@ -523,6 +610,14 @@ int main_lod(size_t arg_start)
             workers = to_int(args[argi], 8);
             continue;
         }
+        if(args[argi] == "-minmax")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_lod("Missing MinMaxElevation LOD offset");
+            minmax_lod_offset = to_int(args[argi], -1);
+            continue;
+        }
         if(dataset == 0)
         {
             dataset = to_int(args[argi], 0);
@@ -554,7 +649,7 @@ int main_lod(size_t arg_start)
         }
     }
     if((dataset == 1) && (cs1 == 1) && (cs2 == 1))  // Elevation, PrimaryTerrainElevation
-        return cognitics::cdb::cdb_lod(cdb, dataset, cs1, cs2, workers) ? EXIT_SUCCESS : EXIT_FAILURE;
+        return cognitics::cdb::cdb_lod(cdb, dataset, cs1, cs2, workers, minmax_lod_offset) ? EXIT_SUCCESS : EXIT_FAILURE;
     if((dataset == 1) && (cs1 == 100) && (cs2 == 1))  // Elevation, SubordinateBathymetry
         return cognitics::cdb::cdb_lod(cdb, dataset, cs1, cs2, workers) ? EXIT_SUCCESS : EXIT_FAILURE;
     else if((dataset == 4) && (cs1 == 1) && (cs2 == 1))  // Imagery, YearlyVstiRepresentation
@@ -1024,7 +1119,8 @@ int main(int argc, char** argv)
 
     std::ofstream logfile;
     int result { EXIT_FAILURE };
-    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
+    bool loglevel_set { false };
+    ccl::Log::instance()->setLevel(ccl::LINFO);
     auto ts_start = std::chrono::steady_clock::now();
     for(int argi = 0; argi < argc; ++argi)
         args.emplace_back(argv[argi]);
@@ -1041,6 +1137,16 @@ int main(int argc, char** argv)
             ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, logfile)));
             continue;
         }
+        if(args[argi] == "-loglevel")
+        {
+            ccl::LOGLEVEL level;
+            if((argi + 1 >= argc) || !ccl::Log::parseLevel(args[argi + 1], level))
+                return usage("Missing or invalid log level");
+            ++argi;
+            ccl::Log::instance()->setLevel(level);
+            loglevel_set = true;
+            continue;
+        }
         if(cdb.empty())
         {
             cdb = args[argi];
@@ -1050,6 +1156,11 @@ int main(int argc, char** argv)
         command_argi = argi + 1;
         break;
     }
+    // Without -loglevel, the logfile gets debug output and the console stays at info.
+    bool debug_to_logfile = logfile.is_open() && !loglevel_set;
+    if(debug_to_logfile)
+        ccl::Log::instance()->setLevel(ccl::LDEBUG);
+    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(debug_to_logfile ? ccl::LINFO : ccl::LDEBUG)));
     if(cdb.empty())
         return usage();
     if(command.empty())
@@ -204,6 +204,7 @@ namespace ccl
     bool copyFile(const std::string &src, const std::string &dest);
     bool copyFilesRecursive(const std::string &srcDir, const std::string &destDir);
 
+    //! Size of the file in bytes, or 0 if it can't be opened.
     uint64_t getFileSize(const std::string &filePath);
     bool deleteFile(const std::string &filename);
 
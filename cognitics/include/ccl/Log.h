@@ -88,10 +88,21 @@ public:
 \section Notes
 
 It is the responsibility of observer implementations to handle filtering by log level.
+Observers report the most verbose level they accept through LogObserver::getLevel(), and ObjLog
+skips formatting messages that no attached observer (or the Log::setLevel() threshold) would accept.
+
+Statements written with CCL_LOG are skipped entirely, operands included, when their level is disabled,
+and are removed at compile time when the level is above CCL_LOG_MAX_LEVEL:
+
+\code
+CCL_LOG(log, ccl::LDEBUG) << "sampled " << count << " posts" << log.endl;
+\endcode
 
 */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <set>
 #include <string>
 #include <memory>
@@ -112,14 +123,14 @@ namespace ccl
 
     //! POSIX log levels
     struct LOGLEVEL { char value; };
-    const struct LOGLEVEL LEMERG    = { 0 };    //!< system is unusable
-    const struct LOGLEVEL LALERT    = { 1 };    //!< action must be taken immediately
-    const struct LOGLEVEL LCRIT        = { 2 };    //!< critical conditions
-    const struct LOGLEVEL LERR        = { 3 };    //!< error conditions
-    const struct LOGLEVEL LWARNING    = { 4 };    //!< warning conditions
-    const struct LOGLEVEL LNOTICE    = { 5 };    //!< normal but significant condition
-    const struct LOGLEVEL LINFO        = { 6 };    //!< informational
-    const struct LOGLEVEL LDEBUG    = { 7 };    //!< debug-level messages
+    constexpr struct LOGLEVEL LEMERG    = { 0 };    //!< system is unusable
+    constexpr struct LOGLEVEL LALERT    = { 1 };    //!< action must be taken immediately
+    constexpr struct LOGLEVEL LCRIT        = { 2 };    //!< critical conditions
+    constexpr struct LOGLEVEL LERR        = { 3 };    //!< error conditions
+    constexpr struct LOGLEVEL LWARNING    = { 4 };    //!< warning conditions
+    constexpr struct LOGLEVEL LNOTICE    = { 5 };    //!< normal but significant condition
+    constexpr struct LOGLEVEL LINFO        = { 6 };    //!< informational
+    constexpr struct LOGLEVEL LDEBUG    = { 7 };    //!< debug-level messages
 
     //! Observer base class for ccl::Log.
     class LogObserver
@@ -130,6 +141,9 @@ namespace ccl
 
         //! Log event handler.
         virtual void write(struct LOGLEVEL level, const std::string &str) = 0;
+
+        //! Most verbose level this observer writes; messages above it are not formatted.
+        virtual struct LOGLEVEL getLevel(void) const { return LDEBUG; }
     };
 
     //! Singleton class for distributing log messages to registered observers.
@@ -137,8 +151,18 @@ namespace ccl
     {
     private:
         static LogSP _instance;
+        static std::atomic<int> _level;            //!< most verbose level any observer accepts, capped by _threshold; -1 with no observers
+        static std::atomic<int> _threshold;        //!< set by setLevel()
         std::set<LogObserverSP> observers;
 
+        void updateLevel(void)
+        {
+            int level = -1;
+            for(std::set<LogObserverSP>::iterator it = observers.begin(), end = observers.end(); it != end; it++)
+                level = std::max<int>(level, (*it)->getLevel().value);
+            _level = std::min<int>(level, _threshold.load());
+        }
+
     protected:
         Log(void) { }
 
@@ -160,17 +184,37 @@ namespace ccl
         void attach(LogObserverSP observer)
         {
             observers.insert(observer);
+            updateLevel();
         }
 
         //! Detach an observer from the log.
         void detach(LogObserverSP observer)
         {
             observers.erase(observers.find(observer));
+            updateLevel();
+        }
+
+        //! Limit logging to level and below, regardless of what observers accept.
+        void setLevel(struct LOGLEVEL level)
+        {
+            _threshold = level.value;
+            updateLevel();
         }
 
-        //! Send a log string to all attached observers.
+        //! True if a message at level would be written by at least one observer.
+        static bool enabled(struct LOGLEVEL level)
+        {
+            return level.value <= _level.load(std::memory_order_relaxed);
+        }
+
+        //! Level for a name ("emerg", "alert", "crit", "err", "warning", "notice", "info", "debug"; "error" and "warn" also work) or a number 0-7.
+        static bool parseLevel(const std::string &name, struct LOGLEVEL &level);
+
+        //! Send a log string to all attached observers, unless level is above the setLevel() threshold.
         void write(struct LOGLEVEL level, const std::string &str)
         {
+            if(level.value > _threshold.load(std::memory_order_relaxed))
+                return;
 #if defined(WIN32) && defined(COG_DEBUG)
             OutputDebugStringA(str.c_str());
             OutputDebugStringA("\n");
@@ -47,6 +47,9 @@ namespace ccl
         /*! This sends the log string to the output stream if the event log level is less than (more critical) than the level property. */
         virtual void write(struct LOGLEVEL level, const std::string &str);
 
+        //! \return The level property.
+        virtual struct LOGLEVEL getLevel(void) const { return level; }
+
     };
 
 
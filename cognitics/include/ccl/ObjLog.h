@@ -30,20 +30,41 @@ DEALINGS IN THE SOFTWARE.
 #include "Log.h"
 #include "LittleEndian.h"
 #include "BigEndian.h"
+#include <atomic>
+#include <ostream>
 #include <sstream>
 #include "mutex.h"
 
+//! Most verbose level compiled into CCL_LOG statements; define lower (e.g. 6 to strip LDEBUG) before including.
+#ifndef CCL_LOG_MAX_LEVEL
+#define CCL_LOG_MAX_LEVEL 7
+#endif
+
+//! Log statement that is skipped, operands included, when the level is disabled.
+/*! Levels above CCL_LOG_MAX_LEVEL compile to nothing.
+\code
+CCL_LOG(log, ccl::LDEBUG) << "value = " << value << log.endl;
+\endcode
+*/
+#define CCL_LOG(log, loglevel) if(!ccl::ObjLog::enabled(loglevel)) ; else (log) << (loglevel)
+
 namespace ccl
 {
     //! Object logging class using ccl::Log.
+    /*! Messages are formatted into a buffer owned by the calling thread, so an ObjLog holds no
+        stream or lock of its own, and nothing is formatted unless an observer will accept the level.
+        The level of a message in progress is kept with that buffer, so threads sharing an ObjLog
+        don't change each other's level mid-message. A level set outside a message becomes the
+        default for later messages that don't set their own.
+    */
     class ObjLog
     {
     protected:
         std::string prefix;            //!< log prefix string
-        std::stringstream str;        //!< internal stream
-        struct LOGLEVEL level;        //!< current stream log level
-        std::string test;            //!< current stream PASS/FAIL status
-        ccl::mutex _mutex;
+        std::atomic<int> level;        //!< level of messages that don't set one
+
+        //! The calling thread's buffer for this log's message in progress, or NULL if its level is disabled.
+        std::ostream *stream(void);
 
     public:
         //! Terminates a log stream.
@@ -52,14 +73,24 @@ namespace ccl
         //! Create an object log stream.
         ObjLog(void);
         ObjLog(const char *name, void *obj = NULL);
+        ObjLog(const ObjLog &other);
+        ObjLog &operator=(const ObjLog &other);
+
+        //! Discards an unterminated message.
+        ~ObjLog(void);
+
+        //! True if messages at level are compiled in and would be written by an observer.
+        static bool enabled(struct LOGLEVEL level)
+        {
+            return (level.value <= CCL_LOG_MAX_LEVEL) && Log::enabled(level);
+        }
 
         //! << template for stream output.
         template<typename T>
         ObjLog &operator<<(const T &t)
         {
-            _mutex.lock();
-            str << t;
-            _mutex.unlock();
+            if(std::ostream *s = stream())
+                *s << t;
             return *this;
         }
 
@@ -72,21 +103,22 @@ namespace ccl
         template<typename T>
         ObjLog &operator<<(ccl::LittleEndian<T> &value)
         {
-            str << T(value);
+            if(std::ostream *s = stream())
+                *s << T(value);
             return *this;
         }
 
         template<typename T>
         ObjLog &operator<<(ccl::BigEndian<T> &value)
         {
-            str << T(value);
+            if(std::ostream *s = stream())
+                *s << T(value);
             return *this;
         }
 
         //! Initialize the object log stream.
         /*! The \c name and \c obj parameters are combined to form the prefix as \c "name[obj]: ", with \c obj as the hex pointer value. */
         void init(const char *name, void *obj = NULL);
-
     };
 
 }
@@ -0,0 +1,146 @@
+
+#pragma once
+
+#include <cdb_util/cdb_util.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace cognitics {
+namespace cdb {
+
+// In-memory record of which tiles exist under a CDB's Tiles/ tree.
+//
+// Each (CDB root, dataset) pair is scanned once, on first use. Tiles are kept
+// per geocell, component selectors and LOD, as a bitset for LODs up to 10 and
+// as a hash of uref/rref above that. The modification time of every leaf (U)
+// directory is recorded so Refresh() only relists directories that changed.
+// Scans run without the index lock held, so lookups are not blocked by a walk;
+// their results are applied under the lock afterwards.
+// Processes that write tiles can save the index to a sidecar under Metadata/
+// so the next process can start from it instead of walking every file; other
+// processes only read it.
+//
+// Roots are normalised (canonical path, no trailing separator), so different
+// spellings of the same CDB share one index.
+class CDBTileIndex
+{
+public:
+    static CDBTileIndex& Instance();
+
+    // True if the tile file exists in this CDB root (previous versions are not searched).
+    bool Exists(const std::string& cdb, const TileInfo& tileinfo);
+
+    // Record a tile written by this process. Ignored if the dataset has not been indexed yet.
+    void Insert(const std::string& cdb, const TileInfo& tileinfo);
+
+    // Relist any leaf directories whose modification time changed since the last scan.
+    // Returns true if anything changed.
+    bool Refresh(const std::string& cdb, int dataset);
+
+    // Refresh() if the dataset is indexed and was last relisted more than
+    // SetRefreshInterval() ago. Cheap enough to call on every request.
+    bool RefreshIfStale(const std::string& cdb, int dataset);
+    void SetRefreshInterval(std::chrono::milliseconds interval);
+
+    // Bumped whenever an index already in use changes (a Refresh that found changes,
+    // Invalidate), so caches built from lookups know when to start over. Inserts since
+    // the last call are counted as a single change.
+    uint64_t Generation();
+
+    // Sidecars are only written for roots marked writable by the tool writing tiles to them.
+    void SetWritable(const std::string& cdb, bool writable = true);
+
+    // Forget everything about a CDB root, including its cached version chain.
+    void Invalidate(const std::string& cdb);
+
+    // VersionChainForCDB(), cached per root.
+    std::vector<std::string> VersionChain(const std::string& cdb);
+
+    size_t TileCount(const std::string& cdb, int dataset);
+
+    // Hash of every leaf directory and its modification time. Writing or removing a tile,
+    // from any process, changes it once the index has seen the directory again.
+    uint64_t Fingerprint(const std::string& cdb, int dataset);
+
+    static std::string SidecarFilename(const std::string& cdb, int dataset);
+
+private:
+    struct LevelKey
+    {
+        int latitude;
+        int longitude;
+        int selector1;
+        int selector2;
+        int lod;
+        bool operator<(const LevelKey& rhs) const;
+    };
+
+    class Level
+    {
+        uint64_t dimension { 1 };
+        std::vector<uint64_t> bits;
+        std::unordered_set<uint64_t> keys;
+    public:
+        explicit Level(int lod = 0);
+        bool Test(int uref, int rref) const;
+        void Set(int uref, int rref);
+        void ClearRow(int uref);
+        size_t Count() const;
+        void Write(std::ostream& os) const;
+        bool Read(std::istream& is);
+    };
+
+    struct DatasetIndex
+    {
+        std::map<LevelKey, Level> levels;
+        std::map<std::string, int64_t> directories;     // leaf directory (relative to Tiles/) -> mtime
+        std::chrono::steady_clock::time_point refreshed;
+    };
+
+    // What a leaf directory holds now, or that it is gone.
+    struct DirectoryScan
+    {
+        std::string reldir;
+        int64_t mtime { 0 };
+        bool removed { false };
+        bool parsed { false };      // reldir named a geocell/LOD/uref directory
+        int latitude { 0 };
+        int longitude { 0 };
+        int lod { 0 };
+        bool lc { false };
+        int uref { 0 };
+        std::vector<TileInfo> tiles;
+    };
+
+    std::mutex mutex;
+    std::mutex save_mutex;
+    std::atomic<uint64_t> generation { 0 };
+    std::atomic<bool> inserted { false };
+    std::chrono::milliseconds refresh_interval { 5000 };
+    std::set<std::string> writable_roots;
+    std::map<std::pair<std::string, int>, std::unique_ptr<DatasetIndex>> indexes;
+    std::map<std::string, std::vector<std::string>> version_chains;
+    std::map<std::string, std::string> roots;       // root as given -> normalised root
+
+    const std::string& RootFor(const std::string& cdb);
+    DatasetIndex& IndexFor(std::unique_lock<std::mutex>& lock, const std::string& cdb, int dataset);
+    bool RefreshIndex(std::unique_lock<std::mutex>& lock, const std::string& cdb, int dataset);
+    static std::vector<DirectoryScan> ScanChanges(const std::string& cdb, int dataset, const std::map<std::string, int64_t>& directories);
+    static bool ScanDirectory(const std::string& cdb, int dataset, const std::string& reldir, DirectoryScan& scan);
+    static void ApplyScans(const std::vector<DirectoryScan>& scans, DatasetIndex& index);
+    bool Load(const std::string& cdb, int dataset, DatasetIndex& index);
+    bool Save(const std::string& cdb, int dataset, const DatasetIndex& index);
+};
+
+}
+}
+
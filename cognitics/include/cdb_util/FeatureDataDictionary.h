@@ -1,44 +1,31 @@
 #pragma once
 
-#include <map>
 #include <string>
-#include <sstream>
 
 namespace cognitics {
 namespace cdb {
 
+// FACC feature codes and the CDB names of their category, subcategory and type.
+//
+// The dictionary is compiled in as sorted constant tables, so there is nothing
+// to construct and every caller shares the same data. The first two letters of
+// a code index the category and subcategory directly; the type is a binary
+// search within its subcategory.
 class FeatureDataDictionary
 {
 public:
-    struct Type
+    // Names are null for the parts of a code that are not in the dictionary.
+    struct Entry
     {
-        int Key;
-        std::string Name;
+        const char* Category { nullptr };
+        const char* Subcategory { nullptr };
+        const char* Type { nullptr };
     };
 
-    struct Subcategory
-    {
-        char Key;
-        std::string Name;
-        std::map<int, Type> Types;
-        void AddType(int key, const std::string& name);
-    };
-
-    struct Category
-    {
-        char Key;
-        std::string Name;
-        std::map<char, Subcategory> Subcategories;
-        void AddSubcategory(char key, const std::string& name);
-    };
-
-    std::map<char, Category> Categories;
-
-    void AddCategory(char key, const std::string& name);
-
-    FeatureDataDictionary();
+    static Entry Lookup(const std::string& facc);
 
-    std::string Subdirectory(const std::string& facc);
+    // GTModel directory for a code, e.g. "A_Culture/L_Misc_Feature/015_Building".
+    static std::string Subdirectory(const std::string& facc);
 
 };
 
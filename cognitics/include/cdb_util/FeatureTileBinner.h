@@ -0,0 +1,56 @@
+
+#pragma once
+
+#include "cdb_util.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace cognitics {
+namespace cdb {
+
+// Assigns features to the tiles of one LOD using tile grid arithmetic.
+//
+// Tiles include their south and west edges, so a point lands in exactly one
+// tile and a line running along a tile edge belongs to the tile north or east
+// of it. A feature that fits in one tile is shared as is; anything crossing
+// tile edges is clipped to each tile with sfa::clipToRectangle. A LineString
+// cut into several pieces becomes one feature per piece so that every tile
+// keeps the geometry type of the source.
+class FeatureTileBinner
+{
+public:
+    typedef std::vector<std::shared_ptr<sfa::Feature>> FeatureList;
+
+    // Bins into every tile of the LOD; the component fields are copied to each TileInfo.
+    FeatureTileBinner(int lod, int dataset, int cs1, int cs2);
+
+    // Bins only into the tiles of the LOD that lie inside parent.
+    FeatureTileBinner(const TileInfo& parent, int lod);
+
+    void Add(const std::shared_ptr<sfa::Feature>& feature);
+
+    std::map<TileInfo, FeatureList>& Bins() { return bins; }
+
+    // Features in all bins, counting each clipped copy.
+    size_t Count() const { return count; }
+
+    // Empties the bins, keeping the tiles they were for.
+    void Clear();
+
+private:
+    TileInfo component;
+    int lod { 0 };
+    bool bounded { false };
+    TileInfo parent;
+    NSEW bounds;
+    std::map<TileInfo, FeatureList> bins;
+    size_t count { 0 };
+
+    bool InParent(const TileInfo& tileinfo) const;
+};
+
+}
+}
+
@@ -0,0 +1,53 @@
+
+#pragma once
+
+#include <cdb_util/cdb_util.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cognitics {
+namespace cdb {
+
+// RasterInfo for source rasters, kept in a text file between runs.
+//
+// A source is opened again only when its size or modification time no longer
+// match the catalog. The rest are read on worker threads, one directory
+// listing per source directory, and the catalog file is rewritten by Save().
+class RasterInfoCatalog
+{
+public:
+    explicit RasterInfoCatalog(const std::string& filename = "");
+
+    const std::string& Filename() const { return filename; }
+
+    // Returns the info for each filename, in the same order.
+    std::vector<RasterInfo> Read(const std::vector<std::string>& filenames, size_t workers = 0);
+
+    bool Save() const;
+
+    size_t Hits() const { return hits; }
+    size_t Misses() const { return misses; }
+
+private:
+    struct Entry
+    {
+        int64_t mtime { 0 };
+        uint64_t size { 0 };
+        RasterInfo info;
+    };
+
+    std::string filename;
+    std::map<std::string, Entry> entries;
+    size_t hits { 0 };
+    size_t misses { 0 };
+    bool dirty { false };
+
+    bool Load();
+};
+
+}
+}
+
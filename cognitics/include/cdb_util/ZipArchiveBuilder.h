@@ -0,0 +1,93 @@
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cognitics {
+namespace cdb {
+
+// Entry names of zip archives, read once per archive.
+//
+// An archive's central directory is reread only when its size or modification
+// time changes, so repeated existence checks against the same D300/D301 zip
+// cost a stat instead of an mz_zip_reader_init_file.
+class ZipDirectoryCache
+{
+public:
+    static ZipDirectoryCache& Instance();
+
+    // True if the archive exists and has an entry with this name.
+    bool Contains(const std::string& zipname, const std::string& filename);
+
+    void Invalidate(const std::string& zipname);
+
+private:
+    struct Directory
+    {
+        int64_t mtime { 0 };
+        uint64_t size { 0 };
+        std::unordered_set<std::string> names;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const Directory>> directories;
+};
+
+// Collects the entries for one zip archive in memory and writes them in a single pass.
+//
+// Entries already in the archive are kept; Add() with a name that is already
+// present (on disk or pending) is ignored. With dedupe set, an entry whose
+// bytes match an existing or pending entry is not stored again and the name
+// of the matching entry is returned instead. Write() compresses the pending
+// entries on worker threads and then appends them all with one central
+// directory rewrite.
+class ZipArchiveBuilder
+{
+public:
+    explicit ZipArchiveBuilder(const std::string& zipname);
+
+    const std::string& Filename() const { return zipname; }
+
+    bool Contains(const std::string& filename) const;
+
+    // Returns the name the bytes are stored under.
+    std::string Add(const std::string& filename, std::string&& bytes, bool dedupe = false);
+
+    size_t PendingCount() const { return pending.size(); }
+
+    // Appends the pending entries; level is a miniz level (MZ_DEFAULT_COMPRESSION = -1).
+    // Compression runs on workers threads, the caller's included; 0 uses one per hardware
+    // thread, which callers that are themselves one of several workers should not ask for.
+    bool Write(int level = -1, size_t workers = 1);
+
+private:
+    struct Entry
+    {
+        std::string filename;
+        std::string bytes;
+        uint32_t crc { 0 };
+        std::string compressed;
+        bool deflated { false };
+    };
+
+    std::string zipname;
+    bool archive_exists { false };
+    std::unordered_set<std::string> names;
+    std::unordered_multimap<uint64_t, std::string> names_by_content;     // (crc, size) -> entry name
+    std::unordered_map<std::string, size_t> pending_index;
+    std::vector<Entry> pending;
+
+    static uint64_t ContentKey(uint32_t crc, uint64_t size);
+    bool SameContent(const std::string& filename, const std::string& bytes) const;
+};
+
+}
+}
+
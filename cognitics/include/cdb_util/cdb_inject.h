@@ -26,6 +26,20 @@ struct cdb_inject_parameters
     bool dry_run { false };
     int cs1 = 1;
     int cs2 = 1;
+
+    // RasterInfo for the sources is cached here between runs; empty uses <cdb>/.source_catalog.
+    std::string source_catalog;
+
+    // Write MinMaxElevation tiles at the same LOD from each PrimaryTerrainElevation tile as it is written.
+    bool minmax { false };
+
+    // Pipelined mode: source blocks are decoded into a process-wide block cache,
+    // each tile is warped from the cache, and tiles are encoded on their own
+    // pool. Tiles are processed in Morton order so neighbours share blocks.
+    bool pipeline { false };
+    int decode_workers { 2 };
+    int encode_workers { 4 };
+    size_t block_cache_megabytes { 1024 };
 };
 
 bool cdb_inject(cdb_inject_parameters& params);
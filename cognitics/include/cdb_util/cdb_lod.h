@@ -7,7 +7,10 @@ namespace cognitics {
 namespace cdb {
 
 bool cdb_lod(const std::string& cdb, int workers);
-bool cdb_lod(const std::string& cdb, int dataset, int cs1, int cs2, int workers);
+
+// With minmax_lod_offset >= 0, rebuilt PrimaryTerrainElevation tiles at least that many LODs
+// above the finest tile under them also write their MinMaxElevation tiles.
+bool cdb_lod(const std::string& cdb, int dataset, int cs1, int cs2, int workers, int minmax_lod_offset = -1);
 
 
 }
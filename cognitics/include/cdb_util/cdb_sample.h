@@ -3,11 +3,41 @@
 
 #include <string>
 #include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <cfloat>
+#include <cstdint>
 
 namespace cognitics {
 namespace cdb {
 
+// Samplers built by cdb_sample_imagery, kept between calls and keyed by CDB, dataset,
+// LOD and the tiles requested, so repeated requests over the same area skip the
+// coverage lookup and reuse the already opened files.
+class CoverageSamplerCache
+{
+public:
+    struct Entry;
+
+    explicit CoverageSamplerCache(size_t capacity = 64) : capacity(capacity) { }
+
+    // Returns the entry for key, creating an empty one if needed.
+    std::shared_ptr<Entry> Get(const std::string& key);
+    void Clear();
+
+    // Clears the cache if the tile index generation changed since the last call.
+    void Validate(uint64_t generation);
+
+private:
+    std::mutex mutex;
+    size_t capacity;
+    uint64_t generation { 0 };
+    std::list<std::string> lru;
+    std::map<std::string, std::pair<std::shared_ptr<Entry>, std::list<std::string>::iterator>> entries;
+};
+
 struct cdb_sample_parameters
 {
     std::string cdb;
@@ -23,7 +53,8 @@ struct cdb_sample_parameters
     int cs2 { 1 };
     int lod { 24 };
     const unsigned char* blue_marble { nullptr };
-    std::vector<unsigned char> population;
+    const std::vector<unsigned char>* population { nullptr };
+    CoverageSamplerCache* samplers { nullptr };
 };
 
 bool cdb_sample(cdb_sample_parameters& params);
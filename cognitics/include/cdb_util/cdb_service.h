@@ -10,6 +10,10 @@ struct cdb_service_parameters
 {
     std::string cdb;
     std::string bind { "8080" };
+    int threads { 16 };                     // civetweb worker threads
+    size_t cache_megabytes { 256 };         // in-memory GetMap response cache (0 disables)
+    std::string cache_dir;                  // optional on-disk GetMap response cache
+    size_t block_cache_megabytes { 512 };   // decoded source blocks shared by all requests
 };
 
 bool cdb_service(cdb_service_parameters& params);
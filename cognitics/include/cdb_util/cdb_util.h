@@ -7,6 +7,8 @@
 #include <elev/DataSourceManager.h>
 #include <elev/Elevation_DSM.h>
 
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace cognitics {
@@ -114,13 +116,18 @@ public:
     int cs2 { 1 };
     int lod { 24 };
     bool insert { false };
+    int workers { 8 };
     std::string models_path;
     std::string textures_path;
+    size_t feature_limit { 4000000 };       // binned features held in memory before they are spilled to disk; 0 for no limit
 
     bool InjectFeatures(const std::string& filename);
     bool InjectFeatures(const std::vector<std::string>& filenames);
 	bool InjectFeatures(const TileInfo& tileinfo, const std::vector<std::string>& filenames);
 	bool InjectFeatures(const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features);
+    bool InjectTiles(const std::map<TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>& tiles, const std::string& spill_path = "");
+    bool SpillTiles(const std::map<TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>& tiles, const std::string& spill_path);
+    bool InjectTile(const TileInfo& tileinfo, const std::vector<std::shared_ptr<sfa::Feature>>& features);
     bool InsertFeatures(const std::string& filename);
     bool InsertFeatures(const std::vector<std::string>& filenames);
 	bool InsertFeatures(const std::vector<sfa::Feature*>& features);
@@ -148,6 +155,9 @@ double MinimumPixelSizeForLod(int lod, double latitude);
 
 TileInfo ParentTileInfo(const TileInfo& tileinfo);
 
+// Z-order key for a tile; sorting by it keeps spatially adjacent tiles together.
+uint64_t MortonCodeForTileInfo(const TileInfo& tileinfo);
+
 std::vector<std::string> FileNamesForTiledDataset(const std::string& cdb, int dataset);
 
 std::vector<TileInfo> FeatureTileInfoForTiledDataset(const std::string& cdb, int dataset, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX) );
@@ -173,7 +183,12 @@ std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const
 bool TextureExists(const std::string& filename);
 
 RasterInfo ReadRasterInfo(const std::string& filename);
+// sibling_files lists the other files in the directory (as for GDALOpenEx) so GDAL doesn't read the directory for every file.
+RasterInfo ReadRasterInfo(const std::string& filename, const char* const* sibling_files);
+std::vector<float> FloatsFromTIF(const std::string& filename);
+std::vector<unsigned char> BytesFromJP2(const std::string& filename);
 bool WriteBytesToJP2(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<unsigned char>& bytes);
+bool WriteBytesToTIF(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<unsigned char>& bytes);
 bool WriteFloatsToTIF(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<float>& floats, bool pixel_is_point = true);
 RasterInfo RasterInfoFromTileInfo(const TileInfo& tileinfo);
 std::vector<unsigned char> FlippedVertically(const std::vector<unsigned char>& bytes, size_t width, size_t height, size_t depth);
@@ -182,11 +197,20 @@ std::vector<float> FlippedVertically(const std::vector<float>& bytes, size_t wid
 bool BuildImageryTileBytesFromSampler(GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<unsigned char>& bytes);
 bool BuildImageryTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo);
 
+// The two halves of BuildImageryTileFromSampler: sample over any existing tile into output row order, then encode.
+bool SampleImageryTile(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<unsigned char>& bytes);
+bool WriteImageryTile(const std::string& cdb, const TileInfo& tileinfo, const std::vector<unsigned char>& bytes);
+
 bool BuildElevationTileFloatsFromSampler(GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<float>& floats);
-bool BuildElevationTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo);
+bool BuildElevationTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, bool minmax = false);
+
+// The two halves of BuildElevationTileFromSampler.
+// With minmax set, a PrimaryTerrainElevation tile also gets its MinMaxElevation tiles, derived from the same floats.
+bool SampleElevationTile(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<float>& floats);
+bool WriteElevationTile(const std::string& cdb, const TileInfo& tileinfo, const std::vector<float>& floats, bool minmax = false);
 
 bool BuildElevationTileFloatsFromSampler2(elev::Elevation_DSM& sampler, const TileInfo& tileinfo, std::vector<float>& floats);
-bool BuildElevationTileFromSampler2(const std::string& cdb, elev::Elevation_DSM& sampler, const TileInfo& tileinfo);
+bool BuildElevationTileFromSampler2(const std::string& cdb, elev::Elevation_DSM& sampler, const TileInfo& tileinfo, bool minmax = false);
 
 bool BuildOverviews(const std::string& cdb, const std::string& component);
 bool BuildImageryOverviews(const std::string& cdb);
@@ -210,7 +234,7 @@ std::vector<sfa::Feature*> FeaturesForTileCroppedFeature(const TileInfo& tile_in
 void ReportMissingGSFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX));
 void ReportMissingGTFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX));
 
-void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features, bool replace, const std::string& source_model_path, const std::string& source_textures_path);
+void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features, bool replace, const std::string& source_model_path, const std::string& source_textures_path, int zip_workers = 1);
 void InjectGTModels(const std::string& cdb, const std::vector<sfa::Feature*>& features, const std::string& source_model_path, const std::string& source_textures_path);
 bool WriteFeaturesToOGRFile(const std::string& filename, const std::vector<sfa::Feature*> features);
 std::vector<sfa::Feature*> FeaturesForTileInfo(const std::string& cdb, const TileInfo& tile_info);
@@ -236,7 +260,14 @@ int TileWidthAtLatitude(double latitude);
 
 std::vector<TileInfo> GenerateTileInfos(int lod, const NSEW& nsew);
 
-void BuildMinMaxElevation(const std::string& cdb, int lod_offset = 4);
+// Per-post minimum and maximum of each elevation post and its east, north and north-east neighbours.
+void MinMaxElevationFromFloats(const std::vector<float>& elevation_floats, int dim, std::vector<float>& min_floats, std::vector<float>& max_floats);
+
+// Writes MinMaxElevation 001 001 (min) and 001 002 (max) at the position and LOD of the elevation tile; floats are in TIF order.
+bool WriteMinMaxElevationTiles(const std::string& cdb, const TileInfo& tileinfo, const std::vector<float>& floats);
+
+// Rebuilds MinMaxElevation from the elevation tiles on disk, lod_offset LODs below each of them.
+void BuildMinMaxElevation(const std::string& cdb, int lod_offset = 4, int workers = 8);
 
 std::map<std::string, std::string> Defaults(const std::string& cdb);
 
@@ -0,0 +1,83 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*!    \file ctl/GridTIN.h
+\headerfile ctl/GridTIN.h
+\brief Provides ctl::GridTIN.
+*/
+#pragma once
+
+#include "TIN.h"
+
+namespace ctl {
+
+/*!    \class ctl::GridTIN ctl/GridTIN.h ctl/GridTIN.h
+ *    \brief Regular Grid TIN Builder
+ *
+ *    Builds a TIN directly from a regular grid of posts, without the point location and edge flipping
+ *    of a DelaunayTriangulation. Posts are addressed by row and column; the x coordinate of a post
+ *    depends only on its column and the y coordinate only on its row, so spacing need not be uniform.
+ *
+ *    With a tolerance of zero every post is kept and each grid cell becomes two triangles.
+ *    With a positive tolerance the grid is decimated by a quadtree: a block of posts is represented by
+ *    its four corners and center as long as no post in the block is further than the tolerance
+ *    (vertically) from that fan. Each block is triangulated as a fan around its center that includes
+ *    any posts its neighbors kept along the shared edges, so the result has no cracks.
+ *
+ *    Boundary posts are only dropped when they are within tolerance, the same as any other post.
+ *    Use a DelaunayTriangulation instead when constraint edges have to be cut into the surface.
+ *
+ *    \code
+ *    GridTIN grid(xs, ys, zs);    // xs.size() columns, ys.size() rows, zs row-major
+ *    TIN tin;
+ *    grid.Triangulate(tin, 0.05);
+ *    \endcode
+ */
+    class GridTIN
+    {
+    public:
+        GridTIN(const std::vector<double>& xs, const std::vector<double>& ys, const std::vector<double>& zs);
+        ~GridTIN(void) { }
+
+        int getNumRows(void) const { return int(ys.size()); }
+        int getNumColumns(void) const { return int(xs.size()); }
+
+        Point getPoint(int row, int col) const { return Point(xs[col], ys[row], zs[(size_t(row) * xs.size()) + col]); }
+
+//!    Fill tin with the triangulation of the grid. Triangles are CCW and normals are area weighted.
+        void Triangulate(TIN& tin, double tolerance = 0) const;
+
+    private:
+        struct Block
+        {
+            int r0, c0, r1, c1;
+        };
+
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> zs;
+
+        double getZ(int row, int col) const { return zs[(size_t(row) * xs.size()) + col]; }
+        bool FanFits(const Block& block, double tolerance) const;
+        void Subdivide(const Block& block, double tolerance, std::vector<Block>& leaves, std::vector<char>& used) const;
+    };
+
+}
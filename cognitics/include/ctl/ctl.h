@@ -45,6 +45,7 @@ DEALINGS IN THE SOFTWARE.
 #include "Edge.h"
 #include "LocationResult.h"
 #include "TIN.h"
+#include "GridTIN.h"
 #include "DelaunayTriangulation.h"
 #include "CGrid.h"
 
@@ -31,13 +31,27 @@ DEALINGS IN THE SOFTWARE.
 
 #include "CacheEntry.h"
 
+#include <ccl/mutex.h>
+
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <unordered_map>
 
 namespace elev
 {
 /*! \class elev::Cache Cache.h cache/Cache.h
 \brief Generic cache management class.
 
+Entries are keyed by (owner, offset) and spread across a fixed number of shards
+by hash. Each shard has its own lock, hash index and LRU list, so a single cache
+can be shared by every thread of a multi-threaded build without serialising
+lookups. Each shard is allowed maxsize / NumShards bytes.
+
+Entries are returned as shared pointers; an entry evicted while a caller still
+holds it stays valid until the caller releases it.
+
 \code
 #include <cache/Cache.h>
 
@@ -49,15 +63,46 @@ elev::Cache *cache = new elev::Cache(32 * 1024 * 1024);
 */
     class Cache
     {
-        unsigned int maxsize;                    //!< maximum size in bytes
-        unsigned int size;                        //!< current size in bytes
-        unsigned int hits;                        //!< cache hits
-        unsigned int misses;                    //!< cache misses
-        std::list<CacheEntry *> entries;        //!< list of elev::CacheEntry objects
+    public:
+        static const size_t NumShards = 16;
+
+    private:
+        struct Key
+        {
+            DataSource *owner;
+            unsigned int offset;
+            bool operator==(const Key &rhs) const { return (owner == rhs.owner) && (offset == rhs.offset); }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key &key) const;
+        };
+
+        typedef std::list<CacheEntryPtr> EntryList;
+
+        struct Shard
+        {
+            ccl::mutex mutex;
+            EntryList entries;                                            //!< entries ordered inversely by last access
+            std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+            size_t size;                                                //!< current size in bytes
+
+            Shard() : size(0) { }
+        };
+
+        std::atomic<unsigned int> maxsize;        //!< maximum size in bytes
+        std::atomic<uint64_t> hits;                //!< cache hits
+        std::atomic<uint64_t> misses;            //!< cache misses
+        std::atomic<uint64_t> evictions;        //!< entries removed to make space
+        Shard shards[NumShards];
+
+        Cache(const Cache &);
+        Cache &operator=(const Cache &);
 
     public:
         //! Create a new cache of maxsize bytes.
-        Cache(unsigned int maxsize) : maxsize(maxsize), size(0), hits(0), misses(0) { }
+        Cache(unsigned int maxsize) : maxsize(maxsize), hits(0), misses(0), evictions(0) { }
 
         //! Destroy the cache and all entries.
         ~Cache();
@@ -66,28 +111,32 @@ elev::Cache *cache = new elev::Cache(32 * 1024 * 1024);
         void Clear();
 
         //! Get the maximum cache size in bytes.
-        unsigned int GetMaxSize(void) { return this->maxsize; }
+        unsigned int GetMaxSize(void) { return this->maxsize.load(); }
         //! Set the maximum cache size in bytes.
+        /*! Shards over their new budget are trimmed on their next miss. */
         void SetMaxSize(unsigned int maxsize) { this->maxsize = maxsize; }
 
         //! Get the current cache size in bytes.
-        unsigned int GetSize(void) { return this->size; }
+        unsigned int GetSize(void);
 
         //! Get cache hit count.
-        unsigned int GetHits(void) { return this->hits; }
+        unsigned int GetHits(void) { return (unsigned int)this->hits.load(); }
         //! Get cache miss count.
-        unsigned int GetMisses(void) { return this->misses; }
+        unsigned int GetMisses(void) { return (unsigned int)this->misses.load(); }
+        //! Get the number of entries evicted to make space.
+        unsigned int GetEvictions(void) { return (unsigned int)this->evictions.load(); }
 
         //! Get the cache entry for the owner and offset.
-        /*! This will also move the requested entry to the front of the list, so that
+        /*! This will also move the requested entry to the front of its shard's list, so that
             the list is ordered inversely by last access.
         
-            If the entry does not exist, entries will be removed from the end of the list
+            If the entry does not exist, entries will be removed from the end of the shard's list
             as needed to make space for the size specified and create a new entry.
+            A new entry is returned unloaded; the caller populates it while holding CacheEntry::mutex.
 
             \warning Attempting to get an entry with size > maxsize will throw an exception.
         */
-        CacheEntry *GetEntry(DataSource *owner, unsigned int offset, unsigned int size);
+        CacheEntryPtr GetEntry(DataSource *owner, unsigned int offset, unsigned int size);
 
     };
 
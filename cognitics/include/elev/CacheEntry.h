@@ -29,6 +29,11 @@ DEALINGS IN THE SOFTWARE.
 */
 #pragma once
 
+#include <ccl/mutex.h>
+
+#include <atomic>
+#include <memory>
+
 namespace elev
 {
     class DataSource;
@@ -40,13 +45,16 @@ namespace elev
 */
     class CacheEntry
     {
+        friend class Cache;
+
         DataSource *owner;                //!< the owner class of the cache entry
         unsigned int offset;        //!< an offset value for use by the owner
 
     public:
         unsigned int size;            //!< size of the dataset in bytes
         void *data;                    //!< dataset
-        bool loaded;                //!< flag to identify if the data property has been populated
+        std::atomic<bool> loaded;    //!< flag to identify if the data property has been populated
+        ccl::mutex mutex;            //!< held while checking and populating data, so concurrent misses load once
 
         //! Create a new entry.
         CacheEntry(DataSource *owner, unsigned int offset, unsigned int size);
@@ -59,5 +67,7 @@ namespace elev
 
     };
 
+    typedef std::shared_ptr<CacheEntry> CacheEntryPtr;
+
 }
 
@@ -40,6 +40,7 @@ These objects are created and maintained by elev::DataSourceManager.
 #include "DataPost.h"
 #include <ccl/ObjLog.h>
 #include <elev/Cache.h>
+#include <ccl/mutex.h>
 
 #include <string>
 #include <vector>
@@ -73,6 +74,7 @@ namespace elev
         double postspacing_x;                    //!< calculated nominal post spacing in meters along the x axis
         double postspacing_y;                    //!< calculated nominal post spacing in meters along the y axis
         int refcount;
+        ccl::mutex ctMutex;                        //!< serialises use of file_ct/app_ct, which are not thread-safe
 
         //! Build coordinate transformation objects
         virtual void BuildCoordinateTransformations();
@@ -111,6 +113,11 @@ namespace elev
         //! \returns the average of the x and y postspacing.
         double GetAveragePostSpacing() { return (postspacing_x + postspacing_y)/2; }
 
+        //! Transform application coordinates to file coordinates in place.
+        void AppToFile(double &x, double &y);
+        //! Transform file coordinates to application coordinates in place.
+        void FileToApp(double &x, double &y);
+
         virtual void ref(void);
         virtual void unref(void);
     };
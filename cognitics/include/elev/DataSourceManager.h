@@ -35,6 +35,7 @@ namespace elev
         bool generate(void);
 
         void getSourcesForPoint(double x, double y, std::list<DataSource_Raster *> &result);
+        void getSourcesForPoint(double x, double y, std::vector<DataSource_Raster *> &result);
     };
 
 
@@ -56,6 +57,9 @@ namespace elev
         //! Destroy the DataSourceManager instance.
         ~DataSourceManager();
 
+        //! Get the block cache shared by all sources (e.g. for hit/miss/eviction counts).
+        Cache *GetCache(void) { return this->cache; }
+
         //! Set the application geospatial reference type (e.g. "WGS84").
         /*! This is passed to all current and new DataSource instances for use in transformations. */
         void SetReferenceType(std::string reftype);
@@ -73,6 +77,9 @@ namespace elev
         /*!    Returns the number of elev::DataPost objects created. */
         int GetPostsForPoint(double x, double y, std::vector<DataPost*> &posts);
 
+        //! [RASTER] Append the raster sources searched by GetPostsForPoint(), in the same order.
+        void GetSourcesForPoint(double x, double y, std::vector<DataSource_Raster *> &result);
+
         void generateBSP(void);
 
         bool getElevationBounds(double &elevation_min, double &elevation_max);
@@ -42,9 +42,18 @@ namespace elev
 
         void set_priority(int p);
 
+        //! Pixel offsets of the posts returned by GetPostsForPoint(), in order.
+        static const int PostOffsets[4][2];
+
         //! Get posts surrounding provided application coordinates.
         virtual int GetPostsForPoint(double x, double y, std::vector<DataPost*> &posts);
 
+        //! Get the posts surrounding provided application coordinates without allocating.
+        /*!    Writes up to four posts (application coordinates and loaded value) in the same order as GetPostsForPoint().
+            \return The number of posts written.
+        */
+        virtual int GetPostValuesForPoint(double x, double y, double *post_x, double *post_y, double *values);
+
         //! Checks if a post value is valid (by FILE PROJECTION post coordinates).
         virtual bool ValidatePost(double file_x, double file_y) { return true; }
 
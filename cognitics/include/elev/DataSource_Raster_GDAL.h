@@ -55,7 +55,7 @@ namespace elev
     {
     protected:
         GDALDataset *gdal_dataset;                            //!< GDALDataset instance for the file
-        ccl::mutex cacheMutex;
+        ccl::mutex datasetMutex;                            //!< guards gdal_dataset and refcount; a source may be shared by several threads
         std::vector<std::pair<int, int> > blocksizes;
         std::vector<GDALDataType> datatypes;
         bool pixel_is_point;
@@ -67,6 +67,9 @@ namespace elev
 
         bool LoadValue(double file_x, double file_y, double &value, int index = 1);
 
+        //! LoadValue() that keeps the last block pinned in block/block_key, so neighbouring posts skip the cache lookup.
+        bool LoadValue(double file_x, double file_y, double &value, int index, CacheEntryPtr &block, unsigned int &block_key);
+
     public:
         //! Instantiate a DataSource_Raster_GDAL object.
         DataSource_Raster_GDAL(std::string filename, Cache *cache);
@@ -81,6 +84,9 @@ namespace elev
         //! Implementation of DataSource_Raster::GetValue().
         virtual bool GetValue(double post_x, double post_y, double &value, int index = 1);
 
+        //! Implementation of DataSource_Raster::GetPostValuesForPoint().
+        virtual int GetPostValuesForPoint(double x, double y, double *post_x, double *post_y, double *values);
+
         //! Implementation of DataSource_Raster::GetValues().
         virtual int GetValues(double post_x, double post_y, std::vector<double> &values);
 
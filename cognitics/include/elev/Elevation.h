@@ -28,10 +28,17 @@ namespace elev
         bool force;        // force strategy (fails if invalid points)
         std::vector<sfa::Point *> points;
         std::map<sfa::Point, cts::FlatEarthProjection> flat_earth_projection_by_origin;
+        std::vector<sfa::Point> fe_points;        // scratch for Interpolate(), kept to avoid reallocating per sample
+        cts::FlatEarthProjection *last_projection;    // projection for the last origin block, skips the map lookup for neighbouring samples
+        int last_origin_x;
+        int last_origin_y;
+
+        //! interpolate sample_point's z from posts whose z values are already loaded
+        bool Interpolate(sfa::Point *sample_point, sfa::Point *const *posts, size_t count);
 
 
     public:
-        Elevation(enum elevation_strategy strategy = ELEVATION_NEAREST, bool force = false) : strategy(strategy), force(force) { }
+        Elevation(enum elevation_strategy strategy = ELEVATION_NEAREST, bool force = false) : strategy(strategy), force(force), last_projection(NULL), last_origin_x(0), last_origin_y(0) { }
         virtual ~Elevation() { Clear(); }
 
         void SetStrategy(enum elevation_strategy strategy) { this->strategy = strategy; }
@@ -14,6 +14,15 @@ namespace elev
 
     class Elevation_DSM : public Elevation
     {
+        // scratch buffers for the batch interface, reused between samples
+        std::vector<DataSource_Raster *> batch_sources;
+        std::vector<sfa::Point> batch_posts;
+        std::vector<DataSource_Raster *> batch_post_sources;
+        std::vector<sfa::Point *> batch_selected;
+        sfa::Point batch_sample;
+
+        bool GetBuffered(double x, double y, double &z);
+
     public:
         DataSourceManager *dsm;
         std::vector<sfa::Feature *> debug_features;
@@ -26,6 +35,16 @@ namespace elev
         virtual bool Load(sfa::Point *p);
         virtual bool Get(sfa::Point *p);
 
+        //! Sample n points, with the same results as calling Get(sfa::Point *) for each.
+        /*! Posts are read into reused buffers instead of allocated per sample, and neighbouring
+            posts in one block share a cache lookup. zs[i] is only written where a value was found.
+            \return The number of points sampled.
+        */
+        size_t Get(const double *xs, const double *ys, float *zs, size_t n);
+
+        //! Sample a width x height grid starting at (x0, y0), row-major; see Get(const double *, const double *, float *, size_t).
+        size_t GetGrid(double x0, double y0, double spacing_x, double spacing_y, int width, int height, float *zs);
+
     };
 
 }
@@ -33,10 +33,12 @@ DEALINGS IN THE SOFTWARE.
 #pragma warning ( pop )
 
 #include <float.h>
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <sfa/sfa.h>
 #include <ccl/mutex.h>
 #include <ccl/cstdint.h>
@@ -444,8 +446,9 @@ namespace gdalsampler
         float *elev { nullptr };
         int age; //!<  Each time this isn't the block we're looking for, we increment this. Then we can delete the oldest to make room in the cache.        
         GDALRasterFile *m_file;
+        ccl::uint64_t m_fileId; //!< GDALRasterFile::GetId() of m_file, which unlike the pointer is never reused.
         std::string m_filename;
-        bool m_ready;
+        std::atomic<bool> m_ready; //!< Set with release once the pixels are in place, so IsReady() can be checked without the cache locks.
         sfa::Feature m_validArea;
 
 
@@ -457,7 +460,7 @@ namespace gdalsampler
 
         bool IsReady()
         {
-            return m_ready;
+            return m_ready.load(std::memory_order_acquire);
         }
 
         bool IsSameBlock(CachedRasterBlock *other)
@@ -566,9 +569,100 @@ namespace gdalsampler
 #endif
 
 
+    /**
+     * Process-wide raster block cache.
+     *
+     * The thread local CacheManager gives every worker its own copy of each
+     * decoded block. When a budget is set, CacheManager::PageBlock() routes
+     * through this cache instead so a block is decoded once and shared by all
+     * threads. Blocks are hashed across shards, each with its own lock and LRU
+     * list, and a block is only unloaded once the cache holds the last
+     * reference to it.
+     **/
+    class SharedBlockCache
+    {
+    public:
+        struct Stats
+        {
+            ccl::uint64_t hits { 0 };
+            ccl::uint64_t misses { 0 };
+            ccl::uint64_t evictions { 0 };
+            ccl::uint64_t bytes { 0 };
+            ccl::uint64_t blocks { 0 };
+        };
+
+        static SharedBlockCache *getInstance();
+
+        // A budget of zero disables the shared cache (the default).
+        void SetBudget(size_t bytes);
+        size_t GetBudget() const { return _budget.load(std::memory_order_acquire); }
+        bool IsEnabled() const { return GetBudget() > 0; }
+
+        // Replace block with the cached copy, decoding it if necessary.
+        bool PageBlock(CachedRasterBlockPtr &block);
+
+        // Unload every block that is not currently in use.
+        void Clear();
+
+        // Drop every block of a file that is being destroyed.
+        void RemoveFile(ccl::uint64_t fileId);
+
+        Stats GetStats();
+
+    private:
+        static const int NUM_SHARDS = 16;
+
+        struct Key
+        {
+            ccl::uint64_t file;
+            int xoffset;
+            int yoffset;
+            int xsize;
+            int ysize;
+
+            bool operator==(const Key &other) const
+            {
+                return (file == other.file) && (xoffset == other.xoffset) && (yoffset == other.yoffset)
+                    && (xsize == other.xsize) && (ysize == other.ysize);
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key &key) const;
+        };
+
+        struct Entry
+        {
+            CachedRasterBlockPtr block;
+            boost::shared_ptr<ccl::mutex> readLock;
+            size_t bytes { 0 };
+            std::list<Key>::iterator lru;
+        };
+
+        struct Shard
+        {
+            ccl::mutex lock;
+            std::unordered_map<Key, Entry, KeyHash> entries;
+            std::list<Key> lru;               // most recently used first
+            size_t bytes { 0 };
+            ccl::uint64_t hits { 0 };
+            ccl::uint64_t misses { 0 };
+            ccl::uint64_t evictions { 0 };
+        };
+
+        Shard _shards[NUM_SHARDS];
+        std::atomic<size_t> _budget { 0 };  // read on every PageBlock without a lock
+
+        static Key KeyForBlock(const CachedRasterBlock *block);
+        static size_t BytesForBlock(const CachedRasterBlock *block);
+        Shard &ShardForKey(const Key &key);
+        void Evict(Shard &shard, size_t budget, std::vector<CachedRasterBlockPtr> &victims);
+    };
+
     class GDALRasterFile;
     class CacheManager
-    {        
+    {
         ccl::mutex _cacheLock;
         static const int MAX_CACHE_ENTRIES;
         static const int CACHE_BLOCK_HEIGHT;
@@ -651,6 +745,56 @@ namespace gdalsampler
     };
 
 
+    // The header of a source raster: everything GDALRasterFile needs to place
+    // the file and pick its transforms without opening it.
+    struct SourceRecord
+    {
+        std::string filename;
+        ccl::int64_t mtime;
+        ccl::uint64_t size;
+        int width;
+        int height;
+        double geotransform[6];
+        bool pixel_is_point;
+        std::string wkt;
+
+        SourceRecord() : mtime(0), size(0), width(0), height(0), pixel_is_point(false)
+        {
+            std::fill(geotransform, geotransform + 6, 0.0);
+        }
+    };
+
+    // Source records that outlive the sampler, optionally persisted to a file.
+    //
+    // A record is used only while the file's size and modification time still
+    // match, so a changed or replaced source is opened again and its record
+    // refreshed. The catalog is shared by reference and may be used from
+    // several samplers and threads at once.
+    class SourceCatalog
+    {
+        ccl::ObjLog log;
+        ccl::mutex mutex;
+        std::string _filename;
+        std::map<std::string, SourceRecord> records;
+        bool dirty;
+        size_t hits;
+        size_t misses;
+
+    public:
+        SourceCatalog();
+
+        // Reads the catalog file, if it exists; Save() writes it back.
+        bool Load(const std::string &filename);
+        bool Save();
+
+        // True and the record if the file is unchanged since it was cataloged.
+        bool Lookup(const std::string &filename, SourceRecord &record);
+        void Update(const SourceRecord &record);
+
+        size_t GetHits() const { return hits; }
+        size_t GetMisses() const { return misses; }
+    };
+
     class GDALRasterFile
     {
         ccl::ObjLog log;
@@ -675,7 +819,11 @@ namespace gdalsampler
         Quad _coverage; // poly in dest coordinates that represents the area of valid pixels for this file.
         Quad _localCoverage;
         bool _isValid;
+        ccl::uint64_t _id;
+        SourceRecord _record;
         bool OpenGDALFile(OGRSpatialReference &destsrs, std::string filename);
+        void ApplyRecord(OGRSpatialReference &destsrs);
+        void InitCoverage();
         ccl::int64_t _age;
         double resolution;// area (x resolution * y resolution)
         double x_resolution;
@@ -721,8 +869,12 @@ namespace gdalsampler
         }
         bool IsValid() { return _isValid; }
         GDALRasterFile(OGRSpatialReference dest, std::string filename);
+        // Places the file from a cataloged header; the dataset is opened on first use.
+        GDALRasterFile(OGRSpatialReference dest, const SourceRecord &record);
         ~GDALRasterFile();
 
+        const SourceRecord &GetRecord() const { return _record; }
+
 
         GDALDataset *GetDataset()
         {
@@ -805,6 +957,12 @@ namespace gdalsampler
         {
             return _filename;
         }
+
+        // Unique for the life of the process, so caches can key on it safely.
+        ccl::uint64_t GetId() const
+        {
+            return _id;
+        }
         double GetResolution()
         {
             return resolution;
@@ -880,6 +1038,7 @@ namespace gdalsampler
         ccl::mutex sortLock;
         ccl::mutex addmutex;
         std::map<std::string, gdalsampler::GDALRasterFilePtr> _file_by_name;
+        SourceCatalog *_catalog;
 
         // returns the first areal that contains the specified point.
         sfa::Polygon GetShapeForFileOrPoint(std::string filename,double x, double y);
@@ -902,6 +1061,8 @@ namespace gdalsampler
         bool ReadCoverageShapes(std::string filename);
         // make sure to call this before adding files.
         void SetDestSRS(OGRSpatialReference srs) { _destSRS = srs; }
+        // Files found in the catalog are added without being opened; the rest are added to it.
+        void SetCatalog(SourceCatalog *catalog) { _catalog = catalog; }
         bool AddFile(std::string filename);
         bool RemoveFile(std::string filename);
         // return a list of all the pixels that overlap with the specified aoi
@@ -925,6 +1086,7 @@ namespace gdalsampler
         void Unload()
         {
             CacheManager::getInstance()->Unload();
+            SharedBlockCache::getInstance()->Clear();
             coverageShapes.clear();
             _files.clear();
         }
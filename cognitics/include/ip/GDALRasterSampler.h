@@ -36,8 +36,8 @@ typedef unsigned int u_int;
 class GDALRasterSampler
 {
     ccl::ObjLog log;
-    // BSP of all the AOIs as polygon pointers
-    sfa::BSP *bsp;
+    // Packed R-tree of all the AOIs as polygon pointers
+    sfa::PackedRTree *bsp;
     //Map back to the file objects so when we get BSP hits we can get the associated files
     typedef std::map<sfa::Polygon *, gdalsampler::GDALRasterFilePtr> aoimap_t;
     aoimap_t aoiFileMap;
@@ -46,15 +46,17 @@ class GDALRasterSampler
     bool BuildBSP(bool rebuild);
     gdalsampler::GDALRasterFileList GetFilesInAOI(gdalsampler::Quad &aoi);
 
+    // This avoids copying no-data values, which are typically -32767.
+    // IPP tends to sample to values like -32767.002, which causes problems.
+    // Yes, we could check for a range around -32767, but nothing should
+    // be this low anyway.
+    static constexpr float ELEVATION_NODATA_THRESHOLD = -10000.0f;
+
     void CopyNonNoDataPixels(float *src, float *dest, int len)
     {
         for (int i = 0; i < len; i++)
         {
-            // This avoids copying no-data values, which are typically -32767.
-            // IPP tends to sample to values like -32767.002, which causes problems.
-            // Yes, we could check for a range around -32767, but nothing should
-            // be this low anyway.
-            if (src[i] > -10000)
+            if (src[i] > ELEVATION_NODATA_THRESHOLD)
                 dest[i] = src[i];
         }
 
@@ -198,9 +200,13 @@ class GDALRasterSampler
     gdalsampler::GDALReader m_reader;
     OGRSpatialReference geoSRS;
 
+    // When IPP support is compiled in, Sample() uses it for imagery unless SetUseIPP(false) is called.
+    bool useIPP;
+
     bool SampleSoftware(const gdalsampler::GeoExtents &window, u_char *buf);
     bool SampleIPP(const gdalsampler::GeoExtents &window, u_char *buf);
-    bool SampleIPP(const gdalsampler::GeoExtents &window, float *buf);
+    bool SampleNative(const gdalsampler::GeoExtents &window, u_char *buf);
+    bool SampleNative(const gdalsampler::GeoExtents &window, float *buf);
 
 public:
     GDALRasterSampler() ;
@@ -217,11 +223,24 @@ public:
     // This should always be called before the first call to AddFile or AddDirectory.
     bool AddCoverageFile(std::string shapefile);
 
+    // Use a catalog of source headers so cataloged files are added without opening them.
+    // The catalog is not owned and must outlive the sampler's AddFile calls.
+    void SetCatalog(gdalsampler::SourceCatalog *catalog) { m_reader.SetCatalog(catalog); }
+
     // Sample all the available files that intersect the specified geographic window
     // into the output buffer with the specified width and height
     bool Sample(const gdalsampler::GeoExtents &window, u_char *buf);
     bool Sample(const gdalsampler::GeoExtents &window, float *buf);
 
+    // Page every source block that intersects the window into the block cache
+    // without warping. Returns the number of blocks touched.
+    int PrefetchBlocks(const gdalsampler::GeoExtents &window);
+
+    // Select between the IPP warp and the native ip::WarpPerspective kernels.
+    // Returns false (and keeps the native kernels) if IPP support was not compiled in.
+    bool SetUseIPP(bool value);
+    bool UsingIPP() const { return useIPP; }
+
     // Returns a GeoExtents that covers the max extents of all files added to the sampler.
     gdalsampler::GeoExtents GetMinMaxExtents();
 
@@ -0,0 +1,51 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+
+/*
+================================================================================
+Pyramid Reduction
+================================================================================
+2:1 reductions for building a lower level of detail from aligned tiles. Each
+destination pixel is computed from the 2x2 source block at (2x, 2y); the
+source must be at least twice the destination size. Steps are in bytes.
+
+The float variants skip noData (and NaN) inputs and write noData only where
+all four inputs are invalid.
+*/
+#pragma once
+
+typedef unsigned char u_char;
+
+namespace ip
+{
+
+    // Box average, rounded to nearest.
+    void Reduce2x2_8u_C3(const u_char *src, int srcStep, u_char *dst, int dstWidth, int dstHeight, int dstStep);
+
+    void Reduce2x2Mean_32f_C1(const float *src, int srcStep, float *dst, int dstWidth, int dstHeight, int dstStep, float noData);
+    void Reduce2x2Min_32f_C1(const float *src, int srcStep, float *dst, int dstWidth, int dstHeight, int dstStep, float noData);
+
+    // Name of the instruction set compiled in: "sse2", "neon" or "scalar".
+    const char *Reduce2x2ISA();
+
+}
@@ -0,0 +1,72 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*
+================================================================================
+Perspective Warp
+================================================================================
+Native implementation of the perspective warps GDALRasterSampler previously
+required Intel IPP for. Coefficients follow the ippiWarpPerspective convention:
+they map source pixel coordinates onto destination pixel coordinates, and
+destination pixels that map outside of the source are left untouched
+(transparent border). Steps are in bytes.
+*/
+#pragma once
+
+typedef unsigned char u_char;
+
+namespace ip
+{
+
+    enum WarpInterpolation
+    {
+        WARP_NEAREST,
+        WARP_LINEAR,
+        WARP_CUBIC            // Catmull-Rom (B=0, C=0.5), matching the IPP cubic setup used by the sampler
+    };
+
+    // Compute the coefficients that map the source rectangle (0,0)-(width-1,height-1)
+    // onto quad, given as ul, ur, lr, ll in destination pixel space.
+    bool GetPerspectiveTransform(int srcWidth, int srcHeight, const double quad[4][2], double coeffs[3][3]);
+
+    bool WarpPerspective_8u_C3(const u_char *src, int srcWidth, int srcHeight, int srcStep,
+        u_char *dst, int dstWidth, int dstHeight, int dstStep,
+        const double coeffs[3][3], WarpInterpolation interpolation);
+
+    bool WarpPerspective_32f_C1(const float *src, int srcWidth, int srcHeight, int srcStep,
+        float *dst, int dstWidth, int dstHeight, int dstStep,
+        const double coeffs[3][3], WarpInterpolation interpolation);
+
+    // Bilinear warp that composites a float source straight into dst: only destination pixels
+    // that are not yet marked in filled, and whose four source taps are all above noData, are
+    // written and then marked. Warping sources from highest to lowest priority into one buffer
+    // gives the same result as last-wins copies while sampling each pixel at most once.
+    // filled holds one byte per destination pixel; filledStep is in bytes.
+    bool WarpComposite_32f_C1(const float *src, int srcWidth, int srcHeight, int srcStep,
+        float *dst, int dstWidth, int dstHeight, int dstStep, u_char *filled, int filledStep,
+        const double coeffs[3][3], float noData);
+
+    // Name of the instruction set selected at runtime: "avx2", "sse4.1", "neon" or "scalar".
+    // Setting COG_WARP_ISA to "scalar" or "sse4.1" before the first warp caps the selection.
+    const char *WarpPerspectiveISA();
+
+}
@@ -25,9 +25,13 @@ DEALINGS IN THE SOFTWARE.
 #include <ip/imageinfo.h>
 #include <ip/ip.h>
 
+#include <vector>
+
 namespace ip {
 
     bool GetJPGImageInfo(std::string filename, ip::ImageInfo &info);
     bool GetJPGImagePixels(std::string filename, ip::ImageInfo &info, ccl::binary &buffer);
     bool WriteJPG24(const std::string &filename, const ip::ImageInfo &info, const ccl::binary &buffer, int jpeg_quality=70);
+    // Same as WriteJPG24, but into memory.
+    bool EncodeJPG24(const ip::ImageInfo &info, const unsigned char *pixels, std::vector<unsigned char> &jpeg, int jpeg_quality=85);
 }
\ No newline at end of file
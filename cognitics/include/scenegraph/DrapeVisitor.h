@@ -24,13 +24,29 @@ DEALINGS IN THE SOFTWARE.
 #include "Visitor.h"
 #include "Scene.h"
 
+#include <memory>
+
 namespace scenegraph
 {
+    struct DrapeTerrainIndex;
+
     // drape
+    //
+    // By default every scene vertex is tested against every terrain face. With setIndexed(true) the terrain
+    // faces are triangulated and put in a uniform grid once, each vertex takes its height from the first
+    // terrain triangle containing it, and the scene faces are draped on worker threads. setSplitEdges(true)
+    // additionally inserts a vertex wherever a scene face edge crosses a terrain edge so the draped face
+    // follows the terrain between its original vertices; split faces are no longer triangles.
     class DrapeVisitor : public Visitor
     {
     private:
         Scene *terrainScene;
+        bool indexed;
+        bool splitEdges;
+        int threads;
+        std::unique_ptr<DrapeTerrainIndex> terrainIndex;
+
+        void drapeIndexed(Scene *scene);
 
     public:
         virtual ~DrapeVisitor(void);
@@ -40,10 +56,17 @@ namespace scenegraph
 
         void setTerrainScene(Scene *terrainScene);
 
+        void setIndexed(bool indexed);
+
+        // Only used by the indexed drape.
+        void setSplitEdges(bool splitEdges);
+
+        // 0 uses every hardware thread.
+        void setThreads(int threads);
+
     };
 
 
 
 }
 
-
@@ -27,6 +27,7 @@ DEALINGS IN THE SOFTWARE.
 #include <list>
 #include "Polygon.h"
 #include "PointLocator.h"
+#include "PackedRTree.h"
 
 
 namespace sfa
@@ -87,6 +88,8 @@ namespace sfa
         virtual ~BSPCollectGeometriesVisitor(void);
         BSPCollectGeometriesVisitor(void);
         virtual void visiting(BSP *bsp);
+        //Collects the geometries of a generated PackedRTree that touch the bounding box, in the order they were added
+        void visiting(PackedRTree *tree);
     };
     /*_______________________________________________________________________________________________
     This class searches for geometries that touch a search window that is defined as a polygon.
@@ -0,0 +1,127 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "Point.h"
+
+namespace sfa
+{
+    class LineString;
+    class Polygon;
+    class CoordinateSequence;
+    typedef std::vector<CoordinateSequence> CoordinateSequenceList;
+
+/*! \class sfa::CoordinateSequence CoordinateSequence.h CoordinateSequence.h
+\brief CoordinateSequence
+
+Packed coordinates of a LineString or ring, stored as one contiguous array of x,y[,z][,m] doubles rather than a list of Point
+objects. Algorithms that walk every vertex (areas, point in polygon, point on line) pack a LineString once and then run over the
+array without a virtual call or pointer chase per vertex.
+
+A sequence packed with Z or M carries 0 for Points that have no Z or M value, matching what those Points return from Z() and M().
+
+The binary methods read and write the same point count and coordinate block that LineString::toBinary() and
+LineString::fromBinary() use (and therefore each Polygon ring), in one block rather than one value at a time.
+
+\note This is an extension to the specification.
+*/
+    class CoordinateSequence
+    {
+    protected:
+        std::vector<double> coords;
+        bool hasZ;
+        bool hasM;
+        int stride;
+
+    public:
+        ~CoordinateSequence(void);
+        CoordinateSequence(bool withZ = false, bool withM = false);
+//!    Packs the points of line; see assign().
+        CoordinateSequence(const LineString* line, bool withZ, bool withM);
+
+//!    Replace the contents with the points of line, keeping Z and M only if requested.
+        void assign(const LineString* line, bool withZ, bool withM);
+
+        void clear(void);
+        void reserve(int numPoints);
+
+        void addPoint(double x, double y, double z = 0, double m = 0);
+        void addPoint(const Point& point);
+
+        int getNumPoints(void) const { return int(coords.size() / stride); }
+        bool isEmpty(void) const { return coords.empty(); }
+        bool is3D(void) const { return hasZ; }
+        bool isMeasured(void) const { return hasM; }
+
+//!    Number of doubles per point (2, 3 or 4).
+        int getStride(void) const { return stride; }
+
+//!    Packed coordinates, getStride() doubles per point.
+        const double* data(void) const { return coords.data(); }
+        double* data(void) { return coords.data(); }
+
+        double X(int n) const { return coords[n * stride]; }
+        double Y(int n) const { return coords[n * stride + 1]; }
+        double Z(int n) const { return hasZ ? coords[n * stride + 2] : 0; }
+        double M(int n) const { return hasM ? coords[n * stride + stride - 1] : 0; }
+
+        Point getPointN(int n) const;
+
+//!    2D equality of the first and last points, as Curve::isClosed().
+        bool isClosed(void) const;
+
+//!    2D bounds of the points. Returns false for an empty sequence.
+        bool getEnvelope(double& minX, double& minY, double& maxX, double& maxY) const;
+
+//!    Append the points to line.
+        void appendTo(LineString* line) const;
+
+//!    Write the point count and coordinates, in this sequence's dimensions.
+        void toBinary(std::ostream &os, WKBByteOrder byteOrder) const;
+
+//!    Replace the contents with a point count and coordinates read from is.
+        void fromBinary(std::istream &is, WKBByteOrder byteOrder, bool withZ, bool withM);
+
+/*!    \brief fromBinary
+
+Replace the contents with a point count and coordinates read from a WKB buffer, such as the body of a LineString or one
+ring of a Polygon.
+\param wkb Start of the point count.
+\param size Bytes available at wkb.
+\param byteOrder Byte order of the buffer.
+\param withZ True if each point in the buffer has a Z value.
+\param withM True if each point in the buffer has an M value.
+\return Number of bytes consumed, or 0 if the buffer is too short.
+*/
+        size_t fromBinary(const unsigned char* wkb, size_t size, WKBByteOrder byteOrder, bool withZ, bool withM);
+    };
+
+/*!    \brief GetPolygonCoordinates
+
+Packs every ring of a Polygon, exterior ring first.
+\param polygon Polygon to pack.
+\param rings Receives one CoordinateSequence per ring.
+\param withZ Keep Z values.
+*/
+    void GetPolygonCoordinates(const Polygon* polygon, CoordinateSequenceList& rings, bool withZ = false);
+
+}
@@ -35,8 +35,8 @@ namespace sfa {
 
 Intersects a set of EdgeNodes and adds any intersections found to those EdgeNodes.
 
-Currently uses Brute force method to compare all segments of each EdgeNode, but would be more efficient if some sweepline 
-was imlpemented for larger sets of EdgeNodes. Perhaps a Monotonic subdivision might also increase performance.
+Candidate segment pairs are found with a sweep over the segment envelopes, so only segments whose envelopes
+overlap are tested. The results are the same as comparing every segment of each EdgeNode with every other.
 */
     class EdgeIntersector
     {
@@ -77,7 +77,6 @@ touching at an end point or overlaping along a line.
 /*! \brief Both initialize and intersect the two sets of edges
 
 If selfTest is set, it will know that A[n] == B[n] since A and B are equal. This allows fewer tests to be run.
-Currently uses a brute force test, but will implement a sweepline soon.
 */
         EdgeIntersector(void) { }
         EdgeIntersector(EdgeNodeList A, EdgeNodeList B, bool selfTest = false);
@@ -33,7 +33,7 @@ namespace sfa
 
     Geometry* getGeometryFromText(const std::string wkt);
 
-    Geometry* getGeometryFromBinary(const ccl::binary wkb);
+    Geometry* getGeometryFromBinary(const ccl::binary &wkb);
 
 }
 
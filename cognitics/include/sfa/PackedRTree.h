@@ -0,0 +1,147 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sfa
+{
+    class Geometry;
+
+/*! \class sfa::PackedRTree PackedRTree.h PackedRTree.h
+\brief PackedRTree
+
+Static R-tree over 2D envelopes, for sets that are filled once and then searched many times (source file footprints, tiles).
+
+Items are added with add() or addGeometry() and the tree is built with generate(). The leaves are sorted by the Hilbert value of
+their envelope centers and packed getNodeSize() to a node, level by level, into one flat array of boxes, so a search walks
+contiguous memory and allocates nothing.
+
+Searches report the index of each item whose envelope touches the window, where an item's index is its position in the order
+of add() calls. Envelopes and the window are closed, as with BSPCollectGeometriesVisitor.
+
+A generated tree can be written to a stream in native byte order and read back. Geometry pointers are not written, so a tree
+that is read back reports item indices only.
+
+\note This is an extension to the specification.
+*/
+    class PackedRTree
+    {
+    protected:
+        size_t nodeSize;
+        size_t numItems;
+        bool generated;
+        std::vector<double> boxes;              // minX, minY, maxX, maxY per node; leaves first, root last
+        std::vector<size_t> indices;            // item index for a leaf, first child node for a branch
+        std::vector<size_t> levelEnds;          // one past the last node of each level
+        std::vector<Geometry *> geometries;
+
+        template <typename Callback>
+        bool searchNode(size_t node, size_t level, double minX, double minY, double maxX, double maxY, Callback &callback) const
+        {
+            size_t first = indices[node];
+            size_t end = std::min<size_t>(first + nodeSize, levelEnds[level - 1]);
+            for (size_t child = first; child < end; ++child)
+            {
+                const double *box = &boxes[child * 4];
+                if ((box[0] > maxX) || (box[1] > maxY) || (box[2] < minX) || (box[3] < minY))
+                    continue;
+                if (level == 1)
+                {
+                    if (!callback(indices[child]))
+                        return false;
+                }
+                else if (!searchNode(child, level - 1, minX, minY, maxX, maxY, callback))
+                    return false;
+            }
+            return true;
+        }
+
+    public:
+        ~PackedRTree(void);
+        PackedRTree(size_t nodeSize = 16);
+
+//!    Remove all items and the tree.
+        void clear(void);
+
+//!    Reserve space for numItems items before adding them.
+        void reserve(size_t numItems);
+
+//!    Add an envelope and return its item index. Must be called before generate().
+        size_t add(double minX, double minY, double maxX, double maxY);
+
+/*!    \brief addGeometry
+
+Add a geometry by its envelope. The geometry is not owned; it is returned by getGeometry() and collected by
+BSPCollectGeometriesVisitor. A geometry without an envelope (empty) is not added.
+\return True if the geometry was added.
+*/
+        bool addGeometry(Geometry *geometry);
+
+//!    Build the tree from the added items. Items cannot be added afterwards without clear().
+        void generate(void);
+
+        bool isGenerated(void) const { return generated; }
+        size_t getNodeSize(void) const { return nodeSize; }
+        size_t getNumItems(void) const { return numItems; }
+
+//!    Geometry added for an item, or NULL if the item was added with add() or the tree was read from a stream.
+        Geometry *getGeometry(size_t item) const;
+
+//!    Bounds of every item. Returns false for an empty tree.
+        bool getEnvelope(double &minX, double &minY, double &maxX, double &maxY) const;
+
+/*!    \brief search
+
+Call callback(size_t item) for each item whose envelope touches the window. The callback returns false to stop the search.
+Nothing is allocated. generate() must have been called.
+\return False if the callback stopped the search.
+*/
+        template <typename Callback>
+        bool search(double minX, double minY, double maxX, double maxY, Callback callback) const
+        {
+            if (!generated || !numItems)
+                return true;
+            size_t root = levelEnds.back() - 1;
+            const double *box = &boxes[root * 4];
+            if ((box[0] > maxX) || (box[1] > maxY) || (box[2] < minX) || (box[3] < minY))
+                return true;
+            return searchNode(root, levelEnds.size() - 1, minX, minY, maxX, maxY, callback);
+        }
+
+//!    Append the items that touch the window to results.
+        void search(double minX, double minY, double maxX, double maxY, std::vector<size_t> &results) const;
+
+//!    Write a generated tree. Returns false if the tree is not generated or the stream fails.
+        bool write(std::ostream &os) const;
+        bool write(const std::string &filename) const;
+
+//!    Replace this tree with one written by write(). Returns false, leaving the tree empty, if the data is not a valid tree.
+        bool read(std::istream &is);
+        bool read(const std::string &filename);
+    };
+
+}
@@ -28,6 +28,7 @@ DEALINGS IN THE SOFTWARE.
 #include "Label.h"
 #include "Point.h"
 #include "LineString.h"
+#include "CoordinateSequence.h"
 
 namespace sfa {
 
@@ -69,6 +70,11 @@ Note that this is a 2D method. It will only use the x and y values of the input
 */
         bool PointOnLine(const Point* p, const LineString* line);
 
+/*!\brief PointOnLine
+Same as above for a line packed with its Z values, which PointLineIntersector includes in the segment length.
+*/
+        bool PointOnLine(const Point* p, const CoordinateSequence& line);
+
 /*!\brief updateLocation
 Updates the current known location of this point using the mod-2 boundary rule.
 \param l Location to update from
@@ -0,0 +1,91 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "Polygon.h"
+#include "Label.h"
+#include <vector>
+
+namespace sfa
+{
+
+/*! \class sfa::PreparedPolygon PreparedPolygon.h PreparedPolygon.h
+\brief PreparedPolygon
+
+A Polygon with its ring edges indexed for repeated 2D tests against many Points or small Polygons.
+
+The edges of every ring are bucketed once into horizontal bands over the Polygon's extent, so locating a point or testing a
+segment only looks at the edges in the bands it spans instead of walking every ring.
+
+Points and segments that come within SFA_EPSILON of a ring are reported as touching the boundary. contains() answers clear cases
+from the index and hands anything that touches the boundary to Geometry::contains(), so its result is the same as calling that
+directly.
+
+The Polygon is not copied and must outlive the PreparedPolygon.
+
+\note This is an extension to the specification.
+*/
+    class PreparedPolygon
+    {
+    public:
+        enum SegmentRelation
+        {
+            SEGMENT_DISJOINT = 0,   //!< The segment stays clear of every ring.
+            SEGMENT_TOUCHES = 1,    //!< The segment comes within SFA_EPSILON of a ring without clearly crossing it.
+            SEGMENT_CROSSES = 2     //!< The segment crosses the interior of a ring edge.
+        };
+
+    protected:
+        const Polygon* polygon;
+        std::vector<double> edges;              // x0, y0, x1, y1 per ring edge
+        std::vector<int> bandStart;             // first entry in bandEdges of each band, plus the end
+        std::vector<int> bandEdges;             // edge indices by band
+        double minX, minY, maxX, maxY;
+        double bandHeight;
+
+        void getBands(double y0, double y1, int& first, int& last) const;
+
+    public:
+        ~PreparedPolygon(void);
+        PreparedPolygon(const Polygon* polygon = NULL);
+
+//!    Index a new Polygon, replacing the current one.
+        void assign(const Polygon* polygon);
+
+        const Polygon* getPolygon(void) const { return polygon; }
+
+//!    Location of (x, y) with respect to the Polygon.
+        Location locate(double x, double y) const;
+        Location locate(const Point* point) const;
+
+//!    How the segment from (ax, ay) to (bx, by) meets the rings.
+        SegmentRelation relateSegment(double ax, double ay, double bx, double by) const;
+
+/*!    \brief contains
+
+Same result as getPolygon()->contains(other). Points and single ring Polygons are decided from the index unless they touch the
+boundary; every other case goes to Geometry::contains().
+*/
+        bool contains(const Geometry* other) const;
+    };
+
+}
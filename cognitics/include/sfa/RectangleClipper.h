@@ -0,0 +1,48 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "Geometry.h"
+
+namespace sfa {
+
+/*!\brief Clips a Geometry to an axis-aligned rectangle
+
+Unlike clipPolygon(), this handles every simple feature type and keeps holes:
+- Points and MultiPoints keep the points inside the rectangle (edges included).
+- LineStrings are clipped segment by segment (Liang-Barsky) and split wherever they leave the rectangle,
+  so a LineString may come back as a MultiLineString.
+- Polygon rings, exterior and interior, are clipped independently (Sutherland-Hodgman). Rings that collapse
+  onto the rectangle boundary are dropped.
+- Multi geometries and GeometryCollections are clipped part by part.
+Z and M are interpolated along clipped edges. Other geometry types fall back to Geometry::intersection().
+
+This is much cheaper than Geometry::intersection() with a rectangle polygon since nothing is noded. A
+concave polygon crossing the rectangle more than once, whose clipped ring would join its pieces with
+zero-width edges along the boundary, and a polygon with a hole crossing the rectangle are clipped with
+Geometry::intersection() instead, so a Polygon may come back as a MultiPolygon.
+
+\return the clipped geometry (owned by the caller), or NULL if nothing is left
+*/
+    Geometry* clipToRectangle(const Geometry* geometry, double xmin, double xmax, double ymin, double ymax);
+
+}
@@ -28,6 +28,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include "LineString.h"
 #include "Polygon.h"
+#include "CoordinateSequence.h"
 
 namespace sfa {
 
@@ -44,6 +45,7 @@ z values.
 \return Area of passed LinearRing.
 */
     double GetRingArea(const LineString* ring);
+    double GetRingArea(const CoordinateSequence& ring);
 
 /*!    \brief GetPolygonArea
 
@@ -65,6 +67,7 @@ may not always be within the LinearRing itself. Assumes CCW orientation, a simpl
 \return Centroid of the passed LinearRing.
 */
     Point GetRingCentroid(const LineString* ring);
+    Point GetRingCentroid(const CoordinateSequence& ring);
 
 /*!    \brief GetPolygonCentroid
 
@@ -140,6 +143,7 @@ orientation of the ring.
 */
     bool PointInRing(const Point* point, const LineString* ring);
     bool PointInRing(const Point& point, const LineString& ring);
+    bool PointInRing(const Point& point, const CoordinateSequence& ring);
 
 /*!    \brief PointInPolygon
 
@@ -154,5 +158,8 @@ if it does not "overlap" itself).
     bool PointInPolygon(const Point* point, const Polygon* polygon);
     bool PointInPolygon(const Point& point, const Polygon& polygon);
 
+//!    Same as above for a Polygon packed with GetPolygonCoordinates().
+    bool PointInPolygon(const Point& point, const CoordinateSequenceList& rings);
+
 
 }
\ No newline at end of file
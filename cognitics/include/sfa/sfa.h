@@ -82,10 +82,12 @@ for(size_t i = 0; i < layers.size(); ++i)
 #include "MultiPoint.h"
 #include "Curve.h"
 #include "LineString.h"
+#include "CoordinateSequence.h"
 #include "MultiCurve.h"
 #include "MultiLineString.h"
 #include "Surface.h"
 #include "Polygon.h"
+#include "PreparedPolygon.h"
 #include "PolyhedralSurface.h"
 #include "MultiSurface.h"
 #include "MultiPolygon.h"
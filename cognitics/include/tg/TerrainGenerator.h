@@ -23,6 +23,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include <ccl/ObjLog.h>
 #include <cts/FlatEarthProjection.h>
+#include <ctl/GridTIN.h>
 #include <ip/GDALRasterSampler.h>
 #include <elev/Elevation.h>
 #include <elev/DataSourceManager.h>
@@ -142,6 +143,10 @@ namespace cognitics
         //void generateRowColumn(int row, int col);        
         double getZ(double x, double y);
 
+        // Triangulates the grid directly, or through a constrained Delaunay triangulation if any constraint
+        // line strings (in the grid's coordinates) must be cut in. Posts within tolerance of the surface may be dropped.
+        ctl::TIN *triangulateTerrain(const ctl::GridTIN &grid, const ctl::PointList &gamingArea, const std::vector<ctl::PointList> &constraints, double tolerance);
+
     };
 
 }
@@ -3,8 +3,23 @@
 #include "mesh2cdb.h"
 typedef std::list<RenderJob> renderJobList_t;
 
+enum class RenderBackend
+{
+    GL,     // OpenGL through EGL (or GLUT on Windows)
+    CPU     // SoftwareRasterizer, no GL context required
+};
+
+struct RenderOptions
+{
+    RenderBackend backend = RenderBackend::GL;
+    int threads = 0;            // CPU backend worker threads, 0 for all cores
+    bool mipmaps = false;       // CPU backend mip selection when minifying textures
+};
+
+// Must be called before renderInit().
+void setRenderOptions(const RenderOptions &options);
+
 void setAOI(double llx, double lly, double urx, double  ury);
 
 bool renderInit(int argc, char **argv, renderJobList_t &jobs, const std::string &cdbRoot);
 bool renderScene(void);
-
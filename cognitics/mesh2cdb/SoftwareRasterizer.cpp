@@ -0,0 +1,875 @@
+#include "SoftwareRasterizer.h"
+
+#include <ip/ip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RASTER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RASTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RASTER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define RASTER_TARGET(isa)
+#endif
+
+namespace
+{
+    const int TILE_SIZE = 64;
+    const int SUBPIXEL_BITS = 8;
+    const int64_t SUBPIXEL = int64_t(1) << SUBPIXEL_BITS;
+    const int64_t HALF_PIXEL = SUBPIXEL / 2;
+
+    // Vertices further than this outside the buffer are clipped before snapping,
+    // which keeps every edge function product inside 64 bits.
+    const double GUARD_BAND = double(1 << 20);
+
+    const size_t TRIANGLES_PER_BATCH = 1 << 18;
+    const size_t TRIANGLES_PER_WORKER = 4096;
+
+    // Writes 1 to mask[i] where all three edge functions are >= 0 at pixel i of the
+    // row and returns the number of covered pixels.
+    typedef int (*CoverRowFunc)(const int64_t e[3], const int64_t step[3], int count, uint8_t *mask);
+
+    struct RasterKernels
+    {
+        const char *name;
+        CoverRowFunc coverRow;
+    };
+
+    int CoverRow_Scalar(const int64_t e[3], const int64_t step[3], int count, uint8_t *mask)
+    {
+        int64_t e0 = e[0];
+        int64_t e1 = e[1];
+        int64_t e2 = e[2];
+        int covered = 0;
+        for (int i = 0; i < count; i++)
+        {
+            mask[i] = ((e0 | e1 | e2) >= 0) ? 1 : 0;
+            covered += mask[i];
+            e0 += step[0];
+            e1 += step[1];
+            e2 += step[2];
+        }
+        return covered;
+    }
+
+#ifdef RASTER_X86
+
+    RASTER_TARGET("avx2")
+    int CoverRow_AVX2(const int64_t e[3], const int64_t step[3], int count, uint8_t *mask)
+    {
+        __m256i e0 = _mm256_set_epi64x(e[0] + 3 * step[0], e[0] + 2 * step[0], e[0] + step[0], e[0]);
+        __m256i e1 = _mm256_set_epi64x(e[1] + 3 * step[1], e[1] + 2 * step[1], e[1] + step[1], e[1]);
+        __m256i e2 = _mm256_set_epi64x(e[2] + 3 * step[2], e[2] + 2 * step[2], e[2] + step[2], e[2]);
+        const __m256i s0 = _mm256_set1_epi64x(4 * step[0]);
+        const __m256i s1 = _mm256_set1_epi64x(4 * step[1]);
+        const __m256i s2 = _mm256_set1_epi64x(4 * step[2]);
+        int covered = 0;
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // A lane is outside if any edge function is negative, i.e. the sign bit of the OR is set.
+            const __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), e2);
+            const int outside = _mm256_movemask_pd(_mm256_castsi256_pd(any));
+            mask[i] = uint8_t(~outside & 1);
+            mask[i + 1] = uint8_t((~outside >> 1) & 1);
+            mask[i + 2] = uint8_t((~outside >> 2) & 1);
+            mask[i + 3] = uint8_t((~outside >> 3) & 1);
+            covered += mask[i] + mask[i + 1] + mask[i + 2] + mask[i + 3];
+            e0 = _mm256_add_epi64(e0, s0);
+            e1 = _mm256_add_epi64(e1, s1);
+            e2 = _mm256_add_epi64(e2, s2);
+        }
+        if (i < count)
+        {
+            const int64_t tail[3] = { e[0] + i * step[0], e[1] + i * step[1], e[2] + i * step[2] };
+            covered += CoverRow_Scalar(tail, step, count - i, mask + i);
+        }
+        return covered;
+    }
+
+    RASTER_TARGET("sse2")
+    int CoverRow_SSE2(const int64_t e[3], const int64_t step[3], int count, uint8_t *mask)
+    {
+        __m128i e0 = _mm_set_epi64x(e[0] + step[0], e[0]);
+        __m128i e1 = _mm_set_epi64x(e[1] + step[1], e[1]);
+        __m128i e2 = _mm_set_epi64x(e[2] + step[2], e[2]);
+        const __m128i s0 = _mm_set1_epi64x(2 * step[0]);
+        const __m128i s1 = _mm_set1_epi64x(2 * step[1]);
+        const __m128i s2 = _mm_set1_epi64x(2 * step[2]);
+        int covered = 0;
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), e2);
+            const int outside = _mm_movemask_pd(_mm_castsi128_pd(any));
+            mask[i] = uint8_t(~outside & 1);
+            mask[i + 1] = uint8_t((~outside >> 1) & 1);
+            covered += mask[i] + mask[i + 1];
+            e0 = _mm_add_epi64(e0, s0);
+            e1 = _mm_add_epi64(e1, s1);
+            e2 = _mm_add_epi64(e2, s2);
+        }
+        if (i < count)
+        {
+            const int64_t tail[3] = { e[0] + i * step[0], e[1] + i * step[1], e[2] + i * step[2] };
+            covered += CoverRow_Scalar(tail, step, count - i, mask + i);
+        }
+        return covered;
+    }
+
+    bool CPUSupportsAVX2()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || ((_xgetbv(0) & 6) != 6))
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    bool CPUSupportsSSE2()
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return true;
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_cpu_supports("sse2");
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        return false;
+#endif
+    }
+
+#endif
+
+#ifdef RASTER_NEON
+
+    int CoverRow_NEON(const int64_t e[3], const int64_t step[3], int count, uint8_t *mask)
+    {
+        int64x2_t e0 = vcombine_s64(vdup_n_s64(e[0]), vdup_n_s64(e[0] + step[0]));
+        int64x2_t e1 = vcombine_s64(vdup_n_s64(e[1]), vdup_n_s64(e[1] + step[1]));
+        int64x2_t e2 = vcombine_s64(vdup_n_s64(e[2]), vdup_n_s64(e[2] + step[2]));
+        const int64x2_t s0 = vdupq_n_s64(2 * step[0]);
+        const int64x2_t s1 = vdupq_n_s64(2 * step[1]);
+        const int64x2_t s2 = vdupq_n_s64(2 * step[2]);
+        int covered = 0;
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // 0 where every edge is >= 0, -1 otherwise.
+            const int64x2_t outside = vshrq_n_s64(vorrq_s64(vorrq_s64(e0, e1), e2), 63);
+            mask[i] = uint8_t(1 + vgetq_lane_s64(outside, 0));
+            mask[i + 1] = uint8_t(1 + vgetq_lane_s64(outside, 1));
+            covered += mask[i] + mask[i + 1];
+            e0 = vaddq_s64(e0, s0);
+            e1 = vaddq_s64(e1, s1);
+            e2 = vaddq_s64(e2, s2);
+        }
+        if (i < count)
+        {
+            const int64_t tail[3] = { e[0] + i * step[0], e[1] + i * step[1], e[2] + i * step[2] };
+            covered += CoverRow_Scalar(tail, step, count - i, mask + i);
+        }
+        return covered;
+    }
+
+#endif
+
+    RasterKernels SelectKernels()
+    {
+        RasterKernels kernels = { "scalar", CoverRow_Scalar };
+#if defined(RASTER_X86)
+        if (CPUSupportsAVX2())
+        {
+            kernels.name = "avx2";
+            kernels.coverRow = CoverRow_AVX2;
+        }
+        else if (CPUSupportsSSE2())
+        {
+            kernels.name = "sse2";
+            kernels.coverRow = CoverRow_SSE2;
+        }
+#elif defined(RASTER_NEON)
+        kernels.name = "neon";
+        kernels.coverRow = CoverRow_NEON;
+#endif
+        return kernels;
+    }
+
+    const RasterKernels &Kernels()
+    {
+        static const RasterKernels kernels = SelectKernels();
+        return kernels;
+    }
+
+    int64_t FloorDiv(int64_t a, int64_t b)
+    {
+        return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+    }
+
+    // GL_REPEAT texel index for a texel-space coordinate.
+    int WrapTexel(double t, int size)
+    {
+        double f = std::floor(t);
+        f -= std::floor(f / size) * size;
+        if (!(f >= 0.0 && f < size))
+            return 0;
+        return int(f);
+    }
+
+    void RunWorkers(int workers, const std::function<void(int)> &work)
+    {
+        std::vector<std::thread> pool;
+        for (int i = 1; i < workers; i++)
+            pool.emplace_back(work, i);
+        work(0);
+        for (auto &thread : pool)
+            thread.join();
+    }
+}
+
+struct SoftwareRasterizer::Texture
+{
+    struct Level
+    {
+        int width;
+        int height;
+        std::vector<unsigned char> rgba;
+    };
+
+    std::vector<Level> levels;
+    bool valid = false;
+    uint64_t lastUsed = 0;
+
+    size_t bytes() const
+    {
+        size_t result = 0;
+        for (auto &level : levels)
+            result += level.rgba.size();
+        return result;
+    }
+
+    void buildMipmaps()
+    {
+        while (levels.back().width > 1 || levels.back().height > 1)
+        {
+            const Level &src = levels.back();
+            Level dst;
+            dst.width = std::max(1, src.width / 2);
+            dst.height = std::max(1, src.height / 2);
+            dst.rgba.resize(size_t(dst.width) * dst.height * 4);
+            for (int y = 0; y < dst.height; y++)
+            {
+                const int y0 = std::min(y * 2, src.height - 1);
+                const int y1 = std::min(y * 2 + 1, src.height - 1);
+                for (int x = 0; x < dst.width; x++)
+                {
+                    const int x0 = std::min(x * 2, src.width - 1);
+                    const int x1 = std::min(x * 2 + 1, src.width - 1);
+                    const unsigned char *p00 = &src.rgba[(size_t(y0) * src.width + x0) * 4];
+                    const unsigned char *p01 = &src.rgba[(size_t(y0) * src.width + x1) * 4];
+                    const unsigned char *p10 = &src.rgba[(size_t(y1) * src.width + x0) * 4];
+                    const unsigned char *p11 = &src.rgba[(size_t(y1) * src.width + x1) * 4];
+                    unsigned char *p = &dst.rgba[(size_t(y) * dst.width + x) * 4];
+                    for (int c = 0; c < 4; c++)
+                        p[c] = (unsigned char)((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+                }
+            }
+            levels.push_back(std::move(dst));
+        }
+    }
+
+    void sampleNearest(int level, double u, double v, float *rgba) const
+    {
+        const Level &l = levels[level];
+        const int x = WrapTexel(u * l.width, l.width);
+        const int y = WrapTexel(v * l.height, l.height);
+        const unsigned char *p = &l.rgba[(size_t(y) * l.width + x) * 4];
+        for (int c = 0; c < 4; c++)
+            rgba[c] = p[c];
+    }
+
+    void sampleLinear(int level, double u, double v, float *rgba) const
+    {
+        const Level &l = levels[level];
+        const double s = u * l.width - 0.5;
+        const double t = v * l.height - 0.5;
+        const double fs = std::floor(s);
+        const double ft = std::floor(t);
+        const float ws = float(s - fs);
+        const float wt = float(t - ft);
+        const int x0 = WrapTexel(fs, l.width);
+        const int y0 = WrapTexel(ft, l.height);
+        const int x1 = (x0 + 1 == l.width) ? 0 : x0 + 1;
+        const int y1 = (y0 + 1 == l.height) ? 0 : y0 + 1;
+        const unsigned char *p00 = &l.rgba[(size_t(y0) * l.width + x0) * 4];
+        const unsigned char *p01 = &l.rgba[(size_t(y0) * l.width + x1) * 4];
+        const unsigned char *p10 = &l.rgba[(size_t(y1) * l.width + x0) * 4];
+        const unsigned char *p11 = &l.rgba[(size_t(y1) * l.width + x1) * 4];
+        for (int c = 0; c < 4; c++)
+        {
+            const float top = p00[c] + (p01[c] - p00[c]) * ws;
+            const float bottom = p10[c] + (p11[c] - p10[c]) * ws;
+            rgba[c] = top + (bottom - top) * wt;
+        }
+    }
+};
+
+struct SoftwareRasterizer::Vertex
+{
+    double x;       // window pixels
+    double y;
+    double d;       // window depth
+    double u;
+    double v;
+};
+
+struct SoftwareRasterizer::Triangle
+{
+    // Edge functions e = a * px + b * py + c in sub-pixel units, biased so a pixel
+    // center is covered when all three are >= 0 (shared edges are drawn once).
+    int64_t a[3];
+    int64_t b[3];
+    int64_t c[3];
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+
+    // Attribute planes: f(x, y) = f00 + fdx * x + fdy * y at the center of pixel (x, y).
+    // Under an orthographic projection w is 1, so these are also perspective correct.
+    double d00, ddx, ddy;
+    double u00, udx, udy;
+    double v00, vdx, vdy;
+
+    const Texture *texture;
+    int level;
+    bool linear;
+};
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height) :
+    width(width),
+    height(height),
+    tilesX((width + TILE_SIZE - 1) / TILE_SIZE),
+    tilesY((height + TILE_SIZE - 1) / TILE_SIZE),
+    threads(0),
+    mipmaps(false),
+    textureBudget(size_t(1) << 30),
+    frame(0),
+    scaleX(1),
+    scaleY(1),
+    offsetX(0),
+    offsetY(0),
+    depthScale(1),
+    depthOffset(0),
+    pixels(size_t(width) * height * 3, 0),
+    depth(size_t(width) * height, 1.0f)
+{
+    log.init("SoftwareRasterizer");
+    setThreads(0);
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+}
+
+const char *SoftwareRasterizer::kernelName()
+{
+    return Kernels().name;
+}
+
+void SoftwareRasterizer::setThreads(int threads)
+{
+    if (threads <= 0)
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    this->threads = threads;
+}
+
+void SoftwareRasterizer::setMipmaps(bool enable)
+{
+    mipmaps = enable;
+}
+
+void SoftwareRasterizer::setTextureBudget(size_t bytes)
+{
+    textureBudget = bytes;
+}
+
+void SoftwareRasterizer::setOrtho(double left, double right, double bottom, double top, double zNear, double zFar)
+{
+    scaleX = width / (right - left);
+    offsetX = -left * scaleX;
+    scaleY = height / (top - bottom);
+    offsetY = -bottom * scaleY;
+    // glOrtho maps eye z to ndc -(2z + far + near) / (far - near); window depth is (ndc + 1) / 2.
+    depthScale = -1.0 / (zFar - zNear);
+    depthOffset = -zNear / (zFar - zNear);
+}
+
+void SoftwareRasterizer::clear()
+{
+    std::fill(pixels.begin(), pixels.end(), 0);
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    frame++;
+    evictTextures();
+}
+
+void SoftwareRasterizer::readPixels(unsigned char *dst) const
+{
+    memcpy(dst, pixels.data(), pixels.size());
+}
+
+void SoftwareRasterizer::readDepth(float *dst) const
+{
+    memcpy(dst, depth.data(), depth.size() * sizeof(float));
+}
+
+int SoftwareRasterizer::workerCount(size_t items) const
+{
+    return int(std::max<size_t>(1, std::min<size_t>(threads, (items + TRIANGLES_PER_WORKER - 1) / TRIANGLES_PER_WORKER)));
+}
+
+void SoftwareRasterizer::evictTextures()
+{
+    size_t total = 0;
+    for (auto &entry : textures)
+        total += entry.second->bytes();
+    if (total <= textureBudget)
+        return;
+    std::vector<std::pair<uint64_t, std::string>> age;
+    for (auto &entry : textures)
+        age.push_back(std::make_pair(entry.second->lastUsed, entry.first));
+    std::sort(age.begin(), age.end());
+    for (auto &entry : age)
+    {
+        if (total <= textureBudget)
+            break;
+        total -= textures[entry.second]->bytes();
+        textures.erase(entry.second);
+    }
+}
+
+void SoftwareRasterizer::loadTextures(const std::vector<std::string> &filenames)
+{
+    std::vector<std::string> missing;
+    for (auto &filename : filenames)
+    {
+        auto it = textures.find(filename);
+        if (it == textures.end())
+            missing.push_back(filename);
+        else if (mipmaps && it->second->valid && it->second->levels.size() == 1)
+            it->second->buildMipmaps();
+    }
+    if (missing.empty())
+        return;
+
+    std::vector<std::shared_ptr<Texture>> loaded(missing.size());
+    std::atomic<size_t> next(0);
+    RunWorkers(std::min<int>(threads, int(missing.size())), [&](int)
+    {
+        for (size_t i = next++; i < missing.size(); i = next++)
+        {
+            auto texture = std::make_shared<Texture>();
+            loaded[i] = texture;
+            ip::ImageInfo info;
+            ccl::binary buffer;
+            if (!ip::GetImagePixels(missing[i], info, buffer))
+                continue;
+            if (!info.interleaved || info.dataType != ip::ImageInfo::UBYTE || (info.depth != 3 && info.depth != 4))
+                continue;
+            // Same orientation as the GL texture upload in QuickObj::getOrLoadTextureID().
+            ip::FlipVertically(info, buffer);
+            Texture::Level level;
+            level.width = info.width;
+            level.height = info.height;
+            const size_t count = size_t(info.width) * info.height;
+            if (buffer.size() < count * info.depth)
+                continue;
+            level.rgba.resize(count * 4);
+            for (size_t p = 0; p < count; p++)
+            {
+                level.rgba[p * 4 + 0] = buffer[p * info.depth + 0];
+                level.rgba[p * 4 + 1] = buffer[p * info.depth + 1];
+                level.rgba[p * 4 + 2] = buffer[p * info.depth + 2];
+                level.rgba[p * 4 + 3] = (info.depth == 4) ? buffer[p * info.depth + 3] : 255;
+            }
+            texture->levels.push_back(std::move(level));
+            if (mipmaps)
+                texture->buildMipmaps();
+            texture->valid = true;
+        }
+    });
+
+    for (size_t i = 0; i < missing.size(); i++)
+    {
+        if (!loaded[i]->valid)
+            log << "Error, unable to read texture pixels for " << missing[i] << log.endl;
+        textures[missing[i]] = loaded[i];
+    }
+}
+
+const SoftwareRasterizer::Texture *SoftwareRasterizer::resolveTexture(const std::string &filename)
+{
+    if (filename.empty())
+        return NULL;
+    auto it = textures.find(filename);
+    if (it == textures.end())
+        return NULL;
+    it->second->lastUsed = frame;
+    return it->second->valid ? it->second.get() : NULL;
+}
+
+void SoftwareRasterizer::setupTriangle(const Vertex *v, const Texture *texture, std::vector<Triangle> &triangles, std::vector<std::vector<uint32_t>> &bins) const
+{
+    int64_t X[3];
+    int64_t Y[3];
+    for (int i = 0; i < 3; i++)
+    {
+        X[i] = int64_t(std::llround(v[i].x * SUBPIXEL));
+        Y[i] = int64_t(std::llround(v[i].y * SUBPIXEL));
+    }
+
+    // Counter-clockwise triangles are front facing; back faces and degenerate triangles are culled.
+    const int64_t area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+    if (area <= 0)
+        return;
+
+    // Pixels whose centers (x * SUBPIXEL + HALF_PIXEL) fall inside the snapped bounds.
+    const int64_t minXs = std::min(X[0], std::min(X[1], X[2]));
+    const int64_t maxXs = std::max(X[0], std::max(X[1], X[2]));
+    const int64_t minYs = std::min(Y[0], std::min(Y[1], Y[2]));
+    const int64_t maxYs = std::max(Y[0], std::max(Y[1], Y[2]));
+    Triangle tri;
+    tri.minX = int(std::max<int64_t>(0, FloorDiv(minXs - HALF_PIXEL + SUBPIXEL - 1, SUBPIXEL)));
+    tri.maxX = int(std::min<int64_t>(width - 1, FloorDiv(maxXs - HALF_PIXEL, SUBPIXEL)));
+    tri.minY = int(std::max<int64_t>(0, FloorDiv(minYs - HALF_PIXEL + SUBPIXEL - 1, SUBPIXEL)));
+    tri.maxY = int(std::min<int64_t>(height - 1, FloorDiv(maxYs - HALF_PIXEL, SUBPIXEL)));
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+        return;
+
+    for (int i = 0; i < 3; i++)
+    {
+        const int j = (i + 1) % 3;
+        const int64_t dx = X[j] - X[i];
+        const int64_t dy = Y[j] - Y[i];
+        tri.a[i] = -dy;
+        tri.b[i] = dx;
+        tri.c[i] = dy * X[i] - dx * Y[i];
+        // Left and top edges own the pixel centers that fall exactly on them.
+        const bool owner = (dy < 0) || (dy == 0 && dx < 0);
+        if (!owner)
+            tri.c[i] -= 1;
+    }
+
+    const double x0 = double(X[0]) / SUBPIXEL;
+    const double y0 = double(Y[0]) / SUBPIXEL;
+    const double dx1 = double(X[1] - X[0]) / SUBPIXEL;
+    const double dy1 = double(Y[1] - Y[0]) / SUBPIXEL;
+    const double dx2 = double(X[2] - X[0]) / SUBPIXEL;
+    const double dy2 = double(Y[2] - Y[0]) / SUBPIXEL;
+    const double det = dx1 * dy2 - dx2 * dy1;
+    auto plane = [&](double f0, double f1, double f2, double &f00, double &fdx, double &fdy)
+    {
+        fdx = ((f1 - f0) * dy2 - (f2 - f0) * dy1) / det;
+        fdy = ((f2 - f0) * dx1 - (f1 - f0) * dx2) / det;
+        f00 = f0 + fdx * (0.5 - x0) + fdy * (0.5 - y0);
+    };
+    plane(v[0].d, v[1].d, v[2].d, tri.d00, tri.ddx, tri.ddy);
+    plane(v[0].u, v[1].u, v[2].u, tri.u00, tri.udx, tri.udy);
+    plane(v[0].v, v[1].v, v[2].v, tri.v00, tri.vdx, tri.vdy);
+
+    tri.texture = texture;
+    tri.level = 0;
+    tri.linear = true;
+    if (texture)
+    {
+        // The texture footprint of a pixel is constant across an orthographic triangle,
+        // so the level of detail is chosen once here rather than per pixel.
+        const double w = texture->levels[0].width;
+        const double h = texture->levels[0].height;
+        const double rho = std::max(std::hypot(tri.udx * w, tri.vdx * h), std::hypot(tri.udy * w, tri.vdy * h));
+        const double lambda = std::log2(rho);
+        if (lambda > 0)
+        {
+            if (mipmaps && texture->levels.size() > 1)
+                tri.level = std::min(int(texture->levels.size()) - 1, int(std::floor(lambda + 0.5)));
+            else
+                tri.linear = false;
+        }
+    }
+
+    const uint32_t index = uint32_t(triangles.size());
+    triangles.push_back(tri);
+    for (int ty = tri.minY / TILE_SIZE; ty <= tri.maxY / TILE_SIZE; ty++)
+    {
+        for (int tx = tri.minX / TILE_SIZE; tx <= tri.maxX / TILE_SIZE; tx++)
+            bins[ty * tilesX + tx].push_back(index);
+    }
+}
+
+void SoftwareRasterizer::rasterizeTile(int tile, const std::vector<std::vector<Triangle>> &triangles, const std::vector<std::vector<std::vector<uint32_t>>> &bins)
+{
+    const int tileX0 = (tile % tilesX) * TILE_SIZE;
+    const int tileY0 = (tile / tilesX) * TILE_SIZE;
+    const int tileX1 = std::min(tileX0 + TILE_SIZE, width) - 1;
+    const int tileY1 = std::min(tileY0 + TILE_SIZE, height) - 1;
+    const CoverRowFunc coverRow = Kernels().coverRow;
+    uint8_t mask[TILE_SIZE];
+
+    for (size_t w = 0; w < triangles.size(); w++)
+    {
+        for (uint32_t index : bins[w][tile])
+        {
+            const Triangle &tri = triangles[w][index];
+            const int x0 = std::max(tri.minX, tileX0);
+            const int x1 = std::min(tri.maxX, tileX1);
+            const int y0 = std::max(tri.minY, tileY0);
+            const int y1 = std::min(tri.maxY, tileY1);
+            const int count = x1 - x0 + 1;
+            const int64_t px = x0 * SUBPIXEL + HALF_PIXEL;
+            const int64_t step[3] = { tri.a[0] * SUBPIXEL, tri.a[1] * SUBPIXEL, tri.a[2] * SUBPIXEL };
+            for (int y = y0; y <= y1; y++)
+            {
+                const int64_t py = y * SUBPIXEL + HALF_PIXEL;
+                const int64_t e[3] = {
+                    tri.a[0] * px + tri.b[0] * py + tri.c[0],
+                    tri.a[1] * px + tri.b[1] * py + tri.c[1],
+                    tri.a[2] * px + tri.b[2] * py + tri.c[2]
+                };
+                if (!coverRow(e, step, count, mask))
+                    continue;
+                const double drow = tri.d00 + tri.ddy * y;
+                const double urow = tri.u00 + tri.udy * y;
+                const double vrow = tri.v00 + tri.vdy * y;
+                const size_t row = size_t(y) * width;
+                for (int i = 0; i < count; i++)
+                {
+                    if (!mask[i])
+                        continue;
+                    const int x = x0 + i;
+                    // Fragments outside the near and far planes are clipped, as GL would.
+                    const double d = drow + tri.ddx * x;
+                    if (!(d >= 0.0 && d <= 1.0))
+                        continue;
+                    const float fd = float(d);
+                    float &dst = depth[row + x];
+                    if (!(fd < dst))
+                        continue;
+                    dst = fd;
+                    unsigned char *p = &pixels[(row + x) * 3];
+                    if (!tri.texture)
+                    {
+                        p[0] = p[1] = p[2] = 255;
+                        continue;
+                    }
+                    float rgba[4];
+                    const double u = urow + tri.udx * x;
+                    const double v = vrow + tri.vdx * x;
+                    if (tri.linear)
+                        tri.texture->sampleLinear(tri.level, u, v, rgba);
+                    else
+                        tri.texture->sampleNearest(tri.level, u, v, rgba);
+                    const float alpha = rgba[3] / 255.0f;
+                    for (int c = 0; c < 3; c++)
+                        p[c] = (unsigned char)std::min(255.0f, rgba[c] * alpha + p[c] * (1.0f - alpha) + 0.5f);
+                }
+            }
+        }
+    }
+}
+
+bool SoftwareRasterizer::draw(cognitics::QuickObj &obj)
+{
+    struct DrawCall
+    {
+        const cognitics::QuickSubMesh *submesh;
+        const Texture *texture;
+        size_t first;
+    };
+
+    std::vector<std::string> textureNames;
+    std::vector<std::string> submeshTextures;
+    bool result = true;
+    for (auto &submesh : obj.subMeshes)
+    {
+        if (submesh.vertIdxs.size() != submesh.uvIdxs.size())
+        {
+            // QuickObj::glRender() stops at the same submesh.
+            log << "The number of vertices does not match the number of UV coordinates." << log.endl;
+            result = false;
+            break;
+        }
+        auto it = obj.materialMap.find(submesh.materialName);
+        submeshTextures.push_back((it != obj.materialMap.end()) ? it->second.textureFile : std::string());
+        if (!submeshTextures.back().empty())
+            textureNames.push_back(submeshTextures.back());
+    }
+    std::sort(textureNames.begin(), textureNames.end());
+    textureNames.erase(std::unique(textureNames.begin(), textureNames.end()), textureNames.end());
+    loadTextures(textureNames);
+
+    std::vector<DrawCall> calls;
+    size_t total = 0;
+    for (size_t i = 0; i < submeshTextures.size(); i++)
+    {
+        const cognitics::QuickSubMesh &submesh = obj.subMeshes[i];
+        DrawCall call = { &submesh, resolveTexture(submeshTextures[i]), total };
+        calls.push_back(call);
+        total += submesh.vertIdxs.size() / 3;
+    }
+    if (total == 0)
+        return result;
+
+    const std::vector<cognitics::QuickVert> &verts = obj.verts;
+    const std::vector<cognitics::QuickVert> &uvs = obj.uvs;
+    const int tiles = tilesX * tilesY;
+    std::atomic<size_t> invalid(0);
+
+    for (size_t batchBegin = 0; batchBegin < total; batchBegin += TRIANGLES_PER_BATCH)
+    {
+        const size_t batchEnd = std::min(total, batchBegin + TRIANGLES_PER_BATCH);
+        const int workers = workerCount(batchEnd - batchBegin);
+        std::vector<std::vector<Triangle>> triangles(workers);
+        std::vector<std::vector<std::vector<uint32_t>>> bins(workers, std::vector<std::vector<uint32_t>>(tiles));
+
+        // Each worker sets up a contiguous run of triangles, so walking the workers in
+        // order during rasterization preserves the submission order within every tile.
+        RunWorkers(workers, [&](int w)
+        {
+            const size_t begin = batchBegin + (batchEnd - batchBegin) * w / workers;
+            const size_t end = batchBegin + (batchEnd - batchBegin) * (w + 1) / workers;
+            auto call = std::upper_bound(calls.begin(), calls.end(), begin, [](size_t t, const DrawCall &c) { return t < c.first; }) - 1;
+            size_t skipped = 0;
+            for (size_t t = begin; t < end; t++)
+            {
+                while ((call + 1) != calls.end() && (call + 1)->first <= t)
+                    ++call;
+                const cognitics::QuickSubMesh &submesh = *call->submesh;
+                const size_t base = (t - call->first) * 3;
+                Vertex v[3];
+                bool valid = true;
+                for (int j = 0; j < 3; j++)
+                {
+                    const uint32_t vi = submesh.vertIdxs[base + j];
+                    const uint32_t ui = submesh.uvIdxs[base + j];
+                    if (vi == 0 || ui == 0 || vi >= verts.size() || ui >= uvs.size())
+                    {
+                        valid = false;
+                        break;
+                    }
+                    v[j].x = verts[vi].x * scaleX + offsetX;
+                    v[j].y = verts[vi].y * scaleY + offsetY;
+                    v[j].d = verts[vi].z * depthScale + depthOffset;
+                    v[j].u = uvs[ui].x;
+                    v[j].v = uvs[ui].y;
+                }
+                if (!valid)
+                {
+                    skipped++;
+                    continue;
+                }
+
+                // Trivially outside the buffer or entirely in front of / behind the clip volume.
+                const double minX = std::min(v[0].x, std::min(v[1].x, v[2].x));
+                const double maxX = std::max(v[0].x, std::max(v[1].x, v[2].x));
+                const double minY = std::min(v[0].y, std::min(v[1].y, v[2].y));
+                const double maxY = std::max(v[0].y, std::max(v[1].y, v[2].y));
+                if (!(maxX >= 0 && minX <= width && maxY >= 0 && minY <= height))
+                    continue;
+                if ((v[0].d < 0 && v[1].d < 0 && v[2].d < 0) || (v[0].d > 1 && v[1].d > 1 && v[2].d > 1))
+                    continue;
+
+                if (minX >= -GUARD_BAND && maxX <= width + GUARD_BAND && minY >= -GUARD_BAND && maxY <= height + GUARD_BAND)
+                {
+                    setupTriangle(v, call->texture, triangles[w], bins[w]);
+                    continue;
+                }
+
+                // Clip against the guard band so snapped coordinates stay small, then fan.
+                std::vector<Vertex> polygon(v, v + 3);
+                for (int edge = 0; edge < 4 && polygon.size() >= 3; edge++)
+                {
+                    auto distance = [&](const Vertex &p)
+                    {
+                        switch (edge)
+                        {
+                        case 0: return p.x + GUARD_BAND;
+                        case 1: return (width + GUARD_BAND) - p.x;
+                        case 2: return p.y + GUARD_BAND;
+                        default: return (height + GUARD_BAND) - p.y;
+                        }
+                    };
+                    std::vector<Vertex> clipped;
+                    for (size_t k = 0; k < polygon.size(); k++)
+                    {
+                        const Vertex &a = polygon[k];
+                        const Vertex &b = polygon[(k + 1) % polygon.size()];
+                        const double da = distance(a);
+                        const double db = distance(b);
+                        if (da >= 0)
+                            clipped.push_back(a);
+                        if ((da >= 0) != (db >= 0))
+                        {
+                            const double s = da / (da - db);
+                            Vertex p;
+                            p.x = a.x + (b.x - a.x) * s;
+                            p.y = a.y + (b.y - a.y) * s;
+                            p.d = a.d + (b.d - a.d) * s;
+                            p.u = a.u + (b.u - a.u) * s;
+                            p.v = a.v + (b.v - a.v) * s;
+                            clipped.push_back(p);
+                        }
+                    }
+                    polygon.swap(clipped);
+                }
+                for (size_t k = 2; k < polygon.size(); k++)
+                {
+                    const Vertex fan[3] = { polygon[0], polygon[k - 1], polygon[k] };
+                    setupTriangle(fan, call->texture, triangles[w], bins[w]);
+                }
+            }
+            invalid += skipped;
+        });
+
+        std::atomic<int> nextTile(0);
+        RunWorkers(std::min(threads, tiles), [&](int)
+        {
+            for (int tile = nextTile++; tile < tiles; tile = nextTile++)
+                rasterizeTile(tile, triangles, bins);
+        });
+    }
+
+    if (invalid > 0)
+    {
+        log << "Skipped " << invalid << " triangles with invalid vert/UV indices in " << obj.objFilename << log.endl;
+        result = false;
+    }
+    return result;
+}
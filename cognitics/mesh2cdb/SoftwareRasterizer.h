@@ -0,0 +1,93 @@
+#pragma once
+
+#include "scenegraphobj/quickobj.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Tiled, multi-threaded replacement for the OpenGL render in meshrender.cpp.
+ *
+ * Produces the same buffers the GL path reads back: an orthographic view of
+ * the AOI, back faces culled, GL_LESS depth test against a depth buffer
+ * cleared to 1, textures (REPEAT, LINEAR magnification, NEAREST
+ * minification) modulated by white and blended with SRC_ALPHA /
+ * ONE_MINUS_SRC_ALPHA over a black framebuffer. Both buffers are bottom-up,
+ * like glReadPixels.
+ *
+ * Triangles are set up and binned into 64x64 pixel tiles on worker threads,
+ * then each tile is rasterized by one thread in submission order, so the
+ * result does not depend on the number of threads. Coverage uses fixed point
+ * edge functions with 8 sub-pixel bits, evaluated several pixels at a time.
+ */
+class SoftwareRasterizer
+{
+public:
+    SoftwareRasterizer(int width, int height);
+    ~SoftwareRasterizer();
+
+    // 0 uses every hardware thread.
+    void setThreads(int threads);
+
+    // Sample the nearest mip level (bilinear within it) when minifying, instead of
+    // point sampling level 0 as the GL path does.
+    void setMipmaps(bool enable);
+
+    // Decoded textures are kept between frames until they use more than this many bytes.
+    void setTextureBudget(size_t bytes);
+
+    // Same arguments as glOrtho(); the viewport is always the whole buffer.
+    void setOrtho(double left, double right, double bottom, double top, double zNear, double zFar);
+
+    // Clears color to black and depth to 1.
+    void clear();
+
+    bool draw(cognitics::QuickObj &obj);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // RGB, width * height * 3 bytes.
+    void readPixels(unsigned char *dst) const;
+
+    // Window depth in [0,1], width * height floats.
+    void readDepth(float *dst) const;
+
+    // Name of the edge function kernel selected for this CPU.
+    static const char *kernelName();
+
+    struct Texture;
+    struct Triangle;
+    struct Vertex;
+
+private:
+    ccl::ObjLog log;
+    int width;
+    int height;
+    int tilesX;
+    int tilesY;
+    int threads;
+    bool mipmaps;
+    size_t textureBudget;
+    uint64_t frame;
+
+    double scaleX;
+    double scaleY;
+    double offsetX;
+    double offsetY;
+    double depthScale;
+    double depthOffset;
+
+    std::vector<unsigned char> pixels;
+    std::vector<float> depth;
+    std::map<std::string, std::shared_ptr<Texture>> textures;
+
+    int workerCount(size_t items) const;
+    const Texture *resolveTexture(const std::string &filename);
+    void loadTextures(const std::vector<std::string> &filenames);
+    void evictTextures();
+    void setupTriangle(const Vertex *v, const Texture *texture, std::vector<Triangle> &triangles, std::vector<std::vector<uint32_t>> &bins) const;
+    void rasterizeTile(int tile, const std::vector<std::vector<Triangle>> &triangles, const std::vector<std::vector<std::vector<uint32_t>>> &bins);
+};
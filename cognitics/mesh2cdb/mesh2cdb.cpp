@@ -49,6 +49,10 @@ int main(int argc, char **argv)
     //args.AddOption("metadata", 1, "<metadata.xml>", "Specify a metadata.xml file. Assumes ENU srs, use as alternative to -config");
     //args.AddOption("lod", 1, "<LOD>", "Maximum LOD to create, range is -10 through 20 for CDB");
     args.AddOption("cdb", 1, "<output path>", "Use the specified path, ignoring the contents of the config file.");
+    args.AddOption("renderer", 1, "<gl|cpu>", "Render with OpenGL (default) or the multi-threaded software rasterizer.");
+    args.AddOption("threads", 1, "<count>", "Worker threads for the software rasterizer (default: all cores).");
+    args.AddOption("mipmap", 0, "", "Software rasterizer: select mip levels when minifying textures.");
+    args.AddOption("loglevel", 1, "<level>", "Most verbose level logged: emerg ... debug (default: info).");
     args.AddOption("help",0,"","Display help, including sample xml file");
 
     if(args.Parse(argc,argv)==EXIT_FAILURE)
@@ -86,6 +90,36 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    RenderOptions renderOptions;
+    if (args.Option("renderer"))
+    {
+        std::string renderer = args.Parameters("renderer")[0];
+        if (renderer == "cpu")
+            renderOptions.backend = RenderBackend::CPU;
+        else if (renderer != "gl")
+        {
+            args.Usage("Unknown renderer " + renderer + ", expected gl or cpu.");
+            return 1;
+        }
+    }
+    if (args.Option("threads"))
+    {
+        renderOptions.threads = atoi(args.Parameters("threads")[0].c_str());
+    }
+    if (args.Option("mipmap"))
+    {
+        renderOptions.mipmaps = true;
+    }
+    setRenderOptions(renderOptions);
+
+    ccl::LOGLEVEL loglevel = ccl::LINFO;
+    if (args.Option("loglevel") && !ccl::Log::parseLevel(args.Parameters("loglevel")[0], loglevel))
+    {
+        args.Usage("Unknown log level " + args.Parameters("loglevel")[0] + ".");
+        return 1;
+    }
+    ccl::Log::instance()->setLevel(loglevel);
+
     Mesh2CDBParams parms;
     if (configXML.length() > 0)
     {
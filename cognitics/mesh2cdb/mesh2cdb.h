@@ -218,8 +218,7 @@ class Obj2CDB
     Mesh2CDBParams parms;
 
     std::vector<ObjFileInfo> objFiles;
-    sfa::BSP bsp;
-    std::map<sfa::Geometry *, sfa::LineString *> envelopes;
+    sfa::PackedRTree bsp;
     std::map<sfa::Geometry *, ObjFileInfo> bestTileLOD;
     Cognitics::CoordinateSystems::EllipsoidTangentPlane *ltp_ellipsoid;
 
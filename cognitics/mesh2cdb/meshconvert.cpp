@@ -279,7 +279,7 @@ void Obj2CDB::buildBSP()
         //delete scene;
     }
 
-    bsp.generate(envelopes);
+    bsp.generate();
     dbLeftLon = 0;
     dbRightLon = 0;
     dbBottomLat = 0;
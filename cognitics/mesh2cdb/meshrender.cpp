@@ -7,6 +7,7 @@
 #include <ccl/Timer.h>
 #include <cdb_util/cdb_lod.h>
 #include <chrono>
+#include <memory>
 
 #include "scenegraphobj/scenegraphobj.h"
 //#include "ip/pngwrapper.h"
@@ -25,6 +26,7 @@
 #include <GL/freeglut_ext.h>
 #include <scenegraph_gl/scenegraph_gl.h>
 #include "MeshRender.h"
+#include "SoftwareRasterizer.h"
 #include "ip/pngwrapper.h"
 #include "scenegraphobj/quickobj.h"
 #pragma warning ( push )
@@ -73,6 +75,8 @@ namespace
     scenegraph::ExtentsVisitor extentsVisitor;
     scenegraph::Scene *fixedScene = NULL;
     renderJobList_t renderJobs;
+    RenderOptions renderOptions;
+    std::unique_ptr<SoftwareRasterizer> rasterizer;
 }
 
 
@@ -95,6 +99,11 @@ void resetAOIForScene(RenderJob job)
     setAOI(left, bottom, right, top);
 }
 
+void setRenderOptions(const RenderOptions &options)
+{
+    renderOptions = options;
+}
+
 void setAOI(double llx, double lly, double urx, double  ury)
 {
     window_llx = llx;
@@ -372,6 +381,48 @@ struct objinfo_compare
 };
 
 
+cognitics::QuickObj *getOrLoadObj(const ObjFileInfo &ofi, const ObjSrs &srs)
+{
+    std::string file = ofi.fi.getFileName();
+    cognitics::QuickObj *qo = cognitics::gObjCache.get(file);
+    if(!qo)
+    {
+        logger << "Loading " << file << logger.endl;
+        qo = new cognitics::QuickObj(file, srs, ofi.fi.getDirName(), true);
+        cognitics::gObjCache.store(qo);
+    }
+    if(!qo->isValid())
+    {
+        logger << "Unable to load " << file << logger.endl;
+        return NULL;
+    }
+    logger << "Rendering " << file << logger.endl;
+    return qo;
+}
+
+/*
+ * Takes ownership of the bottom-up RGB pixels and window depth read back from
+ * either renderer, converts depth to elevation and queues the output files.
+ */
+void queueRenderOutputs(RenderJob &job, unsigned char *pixels, float *grid, int width, int height)
+{
+    FlipVertically(pixels, width, height, 3);
+    double zFar = 5000;
+    double zNear = -5000;
+    for (int i = 0, ic = width * height; i < ic; i++)
+    {
+        if (grid[i] == 1)
+            grid[i] = -32767.0;
+        else
+        {
+            grid[i] = -1 * (zNear + (grid[i] * (zFar - zNear)));
+        }
+    }
+    FlipVertically(grid, width, height);
+    queueDEMJob(job, grid, width, height);
+    queueJP2Job(job, pixels, width, height);
+}
+
 #define QUICK_OBJ
 void renderToFile(RenderJob &job)
 {
@@ -488,23 +539,9 @@ void renderToFile(RenderJob &job)
     std::sort(job.objFiles.begin(), job.objFiles.end(), objinfo_compare());
     for(auto&& ofi : job.objFiles)
     {
-        std::string file = ofi.fi.getFileName();
-        cognitics::QuickObj *qo = cognitics::gObjCache.get(file);
-        if(!qo)
-        {
-            logger << "Loading " << file << logger.endl;
-            qo = new cognitics::QuickObj(file, job.srs, ofi.fi.getDirName(), true);
-            cognitics::gObjCache.store(qo);
-        }
-        if(qo->isValid())
-        {
-            logger << "Rendering " << file << logger.endl;
+        cognitics::QuickObj *qo = getOrLoadObj(ofi, job.srs);
+        if(qo)
             qo->glRender();
-        }
-        else
-        {
-            logger << "Unable to load " << file << logger.endl;
-        }
     }
 #else
     renderVisitor.visit(scene);
@@ -517,31 +554,50 @@ void renderToFile(RenderJob &job)
     //glutSwapBuffers();
     unsigned char *pixels = new unsigned char[width * height * depth];
     glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels);
-    FlipVertically(pixels, width, height, 3);
 
     float *grid = new float[width*height];
     glBindTexture(GL_TEXTURE_2D, depth_texture);
     glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, grid);
-    double zFar = 5000;
-    double zNear = -5000;
-    for (int i = 0, ic = width * height; i < ic; i++)
-    {
-        if (grid[i] == 1)
-            grid[i] = -32767.0;
-        else
-        {
-            grid[i] = -1 * (zNear + (grid[i] * (zFar - zNear)));
-        }
-    }
     glDeleteTextures(1, &depth_texture);
     glDeleteTextures(1, &renderedTexture);
-    FlipVertically(grid, width, height);
-    queueDEMJob(job, grid, width, height);
-    queueJP2Job(job, pixels, width, height);
+    queueRenderOutputs(job, pixels, grid, width, height);
     delete scene;
     scene = NULL;
 }
 
+void renderToFileCPU(RenderJob &job)
+{
+    int width = 1024;
+    int height = 1024;
+    resetAOIForScene(job);
+
+    if (!rasterizer)
+    {
+        rasterizer.reset(new SoftwareRasterizer(width, height));
+        rasterizer->setThreads(renderOptions.threads);
+        rasterizer->setMipmaps(renderOptions.mipmaps);
+        logger << "Software rasterizer using " << SoftwareRasterizer::kernelName() << " edge functions" << logger.endl;
+    }
+    // Same projection as the GL path
+    rasterizer->setOrtho(window_llx, window_urx, window_lly, window_ury, -5000, 5000);
+    rasterizer->clear();
+
+    logger << "Sorting for " << job.cdbFilename << logger.endl;
+    std::sort(job.objFiles.begin(), job.objFiles.end(), objinfo_compare());
+    for(auto&& ofi : job.objFiles)
+    {
+        cognitics::QuickObj *qo = getOrLoadObj(ofi, job.srs);
+        if(qo)
+            rasterizer->draw(*qo);
+    }
+
+    unsigned char *pixels = new unsigned char[width * height * 3];
+    rasterizer->readPixels(pixels);
+    float *grid = new float[width*height];
+    rasterizer->readDepth(grid);
+    queueRenderOutputs(job, pixels, grid, width, height);
+}
+
 
 bool renderingToFile = true;
 float totalCDBTileCount = 0;
@@ -580,7 +636,7 @@ void glutRenderScene()
 }
 
 #define CHECK_EGL_ERR do { EGLint err = eglGetError(); if (err != EGL_SUCCESS) { printf("Error line %d: 0x%.4x\n", __LINE__, err); } } while (false)
-bool renderInit(int argc, char **argv, renderJobList_t &jobs, const std::string &cdbRoot)
+bool initGL(int argc, char **argv)
 {
 #ifdef WIN32
 #ifdef USE_EGL
@@ -675,6 +731,18 @@ bool renderInit(int argc, char **argv, renderJobList_t &jobs, const std::string
     glewInit();
 
 #endif
+
+    // OpenGL init
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    return true;
+}
+
+bool renderInit(int argc, char **argv, renderJobList_t &jobs, const std::string &cdbRoot)
+{
+    if (renderOptions.backend == RenderBackend::GL && !initGL(argc, argv))
+        return false;
+
     totalCDBTileCount = jobs.size();
 
     rootCDBOutput = cdbRoot;
@@ -685,17 +753,16 @@ bool renderInit(int argc, char **argv, renderJobList_t &jobs, const std::string
     logger.init("OBJ Render");
     logger << ccl::LINFO;
 
-    // OpenGL init
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
-
 #ifndef USE_EGL
-    // enter GLUT event processing cycle
-       // register callbacks
-    glutDisplayFunc(glutRenderScene);
-    glutIdleFunc(glutRenderScene);
+    if (renderOptions.backend == RenderBackend::GL)
+    {
+        // enter GLUT event processing cycle
+        // register callbacks
+        glutDisplayFunc(glutRenderScene);
+        glutIdleFunc(glutRenderScene);
 
-    glutMainLoop();
+        glutMainLoop();
+    }
 #endif
     while(true)
     {
@@ -755,7 +822,10 @@ bool renderScene(void)
     if (renderingToFile)
     {
         renderJobs.pop_back();
-        renderToFile(job);
+        if (renderOptions.backend == RenderBackend::CPU)
+            renderToFileCPU(job);
+        else
+            renderToFile(job);
         float jobsLeft = renderJobs.size();
         if((renderJobs.size() % 10)==0)
         {
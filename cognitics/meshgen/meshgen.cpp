@@ -48,6 +48,7 @@ int usage(const std::string &error = std::string())
 	std::cout << "\t-endLOD <lod>\tspecifies the higher LOD of the desired export (default: 8)" << std::endl;
 	std::cout << "\t-projection <projection>\tspecifies the projection of the extents" << std::endl;
 	std::cout << "\t-combineMeshes \tindicates that the feature meshes should be combined with the terrain mesh" << std::endl;
+    std::cout << "\t-loglevel <level>\tspecifies the most verbose level logged: emerg ... debug (default: info)" << std::endl;
     if (error.size())
         std::cerr << "ERROR: " << error << std::endl;
     return (error.size()) ? -1 : 0;
@@ -59,6 +60,7 @@ int main(int argc, char **argv)
     logger << ccl::LINFO;
     cognitics::gdal::init(argv[0]);
     ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
+    ccl::Log::instance()->setLevel(ccl::LINFO);
 
     ccl::Timer execTimer;
     execTimer.startTimer();
@@ -292,6 +294,15 @@ int main(int argc, char **argv)
 			combineMeshes = true;
 			continue;
 		}
+        if (param == "-loglevel")
+        {
+            ++argi;
+            ccl::LOGLEVEL level;
+            if ((argi >= argc) || !ccl::Log::parseLevel(argv[argi], level))
+                return usage("Missing or invalid log level");
+            ccl::Log::instance()->setLevel(level);
+            continue;
+        }
 
         if (param == "-text")
             return usage("Invalid parameters");
@@ -80,6 +80,7 @@ int main(int argc, char **argv)
     cognitics::ArgumentParser args;
     
     args.AddOption("metadata",1,"<metadata-filename>","Specify metadata file with the origin and offsets.");
+    args.AddOption("loglevel", 1, "<level>", "Most verbose level logged: emerg ... debug (default: info).");
     args.AddArgument("Input OBJ File");
 
     if(args.Parse(argc,argv)==EXIT_FAILURE)
@@ -88,6 +89,13 @@ int main(int argc, char **argv)
     }
     std::string metadataXML;
     std::string objRootDir = args.Arguments()[0];
+    ccl::LOGLEVEL loglevel = ccl::LINFO;
+    if(args.Option("loglevel") && !ccl::Log::parseLevel(args.Parameters("loglevel")[0], loglevel))
+    {
+        args.Usage("Unknown log level " + args.Parameters("loglevel")[0] + ".");
+        return EXIT_FAILURE;
+    }
+    ccl::Log::instance()->setLevel(loglevel);
     /*
     if(args.Option("metadata"))
     {
@@ -69,6 +69,7 @@ int main(int argc, char **argv)
 		logger << ccl::LINFO;
 		GDALAllRegister();
 		ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
+		ccl::Log::instance()->setLevel(ccl::LINFO);
 		
 		logger << "test" << logger.endl;
 
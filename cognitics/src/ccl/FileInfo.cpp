@@ -347,14 +347,17 @@ namespace ccl
 
   uint64_t getFileSize(const std::string &filePath)
     {
-        uint64_t flen = 0;
         FILE *file = fopen(filePath.c_str(),"rb");
         if(!file)
         return 0;
-        fseek(file,0,SEEK_END);
-        flen = ftell(file);
+        // ftell() is 32 bits on Windows and fails past 2GB
+#ifdef WIN32
+        int64_t flen = (_fseeki64(file,0,SEEK_END) == 0) ? _ftelli64(file) : -1;
+#else
+        int64_t flen = (fseeko(file,0,SEEK_END) == 0) ? int64_t(ftello(file)) : -1;
+#endif
         fclose(file);
-        return flen;
+        return (flen < 0) ? 0 : uint64_t(flen);
     }
 
   bool copyFilesRecursive(const std::string &srcDir, const std::string &destDir, const std::vector<std::string>& extensions)
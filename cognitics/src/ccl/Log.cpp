@@ -22,7 +22,32 @@ DEALINGS IN THE SOFTWARE.
 
 #include "ccl/Log.h"
 
+#include <cctype>
+
 namespace ccl
 {
     LogSP Log::_instance = LogSP();
+    std::atomic<int> Log::_level(-1);
+    std::atomic<int> Log::_threshold(LDEBUG.value);
+
+    bool Log::parseLevel(const std::string &name, struct LOGLEVEL &level)
+    {
+        static const char *names[] = { "emerg", "alert", "crit", "err", "warning", "notice", "info", "debug" };
+        std::string lower;
+        for(size_t i = 0; i < name.size(); ++i)
+            lower.push_back(char(std::tolower((unsigned char)name[i])));
+        if(lower == "error")
+            lower = "err";
+        if(lower == "warn")
+            lower = "warning";
+        for(char i = 0; i < 8; ++i)
+        {
+            if((lower == names[int(i)]) || ((lower.size() == 1) && (lower[0] == '0' + i)))
+            {
+                level.value = i;
+                return true;
+            }
+        }
+        return false;
+    }
 }
\ No newline at end of file
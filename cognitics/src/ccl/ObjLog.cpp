@@ -22,36 +22,185 @@ DEALINGS IN THE SOFTWARE.
 
 #include "ccl/ObjLog.h"
 
+#include <streambuf>
+
 namespace ccl
 {
-    ObjLog::ObjLog(void) : prefix(""), str(""), level(LNOTICE)
+    namespace
+    {
+        // Appends to a std::string, which keeps its capacity between messages.
+        class MessageBuffer : public std::streambuf
+        {
+        public:
+            std::string data;
+
+        protected:
+            virtual int_type overflow(int_type c)
+            {
+                if(!traits_type::eq_int_type(c, traits_type::eof()))
+                    data.push_back(traits_type::to_char_type(c));
+                return traits_type::not_eof(c);
+            }
+
+            virtual std::streamsize xsputn(const char *s, std::streamsize n)
+            {
+                data.append(s, size_t(n));
+                return n;
+            }
+        };
+
+        struct Message
+        {
+            std::string test;               // PASS/FAIL status of this message
+            MessageBuffer buffer;
+            std::ostream stream;
+
+            Message(void) : stream(&buffer) { }
+
+            void release(void)
+            {
+                test.clear();
+                buffer.data.clear();
+                stream.clear();
+                stream.flags(std::ios_base::dec | std::ios_base::skipws);
+                stream.precision(6);
+                stream.width(0);
+                stream.fill(' ');
+            }
+        };
+
+        // Who owns each message slot and at what level. Kept apart from the buffers, and plain
+        // data, so a disabled statement never touches (or constructs) a stream.
+        struct Slot
+        {
+            const ObjLog *owner;
+            struct LOGLEVEL level;
+            bool formatted;                 // messages[] holds something to clear
+        };
+
+        // One slot per ObjLog with a message in progress on this thread; more than one only
+        // when formatting a token writes to another log before the first message ends.
+        const size_t MaxMessages = 4;
+        thread_local Slot slots[MaxMessages];
+        thread_local Message messages[MaxMessages];
+
+        Slot *findSlot(const ObjLog *owner)
+        {
+            for(size_t i = 0; i < MaxMessages; ++i)
+            {
+                if(slots[i].owner == owner)
+                    return &slots[i];
+            }
+            return NULL;
+        }
+
+        void release(Slot *slot)
+        {
+            slot->owner = NULL;
+            if(slot->formatted)
+            {
+                messages[slot - slots].release();
+                slot->formatted = false;
+            }
+        }
+
+        // A slot that only holds a level (e.g. "log << LINFO;" with no endl) can be taken over.
+        Slot *claimSlot(const ObjLog *owner, struct LOGLEVEL level)
+        {
+            Slot *slot = findSlot(owner);
+            if(!slot)
+                slot = findSlot(NULL);
+            for(size_t i = 0; !slot && (i < MaxMessages); ++i)
+            {
+                if(!slots[i].formatted)
+                    slot = &slots[i];
+            }
+            if(!slot)
+                slot = &slots[MaxMessages - 1];    // nested deeper than the slots; share the last one
+            slot->owner = owner;
+            slot->level = level;
+            return slot;
+        }
+
+        std::ostream &format(Slot *slot)
+        {
+            slot->formatted = true;
+            return messages[slot - slots].stream;
+        }
+    }
+
+    ObjLog::ObjLog(void) : prefix(""), level(LNOTICE.value)
     {
     }
 
-    ObjLog::ObjLog(const char *name, void *obj) : prefix(""), str(""), level(LNOTICE)
+    ObjLog::ObjLog(const char *name, void *obj) : prefix(""), level(LNOTICE.value)
     {
         init(name, obj);
     }
 
+    ObjLog::ObjLog(const ObjLog &other) : prefix(other.prefix), level(other.level.load(std::memory_order_relaxed))
+    {
+    }
+
+    ObjLog &ObjLog::operator=(const ObjLog &other)
+    {
+        prefix = other.prefix;
+        level.store(other.level.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    ObjLog::~ObjLog(void)
+    {
+        Slot *slot = findSlot(this);
+        if(slot)
+            release(slot);
+    }
+
+    std::ostream *ObjLog::stream(void)
+    {
+        Slot *slot = findSlot(this);
+        if(slot)
+            return enabled(slot->level) ? &format(slot) : NULL;
+        struct LOGLEVEL defaultLevel = { char(level.load(std::memory_order_relaxed)) };
+        if(!enabled(defaultLevel))
+            return NULL;
+        return &format(claimSlot(this, defaultLevel));
+    }
+
     ObjLog &ObjLog::operator<<(const struct LOGLEVEL &level)
     {
-        this->level = level;
+        if(this->level.load(std::memory_order_relaxed) != level.value)
+            this->level.store(level.value, std::memory_order_relaxed);
+        claimSlot(this, level);
         return *this;
     }
 
     ObjLog &ObjLog::operator<<(const nl &)
     {
-        _mutex.lock();
-        std::string prestr = prefix;
-        if(test.size())
-            prestr += "\t" + test + "\t";
-        if(this->level.value == LDEBUG.value)
-            Log::instance()->write(this->level, prestr + str.str());
-        else
-            Log::instance()->write(this->level, str.str());
-        test = "";
-        str.str("");
-        _mutex.unlock();
+        Slot *slot = findSlot(this);
+        if(!slot)
+        {
+            // an empty message at the default level
+            struct LOGLEVEL defaultLevel = { char(level.load(std::memory_order_relaxed)) };
+            if(!enabled(defaultLevel))
+                return *this;
+            slot = claimSlot(this, defaultLevel);
+        }
+        // nothing is buffered at a disabled level
+        if(enabled(slot->level))
+        {
+            Message &message = messages[slot - slots];
+            std::string &str = message.buffer.data;
+            if(slot->level.value == LDEBUG.value)
+            {
+                str.insert(0, prefix);
+                if(message.test.size())
+                    str.insert(prefix.size(), "\t" + message.test + "\t");
+            }
+            Log::instance()->write(slot->level, str);
+            slot->formatted = true;
+        }
+        release(slot);
         return *this;
     }
 
@@ -62,9 +211,7 @@ namespace ccl
         if(obj)
             ss << "[" << obj << "]";
         ss << ": ";
-        _mutex.lock();
         prefix = ss.str();
-        _mutex.unlock();
     }
 
 }
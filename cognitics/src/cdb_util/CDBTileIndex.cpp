@@ -0,0 +1,642 @@
+
+#include <cdb_util/CDBTileIndex.h>
+
+#include <ccl/ObjLog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#if _WIN32
+#include <filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#elif __GNUC__ && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#else
+#include <filesystem>
+#endif
+
+namespace cognitics {
+namespace cdb {
+
+namespace
+{
+    const char SIDECAR_MAGIC[8] = { 'C', 'D', 'B', 'T', 'I', 'D', 'X', '1' };
+
+    // Levels up to this many tiles use a bitset (LOD 10 = 128KB); larger ones use a hash.
+    const uint64_t MAX_BITSET_TILES = uint64_t(1) << 20;
+
+    // The same CDB may be named with a relative path, trailing separators or through
+    // a link; the canonical path is used whenever the root exists.
+    std::string NormalizedRoot(const std::string& cdb)
+    {
+        auto result = cdb;
+        auto ec = std::error_code();
+        auto canonical = std::filesystem::canonical(std::filesystem::path(cdb), ec);
+        if(!ec)
+            result = canonical.string();
+        while((result.size() > 1) && ((result.back() == '/') || (result.back() == '\\')))
+            result.pop_back();
+        return result;
+    }
+
+    // Matches the extension CoverageTilesForTiles has always appended.
+    std::string TileExtensionForDataset(int dataset)
+    {
+        if(dataset == 1)
+            return ".tif";
+        if(dataset == 4)
+            return ".jp2";
+        return "";
+    }
+
+    int64_t DirectoryTime(const std::filesystem::path& path)
+    {
+        auto ec = std::error_code();
+        auto t = std::filesystem::last_write_time(path, ec);
+        if(ec)
+            return 0;
+        return int64_t(t.time_since_epoch().count());
+    }
+
+    std::vector<std::filesystem::path> SubDirectories(const std::filesystem::path& path)
+    {
+        auto result = std::vector<std::filesystem::path>();
+        auto ec = std::error_code();
+        for(auto it = std::filesystem::directory_iterator(path, ec); !ec && (it != std::filesystem::directory_iterator()); it.increment(ec))
+        {
+            auto type_ec = std::error_code();
+            if(std::filesystem::is_directory(it->path(), type_ec))
+                result.push_back(it->path());
+        }
+        return result;
+    }
+
+    // "N32" -> 32, "S05" -> -5, "W118" -> -118
+    bool ParseGeocellComponent(const std::string& name, int& value)
+    {
+        if(name.size() < 2)
+            return false;
+        try
+        {
+            value = std::stoi(name.substr(1));
+        }
+        catch(std::exception&)
+        {
+            return false;
+        }
+        if((name[0] == 'S') || (name[0] == 'W'))
+            value = -value;
+        return true;
+    }
+
+    template <typename T> void WriteValue(std::ostream& os, const T& value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T> bool ReadValue(std::istream& is, T& value)
+    {
+        is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return bool(is);
+    }
+}
+
+bool CDBTileIndex::LevelKey::operator<(const LevelKey& rhs) const
+{
+    return std::tie(latitude, longitude, selector1, selector2, lod) < std::tie(rhs.latitude, rhs.longitude, rhs.selector1, rhs.selector2, rhs.lod);
+}
+
+CDBTileIndex::Level::Level(int lod) : dimension(uint64_t(RowsForLOD(lod)))
+{
+    if(dimension * dimension <= MAX_BITSET_TILES)
+        bits.resize(((dimension * dimension) + 63) / 64);
+}
+
+bool CDBTileIndex::Level::Test(int uref, int rref) const
+{
+    if((uref < 0) || (rref < 0) || (uint64_t(uref) >= dimension) || (uint64_t(rref) >= dimension))
+        return false;
+    uint64_t index = (uint64_t(uref) * dimension) + uint64_t(rref);
+    if(!bits.empty())
+        return (bits[index / 64] >> (index % 64)) & 1;
+    return keys.find(index) != keys.end();
+}
+
+void CDBTileIndex::Level::Set(int uref, int rref)
+{
+    if((uref < 0) || (rref < 0) || (uint64_t(uref) >= dimension) || (uint64_t(rref) >= dimension))
+        return;
+    uint64_t index = (uint64_t(uref) * dimension) + uint64_t(rref);
+    if(!bits.empty())
+        bits[index / 64] |= (uint64_t(1) << (index % 64));
+    else
+        keys.insert(index);
+}
+
+void CDBTileIndex::Level::ClearRow(int uref)
+{
+    if((uref < 0) || (uint64_t(uref) >= dimension))
+        return;
+    if(!bits.empty())
+    {
+        for(uint64_t i = uint64_t(uref) * dimension, end = i + dimension; i < end; ++i)
+            bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+        return;
+    }
+    for(auto it = keys.begin(); it != keys.end(); )
+    {
+        if((*it / dimension) == uint64_t(uref))
+            it = keys.erase(it);
+        else
+            ++it;
+    }
+}
+
+size_t CDBTileIndex::Level::Count() const
+{
+    if(bits.empty())
+        return keys.size();
+    size_t result = 0;
+    for(auto word : bits)
+    {
+        for(; word; word &= word - 1)
+            ++result;
+    }
+    return result;
+}
+
+void CDBTileIndex::Level::Write(std::ostream& os) const
+{
+    WriteValue(os, dimension);
+    uint8_t is_bitset = bits.empty() ? 0 : 1;
+    WriteValue(os, is_bitset);
+    if(is_bitset)
+    {
+        uint64_t count = bits.size();
+        WriteValue(os, count);
+        os.write(reinterpret_cast<const char*>(bits.data()), count * sizeof(uint64_t));
+        return;
+    }
+    uint64_t count = keys.size();
+    WriteValue(os, count);
+    for(auto key : keys)
+        WriteValue(os, key);
+}
+
+bool CDBTileIndex::Level::Read(std::istream& is)
+{
+    uint64_t file_dimension = 0;
+    uint8_t is_bitset = 0;
+    uint64_t count = 0;
+    if(!ReadValue(is, file_dimension) || !ReadValue(is, is_bitset) || !ReadValue(is, count))
+        return false;
+    if((file_dimension != dimension) || (bool(is_bitset) == bits.empty()))
+        return false;
+    if(is_bitset)
+    {
+        if(count != bits.size())
+            return false;
+        is.read(reinterpret_cast<char*>(bits.data()), count * sizeof(uint64_t));
+        return bool(is);
+    }
+    keys.clear();
+    keys.reserve(count);
+    for(uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t key = 0;
+        if(!ReadValue(is, key))
+            return false;
+        keys.insert(key);
+    }
+    return true;
+}
+
+CDBTileIndex& CDBTileIndex::Instance()
+{
+    static CDBTileIndex instance;
+    return instance;
+}
+
+std::string CDBTileIndex::SidecarFilename(const std::string& cdb, int dataset)
+{
+    std::stringstream ss;
+    ss << NormalizedRoot(cdb) << "/Metadata/TileIndex_D" << std::setfill('0') << std::setw(3) << dataset << ".bin";
+    return ss.str();
+}
+
+bool CDBTileIndex::Exists(const std::string& cdb, const TileInfo& tileinfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& index = IndexFor(lock, RootFor(cdb), tileinfo.dataset);
+    auto it = index.levels.find(LevelKey{ tileinfo.latitude, tileinfo.longitude, tileinfo.selector1, tileinfo.selector2, tileinfo.lod });
+    if(it == index.levels.end())
+        return false;
+    return it->second.Test(tileinfo.uref, tileinfo.rref);
+}
+
+void CDBTileIndex::Insert(const std::string& cdb, const TileInfo& tileinfo)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = indexes.find(std::make_pair(RootFor(cdb), tileinfo.dataset));
+    if(it == indexes.end())
+        return;
+    // The directory time is left alone so the next Refresh() relists it.
+    auto key = LevelKey{ tileinfo.latitude, tileinfo.longitude, tileinfo.selector1, tileinfo.selector2, tileinfo.lod };
+    auto level = it->second->levels.emplace(key, Level(tileinfo.lod)).first;
+    level->second.Set(tileinfo.uref, tileinfo.rref);
+    inserted = true;
+}
+
+uint64_t CDBTileIndex::Generation()
+{
+    if(inserted.exchange(false))
+        ++generation;
+    return generation;
+}
+
+bool CDBTileIndex::Refresh(const std::string& cdb, int dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& root = RootFor(cdb);
+    if(indexes.find(std::make_pair(root, dataset)) == indexes.end())
+    {
+        IndexFor(lock, root, dataset);
+        return true;
+    }
+    return RefreshIndex(lock, root, dataset);
+}
+
+bool CDBTileIndex::RefreshIfStale(const std::string& cdb, int dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& root = RootFor(cdb);
+    auto it = indexes.find(std::make_pair(root, dataset));
+    if(it == indexes.end())
+        return false;
+    if(std::chrono::steady_clock::now() - it->second->refreshed < refresh_interval)
+        return false;
+    return RefreshIndex(lock, root, dataset);
+}
+
+void CDBTileIndex::SetRefreshInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    refresh_interval = interval;
+}
+
+void CDBTileIndex::SetWritable(const std::string& cdb, bool writable)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto root = RootFor(cdb);
+    if(writable)
+        writable_roots.insert(root);
+    else
+        writable_roots.erase(root);
+}
+
+void CDBTileIndex::Invalidate(const std::string& cdb)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto root = RootFor(cdb);
+    for(auto it = indexes.begin(); it != indexes.end(); )
+    {
+        if(it->first.first == root)
+            it = indexes.erase(it);
+        else
+            ++it;
+    }
+    version_chains.erase(root);
+    ++generation;
+    for(auto it = roots.begin(); it != roots.end(); )
+    {
+        if(it->second == root)
+            it = roots.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::vector<std::string> CDBTileIndex::VersionChain(const std::string& cdb)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto root = RootFor(cdb);
+    auto it = version_chains.find(root);
+    if(it != version_chains.end())
+        return it->second;
+    auto chain = VersionChainForCDB(cdb);
+    version_chains[root] = chain;
+    return chain;
+}
+
+size_t CDBTileIndex::TileCount(const std::string& cdb, int dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& index = IndexFor(lock, RootFor(cdb), dataset);
+    size_t result = 0;
+    for(auto& entry : index.levels)
+        result += entry.second.Count();
+    return result;
+}
+
+uint64_t CDBTileIndex::Fingerprint(const std::string& cdb, int dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& index = IndexFor(lock, RootFor(cdb), dataset);
+    uint64_t hash = 14695981039346656037ULL;    // FNV-1a
+    auto add = [&hash](const void* data, size_t size) {
+        for(size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<const unsigned char*>(data)[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    for(auto& entry : index.directories)
+    {
+        add(entry.first.data(), entry.first.size() + 1);
+        add(&entry.second, sizeof(entry.second));
+    }
+    return hash;
+}
+
+// Resolving a root touches the filesystem, so each spelling is resolved once.
+const std::string& CDBTileIndex::RootFor(const std::string& cdb)
+{
+    auto it = roots.find(cdb);
+    if(it == roots.end())
+        it = roots.emplace(cdb, NormalizedRoot(cdb)).first;
+    return it->second;
+}
+
+// Called with the lock held; it is released while a new index is loaded and scanned.
+// If another thread indexed the same dataset in the meantime, its index is kept.
+CDBTileIndex::DatasetIndex& CDBTileIndex::IndexFor(std::unique_lock<std::mutex>& lock, const std::string& cdb, int dataset)
+{
+    auto key = std::make_pair(cdb, dataset);
+    auto it = indexes.find(key);
+    if(it != indexes.end())
+        return *it->second;
+
+    bool writable = (writable_roots.count(cdb) > 0);
+    lock.unlock();
+    ccl::ObjLog log;
+    auto index = std::unique_ptr<DatasetIndex>(new DatasetIndex());
+    bool loaded = Load(key.first, dataset, *index);
+    auto scans = ScanChanges(key.first, dataset, index->directories);
+    ApplyScans(scans, *index);
+    index->refreshed = std::chrono::steady_clock::now();
+    if(writable && (!loaded || !scans.empty()))
+    {
+        std::lock_guard<std::mutex> save_lock(save_mutex);
+        Save(key.first, dataset, *index);
+    }
+    log << ccl::LDEBUG << "Indexed " << key.first << " dataset " << dataset << ": " << index->directories.size() << " directories" << (loaded ? " (from sidecar)" : "") << log.endl;
+    lock.lock();
+    return *indexes.emplace(key, std::move(index)).first->second;
+}
+
+// Called with the lock held. The directory listing is done without it; the changes
+// are then applied to whatever index is current, unless it was invalidated meanwhile.
+bool CDBTileIndex::RefreshIndex(std::unique_lock<std::mutex>& lock, const std::string& cdb, int dataset)
+{
+    auto key = std::make_pair(cdb, dataset);
+    auto it = indexes.find(key);
+    if(it == indexes.end())
+        return false;
+    auto directories = it->second->directories;
+    it->second->refreshed = std::chrono::steady_clock::now();
+    bool writable = (writable_roots.count(cdb) > 0);
+    lock.unlock();
+    auto scans = ScanChanges(key.first, dataset, directories);
+    lock.lock();
+    if(scans.empty())
+        return false;
+    it = indexes.find(key);
+    if(it == indexes.end())
+        return false;
+    ApplyScans(scans, *it->second);
+    ++generation;
+    if(writable)
+    {
+        auto snapshot = *it->second;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> save_lock(save_mutex);
+            Save(key.first, dataset, snapshot);
+        }
+        lock.lock();
+    }
+    return true;
+}
+
+// Lists every leaf directory whose modification time differs from directories, and
+// every directory in it that is gone. Touches only the filesystem.
+std::vector<CDBTileIndex::DirectoryScan> CDBTileIndex::ScanChanges(const std::string& cdb, int dataset, const std::map<std::string, int64_t>& directories)
+{
+    auto result = std::vector<DirectoryScan>();
+    auto tiles_path = std::filesystem::path(cdb + "/Tiles");
+    auto dataset_subdir = Dataset(uint16_t(dataset)).subdir();
+    auto seen = std::set<std::string>();
+    for(auto& lat_path : SubDirectories(tiles_path))
+    {
+        for(auto& lon_path : SubDirectories(lat_path))
+        {
+            auto dataset_path = lon_path / dataset_subdir;
+            for(auto& lod_path : SubDirectories(dataset_path))
+            {
+                for(auto& uref_path : SubDirectories(lod_path))
+                {
+                    auto reldir = lat_path.filename().string() + "/" + lon_path.filename().string() + "/" + dataset_subdir + "/" + lod_path.filename().string() + "/" + uref_path.filename().string();
+                    seen.insert(reldir);
+                    auto mtime = DirectoryTime(uref_path);
+                    auto it = directories.find(reldir);
+                    if((it != directories.end()) && (it->second == mtime))
+                        continue;
+                    auto scan = DirectoryScan();
+                    scan.reldir = reldir;
+                    scan.mtime = mtime;
+                    ScanDirectory(cdb, dataset, reldir, scan);
+                    result.push_back(std::move(scan));
+                }
+            }
+        }
+    }
+    for(auto& entry : directories)
+    {
+        if(seen.find(entry.first) != seen.end())
+            continue;
+        auto scan = DirectoryScan();
+        scan.reldir = entry.first;
+        scan.removed = true;
+        ScanDirectory(cdb, dataset, entry.first, scan);
+        result.push_back(std::move(scan));
+    }
+    return result;
+}
+
+// Parses reldir into scan and lists the tiles it holds now.
+bool CDBTileIndex::ScanDirectory(const std::string& cdb, int dataset, const std::string& reldir, DirectoryScan& scan)
+{
+    auto parts = std::vector<std::string>();
+    auto part = std::string();
+    auto iss = std::istringstream(reldir);
+    while(std::getline(iss, part, '/'))
+        parts.push_back(part);
+    if(parts.size() != 5)
+        return false;
+    if(!ParseGeocellComponent(parts[0], scan.latitude) || !ParseGeocellComponent(parts[1], scan.longitude) || !ParseGeocellComponent(parts[4], scan.uref))
+        return false;
+    scan.lc = (parts[3] == "LC");
+    if(!scan.lc && !ParseGeocellComponent(parts[3], scan.lod))
+        return false;
+    scan.parsed = true;
+
+    auto extension = TileExtensionForDataset(dataset);
+    auto ec = std::error_code();
+    auto path = std::filesystem::path(cdb + "/Tiles/" + reldir);
+    for(auto it = std::filesystem::directory_iterator(path, ec); !ec && (it != std::filesystem::directory_iterator()); it.increment(ec))
+    {
+        auto filepath = it->path();
+        if(filepath.extension().string() != extension)
+            continue;
+        TileInfo tileinfo;
+        try
+        {
+            tileinfo = TileInfoForFileName(filepath.stem().string());
+        }
+        catch(std::exception&)
+        {
+            continue;
+        }
+        if(tileinfo.dataset != dataset)
+            continue;
+        scan.tiles.push_back(tileinfo);
+    }
+    return true;
+}
+
+// Clears every tile the index holds for each scanned directory, then adds what the scan found.
+void CDBTileIndex::ApplyScans(const std::vector<DirectoryScan>& scans, DatasetIndex& index)
+{
+    for(auto& scan : scans)
+    {
+        if(scan.removed)
+            index.directories.erase(scan.reldir);
+        else
+            index.directories[scan.reldir] = scan.mtime;
+        if(!scan.parsed)
+            continue;
+        for(auto& entry : index.levels)
+        {
+            auto& key = entry.first;
+            if((key.latitude != scan.latitude) || (key.longitude != scan.longitude))
+                continue;
+            if(scan.lc ? (key.lod < 0) : (key.lod == scan.lod))
+                entry.second.ClearRow(scan.uref);
+        }
+        for(auto& tileinfo : scan.tiles)
+        {
+            auto key = LevelKey{ tileinfo.latitude, tileinfo.longitude, tileinfo.selector1, tileinfo.selector2, tileinfo.lod };
+            auto level = index.levels.emplace(key, Level(tileinfo.lod)).first;
+            level->second.Set(tileinfo.uref, tileinfo.rref);
+        }
+    }
+}
+
+bool CDBTileIndex::Load(const std::string& cdb, int dataset, DatasetIndex& index)
+{
+    std::ifstream is(SidecarFilename(cdb, dataset), std::ios::binary);
+    if(!is)
+        return false;
+    char magic[sizeof(SIDECAR_MAGIC)];
+    is.read(magic, sizeof(magic));
+    if(!is || !std::equal(magic, magic + sizeof(magic), SIDECAR_MAGIC))
+        return false;
+    int32_t file_dataset = 0;
+    uint64_t directory_count = 0;
+    if(!ReadValue(is, file_dataset) || (file_dataset != dataset) || !ReadValue(is, directory_count))
+        return false;
+    auto loaded = DatasetIndex();
+    for(uint64_t i = 0; i < directory_count; ++i)
+    {
+        uint32_t length = 0;
+        int64_t mtime = 0;
+        if(!ReadValue(is, length))
+            return false;
+        auto reldir = std::string(length, '\0');
+        is.read(&reldir[0], length);
+        if(!is || !ReadValue(is, mtime))
+            return false;
+        loaded.directories[reldir] = mtime;
+    }
+    uint64_t level_count = 0;
+    if(!ReadValue(is, level_count))
+        return false;
+    for(uint64_t i = 0; i < level_count; ++i)
+    {
+        LevelKey key;
+        if(!ReadValue(is, key.latitude) || !ReadValue(is, key.longitude) || !ReadValue(is, key.selector1) || !ReadValue(is, key.selector2) || !ReadValue(is, key.lod))
+            return false;
+        auto level = Level(key.lod);
+        if(!level.Read(is))
+            return false;
+        loaded.levels.emplace(key, std::move(level));
+    }
+    index = std::move(loaded);
+    return true;
+}
+
+bool CDBTileIndex::Save(const std::string& cdb, int dataset, const DatasetIndex& index)
+{
+    auto filename = SidecarFilename(cdb, dataset);
+    auto ec = std::error_code();
+    std::filesystem::create_directories(std::filesystem::path(filename).parent_path(), ec);
+    auto tmp_filename = filename + ".tmp";
+    {
+        std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+        if(!os)
+            return false;
+        os.write(SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC));
+        WriteValue(os, int32_t(dataset));
+        WriteValue(os, uint64_t(index.directories.size()));
+        for(auto& entry : index.directories)
+        {
+            WriteValue(os, uint32_t(entry.first.size()));
+            os.write(entry.first.data(), entry.first.size());
+            WriteValue(os, entry.second);
+        }
+        WriteValue(os, uint64_t(index.levels.size()));
+        for(auto& entry : index.levels)
+        {
+            auto& key = entry.first;
+            WriteValue(os, key.latitude);
+            WriteValue(os, key.longitude);
+            WriteValue(os, key.selector1);
+            WriteValue(os, key.selector2);
+            WriteValue(os, key.lod);
+            entry.second.Write(os);
+        }
+        if(!os)
+        {
+            os.close();
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp_filename, filename, ec);
+    if(ec)
+    {
+        std::remove(tmp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
+}
+
@@ -1,1433 +1,1547 @@
 
 #include <cdb_util/FeatureDataDictionary.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+
 namespace cognitics {
 namespace cdb {
 
-void FeatureDataDictionary::Subcategory::AddType(int key, const std::string& name) { Types[key] = { key, name }; }
-void FeatureDataDictionary::Category::AddSubcategory(char key, const std::string& name) { Subcategories[key] = { key, name }; }
-void FeatureDataDictionary::AddCategory(char key, const std::string& name) { Categories[key] = { key, name }; }
+namespace
+{
+    struct CategoryRecord
+    {
+        char Key;
+        const char* Name;
+    };
 
-std::string FeatureDataDictionary::Subdirectory(const std::string& facc)
+    struct SubcategoryRecord
+    {
+        char Category;
+        char Key;
+        const char* Name;
+    };
+
+    struct TypeRecord
+    {
+        char Category;
+        char Subcategory;
+        uint16_t Key;
+        const char* Name;
+    };
+
+    constexpr CategoryRecord categories[] =
+    {
+        { 'A', "Culture" },
+        { 'B', "Hydrography" },
+        { 'C', "Hypsography" },
+        { 'D', "Physiography" },
+        { 'E', "Vegetation" },
+        { 'F', "Demarcation" },
+        { 'G', "Aero_Info" },
+        { 'I', "Cadastral" },
+        { 'K', "FDD" },
+        { 'M', "FDD" },
+        { 'N', "FDD" },
+        { 'S', "Special_Use" },
+        { 'U', "EDD" },
+        { 'V', "EDD" },
+        { 'W', "EDD" },
+        { 'Z', "General" },
+    };
+
+    constexpr SubcategoryRecord subcategories[] =
+    {
+        { 'A', 'A', "Extraction" },
+        { 'A', 'B', "Disposal" },
+        { 'A', 'C', "Proc_Industry" },
+        { 'A', 'D', "Power_Gen" },
+        { 'A', 'E', "Fab_Industry" },
+        { 'A', 'F', "Ind_Structure" },
+        { 'A', 'G', "Commercial" },
+        { 'A', 'H', "Institutional" },
+        { 'A', 'I', "Residential" },
+        { 'A', 'J', "Agriculture" },
+        { 'A', 'K', "Recreational" },
+        { 'A', 'L', "Misc_Feature" },
+        { 'A', 'M', "Storage" },
+        { 'A', 'N', "Railroad" },
+        { 'A', 'P', "Road" },
+        { 'A', 'Q', "Associated" },
+        { 'A', 'R', "Air_Traffic_Serv" },
+        { 'A', 'T', "Comm" },
+        { 'A', 'U', "Airport" },
+        { 'B', 'A', "Coastal" },
+        { 'B', 'B', "Harbor" },
+        { 'B', 'C', "NAVAID" },
+        { 'B', 'D', "Hazard" },
+        { 'B', 'E', "Depth_Info" },
+        { 'B', 'F', "Bottom_Feature" },
+        { 'B', 'G', "Tide_Current_Info" },
+        { 'B', 'H', "Inland_Water" },
+        { 'B', 'I', "Misc_Inland_Water" },
+        { 'B', 'J', "Snow_or_Ice" },
+        { 'B', 'K', "Oceanographic" },
+        { 'C', 'A', "Relief" },
+        { 'D', 'A', "Exposed_Material" },
+        { 'D', 'B', "Landform" },
+        { 'E', 'A', "Cropland" },
+        { 'E', 'B', "Rangeland" },
+        { 'E', 'C', "Woodland" },
+        { 'E', 'D', "Wetland" },
+        { 'E', 'E', "Misc_Feature" },
+        { 'F', 'A', "Topo" },
+        { 'F', 'B', "Aero" },
+        { 'F', 'C', "Hydro" },
+        { 'G', 'A', "Air_Route" },
+        { 'G', 'B', "Aerodrome" },
+        { 'G', 'C', "AMDB" },
+        { 'I', 'A', "Area" },
+        { 'I', 'D', "Ref_Point" },
+        { 'I', 'E', "Special_Char" },
+        { 'K', 'B', "FDD" },
+        { 'K', 'C', "FDD" },
+        { 'K', 'D', "FDD" },
+        { 'K', 'E', "FDD" },
+        { 'K', 'F', "FDD" },
+        { 'M', 'A', "FDD" },
+        { 'M', 'B', "FDD" },
+        { 'M', 'C', "FDD" },
+        { 'N', 'A', "FDD" },
+        { 'N', 'C', "FDD" },
+        { 'N', 'D', "FDD" },
+        { 'N', 'F', "FDD" },
+        { 'N', 'G', "FDD" },
+        { 'N', 'H', "FDD" },
+        { 'S', 'A', "Terrain_Anal_Dataset" },
+        { 'S', 'B', "Bkgd_Display_Dataset" },
+        { 'S', 'C', "Transp_Dataset" },
+        { 'S', 'D', "Aero_Dataset" },
+        { 'S', 'E', "Toponymic_Dataset" },
+        { 'S', 'F', "Simulation_Dataset" },
+        { 'S', 'U', "Dev_Dataset" },
+        { 'U', 'A', "Abstract_Object" },
+        { 'U', 'C', "Administration" },
+        { 'U', 'D', "Agriculture" },
+        { 'U', 'E', "Air_Trnsp" },
+        { 'U', 'F', "Aperture" },
+        { 'U', 'G', "Room" },
+        { 'U', 'H', "Section" },
+        { 'U', 'I', "Fixture" },
+        { 'U', 'J', "Floor" },
+        { 'U', 'K', "Partition" },
+        { 'U', 'N', "Demarcation" },
+        { 'U', 'O', "Device_And_Equipment" },
+        { 'U', 'T', "Hydrographic_Artefact" },
+        { 'U', 'V', "Hydrographic_Trnsp" },
+        { 'U', 'W', "Hydrology" },
+        { 'U', 'X', "Ice" },
+        { 'U', 'Z', "Industry" },
+        { 'V', 'A', "Infrastructure" },
+        { 'V', 'C', "Land_Trnsp" },
+        { 'V', 'D', "Lighting_And_Visibility" },
+        { 'V', 'E', "Littoral" },
+        { 'V', 'F', "Living_Organism" },
+        { 'V', 'G', "Location" },
+        { 'V', 'I', "Military_Science" },
+        { 'V', 'J', "Physiography" },
+        { 'V', 'K', "Plant" },
+        { 'V', 'N', "Recreation" },
+        { 'V', 'O', "Religion" },
+        { 'V', 'P', "Shelter" },
+        { 'V', 'R', "Support_Structure" },
+        { 'V', 'S', "Surface" },
+        { 'V', 'U', "Survey" },
+        { 'V', 'X', "Trnsp" },
+        { 'V', 'Y', "Usage_Region" },
+        { 'W', 'A', "Waterbody_Floor" },
+        { 'W', 'C', "Waterbody_Surface" },
+        { 'Z', 'A', "Annotation" },
+        { 'Z', 'B', "Control_Point" },
+        { 'Z', 'C', "Magnetic_Variation" },
+        { 'Z', 'D', "Misc" },
+        { 'Z', 'E', "Bkgd_Feature" },
+        { 'Z', 'I', "FDD" },
+        { 'Z', 'V', "FDD" },
+    };
+
+    // Sorted by category, subcategory and key.
+    constexpr TypeRecord types[] =
+    {
+        { 'A', 'A', 10, "Mine" },
+        { 'A', 'A', 11, "Quarry_Wall" },
+        { 'A', 'A', 12, "Quarry" },
+        { 'A', 'A', 13, "Pit" },
+        { 'A', 'A', 40, "Rig_or_Superstructure" },
+        { 'A', 'A', 50, "Well" },
+        { 'A', 'A', 51, "Wellhead" },
+        { 'A', 'A', 52, "Oil_or_Gas_Field" },
+        { 'A', 'A', 60, "Gradation_Work" },
+        { 'A', 'B', 0, "Disposal_Site" },
+        { 'A', 'B', 10, "Scrap_Yard" },
+        { 'A', 'B', 15, "Incinerator" },
+        { 'A', 'B', 20, "Burner_Stack" },
+        { 'A', 'B', 21, "Diffuser" },
+        { 'A', 'B', 30, "Waste_Plant" },
+        { 'A', 'B', 40, "Aeration_Basin" },
+        { 'A', 'B', 507, "Waste_Heap" },
+        { 'A', 'C', 0, "Treatment_Plant" },
+        { 'A', 'C', 10, "Blast_Furnace" },
+        { 'A', 'C', 20, "Catalytic_Cracker" },
+        { 'A', 'C', 30, "Settling_Basin" },
+        { 'A', 'C', 40, "Oil_or_Gas_Facility" },
+        { 'A', 'C', 50, "Works" },
+        { 'A', 'C', 60, "Industrial_Furnace" },
+        { 'A', 'C', 70, "Industrial_Park" },
+        { 'A', 'C', 507, "Sewage_Treatment_Plant" },
+        { 'A', 'D', 10, "Power_Plant" },
+        { 'A', 'D', 20, "Solar_Panel" },
+        { 'A', 'D', 25, "Solar_Farm" },
+        { 'A', 'D', 30, "Substation" },
+        { 'A', 'D', 40, "Nuclear_Reactor" },
+        { 'A', 'D', 41, "Nuclear_Reactor_Containment" },
+        { 'A', 'D', 50, "Heating_Plant" },
+        { 'A', 'D', 55, "Cooling_Facility" },
+        { 'A', 'D', 60, "Wind_Farm" },
+        { 'A', 'E', 10, "Assembly_Plant" },
+        { 'A', 'F', 10, "Smokestack" },
+        { 'A', 'F', 20, "Conveyor" },
+        { 'A', 'F', 21, "Bucket_Elevator" },
+        { 'A', 'F', 30, "Cooling_Tower" },
+        { 'A', 'F', 40, "Crane" },
+        { 'A', 'F', 41, "Sheerleg" },
+        { 'A', 'F', 50, "Dredger" },
+        { 'A', 'F', 60, "Engine_Cell" },
+        { 'A', 'F', 70, "Flare_Pipe" },
+        { 'A', 'F', 80, "Hopper" },
+        { 'A', 'G', 30, "Shopping_Complex" },
+        { 'A', 'G', 40, "Office_Park" },
+        { 'A', 'G', 50, "Billboard" },
+        { 'A', 'H', 10, "Bastion" },
+        { 'A', 'H', 20, "Trench" },
+        { 'A', 'H', 30, "Hazard_Shelter" },
+        { 'A', 'H', 50, "Fortification" },
+        { 'A', 'H', 60, "Bunker" },
+        { 'A', 'H', 70, "Checkpoint" },
+        { 'A', 'I', 20, "Mobile_Home_Park" },
+        { 'A', 'I', 30, "Camp" },
+        { 'A', 'J', 10, "Circular_Irrigation" },
+        { 'A', 'J', 20, "Siphon" },
+        { 'A', 'J', 30, "Stockyard" },
+        { 'A', 'J', 50, "Windmill" },
+        { 'A', 'J', 51, "Windmotor" },
+        { 'A', 'J', 55, "Water_Mill" },
+        { 'A', 'J', 60, "Farm" },
+        { 'A', 'J', 70, "Ranch" },
+        { 'A', 'J', 80, "Stable" },
+        { 'A', 'J', 85, "Barn" },
+        { 'A', 'J', 90, "Cattle_Dipping_Tank" },
+        { 'A', 'J', 100, "Agricultural_Colony" },
+        { 'A', 'J', 110, "Greenhouse" },
+        { 'A', 'J', 501, "Water_Wheel" },
+        { 'A', 'J', 525, "Grange" },
+        { 'A', 'K', 15, "Bandshell" },
+        { 'A', 'K', 20, "Amst_Pk_Attract" },
+        { 'A', 'K', 30, "Amst_Pk" },
+        { 'A', 'K', 40, "Athletic_Field" },
+        { 'A', 'K', 50, "Tennis_Court" },
+        { 'A', 'K', 51, "Tennis_Complex" },
+        { 'A', 'K', 60, "Campground" },
+        { 'A', 'K', 61, "Picnic_Site" },
+        { 'A', 'K', 70, "Drive-In_Theater" },
+        { 'A', 'K', 80, "Theater_Screen" },
+        { 'A', 'K', 90, "Fairground" },
+        { 'A', 'K', 91, "Exhibition_Ground" },
+        { 'A', 'K', 100, "Golf_Course" },
+        { 'A', 'K', 101, "Golf_Driving_Range" },
+        { 'A', 'K', 110, "Grandstand" },
+        { 'A', 'K', 120, "Park" },
+        { 'A', 'K', 121, "Lookout" },
+        { 'A', 'K', 122, "Green_Space" },
+        { 'A', 'K', 123, "Bench" },
+        { 'A', 'K', 124, "Picnic_Table" },
+        { 'A', 'K', 130, "Race_Track" },
+        { 'A', 'K', 140, "Planter" },
+        { 'A', 'K', 141, "Statue_Pedestal" },
+        { 'A', 'K', 150, "Ski_Jump" },
+        { 'A', 'K', 155, "Ski_Track" },
+        { 'A', 'K', 160, "Stadium" },
+        { 'A', 'K', 161, "Scoreboard" },
+        { 'A', 'K', 164, "Amphitheatre" },
+        { 'A', 'K', 165, "Sports_Stadium" },
+        { 'A', 'K', 166, "Arena" },
+        { 'A', 'K', 170, "Swimming_Pool" },
+        { 'A', 'K', 180, "Zoo" },
+        { 'A', 'K', 190, "Fishing" },
+        { 'A', 'K', 200, "Spa" },
+        { 'A', 'K', 539, "Open_Air_Bath" },
+        { 'A', 'L', 5, "Animal_Sanctuary" },
+        { 'A', 'L', 10, "Facility" },
+        { 'A', 'L', 11, "Installation" },
+        { 'A', 'L', 12, "Arch_Site" },
+        { 'A', 'L', 13, "Building" },
+        { 'A', 'L', 14, "Non_Building_Structure" },
+        { 'A', 'L', 15, "Building" },
+        { 'A', 'L', 17, "Fire_Hydrant" },
+        { 'A', 'L', 18, "Building_Addition" },
+        { 'A', 'L', 19, "Shed" },
+        { 'A', 'L', 20, "Built-Up_Area" },
+        { 'A', 'L', 21, "Built-up_Area-Hist" },
+        { 'A', 'L', 22, "Populated_Place" },
+        { 'A', 'L', 25, "Cairn" },
+        { 'A', 'L', 30, "Cemetery" },
+        { 'A', 'L', 35, "Grave" },
+        { 'A', 'L', 36, "Tomb" },
+        { 'A', 'L', 40, "Cliff_Dwelling" },
+        { 'A', 'L', 45, "Complex_Outline" },
+        { 'A', 'L', 50, "Display_Sign" },
+        { 'A', 'L', 60, "Dragon_Teeth" },
+        { 'A', 'L', 65, "Minefield" },
+        { 'A', 'L', 70, "Fence" },
+        { 'A', 'L', 73, "Flagstaff" },
+        { 'A', 'L', 75, "Gallery" },
+        { 'A', 'L', 80, "Gantry" },
+        { 'A', 'L', 90, "Grave_Marker" },
+        { 'A', 'L', 95, "Homogeneous_Radar_Sig_Area" },
+        { 'A', 'L', 99, "Hut" },
+        { 'A', 'L', 100, "Hut" },
+        { 'A', 'L', 101, "Cabin" },
+        { 'A', 'L', 105, "Settlement" },
+        { 'A', 'L', 110, "Light_Standard" },
+        { 'A', 'L', 116, "Calvary_Cross" },
+        { 'A', 'L', 120, "Missile_Site" },
+        { 'A', 'L', 121, "Anti_Aircraft_Artillery_Site" },
+        { 'A', 'L', 130, "Monument" },
+        { 'A', 'L', 135, "Native_Settlement" },
+        { 'A', 'L', 140, "Particle_Accelerator" },
+        { 'A', 'L', 141, "Telescope" },
+        { 'A', 'L', 142, "Astronomical_Observatory" },
+        { 'A', 'L', 155, "Overhead" },
+        { 'A', 'L', 165, "Pipeline_Crossing_Point" },
+        { 'A', 'L', 170, "Plaza" },
+        { 'A', 'L', 175, "Courtyard" },
+        { 'A', 'L', 180, "Retail_Stand" },
+        { 'A', 'L', 195, "Ramp" },
+        { 'A', 'L', 200, "Ruins" },
+        { 'A', 'L', 201, "Historic" },
+        { 'A', 'L', 208, "Shanty_Town" },
+        { 'A', 'L', 209, "Tent_Encampment" },
+        { 'A', 'L', 210, "Snow_Shed" },
+        { 'A', 'L', 211, "Trans_Route_Protect_Struct" },
+        { 'A', 'L', 220, "Steeple" },
+        { 'A', 'L', 240, "Tower-NC" },
+        { 'A', 'L', 241, "Tower_General" },
+        { 'A', 'L', 250, "Undergrd_Dwelling" },
+        { 'A', 'L', 260, "Wall" },
+        { 'A', 'L', 270, "Industrial_Farm" },
+        { 'A', 'L', 330, "Religious_Facility" },
+        { 'A', 'L', 351, "Space_Facility" },
+        { 'A', 'L', 370, "Country_House" },
+        { 'A', 'L', 375, "Castle" },
+        { 'A', 'L', 510, "Tethered_Balloon" },
+        { 'A', 'M', 10, "Depot" },
+        { 'A', 'M', 11, "Container" },
+        { 'A', 'M', 20, "Grain_Silo" },
+        { 'A', 'M', 30, "Grain_Elevator" },
+        { 'A', 'M', 31, "Timber_Yard" },
+        { 'A', 'M', 40, "Mineral_Pile" },
+        { 'A', 'M', 42, "Material_Pile" },
+        { 'A', 'M', 60, "Storage" },
+        { 'A', 'M', 65, "Munition_Storage_Facility" },
+        { 'A', 'M', 70, "Tank" },
+        { 'A', 'M', 71, "Tank_Farm" },
+        { 'A', 'M', 75, "Fuel_Storage_Facility" },
+        { 'A', 'M', 80, "Water_Tower" },
+        { 'A', 'M', 91, "Silo" },
+        { 'A', 'M', 510, "Transshipment_Station" },
+        { 'A', 'N', 10, "Railroad" },
+        { 'A', 'N', 15, "Railway_Track" },
+        { 'A', 'N', 50, "Railroad_Siding" },
+        { 'A', 'N', 60, "Railroad_Yard" },
+        { 'A', 'N', 65, "Railhead" },
+        { 'A', 'N', 75, "Railroad_Turntable" },
+        { 'A', 'N', 76, "Roundhouse" },
+        { 'A', 'N', 80, "Railroad_Switch" },
+        { 'A', 'N', 85, "Railway_Signal" },
+        { 'A', 'P', 10, "Cart_Track" },
+        { 'A', 'P', 20, "Interchange" },
+        { 'A', 'P', 30, "Road" },
+        { 'A', 'P', 32, "Road_Ramp" },
+        { 'A', 'P', 40, "Gate" },
+        { 'A', 'P', 41, "Barrier" },
+        { 'A', 'P', 50, "Trail" },
+        { 'A', 'P', 60, "Drove" },
+        { 'A', 'Q', 10, "Cableway_Line" },
+        { 'A', 'Q', 20, "Cableway_Pylon" },
+        { 'A', 'Q', 21, "Mast" },
+        { 'A', 'Q', 30, "Boardwalk" },
+        { 'A', 'Q', 35, "Sidewalk" },
+        { 'A', 'Q', 36, "Curb" },
+        { 'A', 'Q', 40, "Bridge" },
+        { 'A', 'Q', 45, "Bridge_Span" },
+        { 'A', 'Q', 50, "Bridge_Superstruct" },
+        { 'A', 'Q', 55, "Bridge_Pylon" },
+        { 'A', 'Q', 56, "Bridge_Pier" },
+        { 'A', 'Q', 58, "Constriction_or_Expansion" },
+        { 'A', 'Q', 60, "Control_Tower" },
+        { 'A', 'Q', 62, "Crossing" },
+        { 'A', 'Q', 63, "Causeway_Structure" },
+        { 'A', 'Q', 64, "Causeway" },
+        { 'A', 'Q', 65, "Culvert" },
+        { 'A', 'Q', 68, "Drop_Gate" },
+        { 'A', 'Q', 70, "Ferry_Crossing" },
+        { 'A', 'Q', 75, "Ice_Route" },
+        { 'A', 'Q', 80, "Ferry_Site" },
+        { 'A', 'Q', 90, "Entrance_or_Exit" },
+        { 'A', 'Q', 95, "Tunnel_Mouth" },
+        { 'A', 'Q', 100, "Landmark_Post" },
+        { 'A', 'Q', 105, "Buried_Utility" },
+        { 'A', 'Q', 110, "Mooring_Mast" },
+        { 'A', 'Q', 111, "Float_Bridge_Site" },
+        { 'A', 'Q', 113, "Pipeline" },
+        { 'A', 'Q', 114, "Storm_Drain" },
+        { 'A', 'Q', 115, "Utility_Cover" },
+        { 'A', 'Q', 116, "Pumping_Station" },
+        { 'A', 'Q', 118, "Sharp_Curve" },
+        { 'A', 'Q', 119, "Route_Marker" },
+        { 'A', 'Q', 120, "Steep_Grade" },
+        { 'A', 'Q', 125, "Station-Misc" },
+        { 'A', 'Q', 130, "Tunnel" },
+        { 'A', 'Q', 135, "Vehicle_Rest_Area" },
+        { 'A', 'Q', 140, "Vehicle_Park_Area" },
+        { 'A', 'Q', 141, "Parking_Garage" },
+        { 'A', 'Q', 150, "Steps_or_Stair" },
+        { 'A', 'Q', 151, "Arcade" },
+        { 'A', 'Q', 152, "Overhead_Walkway" },
+        { 'A', 'Q', 160, "Traffic_Light" },
+        { 'A', 'Q', 161, "Street_Lamp" },
+        { 'A', 'Q', 162, "Street_Sign" },
+        { 'A', 'Q', 170, "Motor_Vehicle_Station" },
+        { 'A', 'Q', 180, "Weigh_Station" },
+        { 'A', 'Q', 200, "Regulatory_Sign" },
+        { 'A', 'R', 1, "Marshaller" },
+        { 'A', 'T', 5, "Cable" },
+        { 'A', 'T', 6, "Overhead_Cable" },
+        { 'A', 'T', 10, "Dish_Aerial" },
+        { 'A', 'T', 11, "Aerial" },
+        { 'A', 'T', 12, "Aerial_Farm" },
+        { 'A', 'T', 20, "Early_Warning_Radar" },
+        { 'A', 'T', 30, "Power_Line" },
+        { 'A', 'T', 40, "Power_Pylon" },
+        { 'A', 'T', 41, "Telepheric" },
+        { 'A', 'T', 42, "Pylon" },
+        { 'A', 'T', 45, "Radar" },
+        { 'A', 'T', 50, "Comm_Building" },
+        { 'A', 'T', 60, "Telephone_Line" },
+        { 'A', 'T', 70, "Telephone_Pylon" },
+        { 'A', 'T', 80, "Comm_Tower" },
+        { 'B', 'A', 5, "High_Water_Line" },
+        { 'B', 'A', 10, "Coastline_or_Shoreline" },
+        { 'B', 'A', 11, "Coastline" },
+        { 'B', 'A', 20, "Foreshore" },
+        { 'B', 'A', 21, "Nearshore" },
+        { 'B', 'A', 22, "Backshore" },
+        { 'B', 'A', 23, "Foreshore" },
+        { 'B', 'A', 24, "Shoreline" },
+        { 'B', 'A', 25, "Offshore" },
+        { 'B', 'A', 30, "Island" },
+        { 'B', 'A', 40, "Water" },
+        { 'B', 'A', 50, "Beach" },
+        { 'B', 'A', 51, "Dyke_Crown" },
+        { 'B', 'A', 52, "Beach_Exit" },
+        { 'B', 'A', 70, "Waterbody_Bar" },
+        { 'B', 'B', 5, "Harbor" },
+        { 'B', 'B', 6, "Harbor_Complex" },
+        { 'B', 'B', 7, "Channel_Edge" },
+        { 'B', 'B', 8, "Harbour_Waters" },
+        { 'B', 'B', 9, "Port" },
+        { 'B', 'B', 10, "Anchorage" },
+        { 'B', 'B', 11, "Anchorage-Complex" },
+        { 'B', 'B', 12, "Anchor_Berth" },
+        { 'B', 'B', 15, "Roadstead" },
+        { 'B', 'B', 19, "Anchor" },
+        { 'B', 'B', 20, "Berth" },
+        { 'B', 'B', 21, "Mooring_Trot" },
+        { 'B', 'B', 22, "Basin" },
+        { 'B', 'B', 30, "Bollard" },
+        { 'B', 'B', 40, "Groyne" },
+        { 'B', 'B', 41, "Breakwater" },
+        { 'B', 'B', 42, "Mole" },
+        { 'B', 'B', 43, "Groin" },
+        { 'B', 'B', 50, "Calling-In_Point" },
+        { 'B', 'B', 79, "Mooring_Facility" },
+        { 'B', 'B', 80, "Dolphin" },
+        { 'B', 'B', 81, "Shoreline_Constr" },
+        { 'B', 'B', 82, "Shoreline_Ramp" },
+        { 'B', 'B', 90, "Drydock" },
+        { 'B', 'B', 91, "Dry_Dock_Basin" },
+        { 'B', 'B', 92, "Dry_Dock_Wall" },
+        { 'B', 'B', 95, "Dock" },
+        { 'B', 'B', 100, "Fish_Stakes" },
+        { 'B', 'B', 105, "Fishing_Harbor" },
+        { 'B', 'B', 110, "Fish_Trap" },
+        { 'B', 'B', 111, "Tunny" },
+        { 'B', 'B', 112, "Fish_Trap_Area" },
+        { 'B', 'B', 115, "Gridiron" },
+        { 'B', 'B', 140, "Jetty" },
+        { 'B', 'B', 149, "Boat_Landing" },
+        { 'B', 'B', 150, "Landing_Place" },
+        { 'B', 'B', 151, "Landing_Stair" },
+        { 'B', 'B', 155, "Maritime_Station" },
+        { 'B', 'B', 160, "Mooring_Ring" },
+        { 'B', 'B', 170, "Loading_Facility" },
+        { 'B', 'B', 175, "Mobile_Offshore_Drill_Unit" },
+        { 'B', 'B', 180, "Oyster_Bed" },
+        { 'B', 'B', 190, "Pier" },
+        { 'B', 'B', 198, "Fender" },
+        { 'B', 'B', 199, "Floating_Dock" },
+        { 'B', 'B', 200, "Pump_Out_Facility" },
+        { 'B', 'B', 201, "Small_Craft_Facility" },
+        { 'B', 'B', 202, "Ice_Boom" },
+        { 'B', 'B', 220, "Ramp" },
+        { 'B', 'B', 221, "Log_Ramp" },
+        { 'B', 'B', 225, "Rip_Rap" },
+        { 'B', 'B', 226, "Shore_Revetment" },
+        { 'B', 'B', 230, "Seawall" },
+        { 'B', 'B', 240, "Slipway" },
+        { 'B', 'B', 241, "Shipyard" },
+        { 'B', 'B', 250, "Watering_Place" },
+        { 'B', 'B', 270, "Pilot_Boarding_Place" },
+        { 'B', 'C', 10, "Beacon" },
+        { 'B', 'C', 20, "Buoy" },
+        { 'B', 'C', 21, "Lateral_Buoy" },
+        { 'B', 'C', 30, "Leading_Light" },
+        { 'B', 'C', 31, "Navigation_Line" },
+        { 'B', 'C', 32, "Radar_Line" },
+        { 'B', 'C', 33, "Radar_Range" },
+        { 'B', 'C', 34, "Maritime_Radiobeacon" },
+        { 'B', 'C', 35, "Lights_in_Line" },
+        { 'B', 'C', 40, "Light" },
+        { 'B', 'C', 50, "Lighthouse" },
+        { 'B', 'C', 55, "Marker" },
+        { 'B', 'C', 60, "Light_Sector" },
+        { 'B', 'C', 70, "Light_Vessel" },
+        { 'B', 'C', 80, "Perches" },
+        { 'B', 'C', 98, "Nav_Mark-Afloat" },
+        { 'B', 'C', 99, "Nav_Mark-Fixed" },
+        { 'B', 'C', 100, "Leading_Line" },
+        { 'B', 'C', 101, "Fog_Signal" },
+        { 'B', 'C', 102, "Direction-Buoyage" },
+        { 'B', 'C', 103, "Sound_Signal_Device" },
+        { 'B', 'C', 110, "Topmark" },
+        { 'B', 'D', 0, "Underwater" },
+        { 'B', 'D', 1, "Mine-Naval" },
+        { 'B', 'D', 2, "Small_Bottom_Object" },
+        { 'B', 'D', 3, "Large_Bottom_Object" },
+        { 'B', 'D', 5, "Misc_Underwater" },
+        { 'B', 'D', 10, "Breakers" },
+        { 'B', 'D', 20, "Crib" },
+        { 'B', 'D', 30, "Discolored_Water" },
+        { 'B', 'D', 40, "Eddy" },
+        { 'B', 'D', 50, "Foul_Ground" },
+        { 'B', 'D', 60, "Seaweed" },
+        { 'B', 'D', 61, "Aquatic_Vegetation" },
+        { 'B', 'D', 70, "Obstruction" },
+        { 'B', 'D', 71, "Log_Boom" },
+        { 'B', 'D', 72, "Pontoon" },
+        { 'B', 'D', 73, "Oil_Barrier" },
+        { 'B', 'D', 74, "Chain_or_Wire" },
+        { 'B', 'D', 75, "Log_Boom" },
+        { 'B', 'D', 76, "Booming_Ground" },
+        { 'B', 'D', 79, "Fishing_Facility" },
+        { 'B', 'D', 80, "Tide_Rip" },
+        { 'B', 'D', 100, "Pile" },
+        { 'B', 'D', 110, "Platform" },
+        { 'B', 'D', 111, "Offshore_Platform" },
+        { 'B', 'D', 112, "Prod_Installation" },
+        { 'B', 'D', 115, "Offshore_Construction" },
+        { 'B', 'D', 119, "Ledge" },
+        { 'B', 'D', 120, "Reef" },
+        { 'B', 'D', 121, "Pingo" },
+        { 'B', 'D', 122, "Cay" },
+        { 'B', 'D', 123, "Boom" },
+        { 'B', 'D', 125, "Fish_Haven" },
+        { 'B', 'D', 130, "Rock" },
+        { 'B', 'D', 140, "Snag_or_Stump" },
+        { 'B', 'D', 180, "Wreck" },
+        { 'B', 'D', 181, "Hulk" },
+        { 'B', 'D', 190, "Non_Submarine_Contact" },
+        { 'B', 'E', 10, "Depth_Curve" },
+        { 'B', 'E', 15, "Depth_Contour" },
+        { 'B', 'E', 19, "Depth_Area" },
+        { 'B', 'E', 20, "Sounding" },
+        { 'B', 'E', 21, "Low_Water_Line" },
+        { 'B', 'E', 22, "Sand_Line" },
+        { 'B', 'E', 23, "Mud_Line" },
+        { 'B', 'E', 29, "Bottom_Return" },
+        { 'B', 'E', 30, "Track_Swath" },
+        { 'B', 'E', 40, "Track_Line" },
+        { 'B', 'E', 50, "Beach_Profile" },
+        { 'B', 'F', 10, "Bottom_Char" },
+        { 'B', 'F', 11, "Bottom_Feature" },
+        { 'B', 'F', 20, "Seabed_Impact_Scour" },
+        { 'B', 'G', 10, "Current_Flow" },
+        { 'B', 'G', 11, "Tideway" },
+        { 'B', 'G', 12, "Water_Turbulence" },
+        { 'B', 'G', 13, "Water_Current_Region" },
+        { 'B', 'G', 20, "Tide_Gauge" },
+        { 'B', 'G', 30, "Tidal_Obs_Station" },
+        { 'B', 'G', 40, "Tidal_Diagram" },
+        { 'B', 'H', 0, "Water" },
+        { 'B', 'H', 10, "Aqueduct" },
+        { 'B', 'H', 11, "Intake" },
+        { 'B', 'H', 12, "Qanat_Shaft" },
+        { 'B', 'H', 15, "Bog" },
+        { 'B', 'H', 20, "Canal" },
+        { 'B', 'H', 30, "Ditch" },
+        { 'B', 'H', 40, "Filtration_Bed" },
+        { 'B', 'H', 49, "Aquaculture_Facility" },
+        { 'B', 'H', 50, "Fish_Farm" },
+        { 'B', 'H', 51, "Fish_Farm_Facility" },
+        { 'B', 'H', 60, "Flume" },
+        { 'B', 'H', 65, "Water_Race" },
+        { 'B', 'H', 70, "Ford" },
+        { 'B', 'H', 75, "Fountain" },
+        { 'B', 'H', 77, "Hummock" },
+        { 'B', 'H', 80, "Lake_or_Pond" },
+        { 'B', 'H', 81, "Pond" },
+        { 'B', 'H', 82, "Inland_Waterbody" },
+        { 'B', 'H', 90, "Low_Land" },
+        { 'B', 'H', 91, "Flooded_Area" },
+        { 'B', 'H', 95, "Marsh_or_Swamp" },
+        { 'B', 'H', 100, "Moat" },
+        { 'B', 'H', 110, "Penstock" },
+        { 'B', 'H', 115, "Phreatic_Water" },
+        { 'B', 'H', 120, "Rapids" },
+        { 'B', 'H', 130, "Reservoir" },
+        { 'B', 'H', 135, "Rice_Field" },
+        { 'B', 'H', 140, "River_or_Stream" },
+        { 'B', 'H', 141, "River_Bank" },
+        { 'B', 'H', 145, "River_Vanishing_Pt" },
+        { 'B', 'H', 150, "Salt_Pan" },
+        { 'B', 'H', 155, "Salt_Evaporator" },
+        { 'B', 'H', 160, "Sebkha" },
+        { 'B', 'H', 165, "Spillway" },
+        { 'B', 'H', 170, "Water_Hole" },
+        { 'B', 'H', 171, "Water_Hole" },
+        { 'B', 'H', 172, "Spring" },
+        { 'B', 'H', 173, "Resurgence" },
+        { 'B', 'H', 175, "Trough" },
+        { 'B', 'H', 180, "Waterfall" },
+        { 'B', 'H', 190, "Lagoon" },
+        { 'B', 'H', 191, "Channel" },
+        { 'B', 'H', 192, "Thalweg" },
+        { 'B', 'H', 200, "Surf_Drainage" },
+        { 'B', 'H', 210, "Inland_Shoreline" },
+        { 'B', 'H', 220, "Waterwork" },
+        { 'B', 'H', 230, "Water_Well" },
+        { 'B', 'H', 240, "Irrigation_System" },
+        { 'B', 'H', 250, "Shallow_Water_Area" },
+        { 'B', 'H', 501, "River_Nav_Route" },
+        { 'B', 'I', 5, "Boat_Lift" },
+        { 'B', 'I', 6, "Ship_Elevator" },
+        { 'B', 'I', 10, "Cistern" },
+        { 'B', 'I', 20, "Dam_or_Weir" },
+        { 'B', 'I', 30, "Lock" },
+        { 'B', 'I', 31, "Lock_Basin" },
+        { 'B', 'I', 32, "Lock_Gate" },
+        { 'B', 'I', 33, "Lock_Wall" },
+        { 'B', 'I', 39, "Sluice" },
+        { 'B', 'I', 40, "Sluice_Gate" },
+        { 'B', 'I', 41, "Gate" },
+        { 'B', 'I', 42, "Caisson" },
+        { 'B', 'I', 43, "Flood_Barrage" },
+        { 'B', 'I', 44, "Flood_Control_Structure" },
+        { 'B', 'I', 45, "Basin_Gate" },
+        { 'B', 'I', 50, "Intake_Tower" },
+        { 'B', 'I', 60, "Fish_Ladder" },
+        { 'B', 'I', 70, "Gauging" },
+        { 'B', 'I', 80, "Boat_Basin" },
+        { 'B', 'J', 20, "Moraine" },
+        { 'B', 'J', 30, "Glacier" },
+        { 'B', 'J', 31, "Crevasse" },
+        { 'B', 'J', 40, "Ice_Cliff" },
+        { 'B', 'J', 60, "Ice_Peak" },
+        { 'B', 'J', 65, "Ice_Shelf" },
+        { 'B', 'J', 70, "Pack_Ice" },
+        { 'B', 'J', 80, "Polar_Ice" },
+        { 'B', 'J', 99, "Ice_Cap" },
+        { 'B', 'J', 100, "Snow_or_Ice_Field" },
+        { 'B', 'J', 105, "Land_Snow_Ice_Field" },
+        { 'B', 'J', 110, "Tundra" },
+        { 'B', 'K', 10, "Acoustic_Station" },
+        { 'B', 'K', 20, "Magnetic_Station" },
+        { 'B', 'K', 30, "Collection_Device" },
+        { 'C', 'A', 10, "Contour_Line" },
+        { 'C', 'A', 20, "Ridge_Line" },
+        { 'C', 'A', 25, "Valley_Line" },
+        { 'C', 'A', 26, "Breakline" },
+        { 'C', 'A', 30, "Spot_Elevation" },
+        { 'C', 'A', 35, "Water_Elevation" },
+        { 'C', 'A', 40, "Contour_Polygon" },
+        { 'C', 'A', 50, "Surface_Triangle" },
+        { 'C', 'A', 99, "Terrain_Constraint_Point" },
+        { 'D', 'A', 5, "Asphalt_Lake" },
+        { 'D', 'A', 6, "Alkali_Flat" },
+        { 'D', 'A', 10, "Ground" },
+        { 'D', 'A', 20, "Barren" },
+        { 'D', 'A', 30, "Land_Area" },
+        { 'D', 'A', 31, "Land_Region" },
+        { 'D', 'B', 0, "Land_Area" },
+        { 'D', 'B', 1, "Land_Morphology_Area" },
+        { 'D', 'B', 10, "Cliff" },
+        { 'D', 'B', 30, "Cave" },
+        { 'D', 'B', 31, "Hill" },
+        { 'D', 'B', 60, "Crevice" },
+        { 'D', 'B', 61, "Crevice" },
+        { 'D', 'B', 70, "Cut" },
+        { 'D', 'B', 71, "Cut_Line" },
+        { 'D', 'B', 72, "Cut_Face" },
+        { 'D', 'B', 80, "Depression" },
+        { 'D', 'B', 90, "Embankment" },
+        { 'D', 'B', 100, "Esker" },
+        { 'D', 'B', 110, "Fault" },
+        { 'D', 'B', 115, "Geothermal_Feature" },
+        { 'D', 'B', 145, "Misc_Obstacle" },
+        { 'D', 'B', 150, "Mountain_Pass" },
+        { 'D', 'B', 160, "Rock_Formation" },
+        { 'D', 'B', 161, "Boulder" },
+        { 'D', 'B', 170, "Sand_Dune" },
+        { 'D', 'B', 176, "Slope_Category" },
+        { 'D', 'B', 180, "Volcano" },
+        { 'D', 'B', 181, "Submerged_Volcano" },
+        { 'D', 'B', 185, "Crater" },
+        { 'D', 'B', 190, "Volcanic_Dike" },
+        { 'D', 'B', 200, "Gully_or_Gorge" },
+        { 'D', 'B', 210, "Landslide_Area" },
+        { 'D', 'B', 211, "Landslide" },
+        { 'D', 'B', 220, "Undermined_Land" },
+        { 'D', 'B', 230, "Fan" },
+        { 'D', 'B', 500, "Cliff-Bottomline" },
+        { 'D', 'B', 501, "Cliff-Topline" },
+        { 'D', 'B', 534, "Ground_Movement_Area" },
+        { 'D', 'B', 561, "Volcanic_Appearance" },
+        { 'E', 'A', 10, "Cropland" },
+        { 'E', 'A', 20, "Hedgerow" },
+        { 'E', 'A', 30, "Nursery" },
+        { 'E', 'A', 31, "Botanical_Garden" },
+        { 'E', 'A', 40, "Plantation" },
+        { 'E', 'A', 50, "Vineyard" },
+        { 'E', 'A', 55, "Hops" },
+        { 'E', 'A', 537, "Horticultural_Area" },
+        { 'E', 'B', 10, "Grassland" },
+        { 'E', 'B', 15, "Grass_or_Scrub_or_Brush" },
+        { 'E', 'B', 20, "Scrub_or_Brush_or_Bush" },
+        { 'E', 'B', 30, "Land_Cover" },
+        { 'E', 'B', 40, "Steppe" },
+        { 'E', 'B', 50, "Savanna" },
+        { 'E', 'B', 60, "Heathland" },
+        { 'E', 'B', 70, "Brush" },
+        { 'E', 'B', 80, "Scrubland" },
+        { 'E', 'C', 5, "Tree" },
+        { 'E', 'C', 7, "Tree_Row" },
+        { 'E', 'C', 10, "Bamboo" },
+        { 'E', 'C', 15, "Forest" },
+        { 'E', 'C', 20, "Oasis" },
+        { 'E', 'C', 30, "Trees" },
+        { 'E', 'C', 40, "Cleared_Way" },
+        { 'E', 'C', 50, "Grove" },
+        { 'E', 'C', 60, "Forest_Clearing" },
+        { 'E', 'C', 70, "Rainforest" },
+        { 'E', 'D', 10, "Marsh" },
+        { 'E', 'D', 20, "Swamp" },
+        { 'E', 'D', 30, "Mangrove_Swamp" },
+        { 'E', 'D', 40, "Taiga" },
+        { 'E', 'E', 0, "Misc_Vegetation" },
+        { 'E', 'E', 10, "Logging_Area" },
+        { 'E', 'E', 20, "No_Vegetation" },
+        { 'E', 'E', 30, "Desert" },
+        { 'E', 'E', 50, "Garden" },
+        { 'E', 'E', 60, "Bank_Vegetation_Zone" },
+        { 'E', 'E', 100, "Economic_Reserve" },
+        { 'F', 'A', 0, "Boundary-Admin" },
+        { 'F', 'A', 1, "Area-Admin" },
+        { 'F', 'A', 2, "Geopolitical_Entity" },
+        { 'F', 'A', 3, "Administrative_Division" },
+        { 'F', 'A', 5, "Access_Zone" },
+        { 'F', 'A', 6, "Sovereign_State" },
+        { 'F', 'A', 7, "Territory_Special_Status" },
+        { 'F', 'A', 12, "Contaminated_Region" },
+        { 'F', 'A', 15, "Firing_Range" },
+        { 'F', 'A', 20, "Armistice_Line" },
+        { 'F', 'A', 30, "Cease-Fire_Line" },
+        { 'F', 'A', 40, "Claim_Line" },
+        { 'F', 'A', 41, "Contact_Zone" },
+        { 'F', 'A', 45, "Contact_Zone_Stanag2256" },
+        { 'F', 'A', 50, "Mandate_Line" },
+        { 'F', 'A', 60, "Boundary-Defacto" },
+        { 'F', 'A', 70, "Demilitarized_Zone" },
+        { 'F', 'A', 80, "National_Park" },
+        { 'F', 'A', 81, "Nature_Reserve" },
+        { 'F', 'A', 82, "Protected_Water" },
+        { 'F', 'A', 90, "Prospecting_Grid" },
+        { 'F', 'A', 91, "Geophysical_Data_Track_Line" },
+        { 'F', 'A', 100, "Test_Area" },
+        { 'F', 'A', 110, "Date_Line" },
+        { 'F', 'A', 120, "Boundary" },
+        { 'F', 'A', 165, "Training_Area" },
+        { 'F', 'A', 170, "Zone_of_Occupation" },
+        { 'F', 'A', 210, "Conservation_Area" },
+        { 'F', 'A', 517, "Military_Administrative_Unit" },
+        { 'F', 'A', 574, "Noise_Control_Area" },
+        { 'F', 'C', 21, "Maritime_Boundary" },
+        { 'F', 'C', 31, "Maritime_Area" },
+        { 'F', 'C', 33, "Dumping_Ground" },
+        { 'F', 'C', 34, "Dredged_Area" },
+        { 'F', 'C', 35, "Pond" },
+        { 'F', 'C', 36, "Restricted_Area" },
+        { 'F', 'C', 37, "Caution_Area" },
+        { 'F', 'C', 38, "Diving_Location" },
+        { 'F', 'C', 40, "TSS_System" },
+        { 'F', 'C', 41, "TSS" },
+        { 'F', 'C', 42, "Inshore_Traffic_Zone" },
+        { 'F', 'C', 45, "Unsurveyed_Area" },
+        { 'F', 'C', 46, "Waterbody_Area" },
+        { 'F', 'C', 47, "Waterbody_Morphology_Area" },
+        { 'F', 'C', 50, "Naval_Firing_Practice_Area" },
+        { 'F', 'C', 55, "Naval_Operations_Area" },
+        { 'F', 'C', 100, "Measured_Dist_Line" },
+        { 'F', 'C', 101, "Theodolite_Line" },
+        { 'F', 'C', 102, "Range_Centerline" },
+        { 'F', 'C', 130, "Radar_Ref_Line" },
+        { 'F', 'C', 165, "Route-Maritime" },
+        { 'F', 'C', 166, "Route-Deep_Water" },
+        { 'F', 'C', 167, "Defined_Water" },
+        { 'F', 'C', 168, "Route-Canal" },
+        { 'F', 'C', 170, "Safety_Fairway" },
+        { 'F', 'C', 177, "Swept_Area" },
+        { 'F', 'C', 179, "Side_Scan_Sonar_Coverage" },
+        { 'F', 'C', 200, "Mine_Counter_Measure_Area" },
+        { 'G', 'A', 5, "Airspace" },
+        { 'G', 'A', 10, "ATS_Segment" },
+        { 'G', 'A', 15, "Spec_Use_Airspace" },
+        { 'G', 'A', 20, "Airspace_Bndry_Seg" },
+        { 'G', 'A', 25, "Spec_Airspace_Seg" },
+        { 'G', 'A', 30, "Off_Route_Bearing" },
+        { 'G', 'A', 31, "Lead_Radial" },
+        { 'G', 'A', 35, "NAVAIDS" },
+        { 'G', 'A', 45, "Route" },
+        { 'G', 'A', 47, "Terminal_Route" },
+        { 'G', 'A', 48, "ILS_Component" },
+        { 'G', 'A', 49, "ILS_Terminal_Seg" },
+        { 'G', 'A', 55, "Waypoint" },
+        { 'G', 'A', 65, "Air_Warning_Light" },
+        { 'G', 'A', 70, "Primary_Surface" },
+        { 'G', 'A', 71, "Apprch_Surface" },
+        { 'G', 'A', 72, "Apprch_Trans_Surface" },
+        { 'G', 'A', 73, "Inner_Hor_Surface" },
+        { 'G', 'A', 74, "Conical_Surface" },
+        { 'G', 'A', 75, "Outer_Hor_Surface" },
+        { 'G', 'A', 76, "Hor_Trans_Surface" },
+        { 'G', 'A', 400, "Aerodrome_Associated_Strip" },
+        { 'G', 'B', 5, "Airport" },
+        { 'G', 'B', 6, "Airfield" },
+        { 'G', 'B', 7, "Airport_Area" },
+        { 'G', 'B', 10, "Airport_Lighting" },
+        { 'G', 'B', 15, "Apron" },
+        { 'G', 'B', 20, "Arresting_Gear" },
+        { 'G', 'B', 25, "Blast_Barrier" },
+        { 'G', 'B', 30, "Helo_Landing_Pad" },
+        { 'G', 'B', 35, "Heliport" },
+        { 'G', 'B', 40, "Launch_Pad" },
+        { 'G', 'B', 45, "Overrun_or_Stopway" },
+        { 'G', 'B', 46, "Touchdown_Zone" },
+        { 'G', 'B', 50, "Revetment" },
+        { 'G', 'B', 55, "Runway" },
+        { 'G', 'B', 56, "Runway_Endpoint" },
+        { 'G', 'B', 57, "Shoulder" },
+        { 'G', 'B', 58, "Point_Abeam" },
+        { 'G', 'B', 59, "Airfield_Elev_Pt" },
+        { 'G', 'B', 60, "Rwy_Radar_Reflector" },
+        { 'G', 'B', 65, "Seaplane_Base" },
+        { 'G', 'B', 70, "Seaplane_Ldg_Area" },
+        { 'G', 'B', 75, "Taxiway" },
+        { 'G', 'B', 80, "Wind_Sock" },
+        { 'G', 'B', 90, "Displaced_Threshold" },
+        { 'G', 'B', 160, "Decontamination_Pad" },
+        { 'G', 'B', 170, "INS_Alignment_Pad" },
+        { 'G', 'B', 220, "Air_Obstruction" },
+        { 'G', 'B', 221, "Misc_Obstruction" },
+        { 'G', 'B', 222, "Low_Air_Maneuver_Pylon" },
+        { 'G', 'B', 230, "Aircraft_Hangar" },
+        { 'G', 'B', 250, "Hardened_Aircraft_Shelter" },
+        { 'G', 'B', 900, "Runway_Marking" },
+        { 'G', 'B', 901, "Taxiway_Marking" },
+        { 'G', 'B', 902, "Roadway_Marking" },
+        { 'G', 'B', 903, "Other_Markings" },
+        { 'G', 'B', 904, "Instruction_Sign" },
+        { 'G', 'B', 905, "Location_Sign" },
+        { 'G', 'B', 906, "Direction_Sign" },
+        { 'G', 'B', 907, "Destination_Sign" },
+        { 'G', 'B', 908, "Information_Sign" },
+        { 'G', 'B', 909, "Runway_Distance_Sign" },
+        { 'G', 'C', 1, "Runway_Element" },
+        { 'G', 'C', 2, "Runway_Intersection" },
+        { 'G', 'C', 3, "Runway_Threshold" },
+        { 'G', 'C', 4, "Runway_Marking" },
+        { 'G', 'C', 5, "Painted_Centerline" },
+        { 'G', 'C', 6, "LAHSO_Location" },
+        { 'G', 'C', 7, "Arresting_Gear_Location" },
+        { 'G', 'C', 8, "Runway_Shoulder" },
+        { 'G', 'C', 9, "Stopway" },
+        { 'G', 'C', 10, "Runway_Displaced_Area" },
+        { 'G', 'C', 11, "Blastpad" },
+        { 'G', 'C', 12, "Runway_Exit_Line" },
+        { 'G', 'C', 13, "Helipad_FATO" },
+        { 'G', 'C', 14, "Helipad_TLOF" },
+        { 'G', 'C', 15, "Helipad_Threshold" },
+        { 'G', 'C', 16, "Taxiway_Element" },
+        { 'G', 'C', 17, "Taxiway_Shoulder" },
+        { 'G', 'C', 18, "Taxiway_Guidance_Line" },
+        { 'G', 'C', 19, "Taxiway_Intxn_Marking" },
+        { 'G', 'C', 20, "Taxiway_Holding_Position" },
+        { 'G', 'C', 21, "Frequency_Area" },
+        { 'G', 'C', 22, "Apron_Element" },
+        { 'G', 'C', 23, "Stand_Guidance_Line" },
+        { 'G', 'C', 24, "Parking_Stand_Location" },
+        { 'G', 'C', 25, "Parking_Stand_Area" },
+        { 'G', 'C', 26, "Deicing_Area" },
+        { 'G', 'C', 27, "Service_Road" },
+        { 'G', 'C', 28, "Aerodrome_Ref_Point" },
+        { 'G', 'C', 29, "Vertical_Poly_Structure" },
+        { 'G', 'C', 30, "Vertical_Point_Structure" },
+        { 'G', 'C', 31, "Vertical_Line_Structure" },
+        { 'G', 'C', 32, "Construction_Area" },
+        { 'G', 'C', 33, "Water" },
+        { 'G', 'C', 34, "Hotspot" },
+        { 'G', 'C', 35, "Aerodrome_Surface_Light" },
+        { 'I', 'A', 10, "Map_Boundary" },
+        { 'I', 'A', 40, "Parcel" },
+        { 'I', 'A', 41, "Tract" },
+        { 'I', 'A', 50, "Cadastral_Const" },
+        { 'I', 'D', 10, "Cadastral_Point" },
+        { 'I', 'D', 20, "Fiducial_Point" },
+        { 'I', 'E', 10, "Map_Sheet" },
+        { 'I', 'E', 20, "Misc" },
+        { 'I', 'E', 40, "Map_Info" },
+        { 'K', 'B', 25, "Agricultural_Zone" },
+        { 'K', 'C', 50, "Time_Zone" },
+        { 'K', 'D', 25, "Monument" },
+        { 'K', 'E', 50, "Land_Reclamation_Area" },
+        { 'K', 'F', 0, "Transport_Link" },
+        { 'M', 'A', 0, "Solid_Rock" },
+        { 'M', 'A', 20, "Erosion_Area" },
+        { 'M', 'A', 30, "Geologic_Mass_Movement" },
+        { 'M', 'A', 40, "Geologic_Structure_Line" },
+        { 'M', 'A', 50, "Soil_Salinization_Area" },
+        { 'M', 'A', 60, "Mineral_Occurrence_Area" },
+        { 'M', 'A', 70, "Hydrogeologic_Area" },
+        { 'M', 'B', 0, "Epicentre" },
+        { 'M', 'B', 10, "Earthquake_Damage_Area" },
+        { 'M', 'C', 0, "Geologic_Mapping_Unit" },
+        { 'M', 'C', 10, "Hydrogeologic_Mapping_Unit" },
+        { 'N', 'A', 10, "Terrain_Relief" },
+        { 'N', 'A', 20, "Vegetation_Zone" },
+        { 'N', 'A', 30, "Tree_Limit" },
+        { 'N', 'A', 35, "Settlement_Limit" },
+        { 'N', 'A', 40, "Cultivation_Limit" },
+        { 'N', 'A', 170, "Drainage_Basin" },
+        { 'N', 'C', 0, "Desertification_Area" },
+        { 'N', 'C', 5, "Dry_Area" },
+        { 'N', 'C', 15, "Aggradation_Area" },
+        { 'N', 'C', 30, "Ecological_Crisis_Area" },
+        { 'N', 'C', 35, "Contaminated_Site" },
+        { 'N', 'D', 0, "Infection_Area" },
+        { 'N', 'D', 5, "Hazardous_Biome_Zone" },
+        { 'N', 'F', 10, "Precipitation_Zone" },
+        { 'N', 'F', 20, "Atmospheric_Humidity_Zone" },
+        { 'N', 'F', 30, "Solar_Irradiance_Zone" },
+        { 'N', 'F', 40, "Frost_and_or_Snow_Zone" },
+        { 'N', 'F', 45, "Fog_Zone" },
+        { 'N', 'G', 0, "Global_Wind_Belt" },
+        { 'N', 'G', 10, "Regional_Wind_Zone" },
+        { 'N', 'G', 15, "Atmospheric_Pressure_Zone" },
+        { 'N', 'G', 25, "Extreme_Wind_Zone" },
+        { 'N', 'H', 180, "Ocean_Region" },
+        { 'S', 'A', 10, "Common_Open_Water" },
+        { 'S', 'A', 20, "Disturbed_Soil" },
+        { 'S', 'A', 30, "Exposed_Bedrock" },
+        { 'S', 'A', 40, "Permanent_Snowfield" },
+        { 'S', 'A', 50, "Slope_Polygon" },
+        { 'S', 'A', 60, "Covered_Drainage" },
+        { 'S', 'A', 70, "Seismic_Activity_Area" },
+        { 'S', 'U', 1, "Military_Base" },
+        { 'S', 'U', 2, "Subway" },
+        { 'S', 'U', 3, "Port_Facility" },
+        { 'U', 'A', 1, "Aperture" },
+        { 'U', 'A', 2, "Component" },
+        { 'U', 'A', 3, "Datum" },
+        { 'U', 'A', 4, "Furniture" },
+        { 'U', 'A', 5, "Man_Made_Object" },
+        { 'U', 'A', 6, "Marine_Object" },
+        { 'U', 'A', 7, "Mesh" },
+        { 'U', 'A', 8, "Non_Empty_Set" },
+        { 'U', 'A', 9, "Object" },
+        { 'U', 'A', 10, "Object_Set" },
+        { 'U', 'A', 11, "Related_Object_Set" },
+        { 'U', 'A', 12, "Set" },
+        { 'U', 'A', 13, "System" },
+        { 'U', 'A', 14, "Terrain_Surface_Object" },
+        { 'U', 'A', 15, "Time_Analysis_Base_Set" },
+        { 'U', 'A', 16, "Time_Forecast_Tau_Set" },
+        { 'U', 'C', 1, "Flagpole" },
+        { 'U', 'D', 1, "Haystack" },
+        { 'U', 'D', 2, "Mixed_Urban_Region" },
+        { 'U', 'F', 0, "Aperture_Generic" },
+        { 'U', 'F', 1, "Breach_Hole" },
+        { 'U', 'F', 2, "Building_Component_Entrance_Or_Exit" },
+        { 'U', 'F', 3, "Door" },
+        { 'U', 'F', 4, "Entrance_or_Exit" },
+        { 'U', 'F', 5, "Wall_Opening" },
+        { 'U', 'F', 6, "Partition_Opening" },
+        { 'U', 'F', 7, "Trap_Door" },
+        { 'U', 'F', 8, "Wall_Loophole" },
+        { 'U', 'F', 9, "Window" },
+        { 'U', 'F', 10, "Ventilation_Opening" },
+        { 'U', 'G', 0, "Room_Generic" },
+        { 'U', 'G', 1, "Anteroom" },
+        { 'U', 'G', 2, "Atrium" },
+        { 'U', 'G', 3, "Compartment_Room" },
+        { 'U', 'G', 4, "Compartment_Shaft" },
+        { 'U', 'G', 5, "Balcony" },
+        { 'U', 'G', 6, "Catwalk" },
+        { 'U', 'G', 7, "Closet" },
+        { 'U', 'G', 8, "Compartment_Duct" },
+        { 'U', 'G', 9, "Courtyard" },
+        { 'U', 'G', 10, "Elevator" },
+        { 'U', 'G', 11, "Elevator_Shaft" },
+        { 'U', 'G', 12, "Escalator" },
+        { 'U', 'G', 13, "Exterior_Hallway" },
+        { 'U', 'G', 14, "Fire_Escape" },
+        { 'U', 'G', 15, "Hallway" },
+        { 'U', 'G', 16, "Pulpit" },
+        { 'U', 'G', 17, "Ramp" },
+        { 'U', 'G', 18, "Stair" },
+        { 'U', 'G', 19, "Ventilation_Duct" },
+        { 'U', 'G', 20, "Ventilation_Shaft" },
+        { 'U', 'G', 21, "Vertical_Passage" },
+        { 'U', 'G', 22, "Stair_Set" },
+        { 'U', 'H', 0, "Section_Generic" },
+        { 'U', 'I', 0, "Fixture_Generic" },
+        { 'U', 'I', 1, "Compartment_Content" },
+        { 'U', 'I', 2, "Control_Panel" },
+        { 'U', 'I', 3, "Furnace" },
+        { 'U', 'I', 4, "Furniture" },
+        { 'U', 'I', 5, "Heat_Radiator" },
+        { 'U', 'J', 0, "Floor_Level_Generic" },
+        { 'U', 'J', 1, "Compartment_Layer" },
+        { 'U', 'J', 2, "Attic" },
+        { 'U', 'J', 3, "Basement" },
+        { 'U', 'J', 4, "Crawl_Space" },
+        { 'U', 'J', 5, "Mezzanine" },
+        { 'U', 'J', 6, "Roof_Assembly" },
+        { 'U', 'K', 0, "Ceiling" },
+        { 'U', 'K', 1, "Floor" },
+        { 'U', 'K', 2, "Partition" },
+        { 'U', 'K', 3, "Ventilation_Duct_Wall" },
+        { 'U', 'K', 4, "Wall" },
+        { 'U', 'N', 1, "Boundary_Component" },
+        { 'U', 'N', 2, "Change_Line" },
+        { 'U', 'N', 3, "Data_Quality_Boundary" },
+        { 'U', 'O', 1, "Acoustic_Transducer" },
+        { 'U', 'O', 3, "Anemometer" },
+        { 'U', 'O', 4, "Automated_Teller_Machine" },
+        { 'U', 'O', 6, "Control_Panel" },
+        { 'U', 'O', 7, "Device" },
+        { 'U', 'O', 8, "Dragline" },
+        { 'U', 'O', 9, "Equipment" },
+        { 'U', 'O', 10, "Equipment_Component" },
+        { 'U', 'O', 11, "Escalator" },
+        { 'U', 'O', 12, "Explosive_Charge" },
+        { 'U', 'O', 13, "Explosive_Land_Mine" },
+        { 'U', 'O', 14, "Explosive_Mine" },
+        { 'U', 'O', 15, "Fire_Escape" },
+        { 'U', 'O', 16, "Food_Oven" },
+        { 'U', 'O', 17, "Heat_Radiator" },
+        { 'U', 'O', 18, "Lift" },
+        { 'U', 'O', 19, "Marine_Aid_To_Navigation" },
+        { 'U', 'O', 20, "Munition" },
+        { 'U', 'O', 21, "Refuse_Bin" },
+        { 'U', 'O', 22, "Shovel" },
+        { 'U', 'O', 23, "Supplies_And_Expendables" },
+        { 'U', 'O', 24, "Underwater_Communication_Device" },
+        { 'U', 'O', 25, "Wind_Vane" },
+        { 'U', 'O', 26, "Container" },
+        { 'U', 'O', 27, "Railway_Signal_Box" },
+        { 'U', 'T', 1, "Breakwater" },
+        { 'U', 'T', 2, "Dyke" },
+        { 'U', 'T', 3, "Lock_Gate" },
+        { 'U', 'T', 4, "Non_Submarine_Contact" },
+        { 'U', 'T', 5, "Shoreline_Construction" },
+        { 'U', 'T', 6, "Tide_Lock" },
+        { 'U', 'T', 7, "Levee" },
+        { 'U', 'V', 1, "Dock" },
+        { 'U', 'V', 2, "Marine_Clearing_Line" },
+        { 'U', 'V', 3, "Marine_Signal_Station" },
+        { 'U', 'V', 4, "Navigable_Waterway" },
+        { 'U', 'V', 5, "Shoal" },
+        { 'U', 'V', 6, "Turning_Basin" },
+        { 'U', 'V', 7, "Wet_Dock" },
+        { 'U', 'W', 1, "Bombora_Region" },
+        { 'U', 'W', 2, "Estuary" },
+        { 'U', 'W', 3, "Fiord" },
+        { 'U', 'W', 4, "Hydrography" },
+        { 'U', 'W', 5, "Hydrologic_Object" },
+        { 'U', 'W', 6, "Marine_Bay" },
+        { 'U', 'W', 7, "Marine_Gulf" },
+        { 'U', 'W', 8, "Marine_Sound" },
+        { 'U', 'W', 9, "Marine_Strait" },
+        { 'U', 'W', 10, "Ocean" },
+        { 'U', 'W', 11, "Polynya" },
+        { 'U', 'W', 12, "Prevailing_Current" },
+        { 'U', 'W', 13, "Run_Off" },
+        { 'U', 'W', 14, "Sea" },
+        { 'U', 'W', 15, "Spring" },
+        { 'U', 'W', 16, "Underwater_Region" },
+        { 'U', 'W', 17, "Waterbody" },
+        { 'U', 'W', 18, "Waterbody_Basin" },
+        { 'U', 'W', 19, "Waterbody_Current" },
+        { 'U', 'W', 20, "Waterbody_Region" },
+        { 'U', 'W', 21, "Water_Channel" },
+        { 'U', 'W', 22, "Water_Current" },
+        { 'U', 'W', 23, "Watercourse" },
+        { 'U', 'W', 24, "Inlet" },
+        { 'U', 'X', 1, "Hoar_Frost" },
+        { 'U', 'X', 2, "Ice" },
+        { 'U', 'X', 3, "Ice_Glaze" },
+        { 'U', 'X', 4, "Ice_Keel" },
+        { 'U', 'X', 5, "Rime" },
+        { 'U', 'X', 6, "Snow_Ground_Cover" },
+        { 'U', 'Z', 1, "Cargo" },
+        { 'U', 'Z', 2, "Drilling_Rig" },
+        { 'U', 'Z', 3, "Industrial_Oven" },
+        { 'U', 'Z', 4, "Market_Place" },
+        { 'U', 'Z', 5, "Natural_Gas_Rig" },
+        { 'U', 'Z', 6, "Soda_Evaporator" },
+        { 'V', 'A', 2, "Buried_Electrical_Cable" },
+        { 'V', 'A', 3, "Buried_Power_Transmission_Line" },
+        { 'V', 'A', 4, "Institutional_Facility" },
+        { 'V', 'A', 5, "Manhole" },
+        { 'V', 'A', 6, "Manhole_Cover" },
+        { 'V', 'A', 7, "Manhole_Riser" },
+        { 'V', 'A', 8, "Pipeline_Terminus" },
+        { 'V', 'A', 9, "Piping_Complex" },
+        { 'V', 'A', 10, "Power_Transmission_Line_Terminus" },
+        { 'V', 'A', 11, "Public_Service_Station" },
+        { 'V', 'A', 12, "Sewer" },
+        { 'V', 'A', 13, "Sludge_Gate" },
+        { 'V', 'A', 14, "Transmission_Station" },
+        { 'V', 'C', 1, "Bridge_Platform" },
+        { 'V', 'C', 2, "Bus_Stop" },
+        { 'V', 'C', 3, "Causeway" },
+        { 'V', 'C', 4, "Driveway" },
+        { 'V', 'C', 5, "Engineer_Bridge" },
+        { 'V', 'C', 6, "Land_Transportation_Route" },
+        { 'V', 'C', 7, "Level_Crossing" },
+        { 'V', 'C', 8, "Log_Crib" },
+        { 'V', 'C', 9, "Mobile_Bridge_System" },
+        { 'V', 'C', 10, "Overpass" },
+        { 'V', 'C', 11, "Railway_Signal_Structure" },
+        { 'V', 'C', 12, "Railway_Track" },
+        { 'V', 'C', 13, "Rock_Drop" },
+        { 'V', 'C', 14, "Route_Lane" },
+        { 'V', 'C', 15, "Sidewalk" },
+        { 'V', 'C', 16, "Tunnel" },
+        { 'V', 'C', 17, "Viaduct" },
+        { 'V', 'C', 18, "Weapon_Fighting_Pos_Access_Route" },
+        { 'V', 'D', 1, "Bioluminescence" },
+        { 'V', 'D', 2, "Display_Light" },
+        { 'V', 'D', 3, "Phosphorescent_Region" },
+        { 'V', 'D', 4, "Shadow" },
+        { 'V', 'E', 1, "Shore" },
+        { 'V', 'F', 1, "Alga" },
+        { 'V', 'F', 2, "Fungus" },
+        { 'V', 'F', 3, "Lichen" },
+        { 'V', 'F', 4, "Living_Organism" },
+        { 'V', 'F', 5, "Moneran" },
+        { 'V', 'F', 6, "Mushroom" },
+        { 'V', 'F', 7, "Plankton" },
+        { 'V', 'F', 8, "Protist" },
+        { 'V', 'G', 3, "Centre_Line" },
+        { 'V', 'G', 4, "Direction" },
+        { 'V', 'G', 5, "Hazard_Marker" },
+        { 'V', 'G', 6, "High_Pressure_Centre" },
+        { 'V', 'G', 7, "Isopleth" },
+        { 'V', 'G', 8, "Line" },
+        { 'V', 'G', 9, "Location" },
+        { 'V', 'G', 10, "Planetary_Pole" },
+        { 'V', 'G', 11, "Railway_Nexus" },
+        { 'V', 'G', 12, "Ray_Path" },
+        { 'V', 'G', 13, "Region" },
+        { 'V', 'G', 14, "Relative_Displacement_Line" },
+        { 'V', 'G', 15, "River_Nexus" },
+        { 'V', 'G', 16, "Site" },
+        { 'V', 'G', 17, "Transportation_Route" },
+        { 'V', 'G', 18, "Variable_Displacement_Line" },
+        { 'V', 'G', 19, "Wadi_Nexus" },
+        { 'V', 'I', 1, "Abatis" },
+        { 'V', 'I', 2, "Air_Defence_Artillery" },
+        { 'V', 'I', 3, "Breach" },
+        { 'V', 'I', 4, "Breach_Hole" },
+        { 'V', 'I', 5, "Defensive_Position" },
+        { 'V', 'I', 6, "Defensive_Position_Defilade" },
+        { 'V', 'I', 7, "Field_Artillery" },
+        { 'V', 'I', 8, "Fighting_Position" },
+        { 'V', 'I', 9, "Individual_Fighting_Position" },
+        { 'V', 'I', 10, "Land_Minefield" },
+        { 'V', 'I', 11, "Marine_Minefield" },
+        { 'V', 'I', 12, "Minefield" },
+        { 'V', 'I', 13, "Missile" },
+        { 'V', 'I', 14, "Mortar" },
+        { 'V', 'I', 15, "Parapet" },
+        { 'V', 'I', 16, "Prohibited_Region" },
+        { 'V', 'I', 17, "Self_Propelled_Artillery" },
+        { 'V', 'I', 18, "Terrain_Crater" },
+        { 'V', 'I', 19, "Terrain_Transportation_Abatis" },
+        { 'V', 'I', 20, "Towed_Artillery" },
+        { 'V', 'I', 21, "Weapon" },
+        { 'V', 'I', 22, "Weapon_Fighting_Position" },
+        { 'V', 'I', 23, "Weapon_Full_Defilade_Position" },
+        { 'V', 'I', 24, "Weapon_Hull_Defilade_Position" },
+        { 'V', 'I', 25, "Weapon_System" },
+        { 'V', 'J', 1, "Butte" },
+        { 'V', 'J', 2, "Canyon" },
+        { 'V', 'J', 3, "Desert_Region" },
+        { 'V', 'J', 4, "Dry_Lake" },
+        { 'V', 'J', 5, "Excavation" },
+        { 'V', 'J', 6, "Filled_Terrain" },
+        { 'V', 'J', 7, "Flood_Basin" },
+        { 'V', 'J', 8, "Geographic_Basin" },
+        { 'V', 'J', 9, "Glade" },
+        { 'V', 'J', 10, "Isthmus" },
+        { 'V', 'J', 11, "Jungle" },
+        { 'V', 'J', 12, "Mesa" },
+        { 'V', 'J', 13, "Mountain" },
+        { 'V', 'J', 14, "Mountainous_Region" },
+        { 'V', 'J', 15, "Named_Land_Tract" },
+        { 'V', 'J', 16, "Permafrost" },
+        { 'V', 'J', 17, "Permanent_Snowfield" },
+        { 'V', 'J', 18, "Planetary_Surface" },
+        { 'V', 'J', 19, "Plateau" },
+        { 'V', 'J', 20, "Polar_Cap" },
+        { 'V', 'J', 21, "Promontory" },
+        { 'V', 'J', 22, "Ridge" },
+        { 'V', 'J', 23, "Sand" },
+        { 'V', 'J', 24, "Sand_Bar" },
+        { 'V', 'J', 25, "Snowfield" },
+        { 'V', 'J', 26, "Soil" },
+        { 'V', 'J', 27, "Stone" },
+        { 'V', 'J', 28, "Sugar_Cane" },
+        { 'V', 'J', 29, "Terrain" },
+        { 'V', 'J', 30, "Terrain_Channel" },
+        { 'V', 'J', 31, "Terrain_Fill" },
+        { 'V', 'J', 32, "Terrain_Plain" },
+        { 'V', 'J', 33, "Terrain_Strip" },
+        { 'V', 'J', 34, "Terrain_Surface_Region" },
+        { 'V', 'J', 35, "Tract" },
+        { 'V', 'J', 36, "Tree_Blowdown" },
+        { 'V', 'J', 37, "Valley_Region" },
+        { 'V', 'J', 38, "Wadi" },
+        { 'V', 'J', 39, "Waterbody_Bank" },
+        { 'V', 'J', 40, "Wetland" },
+        { 'V', 'J', 41, "Boulder_Field" },
+        { 'V', 'K', 1, "Fern" },
+        { 'V', 'K', 2, "Log" },
+        { 'V', 'K', 3, "Plant" },
+        { 'V', 'K', 4, "Pteridophyte" },
+        { 'V', 'K', 5, "Tree_Line" },
+        { 'V', 'K', 6, "Vegetation" },
+        { 'V', 'N', 1, "Open_Air_Bath" },
+        { 'V', 'O', 1, "Convent" },
+        { 'V', 'O', 2, "Marabout" },
+        { 'V', 'O', 3, "Mosque" },
+        { 'V', 'O', 4, "Pulpit" },
+        { 'V', 'O', 5, "Shrine" },
+        { 'V', 'O', 6, "Stupa" },
+        { 'V', 'O', 7, "Synagogue" },
+        { 'V', 'O', 8, "Tabernacle" },
+        { 'V', 'P', 1, "Amphitheatre" },
+        { 'V', 'P', 2, "Apartment_House" },
+        { 'V', 'P', 3, "Barrack" },
+        { 'V', 'P', 4, "Camber" },
+        { 'V', 'P', 5, "Community_Recreation_Facility" },
+        { 'V', 'P', 6, "Dwelling" },
+        { 'V', 'P', 7, "Farm_Storage_Structure" },
+        { 'V', 'P', 8, "Hardened_Aircraft_Shelter" },
+        { 'V', 'P', 9, "Industrial_Building" },
+        { 'V', 'P', 10, "Manufacturing_Facility" },
+        { 'V', 'P', 11, "Monastery" },
+        { 'V', 'P', 12, "Reformatory_Facility" },
+        { 'V', 'P', 13, "Religious_Community" },
+        { 'V', 'P', 14, "Rowhouse" },
+        { 'V', 'P', 15, "Science_Facility" },
+        { 'V', 'P', 16, "Shelter" },
+        { 'V', 'P', 17, "Tent" },
+        { 'V', 'P', 18, "Tent_Dwelling" },
+        { 'V', 'P', 19, "Training_Building" },
+        { 'V', 'P', 20, "Transportation_Building" },
+        { 'V', 'P', 21, "Transportation_Facility" },
+        { 'V', 'P', 22, "Tunnel_Shelter" },
+        { 'V', 'P', 23, "Repair_Facility" },
+        { 'V', 'R', 1, "Electrified_Railway_Pylon" },
+        { 'V', 'R', 2, "Exterior_Wall" },
+        { 'V', 'R', 3, "Load_Cable" },
+        { 'V', 'R', 4, "Pole" },
+        { 'V', 'R', 5, "Pylon" },
+        { 'V', 'R', 6, "Storage_Pit" },
+        { 'V', 'R', 7, "Structure" },
+        { 'V', 'R', 8, "Structure_Exterior" },
+        { 'V', 'R', 9, "Structure_Perimeter" },
+        { 'V', 'R', 10, "Superstructure" },
+        { 'V', 'R', 11, "Wall_Loophole" },
+        { 'V', 'S', 1, "Surface" },
+        { 'V', 'U', 1, "Data_Quality_Region" },
+        { 'V', 'U', 2, "Depth_Contour_Line" },
+        { 'V', 'U', 3, "Distance_Mark" },
+        { 'V', 'U', 4, "Hydrographic_Survey_Contact" },
+        { 'V', 'U', 5, "Land_Easement" },
+        { 'V', 'U', 6, "Map" },
+        { 'V', 'U', 7, "Map_Limits" },
+        { 'V', 'U', 8, "Sounding_Datum" },
+        { 'V', 'U', 9, "Surface_Datum" },
+        { 'V', 'U', 10, "Vertical_Datum" },
+        { 'V', 'X', 1, "Cargo_Container" },
+        { 'V', 'X', 2, "Catwalk" },
+        { 'V', 'X', 3, "Cross_Country_Barrier" },
+        { 'V', 'X', 4, "Mooring_Line" },
+        { 'V', 'X', 5, "Route_Component" },
+        { 'V', 'X', 6, "Traffic_Separation_Scheme" },
+        { 'V', 'X', 7, "Wire_Obstacle" },
+        { 'V', 'Y', 1, "Agricultural_Facility" },
+        { 'V', 'Y', 2, "Aircraft_Landing_Zone" },
+        { 'V', 'Y', 3, "Aircraft_Storage_Tract" },
+        { 'V', 'Y', 4, "Airstrip" },
+        { 'V', 'Y', 5, "Arboretum" },
+        { 'V', 'Y', 6, "Cargo_Container_Facility" },
+        { 'V', 'Y', 7, "City" },
+        { 'V', 'Y', 8, "Extraction_Facility" },
+        { 'V', 'Y', 9, "Facility" },
+        { 'V', 'Y', 10, "Farm" },
+        { 'V', 'Y', 11, "Firebreak" },
+        { 'V', 'Y', 12, "Grounds" },
+        { 'V', 'Y', 13, "Heavy_Industrial_Facility" },
+        { 'V', 'Y', 14, "Indigenous_Burial_Ground" },
+        { 'V', 'Y', 15, "Indigenous_Peoples_Reserve" },
+        { 'V', 'Y', 16, "Land_Fish_Hatchery" },
+        { 'V', 'Y', 17, "Landfill" },
+        { 'V', 'Y', 18, "Light_Industrial_Facility" },
+        { 'V', 'Y', 19, "Marine_Port" },
+        { 'V', 'Y', 20, "Military_Facility" },
+        { 'V', 'Y', 21, "Municipal_Utility_Facility" },
+        { 'V', 'Y', 22, "Museum_Facility" },
+        { 'V', 'Y', 23, "Nuclear_Weapons_Facility" },
+        { 'V', 'Y', 24, "Ore_Refinery" },
+        { 'V', 'Y', 25, "Petroleum_Tank_Farm" },
+        { 'V', 'Y', 26, "Prepared_Defensive_Position_Site" },
+        { 'V', 'Y', 27, "Prepared_Defensive_Tract" },
+        { 'V', 'Y', 28, "Recreational_Facility" },
+        { 'V', 'Y', 29, "Refugee_Compound" },
+        { 'V', 'Y', 30, "Regional_Park" },
+        { 'V', 'Y', 31, "Reserve" },
+        { 'V', 'Y', 32, "Residential_Region" },
+        { 'V', 'Y', 33, "Retail_Facility" },
+        { 'V', 'Y', 34, "Safari_Park" },
+        { 'V', 'Y', 35, "Shanty_Town" },
+        { 'V', 'Y', 36, "Spaceport" },
+        { 'V', 'Y', 37, "Temporary_Encampment" },
+        { 'V', 'Y', 38, "Town" },
+        { 'V', 'Y', 39, "Vessel_Storage_Anchorage" },
+        { 'V', 'Y', 40, "Waterbody_Shelter_Basin" },
+        { 'V', 'Y', 41, "Detention_Facility" },
+        { 'V', 'Y', 42, "Government_Facility" },
+        { 'W', 'A', 1, "Abyss" },
+        { 'W', 'A', 2, "Bathymetric_Province" },
+        { 'W', 'A', 3, "Inland_Water_Bottom" },
+        { 'W', 'A', 4, "Ocean_Basin" },
+        { 'W', 'A', 5, "Ocean_Floor" },
+        { 'W', 'A', 6, "Seamount" },
+        { 'W', 'A', 7, "Waterbody_Floor" },
+        { 'W', 'A', 8, "Waterbody_Floor_Canyon" },
+        { 'W', 'A', 9, "Waterbody_Floor_Pinnacle" },
+        { 'W', 'A', 10, "Waterbody_Floor_Province" },
+        { 'W', 'A', 11, "Waterbody_Floor_Region" },
+        { 'W', 'A', 12, "Waterbody_Floor_Ridge" },
+        { 'W', 'A', 13, "Waterbody_Floor_Trench" },
+        { 'W', 'C', 1, "Ice_Sludge" },
+        { 'W', 'C', 3, "Overfall_Region" },
+        { 'W', 'C', 4, "Plankton_Bloom" },
+        { 'W', 'C', 5, "Pressure_Ice" },
+        { 'W', 'C', 7, "Spring_Tide" },
+        { 'W', 'C', 8, "Surf" },
+        { 'W', 'C', 10, "Tidal_Basin" },
+        { 'W', 'C', 13, "Waterbody_Surface" },
+        { 'W', 'C', 15, "Iceberg" },
+        { 'W', 'C', 16, "Surf_Zone" },
+        { 'W', 'C', 17, "Waterbody_Surface_Region" },
+        { 'W', 'C', 18, "Waterbody_Surface_Slick" },
+        { 'Z', 'B', 20, "Benchmark" },
+        { 'Z', 'B', 30, "Boundary_Monument" },
+        { 'Z', 'B', 31, "Unmonumented_Point" },
+        { 'Z', 'B', 32, "Baseline_Point" },
+        { 'Z', 'B', 35, "Control_Point" },
+        { 'Z', 'B', 36, "Distance_Mark" },
+        { 'Z', 'B', 40, "Diagnostic_Point" },
+        { 'Z', 'B', 60, "Geodetic_Point" },
+        { 'Z', 'C', 40, "Magnetic_Disturbance" },
+        { 'Z', 'C', 50, "Isogonic_Line" },
+        { 'Z', 'C', 51, "Magnetic_Pole" },
+        { 'Z', 'C', 500, "Geophysical_Anomaly" },
+        { 'Z', 'D', 1, "Network" },
+        { 'Z', 'D', 3, "Artifact" },
+        { 'Z', 'D', 12, "Geographic" },
+        { 'Z', 'D', 15, "Point_of_Change" },
+        { 'Z', 'D', 19, "Misc_Feature_Type" },
+        { 'Z', 'D', 20, "Void_Collection_Area" },
+        { 'Z', 'D', 30, "Cultural_Context_Location" },
+        { 'Z', 'D', 40, "Named_Location" },
+        { 'Z', 'D', 45, "Text_Description" },
+        { 'Z', 'I', 1, "Source_Info" },
+        { 'Z', 'I', 2, "Restriction_Info" },
+        { 'Z', 'I', 3, "Identification_Info" },
+        { 'Z', 'I', 4, "Process_Step_Info" },
+        { 'Z', 'I', 5, "Geo_Name_Info" },
+        { 'Z', 'I', 6, "Note" },
+        { 'Z', 'I', 7, "Point_Geometry_Info" },
+        { 'Z', 'I', 8, "Curve_Geometry_Info" },
+        { 'Z', 'I', 9, "Surface_Geometry_Info" },
+        { 'Z', 'I', 10, "Horiz_Coord_Metadata" },
+        { 'Z', 'I', 11, "Vert_Coord_Metadata" },
+        { 'Z', 'I', 12, "Sounding_Metadata" },
+        { 'Z', 'I', 13, "Crop_Info" },
+        { 'Z', 'I', 14, "Manufacturing_Info" },
+        { 'Z', 'I', 15, "Geo_Name_Collection" },
+        { 'Z', 'I', 16, "Route_Pavement_Info" },
+        { 'Z', 'I', 17, "Track_Info" },
+        { 'Z', 'I', 18, "Wireless_Telecom_Info" },
+        { 'Z', 'I', 19, "Aerodrome_Pavement_Info" },
+        { 'Z', 'I', 20, "Geopolitical_Entity_Desig" },
+        { 'Z', 'I', 21, "Admin_Division_Desig" },
+        { 'Z', 'I', 24, "Water_Resource_Info" },
+        { 'Z', 'I', 25, "Hydro_Vert_Positioning_Info" },
+        { 'Z', 'I', 26, "Feature_G_A_Metadata" },
+        { 'Z', 'I', 27, "Feature_Att_G_A_Metadata" },
+        { 'Z', 'I', 28, "Feature_Entity" },
+        { 'Z', 'I', 29, "Geometry_Info" },
+        { 'Z', 'I', 30, "Event_Entity" },
+        { 'Z', 'I', 31, "Dataset" },
+        { 'Z', 'I', 32, "Pylon_Info" },
+        { 'Z', 'I', 33, "Series" },
+        { 'Z', 'I', 34, "Entity" },
+        { 'Z', 'I', 35, "Entity_Collection" },
+        { 'Z', 'I', 36, "Information_Entity" },
+        { 'Z', 'I', 37, "Religious_Info" },
+        { 'Z', 'V', 10, "Anti_Shipping_Activity" },
+    };
+
+    // Where a two letter FACC prefix lives in the tables above.
+    struct PrefixRecord
+    {
+        int16_t Category { -1 };
+        int16_t Subcategory { -1 };
+        uint16_t FirstType { 0 };
+        uint16_t TypeCount { 0 };
+    };
+
+    constexpr int PrefixIndex(char category, char subcategory)
+    {
+        return ((category < 'A') || (category > 'Z') || (subcategory < 'A') || (subcategory > 'Z')) ? -1 : ((category - 'A') * 26) + (subcategory - 'A');
+    }
+
+    constexpr bool TypesSorted()
+    {
+        for(size_t i = 1; i < std::size(types); ++i)
+        {
+            auto& a = types[i - 1];
+            auto& b = types[i];
+            if((a.Category > b.Category) || ((a.Category == b.Category) && (a.Subcategory > b.Subcategory)))
+                return false;
+            if((a.Category == b.Category) && (a.Subcategory == b.Subcategory) && (a.Key >= b.Key))
+                return false;
+        }
+        return true;
+    }
+    static_assert(TypesSorted(), "FACC types must be sorted and unique");
+
+    constexpr std::array<PrefixRecord, 26 * 26> BuildPrefixes()
+    {
+        auto result = std::array<PrefixRecord, 26 * 26>();
+        for(size_t i = 0; i < std::size(categories); ++i)
+        {
+            for(char subcategory = 'A'; subcategory <= 'Z'; ++subcategory)
+                result[PrefixIndex(categories[i].Key, subcategory)].Category = int16_t(i);
+        }
+        for(size_t i = 0; i < std::size(subcategories); ++i)
+            result[PrefixIndex(subcategories[i].Category, subcategories[i].Key)].Subcategory = int16_t(i);
+        for(size_t i = 0; i < std::size(types); ++i)
+        {
+            auto& prefix = result[PrefixIndex(types[i].Category, types[i].Subcategory)];
+            if(prefix.TypeCount == 0)
+                prefix.FirstType = uint16_t(i);
+            ++prefix.TypeCount;
+        }
+        return result;
+    }
+
+    constexpr auto prefixes = BuildPrefixes();
+}
+
+FeatureDataDictionary::Entry FeatureDataDictionary::Lookup(const std::string& facc)
 {
+    auto result = Entry();
     if(facc.size() != 5)
-        return std::string();
-    Category category = Categories[facc[0]];
-    Subcategory subcategory = category.Subcategories[facc[1]];
-    std::string type_key = facc.substr(2);
-    Type type = subcategory.Types[atoi(type_key.c_str())];
-    while(type_key.size() < 3)
-        type_key = "0" + type_key;
-    std::stringstream ss;
-    ss << category.Key << "_" << category.Name;
-    ss << "/" << subcategory.Key << "_" << subcategory.Name;
-    ss << "/" << type_key << "_" << type.Name;
-    return ss.str();
+        return result;
+    auto index = PrefixIndex(facc[0], facc[1]);
+    if(index < 0)
+        return result;
+    auto& prefix = prefixes[index];
+    if(prefix.Category >= 0)
+        result.Category = categories[prefix.Category].Name;
+    if(prefix.Subcategory >= 0)
+        result.Subcategory = subcategories[prefix.Subcategory].Name;
+    auto key = atoi(facc.substr(2).c_str());
+    auto first = &types[prefix.FirstType];
+    auto last = first + prefix.TypeCount;
+    auto it = std::lower_bound(first, last, key, [](const TypeRecord& type, int key) { return type.Key < key; });
+    if((it != last) && (it->Key == key))
+        result.Type = it->Name;
+    return result;
 }
 
-FeatureDataDictionary::FeatureDataDictionary()
+std::string FeatureDataDictionary::Subdirectory(const std::string& facc)
 {
-    AddCategory('A', "Culture");
-    Categories['A'].AddSubcategory('A', "Extraction");
-    Categories['A'].Subcategories['A'].AddType(10, "Mine");
-    Categories['A'].Subcategories['A'].AddType(11, "Quarry_Wall");
-    Categories['A'].Subcategories['A'].AddType(12, "Quarry");
-    Categories['A'].Subcategories['A'].AddType(13, "Pit");
-    Categories['A'].Subcategories['A'].AddType(40, "Rig_or_Superstructure");
-    Categories['A'].Subcategories['A'].AddType(50, "Well");
-    Categories['A'].Subcategories['A'].AddType(51, "Wellhead");
-    Categories['A'].Subcategories['A'].AddType(52, "Oil_or_Gas_Field");
-    Categories['A'].Subcategories['A'].AddType(60, "Gradation_Work");
-    Categories['A'].AddSubcategory('B', "Disposal");
-    Categories['A'].Subcategories['B'].AddType(0, "Disposal_Site");
-    Categories['A'].Subcategories['B'].AddType(10, "Scrap_Yard");
-    Categories['A'].Subcategories['B'].AddType(15, "Incinerator");
-    Categories['A'].Subcategories['B'].AddType(20, "Burner_Stack");
-    Categories['A'].Subcategories['B'].AddType(21, "Diffuser");
-    Categories['A'].Subcategories['B'].AddType(30, "Waste_Plant");
-    Categories['A'].Subcategories['B'].AddType(40, "Aeration_Basin");
-    Categories['A'].Subcategories['B'].AddType(507, "Waste_Heap");
-    Categories['A'].AddSubcategory('C', "Proc_Industry");
-    Categories['A'].Subcategories['C'].AddType(0, "Treatment_Plant");
-    Categories['A'].Subcategories['C'].AddType(10, "Blast_Furnace");
-    Categories['A'].Subcategories['C'].AddType(20, "Catalytic_Cracker");
-    Categories['A'].Subcategories['C'].AddType(30, "Settling_Basin");
-    Categories['A'].Subcategories['C'].AddType(40, "Oil_or_Gas_Facility");
-    Categories['A'].Subcategories['C'].AddType(50, "Works");
-    Categories['A'].Subcategories['C'].AddType(60, "Industrial_Furnace");
-    Categories['A'].Subcategories['C'].AddType(70, "Industrial_Park");
-    Categories['A'].Subcategories['C'].AddType(507, "Sewage_Treatment_Plant");
-    Categories['A'].AddSubcategory('D', "Power_Gen");
-    Categories['A'].Subcategories['D'].AddType(10, "Power_Plant");
-    Categories['A'].Subcategories['D'].AddType(20, "Solar_Panel");
-    Categories['A'].Subcategories['D'].AddType(25, "Solar_Farm");
-    Categories['A'].Subcategories['D'].AddType(30, "Substation");
-    Categories['A'].Subcategories['D'].AddType(40, "Nuclear_Reactor");
-    Categories['A'].Subcategories['D'].AddType(41, "Nuclear_Reactor_Containment");
-    Categories['A'].Subcategories['D'].AddType(50, "Heating_Plant");
-    Categories['A'].Subcategories['D'].AddType(55, "Cooling_Facility");
-    Categories['A'].Subcategories['D'].AddType(60, "Wind_Farm");
-    Categories['A'].AddSubcategory('E', "Fab_Industry");
-    Categories['A'].Subcategories['E'].AddType(10, "Assembly_Plant");
-    Categories['A'].AddSubcategory('F', "Ind_Structure");
-    Categories['A'].Subcategories['F'].AddType(10, "Smokestack");
-    Categories['A'].Subcategories['F'].AddType(20, "Conveyor");
-    Categories['A'].Subcategories['F'].AddType(21, "Bucket_Elevator");
-    Categories['A'].Subcategories['F'].AddType(30, "Cooling_Tower");
-    Categories['A'].Subcategories['F'].AddType(40, "Crane");
-    Categories['A'].Subcategories['F'].AddType(41, "Sheerleg");
-    Categories['A'].Subcategories['F'].AddType(50, "Dredger");
-    Categories['A'].Subcategories['F'].AddType(60, "Engine_Cell");
-    Categories['A'].Subcategories['F'].AddType(70, "Flare_Pipe");
-    Categories['A'].Subcategories['F'].AddType(80, "Hopper");
-    Categories['A'].AddSubcategory('G', "Commercial");
-    Categories['A'].Subcategories['G'].AddType(30, "Shopping_Complex");
-    Categories['A'].Subcategories['G'].AddType(40, "Office_Park");
-    Categories['A'].Subcategories['G'].AddType(50, "Billboard");
-    Categories['A'].AddSubcategory('H', "Institutional");
-    Categories['A'].Subcategories['H'].AddType(10, "Bastion");
-    Categories['A'].Subcategories['H'].AddType(20, "Trench");
-    Categories['A'].Subcategories['H'].AddType(30, "Hazard_Shelter");
-    Categories['A'].Subcategories['H'].AddType(50, "Fortification");
-    Categories['A'].Subcategories['H'].AddType(60, "Bunker");
-    Categories['A'].Subcategories['H'].AddType(70, "Checkpoint");
-    Categories['A'].AddSubcategory('I', "Residential");
-    Categories['A'].Subcategories['I'].AddType(20, "Mobile_Home_Park");
-    Categories['A'].Subcategories['I'].AddType(30, "Camp");
-    Categories['A'].AddSubcategory('J', "Agriculture");
-    Categories['A'].Subcategories['J'].AddType(10, "Circular_Irrigation");
-    Categories['A'].Subcategories['J'].AddType(20, "Siphon");
-    Categories['A'].Subcategories['J'].AddType(30, "Stockyard");
-    Categories['A'].Subcategories['J'].AddType(50, "Windmill");
-    Categories['A'].Subcategories['J'].AddType(51, "Windmotor");
-    Categories['A'].Subcategories['J'].AddType(55, "Water_Mill");
-    Categories['A'].Subcategories['J'].AddType(60, "Farm");
-    Categories['A'].Subcategories['J'].AddType(70, "Ranch");
-    Categories['A'].Subcategories['J'].AddType(80, "Stable");
-    Categories['A'].Subcategories['J'].AddType(85, "Barn");
-    Categories['A'].Subcategories['J'].AddType(90, "Cattle_Dipping_Tank");
-    Categories['A'].Subcategories['J'].AddType(100, "Agricultural_Colony");
-    Categories['A'].Subcategories['J'].AddType(110, "Greenhouse");
-    Categories['A'].Subcategories['J'].AddType(501, "Water_Wheel");
-    Categories['A'].Subcategories['J'].AddType(525, "Grange");
-    Categories['A'].AddSubcategory('K', "Recreational");
-    Categories['A'].Subcategories['K'].AddType(15, "Bandshell");
-    Categories['A'].Subcategories['K'].AddType(20, "Amst_Pk_Attract");
-    Categories['A'].Subcategories['K'].AddType(30, "Amst_Pk");
-    Categories['A'].Subcategories['K'].AddType(40, "Athletic_Field");
-    Categories['A'].Subcategories['K'].AddType(50, "Tennis_Court");
-    Categories['A'].Subcategories['K'].AddType(51, "Tennis_Complex");
-    Categories['A'].Subcategories['K'].AddType(60, "Campground");
-    Categories['A'].Subcategories['K'].AddType(61, "Picnic_Site");
-    Categories['A'].Subcategories['K'].AddType(70, "Drive-In_Theater");
-    Categories['A'].Subcategories['K'].AddType(80, "Theater_Screen");
-    Categories['A'].Subcategories['K'].AddType(90, "Fairground");
-    Categories['A'].Subcategories['K'].AddType(91, "Exhibition_Ground");
-    Categories['A'].Subcategories['K'].AddType(100, "Golf_Course");
-    Categories['A'].Subcategories['K'].AddType(101, "Golf_Driving_Range");
-    Categories['A'].Subcategories['K'].AddType(110, "Grandstand");
-    Categories['A'].Subcategories['K'].AddType(120, "Park");
-    Categories['A'].Subcategories['K'].AddType(121, "Lookout");
-    Categories['A'].Subcategories['K'].AddType(122, "Green_Space");
-    Categories['A'].Subcategories['K'].AddType(123, "Bench");
-    Categories['A'].Subcategories['K'].AddType(124, "Picnic_Table");
-    Categories['A'].Subcategories['K'].AddType(130, "Race_Track");
-    Categories['A'].Subcategories['K'].AddType(140, "Planter");
-    Categories['A'].Subcategories['K'].AddType(141, "Statue_Pedestal");
-    Categories['A'].Subcategories['K'].AddType(150, "Ski_Jump");
-    Categories['A'].Subcategories['K'].AddType(155, "Ski_Track");
-    Categories['A'].Subcategories['K'].AddType(160, "Stadium");
-    Categories['A'].Subcategories['K'].AddType(161, "Scoreboard");
-    Categories['A'].Subcategories['K'].AddType(164, "Amphitheatre");
-    Categories['A'].Subcategories['K'].AddType(165, "Sports_Stadium");
-    Categories['A'].Subcategories['K'].AddType(166, "Arena");
-    Categories['A'].Subcategories['K'].AddType(170, "Swimming_Pool");
-    Categories['A'].Subcategories['K'].AddType(180, "Zoo");
-    Categories['A'].Subcategories['K'].AddType(190, "Fishing");
-    Categories['A'].Subcategories['K'].AddType(200, "Spa");
-    Categories['A'].Subcategories['K'].AddType(539, "Open_Air_Bath");
-    Categories['A'].AddSubcategory('L', "Misc_Feature");
-    Categories['A'].Subcategories['L'].AddType(5, "Animal_Sanctuary");
-    Categories['A'].Subcategories['L'].AddType(10, "Facility");
-    Categories['A'].Subcategories['L'].AddType(11, "Installation");
-    Categories['A'].Subcategories['L'].AddType(12, "Arch_Site");
-    Categories['A'].Subcategories['L'].AddType(13, "Building");
-    Categories['A'].Subcategories['L'].AddType(14, "Non_Building_Structure");
-    Categories['A'].Subcategories['L'].AddType(15, "Building");
-    Categories['A'].Subcategories['L'].AddType(17, "Fire_Hydrant");
-    Categories['A'].Subcategories['L'].AddType(18, "Building_Addition");
-    Categories['A'].Subcategories['L'].AddType(19, "Shed");
-    Categories['A'].Subcategories['L'].AddType(20, "Built-Up_Area");
-    Categories['A'].Subcategories['L'].AddType(21, "Built-up_Area-Hist");
-    Categories['A'].Subcategories['L'].AddType(22, "Populated_Place");
-    Categories['A'].Subcategories['L'].AddType(25, "Cairn");
-    Categories['A'].Subcategories['L'].AddType(30, "Cemetery");
-    Categories['A'].Subcategories['L'].AddType(35, "Grave");
-    Categories['A'].Subcategories['L'].AddType(36, "Tomb");
-    Categories['A'].Subcategories['L'].AddType(40, "Cliff_Dwelling");
-    Categories['A'].Subcategories['L'].AddType(45, "Complex_Outline");
-    Categories['A'].Subcategories['L'].AddType(50, "Display_Sign");
-    Categories['A'].Subcategories['L'].AddType(60, "Dragon_Teeth");
-    Categories['A'].Subcategories['L'].AddType(65, "Minefield");
-    Categories['A'].Subcategories['L'].AddType(70, "Fence");
-    Categories['A'].Subcategories['L'].AddType(73, "Flagstaff");
-    Categories['A'].Subcategories['L'].AddType(75, "Gallery");
-    Categories['A'].Subcategories['L'].AddType(80, "Gantry");
-    Categories['A'].Subcategories['L'].AddType(90, "Grave_Marker");
-    Categories['A'].Subcategories['L'].AddType(95, "Homogeneous_Radar_Sig_Area");
-    Categories['A'].Subcategories['L'].AddType(99, "Hut");
-    Categories['A'].Subcategories['L'].AddType(100, "Hut");
-    Categories['A'].Subcategories['L'].AddType(101, "Cabin");
-    Categories['A'].Subcategories['L'].AddType(105, "Settlement");
-    Categories['A'].Subcategories['L'].AddType(110, "Light_Standard");
-    Categories['A'].Subcategories['L'].AddType(116, "Calvary_Cross");
-    Categories['A'].Subcategories['L'].AddType(120, "Missile_Site");
-    Categories['A'].Subcategories['L'].AddType(121, "Anti_Aircraft_Artillery_Site");
-    Categories['A'].Subcategories['L'].AddType(130, "Monument");
-    Categories['A'].Subcategories['L'].AddType(135, "Native_Settlement");
-    Categories['A'].Subcategories['L'].AddType(140, "Particle_Accelerator");
-    Categories['A'].Subcategories['L'].AddType(141, "Telescope");
-    Categories['A'].Subcategories['L'].AddType(142, "Astronomical_Observatory");
-    Categories['A'].Subcategories['L'].AddType(155, "Overhead");
-    Categories['A'].Subcategories['L'].AddType(165, "Pipeline_Crossing_Point");
-    Categories['A'].Subcategories['L'].AddType(170, "Plaza");
-    Categories['A'].Subcategories['L'].AddType(175, "Courtyard");
-    Categories['A'].Subcategories['L'].AddType(180, "Retail_Stand");
-    Categories['A'].Subcategories['L'].AddType(195, "Ramp");
-    Categories['A'].Subcategories['L'].AddType(200, "Ruins");
-    Categories['A'].Subcategories['L'].AddType(201, "Historic");
-    Categories['A'].Subcategories['L'].AddType(208, "Shanty_Town");
-    Categories['A'].Subcategories['L'].AddType(209, "Tent_Encampment");
-    Categories['A'].Subcategories['L'].AddType(210, "Snow_Shed");
-    Categories['A'].Subcategories['L'].AddType(211, "Trans_Route_Protect_Struct");
-    Categories['A'].Subcategories['L'].AddType(220, "Steeple");
-    Categories['A'].Subcategories['L'].AddType(240, "Tower-NC");
-    Categories['A'].Subcategories['L'].AddType(241, "Tower_General");
-    Categories['A'].Subcategories['L'].AddType(250, "Undergrd_Dwelling");
-    Categories['A'].Subcategories['L'].AddType(260, "Wall");
-    Categories['A'].Subcategories['L'].AddType(270, "Industrial_Farm");
-    Categories['A'].Subcategories['L'].AddType(330, "Religious_Facility");
-    Categories['A'].Subcategories['L'].AddType(351, "Space_Facility");
-    Categories['A'].Subcategories['L'].AddType(370, "Country_House");
-    Categories['A'].Subcategories['L'].AddType(375, "Castle");
-    Categories['A'].Subcategories['L'].AddType(510, "Tethered_Balloon");
-    Categories['A'].AddSubcategory('M', "Storage");
-    Categories['A'].Subcategories['M'].AddType(10, "Depot");
-    Categories['A'].Subcategories['M'].AddType(11, "Container");
-    Categories['A'].Subcategories['M'].AddType(20, "Grain_Silo");
-    Categories['A'].Subcategories['M'].AddType(30, "Grain_Elevator");
-    Categories['A'].Subcategories['M'].AddType(31, "Timber_Yard");
-    Categories['A'].Subcategories['M'].AddType(40, "Mineral_Pile");
-    Categories['A'].Subcategories['M'].AddType(42, "Material_Pile");
-    Categories['A'].Subcategories['M'].AddType(60, "Storage");
-    Categories['A'].Subcategories['M'].AddType(65, "Munition_Storage_Facility");
-    Categories['A'].Subcategories['M'].AddType(70, "Tank");
-    Categories['A'].Subcategories['M'].AddType(71, "Tank_Farm");
-    Categories['A'].Subcategories['M'].AddType(75, "Fuel_Storage_Facility");
-    Categories['A'].Subcategories['M'].AddType(80, "Water_Tower");
-    Categories['A'].Subcategories['M'].AddType(91, "Silo");
-    Categories['A'].Subcategories['M'].AddType(510, "Transshipment_Station");
-    Categories['A'].AddSubcategory('N', "Railroad");
-    Categories['A'].Subcategories['N'].AddType(10, "Railroad");
-    Categories['A'].Subcategories['N'].AddType(15, "Railway_Track");
-    Categories['A'].Subcategories['N'].AddType(50, "Railroad_Siding");
-    Categories['A'].Subcategories['N'].AddType(60, "Railroad_Yard");
-    Categories['A'].Subcategories['N'].AddType(65, "Railhead");
-    Categories['A'].Subcategories['N'].AddType(75, "Railroad_Turntable");
-    Categories['A'].Subcategories['N'].AddType(76, "Roundhouse");
-    Categories['A'].Subcategories['N'].AddType(80, "Railroad_Switch");
-    Categories['A'].Subcategories['N'].AddType(85, "Railway_Signal");
-    Categories['A'].AddSubcategory('P', "Road");
-    Categories['A'].Subcategories['P'].AddType(10, "Cart_Track");
-    Categories['A'].Subcategories['P'].AddType(20, "Interchange");
-    Categories['A'].Subcategories['P'].AddType(30, "Road");
-    Categories['A'].Subcategories['P'].AddType(32, "Road_Ramp");
-    Categories['A'].Subcategories['P'].AddType(40, "Gate");
-    Categories['A'].Subcategories['P'].AddType(41, "Barrier");
-    Categories['A'].Subcategories['P'].AddType(50, "Trail");
-    Categories['A'].Subcategories['P'].AddType(60, "Drove");
-    Categories['A'].AddSubcategory('Q', "Associated");
-    Categories['A'].Subcategories['Q'].AddType(10, "Cableway_Line");
-    Categories['A'].Subcategories['Q'].AddType(20, "Cableway_Pylon");
-    Categories['A'].Subcategories['Q'].AddType(21, "Mast");
-    Categories['A'].Subcategories['Q'].AddType(30, "Boardwalk");
-    Categories['A'].Subcategories['Q'].AddType(35, "Sidewalk");
-    Categories['A'].Subcategories['Q'].AddType(36, "Curb");
-    Categories['A'].Subcategories['Q'].AddType(40, "Bridge");
-    Categories['A'].Subcategories['Q'].AddType(45, "Bridge_Span");
-    Categories['A'].Subcategories['Q'].AddType(50, "Bridge_Superstruct");
-    Categories['A'].Subcategories['Q'].AddType(55, "Bridge_Pylon");
-    Categories['A'].Subcategories['Q'].AddType(56, "Bridge_Pier");
-    Categories['A'].Subcategories['Q'].AddType(58, "Constriction_or_Expansion");
-    Categories['A'].Subcategories['Q'].AddType(60, "Control_Tower");
-    Categories['A'].Subcategories['Q'].AddType(62, "Crossing");
-    Categories['A'].Subcategories['Q'].AddType(63, "Causeway_Structure");
-    Categories['A'].Subcategories['Q'].AddType(64, "Causeway");
-    Categories['A'].Subcategories['Q'].AddType(65, "Culvert");
-    Categories['A'].Subcategories['Q'].AddType(68, "Drop_Gate");
-    Categories['A'].Subcategories['Q'].AddType(70, "Ferry_Crossing");
-    Categories['A'].Subcategories['Q'].AddType(75, "Ice_Route");
-    Categories['A'].Subcategories['Q'].AddType(80, "Ferry_Site");
-    Categories['A'].Subcategories['Q'].AddType(90, "Entrance_or_Exit");
-    Categories['A'].Subcategories['Q'].AddType(95, "Tunnel_Mouth");
-    Categories['A'].Subcategories['Q'].AddType(100, "Landmark_Post");
-    Categories['A'].Subcategories['Q'].AddType(105, "Buried_Utility");
-    Categories['A'].Subcategories['Q'].AddType(110, "Mooring_Mast");
-    Categories['A'].Subcategories['Q'].AddType(111, "Float_Bridge_Site");
-    Categories['A'].Subcategories['Q'].AddType(113, "Pipeline");
-    Categories['A'].Subcategories['Q'].AddType(114, "Storm_Drain");
-    Categories['A'].Subcategories['Q'].AddType(115, "Utility_Cover");
-    Categories['A'].Subcategories['Q'].AddType(116, "Pumping_Station");
-    Categories['A'].Subcategories['Q'].AddType(118, "Sharp_Curve");
-    Categories['A'].Subcategories['Q'].AddType(119, "Route_Marker");
-    Categories['A'].Subcategories['Q'].AddType(120, "Steep_Grade");
-    Categories['A'].Subcategories['Q'].AddType(125, "Station-Misc");
-    Categories['A'].Subcategories['Q'].AddType(130, "Tunnel");
-    Categories['A'].Subcategories['Q'].AddType(135, "Vehicle_Rest_Area");
-    Categories['A'].Subcategories['Q'].AddType(140, "Vehicle_Park_Area");
-    Categories['A'].Subcategories['Q'].AddType(141, "Parking_Garage");
-    Categories['A'].Subcategories['Q'].AddType(150, "Steps_or_Stair");
-    Categories['A'].Subcategories['Q'].AddType(151, "Arcade");
-    Categories['A'].Subcategories['Q'].AddType(152, "Overhead_Walkway");
-    Categories['A'].Subcategories['Q'].AddType(160, "Traffic_Light");
-    Categories['A'].Subcategories['Q'].AddType(161, "Street_Lamp");
-    Categories['A'].Subcategories['Q'].AddType(162, "Street_Sign");
-    Categories['A'].Subcategories['Q'].AddType(170, "Motor_Vehicle_Station");
-    Categories['A'].Subcategories['Q'].AddType(180, "Weigh_Station");
-    Categories['A'].Subcategories['Q'].AddType(200, "Regulatory_Sign");
-    Categories['A'].AddSubcategory('R', "Air_Traffic_Serv");
-    Categories['A'].Subcategories['R'].AddType(1, "Marshaller");
-    Categories['A'].AddSubcategory('T', "Comm");
-    Categories['A'].Subcategories['T'].AddType(5, "Cable");
-    Categories['A'].Subcategories['T'].AddType(6, "Overhead_Cable");
-    Categories['A'].Subcategories['T'].AddType(10, "Dish_Aerial");
-    Categories['A'].Subcategories['T'].AddType(11, "Aerial");
-    Categories['A'].Subcategories['T'].AddType(12, "Aerial_Farm");
-    Categories['A'].Subcategories['T'].AddType(20, "Early_Warning_Radar");
-    Categories['A'].Subcategories['T'].AddType(30, "Power_Line");
-    Categories['A'].Subcategories['T'].AddType(40, "Power_Pylon");
-    Categories['A'].Subcategories['T'].AddType(41, "Telepheric");
-    Categories['A'].Subcategories['T'].AddType(42, "Pylon");
-    Categories['A'].Subcategories['T'].AddType(45, "Radar");
-    Categories['A'].Subcategories['T'].AddType(50, "Comm_Building");
-    Categories['A'].Subcategories['T'].AddType(60, "Telephone_Line");
-    Categories['A'].Subcategories['T'].AddType(70, "Telephone_Pylon");
-    Categories['A'].Subcategories['T'].AddType(80, "Comm_Tower");
-    Categories['A'].AddSubcategory('U', "Airport");
-    AddCategory('B', "Hydrography");
-    Categories['B'].AddSubcategory('A', "Coastal");
-    Categories['B'].Subcategories['A'].AddType(5, "High_Water_Line");
-    Categories['B'].Subcategories['A'].AddType(10, "Coastline_or_Shoreline");
-    Categories['B'].Subcategories['A'].AddType(11, "Coastline");
-    Categories['B'].Subcategories['A'].AddType(20, "Foreshore");
-    Categories['B'].Subcategories['A'].AddType(21, "Nearshore");
-    Categories['B'].Subcategories['A'].AddType(22, "Backshore");
-    Categories['B'].Subcategories['A'].AddType(23, "Foreshore");
-    Categories['B'].Subcategories['A'].AddType(24, "Shoreline");
-    Categories['B'].Subcategories['A'].AddType(25, "Offshore");
-    Categories['B'].Subcategories['A'].AddType(30, "Island");
-    Categories['B'].Subcategories['A'].AddType(40, "Water");
-    Categories['B'].Subcategories['A'].AddType(50, "Beach");
-    Categories['B'].Subcategories['A'].AddType(51, "Dyke_Crown");
-    Categories['B'].Subcategories['A'].AddType(52, "Beach_Exit");
-    Categories['B'].Subcategories['A'].AddType(70, "Waterbody_Bar");
-    Categories['B'].AddSubcategory('B', "Harbor");
-    Categories['B'].Subcategories['B'].AddType(5, "Harbor");
-    Categories['B'].Subcategories['B'].AddType(6, "Harbor_Complex");
-    Categories['B'].Subcategories['B'].AddType(7, "Channel_Edge");
-    Categories['B'].Subcategories['B'].AddType(8, "Harbour_Waters");
-    Categories['B'].Subcategories['B'].AddType(9, "Port");
-    Categories['B'].Subcategories['B'].AddType(10, "Anchorage");
-    Categories['B'].Subcategories['B'].AddType(11, "Anchorage-Complex");
-    Categories['B'].Subcategories['B'].AddType(12, "Anchor_Berth");
-    Categories['B'].Subcategories['B'].AddType(15, "Roadstead");
-    Categories['B'].Subcategories['B'].AddType(19, "Anchor");
-    Categories['B'].Subcategories['B'].AddType(20, "Berth");
-    Categories['B'].Subcategories['B'].AddType(21, "Mooring_Trot");
-    Categories['B'].Subcategories['B'].AddType(22, "Basin");
-    Categories['B'].Subcategories['B'].AddType(30, "Bollard");
-    Categories['B'].Subcategories['B'].AddType(40, "Groyne");
-    Categories['B'].Subcategories['B'].AddType(41, "Breakwater");
-    Categories['B'].Subcategories['B'].AddType(42, "Mole");
-    Categories['B'].Subcategories['B'].AddType(43, "Groin");
-    Categories['B'].Subcategories['B'].AddType(50, "Calling-In_Point");
-    Categories['B'].Subcategories['B'].AddType(79, "Mooring_Facility");
-    Categories['B'].Subcategories['B'].AddType(80, "Dolphin");
-    Categories['B'].Subcategories['B'].AddType(81, "Shoreline_Constr");
-    Categories['B'].Subcategories['B'].AddType(82, "Shoreline_Ramp");
-    Categories['B'].Subcategories['B'].AddType(90, "Drydock");
-    Categories['B'].Subcategories['B'].AddType(91, "Dry_Dock_Basin");
-    Categories['B'].Subcategories['B'].AddType(92, "Dry_Dock_Wall");
-    Categories['B'].Subcategories['B'].AddType(95, "Dock");
-    Categories['B'].Subcategories['B'].AddType(100, "Fish_Stakes");
-    Categories['B'].Subcategories['B'].AddType(105, "Fishing_Harbor");
-    Categories['B'].Subcategories['B'].AddType(110, "Fish_Trap");
-    Categories['B'].Subcategories['B'].AddType(111, "Tunny");
-    Categories['B'].Subcategories['B'].AddType(112, "Fish_Trap_Area");
-    Categories['B'].Subcategories['B'].AddType(115, "Gridiron");
-    Categories['B'].Subcategories['B'].AddType(140, "Jetty");
-    Categories['B'].Subcategories['B'].AddType(149, "Boat_Landing");
-    Categories['B'].Subcategories['B'].AddType(150, "Landing_Place");
-    Categories['B'].Subcategories['B'].AddType(151, "Landing_Stair");
-    Categories['B'].Subcategories['B'].AddType(155, "Maritime_Station");
-    Categories['B'].Subcategories['B'].AddType(160, "Mooring_Ring");
-    Categories['B'].Subcategories['B'].AddType(170, "Loading_Facility");
-    Categories['B'].Subcategories['B'].AddType(175, "Mobile_Offshore_Drill_Unit");
-    Categories['B'].Subcategories['B'].AddType(180, "Oyster_Bed");
-    Categories['B'].Subcategories['B'].AddType(190, "Pier");
-    Categories['B'].Subcategories['B'].AddType(198, "Fender");
-    Categories['B'].Subcategories['B'].AddType(199, "Floating_Dock");
-    Categories['B'].Subcategories['B'].AddType(200, "Pump_Out_Facility");
-    Categories['B'].Subcategories['B'].AddType(201, "Small_Craft_Facility");
-    Categories['B'].Subcategories['B'].AddType(202, "Ice_Boom");
-    Categories['B'].Subcategories['B'].AddType(220, "Ramp");
-    Categories['B'].Subcategories['B'].AddType(221, "Log_Ramp");
-    Categories['B'].Subcategories['B'].AddType(225, "Rip_Rap");
-    Categories['B'].Subcategories['B'].AddType(226, "Shore_Revetment");
-    Categories['B'].Subcategories['B'].AddType(230, "Seawall");
-    Categories['B'].Subcategories['B'].AddType(240, "Slipway");
-    Categories['B'].Subcategories['B'].AddType(241, "Shipyard");
-    Categories['B'].Subcategories['B'].AddType(250, "Watering_Place");
-    Categories['B'].Subcategories['B'].AddType(270, "Pilot_Boarding_Place");
-    Categories['B'].AddSubcategory('C', "NAVAID");
-    Categories['B'].Subcategories['C'].AddType(10, "Beacon");
-    Categories['B'].Subcategories['C'].AddType(20, "Buoy");
-    Categories['B'].Subcategories['C'].AddType(21, "Lateral_Buoy");
-    Categories['B'].Subcategories['C'].AddType(30, "Leading_Light");
-    Categories['B'].Subcategories['C'].AddType(31, "Navigation_Line");
-    Categories['B'].Subcategories['C'].AddType(32, "Radar_Line");
-    Categories['B'].Subcategories['C'].AddType(33, "Radar_Range");
-    Categories['B'].Subcategories['C'].AddType(34, "Maritime_Radiobeacon");
-    Categories['B'].Subcategories['C'].AddType(35, "Lights_in_Line");
-    Categories['B'].Subcategories['C'].AddType(40, "Light");
-    Categories['B'].Subcategories['C'].AddType(50, "Lighthouse");
-    Categories['B'].Subcategories['C'].AddType(55, "Marker");
-    Categories['B'].Subcategories['C'].AddType(60, "Light_Sector");
-    Categories['B'].Subcategories['C'].AddType(70, "Light_Vessel");
-    Categories['B'].Subcategories['C'].AddType(80, "Perches");
-    Categories['B'].Subcategories['C'].AddType(98, "Nav_Mark-Afloat");
-    Categories['B'].Subcategories['C'].AddType(99, "Nav_Mark-Fixed");
-    Categories['B'].Subcategories['C'].AddType(100, "Leading_Line");
-    Categories['B'].Subcategories['C'].AddType(101, "Fog_Signal");
-    Categories['B'].Subcategories['C'].AddType(102, "Direction-Buoyage");
-    Categories['B'].Subcategories['C'].AddType(103, "Sound_Signal_Device");
-    Categories['B'].Subcategories['C'].AddType(110, "Topmark");
-    Categories['B'].AddSubcategory('D', "Hazard");
-    Categories['B'].Subcategories['D'].AddType(0, "Underwater");
-    Categories['B'].Subcategories['D'].AddType(1, "Mine-Naval");
-    Categories['B'].Subcategories['D'].AddType(2, "Small_Bottom_Object");
-    Categories['B'].Subcategories['D'].AddType(3, "Large_Bottom_Object");
-    Categories['B'].Subcategories['D'].AddType(5, "Misc_Underwater");
-    Categories['B'].Subcategories['D'].AddType(10, "Breakers");
-    Categories['B'].Subcategories['D'].AddType(20, "Crib");
-    Categories['B'].Subcategories['D'].AddType(30, "Discolored_Water");
-    Categories['B'].Subcategories['D'].AddType(40, "Eddy");
-    Categories['B'].Subcategories['D'].AddType(50, "Foul_Ground");
-    Categories['B'].Subcategories['D'].AddType(60, "Seaweed");
-    Categories['B'].Subcategories['D'].AddType(61, "Aquatic_Vegetation");
-    Categories['B'].Subcategories['D'].AddType(70, "Obstruction");
-    Categories['B'].Subcategories['D'].AddType(71, "Log_Boom");
-    Categories['B'].Subcategories['D'].AddType(72, "Pontoon");
-    Categories['B'].Subcategories['D'].AddType(73, "Oil_Barrier");
-    Categories['B'].Subcategories['D'].AddType(74, "Chain_or_Wire");
-    Categories['B'].Subcategories['D'].AddType(75, "Log_Boom");
-    Categories['B'].Subcategories['D'].AddType(76, "Booming_Ground");
-    Categories['B'].Subcategories['D'].AddType(79, "Fishing_Facility");
-    Categories['B'].Subcategories['D'].AddType(80, "Tide_Rip");
-    Categories['B'].Subcategories['D'].AddType(100, "Pile");
-    Categories['B'].Subcategories['D'].AddType(110, "Platform");
-    Categories['B'].Subcategories['D'].AddType(111, "Offshore_Platform");
-    Categories['B'].Subcategories['D'].AddType(112, "Prod_Installation");
-    Categories['B'].Subcategories['D'].AddType(115, "Offshore_Construction");
-    Categories['B'].Subcategories['D'].AddType(119, "Ledge");
-    Categories['B'].Subcategories['D'].AddType(120, "Reef");
-    Categories['B'].Subcategories['D'].AddType(121, "Pingo");
-    Categories['B'].Subcategories['D'].AddType(122, "Cay");
-    Categories['B'].Subcategories['D'].AddType(123, "Boom");
-    Categories['B'].Subcategories['D'].AddType(125, "Fish_Haven");
-    Categories['B'].Subcategories['D'].AddType(130, "Rock");
-    Categories['B'].Subcategories['D'].AddType(140, "Snag_or_Stump");
-    Categories['B'].Subcategories['D'].AddType(180, "Wreck");
-    Categories['B'].Subcategories['D'].AddType(181, "Hulk");
-    Categories['B'].Subcategories['D'].AddType(190, "Non_Submarine_Contact");
-    Categories['B'].AddSubcategory('E', "Depth_Info");
-    Categories['B'].Subcategories['E'].AddType(10, "Depth_Curve");
-    Categories['B'].Subcategories['E'].AddType(15, "Depth_Contour");
-    Categories['B'].Subcategories['E'].AddType(19, "Depth_Area");
-    Categories['B'].Subcategories['E'].AddType(20, "Sounding");
-    Categories['B'].Subcategories['E'].AddType(21, "Low_Water_Line");
-    Categories['B'].Subcategories['E'].AddType(22, "Sand_Line");
-    Categories['B'].Subcategories['E'].AddType(23, "Mud_Line");
-    Categories['B'].Subcategories['E'].AddType(29, "Bottom_Return");
-    Categories['B'].Subcategories['E'].AddType(30, "Track_Swath");
-    Categories['B'].Subcategories['E'].AddType(40, "Track_Line");
-    Categories['B'].Subcategories['E'].AddType(50, "Beach_Profile");
-    Categories['B'].AddSubcategory('F', "Bottom_Feature");
-    Categories['B'].Subcategories['F'].AddType(10, "Bottom_Char");
-    Categories['B'].Subcategories['F'].AddType(11, "Bottom_Feature");
-    Categories['B'].Subcategories['F'].AddType(20, "Seabed_Impact_Scour");
-    Categories['B'].AddSubcategory('G', "Tide_Current_Info");
-    Categories['B'].Subcategories['G'].AddType(10, "Current_Flow");
-    Categories['B'].Subcategories['G'].AddType(11, "Tideway");
-    Categories['B'].Subcategories['G'].AddType(12, "Water_Turbulence");
-    Categories['B'].Subcategories['G'].AddType(13, "Water_Current_Region");
-    Categories['B'].Subcategories['G'].AddType(20, "Tide_Gauge");
-    Categories['B'].Subcategories['G'].AddType(30, "Tidal_Obs_Station");
-    Categories['B'].Subcategories['G'].AddType(40, "Tidal_Diagram");
-    Categories['B'].AddSubcategory('H', "Inland_Water");
-    Categories['B'].Subcategories['H'].AddType(0, "Water");
-    Categories['B'].Subcategories['H'].AddType(10, "Aqueduct");
-    Categories['B'].Subcategories['H'].AddType(11, "Intake");
-    Categories['B'].Subcategories['H'].AddType(12, "Qanat_Shaft");
-    Categories['B'].Subcategories['H'].AddType(15, "Bog");
-    Categories['B'].Subcategories['H'].AddType(20, "Canal");
-    Categories['B'].Subcategories['H'].AddType(30, "Ditch");
-    Categories['B'].Subcategories['H'].AddType(40, "Filtration_Bed");
-    Categories['B'].Subcategories['H'].AddType(49, "Aquaculture_Facility");
-    Categories['B'].Subcategories['H'].AddType(50, "Fish_Farm");
-    Categories['B'].Subcategories['H'].AddType(51, "Fish_Farm_Facility");
-    Categories['B'].Subcategories['H'].AddType(60, "Flume");
-    Categories['B'].Subcategories['H'].AddType(65, "Water_Race");
-    Categories['B'].Subcategories['H'].AddType(70, "Ford");
-    Categories['B'].Subcategories['H'].AddType(75, "Fountain");
-    Categories['B'].Subcategories['H'].AddType(77, "Hummock");
-    Categories['B'].Subcategories['H'].AddType(80, "Lake_or_Pond");
-    Categories['B'].Subcategories['H'].AddType(81, "Pond");
-    Categories['B'].Subcategories['H'].AddType(82, "Inland_Waterbody");
-    Categories['B'].Subcategories['H'].AddType(90, "Low_Land");
-    Categories['B'].Subcategories['H'].AddType(91, "Flooded_Area");
-    Categories['B'].Subcategories['H'].AddType(95, "Marsh_or_Swamp");
-    Categories['B'].Subcategories['H'].AddType(100, "Moat");
-    Categories['B'].Subcategories['H'].AddType(110, "Penstock");
-    Categories['B'].Subcategories['H'].AddType(115, "Phreatic_Water");
-    Categories['B'].Subcategories['H'].AddType(120, "Rapids");
-    Categories['B'].Subcategories['H'].AddType(130, "Reservoir");
-    Categories['B'].Subcategories['H'].AddType(135, "Rice_Field");
-    Categories['B'].Subcategories['H'].AddType(140, "River_or_Stream");
-    Categories['B'].Subcategories['H'].AddType(141, "River_Bank");
-    Categories['B'].Subcategories['H'].AddType(145, "River_Vanishing_Pt");
-    Categories['B'].Subcategories['H'].AddType(150, "Salt_Pan");
-    Categories['B'].Subcategories['H'].AddType(155, "Salt_Evaporator");
-    Categories['B'].Subcategories['H'].AddType(160, "Sebkha");
-    Categories['B'].Subcategories['H'].AddType(165, "Spillway");
-    Categories['B'].Subcategories['H'].AddType(170, "Water_Hole");
-    Categories['B'].Subcategories['H'].AddType(171, "Water_Hole");
-    Categories['B'].Subcategories['H'].AddType(172, "Spring");
-    Categories['B'].Subcategories['H'].AddType(173, "Resurgence");
-    Categories['B'].Subcategories['H'].AddType(175, "Trough");
-    Categories['B'].Subcategories['H'].AddType(180, "Waterfall");
-    Categories['B'].Subcategories['H'].AddType(190, "Lagoon");
-    Categories['B'].Subcategories['H'].AddType(191, "Channel");
-    Categories['B'].Subcategories['H'].AddType(192, "Thalweg");
-    Categories['B'].Subcategories['H'].AddType(200, "Surf_Drainage");
-    Categories['B'].Subcategories['H'].AddType(210, "Inland_Shoreline");
-    Categories['B'].Subcategories['H'].AddType(220, "Waterwork");
-    Categories['B'].Subcategories['H'].AddType(230, "Water_Well");
-    Categories['B'].Subcategories['H'].AddType(240, "Irrigation_System");
-    Categories['B'].Subcategories['H'].AddType(250, "Shallow_Water_Area");
-    Categories['B'].Subcategories['H'].AddType(501, "River_Nav_Route");
-    Categories['B'].AddSubcategory('I', "Misc_Inland_Water");
-    Categories['B'].Subcategories['I'].AddType(5, "Boat_Lift");
-    Categories['B'].Subcategories['I'].AddType(6, "Ship_Elevator");
-    Categories['B'].Subcategories['I'].AddType(10, "Cistern");
-    Categories['B'].Subcategories['I'].AddType(20, "Dam_or_Weir");
-    Categories['B'].Subcategories['I'].AddType(30, "Lock");
-    Categories['B'].Subcategories['I'].AddType(31, "Lock_Basin");
-    Categories['B'].Subcategories['I'].AddType(32, "Lock_Gate");
-    Categories['B'].Subcategories['I'].AddType(33, "Lock_Wall");
-    Categories['B'].Subcategories['I'].AddType(39, "Sluice");
-    Categories['B'].Subcategories['I'].AddType(40, "Sluice_Gate");
-    Categories['B'].Subcategories['I'].AddType(41, "Gate");
-    Categories['B'].Subcategories['I'].AddType(42, "Caisson");
-    Categories['B'].Subcategories['I'].AddType(43, "Flood_Barrage");
-    Categories['B'].Subcategories['I'].AddType(44, "Flood_Control_Structure");
-    Categories['B'].Subcategories['I'].AddType(45, "Basin_Gate");
-    Categories['B'].Subcategories['I'].AddType(50, "Intake_Tower");
-    Categories['B'].Subcategories['I'].AddType(60, "Fish_Ladder");
-    Categories['B'].Subcategories['I'].AddType(70, "Gauging");
-    Categories['B'].Subcategories['I'].AddType(80, "Boat_Basin");
-    Categories['B'].AddSubcategory('J', "Snow_or_Ice");
-    Categories['B'].Subcategories['J'].AddType(20, "Moraine");
-    Categories['B'].Subcategories['J'].AddType(30, "Glacier");
-    Categories['B'].Subcategories['J'].AddType(31, "Crevasse");
-    Categories['B'].Subcategories['J'].AddType(40, "Ice_Cliff");
-    Categories['B'].Subcategories['J'].AddType(60, "Ice_Peak");
-    Categories['B'].Subcategories['J'].AddType(65, "Ice_Shelf");
-    Categories['B'].Subcategories['J'].AddType(70, "Pack_Ice");
-    Categories['B'].Subcategories['J'].AddType(80, "Polar_Ice");
-    Categories['B'].Subcategories['J'].AddType(99, "Ice_Cap");
-    Categories['B'].Subcategories['J'].AddType(100, "Snow_or_Ice_Field");
-    Categories['B'].Subcategories['J'].AddType(105, "Land_Snow_Ice_Field");
-    Categories['B'].Subcategories['J'].AddType(110, "Tundra");
-    Categories['B'].AddSubcategory('K', "Oceanographic");
-    Categories['B'].Subcategories['K'].AddType(10, "Acoustic_Station");
-    Categories['B'].Subcategories['K'].AddType(20, "Magnetic_Station");
-    Categories['B'].Subcategories['K'].AddType(30, "Collection_Device");
-    AddCategory('C', "Hypsography");
-    Categories['C'].AddSubcategory('A', "Relief");
-    Categories['C'].Subcategories['A'].AddType(10, "Contour_Line");
-    Categories['C'].Subcategories['A'].AddType(20, "Ridge_Line");
-    Categories['C'].Subcategories['A'].AddType(25, "Valley_Line");
-    Categories['C'].Subcategories['A'].AddType(26, "Breakline");
-    Categories['C'].Subcategories['A'].AddType(30, "Spot_Elevation");
-    Categories['C'].Subcategories['A'].AddType(35, "Water_Elevation");
-    Categories['C'].Subcategories['A'].AddType(40, "Contour_Polygon");
-    Categories['C'].Subcategories['A'].AddType(50, "Surface_Triangle");
-    Categories['C'].Subcategories['A'].AddType(99, "Terrain_Constraint_Point");
-    AddCategory('D', "Physiography");
-    Categories['D'].AddSubcategory('A', "Exposed_Material");
-    Categories['D'].Subcategories['A'].AddType(5, "Asphalt_Lake");
-    Categories['D'].Subcategories['A'].AddType(6, "Alkali_Flat");
-    Categories['D'].Subcategories['A'].AddType(10, "Ground");
-    Categories['D'].Subcategories['A'].AddType(20, "Barren");
-    Categories['D'].Subcategories['A'].AddType(30, "Land_Area");
-    Categories['D'].Subcategories['A'].AddType(31, "Land_Region");
-    Categories['D'].AddSubcategory('B', "Landform");
-    Categories['D'].Subcategories['B'].AddType(0, "Land_Area");
-    Categories['D'].Subcategories['B'].AddType(1, "Land_Morphology_Area");
-    Categories['D'].Subcategories['B'].AddType(10, "Cliff");
-    Categories['D'].Subcategories['B'].AddType(30, "Cave");
-    Categories['D'].Subcategories['B'].AddType(31, "Hill");
-    Categories['D'].Subcategories['B'].AddType(60, "Crevice");
-    Categories['D'].Subcategories['B'].AddType(61, "Crevice");
-    Categories['D'].Subcategories['B'].AddType(70, "Cut");
-    Categories['D'].Subcategories['B'].AddType(71, "Cut_Line");
-    Categories['D'].Subcategories['B'].AddType(72, "Cut_Face");
-    Categories['D'].Subcategories['B'].AddType(80, "Depression");
-    Categories['D'].Subcategories['B'].AddType(90, "Embankment");
-    Categories['D'].Subcategories['B'].AddType(100, "Esker");
-    Categories['D'].Subcategories['B'].AddType(110, "Fault");
-    Categories['D'].Subcategories['B'].AddType(115, "Geothermal_Feature");
-    Categories['D'].Subcategories['B'].AddType(145, "Misc_Obstacle");
-    Categories['D'].Subcategories['B'].AddType(150, "Mountain_Pass");
-    Categories['D'].Subcategories['B'].AddType(160, "Rock_Formation");
-    Categories['D'].Subcategories['B'].AddType(161, "Boulder");
-    Categories['D'].Subcategories['B'].AddType(170, "Sand_Dune");
-    Categories['D'].Subcategories['B'].AddType(176, "Slope_Category");
-    Categories['D'].Subcategories['B'].AddType(180, "Volcano");
-    Categories['D'].Subcategories['B'].AddType(181, "Submerged_Volcano");
-    Categories['D'].Subcategories['B'].AddType(185, "Crater");
-    Categories['D'].Subcategories['B'].AddType(190, "Volcanic_Dike");
-    Categories['D'].Subcategories['B'].AddType(200, "Gully_or_Gorge");
-    Categories['D'].Subcategories['B'].AddType(210, "Landslide_Area");
-    Categories['D'].Subcategories['B'].AddType(211, "Landslide");
-    Categories['D'].Subcategories['B'].AddType(220, "Undermined_Land");
-    Categories['D'].Subcategories['B'].AddType(230, "Fan");
-    Categories['D'].Subcategories['B'].AddType(500, "Cliff-Bottomline");
-    Categories['D'].Subcategories['B'].AddType(501, "Cliff-Topline");
-    Categories['D'].Subcategories['B'].AddType(534, "Ground_Movement_Area");
-    Categories['D'].Subcategories['B'].AddType(561, "Volcanic_Appearance");
-    AddCategory('E', "Vegetation");
-    Categories['E'].AddSubcategory('A', "Cropland");
-    Categories['E'].Subcategories['A'].AddType(10, "Cropland");
-    Categories['E'].Subcategories['A'].AddType(20, "Hedgerow");
-    Categories['E'].Subcategories['A'].AddType(30, "Nursery");
-    Categories['E'].Subcategories['A'].AddType(31, "Botanical_Garden");
-    Categories['E'].Subcategories['A'].AddType(40, "Plantation");
-    Categories['E'].Subcategories['A'].AddType(50, "Vineyard");
-    Categories['E'].Subcategories['A'].AddType(55, "Hops");
-    Categories['E'].Subcategories['A'].AddType(537, "Horticultural_Area");
-    Categories['E'].AddSubcategory('B', "Rangeland");
-    Categories['E'].Subcategories['B'].AddType(10, "Grassland");
-    Categories['E'].Subcategories['B'].AddType(15, "Grass_or_Scrub_or_Brush");
-    Categories['E'].Subcategories['B'].AddType(20, "Scrub_or_Brush_or_Bush");
-    Categories['E'].Subcategories['B'].AddType(30, "Land_Cover");
-    Categories['E'].Subcategories['B'].AddType(40, "Steppe");
-    Categories['E'].Subcategories['B'].AddType(50, "Savanna");
-    Categories['E'].Subcategories['B'].AddType(60, "Heathland");
-    Categories['E'].Subcategories['B'].AddType(70, "Brush");
-    Categories['E'].Subcategories['B'].AddType(80, "Scrubland");
-    Categories['E'].AddSubcategory('C', "Woodland");
-    Categories['E'].Subcategories['C'].AddType(5, "Tree");
-    Categories['E'].Subcategories['C'].AddType(7, "Tree_Row");
-    Categories['E'].Subcategories['C'].AddType(10, "Bamboo");
-    Categories['E'].Subcategories['C'].AddType(15, "Forest");
-    Categories['E'].Subcategories['C'].AddType(20, "Oasis");
-    Categories['E'].Subcategories['C'].AddType(30, "Trees");
-    Categories['E'].Subcategories['C'].AddType(40, "Cleared_Way");
-    Categories['E'].Subcategories['C'].AddType(50, "Grove");
-    Categories['E'].Subcategories['C'].AddType(60, "Forest_Clearing");
-    Categories['E'].Subcategories['C'].AddType(70, "Rainforest");
-    Categories['E'].AddSubcategory('D', "Wetland");
-    Categories['E'].Subcategories['D'].AddType(10, "Marsh");
-    Categories['E'].Subcategories['D'].AddType(20, "Swamp");
-    Categories['E'].Subcategories['D'].AddType(30, "Mangrove_Swamp");
-    Categories['E'].Subcategories['D'].AddType(40, "Taiga");
-    Categories['E'].AddSubcategory('E', "Misc_Feature");
-    Categories['E'].Subcategories['E'].AddType(0, "Misc_Vegetation");
-    Categories['E'].Subcategories['E'].AddType(10, "Logging_Area");
-    Categories['E'].Subcategories['E'].AddType(20, "No_Vegetation");
-    Categories['E'].Subcategories['E'].AddType(30, "Desert");
-    Categories['E'].Subcategories['E'].AddType(50, "Garden");
-    Categories['E'].Subcategories['E'].AddType(60, "Bank_Vegetation_Zone");
-    Categories['E'].Subcategories['E'].AddType(100, "Economic_Reserve");
-    AddCategory('F', "Demarcation");
-    Categories['F'].AddSubcategory('A', "Topo");
-    Categories['F'].Subcategories['A'].AddType(0, "Boundary-Admin");
-    Categories['F'].Subcategories['A'].AddType(1, "Area-Admin");
-    Categories['F'].Subcategories['A'].AddType(2, "Geopolitical_Entity");
-    Categories['F'].Subcategories['A'].AddType(3, "Administrative_Division");
-    Categories['F'].Subcategories['A'].AddType(5, "Access_Zone");
-    Categories['F'].Subcategories['A'].AddType(6, "Sovereign_State");
-    Categories['F'].Subcategories['A'].AddType(7, "Territory_Special_Status");
-    Categories['F'].Subcategories['A'].AddType(12, "Contaminated_Region");
-    Categories['F'].Subcategories['A'].AddType(15, "Firing_Range");
-    Categories['F'].Subcategories['A'].AddType(20, "Armistice_Line");
-    Categories['F'].Subcategories['A'].AddType(30, "Cease-Fire_Line");
-    Categories['F'].Subcategories['A'].AddType(40, "Claim_Line");
-    Categories['F'].Subcategories['A'].AddType(41, "Contact_Zone");
-    Categories['F'].Subcategories['A'].AddType(45, "Contact_Zone_Stanag2256");
-    Categories['F'].Subcategories['A'].AddType(50, "Mandate_Line");
-    Categories['F'].Subcategories['A'].AddType(60, "Boundary-Defacto");
-    Categories['F'].Subcategories['A'].AddType(70, "Demilitarized_Zone");
-    Categories['F'].Subcategories['A'].AddType(80, "National_Park");
-    Categories['F'].Subcategories['A'].AddType(81, "Nature_Reserve");
-    Categories['F'].Subcategories['A'].AddType(82, "Protected_Water");
-    Categories['F'].Subcategories['A'].AddType(90, "Prospecting_Grid");
-    Categories['F'].Subcategories['A'].AddType(91, "Geophysical_Data_Track_Line");
-    Categories['F'].Subcategories['A'].AddType(100, "Test_Area");
-    Categories['F'].Subcategories['A'].AddType(110, "Date_Line");
-    Categories['F'].Subcategories['A'].AddType(120, "Boundary");
-    Categories['F'].Subcategories['A'].AddType(165, "Training_Area");
-    Categories['F'].Subcategories['A'].AddType(170, "Zone_of_Occupation");
-    Categories['F'].Subcategories['A'].AddType(210, "Conservation_Area");
-    Categories['F'].Subcategories['A'].AddType(517, "Military_Administrative_Unit");
-    Categories['F'].Subcategories['A'].AddType(574, "Noise_Control_Area");
-    Categories['F'].AddSubcategory('B', "Aero");
-    Categories['F'].AddSubcategory('C', "Hydro");
-    Categories['F'].Subcategories['C'].AddType(21, "Maritime_Boundary");
-    Categories['F'].Subcategories['C'].AddType(31, "Maritime_Area");
-    Categories['F'].Subcategories['C'].AddType(33, "Dumping_Ground");
-    Categories['F'].Subcategories['C'].AddType(34, "Dredged_Area");
-    Categories['F'].Subcategories['C'].AddType(35, "Pond");
-    Categories['F'].Subcategories['C'].AddType(36, "Restricted_Area");
-    Categories['F'].Subcategories['C'].AddType(37, "Caution_Area");
-    Categories['F'].Subcategories['C'].AddType(38, "Diving_Location");
-    Categories['F'].Subcategories['C'].AddType(40, "TSS_System");
-    Categories['F'].Subcategories['C'].AddType(41, "TSS");
-    Categories['F'].Subcategories['C'].AddType(42, "Inshore_Traffic_Zone");
-    Categories['F'].Subcategories['C'].AddType(45, "Unsurveyed_Area");
-    Categories['F'].Subcategories['C'].AddType(46, "Waterbody_Area");
-    Categories['F'].Subcategories['C'].AddType(47, "Waterbody_Morphology_Area");
-    Categories['F'].Subcategories['C'].AddType(50, "Naval_Firing_Practice_Area");
-    Categories['F'].Subcategories['C'].AddType(55, "Naval_Operations_Area");
-    Categories['F'].Subcategories['C'].AddType(100, "Measured_Dist_Line");
-    Categories['F'].Subcategories['C'].AddType(101, "Theodolite_Line");
-    Categories['F'].Subcategories['C'].AddType(102, "Range_Centerline");
-    Categories['F'].Subcategories['C'].AddType(130, "Radar_Ref_Line");
-    Categories['F'].Subcategories['C'].AddType(165, "Route-Maritime");
-    Categories['F'].Subcategories['C'].AddType(166, "Route-Deep_Water");
-    Categories['F'].Subcategories['C'].AddType(167, "Defined_Water");
-    Categories['F'].Subcategories['C'].AddType(168, "Route-Canal");
-    Categories['F'].Subcategories['C'].AddType(170, "Safety_Fairway");
-    Categories['F'].Subcategories['C'].AddType(177, "Swept_Area");
-    Categories['F'].Subcategories['C'].AddType(179, "Side_Scan_Sonar_Coverage");
-    Categories['F'].Subcategories['C'].AddType(200, "Mine_Counter_Measure_Area");
-    AddCategory('G', "Aero_Info");
-    Categories['G'].AddSubcategory('A', "Air_Route");
-    Categories['G'].Subcategories['A'].AddType(5, "Airspace");
-    Categories['G'].Subcategories['A'].AddType(10, "ATS_Segment");
-    Categories['G'].Subcategories['A'].AddType(15, "Spec_Use_Airspace");
-    Categories['G'].Subcategories['A'].AddType(20, "Airspace_Bndry_Seg");
-    Categories['G'].Subcategories['A'].AddType(25, "Spec_Airspace_Seg");
-    Categories['G'].Subcategories['A'].AddType(30, "Off_Route_Bearing");
-    Categories['G'].Subcategories['A'].AddType(31, "Lead_Radial");
-    Categories['G'].Subcategories['A'].AddType(35, "NAVAIDS");
-    Categories['G'].Subcategories['A'].AddType(45, "Route");
-    Categories['G'].Subcategories['A'].AddType(47, "Terminal_Route");
-    Categories['G'].Subcategories['A'].AddType(48, "ILS_Component");
-    Categories['G'].Subcategories['A'].AddType(49, "ILS_Terminal_Seg");
-    Categories['G'].Subcategories['A'].AddType(55, "Waypoint");
-    Categories['G'].Subcategories['A'].AddType(65, "Air_Warning_Light");
-    Categories['G'].Subcategories['A'].AddType(70, "Primary_Surface");
-    Categories['G'].Subcategories['A'].AddType(71, "Apprch_Surface");
-    Categories['G'].Subcategories['A'].AddType(72, "Apprch_Trans_Surface");
-    Categories['G'].Subcategories['A'].AddType(73, "Inner_Hor_Surface");
-    Categories['G'].Subcategories['A'].AddType(74, "Conical_Surface");
-    Categories['G'].Subcategories['A'].AddType(75, "Outer_Hor_Surface");
-    Categories['G'].Subcategories['A'].AddType(76, "Hor_Trans_Surface");
-    Categories['G'].Subcategories['A'].AddType(400, "Aerodrome_Associated_Strip");
-    Categories['G'].AddSubcategory('B', "Aerodrome");
-    Categories['G'].Subcategories['B'].AddType(5, "Airport");
-    Categories['G'].Subcategories['B'].AddType(6, "Airfield");
-    Categories['G'].Subcategories['B'].AddType(7, "Airport_Area");
-    Categories['G'].Subcategories['B'].AddType(10, "Airport_Lighting");
-    Categories['G'].Subcategories['B'].AddType(15, "Apron");
-    Categories['G'].Subcategories['B'].AddType(20, "Arresting_Gear");
-    Categories['G'].Subcategories['B'].AddType(25, "Blast_Barrier");
-    Categories['G'].Subcategories['B'].AddType(30, "Helo_Landing_Pad");
-    Categories['G'].Subcategories['B'].AddType(35, "Heliport");
-    Categories['G'].Subcategories['B'].AddType(40, "Launch_Pad");
-    Categories['G'].Subcategories['B'].AddType(45, "Overrun_or_Stopway");
-    Categories['G'].Subcategories['B'].AddType(46, "Touchdown_Zone");
-    Categories['G'].Subcategories['B'].AddType(50, "Revetment");
-    Categories['G'].Subcategories['B'].AddType(55, "Runway");
-    Categories['G'].Subcategories['B'].AddType(56, "Runway_Endpoint");
-    Categories['G'].Subcategories['B'].AddType(57, "Shoulder");
-    Categories['G'].Subcategories['B'].AddType(58, "Point_Abeam");
-    Categories['G'].Subcategories['B'].AddType(59, "Airfield_Elev_Pt");
-    Categories['G'].Subcategories['B'].AddType(60, "Rwy_Radar_Reflector");
-    Categories['G'].Subcategories['B'].AddType(65, "Seaplane_Base");
-    Categories['G'].Subcategories['B'].AddType(70, "Seaplane_Ldg_Area");
-    Categories['G'].Subcategories['B'].AddType(75, "Taxiway");
-    Categories['G'].Subcategories['B'].AddType(80, "Wind_Sock");
-    Categories['G'].Subcategories['B'].AddType(90, "Displaced_Threshold");
-    Categories['G'].Subcategories['B'].AddType(160, "Decontamination_Pad");
-    Categories['G'].Subcategories['B'].AddType(170, "INS_Alignment_Pad");
-    Categories['G'].Subcategories['B'].AddType(220, "Air_Obstruction");
-    Categories['G'].Subcategories['B'].AddType(221, "Misc_Obstruction");
-    Categories['G'].Subcategories['B'].AddType(222, "Low_Air_Maneuver_Pylon");
-    Categories['G'].Subcategories['B'].AddType(230, "Aircraft_Hangar");
-    Categories['G'].Subcategories['B'].AddType(250, "Hardened_Aircraft_Shelter");
-    Categories['G'].Subcategories['B'].AddType(900, "Runway_Marking");
-    Categories['G'].Subcategories['B'].AddType(901, "Taxiway_Marking");
-    Categories['G'].Subcategories['B'].AddType(902, "Roadway_Marking");
-    Categories['G'].Subcategories['B'].AddType(903, "Other_Markings");
-    Categories['G'].Subcategories['B'].AddType(904, "Instruction_Sign");
-    Categories['G'].Subcategories['B'].AddType(905, "Location_Sign");
-    Categories['G'].Subcategories['B'].AddType(906, "Direction_Sign");
-    Categories['G'].Subcategories['B'].AddType(907, "Destination_Sign");
-    Categories['G'].Subcategories['B'].AddType(908, "Information_Sign");
-    Categories['G'].Subcategories['B'].AddType(909, "Runway_Distance_Sign");
-    Categories['G'].AddSubcategory('C', "AMDB");
-    Categories['G'].Subcategories['C'].AddType(1, "Runway_Element");
-    Categories['G'].Subcategories['C'].AddType(2, "Runway_Intersection");
-    Categories['G'].Subcategories['C'].AddType(3, "Runway_Threshold");
-    Categories['G'].Subcategories['C'].AddType(4, "Runway_Marking");
-    Categories['G'].Subcategories['C'].AddType(5, "Painted_Centerline");
-    Categories['G'].Subcategories['C'].AddType(6, "LAHSO_Location");
-    Categories['G'].Subcategories['C'].AddType(7, "Arresting_Gear_Location");
-    Categories['G'].Subcategories['C'].AddType(8, "Runway_Shoulder");
-    Categories['G'].Subcategories['C'].AddType(9, "Stopway");
-    Categories['G'].Subcategories['C'].AddType(10, "Runway_Displaced_Area");
-    Categories['G'].Subcategories['C'].AddType(11, "Blastpad");
-    Categories['G'].Subcategories['C'].AddType(12, "Runway_Exit_Line");
-    Categories['G'].Subcategories['C'].AddType(13, "Helipad_FATO");
-    Categories['G'].Subcategories['C'].AddType(14, "Helipad_TLOF");
-    Categories['G'].Subcategories['C'].AddType(15, "Helipad_Threshold");
-    Categories['G'].Subcategories['C'].AddType(16, "Taxiway_Element");
-    Categories['G'].Subcategories['C'].AddType(17, "Taxiway_Shoulder");
-    Categories['G'].Subcategories['C'].AddType(18, "Taxiway_Guidance_Line");
-    Categories['G'].Subcategories['C'].AddType(19, "Taxiway_Intxn_Marking");
-    Categories['G'].Subcategories['C'].AddType(20, "Taxiway_Holding_Position");
-    Categories['G'].Subcategories['C'].AddType(21, "Frequency_Area");
-    Categories['G'].Subcategories['C'].AddType(22, "Apron_Element");
-    Categories['G'].Subcategories['C'].AddType(23, "Stand_Guidance_Line");
-    Categories['G'].Subcategories['C'].AddType(24, "Parking_Stand_Location");
-    Categories['G'].Subcategories['C'].AddType(25, "Parking_Stand_Area");
-    Categories['G'].Subcategories['C'].AddType(26, "Deicing_Area");
-    Categories['G'].Subcategories['C'].AddType(27, "Service_Road");
-    Categories['G'].Subcategories['C'].AddType(28, "Aerodrome_Ref_Point");
-    Categories['G'].Subcategories['C'].AddType(29, "Vertical_Poly_Structure");
-    Categories['G'].Subcategories['C'].AddType(30, "Vertical_Point_Structure");
-    Categories['G'].Subcategories['C'].AddType(31, "Vertical_Line_Structure");
-    Categories['G'].Subcategories['C'].AddType(32, "Construction_Area");
-    Categories['G'].Subcategories['C'].AddType(33, "Water");
-    Categories['G'].Subcategories['C'].AddType(34, "Hotspot");
-    Categories['G'].Subcategories['C'].AddType(35, "Aerodrome_Surface_Light");
-    AddCategory('I', "Cadastral");
-    Categories['I'].AddSubcategory('A', "Area");
-    Categories['I'].Subcategories['A'].AddType(10, "Map_Boundary");
-    Categories['I'].Subcategories['A'].AddType(40, "Parcel");
-    Categories['I'].Subcategories['A'].AddType(41, "Tract");
-    Categories['I'].Subcategories['A'].AddType(50, "Cadastral_Const");
-    Categories['I'].AddSubcategory('D', "Ref_Point");
-    Categories['I'].Subcategories['D'].AddType(10, "Cadastral_Point");
-    Categories['I'].Subcategories['D'].AddType(20, "Fiducial_Point");
-    Categories['I'].AddSubcategory('E', "Special_Char");
-    Categories['I'].Subcategories['E'].AddType(10, "Map_Sheet");
-    Categories['I'].Subcategories['E'].AddType(20, "Misc");
-    Categories['I'].Subcategories['E'].AddType(40, "Map_Info");
-    AddCategory('K', "FDD");
-    Categories['K'].AddSubcategory('B', "FDD");
-    Categories['K'].Subcategories['B'].AddType(25, "Agricultural_Zone");
-    Categories['K'].AddSubcategory('C', "FDD");
-    Categories['K'].Subcategories['C'].AddType(50, "Time_Zone");
-    Categories['K'].AddSubcategory('D', "FDD");
-    Categories['K'].Subcategories['D'].AddType(25, "Monument");
-    Categories['K'].AddSubcategory('E', "FDD");
-    Categories['K'].Subcategories['E'].AddType(50, "Land_Reclamation_Area");
-    Categories['K'].AddSubcategory('F', "FDD");
-    Categories['K'].Subcategories['F'].AddType(0, "Transport_Link");
-    AddCategory('M', "FDD");
-    Categories['M'].AddSubcategory('A', "FDD");
-    Categories['M'].Subcategories['A'].AddType(0, "Solid_Rock");
-    Categories['M'].Subcategories['A'].AddType(20, "Erosion_Area");
-    Categories['M'].Subcategories['A'].AddType(30, "Geologic_Mass_Movement");
-    Categories['M'].Subcategories['A'].AddType(40, "Geologic_Structure_Line");
-    Categories['M'].Subcategories['A'].AddType(50, "Soil_Salinization_Area");
-    Categories['M'].Subcategories['A'].AddType(60, "Mineral_Occurrence_Area");
-    Categories['M'].Subcategories['A'].AddType(70, "Hydrogeologic_Area");
-    Categories['M'].AddSubcategory('B', "FDD");
-    Categories['M'].Subcategories['B'].AddType(0, "Epicentre");
-    Categories['M'].Subcategories['B'].AddType(10, "Earthquake_Damage_Area");
-    Categories['M'].AddSubcategory('C', "FDD");
-    Categories['M'].Subcategories['C'].AddType(0, "Geologic_Mapping_Unit");
-    Categories['M'].Subcategories['C'].AddType(10, "Hydrogeologic_Mapping_Unit");
-    AddCategory('N', "FDD");
-    Categories['N'].AddSubcategory('A', "FDD");
-    Categories['N'].Subcategories['A'].AddType(10, "Terrain_Relief");
-    Categories['N'].Subcategories['A'].AddType(20, "Vegetation_Zone");
-    Categories['N'].Subcategories['A'].AddType(30, "Tree_Limit");
-    Categories['N'].Subcategories['A'].AddType(35, "Settlement_Limit");
-    Categories['N'].Subcategories['A'].AddType(40, "Cultivation_Limit");
-    Categories['N'].Subcategories['A'].AddType(170, "Drainage_Basin");
-    Categories['N'].AddSubcategory('C', "FDD");
-    Categories['N'].Subcategories['C'].AddType(0, "Desertification_Area");
-    Categories['N'].Subcategories['C'].AddType(5, "Dry_Area");
-    Categories['N'].Subcategories['C'].AddType(15, "Aggradation_Area");
-    Categories['N'].Subcategories['C'].AddType(30, "Ecological_Crisis_Area");
-    Categories['N'].Subcategories['C'].AddType(35, "Contaminated_Site");
-    Categories['N'].AddSubcategory('D', "FDD");
-    Categories['N'].Subcategories['D'].AddType(0, "Infection_Area");
-    Categories['N'].Subcategories['D'].AddType(5, "Hazardous_Biome_Zone");
-    Categories['N'].AddSubcategory('F', "FDD");
-    Categories['N'].Subcategories['F'].AddType(10, "Precipitation_Zone");
-    Categories['N'].Subcategories['F'].AddType(20, "Atmospheric_Humidity_Zone");
-    Categories['N'].Subcategories['F'].AddType(30, "Solar_Irradiance_Zone");
-    Categories['N'].Subcategories['F'].AddType(40, "Frost_and_or_Snow_Zone");
-    Categories['N'].Subcategories['F'].AddType(45, "Fog_Zone");
-    Categories['N'].AddSubcategory('G', "FDD");
-    Categories['N'].Subcategories['G'].AddType(0, "Global_Wind_Belt");
-    Categories['N'].Subcategories['G'].AddType(10, "Regional_Wind_Zone");
-    Categories['N'].Subcategories['G'].AddType(15, "Atmospheric_Pressure_Zone");
-    Categories['N'].Subcategories['G'].AddType(25, "Extreme_Wind_Zone");
-    Categories['N'].AddSubcategory('H', "FDD");
-    Categories['N'].Subcategories['H'].AddType(180, "Ocean_Region");
-    AddCategory('S', "Special_Use");
-    Categories['S'].AddSubcategory('A', "Terrain_Anal_Dataset");
-    Categories['S'].Subcategories['A'].AddType(10, "Common_Open_Water");
-    Categories['S'].Subcategories['A'].AddType(20, "Disturbed_Soil");
-    Categories['S'].Subcategories['A'].AddType(30, "Exposed_Bedrock");
-    Categories['S'].Subcategories['A'].AddType(40, "Permanent_Snowfield");
-    Categories['S'].Subcategories['A'].AddType(50, "Slope_Polygon");
-    Categories['S'].Subcategories['A'].AddType(60, "Covered_Drainage");
-    Categories['S'].Subcategories['A'].AddType(70, "Seismic_Activity_Area");
-    Categories['S'].AddSubcategory('B', "Bkgd_Display_Dataset");
-    Categories['S'].AddSubcategory('C', "Transp_Dataset");
-    Categories['S'].AddSubcategory('D', "Aero_Dataset");
-    Categories['S'].AddSubcategory('E', "Toponymic_Dataset");
-    Categories['S'].AddSubcategory('F', "Simulation_Dataset");
-    Categories['S'].AddSubcategory('U', "Dev_Dataset");
-    Categories['S'].Subcategories['U'].AddType(1, "Military_Base");
-    Categories['S'].Subcategories['U'].AddType(2, "Subway");
-    Categories['S'].Subcategories['U'].AddType(3, "Port_Facility");
-    AddCategory('U', "EDD");
-    Categories['U'].AddSubcategory('A', "Abstract_Object");
-    Categories['U'].Subcategories['A'].AddType(1, "Aperture");
-    Categories['U'].Subcategories['A'].AddType(2, "Component");
-    Categories['U'].Subcategories['A'].AddType(3, "Datum");
-    Categories['U'].Subcategories['A'].AddType(4, "Furniture");
-    Categories['U'].Subcategories['A'].AddType(5, "Man_Made_Object");
-    Categories['U'].Subcategories['A'].AddType(6, "Marine_Object");
-    Categories['U'].Subcategories['A'].AddType(7, "Mesh");
-    Categories['U'].Subcategories['A'].AddType(8, "Non_Empty_Set");
-    Categories['U'].Subcategories['A'].AddType(9, "Object");
-    Categories['U'].Subcategories['A'].AddType(10, "Object_Set");
-    Categories['U'].Subcategories['A'].AddType(11, "Related_Object_Set");
-    Categories['U'].Subcategories['A'].AddType(12, "Set");
-    Categories['U'].Subcategories['A'].AddType(13, "System");
-    Categories['U'].Subcategories['A'].AddType(14, "Terrain_Surface_Object");
-    Categories['U'].Subcategories['A'].AddType(15, "Time_Analysis_Base_Set");
-    Categories['U'].Subcategories['A'].AddType(16, "Time_Forecast_Tau_Set");
-    Categories['U'].AddSubcategory('C', "Administration");
-    Categories['U'].Subcategories['C'].AddType(1, "Flagpole");
-    Categories['U'].AddSubcategory('D', "Agriculture");
-    Categories['U'].Subcategories['D'].AddType(1, "Haystack");
-    Categories['U'].Subcategories['D'].AddType(2, "Mixed_Urban_Region");
-    Categories['U'].AddSubcategory('E', "Air_Trnsp");
-    Categories['U'].AddSubcategory('F', "Aperture");
-    Categories['U'].Subcategories['F'].AddType(0, "Aperture_Generic");
-    Categories['U'].Subcategories['F'].AddType(1, "Breach_Hole");
-    Categories['U'].Subcategories['F'].AddType(2, "Building_Component_Entrance_Or_Exit");
-    Categories['U'].Subcategories['F'].AddType(3, "Door");
-    Categories['U'].Subcategories['F'].AddType(4, "Entrance_or_Exit");
-    Categories['U'].Subcategories['F'].AddType(5, "Wall_Opening");
-    Categories['U'].Subcategories['F'].AddType(6, "Partition_Opening");
-    Categories['U'].Subcategories['F'].AddType(7, "Trap_Door");
-    Categories['U'].Subcategories['F'].AddType(8, "Wall_Loophole");
-    Categories['U'].Subcategories['F'].AddType(9, "Window");
-    Categories['U'].Subcategories['F'].AddType(10, "Ventilation_Opening");
-    Categories['U'].AddSubcategory('G', "Room");
-    Categories['U'].Subcategories['G'].AddType(0, "Room_Generic");
-    Categories['U'].Subcategories['G'].AddType(1, "Anteroom");
-    Categories['U'].Subcategories['G'].AddType(2, "Atrium");
-    Categories['U'].Subcategories['G'].AddType(3, "Compartment_Room");
-    Categories['U'].Subcategories['G'].AddType(4, "Compartment_Shaft");
-    Categories['U'].Subcategories['G'].AddType(5, "Balcony");
-    Categories['U'].Subcategories['G'].AddType(6, "Catwalk");
-    Categories['U'].Subcategories['G'].AddType(7, "Closet");
-    Categories['U'].Subcategories['G'].AddType(8, "Compartment_Duct");
-    Categories['U'].Subcategories['G'].AddType(9, "Courtyard");
-    Categories['U'].Subcategories['G'].AddType(10, "Elevator");
-    Categories['U'].Subcategories['G'].AddType(11, "Elevator_Shaft");
-    Categories['U'].Subcategories['G'].AddType(12, "Escalator");
-    Categories['U'].Subcategories['G'].AddType(13, "Exterior_Hallway");
-    Categories['U'].Subcategories['G'].AddType(14, "Fire_Escape");
-    Categories['U'].Subcategories['G'].AddType(15, "Hallway");
-    Categories['U'].Subcategories['G'].AddType(16, "Pulpit");
-    Categories['U'].Subcategories['G'].AddType(17, "Ramp");
-    Categories['U'].Subcategories['G'].AddType(18, "Stair");
-    Categories['U'].Subcategories['G'].AddType(19, "Ventilation_Duct");
-    Categories['U'].Subcategories['G'].AddType(20, "Ventilation_Shaft");
-    Categories['U'].Subcategories['G'].AddType(21, "Vertical_Passage");
-    Categories['U'].Subcategories['G'].AddType(22, "Stair_Set");
-    Categories['U'].AddSubcategory('H', "Section");
-    Categories['U'].Subcategories['H'].AddType(0, "Section_Generic");
-    Categories['U'].AddSubcategory('I', "Fixture");
-    Categories['U'].Subcategories['I'].AddType(0, "Fixture_Generic");
-    Categories['U'].Subcategories['I'].AddType(1, "Compartment_Content");
-    Categories['U'].Subcategories['I'].AddType(2, "Control_Panel");
-    Categories['U'].Subcategories['I'].AddType(3, "Furnace");
-    Categories['U'].Subcategories['I'].AddType(4, "Furniture");
-    Categories['U'].Subcategories['I'].AddType(5, "Heat_Radiator");
-    Categories['U'].AddSubcategory('J', "Floor");
-    Categories['U'].Subcategories['J'].AddType(0, "Floor_Level_Generic");
-    Categories['U'].Subcategories['J'].AddType(1, "Compartment_Layer");
-    Categories['U'].Subcategories['J'].AddType(2, "Attic");
-    Categories['U'].Subcategories['J'].AddType(3, "Basement");
-    Categories['U'].Subcategories['J'].AddType(4, "Crawl_Space");
-    Categories['U'].Subcategories['J'].AddType(5, "Mezzanine");
-    Categories['U'].Subcategories['J'].AddType(6, "Roof_Assembly");
-    Categories['U'].AddSubcategory('K', "Partition");
-    Categories['U'].Subcategories['K'].AddType(0, "Ceiling");
-    Categories['U'].Subcategories['K'].AddType(1, "Floor");
-    Categories['U'].Subcategories['K'].AddType(2, "Partition");
-    Categories['U'].Subcategories['K'].AddType(3, "Ventilation_Duct_Wall");
-    Categories['U'].Subcategories['K'].AddType(4, "Wall");
-    Categories['U'].AddSubcategory('N', "Demarcation");
-    Categories['U'].Subcategories['N'].AddType(1, "Boundary_Component");
-    Categories['U'].Subcategories['N'].AddType(2, "Change_Line");
-    Categories['U'].Subcategories['N'].AddType(3, "Data_Quality_Boundary");
-    Categories['U'].AddSubcategory('O', "Device_And_Equipment");
-    Categories['U'].Subcategories['O'].AddType(1, "Acoustic_Transducer");
-    Categories['U'].Subcategories['O'].AddType(3, "Anemometer");
-    Categories['U'].Subcategories['O'].AddType(4, "Automated_Teller_Machine");
-    Categories['U'].Subcategories['O'].AddType(6, "Control_Panel");
-    Categories['U'].Subcategories['O'].AddType(7, "Device");
-    Categories['U'].Subcategories['O'].AddType(8, "Dragline");
-    Categories['U'].Subcategories['O'].AddType(9, "Equipment");
-    Categories['U'].Subcategories['O'].AddType(10, "Equipment_Component");
-    Categories['U'].Subcategories['O'].AddType(11, "Escalator");
-    Categories['U'].Subcategories['O'].AddType(12, "Explosive_Charge");
-    Categories['U'].Subcategories['O'].AddType(13, "Explosive_Land_Mine");
-    Categories['U'].Subcategories['O'].AddType(14, "Explosive_Mine");
-    Categories['U'].Subcategories['O'].AddType(15, "Fire_Escape");
-    Categories['U'].Subcategories['O'].AddType(16, "Food_Oven");
-    Categories['U'].Subcategories['O'].AddType(17, "Heat_Radiator");
-    Categories['U'].Subcategories['O'].AddType(18, "Lift");
-    Categories['U'].Subcategories['O'].AddType(19, "Marine_Aid_To_Navigation");
-    Categories['U'].Subcategories['O'].AddType(20, "Munition");
-    Categories['U'].Subcategories['O'].AddType(21, "Refuse_Bin");
-    Categories['U'].Subcategories['O'].AddType(22, "Shovel");
-    Categories['U'].Subcategories['O'].AddType(23, "Supplies_And_Expendables");
-    Categories['U'].Subcategories['O'].AddType(24, "Underwater_Communication_Device");
-    Categories['U'].Subcategories['O'].AddType(25, "Wind_Vane");
-    Categories['U'].Subcategories['O'].AddType(26, "Container");
-    Categories['U'].Subcategories['O'].AddType(27, "Railway_Signal_Box");
-    Categories['U'].AddSubcategory('T', "Hydrographic_Artefact");
-    Categories['U'].Subcategories['T'].AddType(1, "Breakwater");
-    Categories['U'].Subcategories['T'].AddType(2, "Dyke");
-    Categories['U'].Subcategories['T'].AddType(3, "Lock_Gate");
-    Categories['U'].Subcategories['T'].AddType(4, "Non_Submarine_Contact");
-    Categories['U'].Subcategories['T'].AddType(5, "Shoreline_Construction");
-    Categories['U'].Subcategories['T'].AddType(6, "Tide_Lock");
-    Categories['U'].Subcategories['T'].AddType(7, "Levee");
-    Categories['U'].AddSubcategory('V', "Hydrographic_Trnsp");
-    Categories['U'].Subcategories['V'].AddType(1, "Dock");
-    Categories['U'].Subcategories['V'].AddType(2, "Marine_Clearing_Line");
-    Categories['U'].Subcategories['V'].AddType(3, "Marine_Signal_Station");
-    Categories['U'].Subcategories['V'].AddType(4, "Navigable_Waterway");
-    Categories['U'].Subcategories['V'].AddType(5, "Shoal");
-    Categories['U'].Subcategories['V'].AddType(6, "Turning_Basin");
-    Categories['U'].Subcategories['V'].AddType(7, "Wet_Dock");
-    Categories['U'].AddSubcategory('W', "Hydrology");
-    Categories['U'].Subcategories['W'].AddType(1, "Bombora_Region");
-    Categories['U'].Subcategories['W'].AddType(2, "Estuary");
-    Categories['U'].Subcategories['W'].AddType(3, "Fiord");
-    Categories['U'].Subcategories['W'].AddType(4, "Hydrography");
-    Categories['U'].Subcategories['W'].AddType(5, "Hydrologic_Object");
-    Categories['U'].Subcategories['W'].AddType(6, "Marine_Bay");
-    Categories['U'].Subcategories['W'].AddType(7, "Marine_Gulf");
-    Categories['U'].Subcategories['W'].AddType(8, "Marine_Sound");
-    Categories['U'].Subcategories['W'].AddType(9, "Marine_Strait");
-    Categories['U'].Subcategories['W'].AddType(10, "Ocean");
-    Categories['U'].Subcategories['W'].AddType(11, "Polynya");
-    Categories['U'].Subcategories['W'].AddType(12, "Prevailing_Current");
-    Categories['U'].Subcategories['W'].AddType(13, "Run_Off");
-    Categories['U'].Subcategories['W'].AddType(14, "Sea");
-    Categories['U'].Subcategories['W'].AddType(15, "Spring");
-    Categories['U'].Subcategories['W'].AddType(16, "Underwater_Region");
-    Categories['U'].Subcategories['W'].AddType(17, "Waterbody");
-    Categories['U'].Subcategories['W'].AddType(18, "Waterbody_Basin");
-    Categories['U'].Subcategories['W'].AddType(19, "Waterbody_Current");
-    Categories['U'].Subcategories['W'].AddType(20, "Waterbody_Region");
-    Categories['U'].Subcategories['W'].AddType(21, "Water_Channel");
-    Categories['U'].Subcategories['W'].AddType(22, "Water_Current");
-    Categories['U'].Subcategories['W'].AddType(23, "Watercourse");
-    Categories['U'].Subcategories['W'].AddType(24, "Inlet");
-    Categories['U'].AddSubcategory('X', "Ice");
-    Categories['U'].Subcategories['X'].AddType(1, "Hoar_Frost");
-    Categories['U'].Subcategories['X'].AddType(2, "Ice");
-    Categories['U'].Subcategories['X'].AddType(3, "Ice_Glaze");
-    Categories['U'].Subcategories['X'].AddType(4, "Ice_Keel");
-    Categories['U'].Subcategories['X'].AddType(5, "Rime");
-    Categories['U'].Subcategories['X'].AddType(6, "Snow_Ground_Cover");
-    Categories['U'].AddSubcategory('Z', "Industry");
-    Categories['U'].Subcategories['Z'].AddType(1, "Cargo");
-    Categories['U'].Subcategories['Z'].AddType(2, "Drilling_Rig");
-    Categories['U'].Subcategories['Z'].AddType(3, "Industrial_Oven");
-    Categories['U'].Subcategories['Z'].AddType(4, "Market_Place");
-    Categories['U'].Subcategories['Z'].AddType(5, "Natural_Gas_Rig");
-    Categories['U'].Subcategories['Z'].AddType(6, "Soda_Evaporator");
-    AddCategory('V', "EDD");
-    Categories['V'].AddSubcategory('A', "Infrastructure");
-    Categories['V'].Subcategories['A'].AddType(2, "Buried_Electrical_Cable");
-    Categories['V'].Subcategories['A'].AddType(3, "Buried_Power_Transmission_Line");
-    Categories['V'].Subcategories['A'].AddType(4, "Institutional_Facility");
-    Categories['V'].Subcategories['A'].AddType(5, "Manhole");
-    Categories['V'].Subcategories['A'].AddType(6, "Manhole_Cover");
-    Categories['V'].Subcategories['A'].AddType(7, "Manhole_Riser");
-    Categories['V'].Subcategories['A'].AddType(8, "Pipeline_Terminus");
-    Categories['V'].Subcategories['A'].AddType(9, "Piping_Complex");
-    Categories['V'].Subcategories['A'].AddType(10, "Power_Transmission_Line_Terminus");
-    Categories['V'].Subcategories['A'].AddType(11, "Public_Service_Station");
-    Categories['V'].Subcategories['A'].AddType(12, "Sewer");
-    Categories['V'].Subcategories['A'].AddType(13, "Sludge_Gate");
-    Categories['V'].Subcategories['A'].AddType(14, "Transmission_Station");
-    Categories['V'].AddSubcategory('C', "Land_Trnsp");
-    Categories['V'].Subcategories['C'].AddType(1, "Bridge_Platform");
-    Categories['V'].Subcategories['C'].AddType(2, "Bus_Stop");
-    Categories['V'].Subcategories['C'].AddType(3, "Causeway");
-    Categories['V'].Subcategories['C'].AddType(4, "Driveway");
-    Categories['V'].Subcategories['C'].AddType(5, "Engineer_Bridge");
-    Categories['V'].Subcategories['C'].AddType(6, "Land_Transportation_Route");
-    Categories['V'].Subcategories['C'].AddType(7, "Level_Crossing");
-    Categories['V'].Subcategories['C'].AddType(8, "Log_Crib");
-    Categories['V'].Subcategories['C'].AddType(9, "Mobile_Bridge_System");
-    Categories['V'].Subcategories['C'].AddType(10, "Overpass");
-    Categories['V'].Subcategories['C'].AddType(11, "Railway_Signal_Structure");
-    Categories['V'].Subcategories['C'].AddType(12, "Railway_Track");
-    Categories['V'].Subcategories['C'].AddType(13, "Rock_Drop");
-    Categories['V'].Subcategories['C'].AddType(14, "Route_Lane");
-    Categories['V'].Subcategories['C'].AddType(15, "Sidewalk");
-    Categories['V'].Subcategories['C'].AddType(16, "Tunnel");
-    Categories['V'].Subcategories['C'].AddType(17, "Viaduct");
-    Categories['V'].Subcategories['C'].AddType(18, "Weapon_Fighting_Pos_Access_Route");
-    Categories['V'].AddSubcategory('D', "Lighting_And_Visibility");
-    Categories['V'].Subcategories['D'].AddType(1, "Bioluminescence");
-    Categories['V'].Subcategories['D'].AddType(2, "Display_Light");
-    Categories['V'].Subcategories['D'].AddType(3, "Phosphorescent_Region");
-    Categories['V'].Subcategories['D'].AddType(4, "Shadow");
-    Categories['V'].AddSubcategory('E', "Littoral");
-    Categories['V'].Subcategories['E'].AddType(1, "Shore");
-    Categories['V'].AddSubcategory('F', "Living_Organism");
-    Categories['V'].Subcategories['F'].AddType(1, "Alga");
-    Categories['V'].Subcategories['F'].AddType(2, "Fungus");
-    Categories['V'].Subcategories['F'].AddType(3, "Lichen");
-    Categories['V'].Subcategories['F'].AddType(4, "Living_Organism");
-    Categories['V'].Subcategories['F'].AddType(5, "Moneran");
-    Categories['V'].Subcategories['F'].AddType(6, "Mushroom");
-    Categories['V'].Subcategories['F'].AddType(7, "Plankton");
-    Categories['V'].Subcategories['F'].AddType(8, "Protist");
-    Categories['V'].AddSubcategory('G', "Location");
-    Categories['V'].Subcategories['G'].AddType(3, "Centre_Line");
-    Categories['V'].Subcategories['G'].AddType(4, "Direction");
-    Categories['V'].Subcategories['G'].AddType(5, "Hazard_Marker");
-    Categories['V'].Subcategories['G'].AddType(6, "High_Pressure_Centre");
-    Categories['V'].Subcategories['G'].AddType(7, "Isopleth");
-    Categories['V'].Subcategories['G'].AddType(8, "Line");
-    Categories['V'].Subcategories['G'].AddType(9, "Location");
-    Categories['V'].Subcategories['G'].AddType(10, "Planetary_Pole");
-    Categories['V'].Subcategories['G'].AddType(11, "Railway_Nexus");
-    Categories['V'].Subcategories['G'].AddType(12, "Ray_Path");
-    Categories['V'].Subcategories['G'].AddType(13, "Region");
-    Categories['V'].Subcategories['G'].AddType(14, "Relative_Displacement_Line");
-    Categories['V'].Subcategories['G'].AddType(15, "River_Nexus");
-    Categories['V'].Subcategories['G'].AddType(16, "Site");
-    Categories['V'].Subcategories['G'].AddType(17, "Transportation_Route");
-    Categories['V'].Subcategories['G'].AddType(18, "Variable_Displacement_Line");
-    Categories['V'].Subcategories['G'].AddType(19, "Wadi_Nexus");
-    Categories['V'].AddSubcategory('I', "Military_Science");
-    Categories['V'].Subcategories['I'].AddType(1, "Abatis");
-    Categories['V'].Subcategories['I'].AddType(2, "Air_Defence_Artillery");
-    Categories['V'].Subcategories['I'].AddType(3, "Breach");
-    Categories['V'].Subcategories['I'].AddType(4, "Breach_Hole");
-    Categories['V'].Subcategories['I'].AddType(5, "Defensive_Position");
-    Categories['V'].Subcategories['I'].AddType(6, "Defensive_Position_Defilade");
-    Categories['V'].Subcategories['I'].AddType(7, "Field_Artillery");
-    Categories['V'].Subcategories['I'].AddType(8, "Fighting_Position");
-    Categories['V'].Subcategories['I'].AddType(9, "Individual_Fighting_Position");
-    Categories['V'].Subcategories['I'].AddType(10, "Land_Minefield");
-    Categories['V'].Subcategories['I'].AddType(11, "Marine_Minefield");
-    Categories['V'].Subcategories['I'].AddType(12, "Minefield");
-    Categories['V'].Subcategories['I'].AddType(13, "Missile");
-    Categories['V'].Subcategories['I'].AddType(14, "Mortar");
-    Categories['V'].Subcategories['I'].AddType(15, "Parapet");
-    Categories['V'].Subcategories['I'].AddType(16, "Prohibited_Region");
-    Categories['V'].Subcategories['I'].AddType(17, "Self_Propelled_Artillery");
-    Categories['V'].Subcategories['I'].AddType(18, "Terrain_Crater");
-    Categories['V'].Subcategories['I'].AddType(19, "Terrain_Transportation_Abatis");
-    Categories['V'].Subcategories['I'].AddType(20, "Towed_Artillery");
-    Categories['V'].Subcategories['I'].AddType(21, "Weapon");
-    Categories['V'].Subcategories['I'].AddType(22, "Weapon_Fighting_Position");
-    Categories['V'].Subcategories['I'].AddType(23, "Weapon_Full_Defilade_Position");
-    Categories['V'].Subcategories['I'].AddType(24, "Weapon_Hull_Defilade_Position");
-    Categories['V'].Subcategories['I'].AddType(25, "Weapon_System");
-    Categories['V'].AddSubcategory('J', "Physiography");
-    Categories['V'].Subcategories['J'].AddType(1, "Butte");
-    Categories['V'].Subcategories['J'].AddType(2, "Canyon");
-    Categories['V'].Subcategories['J'].AddType(3, "Desert_Region");
-    Categories['V'].Subcategories['J'].AddType(4, "Dry_Lake");
-    Categories['V'].Subcategories['J'].AddType(5, "Excavation");
-    Categories['V'].Subcategories['J'].AddType(6, "Filled_Terrain");
-    Categories['V'].Subcategories['J'].AddType(7, "Flood_Basin");
-    Categories['V'].Subcategories['J'].AddType(8, "Geographic_Basin");
-    Categories['V'].Subcategories['J'].AddType(9, "Glade");
-    Categories['V'].Subcategories['J'].AddType(10, "Isthmus");
-    Categories['V'].Subcategories['J'].AddType(11, "Jungle");
-    Categories['V'].Subcategories['J'].AddType(12, "Mesa");
-    Categories['V'].Subcategories['J'].AddType(13, "Mountain");
-    Categories['V'].Subcategories['J'].AddType(14, "Mountainous_Region");
-    Categories['V'].Subcategories['J'].AddType(15, "Named_Land_Tract");
-    Categories['V'].Subcategories['J'].AddType(16, "Permafrost");
-    Categories['V'].Subcategories['J'].AddType(17, "Permanent_Snowfield");
-    Categories['V'].Subcategories['J'].AddType(18, "Planetary_Surface");
-    Categories['V'].Subcategories['J'].AddType(19, "Plateau");
-    Categories['V'].Subcategories['J'].AddType(20, "Polar_Cap");
-    Categories['V'].Subcategories['J'].AddType(21, "Promontory");
-    Categories['V'].Subcategories['J'].AddType(22, "Ridge");
-    Categories['V'].Subcategories['J'].AddType(23, "Sand");
-    Categories['V'].Subcategories['J'].AddType(24, "Sand_Bar");
-    Categories['V'].Subcategories['J'].AddType(25, "Snowfield");
-    Categories['V'].Subcategories['J'].AddType(26, "Soil");
-    Categories['V'].Subcategories['J'].AddType(27, "Stone");
-    Categories['V'].Subcategories['J'].AddType(28, "Sugar_Cane");
-    Categories['V'].Subcategories['J'].AddType(29, "Terrain");
-    Categories['V'].Subcategories['J'].AddType(30, "Terrain_Channel");
-    Categories['V'].Subcategories['J'].AddType(31, "Terrain_Fill");
-    Categories['V'].Subcategories['J'].AddType(32, "Terrain_Plain");
-    Categories['V'].Subcategories['J'].AddType(33, "Terrain_Strip");
-    Categories['V'].Subcategories['J'].AddType(34, "Terrain_Surface_Region");
-    Categories['V'].Subcategories['J'].AddType(35, "Tract");
-    Categories['V'].Subcategories['J'].AddType(36, "Tree_Blowdown");
-    Categories['V'].Subcategories['J'].AddType(37, "Valley_Region");
-    Categories['V'].Subcategories['J'].AddType(38, "Wadi");
-    Categories['V'].Subcategories['J'].AddType(39, "Waterbody_Bank");
-    Categories['V'].Subcategories['J'].AddType(40, "Wetland");
-    Categories['V'].Subcategories['J'].AddType(41, "Boulder_Field");
-    Categories['V'].AddSubcategory('K', "Plant");
-    Categories['V'].Subcategories['K'].AddType(1, "Fern");
-    Categories['V'].Subcategories['K'].AddType(2, "Log");
-    Categories['V'].Subcategories['K'].AddType(3, "Plant");
-    Categories['V'].Subcategories['K'].AddType(4, "Pteridophyte");
-    Categories['V'].Subcategories['K'].AddType(5, "Tree_Line");
-    Categories['V'].Subcategories['K'].AddType(6, "Vegetation");
-    Categories['V'].AddSubcategory('N', "Recreation");
-    Categories['V'].Subcategories['N'].AddType(1, "Open_Air_Bath");
-    Categories['V'].AddSubcategory('O', "Religion");
-    Categories['V'].Subcategories['O'].AddType(1, "Convent");
-    Categories['V'].Subcategories['O'].AddType(2, "Marabout");
-    Categories['V'].Subcategories['O'].AddType(3, "Mosque");
-    Categories['V'].Subcategories['O'].AddType(4, "Pulpit");
-    Categories['V'].Subcategories['O'].AddType(5, "Shrine");
-    Categories['V'].Subcategories['O'].AddType(6, "Stupa");
-    Categories['V'].Subcategories['O'].AddType(7, "Synagogue");
-    Categories['V'].Subcategories['O'].AddType(8, "Tabernacle");
-    Categories['V'].AddSubcategory('P', "Shelter");
-    Categories['V'].Subcategories['P'].AddType(1, "Amphitheatre");
-    Categories['V'].Subcategories['P'].AddType(2, "Apartment_House");
-    Categories['V'].Subcategories['P'].AddType(3, "Barrack");
-    Categories['V'].Subcategories['P'].AddType(4, "Camber");
-    Categories['V'].Subcategories['P'].AddType(5, "Community_Recreation_Facility");
-    Categories['V'].Subcategories['P'].AddType(6, "Dwelling");
-    Categories['V'].Subcategories['P'].AddType(7, "Farm_Storage_Structure");
-    Categories['V'].Subcategories['P'].AddType(8, "Hardened_Aircraft_Shelter");
-    Categories['V'].Subcategories['P'].AddType(9, "Industrial_Building");
-    Categories['V'].Subcategories['P'].AddType(10, "Manufacturing_Facility");
-    Categories['V'].Subcategories['P'].AddType(11, "Monastery");
-    Categories['V'].Subcategories['P'].AddType(12, "Reformatory_Facility");
-    Categories['V'].Subcategories['P'].AddType(13, "Religious_Community");
-    Categories['V'].Subcategories['P'].AddType(14, "Rowhouse");
-    Categories['V'].Subcategories['P'].AddType(15, "Science_Facility");
-    Categories['V'].Subcategories['P'].AddType(16, "Shelter");
-    Categories['V'].Subcategories['P'].AddType(17, "Tent");
-    Categories['V'].Subcategories['P'].AddType(18, "Tent_Dwelling");
-    Categories['V'].Subcategories['P'].AddType(19, "Training_Building");
-    Categories['V'].Subcategories['P'].AddType(20, "Transportation_Building");
-    Categories['V'].Subcategories['P'].AddType(21, "Transportation_Facility");
-    Categories['V'].Subcategories['P'].AddType(22, "Tunnel_Shelter");
-    Categories['V'].Subcategories['P'].AddType(23, "Repair_Facility");
-    Categories['V'].AddSubcategory('R', "Support_Structure");
-    Categories['V'].Subcategories['R'].AddType(1, "Electrified_Railway_Pylon");
-    Categories['V'].Subcategories['R'].AddType(2, "Exterior_Wall");
-    Categories['V'].Subcategories['R'].AddType(3, "Load_Cable");
-    Categories['V'].Subcategories['R'].AddType(4, "Pole");
-    Categories['V'].Subcategories['R'].AddType(5, "Pylon");
-    Categories['V'].Subcategories['R'].AddType(6, "Storage_Pit");
-    Categories['V'].Subcategories['R'].AddType(7, "Structure");
-    Categories['V'].Subcategories['R'].AddType(8, "Structure_Exterior");
-    Categories['V'].Subcategories['R'].AddType(9, "Structure_Perimeter");
-    Categories['V'].Subcategories['R'].AddType(10, "Superstructure");
-    Categories['V'].Subcategories['R'].AddType(11, "Wall_Loophole");
-    Categories['V'].AddSubcategory('S', "Surface");
-    Categories['V'].Subcategories['S'].AddType(1, "Surface");
-    Categories['V'].AddSubcategory('U', "Survey");
-    Categories['V'].Subcategories['U'].AddType(1, "Data_Quality_Region");
-    Categories['V'].Subcategories['U'].AddType(2, "Depth_Contour_Line");
-    Categories['V'].Subcategories['U'].AddType(3, "Distance_Mark");
-    Categories['V'].Subcategories['U'].AddType(4, "Hydrographic_Survey_Contact");
-    Categories['V'].Subcategories['U'].AddType(5, "Land_Easement");
-    Categories['V'].Subcategories['U'].AddType(6, "Map");
-    Categories['V'].Subcategories['U'].AddType(7, "Map_Limits");
-    Categories['V'].Subcategories['U'].AddType(8, "Sounding_Datum");
-    Categories['V'].Subcategories['U'].AddType(9, "Surface_Datum");
-    Categories['V'].Subcategories['U'].AddType(10, "Vertical_Datum");
-    Categories['V'].AddSubcategory('X', "Trnsp");
-    Categories['V'].Subcategories['X'].AddType(1, "Cargo_Container");
-    Categories['V'].Subcategories['X'].AddType(2, "Catwalk");
-    Categories['V'].Subcategories['X'].AddType(3, "Cross_Country_Barrier");
-    Categories['V'].Subcategories['X'].AddType(4, "Mooring_Line");
-    Categories['V'].Subcategories['X'].AddType(5, "Route_Component");
-    Categories['V'].Subcategories['X'].AddType(6, "Traffic_Separation_Scheme");
-    Categories['V'].Subcategories['X'].AddType(7, "Wire_Obstacle");
-    Categories['V'].AddSubcategory('Y', "Usage_Region");
-    Categories['V'].Subcategories['Y'].AddType(1, "Agricultural_Facility");
-    Categories['V'].Subcategories['Y'].AddType(2, "Aircraft_Landing_Zone");
-    Categories['V'].Subcategories['Y'].AddType(3, "Aircraft_Storage_Tract");
-    Categories['V'].Subcategories['Y'].AddType(4, "Airstrip");
-    Categories['V'].Subcategories['Y'].AddType(5, "Arboretum");
-    Categories['V'].Subcategories['Y'].AddType(6, "Cargo_Container_Facility");
-    Categories['V'].Subcategories['Y'].AddType(7, "City");
-    Categories['V'].Subcategories['Y'].AddType(8, "Extraction_Facility");
-    Categories['V'].Subcategories['Y'].AddType(9, "Facility");
-    Categories['V'].Subcategories['Y'].AddType(10, "Farm");
-    Categories['V'].Subcategories['Y'].AddType(11, "Firebreak");
-    Categories['V'].Subcategories['Y'].AddType(12, "Grounds");
-    Categories['V'].Subcategories['Y'].AddType(13, "Heavy_Industrial_Facility");
-    Categories['V'].Subcategories['Y'].AddType(14, "Indigenous_Burial_Ground");
-    Categories['V'].Subcategories['Y'].AddType(15, "Indigenous_Peoples_Reserve");
-    Categories['V'].Subcategories['Y'].AddType(16, "Land_Fish_Hatchery");
-    Categories['V'].Subcategories['Y'].AddType(17, "Landfill");
-    Categories['V'].Subcategories['Y'].AddType(18, "Light_Industrial_Facility");
-    Categories['V'].Subcategories['Y'].AddType(19, "Marine_Port");
-    Categories['V'].Subcategories['Y'].AddType(20, "Military_Facility");
-    Categories['V'].Subcategories['Y'].AddType(21, "Municipal_Utility_Facility");
-    Categories['V'].Subcategories['Y'].AddType(22, "Museum_Facility");
-    Categories['V'].Subcategories['Y'].AddType(23, "Nuclear_Weapons_Facility");
-    Categories['V'].Subcategories['Y'].AddType(24, "Ore_Refinery");
-    Categories['V'].Subcategories['Y'].AddType(25, "Petroleum_Tank_Farm");
-    Categories['V'].Subcategories['Y'].AddType(26, "Prepared_Defensive_Position_Site");
-    Categories['V'].Subcategories['Y'].AddType(27, "Prepared_Defensive_Tract");
-    Categories['V'].Subcategories['Y'].AddType(28, "Recreational_Facility");
-    Categories['V'].Subcategories['Y'].AddType(29, "Refugee_Compound");
-    Categories['V'].Subcategories['Y'].AddType(30, "Regional_Park");
-    Categories['V'].Subcategories['Y'].AddType(31, "Reserve");
-    Categories['V'].Subcategories['Y'].AddType(32, "Residential_Region");
-    Categories['V'].Subcategories['Y'].AddType(33, "Retail_Facility");
-    Categories['V'].Subcategories['Y'].AddType(34, "Safari_Park");
-    Categories['V'].Subcategories['Y'].AddType(35, "Shanty_Town");
-    Categories['V'].Subcategories['Y'].AddType(36, "Spaceport");
-    Categories['V'].Subcategories['Y'].AddType(37, "Temporary_Encampment");
-    Categories['V'].Subcategories['Y'].AddType(38, "Town");
-    Categories['V'].Subcategories['Y'].AddType(39, "Vessel_Storage_Anchorage");
-    Categories['V'].Subcategories['Y'].AddType(40, "Waterbody_Shelter_Basin");
-    Categories['V'].Subcategories['Y'].AddType(41, "Detention_Facility");
-    Categories['V'].Subcategories['Y'].AddType(42, "Government_Facility");
-    AddCategory('W', "EDD");
-    Categories['W'].AddSubcategory('A', "Waterbody_Floor");
-    Categories['W'].Subcategories['A'].AddType(1, "Abyss");
-    Categories['W'].Subcategories['A'].AddType(2, "Bathymetric_Province");
-    Categories['W'].Subcategories['A'].AddType(3, "Inland_Water_Bottom");
-    Categories['W'].Subcategories['A'].AddType(4, "Ocean_Basin");
-    Categories['W'].Subcategories['A'].AddType(5, "Ocean_Floor");
-    Categories['W'].Subcategories['A'].AddType(6, "Seamount");
-    Categories['W'].Subcategories['A'].AddType(7, "Waterbody_Floor");
-    Categories['W'].Subcategories['A'].AddType(8, "Waterbody_Floor_Canyon");
-    Categories['W'].Subcategories['A'].AddType(9, "Waterbody_Floor_Pinnacle");
-    Categories['W'].Subcategories['A'].AddType(10, "Waterbody_Floor_Province");
-    Categories['W'].Subcategories['A'].AddType(11, "Waterbody_Floor_Region");
-    Categories['W'].Subcategories['A'].AddType(12, "Waterbody_Floor_Ridge");
-    Categories['W'].Subcategories['A'].AddType(13, "Waterbody_Floor_Trench");
-    Categories['W'].AddSubcategory('C', "Waterbody_Surface");
-    Categories['W'].Subcategories['C'].AddType(1, "Ice_Sludge");
-    Categories['W'].Subcategories['C'].AddType(3, "Overfall_Region");
-    Categories['W'].Subcategories['C'].AddType(4, "Plankton_Bloom");
-    Categories['W'].Subcategories['C'].AddType(5, "Pressure_Ice");
-    Categories['W'].Subcategories['C'].AddType(7, "Spring_Tide");
-    Categories['W'].Subcategories['C'].AddType(8, "Surf");
-    Categories['W'].Subcategories['C'].AddType(10, "Tidal_Basin");
-    Categories['W'].Subcategories['C'].AddType(13, "Waterbody_Surface");
-    Categories['W'].Subcategories['C'].AddType(15, "Iceberg");
-    Categories['W'].Subcategories['C'].AddType(16, "Surf_Zone");
-    Categories['W'].Subcategories['C'].AddType(17, "Waterbody_Surface_Region");
-    Categories['W'].Subcategories['C'].AddType(18, "Waterbody_Surface_Slick");
-    AddCategory('Z', "General");
-    Categories['Z'].AddSubcategory('A', "Annotation");
-    Categories['Z'].AddSubcategory('B', "Control_Point");
-    Categories['Z'].Subcategories['B'].AddType(20, "Benchmark");
-    Categories['Z'].Subcategories['B'].AddType(30, "Boundary_Monument");
-    Categories['Z'].Subcategories['B'].AddType(31, "Unmonumented_Point");
-    Categories['Z'].Subcategories['B'].AddType(32, "Baseline_Point");
-    Categories['Z'].Subcategories['B'].AddType(35, "Control_Point");
-    Categories['Z'].Subcategories['B'].AddType(36, "Distance_Mark");
-    Categories['Z'].Subcategories['B'].AddType(40, "Diagnostic_Point");
-    Categories['Z'].Subcategories['B'].AddType(60, "Geodetic_Point");
-    Categories['Z'].AddSubcategory('C', "Magnetic_Variation");
-    Categories['Z'].Subcategories['C'].AddType(40, "Magnetic_Disturbance");
-    Categories['Z'].Subcategories['C'].AddType(50, "Isogonic_Line");
-    Categories['Z'].Subcategories['C'].AddType(51, "Magnetic_Pole");
-    Categories['Z'].Subcategories['C'].AddType(500, "Geophysical_Anomaly");
-    Categories['Z'].AddSubcategory('D', "Misc");
-    Categories['Z'].Subcategories['D'].AddType(1, "Network");
-    Categories['Z'].Subcategories['D'].AddType(3, "Artifact");
-    Categories['Z'].Subcategories['D'].AddType(12, "Geographic");
-    Categories['Z'].Subcategories['D'].AddType(15, "Point_of_Change");
-    Categories['Z'].Subcategories['D'].AddType(19, "Misc_Feature_Type");
-    Categories['Z'].Subcategories['D'].AddType(20, "Void_Collection_Area");
-    Categories['Z'].Subcategories['D'].AddType(30, "Cultural_Context_Location");
-    Categories['Z'].Subcategories['D'].AddType(40, "Named_Location");
-    Categories['Z'].Subcategories['D'].AddType(45, "Text_Description");
-    Categories['Z'].AddSubcategory('E', "Bkgd_Feature");
-    Categories['Z'].AddSubcategory('I', "FDD");
-    Categories['Z'].Subcategories['I'].AddType(1, "Source_Info");
-    Categories['Z'].Subcategories['I'].AddType(2, "Restriction_Info");
-    Categories['Z'].Subcategories['I'].AddType(3, "Identification_Info");
-    Categories['Z'].Subcategories['I'].AddType(4, "Process_Step_Info");
-    Categories['Z'].Subcategories['I'].AddType(5, "Geo_Name_Info");
-    Categories['Z'].Subcategories['I'].AddType(6, "Note");
-    Categories['Z'].Subcategories['I'].AddType(7, "Point_Geometry_Info");
-    Categories['Z'].Subcategories['I'].AddType(8, "Curve_Geometry_Info");
-    Categories['Z'].Subcategories['I'].AddType(9, "Surface_Geometry_Info");
-    Categories['Z'].Subcategories['I'].AddType(10, "Horiz_Coord_Metadata");
-    Categories['Z'].Subcategories['I'].AddType(11, "Vert_Coord_Metadata");
-    Categories['Z'].Subcategories['I'].AddType(12, "Sounding_Metadata");
-    Categories['Z'].Subcategories['I'].AddType(13, "Crop_Info");
-    Categories['Z'].Subcategories['I'].AddType(14, "Manufacturing_Info");
-    Categories['Z'].Subcategories['I'].AddType(15, "Geo_Name_Collection");
-    Categories['Z'].Subcategories['I'].AddType(16, "Route_Pavement_Info");
-    Categories['Z'].Subcategories['I'].AddType(17, "Track_Info");
-    Categories['Z'].Subcategories['I'].AddType(18, "Wireless_Telecom_Info");
-    Categories['Z'].Subcategories['I'].AddType(19, "Aerodrome_Pavement_Info");
-    Categories['Z'].Subcategories['I'].AddType(20, "Geopolitical_Entity_Desig");
-    Categories['Z'].Subcategories['I'].AddType(21, "Admin_Division_Desig");
-    Categories['Z'].Subcategories['I'].AddType(24, "Water_Resource_Info");
-    Categories['Z'].Subcategories['I'].AddType(25, "Hydro_Vert_Positioning_Info");
-    Categories['Z'].Subcategories['I'].AddType(26, "Feature_G_A_Metadata");
-    Categories['Z'].Subcategories['I'].AddType(27, "Feature_Att_G_A_Metadata");
-    Categories['Z'].Subcategories['I'].AddType(28, "Feature_Entity");
-    Categories['Z'].Subcategories['I'].AddType(29, "Geometry_Info");
-    Categories['Z'].Subcategories['I'].AddType(30, "Event_Entity");
-    Categories['Z'].Subcategories['I'].AddType(31, "Dataset");
-    Categories['Z'].Subcategories['I'].AddType(32, "Pylon_Info");
-    Categories['Z'].Subcategories['I'].AddType(33, "Series");
-    Categories['Z'].Subcategories['I'].AddType(34, "Entity");
-    Categories['Z'].Subcategories['I'].AddType(35, "Entity_Collection");
-    Categories['Z'].Subcategories['I'].AddType(36, "Information_Entity");
-    Categories['Z'].Subcategories['I'].AddType(37, "Religious_Info");
-    Categories['Z'].AddSubcategory('V', "FDD");
-    Categories['Z'].Subcategories['V'].AddType(10, "Anti_Shipping_Activity");
+    if(facc.size() != 5)
+        return std::string();
+    auto entry = Lookup(facc);
+    auto type_key = facc.substr(2);
+    auto result = std::string();
+    result.reserve(64);
+    result += facc[0];
+    result += "_";
+    result += entry.Category ? entry.Category : "";
+    result += "/";
+    result += facc[1];
+    result += "_";
+    result += entry.Subcategory ? entry.Subcategory : "";
+    result += "/";
+    result += type_key;
+    result += "_";
+    result += entry.Type ? entry.Type : "";
+    return result;
 }
 
 }
 }
+
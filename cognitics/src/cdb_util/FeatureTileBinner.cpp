@@ -0,0 +1,167 @@
+
+#include <cdb_util/FeatureTileBinner.h>
+
+#include <sfa/LineString.h>
+#include <sfa/MultiLineString.h>
+#include <sfa/RectangleClipper.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cognitics {
+namespace cdb {
+
+namespace
+{
+    // Cells of size step starting at origin that [min, max] overlaps. An extent
+    // only counts the cells whose interior it reaches; a coordinate on a cell
+    // edge belongs to the cell above it.
+    bool CellRange(double min, double max, bool extent, double origin, double step, int count, int& first, int& last)
+    {
+        auto lo = std::floor((min - origin) / step);
+        // a feature on the top or east edge (latitude 90, longitude 180) belongs to the last cell
+        if((lo >= count) && (min <= origin + (count * step)))
+            lo = count - 1;
+        auto hi = extent ? std::ceil((max - origin) / step) - 1 : lo;
+        first = int(std::max<double>(lo, 0));
+        last = int(std::min<double>(hi, count - 1));
+        return first <= last;
+    }
+
+    std::shared_ptr<sfa::Feature> FeatureWithGeometry(const sfa::Feature& feature, sfa::Geometry* geometry)
+    {
+        auto result = std::make_shared<sfa::Feature>();
+        result->attributes = feature.attributes;
+        result->geometry = geometry;
+        return result;
+    }
+}
+
+FeatureTileBinner::FeatureTileBinner(int lod, int dataset, int cs1, int cs2) : lod(lod)
+{
+    component.dataset = dataset;
+    component.selector1 = cs1;
+    component.selector2 = cs2;
+}
+
+FeatureTileBinner::FeatureTileBinner(const TileInfo& parent, int lod) : component(parent), lod(lod), bounded(true), parent(parent)
+{
+    bounds = NSEWForTileInfo(parent);
+}
+
+bool FeatureTileBinner::InParent(const TileInfo& tileinfo) const
+{
+    if((tileinfo.latitude != parent.latitude) || (tileinfo.longitude != parent.longitude))
+        return false;
+    if(parent.lod <= 0)
+        return true;
+    auto shift = lod - parent.lod;
+    return ((tileinfo.uref >> shift) == parent.uref) && ((tileinfo.rref >> shift) == parent.rref);
+}
+
+void FeatureTileBinner::Add(const std::shared_ptr<sfa::Feature>& feature)
+{
+    if(!feature || !feature->geometry)
+        return;
+    auto envelope = std::unique_ptr<sfa::Geometry>(feature->geometry->getEnvelope());
+    auto extent = dynamic_cast<sfa::LineString*>(envelope.get());
+    if(!extent || (extent->getNumPoints() < 2))
+        return;
+    auto west = extent->getPointN(0)->X();
+    auto south = extent->getPointN(0)->Y();
+    auto east = extent->getPointN(1)->X();
+    auto north = extent->getPointN(1)->Y();
+
+    auto x_extent = east > west;
+    auto y_extent = north > south;
+    if(bounded)
+    {
+        west = std::max<double>(west, bounds.west);
+        south = std::max<double>(south, bounds.south);
+        east = std::min<double>(east, bounds.east);
+        north = std::min<double>(north, bounds.north);
+        if((west > east) || (south > north))
+            return;
+    }
+
+    auto rows = RowsForLOD(lod);
+    auto cols = ColumnsForLOD(lod);
+    auto tileinfos = std::vector<TileInfo>();
+    int lat_first, lat_last;
+    if(!CellRange(south, north, y_extent, -90.0, 1.0, 180, lat_first, lat_last))
+        return;
+    for(int ilat = lat_first; ilat <= lat_last; ++ilat)
+    {
+        auto latitude = ilat - 90;
+        auto width = TileWidthAtLatitude(latitude);
+        int u_first, u_last;
+        if(!CellRange(std::max<double>(south, latitude), std::min<double>(north, latitude + 1), y_extent, latitude, 1.0 / rows, rows, u_first, u_last))
+            continue;
+        int lon_first, lon_last;
+        if(!CellRange(west, east, x_extent, -180.0, width, 360 / width, lon_first, lon_last))
+            continue;
+        for(int ilon = lon_first; ilon <= lon_last; ++ilon)
+        {
+            auto longitude = -180 + (ilon * width);
+            int r_first, r_last;
+            if(!CellRange(std::max<double>(west, longitude), std::min<double>(east, longitude + width), x_extent, longitude, double(width) / cols, cols, r_first, r_last))
+                continue;
+            for(int uref = u_first; uref <= u_last; ++uref)
+            {
+                for(int rref = r_first; rref <= r_last; ++rref)
+                {
+                    auto tileinfo = component;
+                    tileinfo.latitude = latitude;
+                    tileinfo.longitude = longitude;
+                    tileinfo.lod = lod;
+                    tileinfo.uref = uref;
+                    tileinfo.rref = rref;
+                    if(bounded && !InParent(tileinfo))
+                        continue;
+                    tileinfos.push_back(tileinfo);
+                }
+            }
+        }
+    }
+
+    west = extent->getPointN(0)->X();
+    south = extent->getPointN(0)->Y();
+    east = extent->getPointN(1)->X();
+    north = extent->getPointN(1)->Y();
+    auto split_lines = (feature->geometry->getWKBGeometryType() == sfa::wkbLineString);
+    for(auto& tileinfo : tileinfos)
+    {
+        auto nsew = NSEWForTileInfo(tileinfo);
+        if((west >= nsew.west) && (east <= nsew.east) && (south >= nsew.south) && (north <= nsew.north))
+        {
+            bins[tileinfo].push_back(feature);
+            ++count;
+            continue;
+        }
+        auto clipped = std::unique_ptr<sfa::Geometry>(sfa::clipToRectangle(feature->geometry, nsew.west, nsew.east, nsew.south, nsew.north));
+        if(!clipped)
+            continue;
+        auto& bin = bins[tileinfo];
+        if(split_lines && (clipped->getWKBGeometryType() == sfa::wkbMultiLineString))
+        {
+            auto parts = static_cast<sfa::MultiLineString*>(clipped.get());
+            for(int i = 1, c = parts->getNumGeometries(); i <= c; ++i)
+                bin.push_back(FeatureWithGeometry(*feature, parts->getGeometryN(i)->copy()));
+            count += parts->getNumGeometries();
+            continue;
+        }
+        bin.push_back(FeatureWithGeometry(*feature, clipped.release()));
+        ++count;
+    }
+}
+
+void FeatureTileBinner::Clear()
+{
+    for(auto& entry : bins)
+        FeatureList().swap(entry.second);
+    count = 0;
+}
+
+}
+}
+
@@ -0,0 +1,207 @@
+
+#include <cdb_util/RasterInfoCatalog.h>
+
+#include <ccl/ObjLog.h>
+#include <ccl/FileInfo.h>
+
+#include <cpl_string.h>
+#include <cpl_vsi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if _WIN32
+#include <filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#elif __GNUC__ && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#else
+#include <filesystem>
+#endif
+
+namespace cognitics {
+namespace cdb {
+
+namespace
+{
+    const char* CatalogHeader = "RasterInfoCatalog 1";
+
+    bool SourceStat(const std::string& filename, int64_t& mtime, uint64_t& size)
+    {
+        std::string path = filename;
+        std::string table;
+        ccl::GetFilenameAndTable(filename, path, table);
+        auto ec = std::error_code();
+        size = uint64_t(std::filesystem::file_size(path, ec));
+        if(ec)
+            return false;
+        auto t = std::filesystem::last_write_time(path, ec);
+        if(ec)
+            return false;
+        mtime = int64_t(t.time_since_epoch().count());
+        return true;
+    }
+}
+
+RasterInfoCatalog::RasterInfoCatalog(const std::string& filename) : filename(filename)
+{
+    Load();
+}
+
+bool RasterInfoCatalog::Load()
+{
+    if(filename.empty())
+        return false;
+    std::ifstream infile(filename);
+    if(!infile)
+        return false;
+    std::string line;
+    if(!std::getline(infile, line) || (line != CatalogHeader))
+        return false;
+    while(std::getline(infile, line))
+    {
+        // The path goes last so it may contain spaces.
+        auto tab = line.find('\t');
+        if(tab == std::string::npos)
+            continue;
+        std::istringstream iss(line.substr(0, tab));
+        Entry entry;
+        auto& info = entry.info;
+        iss >> entry.mtime >> entry.size >> info.Width >> info.Height >> info.OriginX >> info.OriginY >> info.PixelSizeX >> info.PixelSizeY
+            >> info.South >> info.West >> info.North >> info.East >> info.BandCount;
+        if(iss.fail())
+            continue;
+        entries[line.substr(tab + 1)] = entry;
+    }
+    return true;
+}
+
+bool RasterInfoCatalog::Save() const
+{
+    if(filename.empty())
+        return false;
+    if(!dirty)
+        return true;
+    ccl::makeDirectory(ccl::FileInfo(filename).getDirName());
+    auto tmpname = filename + ".tmp";
+    {
+        std::ofstream outfile(tmpname, std::ios::trunc);
+        if(!outfile)
+            return false;
+        outfile.precision(17);
+        outfile << CatalogHeader << "\n";
+        for(auto& it : entries)
+        {
+            auto& entry = it.second;
+            auto& info = entry.info;
+            outfile << entry.mtime << " " << entry.size << " " << info.Width << " " << info.Height << " "
+                << info.OriginX << " " << info.OriginY << " " << info.PixelSizeX << " " << info.PixelSizeY << " "
+                << info.South << " " << info.West << " " << info.North << " " << info.East << " " << info.BandCount
+                << "\t" << it.first << "\n";
+        }
+        if(!outfile)
+            return false;
+    }
+    std::remove(filename.c_str());
+    return std::rename(tmpname.c_str(), filename.c_str()) == 0;
+}
+
+std::vector<RasterInfo> RasterInfoCatalog::Read(const std::vector<std::string>& filenames, size_t workers)
+{
+    auto result = std::vector<RasterInfo>(filenames.size());
+
+    struct Pending
+    {
+        size_t index;
+        int64_t mtime;
+        uint64_t size;
+        bool stat;
+        char** siblings;
+    };
+    auto pending = std::vector<Pending>();
+    for(size_t i = 0, c = filenames.size(); i < c; ++i)
+    {
+        auto& name = filenames[i];
+        int64_t mtime = 0;
+        uint64_t size = 0;
+        bool stat = SourceStat(name, mtime, size);
+        if(stat)
+        {
+            auto it = entries.find(name);
+            if((it != entries.end()) && (it->second.mtime == mtime) && (it->second.size == size))
+            {
+                result[i] = it->second.info;
+                ++hits;
+                continue;
+            }
+        }
+        pending.push_back(Pending { i, mtime, size, stat, nullptr });
+    }
+    misses += pending.size();
+    if(pending.empty())
+        return result;
+
+    // Without a sibling list GDAL lists the source's directory on every open,
+    // which is quadratic for a directory of tens of thousands of tiles.
+    auto siblings_by_directory = std::map<std::string, char**>();
+    for(auto& p : pending)
+    {
+        auto& name = filenames[p.index];
+        std::string path = name;
+        std::string table;
+        ccl::GetFilenameAndTable(name, path, table);
+        if(!table.empty())
+            continue;
+        auto dir = std::filesystem::path(path).parent_path().string();
+        if(dir.empty())
+            dir = ".";
+        auto it = siblings_by_directory.find(dir);
+        if(it == siblings_by_directory.end())
+            it = siblings_by_directory.emplace(dir, VSIReadDir(dir.c_str())).first;
+        p.siblings = it->second;
+    }
+
+    if(workers == 0)
+        workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    workers = std::min(workers, pending.size());
+    std::atomic<size_t> next { 0 };
+    auto read = [&]()
+    {
+        for(auto i = next++; i < pending.size(); i = next++)
+        {
+            auto& p = pending[i];
+            result[p.index] = ReadRasterInfo(filenames[p.index], p.siblings);
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < workers; ++i)
+        threads.emplace_back(read);
+    read();
+    for(auto& thread : threads)
+        thread.join();
+
+    for(auto& it : siblings_by_directory)
+        CSLDestroy(it.second);
+
+    for(auto& p : pending)
+    {
+        // Files GDAL couldn't read are tried again next time.
+        auto& info = result[p.index];
+        if(!p.stat || (info.Width == 0))
+            continue;
+        auto& entry = entries[filenames[p.index]];
+        entry.mtime = p.mtime;
+        entry.size = p.size;
+        entry.info = info;
+        dirty = true;
+    }
+    return result;
+}
+
+}
+}
+
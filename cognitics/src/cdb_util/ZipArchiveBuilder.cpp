@@ -0,0 +1,289 @@
+
+#include <cdb_util/ZipArchiveBuilder.h>
+
+#include <ccl/ObjLog.h>
+#include <ccl/FileInfo.h>
+#include <ccl/miniz.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if _WIN32
+#include <filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#elif __GNUC__ && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#else
+#include <filesystem>
+#endif
+
+namespace cognitics {
+namespace cdb {
+
+namespace
+{
+    bool ArchiveStat(const std::string& zipname, int64_t& mtime, uint64_t& size)
+    {
+        auto ec = std::error_code();
+        auto path = std::filesystem::path(zipname);
+        size = uint64_t(std::filesystem::file_size(path, ec));
+        if(ec)
+            return false;
+        auto t = std::filesystem::last_write_time(path, ec);
+        if(ec)
+            return false;
+        mtime = int64_t(t.time_since_epoch().count());
+        return true;
+    }
+
+    std::string EntryFilename(mz_zip_archive& zip, mz_uint index)
+    {
+        char filename[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
+        mz_zip_reader_get_filename(&zip, index, filename, sizeof(filename));
+        return filename;
+    }
+}
+
+ZipDirectoryCache& ZipDirectoryCache::Instance()
+{
+    static ZipDirectoryCache instance;
+    return instance;
+}
+
+bool ZipDirectoryCache::Contains(const std::string& zipname, const std::string& filename)
+{
+    int64_t mtime = 0;
+    uint64_t size = 0;
+    if(!ArchiveStat(zipname, mtime, size))
+    {
+        Invalidate(zipname);
+        return false;
+    }
+
+    std::shared_ptr<const Directory> directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = directories.find(zipname);
+        if((it != directories.end()) && (it->second->mtime == mtime) && (it->second->size == size))
+            directory = it->second;
+    }
+
+    if(!directory)
+    {
+        // Read outside the lock; two threads racing on the same stale archive just read it twice.
+        auto fresh = std::make_shared<Directory>();
+        fresh->mtime = mtime;
+        fresh->size = size;
+        mz_zip_archive zip;
+        memset(&zip, 0, sizeof(zip));
+        if(!mz_zip_reader_init_file(&zip, zipname.c_str(), MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY))
+            return false;
+        auto count = mz_zip_reader_get_num_files(&zip);
+        fresh->names.reserve(count);
+        for(mz_uint i = 0; i < count; ++i)
+            fresh->names.insert(EntryFilename(zip, i));
+        mz_zip_reader_end(&zip);
+        directory = fresh;
+        std::lock_guard<std::mutex> lock(mutex);
+        directories[zipname] = directory;
+    }
+
+    return directory->names.find(filename) != directory->names.end();
+}
+
+void ZipDirectoryCache::Invalidate(const std::string& zipname)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    directories.erase(zipname);
+}
+
+ZipArchiveBuilder::ZipArchiveBuilder(const std::string& zipname) : zipname(zipname)
+{
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+    if(!mz_zip_reader_init_file(&zip, zipname.c_str(), MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY))
+        return;
+    archive_exists = true;
+    auto count = mz_zip_reader_get_num_files(&zip);
+    for(mz_uint i = 0; i < count; ++i)
+    {
+        mz_zip_archive_file_stat stat;
+        if(!mz_zip_reader_file_stat(&zip, i, &stat))
+            continue;
+        names.insert(stat.m_filename);
+        if(!mz_zip_reader_is_file_a_directory(&zip, i))
+            names_by_content.emplace(ContentKey(stat.m_crc32, stat.m_uncomp_size), stat.m_filename);
+    }
+    mz_zip_reader_end(&zip);
+}
+
+uint64_t ZipArchiveBuilder::ContentKey(uint32_t crc, uint64_t size)
+{
+    return (size << 32) ^ crc;
+}
+
+bool ZipArchiveBuilder::Contains(const std::string& filename) const
+{
+    return names.find(filename) != names.end();
+}
+
+bool ZipArchiveBuilder::SameContent(const std::string& filename, const std::string& bytes) const
+{
+    auto pit = pending_index.find(filename);
+    if(pit != pending_index.end())
+        return pending[pit->second].bytes == bytes;
+
+    // Matching crc and size against an entry already on disk; confirm before sharing it.
+    size_t size = 0;
+    auto data = mz_zip_extract_archive_file_to_heap(zipname.c_str(), filename.c_str(), &size, 0);
+    if(!data)
+        return false;
+    bool result = (size == bytes.size()) && (memcmp(data, bytes.data(), size) == 0);
+    mz_free(data);
+    return result;
+}
+
+std::string ZipArchiveBuilder::Add(const std::string& filename, std::string&& bytes, bool dedupe)
+{
+    if(Contains(filename))
+        return filename;
+
+    auto crc = uint32_t(mz_crc32(MZ_CRC32_INIT, (const mz_uint8*)bytes.data(), bytes.size()));
+    auto key = ContentKey(crc, bytes.size());
+    if(dedupe)
+    {
+        auto range = names_by_content.equal_range(key);
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            if(SameContent(it->second, bytes))
+                return it->second;
+        }
+    }
+
+    names.insert(filename);
+    names_by_content.emplace(key, filename);
+    pending_index[filename] = pending.size();
+    pending.emplace_back();
+    auto& entry = pending.back();
+    entry.filename = filename;
+    entry.bytes = std::move(bytes);
+    entry.crc = crc;
+    return filename;
+}
+
+bool ZipArchiveBuilder::Write(int level, size_t workers)
+{
+    if(pending.empty())
+        return true;
+
+    ccl::ObjLog log;
+
+    if(level < 0)
+        level = MZ_DEFAULT_LEVEL;
+    if(level > 0)
+    {
+        if(workers == 0)
+            workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+        workers = std::min(workers, pending.size());
+        auto flags = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+        std::atomic<size_t> next { 0 };
+        auto compress = [&]()
+        {
+            for(auto i = next++; i < pending.size(); i = next++)
+            {
+                auto& entry = pending[i];
+                if(entry.bytes.size() <= 3)
+                    continue;
+                size_t compressed_size = 0;
+                auto compressed = tdefl_compress_mem_to_heap(entry.bytes.data(), entry.bytes.size(), &compressed_size, flags);
+                if(!compressed)
+                    continue;
+                // Incompressible data is stored, as mz_zip_writer_add_mem_ex would do.
+                if(compressed_size < entry.bytes.size())
+                {
+                    entry.compressed.assign((const char*)compressed, compressed_size);
+                    entry.deflated = true;
+                }
+                mz_free(compressed);
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_t i = 1; i < workers; ++i)
+            threads.emplace_back(compress);
+        compress();
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+    bool created = false;
+    if(archive_exists)
+    {
+        if(!mz_zip_reader_init_file(&zip, zipname.c_str(), MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY))
+        {
+            log << ccl::LERR << "unable to open " << zipname << log.endl;
+            return false;
+        }
+        if(!mz_zip_writer_init_from_reader(&zip, zipname.c_str()))
+        {
+            mz_zip_reader_end(&zip);
+            log << ccl::LERR << "unable to append to " << zipname << log.endl;
+            return false;
+        }
+    }
+    else
+    {
+        ccl::makeDirectory(ccl::FileInfo(zipname).getDirName());
+        if(!mz_zip_writer_init_file(&zip, zipname.c_str(), 0))
+        {
+            log << ccl::LERR << "unable to create " << zipname << log.endl;
+            return false;
+        }
+        created = true;
+    }
+
+    bool result = true;
+    for(auto& entry : pending)
+    {
+        mz_bool status;
+        if(entry.deflated)
+            status = mz_zip_writer_add_mem_ex(&zip, entry.filename.c_str(), entry.compressed.data(), entry.compressed.size(), NULL, 0, mz_uint(level) | MZ_ZIP_FLAG_COMPRESSED_DATA, entry.bytes.size(), entry.crc);
+        else
+            status = mz_zip_writer_add_mem_ex(&zip, entry.filename.c_str(), entry.bytes.data(), entry.bytes.size(), NULL, 0, 0, 0, 0);
+        if(!status)
+        {
+            log << ccl::LERR << "unable to add " << entry.filename << " to " << zipname << log.endl;
+            result = false;
+            break;
+        }
+    }
+    // Always finalize so the archive keeps a valid central directory.
+    if(!mz_zip_writer_finalize_archive(&zip))
+        result = false;
+    if(!mz_zip_writer_end(&zip))
+        result = false;
+    if(!result && created)
+        std::remove(zipname.c_str());
+
+    ZipDirectoryCache::Instance().Invalidate(zipname);
+
+    if(!result)
+    {
+        // Forget the entries that did not make it so the builder matches the archive again.
+        *this = ZipArchiveBuilder(zipname);
+        return false;
+    }
+    archive_exists = true;
+    pending.clear();
+    pending_index.clear();
+    return true;
+}
+
+}
+}
+
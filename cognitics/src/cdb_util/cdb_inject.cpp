@@ -2,6 +2,8 @@
 #include <cdb_util/cdb_inject.h>
 
 #include <cdb_util/cdb_util.h>
+#include <cdb_util/CDBTileIndex.h>
+#include <cdb_util/RasterInfoCatalog.h>
 
 #include <cdb_tile/Tile.h>
 
@@ -15,6 +17,9 @@
 #include <chrono>
 #include <future>
 #include <deque>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 
 #if _WIN32
 #include <filesystem>
@@ -71,45 +76,66 @@ public:
 
 };
 
+// Elevation sources and their block cache are shared by every worker; each
+// thread only gets its own Elevation_DSM, which keeps per-query state.
 class CDBTileJobThreadDataManager : public ccl::ThreadDataManager
 {
 private:
     gdalsampler::tl_ptr<elev::Elevation_DSM> _tl_sampler;
+    std::mutex _dsm_mutex;
+    std::unique_ptr<elev::DataSourceManager> _dsm;
 
 public:
     bool useIPP { true };
+    unsigned int cache_size { 512 * 1024 * 1024 };
     std::vector<std::string> elevation_filenames;
     std::vector<std::string> elevation_filepaths;
-	
+
+    virtual ~CDBTileJobThreadDataManager()
+    {
+        if(!_dsm)
+            return;
+        ccl::ObjLog log;
+        auto cache = _dsm->GetCache();
+        log << ccl::LINFO << "Elevation cache: " << cache->GetHits() << " hits, " << cache->GetMisses() << " misses, " << cache->GetEvictions() << " evictions" << log.endl;
+    }
+
     virtual void onThreadFinished()
     {
         deleteSampler();
     }
 
-	elev::Elevation_DSM *getSampler()
-	{
-		if(_tl_sampler.get() == NULL)
-		{
-			elev::DataSourceManager *dsm = new elev::DataSourceManager(50 * 1024 * 1024);
-            for(auto&& elevation_filename : elevation_filenames)
-				dsm->AddFile_Raster_GDAL(elevation_filename);
-            for(auto&& elevation_filepath : elevation_filepaths)
-				dsm->AddDirectory_Raster_GDAL(elevation_filepath);
-			dsm->generateBSP();
-			_tl_sampler.set(new elev::Elevation_DSM(dsm, elev::ELEVATION_BILINEAR));
-		}
-		return _tl_sampler.get();
-	}
+    elev::Elevation_DSM *getSampler()
+    {
+        if(_tl_sampler.get() == NULL)
+        {
+            elev::DataSourceManager *dsm = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_dsm_mutex);
+                if(!_dsm)
+                {
+                    _dsm.reset(new elev::DataSourceManager(cache_size));
+                    for(auto&& elevation_filename : elevation_filenames)
+                        _dsm->AddFile_Raster_GDAL(elevation_filename);
+                    for(auto&& elevation_filepath : elevation_filepaths)
+                        _dsm->AddDirectory_Raster_GDAL(elevation_filepath);
+                    _dsm->generateBSP();
+                }
+                dsm = _dsm.get();
+            }
+            _tl_sampler.set(new elev::Elevation_DSM(dsm, elev::ELEVATION_BILINEAR));
+        }
+        return _tl_sampler.get();
+    }
 
     void deleteSampler()
-	{
-		if(_tl_sampler.get() != NULL)
-		{
-			delete _tl_sampler.get()->dsm;
-			delete _tl_sampler.get();
-			_tl_sampler.set(NULL);
-		}
-	}
+    {
+        if(_tl_sampler.get() != NULL)
+        {
+            delete _tl_sampler.get();
+            _tl_sampler.set(NULL);
+        }
+    }
 
 };
 
@@ -131,6 +157,7 @@ protected:
 
 public:
     CDBTileJobThreadDataManager* data_manager { nullptr };
+    bool minmax { false };
 
     virtual ~CDBTileJob() {}
 
@@ -149,19 +176,19 @@ public:
     {
         ccl::ObjLog log;
         auto fn = cognitics::cdb::FileNameForTileInfo(tileinfo);
-        log << "Processing " << fn << log.endl;
+        CCL_LOG(log, ccl::LINFO) << "Processing " << fn << log.endl;
         try
         {
             if (isElevation)
             {
                 if(data_manager->useIPP)
                 {
-                    cognitics::cdb::BuildElevationTileFromSampler(cdb, sampler, tileinfo);
+                    cognitics::cdb::BuildElevationTileFromSampler(cdb, sampler, tileinfo, minmax);
                 }
                 else
                 {
                     auto dsm = data_manager->getSampler();
-                    cognitics::cdb::BuildElevationTileFromSampler2(cdb, *dsm, tileinfo);
+                    cognitics::cdb::BuildElevationTileFromSampler2(cdb, *dsm, tileinfo, minmax);
                 }
             }
             else
@@ -184,6 +211,287 @@ int CDBTileJob::createdJobCount = 0;
 int CDBTileJob::processedJobCount = 0;
 std::mutex CDBTileJob::countMutex;
 
+// Busy time and tile count for one stage of the pipelined inject.
+struct InjectStageStats
+{
+    std::string name;
+    int workers;
+    std::atomic<long long> tiles { 0 };
+    std::atomic<long long> microseconds { 0 };
+
+    InjectStageStats(const std::string& name, int workers) : name(name), workers(workers) { }
+
+    void add(std::chrono::steady_clock::time_point start)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        microseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        ++tiles;
+    }
+
+    std::string summary() const
+    {
+        long long count = tiles.load();
+        double busy = microseconds.load() / 1e6;
+        double per_tile = count ? (busy * 1000.0 / count) : 0.0;
+        double rate = (busy > 0.0) ? (count * workers / busy) : 0.0;
+        std::stringstream ss;
+        ss.precision(4);
+        ss << name << ": " << count << " tiles, " << workers << " worker(s), " << busy << "s busy, " << per_tile << " ms/tile, " << rate << " tiles/s";
+        return ss.str();
+    }
+};
+
+// Owner of every pipeline job. A job with an owner is deleted by JobManager::cleanup()
+// once it has finished, so a pass doesn't hold a Job and its ObjLog per tile stage.
+class InjectOwnerJob : public ccl::Job
+{
+public:
+    InjectOwnerJob() : ccl::Job(NULL, NULL)
+    {
+    }
+
+    int execute(void)
+    {
+        return 0;
+    }
+};
+
+// Three thread pools connected by jobs that hand each tile to the next stage:
+// decode pages the tile's source blocks into the shared block cache, warp
+// samples them into a tile buffer, encode writes the JP2/TIF.
+class InjectPipeline
+{
+public:
+    std::string cdb;
+    GDALRasterSampler& sampler;
+    bool isElevation;
+    bool minmax;
+    JobProgressReporter& reporter;
+    InjectStageStats decodeStats;
+    InjectStageStats warpStats;
+    InjectStageStats encodeStats;
+    std::atomic<long long> blocks { 0 };
+
+    // Declared before the job managers so it outlives the jobs it owns.
+    InjectOwnerJob owner;
+
+private:
+
+    // Bounds the number of tiles between decode and encode so prefetched blocks
+    // are still cached when the warp reaches them and tile buffers don't pile up.
+    std::mutex inflightMutex;
+    std::condition_variable inflightCondition;
+    int inflight { 0 };
+    int maxInflight { 1 };
+
+public:
+    ccl::JobManager decodeManager;
+    ccl::JobManager warpManager;
+    ccl::JobManager encodeManager;
+
+    InjectPipeline(const cognitics::cdb::cdb_inject_parameters& params, GDALRasterSampler& sampler, bool isElevation, JobProgressReporter& reporter)
+        : cdb(params.cdb), sampler(sampler), isElevation(isElevation), minmax(params.minmax), reporter(reporter),
+        decodeStats("decode", std::max<int>(params.decode_workers, 1)),
+        warpStats("warp", std::max<int>(params.workers, 1)),
+        encodeStats("encode", std::max<int>(params.encode_workers, 1)),
+        maxInflight((warpStats.workers + encodeStats.workers) * 2),
+        decodeManager(decodeStats.workers),
+        warpManager(warpStats.workers),
+        encodeManager(encodeStats.workers)
+    {
+    }
+
+    // Delete the jobs that have finished so far.
+    void cleanup()
+    {
+        decodeManager.cleanup();
+        warpManager.cleanup();
+        encodeManager.cleanup();
+    }
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock(inflightMutex);
+        inflightCondition.wait(lock, [this] { return inflight < maxInflight; });
+        ++inflight;
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            --inflight;
+        }
+        inflightCondition.notify_one();
+    }
+
+    void run(const std::vector<cognitics::cdb::TileInfo>& tileinfos);
+};
+
+class InjectEncodeJob : public ccl::Job
+{
+    InjectPipeline& pipeline;
+    cognitics::cdb::TileInfo tileinfo;
+
+public:
+    std::vector<unsigned char> bytes;
+    std::vector<float> floats;
+
+    InjectEncodeJob(InjectPipeline& pipeline, const cognitics::cdb::TileInfo& tileinfo)
+        : ccl::Job(&pipeline.encodeManager, &pipeline.owner), pipeline(pipeline), tileinfo(tileinfo)
+    {
+    }
+
+    int execute(void)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            bool written = pipeline.isElevation
+                ? cognitics::cdb::WriteElevationTile(pipeline.cdb, tileinfo, floats, pipeline.minmax)
+                : cognitics::cdb::WriteImageryTile(pipeline.cdb, tileinfo, bytes);
+            if(!written)
+                log << cognitics::cdb::FileNameForTileInfo(tileinfo) << " write failed" << log.endl;
+        }
+        catch(std::exception& e)
+        {
+            log << cognitics::cdb::FileNameForTileInfo(tileinfo) << " EXCEPTION: " << e.what() << log.endl;
+        }
+        pipeline.encodeStats.add(start);
+        std::vector<unsigned char>().swap(bytes);
+        std::vector<float>().swap(floats);
+        pipeline.reporter.reportCompletedJob("");
+        pipeline.release();
+        return 0;
+    }
+};
+
+class InjectWarpJob : public ccl::Job
+{
+    InjectPipeline& pipeline;
+    cognitics::cdb::TileInfo tileinfo;
+
+public:
+    InjectWarpJob(InjectPipeline& pipeline, const cognitics::cdb::TileInfo& tileinfo)
+        : ccl::Job(&pipeline.warpManager, &pipeline.owner), pipeline(pipeline), tileinfo(tileinfo)
+    {
+    }
+
+    int execute(void)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto encodeJob = new InjectEncodeJob(pipeline, tileinfo);
+        bool sampled = false;
+        try
+        {
+            if(pipeline.isElevation)
+                sampled = cognitics::cdb::SampleElevationTile(pipeline.cdb, pipeline.sampler, tileinfo, encodeJob->floats);
+            else
+                sampled = cognitics::cdb::SampleImageryTile(pipeline.cdb, pipeline.sampler, tileinfo, encodeJob->bytes);
+            if(!sampled)
+                log << cognitics::cdb::FileNameForTileInfo(tileinfo) << " sample failed, tile not written" << log.endl;
+        }
+        catch(std::exception& e)
+        {
+            log << cognitics::cdb::FileNameForTileInfo(tileinfo) << " EXCEPTION: " << e.what() << log.endl;
+        }
+        pipeline.warpStats.add(start);
+        if(!sampled)
+        {
+            // never submitted, so no manager will delete it
+            delete encodeJob;
+            pipeline.reporter.reportCompletedJob("");
+            pipeline.release();
+            return 0;
+        }
+        pipeline.encodeManager.submitJob(encodeJob, false);
+        return 0;
+    }
+};
+
+class InjectDecodeJob : public ccl::Job
+{
+    InjectPipeline& pipeline;
+    cognitics::cdb::TileInfo tileinfo;
+
+public:
+    InjectDecodeJob(InjectPipeline& pipeline, const cognitics::cdb::TileInfo& tileinfo)
+        : ccl::Job(&pipeline.decodeManager, &pipeline.owner), pipeline(pipeline), tileinfo(tileinfo)
+    {
+    }
+
+    int execute(void)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            // Padded by a pixel to cover the half-post shift used for elevation.
+            double north, south, east, west;
+            std::tie(north, south, east, west) = cognitics::cdb::NSEWBoundsForTileInfo(tileinfo);
+            int dim = cognitics::cdb::TileDimensionForLod(tileinfo.lod);
+            double pad_ns = (north - south) / dim;
+            double pad_ew = (east - west) / dim;
+            gdalsampler::GeoExtents window;
+            window.north = north + pad_ns;
+            window.south = south - pad_ns;
+            window.east = east + pad_ew;
+            window.west = west - pad_ew;
+            window.width = dim + 2;
+            window.height = dim + 2;
+            pipeline.blocks += pipeline.sampler.PrefetchBlocks(window);
+        }
+        catch(std::exception& e)
+        {
+            log << cognitics::cdb::FileNameForTileInfo(tileinfo) << " EXCEPTION: " << e.what() << log.endl;
+        }
+        pipeline.decodeStats.add(start);
+        pipeline.warpManager.submitJob(new InjectWarpJob(pipeline, tileinfo), false);
+        return 0;
+    }
+};
+
+void InjectPipeline::run(const std::vector<cognitics::cdb::TileInfo>& tileinfos)
+{
+    ccl::ObjLog log;
+    auto start = std::chrono::steady_clock::now();
+    reporter.setTotalJobCount(int(tileinfos.size()));
+    for(auto&& ti : tileinfos)
+    {
+        acquire();
+        cleanup();
+        decodeManager.submitJob(new InjectDecodeJob(*this, ti), false);
+    }
+    decodeManager.waitForCompletion();
+    warpManager.waitForCompletion();
+    encodeManager.waitForCompletion();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto cache = gdalsampler::SharedBlockCache::getInstance()->GetStats();
+    log << ccl::LINFO << "Pipeline finished " << tileinfos.size() << " " << (isElevation ? "elevation" : "imagery") << " tiles in " << elapsed << "s (" << ((elapsed > 0.0) ? (tileinfos.size() / elapsed) : 0.0) << " tiles/s)" << log.endl;
+    log << ccl::LINFO << "  " << decodeStats.summary() << ", " << blocks.load() << " blocks paged" << log.endl;
+    log << ccl::LINFO << "  " << warpStats.summary() << log.endl;
+    log << ccl::LINFO << "  " << encodeStats.summary() << log.endl;
+    log << ccl::LINFO << "  block cache: " << cache.hits << " hits, " << cache.misses << " misses, " << cache.evictions << " evictions, " << (cache.bytes / (1024 * 1024)) << " MB in " << cache.blocks << " blocks" << log.endl;
+}
+
+void RunInjectPipeline(const cognitics::cdb::cdb_inject_parameters& params, GDALRasterSampler& sampler, const std::set<cognitics::cdb::TileInfo>& tileinfo_set, bool isElevation, JobProgressReporter& reporter)
+{
+    auto tileinfos = std::vector<cognitics::cdb::TileInfo>(tileinfo_set.begin(), tileinfo_set.end());
+    std::sort(tileinfos.begin(), tileinfos.end(), [](const cognitics::cdb::TileInfo& a, const cognitics::cdb::TileInfo& b)
+    {
+        return cognitics::cdb::MortonCodeForTileInfo(a) < cognitics::cdb::MortonCodeForTileInfo(b);
+    });
+
+    auto cache = gdalsampler::SharedBlockCache::getInstance();
+    cache->SetBudget(std::max<size_t>(params.block_cache_megabytes, 1) * 1024 * 1024);
+    {
+        InjectPipeline pipeline(params, sampler, isElevation, reporter);
+        pipeline.run(tileinfos);
+    }
+    cache->Clear();
+    cache->SetBudget(0);
+}
+
 }
 
 namespace cognitics {
@@ -192,6 +500,7 @@ namespace cdb {
 bool cdb_inject(cdb_inject_parameters& params)
 {
     ccl::ObjLog log;
+    CDBTileIndex::Instance().SetWritable(params.cdb);
 
 
     auto imagery_filenames = std::vector<std::string>();
@@ -260,6 +569,7 @@ bool cdb_inject(cdb_inject_parameters& params)
     bool elevation_enabled = !elevation_filenames.empty();
 
     auto raster_info_by_filename = std::map<std::string, cognitics::cdb::RasterInfo>();
+    auto catalog = cognitics::cdb::RasterInfoCatalog(params.source_catalog.empty() ? (params.cdb + "/.source_catalog") : params.source_catalog);
 
     auto imagery_tiles = std::vector<cognitics::cdb::Tile>();
     auto imagery_tileinfos = std::set<cognitics::cdb::TileInfo>();
@@ -270,10 +580,11 @@ bool cdb_inject(cdb_inject_parameters& params)
         // We're doing this here to avoid opening the file and checking the metadata twice, which makes a big difference
         // in a large import.
         auto bad_imagery_filenames = std::vector<std::string>();
-        for (auto filename : imagery_filenames)
+        auto imagery_raster_infos = catalog.Read(imagery_filenames, params.workers);
+        for (size_t i = 0, c = imagery_filenames.size(); i < c; ++i)
         {
-            log << ccl::LINFO << "Reading metadata for " << filename << log.endl;
-            auto raster_info = cognitics::cdb::ReadRasterInfo(filename);
+            auto& filename = imagery_filenames[i];
+            auto raster_info = imagery_raster_infos[i];
             /*
             if (raster_info.BandCount < 3)
             {
@@ -321,9 +632,11 @@ bool cdb_inject(cdb_inject_parameters& params)
     if (elevation_enabled)
     {
         log << ccl::LINFO << "Gathering information on " << elevation_filenames.size() << " elevation file(s)..." << log.endl;
-        for (auto filename : elevation_filenames)
+        auto elevation_raster_infos = catalog.Read(elevation_filenames, params.workers);
+        for (size_t i = 0, c = elevation_filenames.size(); i < c; ++i)
         {
-            auto raster_info = cognitics::cdb::ReadRasterInfo(filename);
+            auto& filename = elevation_filenames[i];
+            auto raster_info = elevation_raster_infos[i];
             if (raster_info.BandCount != 1)
             {
                 log << ccl::LWARNING << "Warning: " << filename << " ignored as an elevation file because it has " << raster_info.BandCount << " raster bands." << log.endl;
@@ -361,6 +674,14 @@ bool cdb_inject(cdb_inject_parameters& params)
         }
     }
 
+    if (catalog.Hits() + catalog.Misses() > 0)
+    {
+        log << ccl::LINFO << "Source metadata: " << catalog.Hits() << " cached, " << catalog.Misses() << " read." << log.endl;
+        // A dry run doesn't create the CDB just to hold the catalog.
+        if (!(params.dry_run || params.count_tiles) || std::filesystem::exists(params.cdb))
+            catalog.Save();
+    }
+
     if (params.dry_run || params.count_tiles)
     {
         // TODO: we need to differentiate between imagery and elevation
@@ -411,9 +732,14 @@ bool cdb_inject(cdb_inject_parameters& params)
     CDBTileJobThreadDataManager cdbTileJobThreadDataManager;
     ccl::JobManager jobManager(params.workers, NULL, &cdbTileJobThreadDataManager);
 
+    // Source headers for the samplers, so sources and coverage tiles seen by an earlier run aren't opened again up front.
+    gdalsampler::SourceCatalog source_catalog;
+    source_catalog.Load(catalog.Filename() + ".gdal");
+
     if (!imagery_tileinfos.empty())
     {
         GDALRasterSampler sampler;
+        sampler.SetCatalog(&source_catalog);
         for(auto ti : imagery_tileinfos)
         {
             auto parent_ti = cognitics::cdb::ParentTileInfo(ti);
@@ -437,19 +763,28 @@ bool cdb_inject(cdb_inject_parameters& params)
             std::cout << fn << "\n";
         for(auto fn : imagery_filenames)
             sampler.AddFile(fn);
-        for (auto&& ti : imagery_tileinfos)
+        source_catalog.Save();
+        if (params.pipeline)
         {
-            auto cdbTileJob = new CDBTileJob(&jobManager, params.cdb, std::ref(sampler), ti, jobReporter, false);
-            cdbTileJob->data_manager = &cdbTileJobThreadDataManager;
-            jobManager.submitJob(cdbTileJob);
+            RunInjectPipeline(params, sampler, imagery_tileinfos, false, jobReporter);
+        }
+        else
+        {
+            for (auto&& ti : imagery_tileinfos)
+            {
+                auto cdbTileJob = new CDBTileJob(&jobManager, params.cdb, std::ref(sampler), ti, jobReporter, false);
+                cdbTileJob->data_manager = &cdbTileJobThreadDataManager;
+                jobManager.submitJob(cdbTileJob);
+            }
+            jobReporter.setTotalJobCount(imagery_tileinfos.size());
+            jobManager.waitForCompletion();
         }
-        jobReporter.setTotalJobCount(imagery_tileinfos.size());
-        jobManager.waitForCompletion();
     }
 
     if (!elevation_tileinfos.empty())
     {
         GDALRasterSampler sampler;
+        sampler.SetCatalog(&source_catalog);
         for(auto ti : elevation_tileinfos)
         {
             double tile_north, tile_south, tile_east, tile_west;
@@ -477,15 +812,24 @@ bool cdb_inject(cdb_inject_parameters& params)
             std::cout << fn << "\n";
         for(auto fn : elevation_filenames)
             sampler.AddFile(fn);
-        for (auto&& ti : elevation_tileinfos)
+        source_catalog.Save();
+        if (params.pipeline)
         {
-            auto cdbTileJob = new CDBTileJob(&jobManager, params.cdb, std::ref(sampler), ti, jobReporter, true);
-            cdbTileJob->data_manager = &cdbTileJobThreadDataManager;
-            cdbTileJob->data_manager->elevation_filenames = elevation_filenames;
-            jobManager.submitJob(cdbTileJob);
+            RunInjectPipeline(params, sampler, elevation_tileinfos, true, jobReporter);
+        }
+        else
+        {
+            for (auto&& ti : elevation_tileinfos)
+            {
+                auto cdbTileJob = new CDBTileJob(&jobManager, params.cdb, std::ref(sampler), ti, jobReporter, true);
+                cdbTileJob->data_manager = &cdbTileJobThreadDataManager;
+                cdbTileJob->minmax = params.minmax;
+                cdbTileJob->data_manager->elevation_filenames = elevation_filenames;
+                jobManager.submitJob(cdbTileJob);
+            }
+            jobReporter.setTotalJobCount(elevation_tileinfos.size());
+            jobManager.waitForCompletion();
         }
-        jobReporter.setTotalJobCount(elevation_tileinfos.size());
-        jobManager.waitForCompletion();
         /*
         {
             elev::DataSourceManager dsm(50 * 1024 * 1024);
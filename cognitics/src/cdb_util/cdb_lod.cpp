@@ -1,15 +1,19 @@
-
 #include <cdb_util/cdb_lod.h>
 
 #include <cdb_util/cdb_util.h>
+#include <cdb_util/CDBTileIndex.h>
 
 #include <ccl/FileInfo.h>
 #include <ccl/JobManager.h>
+#include <ip/PyramidReduce.h>
+
+#include <cpl_vsi.h>
 
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <functional>
+#include <memory>
 
 #if _WIN32
 #include <filesystem>
@@ -24,87 +28,369 @@ namespace std { namespace filesystem = std::experimental::filesystem; }
 namespace
 {
 
-class TileJob : public ccl::Job
+// Black is the imagery no-data value, as in GDALRasterSampler::CopyNonBlackPixels.
+bool HasBlackPixel(const std::vector<unsigned char>& bytes)
+{
+    for(size_t i = 0, c = bytes.size(); i + 2 < c; i += 3)
+    {
+        if((bytes[i] | bytes[i + 1] | bytes[i + 2]) == 0)
+            return true;
+    }
+    return false;
+}
+
+// One tile in the LOD pyramid. Leaves are tiles that already exist and have no
+// children on disk; every other node is a parent that may be (re)built once all
+// of its children have been handled.
+struct LodNode
+{
+    cognitics::cdb::TileInfo tileinfo;
+    std::string filename;
+    bool exists { false };
+    std::filesystem::file_time_type filetime;
+    LodNode* parent { nullptr };
+    std::vector<LodNode*> children;
+    int pending { 0 };
+    int height { 0 };       // LODs between this node and the finest tile under it
+    bool built { false };
+
+    // Output of a build, kept until the parent has consumed it.
+    std::vector<unsigned char> bytes;
+    std::vector<float> floats;
+};
+
+class LodScheduler;
+
+class LodJob : public ccl::Job
 {
 public:
-    TileJob(ccl::JobManager* manager, ccl::Job *owner = NULL) : Job(manager, owner) { }
+    LodJob(ccl::JobManager* manager, LodScheduler* scheduler, LodNode* node) : Job(manager, NULL), scheduler(scheduler), node(node) { }
 
     ccl::ObjLog log;
+    LodScheduler* scheduler;
+    LodNode* node;
+
+    virtual int execute(void);
+};
+
+// Builds the parent/child graph for every geocell of a dataset and runs it on a
+// single JobManager. A parent is submitted as soon as its last child completes,
+// so workers never wait on the rest of a level or on other geocells.
+class LodScheduler
+{
+public:
+    LodScheduler(const std::string& cdb, int workers, int minmax_lod_offset) : cdb(cdb), minmax_lod_offset(minmax_lod_offset), job_manager(workers) { }
+
     std::string cdb;
-    std::string filename;
-    std::vector<std::string> child_filenames;
+    int minmax_lod_offset;
+    std::map<std::string, std::unique_ptr<LodNode>> nodes;
+    std::vector<std::unique_ptr<LodJob>> jobs;
+    std::mutex mutex;
+    gdalsampler::SourceCatalog catalog;     // coverage tiles are shared by neighbouring parents
+    ccl::JobManager job_manager;
+
+    std::string FilenameForTileInfo(const cognitics::cdb::TileInfo& tileinfo) const
+    {
+        auto filename = cdb + "/Tiles/" + cognitics::cdb::FilePathForTileInfo(tileinfo) + "/" + cognitics::cdb::FileNameForTileInfo(tileinfo);
+        if(tileinfo.dataset == 1)
+            filename += ".tif";
+        if(tileinfo.dataset == 4)
+            filename += ".jp2";
+        return std::filesystem::path(filename).string();
+    }
+
+    LodNode* NodeForTileInfo(const cognitics::cdb::TileInfo& tileinfo)
+    {
+        auto filename = FilenameForTileInfo(tileinfo);
+        auto& node = nodes[filename];
+        if(!node)
+        {
+            node.reset(new LodNode());
+            node->tileinfo = tileinfo;
+            node->filename = filename;
+        }
+        return node.get();
+    }
+
+    void AddExistingTile(const cognitics::cdb::TileInfo& tileinfo, std::filesystem::file_time_type filetime)
+    {
+        auto node = NodeForTileInfo(tileinfo);
+        node->exists = true;
+        node->filetime = filetime;
+    }
+
+    // Link every existing tile to its ancestors down to LOD -10.
+    void Link()
+    {
+        auto existing = std::vector<LodNode*>();
+        for(auto& entry : nodes)
+            existing.push_back(entry.second.get());
+        for(auto node : existing)
+        {
+            while((node->parent == nullptr) && (node->tileinfo.lod > -10))
+            {
+                auto parent = NodeForTileInfo(cognitics::cdb::ParentTileInfo(node->tileinfo));
+                node->parent = parent;
+                parent->children.push_back(node);
+                ++parent->pending;
+                node = parent;
+            }
+        }
+        for(auto node : existing)
+        {
+            int height = 0;
+            for(auto parent = node->parent; parent != nullptr; parent = parent->parent)
+            {
+                if(parent->height > height)
+                    break;
+                parent->height = ++height;
+            }
+        }
+    }
+
+    // MinMaxElevation is kept minmax_lod_offset LODs below the finest elevation, as BuildMinMaxElevation places it.
+    bool WritesMinMax(const LodNode* node) const
+    {
+        return (minmax_lod_offset >= 0) && (node->height >= minmax_lod_offset);
+    }
 
-    virtual int execute(void)
+    void Complete(LodNode* node)
     {
-        auto stem = std::filesystem::path(filename).stem().string();
+        auto parent = node->parent;
+        if(parent == nullptr)
+            return;
+        LodJob* job = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--parent->pending > 0)
+                return;
+            jobs.emplace_back(new LodJob(&job_manager, this, parent));
+            job = jobs.back().get();
+        }
+        // Newly runnable parents go to the front so a subtree finishes (and frees its buffers) before more leaves start.
+        job_manager.submitJob(job);
+    }
+
+    void Run()
+    {
+        Link();
+        for(auto& entry : nodes)
+        {
+            if(entry.second->children.empty())
+                Complete(entry.second.get());
+        }
+        job_manager.waitForCompletion();
+    }
+
+    void Build(LodNode* node, ccl::ObjLog& log)
+    {
+        auto stem = std::filesystem::path(node->filename).stem().string();
+
+        // Children written this run are always used; otherwise only children newer than the existing parent.
+        auto memory_children = std::vector<LodNode*>();
+        auto disk_children = std::vector<LodNode*>();
+        for(auto child : node->children)
+        {
+            if(child->built)
+                memory_children.push_back(child);
+            else if(child->exists && (!node->exists || (child->filetime > node->filetime)))
+                disk_children.push_back(child);
+        }
+        if(memory_children.empty() && disk_children.empty())
+            return;
+
         log << "    " << stem << log.endl;
-        try
+
+        if(!ReduceChildren(node, memory_children, disk_children))
+            SampleChildren(node, memory_children, disk_children);
+        if(!node->built)
+            log << "    " << stem << " not written" << log.endl;
+
+        for(auto child : memory_children)
+        {
+            child->bytes = std::vector<unsigned char>();
+            child->floats = std::vector<float>();
+        }
+        if(!node->built || (node->parent == nullptr))
         {
-            auto errcode = std::error_code();
-            auto filetime = std::filesystem::last_write_time(filename, errcode);
-            if(!errcode)
+            node->bytes = std::vector<unsigned char>();
+            node->floats = std::vector<float>();
+        }
+    }
+
+    // When every child of the parent contributes, the parent is just a 2:1 reduction
+    // of aligned CDB tiles and nothing under it (coverage, the old parent) shows through.
+    // Returns false if the reduction doesn't fully cover the parent: an elevation
+    // sample with no valid input, or any black (no-data) imagery pixel in a child.
+    bool ReduceChildren(LodNode* node, const std::vector<LodNode*>& memory_children, const std::vector<LodNode*>& disk_children)
+    {
+        auto& tile_info = node->tileinfo;
+        size_t expected = (tile_info.lod >= 0) ? 4 : 1;
+        if(memory_children.size() + disk_children.size() != expected)
+            return false;
+
+        const float nodata = -32767.0f;
+        int dim = cognitics::cdb::TileDimensionForLod(tile_info.lod);
+        int channels = (tile_info.dataset == 4) ? 3 : 1;
+        auto bytes = std::vector<unsigned char>();
+        auto floats = std::vector<float>();
+        if(channels == 3)
+            bytes.resize(size_t(dim) * dim * 3);
+        else
+            floats.resize(size_t(dim) * dim);
+
+        auto children = memory_children;
+        children.insert(children.end(), disk_children.begin(), disk_children.end());
+        for(auto child : children)
+        {
+            int child_dim = cognitics::cdb::TileDimensionForLod(child->tileinfo.lod);
+            int reduced_dim = child_dim / 2;
+            if(reduced_dim * ((expected == 4) ? 2 : 1) != dim)
+                return false;
+
+            // Buffers are north-up; uref increases northward.
+            int row = 0;
+            int col = 0;
+            if(expected == 4)
             {
-                auto filtered_children = std::vector<std::string>();
-                for (auto child_filename : child_filenames)
-                {
-                    auto child_filetime = std::filesystem::last_write_time(child_filename);
-                    if(child_filetime > filetime)
-                        filtered_children.push_back(child_filename);
-                }
-                child_filenames = filtered_children;
+                row = (1 - (child->tileinfo.uref - (2 * tile_info.uref))) * reduced_dim;
+                col = (child->tileinfo.rref - (2 * tile_info.rref)) * reduced_dim;
             }
-            if(child_filenames.empty())
-                return 0;
-
-            auto tile_info = cognitics::cdb::TileInfoForFileName(stem);
-            double tile_north, tile_south, tile_east, tile_west;
-            std::tie(tile_north, tile_south, tile_east, tile_west) = cognitics::cdb::NSEWBoundsForTileInfo(tile_info);
-            auto coords = cognitics::cdb::CoordinatesRange(tile_west, tile_east, tile_south, tile_north);
-            auto tiles = cognitics::cdb::generate_tiles(coords, cognitics::cdb::Dataset((uint16_t)tile_info.dataset), tile_info.lod - 1);
-            for(auto& tile : tiles)
+            size_t offset = ((size_t(row) * dim) + col) * channels;
+
+            if(channels == 3)
             {
-                tile.setCs1(tile_info.selector1);
-                tile.setCs2(tile_info.selector2);
+                auto decoded = std::vector<unsigned char>();
+                if(!child->built)
+                    decoded = cognitics::cdb::BytesFromJP2(child->filename);
+                auto& child_bytes = child->built ? child->bytes : decoded;
+                if(child_bytes.size() != size_t(child_dim) * child_dim * 3)
+                    return false;
+                // The box filter would average black into its neighbours, so holes go to the sampler.
+                if(HasBlackPixel(child_bytes))
+                    return false;
+                ip::Reduce2x2_8u_C3(&child_bytes[0], child_dim * 3, &bytes[offset], reduced_dim, reduced_dim, dim * 3);
             }
-            auto coverage_tiles = cognitics::cdb::CoverageTilesForTiles(cdb, tiles);
-            auto coverage_filenames = std::vector<std::string>();
-            for (auto ctile : coverage_tiles)
+            else
             {
-                auto cdb = ctile.first;
-                auto tile = ctile.second;
-                auto tile_info = cognitics::cdb::TileInfoForTile(tile);
-                auto tile_filepath = cognitics::cdb::FilePathForTileInfo(tile_info);
-                auto tile_filename = cognitics::cdb::FileNameForTileInfo(tile_info);
-                auto filename = cdb + "/Tiles/" + tile_filepath + "/" + tile_filename;
-                if (tile_info.dataset == 1)
-                    filename += ".tif";
-                if (tile_info.dataset == 4)
-                    filename += ".jp2";
-                if (std::find(coverage_filenames.begin(), coverage_filenames.end(), filename) == coverage_filenames.end())
-                    coverage_filenames.push_back(filename);
+                auto decoded = std::vector<float>();
+                if(!child->built)
+                    decoded = cognitics::cdb::FloatsFromTIF(child->filename);
+                auto& child_floats = child->built ? child->floats : decoded;
+                if(child_floats.size() != size_t(child_dim) * child_dim)
+                    return false;
+                ip::Reduce2x2Mean_32f_C1(&child_floats[0], child_dim * sizeof(float), &floats[offset], reduced_dim, reduced_dim, dim * sizeof(float), nodata);
             }
+        }
+
+        // Holes in the children are filled from coverage by the sampler.
+        if(std::find(floats.begin(), floats.end(), nodata) != floats.end())
+            return false;
+
+        if(channels == 3)
+        {
+            node->bytes.swap(bytes);
+            node->built = cognitics::cdb::WriteImageryTile(cdb, tile_info, node->bytes);
+        }
+        else
+        {
+            node->floats.swap(floats);
+            node->built = cognitics::cdb::WriteElevationTile(cdb, tile_info, node->floats, WritesMinMax(node));
+        }
+        return true;
+    }
 
+    // Partial coverage: composite the children over the existing parent and any coverage
+    // from lower LODs or older versions with a GDALRasterSampler.
+    void SampleChildren(LodNode* node, const std::vector<LodNode*>& memory_children, std::vector<LodNode*> disk_children)
+    {
+        auto& tile_info = node->tileinfo;
+        double tile_north, tile_south, tile_east, tile_west;
+        std::tie(tile_north, tile_south, tile_east, tile_west) = cognitics::cdb::NSEWBoundsForTileInfo(tile_info);
+        auto coords = cognitics::cdb::CoordinatesRange(tile_west, tile_east, tile_south, tile_north);
+        auto tiles = cognitics::cdb::generate_tiles(coords, cognitics::cdb::Dataset((uint16_t)tile_info.dataset), tile_info.lod - 1);
+        for(auto& tile : tiles)
+        {
+            tile.setCs1(tile_info.selector1);
+            tile.setCs2(tile_info.selector2);
+        }
+        auto coverage_tiles = cognitics::cdb::CoverageTilesForTiles(cdb, tiles);
+        auto coverage_filenames = std::vector<std::string>();
+        for(auto ctile : coverage_tiles)
+        {
+            auto coverage_cdb = ctile.first;
+            auto coverage_info = cognitics::cdb::TileInfoForTile(ctile.second);
+            auto filename = coverage_cdb + "/Tiles/" + cognitics::cdb::FilePathForTileInfo(coverage_info) + "/" + cognitics::cdb::FileNameForTileInfo(coverage_info);
+            if(coverage_info.dataset == 1)
+                filename += ".tif";
+            if(coverage_info.dataset == 4)
+                filename += ".jp2";
+            if(std::find(coverage_filenames.begin(), coverage_filenames.end(), filename) == coverage_filenames.end())
+                coverage_filenames.push_back(filename);
+        }
+
+        // Children built in this run are handed over as uncompressed in-memory
+        // GeoTIFFs rather than decoded again from the tiles just written.
+        auto memory_filenames = std::vector<std::string>();
+        for(auto child : memory_children)
+        {
+            auto child_stem = std::filesystem::path(child->filename).stem().string();
+            auto memory_filename = "/vsimem/cdb_lod/" + child_stem + ".tif";
+            auto info = cognitics::cdb::RasterInfoFromTileInfo(child->tileinfo);
+            bool written = false;
+            if(tile_info.dataset == 1)
+                written = cognitics::cdb::WriteFloatsToTIF(memory_filename, info, child->floats);
+            if(tile_info.dataset == 4)
+                written = cognitics::cdb::WriteBytesToTIF(memory_filename, info, child->bytes);
+            if(written)
+                memory_filenames.push_back(memory_filename);
+            else
+                disk_children.push_back(child);
+        }
 
+        {
             GDALRasterSampler sampler;
-            for (auto coverage_filename : coverage_filenames)
+            sampler.SetCatalog(&catalog);
+            for(auto coverage_filename : coverage_filenames)
                 sampler.AddFile(coverage_filename);
-            for (auto child_filename : child_filenames)
-                sampler.AddFile(child_filename);
+            for(auto child : disk_children)
+                sampler.AddFile(child->filename);
+            for(auto memory_filename : memory_filenames)
+                sampler.AddFile(memory_filename);
             if(tile_info.dataset == 1)
-                cognitics::cdb::BuildElevationTileFromSampler(cdb, sampler, tile_info);
+            {
+                node->built = cognitics::cdb::SampleElevationTile(cdb, sampler, tile_info, node->floats)
+                    && cognitics::cdb::WriteElevationTile(cdb, tile_info, node->floats, WritesMinMax(node));
+            }
             if(tile_info.dataset == 4)
-                cognitics::cdb::BuildImageryTileFromSampler(cdb, sampler, tile_info);
+            {
+                node->built = cognitics::cdb::SampleImageryTile(cdb, sampler, tile_info, node->bytes)
+                    && cognitics::cdb::WriteImageryTile(cdb, tile_info, node->bytes);
+            }
+
+            // The worker's block cache points into this sampler's files.
             gdalsampler::CacheManager::getInstance()->Unload();
         }
-        catch(std::exception& e)
-        {
-            log << "      EXCEPTION: " << e.what() << log.endl;
-        }
-        return 0;
+
+        for(auto memory_filename : memory_filenames)
+            VSIUnlink(memory_filename.c_str());
     }
 
 };
 
+int LodJob::execute(void)
+{
+    try
+    {
+        scheduler->Build(node, log);
+    }
+    catch(std::exception& e)
+    {
+        log << "      EXCEPTION: " << e.what() << log.endl;
+    }
+    scheduler->Complete(node);
+    return 0;
+}
 
 }
 
@@ -122,10 +408,14 @@ bool cdb_lod(const std::string& cdb, int workers)
     return result;
 }
 
-bool cdb_lod(const std::string& cdb, int dataset, int cs1, int cs2, int workers)
+bool cdb_lod(const std::string& cdb, int dataset, int cs1, int cs2, int workers, int minmax_lod_offset)
 {
     ccl::ObjLog log;
+    CDBTileIndex::Instance().SetWritable(cdb);
 
+    LodScheduler scheduler(cdb, workers, minmax_lod_offset);
+
+    std::string extension = (dataset == 1) ? ".tif" : ".jp2";
     auto geocells = GeocellsForCdb(cdb);
     for(auto geocell : geocells)
     {
@@ -133,88 +423,34 @@ bool cdb_lod(const std::string& cdb, int dataset, int cs1, int cs2, int workers)
         int lat = LatitudeFromSubdirectory(geocell.first);
         int lon = LongitudeFromSubdirectory(geocell.second);
         auto dataset_path = geocell_path + "/" + DatasetSubdirectory(dataset);
-        auto max_lod = MaxLodForDatasetPath(dataset_path);
-        for(int target_lod = max_lod; target_lod > -10; --target_lod)
-        {
-            ccl::JobManager job_manager(workers);
-
-            auto lod_path = dataset_path + "/" + SubdirectoryForLOD(target_lod);
-            auto parent_path = dataset_path + "/" + SubdirectoryForLOD(target_lod - 1);
-            log << parent_path << log.endl;
-
-            auto lod_files = std::vector<std::string>();
-            {
-                std::error_code ec;
-                auto tmp_files = std::vector<std::string>();
-                for(const auto& entry : std::filesystem::recursive_directory_iterator(lod_path,ec))
-                {
-                    if(std::filesystem::is_regular_file(entry))
-                        tmp_files.push_back(entry.path().string());
-                }
-                for(auto tmp_file : tmp_files)
-                {
-                    try
-                    {
-                        auto ti = TileInfoForFileName(std::filesystem::path(tmp_file).stem().string());
-                        if((ti.latitude == lat) && (ti.longitude == lon) && (ti.lod == target_lod) && (ti.selector1 == cs1) && (ti.selector2 == cs2))
-                            lod_files.push_back(tmp_file);
-                    }
-                    catch(std::exception &)
-                    {
-                    }
-                }
-            }
+        log << dataset_path << log.endl;
 
-            auto parent_files = std::vector<std::string>();
-            {
-                std::error_code ec;
-                for(const auto& entry : std::filesystem::recursive_directory_iterator(parent_path, ec))
-                {
-                    if(std::filesystem::is_regular_file(entry))
-                        parent_files.push_back(entry.path().string());
-                }
-            }
-
-            auto lod_files_by_parent = std::map<std::string, std::vector<std::string>>();
-
-            for(auto lod_file : lod_files)
+        std::error_code ec;
+        for(const auto& entry : std::filesystem::recursive_directory_iterator(dataset_path, ec))
+        {
+            if(!std::filesystem::is_regular_file(entry))
+                continue;
+            if(entry.path().extension().string() != extension)
+                continue;
+            try
             {
-                auto tile_info = TileInfoForFileName(std::filesystem::path(lod_file).stem().string());
-                auto parent_info = tile_info;
-                parent_info.lod -= 1;
-                parent_info.uref /= 2;
-                parent_info.rref /= 2;
-                auto parent_file = cdb + "/Tiles/" + FilePathForTileInfo(parent_info) + "/" + FileNameForTileInfo(parent_info);
-                parent_file = std::filesystem::path(parent_file).string();
-                if (tile_info.dataset == 1)
-                    parent_file += ".tif";
-                if (tile_info.dataset == 4)
-                    parent_file += ".jp2";
-                lod_files_by_parent[parent_file].push_back(lod_file);
+                auto ti = TileInfoForFileName(entry.path().stem().string());
+                if((ti.latitude != lat) || (ti.longitude != lon) || (ti.dataset != dataset) || (ti.selector1 != cs1) || (ti.selector2 != cs2))
+                    continue;
+                if(ti.lod < -10)
+                    continue;
+                scheduler.AddExistingTile(ti, std::filesystem::last_write_time(entry.path()));
             }
-
-            auto jobs = std::vector<TileJob*>();
-
-            for(const auto& entry : lod_files_by_parent)
+            catch(std::exception &)
             {
-                auto parent_file = entry.first;
-                auto child_files = entry.second;
-                jobs.push_back(new TileJob(&job_manager));
-                auto job = jobs.back();
-                job->cdb = cdb;
-                job->filename = parent_file;
-                job->child_filenames = child_files;
-                job_manager.submitJob(job);
             }
-
-            job_manager.waitForCompletion();
-            for(auto job : jobs)
-                delete job;
         }
     }
 
+    scheduler.Run();
     return true;
 }
 
 }
 }
+
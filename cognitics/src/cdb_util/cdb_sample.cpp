@@ -2,6 +2,7 @@
 #include <cdb_util/cdb_sample.h>
 
 #include <cdb_util/cdb_util.h>
+#include <cdb_util/CDBTileIndex.h>
 
 #include <ccl/FileInfo.h>
 
@@ -23,6 +24,51 @@ namespace std { namespace filesystem = std::experimental::filesystem; }
 namespace cognitics {
 namespace cdb {
 
+struct CoverageSamplerCache::Entry
+{
+    std::mutex mutex;
+    bool ready { false };
+    GDALRasterSampler sampler;
+};
+
+std::shared_ptr<CoverageSamplerCache::Entry> CoverageSamplerCache::Get(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if(it != entries.end())
+    {
+        lru.splice(lru.begin(), lru, it->second.second);
+        return it->second.first;
+    }
+    auto entry = std::make_shared<Entry>();
+    lru.push_front(key);
+    entries[key] = std::make_pair(entry, lru.begin());
+    while(entries.size() > capacity)
+    {
+        // samplers still in use are released by their last holder
+        entries.erase(lru.back());
+        lru.pop_back();
+    }
+    return entry;
+}
+
+void CoverageSamplerCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru.clear();
+}
+
+void CoverageSamplerCache::Validate(uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(generation == this->generation)
+        return;
+    this->generation = generation;
+    entries.clear();
+    lru.clear();
+}
+
 bool cdb_sample(cdb_sample_parameters& params)
 {
     auto pixel_size_x = std::abs((params.east - params.west) / params.width);
@@ -152,11 +198,11 @@ std::vector<unsigned char> cdb_sample_imagery(cdb_sample_parameters& params)
                 unsigned char g = params.blue_marble[bm_offset + 1];
                 unsigned char b = params.blue_marble[bm_offset + 2];
                 unsigned char a = 255;
-                if(!params.population.empty())
+                if(params.population && !params.population->empty())
                 {
                     int ilat = 90 + std::floor(lat);
                     int ilon = 180 + std::floor(lon);
-                    if(params.population.at((ilat * 360) + ilon) > 0)
+                    if(params.population->at((ilat * 360) + ilon) > 0)
                     {
                         r = std::min<int>(r + 96, 255);
                         b = std::min<int>(b + 96, 255);
@@ -176,28 +222,57 @@ std::vector<unsigned char> cdb_sample_imagery(cdb_sample_parameters& params)
 
     auto coords = cognitics::cdb::CoordinatesRange(params.west, params.east, params.south, params.north);
     auto tiles = cognitics::cdb::generate_tiles(coords, cognitics::cdb::Dataset((uint16_t)params.dataset), target_lod);
-    auto coverage_tiles = cognitics::cdb::CoverageTilesForTiles(params.cdb, tiles);
 
-    GDALRasterSampler sampler;
-    for(auto ctile : coverage_tiles)
+    // Pick up tiles written by other processes since the index was built.
+    auto& tile_index = CDBTileIndex::Instance();
+    for(auto version : tile_index.VersionChain(params.cdb))
+        tile_index.RefreshIfStale(version, params.dataset);
+
+    auto entry = std::shared_ptr<CoverageSamplerCache::Entry>();
+    if(params.samplers)
     {
-        auto cdb = ctile.first;
-        auto tile = ctile.second;
-        auto tile_info = cognitics::cdb::TileInfoForTile(tile);
-        auto tile_filepath = cognitics::cdb::FilePathForTileInfo(tile_info);
-        auto tile_filename = cognitics::cdb::FileNameForTileInfo(tile_info);
-        auto filename = cdb + "/Tiles/" + tile_filepath + "/" + tile_filename;
-        if(tile_info.dataset == 1)
-            filename += ".tif";
-        if(tile_info.dataset == 4)
-            filename += ".jp2";
-        sampler.AddFile(filename);
-        ccl::Log::instance()->write(ccl::LDEBUG, "  " + filename);
+        auto key = params.cdb + "|" + std::to_string(params.dataset) + "|" + std::to_string(target_lod);
+        for(auto& tile : tiles)
+            key += "|" + FileNameForTileInfo(TileInfoForTile(tile));
+        entry = params.samplers->Get(key);
+    }
+    else
+    {
+        entry = std::make_shared<CoverageSamplerCache::Entry>();
+    }
+
+    // GDAL datasets aren't safe to share between threads; concurrent requests for the same tiles take turns.
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    auto& sampler = entry->sampler;
+    if(!entry->ready)
+    {
+        auto coverage_tiles = cognitics::cdb::CoverageTilesForTiles(params.cdb, tiles);
+        for(auto ctile : coverage_tiles)
+        {
+            auto cdb = ctile.first;
+            auto tile = ctile.second;
+            auto tile_info = cognitics::cdb::TileInfoForTile(tile);
+            auto tile_filepath = cognitics::cdb::FilePathForTileInfo(tile_info);
+            auto tile_filename = cognitics::cdb::FileNameForTileInfo(tile_info);
+            auto filename = cdb + "/Tiles/" + tile_filepath + "/" + tile_filename;
+            if(tile_info.dataset == 1)
+                filename += ".tif";
+            if(tile_info.dataset == 4)
+                filename += ".jp2";
+            sampler.AddFile(filename);
+            ccl::Log::instance()->write(ccl::LDEBUG, "  " + filename);
+        }
+        entry->ready = true;
     }
 
     bytes = cognitics::cdb::FlippedVertically(bytes, raster_info.Width, raster_info.Height, 3);
     bool result = sampler.Sample(extents, &bytes[0]);
     bytes = cognitics::cdb::FlippedVertically(bytes, raster_info.Width, raster_info.Height, 3);
+
+    // This thread's block cache points into the sampler's files, which may be released by another thread.
+    // Shared blocks are dropped by the file itself, so they are kept for the next request.
+    if(params.samplers && !gdalsampler::SharedBlockCache::getInstance()->IsEnabled())
+        gdalsampler::CacheManager::getInstance()->Unload();
     return bytes;
 }
 
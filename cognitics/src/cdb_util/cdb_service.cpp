@@ -3,13 +3,22 @@
 
 #include <cdb_util/cdb_util.h>
 #include <cdb_util/cdb_sample.h>
+#include <cdb_util/CDBTileIndex.h>
 #include <ip/jpgwrapper.h>
 
 #include <civetweb/CivetServer.h>
 
+#include <ccl/FileInfo.h>
+
+#include <cmath>
 #include <cstdlib>
+#include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <functional>
 
 #include <png.h>
@@ -38,6 +47,307 @@ std::string WebResponse404()
 }
 
 
+// Encoded GetMap responses keyed by their normalised request. Entries are evicted
+// least recently used first once the memory budget is exceeded; with a directory set,
+// responses are also written there so entries evicted from memory can be read back.
+// Everything, on disk too, is dropped when the CDB changes. The directory holds a stamp
+// naming the CDB state its files were rendered from, so a restart against the same,
+// unchanged CDB keeps them.
+class WMSResponseCache
+{
+public:
+    typedef std::shared_ptr<const std::vector<unsigned char>> Response;
+
+    void Configure(size_t budget, const std::string& directory)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->budget = budget;
+        this->directory = directory;
+        if(!directory.empty())
+            ccl::makeDirectory(directory);
+    }
+
+    bool Find(const std::string& key, Response& response, std::string& etag)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if(it != entries.end())
+            {
+                lru.splice(lru.begin(), lru, it->second.lru);
+                response = it->second.response;
+                etag = it->second.etag;
+                return true;
+            }
+            if(directory.empty())
+                return false;
+        }
+        std::ifstream f(FilenameForKey(key), std::ios::binary);
+        if(!f)
+            return false;
+        auto bytes = std::vector<unsigned char>((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        if(bytes.empty())
+            return false;
+        response = std::make_shared<const std::vector<unsigned char>>(std::move(bytes));
+        etag = ETagForResponse(*response);
+        Remember(key, response, etag);
+        return true;
+    }
+
+    std::string Insert(const std::string& key, const Response& response)
+    {
+        auto etag = ETagForResponse(*response);
+        Remember(key, response, etag);
+        std::string dir;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dir = directory;
+        }
+        if(!dir.empty())
+        {
+            auto filename = FilenameForKey(key);
+            auto tmp_filename = filename + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            {
+                std::ofstream f(tmp_filename, std::ios::binary);
+                f.write((const char*)response->data(), response->size());
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmp_filename, filename, ec);
+            if(ec)
+                std::remove(tmp_filename.c_str());
+        }
+        return etag;
+    }
+
+    void Clear()
+    {
+        std::string dir;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+            lru.clear();
+            bytes = 0;
+            dir = directory;
+        }
+        if(dir.empty())
+            return;
+        ClearDirectory(dir);
+    }
+
+    // Starts serving the CDB described by stamp, as of the tile index generation given.
+    // Memory is always dropped; files on disk are kept if they were written for stamp.
+    void Open(const std::string& stamp, uint64_t generation)
+    {
+        std::string dir;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+            lru.clear();
+            bytes = 0;
+            this->generation = generation;
+            dir = directory;
+        }
+        if(dir.empty())
+            return;
+        std::ifstream f(dir + "/cache.stamp", std::ios::binary);
+        auto previous = std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        if(f && (previous == stamp))
+            return;
+        ClearDirectory(dir);
+        SetStamp(stamp);
+    }
+
+    void SetStamp(const std::string& stamp)
+    {
+        std::string dir;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dir = directory;
+        }
+        if(dir.empty())
+            return;
+        std::ofstream f(dir + "/cache.stamp", std::ios::binary | std::ios::trunc);
+        f << stamp;
+    }
+
+    // Clears the cache if the tile index generation changed since the last call.
+    // Returns true if it did.
+    bool Validate(uint64_t generation)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(generation == this->generation)
+                return false;
+            this->generation = generation;
+        }
+        Clear();
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        Response response;
+        std::string etag;
+        std::list<std::string>::iterator lru;
+    };
+
+    std::mutex mutex;
+    size_t budget { 0 };
+    size_t bytes { 0 };
+    uint64_t generation { 0 };
+    std::string directory;
+    std::map<std::string, Entry> entries;
+    std::list<std::string> lru;
+
+    static void ClearDirectory(const std::string& dir)
+    {
+        // Only files named by FilenameForKey() and the stamp; anything else in the directory is left alone.
+        std::remove((dir + "/cache.stamp").c_str());
+        auto ec = std::error_code();
+        for(auto it = std::filesystem::directory_iterator(dir, ec); !ec && (it != std::filesystem::directory_iterator()); it.increment(ec))
+        {
+            auto path = it->path();
+            auto stem = path.stem().string();
+            if((path.extension().string() != ".png") || (stem.size() != 16) || (stem.find_first_not_of("0123456789abcdef") != std::string::npos))
+                continue;
+            auto remove_ec = std::error_code();
+            std::filesystem::remove(path, remove_ec);
+        }
+    }
+
+    static uint64_t Hash(const unsigned char* data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ULL;    // FNV-1a
+        for(size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    static std::string Hex(uint64_t value)
+    {
+        auto ss = std::stringstream();
+        ss << std::hex << std::setw(16) << std::setfill('0') << value;
+        return ss.str();
+    }
+
+    static std::string ETagForResponse(const std::vector<unsigned char>& response)
+    {
+        return "\"" + Hex(Hash(response.data(), response.size())) + "\"";
+    }
+
+    std::string FilenameForKey(const std::string& key)
+    {
+        return directory + "/" + Hex(Hash((const unsigned char*)key.data(), key.size())) + ".png";
+    }
+
+    void Remember(const std::string& key, const Response& response, const std::string& etag)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(response->size() > budget)
+            return;
+        if(entries.find(key) != entries.end())
+            return;
+        lru.push_front(key);
+        entries[key] = Entry { response, etag, lru.begin() };
+        bytes += response->size();
+        while(bytes > budget)
+        {
+            auto it = entries.find(lru.back());
+            bytes -= it->second.response->size();
+            entries.erase(it);
+            lru.pop_back();
+        }
+    }
+};
+
+// The imagery tiles of every version the service reads, as the response cache stamp.
+std::string CacheStampForCDB(const std::string& cdb)
+{
+    auto& tile_index = CDBTileIndex::Instance();
+    auto ss = std::stringstream();
+    for(auto version : tile_index.VersionChain(cdb))
+        ss << version << " " << std::hex << tile_index.Fingerprint(version, 4) << "\n";
+    return ss.str();
+}
+
+// Picks up tiles written by other processes and, if the CDB changed, drops what was
+// cached from it. Called before a request looks in either cache.
+void ValidateCaches(const std::string& cdb, int dataset, WMSResponseCache& responses, CoverageSamplerCache& samplers)
+{
+    auto& tile_index = CDBTileIndex::Instance();
+    for(auto version : tile_index.VersionChain(cdb))
+        tile_index.RefreshIfStale(version, dataset);
+    auto generation = tile_index.Generation();
+    if(responses.Validate(generation))
+        responses.SetStamp(CacheStampForCDB(cdb));
+    samplers.Validate(generation);
+}
+
+void png_write(png_structp  png_ptr, png_bytep data, png_size_t length)
+{
+    std::vector<unsigned char> *p = (std::vector<unsigned char>*)png_get_io_ptr(png_ptr);
+    p->insert(p->end(), data, data + length);
+}
+
+std::vector<unsigned char> PNGFromRGB(int width, int height, const std::vector<unsigned char>& bytes)
+{
+    auto result = std::vector<unsigned char>();
+    auto write_struct = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    auto info_struct = png_create_info_struct(write_struct);
+    if(write_struct && info_struct)
+    {
+        if(setjmp(png_jmpbuf(write_struct)) == 0)
+        {
+            png_set_IHDR(write_struct, info_struct, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+            std::vector<unsigned char*> rows(height);
+            for (size_t y = 0; y < height; ++y)
+                rows[y] = (unsigned char *)&bytes[0] + (y * width * 3);
+            // favour encode speed; these are viewed once and cached, not archived
+            png_set_compression_level(write_struct, 1);
+            png_set_filter(write_struct, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+            png_set_rows(write_struct, info_struct, &rows[0]);
+            png_set_write_fn(write_struct, (png_voidp)&result, png_write, NULL);
+            png_write_png(write_struct, info_struct, PNG_TRANSFORM_IDENTITY, NULL);
+        }
+    }
+    png_destroy_write_struct(&write_struct, &info_struct);
+    return result;
+}
+
+// Writes a cached response, or 304 if the client already has it. The body is written
+// straight from the cache buffer.
+bool WriteCachedResponse(mg_connection* connection, const std::string& content_type, const WMSResponseCache::Response& response, const std::string& etag)
+{
+    auto if_none_match = mg_get_header(connection, "If-None-Match");
+    if(if_none_match && ((std::string(if_none_match).find(etag) != std::string::npos) || (std::string(if_none_match) == "*")))
+    {
+        auto ss = std::stringstream();
+        ss << "HTTP/1.1 304 Not Modified\r\n";
+        ss << "ETag: " << etag << "\r\n";
+        ss << "Cache-Control: no-cache\r\n";
+        ss << "\r\n";
+        auto str = ss.str();
+        mg_write(connection, str.c_str(), str.size());
+        return true;
+    }
+
+    auto ss = std::stringstream();
+    ss << "HTTP/1.1 200 OK\r\n";
+    ss << "Content-Type: " << content_type << "\r\n";
+    ss << "Content-Length: " << response->size() << "\r\n";
+    ss << "ETag: " << etag << "\r\n";
+    ss << "Cache-Control: no-cache\r\n";
+    ss << "\r\n";
+    auto str = ss.str();
+    mg_write(connection, str.c_str(), str.size());
+    mg_write(connection, response->data(), response->size());
+    return true;
+}
+
 class CDBRequest
 {
 public:
@@ -121,9 +431,11 @@ class WMSRequestHandler
     CDBRequest cdb_request;
     const unsigned char* blue_marble { nullptr };
     const std::vector<unsigned char>& population;
+    WMSResponseCache& responses;
+    CoverageSamplerCache& samplers;
 
-    WMSRequestHandler(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population)
-        : cdb_request(cdb, server, connection), blue_marble(blue_marble), population(population) { };
+    WMSRequestHandler(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population, WMSResponseCache& responses, CoverageSamplerCache& samplers)
+        : cdb_request(cdb, server, connection), blue_marble(blue_marble), population(population), responses(responses), samplers(samplers) { };
 
     void Write(const std::string& str)
     {
@@ -269,50 +581,6 @@ class WMSRequestHandler
         return true;
     }
 
-    static void png_write(png_structp  png_ptr, png_bytep data, png_size_t length)
-    {
-        std::vector<unsigned char> *p = (std::vector<unsigned char>*)png_get_io_ptr(png_ptr);
-        p->insert(p->end(), data, data + length);
-    }
-
-    std::vector<unsigned char> RGBAFromRGB(const std::vector<unsigned char>& bytes)
-    {
-        auto result = std::vector<unsigned char>(bytes.size() * 4 / 3);
-        for(size_t i = 0, c = bytes.size() / 3; i < c; ++i)
-        {
-            result[(i * 4) + 0] = bytes[(i * 3) + 0];
-            result[(i * 4) + 1] = bytes[(i * 3) + 1];
-            result[(i * 4) + 2] = bytes[(i * 3) + 2];
-            result[(i * 4) + 3] = 255;
-        }
-        return result;
-    }
-
-    std::vector<unsigned char> PNGFromRGB(const cdb_sample_parameters& params, const std::vector<unsigned char>& bytes)
-    {
-        auto result = std::vector<unsigned char>();
-        auto write_struct = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-        auto info_struct = png_create_info_struct(write_struct);
-        if(write_struct && info_struct)
-        {
-            if(setjmp(png_jmpbuf(write_struct)) == 0)
-            {
-                png_set_IHDR(write_struct, info_struct, params.width, params.height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-                //png_set_IHDR(write_struct, info_struct, params.width, params.height, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-                std::vector<unsigned char*> rows(params.height);
-                //auto rgba = RGBAFromRGB(bytes);
-                for (size_t y = 0; y < params.height; ++y)
-                    rows[y] = (unsigned char *)&bytes[0] + (y * params.width * 3);
-                    //rows[y] = (unsigned char *)&rgba[0] + (y * params.width * 4);
-                png_set_rows(write_struct, info_struct, &rows[0]);
-                png_set_write_fn(write_struct, (png_voidp)&result, png_write, NULL);
-                png_write_png(write_struct, info_struct, PNG_TRANSFORM_IDENTITY, NULL);
-            }
-        }
-        png_destroy_write_struct(&write_struct, &info_struct);
-        return result;
-    }
-
     bool RespondGetMap()
     {
         auto sample_params = cdb_sample_parameters();
@@ -347,23 +615,39 @@ class WMSRequestHandler
         if(cdb_request.query_map.find("height") == cdb_request.query_map.end())
             return RespondError("No HEIGHT parameter specified");
         sample_params.height = std::stoi(cdb_request.query_map["height"]);
+        if((sample_params.width <= 0) || (sample_params.height <= 0))
+            return RespondError("Invalid WIDTH/HEIGHT requested");
         sample_params.cdb = cdb_request.cdb;
         sample_params.blue_marble = blue_marble;
-        sample_params.population = population;
-
-        auto bytes = cdb_sample_imagery(sample_params);
-        if(bytes.empty())
-            return RespondError("No data");
+        sample_params.population = &population;
+        sample_params.samplers = &samplers;
+
+        ValidateCaches(cdb_request.cdb, sample_params.dataset, responses, samplers);
+        auto key = KeyForSampleParameters(layers, sample_params);
+        auto response = WMSResponseCache::Response();
+        auto etag = std::string();
+        if(!responses.Find(key, response, etag))
+        {
+            auto bytes = cdb_sample_imagery(sample_params);
+            if(bytes.empty())
+                return RespondError("No data");
+            response = std::make_shared<const std::vector<unsigned char>>(PNGFromRGB(sample_params.width, sample_params.height, bytes));
+            etag = responses.Insert(key, response);
+        }
 
-        auto png = PNGFromRGB(sample_params, bytes);
+        return WriteCachedResponse(cdb_request.connection, "image/png", response, etag);
+    }
 
+    // Bounds after CRS axis order is applied, in thousandths of a pixel, so equivalent BBOX spellings share an entry.
+    std::string KeyForSampleParameters(const std::string& layers, const cdb_sample_parameters& params)
+    {
+        auto step_x = std::abs(params.east - params.west) / (params.width * 1000.0);
+        auto step_y = std::abs(params.north - params.south) / (params.height * 1000.0);
+        auto rounded = [](double value, double step) { return (step > 0.0) ? std::llround(value / step) : 0LL; };
         auto ss = std::stringstream();
-        ss << "HTTP/1.1 200 OK\r\n";
-        ss << "Content-Type: image/png\r\n";
-        ss << "\r\n";
-        Write(ss.str());
-        mg_write(cdb_request.connection, png.data(), png.size());
-        return true;
+        ss << params.cdb << "|" << layers << "|" << params.width << "x" << params.height;
+        ss << "|" << rounded(params.north, step_y) << "," << rounded(params.south, step_y) << "," << rounded(params.east, step_x) << "," << rounded(params.west, step_x);
+        return ss.str();
     }
 
     bool Execute()
@@ -387,31 +671,348 @@ class WMSRequestHandler
 
 public:
 
-    static bool HandleRequest(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population)
+    static bool HandleRequest(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population, WMSResponseCache& responses, CoverageSamplerCache& samplers)
     {
-        auto handler = WMSRequestHandler { cdb, server, connection, blue_marble, population };
+        auto handler = WMSRequestHandler { cdb, server, connection, blue_marble, population, responses, samplers };
         return handler.Execute();
     }
 
 };
 
-class WMSHandler : public CivetHandler
+////////////////////////////////////////////////////////////////////////////////
+
+// Pre-tiled imagery on a fixed EPSG:4326 grid that lines up with CDB tiles:
+// at LOD >= 0 a grid tile is 1/2^lod degrees and 1024 pixels, below that it is a
+// geocell at TileDimensionForLod() pixels. Rows count down from 90N and columns
+// east from 180W, as in WMTS and OpenLayers. Served as
+//   /tiles/{lod}/{row}/{col}.png|jpg
+//   /wmts?SERVICE=WMTS&REQUEST=GetTile&TILEMATRIX={lod}&TILEROW={row}&TILECOL={col}&FORMAT=image/png
+// Where the grid tile is an existing CDB tile (one degree wide geocells), the JP2
+// is transcoded once and cached; anywhere else it is sampled like GetMap.
+class TileRequestHandler
 {
+    CDBRequest cdb_request;
     const unsigned char* blue_marble { nullptr };
+    const std::vector<unsigned char>& population;
+    WMSResponseCache& responses;
+    CoverageSamplerCache& samplers;
+
+    static const int MinLod = -10;
+    static const int MaxLod = 23;
+
+    TileRequestHandler(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population, WMSResponseCache& responses, CoverageSamplerCache& samplers)
+        : cdb_request(cdb, server, connection), blue_marble(blue_marble), population(population), responses(responses), samplers(samplers) { };
+
+    void Write(const std::string& str)
+    {
+        mg_write(cdb_request.connection, str.c_str(), str.size());
+    }
+
+    bool Respond404()
+    {
+        Write(WebResponse404());
+        return true;
+    }
+
+    static int64_t TilesPerDegree(int lod)
+    {
+        return (lod > 0) ? (int64_t(1) << lod) : 1;
+    }
+
+    static std::tuple<double, double, double, double> NSEWBoundsForGridTile(int lod, int64_t row, int64_t col)
+    {
+        double size = 1.0 / TilesPerDegree(lod);
+        double north = 90.0 - (row * size);
+        double west = -180.0 + (col * size);
+        return std::make_tuple(north, north - size, west + size, west);
+    }
+
+    // The CDB tile with exactly the same footprint, if geocells at this latitude are one degree wide.
+    static bool TileInfoForGridTile(int lod, int64_t row, int64_t col, TileInfo& tileinfo)
+    {
+        auto n = TilesPerDegree(lod);
+        auto south_row = (180 * n) - 1 - row;
+        tileinfo.latitude = int(south_row / n) - 90;
+        tileinfo.longitude = int(col / n) - 180;
+        if(get_tile_width(double(tileinfo.latitude)) != 1)
+            return false;
+        tileinfo.dataset = 4;
+        tileinfo.selector1 = 1;
+        tileinfo.selector2 = 1;
+        tileinfo.lod = lod;
+        tileinfo.uref = int(south_row % n);
+        tileinfo.rref = int(col % n);
+        return true;
+    }
+
+    std::vector<unsigned char> TranscodeCDBTile(const TileInfo& tileinfo)
+    {
+        auto& tile_index = CDBTileIndex::Instance();
+        for(auto version : tile_index.VersionChain(cdb_request.cdb))
+        {
+            if(!tile_index.Exists(version, tileinfo))
+                continue;
+            auto filename = version + "/Tiles/" + FilePathForTileInfo(tileinfo) + "/" + FileNameForTileInfo(tileinfo) + ".jp2";
+            return BytesFromJP2(filename);
+        }
+        return std::vector<unsigned char>();
+    }
+
+    std::vector<unsigned char> SampleGridTile(int lod, int64_t row, int64_t col)
+    {
+        auto sample_params = cdb_sample_parameters();
+        std::tie(sample_params.north, sample_params.south, sample_params.east, sample_params.west) = NSEWBoundsForGridTile(lod, row, col);
+        sample_params.width = TileDimensionForLod(lod);
+        sample_params.height = sample_params.width;
+        sample_params.dataset = 4;
+        sample_params.cdb = cdb_request.cdb;
+        sample_params.blue_marble = blue_marble;
+        sample_params.population = &population;
+        sample_params.samplers = &samplers;
+        return cdb_sample_imagery(sample_params);
+    }
+
+    bool RespondTile(int lod, int64_t row, int64_t col, const std::string& format)
+    {
+        if((lod < MinLod) || (lod > MaxLod))
+            return Respond404();
+        auto n = TilesPerDegree(lod);
+        if((row < 0) || (row >= 180 * n) || (col < 0) || (col >= 360 * n))
+            return Respond404();
+        bool jpeg = (format == "jpg") || (format == "jpeg") || (format == "image/jpeg");
+        bool png = (format == "png") || (format == "image/png");
+        if(!jpeg && !png)
+            return Respond404();
+
+        ValidateCaches(cdb_request.cdb, 4, responses, samplers);
+        auto key = "tile|" + cdb_request.cdb + "|" + std::to_string(lod) + "/" + std::to_string(row) + "/" + std::to_string(col) + (jpeg ? ".jpg" : ".png");
+        auto response = WMSResponseCache::Response();
+        auto etag = std::string();
+        if(!responses.Find(key, response, etag))
+        {
+            int dim = TileDimensionForLod(lod);
+            auto bytes = std::vector<unsigned char>();
+            auto tileinfo = TileInfo();
+            if(TileInfoForGridTile(lod, row, col, tileinfo))
+                bytes = TranscodeCDBTile(tileinfo);
+            if(bytes.size() != size_t(dim) * dim * 3)
+                bytes = SampleGridTile(lod, row, col);
+            if(bytes.size() != size_t(dim) * dim * 3)
+                return Respond404();
+
+            auto encoded = std::vector<unsigned char>();
+            if(jpeg)
+            {
+                auto info = ip::ImageInfo();
+                info.width = dim;
+                info.height = dim;
+                info.depth = 3;
+                if(!ip::EncodeJPG24(info, bytes.data(), encoded))
+                    return Respond404();
+            }
+            else
+            {
+                encoded = PNGFromRGB(dim, dim, bytes);
+            }
+            response = std::make_shared<const std::vector<unsigned char>>(std::move(encoded));
+            etag = responses.Insert(key, response);
+        }
+        return WriteCachedResponse(cdb_request.connection, jpeg ? "image/jpeg" : "image/png", response, etag);
+    }
+
+    bool RespondRESTTile()
+    {
+        // /tiles/{lod}/{row}/{col}.{ext}
+        auto uri = std::string(cdb_request.request_info->local_uri ? cdb_request.request_info->local_uri : "");
+        auto parts = std::vector<std::string>();
+        auto is = std::istringstream(uri);
+        std::string entry;
+        while(std::getline(is, entry, '/'))
+        {
+            if(!entry.empty())
+                parts.push_back(entry);
+        }
+        if(parts.size() != 4)
+            return Respond404();
+        auto dot = parts[3].find('.');
+        if(dot == std::string::npos)
+            return Respond404();
+        try
+        {
+            int lod = std::stoi(parts[1]);
+            int64_t row = std::stoll(parts[2]);
+            int64_t col = std::stoll(parts[3].substr(0, dot));
+            return RespondTile(lod, row, col, cdb_request.LowerCase(parts[3].substr(dot + 1)));
+        }
+        catch(std::exception&)
+        {
+            return Respond404();
+        }
+    }
+
+    bool RespondGetCapabilities()
+    {
+        std::string host;
+        auto host_header = mg_get_header(cdb_request.connection, "Host");
+        if(host_header)
+            host = std::string("http://") + host_header;
+
+        auto ss = std::stringstream();
+        ss << "HTTP/1.1 200 OK\r\n";
+        ss << "Content-Type: text/xml\r\n";
+        ss << "Connection: close\r\n";
+        ss << "\r\n";
+
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+        ss << "<Capabilities xmlns=\"http://www.opengis.net/wmts/1.0\" xmlns:ows=\"http://www.opengis.net/ows/1.1\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" version=\"1.0.0\">";
+        ss << "<ows:ServiceIdentification><ows:Title>" << ccl::FileInfo(cdb_request.cdb).getBaseName() << "</ows:Title>";
+        ss << "<ows:ServiceType>OGC WMTS</ows:ServiceType><ows:ServiceTypeVersion>1.0.0</ows:ServiceTypeVersion></ows:ServiceIdentification>";
+        ss << "<ows:OperationsMetadata>";
+        for(auto operation : { "GetCapabilities", "GetTile" })
+        {
+            ss << "<ows:Operation name=\"" << operation << "\"><ows:DCP><ows:HTTP><ows:Get xlink:href=\"" << host << "/wmts?\">";
+            ss << "<ows:Constraint name=\"GetEncoding\"><ows:AllowedValues><ows:Value>KVP</ows:Value></ows:AllowedValues></ows:Constraint>";
+            ss << "</ows:Get></ows:HTTP></ows:DCP></ows:Operation>";
+        }
+        ss << "</ows:OperationsMetadata>";
+
+        ss << "<Contents>";
+        ss << "<Layer>";
+        ss << "<ows:Title>Imagery</ows:Title>";
+        ss << "<ows:WGS84BoundingBox><ows:LowerCorner>-180 -90</ows:LowerCorner><ows:UpperCorner>180 90</ows:UpperCorner></ows:WGS84BoundingBox>";
+        ss << "<ows:Identifier>Imagery</ows:Identifier>";
+        ss << "<Style isDefault=\"true\"><ows:Identifier>default</ows:Identifier></Style>";
+        ss << "<Format>image/png</Format>";
+        ss << "<Format>image/jpeg</Format>";
+        ss << "<TileMatrixSetLink><TileMatrixSet>CDB</TileMatrixSet></TileMatrixSetLink>";
+        ss << "<ResourceURL format=\"image/png\" resourceType=\"tile\" template=\"" << host << "/tiles/{TileMatrix}/{TileRow}/{TileCol}.png\"/>";
+        ss << "<ResourceURL format=\"image/jpeg\" resourceType=\"tile\" template=\"" << host << "/tiles/{TileMatrix}/{TileRow}/{TileCol}.jpg\"/>";
+        ss << "</Layer>";
+
+        ss << "<TileMatrixSet>";
+        ss << "<ows:Identifier>CDB</ows:Identifier>";
+        ss << "<ows:SupportedCRS>urn:ogc:def:crs:EPSG::4326</ows:SupportedCRS>";
+        const double meters_per_degree = 111319.49079327357;     // WGS84 equator
+        for(int lod = MinLod; lod <= MaxLod; ++lod)
+        {
+            auto n = TilesPerDegree(lod);
+            int dim = TileDimensionForLod(lod);
+            double degrees_per_pixel = 1.0 / (double(n) * dim);
+            ss << "<TileMatrix>";
+            ss << "<ows:Identifier>" << lod << "</ows:Identifier>";
+            ss << "<ScaleDenominator>" << std::setprecision(17) << (degrees_per_pixel * meters_per_degree / 0.00028) << "</ScaleDenominator>";
+            ss << "<TopLeftCorner>90 -180</TopLeftCorner>";
+            ss << "<TileWidth>" << dim << "</TileWidth><TileHeight>" << dim << "</TileHeight>";
+            ss << "<MatrixWidth>" << (360 * n) << "</MatrixWidth><MatrixHeight>" << (180 * n) << "</MatrixHeight>";
+            ss << "</TileMatrix>";
+        }
+        ss << "</TileMatrixSet>";
+        ss << "</Contents>";
+        ss << "</Capabilities>";
+        Write(ss.str());
+        return true;
+    }
+
+    bool RespondKVP()
+    {
+        auto& query_map = cdb_request.query_map;
+        if(cdb_request.LowerCase(query_map["service"]) != "wmts")
+            return Respond404();
+        auto request = cdb_request.LowerCase(query_map["request"]);
+        if(request == "getcapabilities")
+            return RespondGetCapabilities();
+        if(request != "gettile")
+            return Respond404();
+        if((query_map.find("tilematrix") == query_map.end()) || (query_map.find("tilerow") == query_map.end()) || (query_map.find("tilecol") == query_map.end()))
+            return Respond404();
+        auto format = query_map.find("format") != query_map.end() ? query_map["format"] : std::string("image/png");
+        try
+        {
+            return RespondTile(std::stoi(query_map["tilematrix"]), std::stoll(query_map["tilerow"]), std::stoll(query_map["tilecol"]), cdb_request.LowerCase(format));
+        }
+        catch(std::exception&)
+        {
+            return Respond404();
+        }
+    }
+
+    bool Execute()
+    {
+        cdb_request.Dump();
+        if(cdb_request.cdb.empty())
+            return Respond404();
+        auto uri = std::string(cdb_request.request_info->local_uri ? cdb_request.request_info->local_uri : "");
+        if(uri.compare(0, 5, "/wmts") == 0)
+            return RespondKVP();
+        return RespondRESTTile();
+    }
+
+public:
+
+    static bool HandleRequest(const std::string& cdb, CivetServer* server, mg_connection* connection, const unsigned char* blue_marble, const std::vector<unsigned char>& population, WMSResponseCache& responses, CoverageSamplerCache& samplers)
+    {
+        auto handler = TileRequestHandler { cdb, server, connection, blue_marble, population, responses, samplers };
+        return handler.Execute();
+    }
+
+};
+
+// The CDB being served. Never modified once published, so a request keeps using the
+// one it started with while SetCDB() switches to another.
+struct ServedCDB
+{
     std::string cdb;
     std::vector<unsigned char> population;
+};
+
+class WMSHandler : public CivetHandler
+{
+    const unsigned char* blue_marble { nullptr };
+    std::mutex served_mutex;
+    std::shared_ptr<const ServedCDB> served;
+    std::mutex set_mutex;       // serialises SetCDB()
+    WMSResponseCache responses;
+    CoverageSamplerCache samplers;
+
+    std::shared_ptr<const ServedCDB> Served()
+    {
+        std::lock_guard<std::mutex> lock(served_mutex);
+        return served;
+    }
+
 public:
-    WMSHandler(const unsigned char* blue_marble) : blue_marble(blue_marble), population(180 * 360) { }
+    WMSHandler(const unsigned char* blue_marble) : blue_marble(blue_marble), served(std::make_shared<ServedCDB>(ServedCDB { "", std::vector<unsigned char>(180 * 360) })) { }
 
+    void ConfigureCache(size_t budget, const std::string& directory)
+    {
+        responses.Configure(budget, directory);
+    }
+
+    // Selecting the CDB already served keeps the caches; ValidateCaches() picks up changes to it.
     void SetCDB(const std::string& cdb)
     {
-        this->cdb = cdb;
+        std::lock_guard<std::mutex> lock(set_mutex);
+        if(Served()->cdb == cdb)
+            return;
+        auto next = std::make_shared<ServedCDB>(ServedCDB { cdb, std::vector<unsigned char>(180 * 360) });
+        auto& tile_index = CDBTileIndex::Instance();
+        // Another process may have written to the CDB since it was last opened.
         auto versions = cognitics::cdb::VersionChainForCDB(cdb);
         for(auto version : versions)
-            AddCDBToPopulation(version);
+        {
+            tile_index.Invalidate(version);
+            AddCDBToPopulation(version, next->population);
+        }
+        // Files cached on disk by an earlier run are kept if the CDB has not changed since.
+        auto stamp = CacheStampForCDB(cdb);
+        auto generation = tile_index.Generation();
+        responses.Open(stamp, generation);
+        samplers.Validate(generation);
+        std::lock_guard<std::mutex> served_lock(served_mutex);
+        served = next;
     }
 
-    void AddCDBToPopulation(const std::string& cdb)
+    static void AddCDBToPopulation(const std::string& cdb, std::vector<unsigned char>& population)
     {
         auto cdb_geocells = cognitics::cdb::GeocellsForCdb(cdb);
         for(auto geocell : cdb_geocells)
@@ -433,7 +1034,25 @@ public:
 
     bool handleGet(CivetServer* server, struct mg_connection* connection)
     {
-        return WMSRequestHandler::HandleRequest(cdb, server, connection, blue_marble, population);
+        auto current = Served();
+        return WMSRequestHandler::HandleRequest(current->cdb, server, connection, blue_marble, current->population, responses, samplers);
+    }
+
+    bool HandleTileRequest(CivetServer* server, struct mg_connection* connection)
+    {
+        auto current = Served();
+        return TileRequestHandler::HandleRequest(current->cdb, server, connection, blue_marble, current->population, responses, samplers);
+    }
+};
+
+class TileHandler : public CivetHandler
+{
+public:
+    WMSHandler& wms_handler;
+    TileHandler(WMSHandler& wms_handler) : wms_handler(wms_handler) { }
+    bool handleGet(CivetServer* server, struct mg_connection* connection)
+    {
+        return wms_handler.HandleTileRequest(server, connection);
     }
 };
 
@@ -473,13 +1092,18 @@ bool cdb_service(cdb_service_parameters& params)
     if(ip::GetJPGImagePixels("htdocs/world.topo.bathy.200408.3x21600x10800.jpg", bm_info, bm_bytes))
         blue_marble = bm_bytes.data();
 
-    auto civet_options = std::vector<std::string> { "document_root", "./htdocs", "listening_ports", params.bind };
+    auto civet_options = std::vector<std::string> { "document_root", "./htdocs", "listening_ports", params.bind, "num_threads", std::to_string(std::max<int>(params.threads, 1)) };
     auto web_server = CivetServer(civet_options);
     auto wms_handler = WMSHandler(blue_marble);
+    wms_handler.ConfigureCache(params.cache_megabytes * 1024 * 1024, params.cache_dir);
+    gdalsampler::SharedBlockCache::getInstance()->SetBudget(params.block_cache_megabytes * 1024 * 1024);
     if(!params.cdb.empty())
         wms_handler.SetCDB(params.cdb);
     auto web_handler = WebHandler(wms_handler);
+    auto tile_handler = TileHandler(wms_handler);
     web_server.addHandler("/wms", wms_handler);
+    web_server.addHandler("/wmts", tile_handler);
+    web_server.addHandler("/tiles", tile_handler);
     web_server.addHandler("", web_handler);
     while(true)
         ccl::sleep(100);
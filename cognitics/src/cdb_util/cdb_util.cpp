@@ -1,6 +1,11 @@
 
 #include <cdb_util/cdb_util.h>
+#include <cdb_util/CDBTileIndex.h>
+#include <cdb_util/FeatureTileBinner.h>
+#include <cdb_util/ZipArchiveBuilder.h>
 #include <ogr/File.h>
+#include <sfa/RectangleClipper.h>
+#include <ccl/JobManager.h>
 
 #include <cdb_util/FeatureDataDictionary.h>
 #include <ccl/tinyxml2.h>
@@ -16,9 +21,13 @@
 #include <flt/Header.h>
 
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <functional>
 #include <locale>
 #include <iomanip>
+#include <mutex>
+#include <thread>
 
 #if _WIN32
 #include <filesystem>
@@ -170,6 +179,26 @@ TileInfo ParentTileInfo(const TileInfo& tileinfo)
     return result;
 }
 
+uint64_t MortonCodeForTileInfo(const TileInfo& tileinfo)
+{
+    // Global row/column at the tile's LOD. Geocells wider than one degree leave
+    // gaps in the column space, which doesn't matter for ordering.
+    uint64_t div = (uint64_t)RowsForLOD(tileinfo.lod);
+    uint64_t row = (uint64_t)(tileinfo.latitude + 90) * div + (uint64_t)tileinfo.uref;
+    uint64_t col = (uint64_t)(tileinfo.longitude + 180) * div + (uint64_t)tileinfo.rref;
+    auto spread = [](uint64_t v)
+    {
+        v &= 0xFFFFFFFFull;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+    };
+    return spread(col) | (spread(row) << 1);
+}
+
 std::vector<std::string> FileNamesForTiledDataset(const std::string& cdb, int dataset)
 {
     auto result = std::vector<std::string>();
@@ -570,7 +599,6 @@ std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const
         }
     }
 
-    auto fdd = FeatureDataDictionary();
 
     for (auto feature : features)
     {
@@ -581,7 +609,7 @@ std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const
         auto modl = feature->attributes.getAttributeAsString("MODL");
         auto modl_base = ccl::FileInfo(modl).getBaseName(true);
         modl = modl_base + ".flt";
-        auto model_filename = cdb + "/GTModel/500_GTModelGeometry/" + fdd.Subdirectory(facc) + "/D500_S001_T001_" + facc + "_" + fsc + "_" + modl;
+        auto model_filename = cdb + "/GTModel/500_GTModelGeometry/" + FeatureDataDictionary::Subdirectory(facc) + "/D500_S001_T001_" + facc + "_" + fsc + "_" + modl;
         result.push_back(model_filename);
     }
 
@@ -591,22 +619,9 @@ std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const
 
 bool TextureExists(const std::string& filename)
 {
-    //you can iterate through all the files in an archive(using mz_zip_reader_get_num_files()) and retrieve detailed info on each file by calling mz_zip_reader_file_stat().
-
     auto parent_path = ccl::FileInfo(filename).getDirName();
     if(ccl::FileInfo(parent_path).getSuffix() == "zip")
-    {
-        auto texture_filename = ccl::FileInfo(filename).getBaseName();
-        mz_zip_archive zip;
-        memset(&zip, 0, sizeof(zip));
-        //auto z = "D:/CDB/LosAngeles_CDB/Tiles/N34/W118/301_GSModelTexture/L06/U0/N34W118_D301_S001_T001_L06_U0_R1.zip";
-        //if(!mz_zip_reader_init_file(&zip, z, 0))
-        if(!mz_zip_reader_init_file(&zip, parent_path.c_str(), 0))
-            return false;
-        bool result = (mz_zip_reader_locate_file(&zip, texture_filename.c_str(), nullptr, 0) >= 0);
-        mz_zip_reader_end(&zip);
-        return result;
-    }
+        return ZipDirectoryCache::Instance().Contains(parent_path, ccl::FileInfo(filename).getBaseName());
 
     return ccl::FileInfo::fileExists(filename);
 }
@@ -643,25 +658,39 @@ bool BuildElevationTileFloatsFromSampler2(elev::Elevation_DSM& sampler, const Ti
     extents.height = extents.width;
     double spacing_x = (extents.east - extents.west) / extents.width;
     double spacing_y = (extents.north - extents.south) / extents.height;
-    auto point = sfa::Point();
-    bool hit = false;
-    for(int y = 0; y < extents.height; ++y)
+    return sampler.GetGrid(extents.west, extents.south, spacing_x, spacing_y, extents.width, extents.height, floats.data()) > 0;
+}
+
+namespace
+{
+    struct CoordinateTransformationDeleter
     {
-        point.setY(extents.south + (y * spacing_y));
-        for(int x = 0; x < extents.width; ++x)
-        {
-            point.setX(extents.west + (x * spacing_x));
-            if(sampler.Get(&point))
-            {
-                floats[(y * extents.width) + x] = point.Z();
-                hit = true;
-            }
-        }
+        void operator()(OGRCoordinateTransformation* transform) const { OGRCoordinateTransformation::DestroyCT(transform); }
+    };
+
+    // Setting up a transformation is far more expensive than reading the raster header, and a
+    // source set almost always shares one projection, so each thread keeps one per projection.
+    OGRCoordinateTransformation* TransformationToWGS84(const std::string& projref)
+    {
+        thread_local std::map<std::string, std::unique_ptr<OGRCoordinateTransformation, CoordinateTransformationDeleter>> transforms;
+        auto it = transforms.find(projref);
+        if(it != transforms.end())
+            return it->second.get();
+        auto file_srs = OGRSpatialReference(projref.c_str());
+        auto app_srs = OGRSpatialReference();
+        app_srs.SetWellKnownGeogCS("WGS84");
+        auto& transform = transforms[projref];
+        transform.reset(OGRCreateCoordinateTransformation(&file_srs, &app_srs));
+        return transform.get();
     }
-    return hit;
 }
 
 RasterInfo ReadRasterInfo(const std::string& filename)
+{
+    return ReadRasterInfo(filename, nullptr);
+}
+
+RasterInfo ReadRasterInfo(const std::string& filename, const char* const* sibling_files)
 {
     GDALDataset *ds = NULL;
     auto info = RasterInfo();
@@ -677,10 +706,11 @@ RasterInfo ReadRasterInfo(const std::string& filename)
 
         ds = (GDALDataset*)GDALOpenEx(strippedFilename.c_str(),
             GDAL_OF_READONLY, NULL, papszOptions, NULL);
+        CSLDestroy(papszOptions);
     }
     else
     {
-        ds = (GDALDataset *)GDALOpen(filename.c_str(), GA_ReadOnly);
+        ds = (GDALDataset*)GDALOpenEx(filename.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, NULL, NULL, sibling_files);
     }
     if(ds == nullptr)
         return info;
@@ -694,18 +724,13 @@ RasterInfo ReadRasterInfo(const std::string& filename)
     {
         projref = "WGS84";
     }
-    
+    auto transform = has_geotransform ? TransformationToWGS84(projref) : nullptr;
+
+    GDALClose(ds);
 
     if(!has_geotransform)
         return info;
 
-    auto file_srs = OGRSpatialReference(projref);
-    auto app_srs = OGRSpatialReference();
-    app_srs.SetWellKnownGeogCS("WGS84");
-    auto transform = OGRCreateCoordinateTransformation(&file_srs, &app_srs);
-
-    GDALClose(ds);
-
     info.OriginX = geotransform[0];
     info.OriginY = geotransform[3];
     info.PixelSizeX = geotransform[1];
@@ -716,11 +741,9 @@ RasterInfo ReadRasterInfo(const std::string& filename)
     double y_min = DBL_MAX;
     double y_max = -DBL_MAX;
 
+    // The geotransform is affine, so the extremes of the border posts are at the corners.
     int row_arr[2] = {0,info.Height-1};
     int col_arr[2] = {0,info.Width-1};
-
-/*
-    // Every post in the first and last row, 1
     for(int row = 0; row < 2; ++row)
     {
         for(int col = 0; col < 2; ++col)
@@ -735,46 +758,6 @@ RasterInfo ReadRasterInfo(const std::string& filename)
             y_max = std::max<double>(y_max, y);
         }
     }
-*/
-    /*
-
-    for(int row = 0; row < info.Height; ++row)
-    {
-        for(int col = 0; col < info.Width; ++col)
-        {
-            //Xgeo = GT(0) + Xpixel * GT(1) + Yline * GT(2)
-            //Ygeo = GT(3) + Xpixel * GT(4) + Yline * GT(5)
-            auto x = geotransform[0] + (geotransform[1] * col) + (geotransform[2] * row);
-            auto y = geotransform[3] + (geotransform[4] * col) + (geotransform[5] * row);
-            x_min = std::min<double>(x_min, x);
-            x_max = std::max<double>(x_max, x);
-            y_min = std::min<double>(y_min, y);
-            y_max = std::max<double>(y_max, y);
-        }
-    }
-    */
-
-    for(int row = 0; row < info.Height; ++row)
-    {
-        bool only_first_and_last_col = false;
-        if((row!=0) && (row != (info.Height-1)))
-            only_first_and_last_col = true;
-
-        for(int col = 0; col < info.Width; ++col)
-        {
-            if(only_first_and_last_col && (col!=0) && (col!=(info.Width-1)))
-                continue;
-            
-            //Xgeo = GT(0) + Xpixel * GT(1) + Yline * GT(2)
-            //Ygeo = GT(3) + Xpixel * GT(4) + Yline * GT(5)
-            auto x = geotransform[0] + (geotransform[1] * col) + (geotransform[2] * row);
-            auto y = geotransform[3] + (geotransform[4] * col) + (geotransform[5] * row);
-            x_min = std::min<double>(x_min, x);
-            x_max = std::max<double>(x_max, x);
-            y_min = std::min<double>(y_min, y);
-            y_max = std::max<double>(y_max, y);
-        }
-    }
 
     if(y_max < y_min)
         std::swap(y_max, y_min);
@@ -801,8 +784,6 @@ RasterInfo ReadRasterInfo(const std::string& filename)
 
         info.PixelSizeX = fabs((nw_w - sw_w))/info.Width;
         info.PixelSizeY = fabs((nw_n - sw_s))/info.Height;
-
-        OGRCoordinateTransformation::DestroyCT(transform);
     }
 
     info.South = std::min<double>(sw_s, se_s);
@@ -916,6 +897,35 @@ void WriteFloatsToText(const std::string& filename, const RasterInfo& rasterinfo
     f.close();
 }
 
+// Uncompressed 3-band GeoTIFF; cheap enough to use for /vsimem/ handoff between jobs.
+bool WriteBytesToTIF(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<unsigned char>& bytes)
+{
+    auto tif_driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if(tif_driver == NULL)
+        return false;
+
+    double geotransform[6] = { rasterinfo.OriginX, rasterinfo.PixelSizeX, 0.0, rasterinfo.OriginY, 0.0, rasterinfo.PixelSizeY };
+
+    auto tif_ds = tif_driver->Create(filename.c_str(), rasterinfo.Width, rasterinfo.Height, 3, GDT_Byte, nullptr);
+    if(tif_ds == NULL)
+        return false;
+    tif_ds->SetGeoTransform(geotransform);
+
+    OGRSpatialReference oSRS;
+    oSRS.SetWellKnownGeogCS("WGS84");
+    char *wkt = NULL;
+    oSRS.exportToWkt(&wkt);
+    tif_ds->SetProjection(wkt);
+    CPLFree(wkt);
+
+    for(int band = 1; band <= 3; ++band)
+        auto discard = tif_ds->GetRasterBand(band)->RasterIO(GF_Write, 0, 0, rasterinfo.Width, rasterinfo.Height, (unsigned char*)&bytes[band - 1], rasterinfo.Width, rasterinfo.Height, GDT_Byte, 3, rasterinfo.Width * 3);
+
+    GDALClose(tif_ds);
+
+    return true;
+}
+
 bool WriteFloatsToTIF(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<float>& floats, bool pixel_is_point)
 {
     auto tif_driver = GetGDALDriverManager()->GetDriverByName("GTiff");
@@ -924,7 +934,8 @@ bool WriteFloatsToTIF(const std::string& filename, const RasterInfo& rasterinfo,
 
     double geotransform[6] = { rasterinfo.OriginX - (0.5 * rasterinfo.PixelSizeX), rasterinfo.PixelSizeX, 0.0, rasterinfo.OriginY + (0.5 * rasterinfo.PixelSizeY), 0.0, rasterinfo.PixelSizeY };
 
-    ccl::makeDirectory(ccl::FileInfo(filename).getDirName());
+    if(filename.compare(0, 4, "/vsi") != 0)
+        ccl::makeDirectory(ccl::FileInfo(filename).getDirName());
     auto tif_ds = tif_driver->Create(filename.c_str(), rasterinfo.Width, rasterinfo.Height, 1, GDT_Float32, nullptr);
     tif_ds->SetGeoTransform(geotransform);
     if(pixel_is_point)
@@ -989,13 +1000,13 @@ std::vector<float> FlippedVertically(const std::vector<float>& floats, size_t wi
     return result;
 }
 
-bool BuildImageryTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo)
+bool SampleImageryTile(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<unsigned char>& bytes)
 {
     auto jp2_filepath = FilePathForTileInfo(tileinfo);
     auto jp2_filename = FileNameForTileInfo(tileinfo);
     auto outfilename = cdb + "/Tiles/" + jp2_filepath + "/" + jp2_filename + ".jp2";
     auto dim = TileDimensionForLod(tileinfo.lod);
-    auto bytes = std::vector<unsigned char>();
+    bytes.clear();
     if (std::filesystem::exists(outfilename))
     {
         bytes = BytesFromJP2(outfilename);
@@ -1009,21 +1020,41 @@ bool BuildImageryTileFromSampler(const std::string& cdb, GDALRasterSampler& samp
         bytes.resize(dimension * dimension * 3);
     }
 
-    BuildImageryTileBytesFromSampler(sampler, tileinfo, bytes);    
+    if(!BuildImageryTileBytesFromSampler(sampler, tileinfo, bytes))
+        return false;
     bytes = FlippedVertically(bytes, dim, dim, 3);
+    return true;
+}
+
+bool WriteImageryTile(const std::string& cdb, const TileInfo& tileinfo, const std::vector<unsigned char>& bytes)
+{
+    auto jp2_filepath = FilePathForTileInfo(tileinfo);
+    auto jp2_filename = FileNameForTileInfo(tileinfo);
+    auto outfilename = cdb + "/Tiles/" + jp2_filepath + "/" + jp2_filename + ".jp2";
     auto info = RasterInfoFromTileInfo(tileinfo);
     ccl::makeDirectory(ccl::FileInfo(outfilename).getDirName());
     std::remove(outfilename.c_str());
-    return WriteBytesToJP2(outfilename, info, bytes);
+    if(!WriteBytesToJP2(outfilename, info, bytes))
+        return false;
+    CDBTileIndex::Instance().Insert(cdb, tileinfo);
+    return true;
 }
 
-bool BuildElevationTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo)
+bool BuildImageryTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo)
+{
+    auto bytes = std::vector<unsigned char>();
+    if(!SampleImageryTile(cdb, sampler, tileinfo, bytes))
+        return false;
+    return WriteImageryTile(cdb, tileinfo, bytes);
+}
+
+bool SampleElevationTile(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<float>& floats)
 {
     auto tif_filepath = FilePathForTileInfo(tileinfo);
     auto tif_filename = FileNameForTileInfo(tileinfo);
     auto outfilename = cdb + "/Tiles/" + tif_filepath + "/" + tif_filename + ".tif";
     auto dim = TileDimensionForLod(tileinfo.lod);
-    auto floats = std::vector<float>();
+    floats.clear();
     if(std::filesystem::exists(outfilename))
     {
         floats = FloatsFromTIF(outfilename);
@@ -1036,16 +1067,38 @@ bool BuildElevationTileFromSampler(const std::string& cdb, GDALRasterSampler& sa
         std::fill(floats.begin(), floats.end(), 0);
     }
 
-    BuildElevationTileFloatsFromSampler(sampler, tileinfo, floats);
+    if(!BuildElevationTileFloatsFromSampler(sampler, tileinfo, floats))
+        return false;
     floats = FlippedVertically(floats, dim, dim, 1);
+    return true;
+}
+
+bool WriteElevationTile(const std::string& cdb, const TileInfo& tileinfo, const std::vector<float>& floats, bool minmax)
+{
+    auto tif_filepath = FilePathForTileInfo(tileinfo);
+    auto tif_filename = FileNameForTileInfo(tileinfo);
+    auto outfilename = cdb + "/Tiles/" + tif_filepath + "/" + tif_filename + ".tif";
     auto info = RasterInfoFromTileInfo(tileinfo);
     ccl::makeDirectory(ccl::FileInfo(outfilename).getDirName());
     std::remove(outfilename.c_str());
     //WriteFloatsToText(outfilename + ".txt", info, floats);
-    return WriteFloatsToTIF(outfilename, info, floats);
+    if(!WriteFloatsToTIF(outfilename, info, floats))
+        return false;
+    CDBTileIndex::Instance().Insert(cdb, tileinfo);
+    if(minmax && (tileinfo.dataset == 1) && (tileinfo.selector1 == 1) && (tileinfo.selector2 == 1))
+        return WriteMinMaxElevationTiles(cdb, tileinfo, floats);
+    return true;
+}
+
+bool BuildElevationTileFromSampler(const std::string& cdb, GDALRasterSampler& sampler, const TileInfo& tileinfo, bool minmax)
+{
+    auto floats = std::vector<float>();
+    if(!SampleElevationTile(cdb, sampler, tileinfo, floats))
+        return false;
+    return WriteElevationTile(cdb, tileinfo, floats, minmax);
 }
 
-bool BuildElevationTileFromSampler2(const std::string& cdb, elev::Elevation_DSM& sampler, const TileInfo& tileinfo)
+bool BuildElevationTileFromSampler2(const std::string& cdb, elev::Elevation_DSM& sampler, const TileInfo& tileinfo, bool minmax)
 {
     auto tif_filepath = FilePathForTileInfo(tileinfo);
     auto tif_filename = FileNameForTileInfo(tileinfo);
@@ -1065,11 +1118,7 @@ bool BuildElevationTileFromSampler2(const std::string& cdb, elev::Elevation_DSM&
         return true;
     auto dim = TileDimensionForLod(tileinfo.lod);
     floats = FlippedVertically(floats, dim, dim, 1);
-    auto info = RasterInfoFromTileInfo(tileinfo);
-    ccl::makeDirectory(ccl::FileInfo(outfilename).getDirName());
-    std::remove(outfilename.c_str());
-    //WriteFloatsToText(outfilename + ".txt", info, floats);
-    return WriteFloatsToTIF(outfilename, info, floats);
+    return WriteElevationTile(cdb, tileinfo, floats, minmax);
 }
 
 
@@ -1234,7 +1283,8 @@ std::vector<std::string> VersionChainForCDB(const std::string& cdb)
 
 std::vector<std::pair<std::string, Tile>> CoverageTilesForTiles(const std::string& cdb, const std::vector<Tile>& source_tiles)
 {
-    auto cdblist = VersionChainForCDB(cdb);
+    auto& tile_index = CDBTileIndex::Instance();
+    auto cdblist = tile_index.VersionChain(cdb);
     auto result = std::vector<std::pair<std::string, Tile>>();
     auto tiles = source_tiles;
     while(!tiles.empty())
@@ -1243,17 +1293,10 @@ std::vector<std::pair<std::string, Tile>> CoverageTilesForTiles(const std::strin
         for(auto tile : tiles)
         {
             auto tile_info = TileInfoForTile(tile);
-            auto tile_filepath = FilePathForTileInfo(tile_info);
-            auto tile_filename = FileNameForTileInfo(tile_info);
             bool found = false;
             for(auto local_cdb : cdblist)
             {
-                auto filename = local_cdb + "/Tiles/" + tile_filepath + "/" + tile_filename;
-                if(tile_info.dataset == 1)
-                    filename += ".tif";
-                if(tile_info.dataset == 4)
-                    filename += ".jp2";
-                if(std::filesystem::exists(filename))
+                if(tile_index.Exists(local_cdb, tile_info))
                 {
                     result.emplace_back(local_cdb, tile);
                     found = true;
@@ -1282,7 +1325,8 @@ std::vector<std::pair<std::string, Tile>> CoverageTilesForTiles(const std::strin
 
 std::vector<std::pair<std::string, TileInfo>> CoverageTileInfosForTileInfo(const std::string& cdb, const TileInfo& source_tileinfo)
 {
-    auto cdblist = VersionChainForCDB(cdb);
+    auto& tile_index = CDBTileIndex::Instance();
+    auto cdblist = tile_index.VersionChain(cdb);
     auto result = std::vector<std::pair<std::string, TileInfo>>();
     auto tileinfos = std::vector<TileInfo>();
     tileinfos.push_back(source_tileinfo);
@@ -1291,17 +1335,10 @@ std::vector<std::pair<std::string, TileInfo>> CoverageTileInfosForTileInfo(const
         auto parent_tileinfos = std::vector<TileInfo>();
         for(auto tileinfo : tileinfos)
         {
-            auto tile_filepath = FilePathForTileInfo(tileinfo);
-            auto tile_filename = FileNameForTileInfo(tileinfo);
             bool found = false;
             for(auto local_cdb : cdblist)
             {
-                auto filename = local_cdb + "/Tiles/" + tile_filepath + "/" + tile_filename;
-                if(tileinfo.dataset == 1)
-                    filename += ".tif";
-                if(tileinfo.dataset == 4)
-                    filename += ".jp2";
-                if(std::filesystem::exists(filename))
+                if(tile_index.Exists(local_cdb, tileinfo))
                 {
                     result.emplace_back(local_cdb, tileinfo);
                     found = true;
@@ -1346,6 +1383,39 @@ std::vector<TileInfo> TileInfosForOGRFile(const std::string& filename)
     return GenerateTileInfos(0, nsew);
 }
 
+namespace
+{
+    std::mutex inject_models_mutex;
+
+    // Calls fn(i) for i in [0, count) on up to workers threads; false if any call returned false.
+    bool ForEachOnWorkers(size_t count, int workers, const std::function<bool(size_t)>& fn)
+    {
+        auto worker_count = std::min<size_t>(std::max<int>(workers, 1), count);
+        std::atomic<size_t> next { 0 };
+        std::atomic<bool> result { true };
+        auto run = [&]()
+        {
+            for(auto i = next++; i < count; i = next++)
+            {
+                if(!fn(i))
+                    result = false;
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_t i = 1; i < worker_count; ++i)
+            threads.emplace_back(run);
+        run();
+        for(auto& thread : threads)
+            thread.join();
+        return result;
+    }
+
+    std::string SpillFileName(const std::string& spill_path, const TileInfo& tileinfo)
+    {
+        return spill_path + "/" + FileNameForTileInfo(tileinfo) + ".shp";
+    }
+}
+
 bool CDBInjector::InjectFeatures(const std::string& filename)
 {
     return InjectFeatures(std::vector<std::string>{ filename });
@@ -1359,26 +1429,59 @@ bool CDBInjector::InjectFeatures(const std::vector<std::string>& filenames)
     if(insert)
         return InsertFeatures(filenames);
 
-    std::map<TileInfo, std::vector<std::string>> filenames_by_tile_info;
+    // Each source is read once; features are binned straight into the LOD 0 tiles they touch.
+    // When the bins pass feature_limit they are appended to per tile spill files, which are
+    // merged back one tile at a time as the tiles are written.
+    auto binner = FeatureTileBinner(0, dataset, cs1, cs2);
+    auto spill_path = std::string();
+    bool result = true;
     for(auto filename : filenames)
     {
-        auto tileinfos = TileInfosForOGRFile(filename);
-        for(auto tileinfo : tileinfos)
+        auto file = ogr::File();
+        if(!file.open(filename))
         {
-            tileinfo.dataset = dataset;
-            tileinfo.selector1 = cs1;
-            tileinfo.selector2 = cs2;
-            filenames_by_tile_info[tileinfo].push_back(filename);
+            result = false;
+            break;
+        }
+        auto layers = file.getLayers();
+        for(auto layer : layers)
+        {
+            sfa::Feature* feature = nullptr;
+            while(result && (feature = layer->getNextFeature()))
+            {
+                binner.Add(std::shared_ptr<sfa::Feature>(feature));
+                if((feature_limit == 0) || (binner.Count() < feature_limit))
+                    continue;
+                if(spill_path.empty())
+                {
+                    spill_path = cdb + "/.inject_spill";
+                    std::error_code ec;
+                    std::filesystem::remove_all(spill_path, ec);
+                    std::filesystem::create_directories(spill_path, ec);
+                }
+                ccl::ObjLog log;
+                log << "INJECT spilling " << binner.Count() << " features to " << spill_path << log.endl;
+                result = SpillTiles(binner.Bins(), spill_path);
+                binner.Clear();
+            }
         }
+        file.close();
+        if(!result)
+            break;
     }
-    for(auto entry : filenames_by_tile_info)
-        InjectFeatures(entry.first, entry.second);
-    return true;
+    if(result)
+        result = InjectTiles(binner.Bins(), spill_path);
+    if(!spill_path.empty())
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(spill_path, ec);
+    }
+    return result;
 }
 
 bool CDBInjector::InjectFeatures(const TileInfo& tileinfo, const std::vector<std::string>& filenames)
 {
-    auto features = std::vector<sfa::Feature*>();
+    auto binner = FeatureTileBinner(tileinfo, tileinfo.lod);
     for(auto filename : filenames)
     {
         auto file = ogr::File();
@@ -1388,38 +1491,65 @@ bool CDBInjector::InjectFeatures(const TileInfo& tileinfo, const std::vector<std
         for(auto layer : layers)
         {
             while(auto feature = layer->getNextFeature())
-                features.push_back(feature);
+                binner.Add(std::shared_ptr<sfa::Feature>(feature));
         }
         file.close();
     }
-    bool result = InjectFeatures(tileinfo, features);
-    for(auto feature : features)
-        delete feature;
-    return result;
+    return InjectTiles(binner.Bins());
 }
 
 bool CDBInjector::InjectFeatures(const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features)
 {
-    auto tile_features = std::vector<sfa::Feature*>();
-    auto nsew = NSEWForTileInfo(tileinfo);
+    // The caller keeps ownership of the features.
+    auto binner = FeatureTileBinner(tileinfo, tileinfo.lod);
     for(auto feature : features)
+        binner.Add(std::shared_ptr<sfa::Feature>(feature, [](sfa::Feature*) { }));
+    return InjectTiles(binner.Bins());
+}
+
+bool CDBInjector::InjectTiles(const std::map<TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>& tiles, const std::string& spill_path)
+{
+    auto entries = std::vector<const std::pair<const TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>*>();
+    for(auto& entry : tiles)
+        entries.push_back(&entry);
+    return ForEachOnWorkers(entries.size(), workers, [&](size_t i)
     {
-		if(!feature->geometry)
-			continue;
-		auto envelope = std::make_unique<sfa::LineString>(dynamic_cast<sfa::LineString*>(feature->geometry->getEnvelope()));
-		auto point_min = envelope->getPointN(0);
-		auto point_max = envelope->getPointN(1);
-		if(point_min->Y() > nsew.north)
-			continue;
-		if(point_min->X() > nsew.east)
-			continue;
-		if(point_max->Y() < nsew.south)
-			continue;
-		if(point_max->X() < nsew.west)
-			continue;
-		tile_features.push_back(feature);
-    }
-    if(tile_features.empty())
+        auto& tileinfo = entries[i]->first;
+        auto& features = entries[i]->second;
+        auto spill_fn = spill_path.empty() ? std::string() : SpillFileName(spill_path, tileinfo);
+        if(spill_fn.empty() || !ccl::fileExists(spill_fn))
+            return InjectTile(tileinfo, features);
+
+        // spilled features were binned first, so they go first
+        auto tile_features = std::vector<std::shared_ptr<sfa::Feature>>();
+        for(auto feature : FeaturesForOGRFile(spill_fn))
+            tile_features.emplace_back(feature);
+        tile_features.insert(tile_features.end(), features.begin(), features.end());
+        return InjectTile(tileinfo, tile_features);
+    });
+}
+
+bool CDBInjector::SpillTiles(const std::map<TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>& tiles, const std::string& spill_path)
+{
+    auto entries = std::vector<const std::pair<const TileInfo, std::vector<std::shared_ptr<sfa::Feature>>>*>();
+    for(auto& entry : tiles)
+    {
+        if(!entry.second.empty())
+            entries.push_back(&entry);
+    }
+    return ForEachOnWorkers(entries.size(), workers, [&](size_t i)
+    {
+        auto tile_features = std::vector<sfa::Feature*>();
+        tile_features.reserve(entries[i]->second.size());
+        for(auto& feature : entries[i]->second)
+            tile_features.push_back(feature.get());
+        return WriteFeaturesToOGRFile(SpillFileName(spill_path, entries[i]->first), tile_features);
+    });
+}
+
+bool CDBInjector::InjectTile(const TileInfo& tileinfo, const std::vector<std::shared_ptr<sfa::Feature>>& features)
+{
+    if(features.empty())
         return true;
 
 	auto tile_filepath = FilePathForTileInfo(tileinfo);
@@ -1433,13 +1563,24 @@ bool CDBInjector::InjectFeatures(const TileInfo& tileinfo, const std::vector<sfa
 
     ccl::ObjLog log;
 
-    if(tile_features.size() <= 16384)
+    if(features.size() <= 16384)
     {
+        auto tile_features = std::vector<sfa::Feature*>();
+        tile_features.reserve(features.size());
+        for(auto& feature : features)
+            tile_features.push_back(feature.get());
+
         log << "INJECT " << tile_filename << ": writing " << tile_features.size() << " features" << log.endl;
-        if((dataset == 100) && !models_path.empty())
-            InjectGSModels(cdb, tileinfo, tile_features, insert, models_path, textures_path);
-        if((dataset == 101) && !models_path.empty())
-            InjectGTModels(cdb, tile_features, models_path, textures_path);
+        if(!models_path.empty() && ((dataset == 100) || (dataset == 101)))
+        {
+            // GTModels share one library, so model injection stays serialized. Only one
+            // worker is in here at a time, so its archives are compressed on workers threads.
+            std::lock_guard<std::mutex> lock(inject_models_mutex);
+            if(dataset == 100)
+                InjectGSModels(cdb, tileinfo, tile_features, insert, models_path, textures_path, workers);
+            if(dataset == 101)
+                InjectGTModels(cdb, tile_features, models_path, textures_path);
+        }
 
         if(!insert)
         {
@@ -1449,21 +1590,20 @@ bool CDBInjector::InjectFeatures(const TileInfo& tileinfo, const std::vector<sfa
         return WriteFeaturesToOGRFile(tile_fn, tile_features);
     }
 
-	log << "INJECT " << tile_filename << ": splitting " << tile_features.size() << " features" << log.endl;
+	log << "INJECT " << tile_filename << ": splitting " << features.size() << " features" << log.endl;
 
     WriteFeaturesToOGRFile(tile_fn, { });
 	WriteDummyClassDBF(class_tile_fn);
-    auto children = GenerateTileInfos(tileinfo.lod + 1, nsew);
+    auto binner = FeatureTileBinner(tileinfo, tileinfo.lod + 1);
+    for(auto& feature : features)
+        binner.Add(feature);
     bool result = true;
-    for(auto child : children)
+    for(auto& entry : binner.Bins())
     {
-        child.dataset = tileinfo.dataset;
-        child.selector1 = tileinfo.selector1;
-        child.selector2 = tileinfo.selector2;
-        if(!InjectFeatures(child, tile_features))
+        if(!InjectTile(entry.first, entry.second))
             result = false;
     }
-    return true;
+    return result;
 }
 
 bool CDBInjector::InsertFeatures(const std::string& filename)
@@ -1531,19 +1671,11 @@ std::vector<sfa::Feature*> FeaturesForTileCroppedFeature(const TileInfo& tile_in
         return std::vector<sfa::Feature*>();
     double tile_north, tile_south, tile_east, tile_west;
     std::tie(tile_north, tile_south, tile_east, tile_west) = NSEWBoundsForTileInfo(tile_info);
-    auto tile_ring = new sfa::LineString;
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_south));
-    tile_ring->addPoint(new sfa::Point(tile_east, tile_south));
-    tile_ring->addPoint(new sfa::Point(tile_east, tile_north));
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_north));
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_south));
-    sfa::Polygon tile_aabb;
-    tile_aabb.addRing(tile_ring);
-    auto isect_geometry = tile_aabb.intersection(feature.geometry);
+    auto isect_geometry = sfa::clipToRectangle(feature.geometry, tile_west, tile_east, tile_south, tile_north);
     if(!isect_geometry)
         return std::vector<sfa::Feature*>();
     sfa::GeometryCollection* isect_collection = dynamic_cast<sfa::GeometryCollection*>(isect_geometry);
-    if(!isect_collection)
+    if(!isect_collection || (isect_geometry->getWKBGeometryType() == feature.geometry->getWKBGeometryType()))
     {
         isect_collection = new sfa::GeometryCollection;
         isect_collection->addGeometry(isect_geometry);
@@ -1732,16 +1864,10 @@ TileInfo HighestExistingTileInfoForPosition(const std::string& cdb, int dataset,
 
 bool FileExistsInZip(const std::string& zipname, const std::string& filename)
 {
-    mz_zip_archive zip;
-    memset(&zip, 0, sizeof(zip));
-    if(!mz_zip_reader_init_file(&zip, zipname.c_str(), 0))
-        return false;
-    bool result = mz_zip_reader_locate_file(&zip, filename.c_str(), nullptr, 0) >= 0;
-    mz_zip_reader_end(&zip);
-    return result;
+    return ZipDirectoryCache::Instance().Contains(zipname, filename);
 }
 
-void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features, bool insert, const std::string& source_model_path, const std::string& source_texture_path)
+void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std::vector<sfa::Feature*>& features, bool insert, const std::string& source_model_path, const std::string& source_texture_path, int zip_workers)
 {
     auto D300_tile_info = tileinfo;
     D300_tile_info.dataset = 300;
@@ -1759,7 +1885,6 @@ void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std:
     auto D301_zipname = std::filesystem::path(D301_zipname_temp).string();
 
     ccl::ObjLog log;
-    auto fdd = FeatureDataDictionary();
     auto source_by_target = std::map<std::string, std::string>();
     for(auto feature : features)
     {
@@ -1790,14 +1915,11 @@ void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std:
 			feature->attributes.setAttribute("CNAM", std::string(""));
     }
 
-    //mz_bool mz_zip_add_mem_to_archive_file_in_place(const char *pZip_filename, const char *pArchive_name, const void *pBuf, size_t buf_size, const void *pComment, mz_uint16 comment_size, mz_uint level_and_flags);
-    /*
-        mz_zip_archive zip;
-        memset(&zip, 0, sizeof(zip));
-        if(!mz_zip_reader_init_file(&zip, parent_path.c_str(), 0))
-            return false;
-        mz_zip_reader_end(&zip);
-        */
+    // Both archives are built in memory and written once at the end; adding entries
+    // one at a time rewrites the central directory for every model and texture.
+    auto D300_zip = ZipArchiveBuilder(D300_zipname);
+    auto D301_zip = ZipArchiveBuilder(D301_zipname);
+    auto texture_by_source = std::map<std::string, std::string>();
 
     for(auto entry : source_by_target)
     {
@@ -1844,13 +1966,11 @@ void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std:
 						outbase.resize(32);
 					std::replace(outbase.begin(), outbase.end(), '.', '_');
                     auto outfn = D301_filename + "_" + outbase + "." + outext;
-					auto outpath = ccl::FileInfo(D301_zipname).getDirName();
-					ccl::makeDirectory(outpath);
-                    if(!FileExistsInZip(D301_zipname.c_str(), outfn.c_str()))
-                    {
-                        auto texture_bytes = BytesFromFile(source_texture);
-                        auto mz_result = mz_zip_add_mem_to_archive_file_in_place(D301_zipname.c_str(), outfn.c_str(), texture_bytes.data(), texture_bytes.size(), NULL, 0, MZ_DEFAULT_COMPRESSION);
-                    }
+                    auto tit = texture_by_source.find(source_texture);
+                    if(tit != texture_by_source.end())
+                        outfn = tit->second;
+                    else if(!D301_zip.Contains(outfn))
+                        outfn = texture_by_source[source_texture] = D301_zip.Add(outfn, BytesFromFile(source_texture), true);
                     auto lodstr = std::to_string(tileinfo.lod);
                     if(lodstr.size() < 2)
                         lodstr = "0" + lodstr;
@@ -1869,15 +1989,18 @@ void InjectGSModels(const std::string& cdb, const TileInfo& tileinfo, const std:
 
         //FileFromBytes(outfile, bytes);
         auto outfn = ccl::FileInfo(outfile).getBaseName();
-        if(!FileExistsInZip(D300_zipname.c_str(), outfn.c_str()))
-			mz_zip_add_mem_to_archive_file_in_place(D300_zipname.c_str(), outfn.c_str(), bytes.data(), bytes.size(), NULL, 0, MZ_DEFAULT_COMPRESSION);
+        D300_zip.Add(outfn, std::move(bytes));
     }
+
+    if(D301_zip.PendingCount() > 0)
+        log << "INJECT " << D301_filename << ": writing " << D301_zip.PendingCount() << " textures" << log.endl;
+    D301_zip.Write(-1, std::max<int>(zip_workers, 1));
+    D300_zip.Write(-1, std::max<int>(zip_workers, 1));
 }
 
 void InjectGTModels(const std::string& cdb, const std::vector<sfa::Feature*>& features, const std::string& source_model_path, const std::string& source_texture_path)
 {
     ccl::ObjLog log;
-    auto fdd = FeatureDataDictionary();
     auto source_by_target = std::map<std::string, std::string>();
     for(auto feature : features)
     {
@@ -1899,7 +2022,7 @@ void InjectGTModels(const std::string& cdb, const std::vector<sfa::Feature*>& fe
             std::reverse(modl_base.begin(), modl_base.end());
             modl_base.resize(32);
         }
-        auto relpath = "/GTModel/500_GTModelGeometry/" + fdd.Subdirectory(facc) + "/D500_S001_T001_" + facc + "_" + fsc + "_" + modl_base + ".flt";
+        auto relpath = "/GTModel/500_GTModelGeometry/" + FeatureDataDictionary::Subdirectory(facc) + "/D500_S001_T001_" + facc + "_" + fsc + "_" + modl_base + ".flt";
         auto outfile = cdb + relpath;
         source_by_target[outfile] = infile;
         feature->attributes.setAttribute("MODL", modl_base);
@@ -2244,91 +2367,135 @@ std::vector<TileInfo> GenerateTileInfos(int lod, const NSEW& nsew)
     return result;
 }
 
-void BuildMinMaxElevation(const std::string& cdb, int lod_offset)
+void MinMaxElevationFromFloats(const std::vector<float>& elevation_floats, int dim, std::vector<float>& min_floats, std::vector<float>& max_floats)
 {
-    ccl::ObjLog log;
-    auto elevation_filenames = FileNamesForTiledDataset(cdb, 1);
-    auto elevation_tileinfos = TileInfoForFileNames(elevation_filenames);
-    auto minmax_tiles = std::vector<Tile>();
-    for(auto elevation_tileinfo : elevation_tileinfos)
+    min_floats.resize(size_t(dim) * dim);
+    max_floats.resize(size_t(dim) * dim);
+    if(elevation_floats.size() < min_floats.size())
+        return;
+    for(int row = 0; row < dim; ++row)
     {
-        auto nsew = NSEWBoundsForTileInfo(elevation_tileinfo);
-        auto coords = CoordinatesRange(std::get<3>(nsew), std::get<2>(nsew), std::get<1>(nsew), std::get<0>(nsew));
-        auto tiles = generate_tiles(coords, Dataset((uint16_t)2), elevation_tileinfo.lod - lod_offset);
-        minmax_tiles.insert(minmax_tiles.end(), tiles.begin(), tiles.end());
+        // note that this doesn't follow the spec exactly
+        // - we should reference the adjacent tiles to the north/east
+        // - we should upsample from lower LODs if available for the north/east
+        // - coarser LODs in the minmax dataset should be taken from the higher LOD minmax rather than the associated elevation layer
+        const float* south = &elevation_floats[size_t(row) * dim];
+        const float* north = (row + 1 < dim) ? south + dim : south;
+        float* min_row = &min_floats[size_t(row) * dim];
+        float* max_row = &max_floats[size_t(row) * dim];
+        for(int col = 0; col < dim; ++col)
+        {
+            int east = (col + 1 < dim) ? col + 1 : col;
+            float sw = south[col];
+            float se = south[east];
+            float nw = north[col];
+            float ne = north[east];
+            min_row[col] = std::min<float>(std::min<float>(sw, se), std::min<float>(nw, ne));
+            max_row[col] = std::max<float>(std::max<float>(sw, se), std::max<float>(nw, ne));
+        }
     }
-    std::sort(minmax_tiles.begin(), minmax_tiles.end());
-    minmax_tiles.erase(std::unique(minmax_tiles.begin(), minmax_tiles.end()), minmax_tiles.end());
-    std::reverse(minmax_tiles.begin(), minmax_tiles.end());
-    for(auto tile : minmax_tiles)
+}
+
+bool WriteMinMaxElevationTiles(const std::string& cdb, const TileInfo& tileinfo, const std::vector<float>& floats)
+{
+    int dim = TileDimensionForLod(tileinfo.lod);
+    if(floats.size() != size_t(dim) * dim)
+        return false;
+    auto min_floats = std::vector<float>();
+    auto max_floats = std::vector<float>();
+    MinMaxElevationFromFloats(floats, dim, min_floats, max_floats);
+    auto tile_info = tileinfo;
+    tile_info.dataset = 2;
+    tile_info.selector1 = 1;
+    auto raster_info = RasterInfoFromTileInfo(tile_info);
+    bool result = true;
+    for(int selector2 = 1; selector2 <= 2; ++selector2)
+    {
+        tile_info.selector2 = selector2;
+        auto tif_filepath = FilePathForTileInfo(tile_info);
+        auto tif_filename = FileNameForTileInfo(tile_info);
+        auto tif = cdb + "/Tiles/" + tif_filepath + "/" + tif_filename + ".tif";
+        std::remove(tif.c_str());
+        if(!WriteFloatsToTIF(tif, raster_info, (selector2 == 1) ? min_floats : max_floats, false))
+            result = false;
+    }
+    return result;
+}
+
+namespace
+{
+    class MinMaxElevationJob : public ccl::Job
     {
-        auto tile_info = TileInfoForTile(tile);
-        int dim = TileDimensionForLod(tile_info.lod);
-        auto min_floats = std::vector<float>(dim * dim);
-        auto max_floats = std::vector<float>(dim * dim);
+    public:
+        MinMaxElevationJob(ccl::JobManager* manager, const std::string& cdb, const TileInfo& tileinfo, std::atomic<size_t>& missing)
+            : Job(manager, NULL), cdb(cdb), tileinfo(tileinfo), missing(missing) { }
+
+        std::string cdb;
+        TileInfo tileinfo;
+        std::atomic<size_t>& missing;
+
+        virtual int execute(void)
         {
-            auto elevation_tile_info = tile_info;
+            auto elevation_tile_info = tileinfo;
             elevation_tile_info.dataset = 1;
             elevation_tile_info.selector1 = 1;
             elevation_tile_info.selector2 = 1;
             auto elevation_tif_filepath = FilePathForTileInfo(elevation_tile_info);
             auto elevation_tif_filename = FileNameForTileInfo(elevation_tile_info);
             auto elevation_tif = cdb + "/Tiles/" + elevation_tif_filepath + "/" + elevation_tif_filename + ".tif";
-            auto elevation_floats = FloatsFromTIF(elevation_tif);
-            if(elevation_floats.empty())
+            try
             {
-                log << elevation_tif_filename << " not found.\n\nEnsure elevation LODs are generated prior to building MinMaxElevation." << log.endl;
-                return;
-            }
-            for(int row = 0; row < dim; ++row)
-            {
-                for(int col = 0; col < dim; ++col)
+                auto elevation_floats = FloatsFromTIF(elevation_tif);
+                if(elevation_floats.empty())
                 {
-                    // note that this doesn't follow the spec exactly
-                    // - we should reference the adjacent tiles to the north/east
-                    // - we should upsample from lower LODs if available for the north/east
-                    // - coarser LODs in the minmax dataset should be taken from the higher LOD minmax rather than the associated elevation layer
-                    int index = (row * dim) + col;
-                    float sw = elevation_floats[index + 0];
-                    float se = (col + 1 < dim) ? elevation_floats[index + 1] : sw;
-                    float nw = (row + 1 < dim) ? elevation_floats[index + dim] : sw;
-                    float ne = sw;
-                    if(row + 1 < dim)
-                        ne = se;
-                    if(col + 1 < dim)
-                        ne = nw;
-                    if((row + 1 < dim) && (col + 1 < dim))
-                        elevation_floats[index + dim + 1];
-                    float min_value = std::min<float>(sw, se);
-                    min_value = std::min<float>(min_value, nw);
-                    min_value = std::min<float>(min_value, ne);
-                    min_floats[index] = min_value;
-                    float max_value = std::max<float>(sw, se);
-                    max_value = std::max<float>(max_value, nw);
-                    max_value = std::max<float>(max_value, ne);
-                    max_floats[index] = max_value;
+                    log << elevation_tif_filename << " not found." << log.endl;
+                    ++missing;
+                    return 0;
                 }
+                if(!WriteMinMaxElevationTiles(cdb, elevation_tile_info, elevation_floats))
+                    log << ccl::LERR << "unable to write MinMaxElevation for " << elevation_tif_filename << log.endl;
             }
+            catch(std::exception& e)
+            {
+                log << elevation_tif_filename << " EXCEPTION: " << e.what() << log.endl;
+            }
+            return 0;
         }
-        tile_info.dataset = 2;
-        tile_info.selector1 = 1;
-        {
-            tile_info.selector2 = 1;
-            auto tif_filepath = FilePathForTileInfo(tile_info);
-            auto tif_filename = FileNameForTileInfo(tile_info);
-            auto tif = cdb + "/Tiles/" + tif_filepath + "/" + tif_filename + ".tif";
-            auto raster_info = RasterInfoFromTileInfo(tile_info);
-            WriteFloatsToTIF(tif, raster_info, min_floats, false);
-        }
+    };
+}
+
+void BuildMinMaxElevation(const std::string& cdb, int lod_offset, int workers)
+{
+    ccl::ObjLog log;
+    auto elevation_filenames = FileNamesForTiledDataset(cdb, 1);
+    auto elevation_tileinfos = TileInfoForFileNames(elevation_filenames);
+    auto minmax_tiles = std::vector<Tile>();
+    for(auto elevation_tileinfo : elevation_tileinfos)
+    {
+        auto nsew = NSEWBoundsForTileInfo(elevation_tileinfo);
+        auto coords = CoordinatesRange(std::get<3>(nsew), std::get<2>(nsew), std::get<1>(nsew), std::get<0>(nsew));
+        auto tiles = generate_tiles(coords, Dataset((uint16_t)2), elevation_tileinfo.lod - lod_offset);
+        minmax_tiles.insert(minmax_tiles.end(), tiles.begin(), tiles.end());
+    }
+    std::sort(minmax_tiles.begin(), minmax_tiles.end());
+    minmax_tiles.erase(std::unique(minmax_tiles.begin(), minmax_tiles.end()), minmax_tiles.end());
+    std::reverse(minmax_tiles.begin(), minmax_tiles.end());
+
+    // Every minmax tile depends only on its own elevation tile.
+    std::atomic<size_t> missing { 0 };
+    {
+        std::vector<std::unique_ptr<MinMaxElevationJob>> jobs;
+        jobs.reserve(minmax_tiles.size());
+        ccl::JobManager job_manager(std::max<int>(workers, 1));
+        for(auto& tile : minmax_tiles)
         {
-            tile_info.selector2 = 2;
-            auto tif_filepath = FilePathForTileInfo(tile_info);
-            auto tif_filename = FileNameForTileInfo(tile_info);
-            auto tif = cdb + "/Tiles/" + tif_filepath + "/" + tif_filename + ".tif";
-            auto raster_info = RasterInfoFromTileInfo(tile_info);
-            WriteFloatsToTIF(tif, raster_info, max_floats, false);
+            jobs.emplace_back(new MinMaxElevationJob(&job_manager, cdb, TileInfoForTile(tile), missing));
+            job_manager.submitJob(jobs.back().get(), false);
         }
+        job_manager.waitForCompletion();
     }
+    if(missing > 0)
+        log << missing << " elevation tiles not found.\n\nEnsure elevation LODs are generated prior to building MinMaxElevation." << log.endl;
 }
 
 std::map<std::string, std::string> Defaults(const std::string& cdb)
@@ -0,0 +1,228 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#include "ctl/GridTIN.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ctl {
+
+    GridTIN::GridTIN(const std::vector<double>& xs, const std::vector<double>& ys, const std::vector<double>& zs) : xs(xs), ys(ys), zs(zs)
+    {
+        this->zs.resize(xs.size() * ys.size());
+    }
+
+    namespace
+    {
+        inline double Cross2D(double ax, double ay, double bx, double by)
+        {
+            return (ax * by) - (ay * bx);
+        }
+
+    //    Height of the plane through a, b and c at (x, y)
+        inline double PlaneZ(const Point& a, const Point& b, const Point& c, double x, double y)
+        {
+            double det = Cross2D(b.x - a.x, b.y - a.y, c.x - a.x, c.y - a.y);
+            if (det == 0)
+                return a.z;
+            double s = Cross2D(x - a.x, y - a.y, c.x - a.x, c.y - a.y) / det;
+            double t = Cross2D(b.x - a.x, b.y - a.y, x - a.x, y - a.y) / det;
+            return a.z + (s * (b.z - a.z)) + (t * (c.z - a.z));
+        }
+    }
+
+    bool GridTIN::FanFits(const Block& block, double tolerance) const
+    {
+        int rm = (block.r0 + block.r1) / 2;
+        int cm = (block.c0 + block.c1) / 2;
+        Point center = getPoint(rm, cm);
+        Point nw = getPoint(block.r0, block.c0);
+        Point ne = getPoint(block.r0, block.c1);
+        Point se = getPoint(block.r1, block.c1);
+        Point sw = getPoint(block.r1, block.c0);
+
+    //    Within each quadrant, scaling to the unit square maps the diagonals to |u| == |v|
+        for (int r = block.r0; r <= block.r1; ++r)
+        {
+            double y = ys[r];
+            double v = (r < rm) ? (center.y - y) / (center.y - nw.y) : (r > rm) ? (y - center.y) / (sw.y - center.y) : 0;
+            for (int c = block.c0; c <= block.c1; ++c)
+            {
+                double x = xs[c];
+                double u = (c < cm) ? (center.x - x) / (center.x - nw.x) : (c > cm) ? (x - center.x) / (ne.x - center.x) : 0;
+                double z;
+                if (std::abs(v) >= std::abs(u))
+                    z = (r <= rm) ? PlaneZ(center, nw, ne, x, y) : PlaneZ(center, se, sw, x, y);
+                else
+                    z = (c <= cm) ? PlaneZ(center, sw, nw, x, y) : PlaneZ(center, ne, se, x, y);
+                if (std::abs(z - getZ(r, c)) > tolerance)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void GridTIN::Subdivide(const Block& block, double tolerance, std::vector<Block>& leaves, std::vector<char>& used) const
+    {
+        size_t cols = xs.size();
+        int h = block.r1 - block.r0;
+        int w = block.c1 - block.c0;
+        bool leaf = (h <= 1) && (w <= 1);
+        if (!leaf && (h > 1) && (w > 1))
+            leaf = FanFits(block, tolerance);
+        if (leaf)
+        {
+            used[(size_t(block.r0) * cols) + block.c0] = 1;
+            used[(size_t(block.r0) * cols) + block.c1] = 1;
+            used[(size_t(block.r1) * cols) + block.c0] = 1;
+            used[(size_t(block.r1) * cols) + block.c1] = 1;
+            if ((h > 1) && (w > 1))
+                used[(size_t((block.r0 + block.r1) / 2) * cols) + ((block.c0 + block.c1) / 2)] = 1;
+            leaves.push_back(block);
+            return;
+        }
+
+    //    A block one post wide in either direction is only split along the other; its leaves end up as single cells
+        int rm = (h > 1) ? (block.r0 + block.r1) / 2 : block.r1;
+        int cm = (w > 1) ? (block.c0 + block.c1) / 2 : block.c1;
+        Subdivide(Block{ block.r0, block.c0, rm, cm }, tolerance, leaves, used);
+        if (cm < block.c1)
+            Subdivide(Block{ block.r0, cm, rm, block.c1 }, tolerance, leaves, used);
+        if (rm < block.r1)
+            Subdivide(Block{ rm, block.c0, block.r1, cm }, tolerance, leaves, used);
+        if ((rm < block.r1) && (cm < block.c1))
+            Subdivide(Block{ rm, cm, block.r1, block.c1 }, tolerance, leaves, used);
+    }
+
+    void GridTIN::Triangulate(TIN& tin, double tolerance) const
+    {
+        tin.verts.clear();
+        tin.normals.clear();
+        tin.triangles.clear();
+
+        int rows = getNumRows();
+        int cols = getNumColumns();
+        if ((rows < 2) || (cols < 2))
+            return;
+
+        std::vector<Block> leaves;
+        std::vector<char> used(size_t(rows) * cols, 0);
+        if (tolerance > 0)
+        {
+            Subdivide(Block{ 0, 0, rows - 1, cols - 1 }, tolerance, leaves, used);
+        }
+        else
+        {
+            leaves.reserve(size_t(rows - 1) * (cols - 1));
+            for (int r = 0; r + 1 < rows; ++r)
+            {
+                for (int c = 0; c + 1 < cols; ++c)
+                    leaves.push_back(Block{ r, c, r + 1, c + 1 });
+            }
+            std::fill(used.begin(), used.end(), char(1));
+        }
+
+    //    Number the kept posts in row-major order
+        const ID invalid = ID(-1);
+        IDList index(used.size(), invalid);
+        for (size_t i = 0, c = used.size(); i < c; ++i)
+        {
+            if (!used[i])
+                continue;
+            index[i] = ID(tin.verts.size());
+            tin.verts.push_back(getPoint(int(i / cols), int(i % cols)));
+        }
+        tin.normals.resize(tin.verts.size());
+        tin.triangles.reserve(leaves.size() * 6);
+
+        auto emit = [&](size_t ia, size_t ib, size_t ic)
+        {
+            ID a = index[ia];
+            ID b = index[ib];
+            ID c = index[ic];
+            Vector normal = (tin.verts[b] - tin.verts[a]).cross(tin.verts[c] - tin.verts[a]);
+            if (normal.z == 0)
+                return;
+            if (normal.z < 0)
+            {
+                std::swap(b, c);
+                normal *= -1;
+            }
+            tin.triangles.push_back(a);
+            tin.triangles.push_back(b);
+            tin.triangles.push_back(c);
+            tin.normals[a] += normal;
+            tin.normals[b] += normal;
+            tin.normals[c] += normal;
+        };
+
+        std::vector<size_t> ring;
+        for (const Block& block : leaves)
+        {
+            size_t nw = (size_t(block.r0) * cols) + block.c0;
+            size_t ne = (size_t(block.r0) * cols) + block.c1;
+            size_t sw = (size_t(block.r1) * cols) + block.c0;
+            size_t se = (size_t(block.r1) * cols) + block.c1;
+            if ((block.r1 - block.r0 <= 1) && (block.c1 - block.c0 <= 1))
+            {
+                emit(nw, sw, se);
+                emit(nw, se, ne);
+                continue;
+            }
+
+        //    Fan around the center, through every kept post on the block's edges
+            ring.clear();
+            for (int c = block.c0; c < block.c1; ++c)
+            {
+                if (used[(size_t(block.r0) * cols) + c])
+                    ring.push_back((size_t(block.r0) * cols) + c);
+            }
+            for (int r = block.r0; r < block.r1; ++r)
+            {
+                if (used[(size_t(r) * cols) + block.c1])
+                    ring.push_back((size_t(r) * cols) + block.c1);
+            }
+            for (int c = block.c1; c > block.c0; --c)
+            {
+                if (used[(size_t(block.r1) * cols) + c])
+                    ring.push_back((size_t(block.r1) * cols) + c);
+            }
+            for (int r = block.r1; r > block.r0; --r)
+            {
+                if (used[(size_t(r) * cols) + block.c0])
+                    ring.push_back((size_t(r) * cols) + block.c0);
+            }
+            size_t center = (size_t((block.r0 + block.r1) / 2) * cols) + ((block.c0 + block.c1) / 2);
+            for (size_t i = 0, c = ring.size(); i < c; ++i)
+                emit(center, ring[i], ring[(i + 1) % c]);
+        }
+
+        for (size_t i = 0, c = tin.normals.size(); i < c; ++i)
+        {
+            if (tin.normals[i].length() == 0)
+                tin.normals[i] = Vector(0, 0, 1);
+            else
+                tin.normals[i].normalize();
+        }
+    }
+
+}
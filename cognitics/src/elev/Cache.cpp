@@ -20,12 +20,24 @@ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 //! \file Cache.cpp
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 #include "elev/Cache.h"
 #include "elev/DataSource.h"
 
 namespace elev
 {
+    size_t Cache::KeyHash::operator()(const Key &key) const
+    {
+        // mix the bits so neighbouring blocks of one source spread across shards
+        uint64_t h = uint64_t(reinterpret_cast<uintptr_t>(key.owner)) ^ (uint64_t(key.offset) * 0x9E3779B97F4A7C15ULL);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        return size_t(h);
+    }
+
     Cache::~Cache()
     {
         Clear();
@@ -33,63 +45,80 @@ namespace elev
 
     void Cache::Clear()
     {
-        while(!entries.empty())
+        for(size_t i = 0; i < NumShards; ++i)
+        {
+            EntryList released;
+            {
+                ccl::scoped_mutex lock(&shards[i].mutex);
+                released.swap(shards[i].entries);
+                shards[i].index.clear();
+                shards[i].size = 0;
+            }
+        }
+    }
+
+    unsigned int Cache::GetSize(void)
+    {
+        size_t size = 0;
+        for(size_t i = 0; i < NumShards; ++i)
         {
-            CacheEntry *entry = entries.back();
-            entries.pop_back();
-            delete entry;
+            ccl::scoped_mutex lock(&shards[i].mutex);
+            size += shards[i].size;
         }
-        size = 0;
+        return (unsigned int)size;
     }
 
-    CacheEntry *Cache::GetEntry(DataSource *owner, unsigned int offset, unsigned int size)
+    CacheEntryPtr Cache::GetEntry(DataSource *owner, unsigned int offset, unsigned int size)
     {
-        if(size > this->maxsize)    // entry too large for the cache
+        const size_t maxsize = this->maxsize.load();
+        if(size > maxsize)    // entry too large for the cache
         {
             throw std::runtime_error("Cache::GetEntry(): requested entry size > maximum cache size");
-            return NULL;
+            return CacheEntryPtr();
         }
 
-        std::list<CacheEntry *>::iterator entry_i = entries.begin();
-        while(entry_i != entries.end())
+        Key key = { owner, offset };
+        size_t hash = KeyHash()(key);
+        Shard &shard = shards[(hash >> 7) % NumShards];
+        const size_t budget = std::max<size_t>(maxsize / NumShards, size);
+
+        // evicted entries are released after the shard lock is dropped, since destroying
+        // an entry unrefs its owner and may close a dataset
+        std::vector<CacheEntryPtr> evicted;
+        CacheEntryPtr entry;
         {
-            CacheEntry *entry = *entry_i;
-            if(entry->IsMatch(owner, offset))
+            ccl::scoped_mutex lock(&shard.mutex);
+            auto it = shard.index.find(key);
+            if(it != shard.index.end())
             {
-                if(entry_i == entries.begin())
-                {
-                    ++hits;
-                    return(entry);
-                }
                 // move the element to the front of the list and return our match
-                entry_i = entries.erase(entry_i);
-                entries.push_front(entry);
+                if(it->second != shard.entries.begin())
+                    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
                 ++hits;
-                return(entry);
+                return shard.entries.front();
             }
-            else ++entry_i;
-        }
 
-        this->size += size;
+            // make space at the end of the list (oldest)
+            shard.size += size;
+            while((shard.size > budget) && !shard.entries.empty())
+            {
+                CacheEntryPtr &oldest = shard.entries.back();
+                Key oldest_key = { oldest->owner, oldest->offset };
+                shard.index.erase(oldest_key);
+                shard.size -= oldest->size;
+                evicted.push_back(oldest);
+                shard.entries.pop_back();
+            }
 
-        // make space at the end of the list (oldest)
-        while(this->size > this->maxsize)
-        {
-            CacheEntry *entry = entries.back();
-            entries.pop_back();
-            this->size -= entry->size;
-            delete entry;
+            entry.reset(new CacheEntry(owner, offset, size));
+            shard.entries.push_front(entry);
+            shard.index[key] = shard.entries.begin();
         }
 
-        CacheEntry *entry = new CacheEntry(owner, offset, size);
-        entries.push_front(entry);
-
         ++misses;
-
+        evictions += evicted.size();
         return entry;
     }
 
 }
 
-
-
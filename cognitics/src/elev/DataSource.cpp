@@ -118,6 +118,22 @@ namespace elev
         return true;
     }
 
+    void DataSource::AppToFile(double &x, double &y)
+    {
+        if(!file_ct)
+            return;
+        ccl::scoped_mutex lock(&ctMutex);
+        file_ct->Transform(1, &x, &y);
+    }
+
+    void DataSource::FileToApp(double &x, double &y)
+    {
+        if(!app_ct)
+            return;
+        ccl::scoped_mutex lock(&ctMutex);
+        app_ct->Transform(1, &x, &y);
+    }
+
     void DataSource::ref(void)
     {
         ++refcount;
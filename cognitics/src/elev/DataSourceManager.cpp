@@ -81,6 +81,13 @@ namespace elev
     }
 
     void ElevationBSP::getSourcesForPoint(double x, double y, std::list<DataSource_Raster *> &result)
+    {
+        std::vector<DataSource_Raster *> sources_for_point;
+        getSourcesForPoint(x, y, sources_for_point);
+        result.insert(result.end(), sources_for_point.begin(), sources_for_point.end());
+    }
+
+    void ElevationBSP::getSourcesForPoint(double x, double y, std::vector<DataSource_Raster *> &result)
     {
         for(std::list<DataSource_Raster *>::iterator it = sources.begin(), end = sources.end(); it != end; ++it)
         {
@@ -195,9 +202,7 @@ namespace elev
 
     int DataSourceManager::GetPostsForPoint(double x, double y, std::vector<DataPost*> &posts)
     {
-#ifdef DEBUG
-        log << ccl::LDEBUG << "GetPostsForPoint(" << x << ", " << y << ", &)" << log.endl;
-#endif
+        CCL_LOG(log, ccl::LDEBUG) << "GetPostsForPoint(" << x << ", " << y << ", &)" << log.endl;
         std::vector<DataSource *> search_sources;
         search_sources.reserve(32);
         if(bsp.generated)
@@ -222,6 +227,20 @@ namespace elev
         return results;
     }
 
+    void DataSourceManager::GetSourcesForPoint(double x, double y, std::vector<DataSource_Raster *> &result)
+    {
+        if(bsp.generated)
+        {
+            bsp.getSourcesForPoint(x, y, result);
+            return;
+        }
+        for(size_t i = 0, c = sources.size(); i < c; i++)
+        {
+            if(sources[i]->GetType() == DATASOURCE_TYPE_RASTER)
+                result.push_back((DataSource_Raster *)sources[i]);
+        }
+    }
+
     void DataSourceManager::generateBSP(void)
     {
         for(size_t i = 0, c = sources.size(); i < c; ++i)
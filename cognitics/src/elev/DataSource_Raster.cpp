@@ -34,6 +34,8 @@ namespace elev
         this->rotation_y = 1;
     }
 
+    const int DataSource_Raster::PostOffsets[4][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 0 } };
+
     void DataSource_Raster::set_priority(int p)
     {
         priority = p;
@@ -74,8 +76,7 @@ namespace elev
 #ifdef DEBUG
         log << ccl::LDEBUG << "GetPostsForPoint(" << file_x << ", " << file_y << ", &)" << log.endl;
 #endif
-        if(file_ct)
-            file_ct->Transform(1, &file_x, &file_y);
+        AppToFile(file_x, file_y);
 
         std::vector<sfa::Point> points;
 
@@ -86,34 +87,57 @@ namespace elev
 
         double px, py;
 
-        pixel_to_file_cs(ipx, ipy, px, py);
-        if(CheckBounds(px, py) && ValidatePost(px, py))
-            points.push_back(sfa::Point(px, py));
-
-        pixel_to_file_cs(ipx, ipy + 1, px, py);
-        if(CheckBounds(px, py) && ValidatePost(px, py))
-            points.push_back(sfa::Point(px, py));
-
-        pixel_to_file_cs(ipx + 1, ipy + 1, px, py);
-        if(CheckBounds(px, py) && ValidatePost(px, py))
-            points.push_back(sfa::Point(px, py));
-
-        pixel_to_file_cs(ipx + 1, ipy, px, py);
-        if(CheckBounds(px, py) && ValidatePost(px, py))
-            points.push_back(sfa::Point(px, py));
+        for(int i = 0; i < 4; ++i)
+        {
+            pixel_to_file_cs(ipx + PostOffsets[i][0], ipy + PostOffsets[i][1], px, py);
+            if(CheckBounds(px, py) && ValidatePost(px, py))
+                points.push_back(sfa::Point(px, py));
+        }
 
         for(size_t i = 0, c = points.size(); i < c; ++i)
         {
             double app_x = points[i].X();
             double app_y = points[i].Y();
-            if(app_ct)
-                app_ct->Transform(1, &app_x, &app_y);
+            FileToApp(app_x, app_y);
             DataPost *dp = new DataPost(this, app_x, app_y);
             geoposts.push_back(dp);
         }
         return points.size();
     }
 
+    int DataSource_Raster::GetPostValuesForPoint(double x, double y, double *post_x, double *post_y, double *values)
+    {
+        double file_x = x;
+        double file_y = y;
+        AppToFile(file_x, file_y);
+
+        double dpx, dpy;
+        file_cs_to_pixel(file_x, file_y, dpx, dpy);
+        int ipx = std::floor(dpx);
+        int ipy = std::floor(dpy);
+
+        int count = 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            double px, py;
+            pixel_to_file_cs(ipx + PostOffsets[i][0], ipy + PostOffsets[i][1], px, py);
+            if(!CheckBounds(px, py) || !ValidatePost(px, py))
+                continue;
+            double app_x = px;
+            double app_y = py;
+            FileToApp(app_x, app_y);
+            // a post that fails to load keeps a zero value, as a DataPost does
+            double value;
+            if(!GetValue(app_x, app_y, value))
+                value = 0;
+            post_x[count] = app_x;
+            post_y[count] = app_y;
+            values[count] = value;
+            ++count;
+        }
+        return count;
+    }
+
     bool DataSource_Raster::GetValue(DataPost *post, double &value, int index)
     {
         return GetValue(post->X(), post->Y(), value, index);
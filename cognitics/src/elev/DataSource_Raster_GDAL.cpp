@@ -261,9 +261,7 @@ namespace elev
 
     bool DataSource_Raster_GDAL::ValidatePost(double file_x, double file_y)
     {
-#ifdef DEBUG
-        log << ccl::LDEBUG << "ValidatePost(" << file_x << ", " << file_y << ")" << log.endl;
-#endif
+        CCL_LOG(log, ccl::LDEBUG) << "ValidatePost(" << file_x << ", " << file_y << ")" << log.endl;
         double value;
         if(!LoadValue(file_x, file_y, value, 1))
             return false;
@@ -275,21 +273,16 @@ namespace elev
 
     bool DataSource_Raster_GDAL::GetValue(double post_x, double post_y, double &value, int index)
     {
-#ifdef DEBUG
-        log << ccl::LDEBUG << "GetValue(" << post_x << ", " << post_y << ", &)" << log.endl;
-#endif
+        CCL_LOG(log, ccl::LDEBUG) << "GetValue(" << post_x << ", " << post_y << ", &)" << log.endl;
         double file_x = post_x;
         double file_y = post_y;
-        if(file_ct)
-            file_ct->Transform(1, &file_x, &file_y);
+        AppToFile(file_x, file_y);
         return LoadValue(file_x, file_y, value, index);
     }
 
     int DataSource_Raster_GDAL::GetValues(double post_x, double post_y, std::vector<double> &values)
     {
-#ifdef DEBUG
-        log << ccl::LDEBUG << "GetValues(" << post_x << ", " << post_y << ", &)" << log.endl;
-#endif
+        CCL_LOG(log, ccl::LDEBUG) << "GetValues(" << post_x << ", " << post_y << ", &)" << log.endl;
         for(size_t i = 0; i < depth; i++)
         {
             double value;
@@ -299,12 +292,48 @@ namespace elev
         return int(depth);
     }
 
+    int DataSource_Raster_GDAL::GetPostValuesForPoint(double x, double y, double *post_x, double *post_y, double *values)
+    {
+        // projected sources round-trip each post through the transforms, as GetPostsForPoint() does
+        if(file_ct)
+            return DataSource_Raster::GetPostValuesForPoint(x, y, post_x, post_y, values);
+
+        double dpx, dpy;
+        file_cs_to_pixel(x, y, dpx, dpy);
+        int ipx = std::floor(dpx);
+        int ipy = std::floor(dpy);
+
+        CacheEntryPtr block;
+        unsigned int block_key = 0;
+        int count = 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            double px, py;
+            pixel_to_file_cs(ipx + PostOffsets[i][0], ipy + PostOffsets[i][1], px, py);
+            if(!CheckBounds(px, py))
+                continue;
+            double value;
+            if(!LoadValue(px, py, value, 1, block, block_key))
+                continue;
+            post_x[count] = px;
+            post_y[count] = py;
+            values[count] = value;
+            ++count;
+        }
+        return count;
+    }
+
     bool DataSource_Raster_GDAL::LoadValue(double file_x, double file_y, double &value, int index)
+    {
+        CacheEntryPtr block;
+        unsigned int block_key = 0;
+        return LoadValue(file_x, file_y, value, index, block, block_key);
+    }
+
+    bool DataSource_Raster_GDAL::LoadValue(double file_x, double file_y, double &value, int index, CacheEntryPtr &block, unsigned int &block_key)
     {
         
-#ifdef DEBUG
-        log << ccl::LDEBUG << "LoadValue(" << file_x << ", " << file_y << ", &)" << log.endl;
-#endif
+        CCL_LOG(log, ccl::LDEBUG) << "LoadValue(" << file_x << ", " << file_y << ", &)" << log.endl;
         std::pair<int, int> &blocksize_pair = blocksizes.at(index - 1);
         int size_x = blocksize_pair.first;
         int size_y = blocksize_pair.second;
@@ -323,13 +352,25 @@ namespace elev
         //log << ccl::LDEBUG << "LoadValue(" << file_x << ", " << file_y << ") ; pixel(" << pixel_x << "," << pixel_y << ") ; size(" << size_x << "," << size_y << ")" << log.endl;
 
         int datasize = GDALGetDataTypeSize(datatypes.at(index - 1)) / 8;
-        CacheEntry *entry = cache->GetEntry(this, (block_offset_y * size_x) + block_offset_x, datasize * size_x * size_y);
+        unsigned int key = (block_offset_y * size_x) + block_offset_x;
+        if(!block || (block_key != key))
+        {
+            block = cache->GetEntry(this, key, datasize * size_x * size_y);
+            block_key = key;
+        }
+        CacheEntry *entry = block.get();
         if(!entry->loaded)
         {
-            GDALRasterBand *gdal_rasterband = gdal_dataset->GetRasterBand(index);
-            if (gdal_rasterband->ReadBlock(block_offset_x, block_offset_y, entry->data) != CE_None)
-                return false;
-            entry->loaded = true;
+            // the first thread to miss on a block reads it; others wait on the entry
+            ccl::scoped_mutex entry_lock(&entry->mutex);
+            if(!entry->loaded)
+            {
+                ccl::scoped_mutex dataset_lock(&datasetMutex);
+                GDALRasterBand *gdal_rasterband = gdal_dataset->GetRasterBand(index);
+                if (gdal_rasterband->ReadBlock(block_offset_x, block_offset_y, entry->data) != CE_None)
+                    return false;
+                entry->loaded = true;
+            }
         }
         value = SRCVAL(entry->data, datatypes.at(index - 1), ((pixel_y % size_y) * size_x) + (pixel_x % size_x));
 
@@ -340,6 +381,7 @@ namespace elev
 
     void DataSource_Raster_GDAL::ref(void)
     {
+        ccl::scoped_mutex lock(&datasetMutex);
         if (refcount == 0)
         {
             std::string tableName;
@@ -364,6 +406,7 @@ namespace elev
 
     void DataSource_Raster_GDAL::unref(void)
     {
+        ccl::scoped_mutex lock(&datasetMutex);
         DataSource::unref();
         if(refcount == 0)
         {
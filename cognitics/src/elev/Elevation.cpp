@@ -53,39 +53,54 @@ namespace elev
             }
         }
 
+        for(size_t i = 0, c = points.size(); i < c; i++)
+        {
+            Load(points.at(i));
+            if(strategy == ELEVATION_NEAREST)
+                break;
+        }
+
+        return Interpolate(sample_point, points.data(), points.size());
+    }
+
+    bool Elevation::Interpolate(Point *sample_point, Point *const *posts, size_t count)
+    {
         cts::FlatEarthProjection *flat_earth_projection = NULL;
         {
             static const double blocksize = 0.1f;
             int offset_x = std::floor((sample_point->X() + (blocksize / 2)) / blocksize);
             int offset_y = std::floor((sample_point->Y() + (blocksize / 2)) / blocksize);
-            sfa::Point origin(offset_x * blocksize, offset_y * blocksize);
-            std::map<sfa::Point, cts::FlatEarthProjection>::iterator it = flat_earth_projection_by_origin.find(origin);
-            if(it == flat_earth_projection_by_origin.end())
+            if(last_projection && (offset_x == last_origin_x) && (offset_y == last_origin_y))
+                flat_earth_projection = last_projection;
+            else
             {
-                flat_earth_projection_by_origin[origin] = cts::FlatEarthProjection(origin.Y(), origin.X());
-                it = flat_earth_projection_by_origin.find(origin);
+                sfa::Point origin(offset_x * blocksize, offset_y * blocksize);
+                std::map<sfa::Point, cts::FlatEarthProjection>::iterator it = flat_earth_projection_by_origin.find(origin);
+                if(it == flat_earth_projection_by_origin.end())
+                {
+                    flat_earth_projection_by_origin[origin] = cts::FlatEarthProjection(origin.Y(), origin.X());
+                    it = flat_earth_projection_by_origin.find(origin);
+                }
+                flat_earth_projection = &it->second;
+                last_projection = flat_earth_projection;
+                last_origin_x = offset_x;
+                last_origin_y = offset_y;
             }
-            flat_earth_projection = &it->second;
         }
 
         sfa::Point fe_sample_point = sample_point;
         fe_sample_point.setX(flat_earth_projection->convertGeoToLocalX(fe_sample_point.X()));
         fe_sample_point.setY(flat_earth_projection->convertGeoToLocalY(fe_sample_point.Y()));
 
-        std::vector<sfa::Point> fe_points(points.size());
-        for(size_t i = 0, c = fe_points.size(); i < c; i++)
+        fe_points.resize(count);
+        for(size_t i = 0; i < count; i++)
         {
-            sfa::Point *point = points.at(i);
-            sfa::Point &fe_point = fe_points.at(i);
+            const sfa::Point *point = posts[i];
+            sfa::Point &fe_point = fe_points[i];
             fe_point.setX(flat_earth_projection->convertGeoToLocalX(point->X()));
             fe_point.setY(flat_earth_projection->convertGeoToLocalY(point->Y()));
         }
 
-        std::vector<double> distances(points.size());
-        for(size_t i = 0, c = fe_points.size(); i < c; i++)
-            distances[i] = fe_sample_point.distance(&fe_points[i]);
-
-
         enum elevation_strategy strat = strategy;
         sfa::Point * nearest1 = NULL;
         sfa::Point * nearest2 = NULL;
@@ -98,11 +113,10 @@ namespace elev
         sfa::Point * se = NULL;
         sfa::Point * sw = NULL;
 
-        for(size_t i = 0, c = points.size(); i < c; i++)
+        for(size_t i = 0; i < count; i++)
         {
-            sfa::Point *point = points.at(i);
-            sfa::Point &fe_point = fe_points.at(i);
-            Load(point);
+            const sfa::Point *point = posts[i];
+            sfa::Point &fe_point = fe_points[i];
             fe_point.setZ(point->Z());
 
             if(nearest1)
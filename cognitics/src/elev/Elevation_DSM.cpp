@@ -5,6 +5,8 @@ Copyright 2017 Cognitics, Inc.
 //#pragma optimize("", off)
 
 #include <float.h>
+#include <algorithm>
+#include <functional>
 #include "elev/Elevation_DSM.h"
 
 #include <ccl/Profile.h>
@@ -197,5 +199,110 @@ namespace elev
         return result;
     }
 
-}
+    bool Elevation_DSM::GetBuffered(double x, double y, double &z)
+    {
+        if(dsm->generate_debug_features)
+        {
+            sfa::Point p(x, y);
+            if(!Get(&p))
+                return false;
+            z = p.Z();
+            return true;
+        }
+
+        batch_sources.clear();
+        dsm->GetSourcesForPoint(x, y, batch_sources);
+        if(batch_posts.size() < batch_sources.size() * 4)
+        {
+            batch_posts.resize(batch_sources.size() * 4);
+            batch_post_sources.resize(batch_posts.size());
+        }
+
+        size_t count = 0;
+        for(size_t i = 0, c = batch_sources.size(); i < c; ++i)
+        {
+            double post_x[4], post_y[4], values[4];
+            int posts = batch_sources[i]->GetPostValuesForPoint(x, y, post_x, post_y, values);
+            for(int j = 0; j < posts; ++j, ++count)
+            {
+                batch_posts[count].setX(post_x[j]);
+                batch_posts[count].setY(post_y[j]);
+                batch_posts[count].setZ(values[j]);
+                batch_post_sources[count] = batch_sources[i];
+            }
+        }
+        if(count == 0)
+            return false;
+
+        // same choice as find_best_datasource_with_desired_posts(): the first source, in map order, with enough posts
+        size_t desired_posts = get_num_posts_for_strategy(GetStrategy());
+        std::less<DataSource_Raster *> source_order;
+        DataSource_Raster *sole_source = NULL;
+        for(size_t i = 0; i < count; ++i)
+        {
+            DataSource_Raster *source = batch_post_sources[i];
+            if(sole_source && !source_order(source, sole_source))
+                continue;
+            size_t source_posts = std::count(batch_post_sources.begin(), batch_post_sources.begin() + count, source);
+            if(source_posts >= desired_posts)
+                sole_source = source;
+        }
+
+        batch_selected.clear();
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(!sole_source || (batch_post_sources[i] == sole_source))
+                batch_selected.push_back(&batch_posts[i]);
+        }
+
+        // test for point on post
+        for(size_t i = 0, c = batch_selected.size(); i < c; ++i)
+        {
+            if((batch_selected[i]->X() == x) && (batch_selected[i]->Y() == y))
+            {
+                z = batch_selected[i]->Z();
+                return true;
+            }
+        }
+
+        batch_sample.setX(x);
+        batch_sample.setY(y);
+        if(!Interpolate(&batch_sample, batch_selected.data(), batch_selected.size()))
+            return false;
+        z = batch_sample.Z();
+        return true;
+    }
 
+    size_t Elevation_DSM::Get(const double *xs, const double *ys, float *zs, size_t n)
+    {
+        size_t result = 0;
+        for(size_t i = 0; i < n; ++i)
+        {
+            double z;
+            if(!GetBuffered(xs[i], ys[i], z))
+                continue;
+            zs[i] = float(z);
+            ++result;
+        }
+        return result;
+    }
+
+    size_t Elevation_DSM::GetGrid(double x0, double y0, double spacing_x, double spacing_y, int width, int height, float *zs)
+    {
+        size_t result = 0;
+        for(int row = 0; row < height; ++row)
+        {
+            double y = y0 + (row * spacing_y);
+            for(int col = 0; col < width; ++col)
+            {
+                double z;
+                if(!GetBuffered(x0 + (col * spacing_x), y, z))
+                    continue;
+                zs[(row * width) + col] = float(z);
+                ++result;
+            }
+        }
+        return result;
+    }
+
+}
@@ -29,6 +29,23 @@ DEALINGS IN THE SOFTWARE.
 #include <cts/FlatEarthProjection.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+#if _WIN32
+#include <filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#elif __GNUC__ && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#else
+#include <filesystem>
+#endif
 
 int g_debugMode = 0;
 bool g_UseProjDLL = false;
@@ -40,6 +57,8 @@ namespace gdalsampler
     const int CacheManager::CACHE_BLOCK_HEIGHT = 3000;
     const int CacheManager::CACHE_BLOCK_WIDTH = 3000;
 
+    static std::atomic<ccl::uint64_t> next_raster_file_id(1);
+
     TransformCache *TransformCache::instance = NULL;
     ccl::mutex transform_cache_singleton_mutex;
     TransformCache *TransformCache::getInstance()
@@ -295,7 +314,7 @@ namespace gdalsampler
         return false;
     }
 
-    GDALReader::GDALReader() :okToSort(false)
+    GDALReader::GDALReader() : _catalog(NULL), okToSort(false)
     {
         sortLock.unlock();
         log.init("GDALReader");
@@ -332,64 +351,66 @@ namespace gdalsampler
             return false;
         }
 
-        if (!xformset)
-        {
-            //Get the source and dest SRS, and look them up from the cache
-            char *psrfstr = new char[4096];
-            char *srfstr = psrfstr;
-            strncpy(srfstr, poDataset->GetProjectionRef(), 4096);
-            srfstr[4095] = '\0';//make sure it'm_bottom NULL terminated on an overflow
-            std::string filesrswkt(psrfstr);            
-
-            char *pszSRS_WKT = NULL;
-            destsrs.exportToWkt(&pszSRS_WKT);
-            std::string destsrswkt(pszSRS_WKT);            
-            
-            //Get from the command line parameter            
-            xformset = TransformCache::getInstance()->getTransforms(filesrswkt, destsrswkt);
-            delete[] psrfstr;
-            CPLFree(pszSRS_WKT);
-        }
+        // The WKT has always been cut at 4095 characters; the transform cache is keyed by it.
+        char *psrfstr = new char[4096];
+        char *srfstr = psrfstr;
+        strncpy(srfstr, poDataset->GetProjectionRef(), 4096);
+        srfstr[4095] = '\0';//make sure it'm_bottom NULL terminated on an overflow
+        _record.wkt = psrfstr;
+        delete[] psrfstr;
 
         auto area_or_point_ptr = poDataset->GetMetadataItem("AREA_OR_POINT");
         if(area_or_point_ptr != nullptr)
         {
             auto area_or_point = std::string(poDataset->GetMetadataItem("AREA_OR_POINT"));
             std::transform(area_or_point.begin(), area_or_point.end(), area_or_point.begin(), ::toupper);
-            pixel_is_point = (area_or_point == "POINT");
+            _record.pixel_is_point = (area_or_point == "POINT");
         }
 
         // Get the resolution and normalize it (somehow)
-        double adfGeoTransform[6];
-        if( poDataset->GetGeoTransform( adfGeoTransform ) == CE_None )
-        {
-            OGRSpatialReference oOrtho;        
-            oOrtho.SetWellKnownGeogCS( "WGS84" );        
-
-            _fileWidth = poDataset->GetRasterXSize();
-            _fileHeight = poDataset->GetRasterYSize();
-            _top = adfGeoTransform[3];
-            _left = adfGeoTransform[0];
-            _bottom = _top + (adfGeoTransform[5] * poDataset->GetRasterYSize());
-            _right = _left + (adfGeoTransform[1] * poDataset->GetRasterXSize());
+        if( poDataset->GetGeoTransform( _record.geotransform ) != CE_None )
+            return false;
+        _record.filename = filename;
+        _record.width = poDataset->GetRasterXSize();
+        _record.height = poDataset->GetRasterYSize();
+        ApplyRecord(destsrs);
+        return true;
+    }
 
-            _origEWConst = adfGeoTransform[1];
-            _origNSConst = adfGeoTransform[5];
-            adfTransform4 = adfGeoTransform[4];
-            adfTransform2 = adfGeoTransform[2];
-            _determinate = (_origEWConst * _origNSConst - adfTransform2 * adfTransform4);
-        }
-        else
+    void GDALRasterFile::ApplyRecord(OGRSpatialReference &destsrs)
+    {
+        if (!xformset)
         {
-            return false;
+            //Get the source and dest SRS, and look them up from the cache
+            char *pszSRS_WKT = NULL;
+            destsrs.exportToWkt(&pszSRS_WKT);
+            std::string destsrswkt(pszSRS_WKT);            
+            
+            //Get from the command line parameter            
+            xformset = TransformCache::getInstance()->getTransforms(_record.wkt, destsrswkt);
+            CPLFree(pszSRS_WKT);
         }
 
-        return true;
+        pixel_is_point = _record.pixel_is_point;
+
+        const double *adfGeoTransform = _record.geotransform;
+        _fileWidth = _record.width;
+        _fileHeight = _record.height;
+        _top = adfGeoTransform[3];
+        _left = adfGeoTransform[0];
+        _bottom = _top + (adfGeoTransform[5] * _fileHeight);
+        _right = _left + (adfGeoTransform[1] * _fileWidth);
+
+        _origEWConst = adfGeoTransform[1];
+        _origNSConst = adfGeoTransform[5];
+        adfTransform4 = adfGeoTransform[4];
+        adfTransform2 = adfGeoTransform[2];
+        _determinate = (_origEWConst * _origNSConst - adfTransform2 * adfTransform4);
     }
 
     
     GDALRasterFile::GDALRasterFile(OGRSpatialReference destSRS, std::string filename)
-        : _filename(filename)
+        : poDataset(NULL), _filename(filename), _id(next_raster_file_id++)
     {
         isRPF =  false;
         referenceCount = 0;
@@ -406,6 +427,27 @@ namespace gdalsampler
             xformset = NULL;
             return;
         }
+        InitCoverage();
+        Close();//Free up the file handle
+    }
+
+    GDALRasterFile::GDALRasterFile(OGRSpatialReference destSRS, const SourceRecord &record)
+        : poDataset(NULL), _filename(record.filename), _id(next_raster_file_id++), _record(record)
+    {
+        isRPF =  false;
+        referenceCount = 0;
+        references = 0;
+        log.init("GDALRasterFile");
+        log << ccl::LINFO;
+        _age = 0;
+        xformset = NULL;
+        ApplyRecord(destSRS);
+        _isValid = true;
+        InitCoverage();
+    }
+
+    void GDALRasterFile::InitCoverage()
+    {
         Quad localCoverage;
         PixelToLocalPoint(0,0,localCoverage.ul);
         PixelToLocalPoint(0,_fileWidth,localCoverage.ur);
@@ -424,11 +466,12 @@ namespace gdalsampler
         x_resolution = resX;
         y_resolution = resY;
         resolution = resX * resY;
-        Close();//Free up the file handle
     }
 
     GDALRasterFile::~GDALRasterFile()
     {    
+        // Shared blocks outlive the sampler that read them and point back at this file.
+        SharedBlockCache::getInstance()->RemoveFile(_id);
         if (poDataset)
             GDALClose(poDataset);
     }
@@ -607,8 +650,9 @@ namespace gdalsampler
 
     CachedRasterBlock::CachedRasterBlock(int xoffset, int yoffset, int width, int height, std::string filename, GDALRasterFile *file, bool lazyAlloc)
     {
-        m_ready = false;
+        m_ready.store(false, std::memory_order_relaxed);
         this->m_file = file;
+        this->m_fileId = file ? file->GetId() : 0;
         this->m_filename = filename;
         this->xoffset = xoffset;
         this->yoffset = yoffset;
@@ -686,6 +730,10 @@ namespace gdalsampler
         if(block->IsReady())
             return true;
 
+        SharedBlockCache *shared = SharedBlockCache::getInstance();
+        if(shared->IsEnabled())
+            return shared->PageBlock(block);
+
         int blocksize = (block->xsize * block->ysize * 3);
         CachedRasterBlockList::iterator block_iter = _altBlockCache.begin();
         while(block_iter!=_altBlockCache.end())
@@ -719,6 +767,195 @@ namespace gdalsampler
         return true;
     }
 
+    SharedBlockCache *SharedBlockCache::getInstance()
+    {
+        static SharedBlockCache instance;
+        return &instance;
+    }
+
+    void SharedBlockCache::SetBudget(size_t bytes)
+    {
+        _budget.store(bytes, std::memory_order_release);
+        std::vector<CachedRasterBlockPtr> victims;
+        for(int i = 0; i < NUM_SHARDS; ++i)
+        {
+            ccl::scoped_mutex lock(&_shards[i].lock);
+            Evict(_shards[i], bytes / NUM_SHARDS, victims);
+        }
+        for(size_t i = 0, c = victims.size(); i < c; ++i)
+            victims[i]->UnloadBlock();
+    }
+
+    SharedBlockCache::Key SharedBlockCache::KeyForBlock(const CachedRasterBlock *block)
+    {
+        Key key = { block->m_fileId, block->xoffset, block->yoffset, block->xsize, block->ysize };
+        return key;
+    }
+
+    size_t SharedBlockCache::KeyHash::operator()(const Key &key) const
+    {
+        // Boost style hash_combine over the fields.
+        size_t seed = std::hash<ccl::uint64_t>()(key.file);
+        const int fields[4] = { key.xoffset, key.yoffset, key.xsize, key.ysize };
+        for(int i = 0; i < 4; ++i)
+            seed ^= std::hash<int>()(fields[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+
+    size_t SharedBlockCache::BytesForBlock(const CachedRasterBlock *block)
+    {
+        size_t pixels = size_t(block->xsize) * size_t(block->ysize);
+        return block->elev ? pixels * sizeof(float) : pixels * 3;
+    }
+
+    SharedBlockCache::Shard &SharedBlockCache::ShardForKey(const Key &key)
+    {
+        // The high bits pick the shard so the low bits still spread entries across each shard's buckets.
+        return _shards[(KeyHash()(key) >> 16) % NUM_SHARDS];
+    }
+
+    // Called with the shard locked. Blocks that are still referenced outside the
+    // cache are skipped; the rest are handed back so they can be unloaded after
+    // the lock is released (unloading may close the GDAL dataset).
+    void SharedBlockCache::Evict(Shard &shard, size_t budget, std::vector<CachedRasterBlockPtr> &victims)
+    {
+        std::list<Key>::iterator it = shard.lru.end();
+        while((shard.bytes > budget) && (it != shard.lru.begin()))
+        {
+            --it;
+            std::unordered_map<Key, Entry, KeyHash>::iterator entry = shard.entries.find(*it);
+            if(entry->second.block.use_count() > 1)
+                continue;
+            shard.bytes -= entry->second.bytes;
+            if(entry->second.block->IsReady())
+                victims.push_back(entry->second.block);
+            shard.entries.erase(entry);
+            it = shard.lru.erase(it);
+            ++shard.evictions;
+        }
+    }
+
+    bool SharedBlockCache::PageBlock(CachedRasterBlockPtr &block)
+    {
+        Key key = KeyForBlock(block.get());
+        Shard &shard = ShardForKey(key);
+
+        CachedRasterBlockPtr cached;
+        boost::shared_ptr<ccl::mutex> readLock;
+        {
+            ccl::scoped_mutex lock(&shard.lock);
+            std::unordered_map<Key, Entry, KeyHash>::iterator it = shard.entries.find(key);
+            if(it != shard.entries.end())
+            {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru);
+                cached = it->second.block;
+                readLock = it->second.readLock;
+                if(cached->IsReady())
+                {
+                    ++shard.hits;
+                    block = cached;
+                    return true;
+                }
+            }
+            else
+            {
+                shard.lru.push_front(key);
+                Entry &entry = shard.entries[key];
+                entry.block = block;
+                entry.readLock.reset(new ccl::mutex);
+                entry.lru = shard.lru.begin();
+                cached = block;
+                readLock = entry.readLock;
+            }
+        }
+
+        // Only one thread decodes a given block; the others wait here and then
+        // find it ready.
+        {
+            ccl::scoped_mutex lock(readLock.get());
+            if(!cached->IsReady())
+            {
+                cached->ReadBlock();
+                std::vector<CachedRasterBlockPtr> victims;
+                {
+                    ccl::scoped_mutex lock(&shard.lock);
+                    ++shard.misses;
+                    std::unordered_map<Key, Entry, KeyHash>::iterator it = shard.entries.find(key);
+                    if(it != shard.entries.end())
+                    {
+                        size_t bytes = cached->IsReady() ? BytesForBlock(cached.get()) : 0;
+                        shard.bytes += bytes - it->second.bytes;
+                        it->second.bytes = bytes;
+                    }
+                    Evict(shard, GetBudget() / NUM_SHARDS, victims);
+                }
+                for(size_t i = 0, c = victims.size(); i < c; ++i)
+                    victims[i]->UnloadBlock();
+            }
+            else
+            {
+                ccl::scoped_mutex lock(&shard.lock);
+                ++shard.hits;
+            }
+        }
+        block = cached;
+        return block->IsReady();
+    }
+
+    void SharedBlockCache::Clear()
+    {
+        std::vector<CachedRasterBlockPtr> victims;
+        for(int i = 0; i < NUM_SHARDS; ++i)
+        {
+            ccl::scoped_mutex lock(&_shards[i].lock);
+            Evict(_shards[i], 0, victims);
+        }
+        for(size_t i = 0, c = victims.size(); i < c; ++i)
+            victims[i]->UnloadBlock();
+    }
+
+    void SharedBlockCache::RemoveFile(ccl::uint64_t fileId)
+    {
+        std::vector<CachedRasterBlockPtr> victims;
+        for(int i = 0; i < NUM_SHARDS; ++i)
+        {
+            Shard &shard = _shards[i];
+            ccl::scoped_mutex lock(&shard.lock);
+            std::list<Key>::iterator it = shard.lru.begin();
+            while(it != shard.lru.end())
+            {
+                if(it->file != fileId)
+                {
+                    ++it;
+                    continue;
+                }
+                std::unordered_map<Key, Entry, KeyHash>::iterator entry = shard.entries.find(*it);
+                shard.bytes -= entry->second.bytes;
+                if(entry->second.block->IsReady())
+                    victims.push_back(entry->second.block);
+                shard.entries.erase(entry);
+                it = shard.lru.erase(it);
+            }
+        }
+        for(size_t i = 0, c = victims.size(); i < c; ++i)
+            victims[i]->UnloadBlock();
+    }
+
+    SharedBlockCache::Stats SharedBlockCache::GetStats()
+    {
+        Stats stats;
+        for(int i = 0; i < NUM_SHARDS; ++i)
+        {
+            ccl::scoped_mutex lock(&_shards[i].lock);
+            stats.hits += _shards[i].hits;
+            stats.misses += _shards[i].misses;
+            stats.evictions += _shards[i].evictions;
+            stats.bytes += _shards[i].bytes;
+            stats.blocks += _shards[i].entries.size();
+        }
+        return stats;
+    }
+
     bool CachedRasterBlock::GetInterleavedPixels(u_char *buf)
     {
         int len = xsize * ysize;
@@ -754,11 +991,12 @@ namespace gdalsampler
                 elev = new float[xsize * ysize];
                 g_GDALProtMutex.lock();
 
-                m_ready = (CE_None == band->RasterIO(GF_Read, xoffset, yoffset, xsize, ysize, elev, xsize, ysize, GDT_Float32, 0, 0));
-                if(!m_ready)
+                bool read = (CE_None == band->RasterIO(GF_Read, xoffset, yoffset, xsize, ysize, elev, xsize, ysize, GDT_Float32, 0, 0));
+                if(!read)
                     printf("Error: Failed float read x/y: %d/%d w/h: %d/%d\n", xoffset, yoffset, xsize, ysize);
                 g_GDALProtMutex.unlock();
-                return m_ready;
+                m_ready.store(read, std::memory_order_release);
+                return read;
             }
         }
 
@@ -866,14 +1104,25 @@ namespace gdalsampler
             delete[] idxs;
             g_GDALProtMutex.unlock();
         }
-        m_ready = true;
+        m_ready.store(true, std::memory_order_release);
         return true;
     }
 
     bool GDALReader::AddFile(std::string filename)
     {
         ccl::scoped_mutex m(&addmutex);
-        GDALRasterFilePtr gdalfile(new GDALRasterFile(_destSRS,filename));
+        GDALRasterFilePtr gdalfile;
+        SourceRecord record;
+        if(_catalog && _catalog->Lookup(filename, record))
+        {
+            gdalfile.reset(new GDALRasterFile(_destSRS,record));
+        }
+        else
+        {
+            gdalfile.reset(new GDALRasterFile(_destSRS,filename));
+            if(_catalog && gdalfile->IsValid())
+                _catalog->Update(gdalfile->GetRecord());
+        }
         if(gdalfile->IsValid())
         {
             double top = -DBL_MAX;
@@ -901,6 +1150,206 @@ namespace gdalsampler
         return false;
     }
 
+    namespace
+    {
+        const char CatalogMagic[8] = { 'G', 'D', 'S', 'R', 'C', 'A', 'T', '\0' };
+        // Bump when the record layout changes.
+        const ccl::uint32_t CatalogVersion = 2;
+        // Written in native order, so a catalog from a machine of the other byte order reads it reversed.
+        const ccl::uint32_t CatalogByteOrder = 0x01020304;
+
+        bool SourceStat(const std::string &filename, ccl::int64_t &mtime, ccl::uint64_t &size)
+        {
+            std::string path = filename;
+            std::string table;
+            ccl::GetFilenameAndTable(filename, path, table);
+            std::error_code ec;
+            size = ccl::uint64_t(std::filesystem::file_size(path, ec));
+            if(ec)
+                return false;
+            auto t = std::filesystem::last_write_time(path, ec);
+            if(ec)
+                return false;
+            mtime = ccl::int64_t(t.time_since_epoch().count());
+            return true;
+        }
+
+        template <typename T> void WriteValue(std::string &out, const T &value)
+        {
+            out.append((const char *)&value, sizeof(T));
+        }
+
+        void WriteString(std::string &out, const std::string &value)
+        {
+            WriteValue(out, ccl::uint32_t(value.size()));
+            out.append(value);
+        }
+
+        template <typename T> bool ReadValue(const char *&pos, const char *end, T &value)
+        {
+            if(size_t(end - pos) < sizeof(T))
+                return false;
+            memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(const char *&pos, const char *end, std::string &value)
+        {
+            ccl::uint32_t len = 0;
+            if(!ReadValue(pos, end, len) || (size_t(end - pos) < len))
+                return false;
+            value.assign(pos, len);
+            pos += len;
+            return true;
+        }
+    }
+
+    SourceCatalog::SourceCatalog() : dirty(false), hits(0), misses(0)
+    {
+        log.init("SourceCatalog");
+        log << ccl::LINFO;
+    }
+
+    // The file is one block: magic, byte order mark and version, the distinct WKTs, then
+    // fixed layout records that refer to them by index, so a catalog of many sources loads
+    // with one read. Values are in native order; a catalog written with another byte order
+    // or version is rebuilt rather than converted.
+    bool SourceCatalog::Load(const std::string &filename)
+    {
+        ccl::scoped_mutex m(&mutex);
+        _filename = filename;
+        std::ifstream infile(filename.c_str(), std::ios::binary);
+        if(!infile)
+            return false;
+        std::string bytes((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+        const char *pos = bytes.data();
+        const char *end = pos + bytes.size();
+        if((bytes.size() < sizeof(CatalogMagic)) || (memcmp(pos, CatalogMagic, sizeof(CatalogMagic)) != 0))
+        {
+            log << ccl::LWARNING << filename << " is not a source catalog; it will be rebuilt." << log.endl;
+            return false;
+        }
+        pos += sizeof(CatalogMagic);
+        ccl::uint32_t byte_order = 0;
+        ccl::uint32_t version = 0;
+        if(!ReadValue(pos, end, byte_order) || !ReadValue(pos, end, version) || (byte_order != CatalogByteOrder) || (version != CatalogVersion))
+        {
+            log << ccl::LWARNING << filename << " was written with another byte order or version; it will be rebuilt." << log.endl;
+            return false;
+        }
+        ccl::uint32_t wkt_count = 0;
+        if(!ReadValue(pos, end, wkt_count))
+            return false;
+        std::vector<std::string> wkts(wkt_count);
+        for(ccl::uint32_t i = 0; i < wkt_count; ++i)
+        {
+            if(!ReadString(pos, end, wkts[i]))
+                return false;
+        }
+        ccl::uint32_t record_count = 0;
+        if(!ReadValue(pos, end, record_count))
+            return false;
+        for(ccl::uint32_t i = 0; i < record_count; ++i)
+        {
+            SourceRecord record;
+            ccl::uint8_t pixel_is_point = 0;
+            ccl::uint32_t wkt_index = 0;
+            bool ok = ReadString(pos, end, record.filename)
+                && ReadValue(pos, end, record.mtime)
+                && ReadValue(pos, end, record.size)
+                && ReadValue(pos, end, record.width)
+                && ReadValue(pos, end, record.height)
+                && ReadValue(pos, end, record.geotransform)
+                && ReadValue(pos, end, pixel_is_point)
+                && ReadValue(pos, end, wkt_index);
+            if(!ok || (wkt_index >= wkt_count))
+                return false;
+            record.pixel_is_point = (pixel_is_point != 0);
+            record.wkt = wkts[wkt_index];
+            records[record.filename] = record;
+        }
+        log << ccl::LINFO << "Loaded " << records.size() << " sources from " << filename << log.endl;
+        return true;
+    }
+
+    bool SourceCatalog::Save()
+    {
+        ccl::scoped_mutex m(&mutex);
+        if(_filename.empty())
+            return false;
+        if(!dirty)
+            return true;
+        std::map<std::string, ccl::uint32_t> wkt_index;
+        std::vector<const std::string *> wkts;
+        for(auto &it : records)
+        {
+            if(wkt_index.insert(std::make_pair(it.second.wkt, ccl::uint32_t(wkts.size()))).second)
+                wkts.push_back(&it.second.wkt);
+        }
+        std::string bytes(CatalogMagic, sizeof(CatalogMagic));
+        WriteValue(bytes, CatalogByteOrder);
+        WriteValue(bytes, CatalogVersion);
+        WriteValue(bytes, ccl::uint32_t(wkts.size()));
+        for(auto wkt : wkts)
+            WriteString(bytes, *wkt);
+        WriteValue(bytes, ccl::uint32_t(records.size()));
+        for(auto &it : records)
+        {
+            auto &record = it.second;
+            WriteString(bytes, record.filename);
+            WriteValue(bytes, record.mtime);
+            WriteValue(bytes, record.size);
+            WriteValue(bytes, record.width);
+            WriteValue(bytes, record.height);
+            WriteValue(bytes, record.geotransform);
+            WriteValue(bytes, ccl::uint8_t(record.pixel_is_point ? 1 : 0));
+            WriteValue(bytes, wkt_index[record.wkt]);
+        }
+        std::string tmpname = _filename + ".tmp";
+        {
+            std::ofstream outfile(tmpname.c_str(), std::ios::binary | std::ios::trunc);
+            if(!outfile)
+                return false;
+            outfile.write(bytes.data(), bytes.size());
+            if(!outfile)
+                return false;
+        }
+        std::remove(_filename.c_str());
+        if(std::rename(tmpname.c_str(), _filename.c_str()) != 0)
+            return false;
+        dirty = false;
+        return true;
+    }
+
+    bool SourceCatalog::Lookup(const std::string &filename, SourceRecord &record)
+    {
+        ccl::int64_t mtime = 0;
+        ccl::uint64_t size = 0;
+        bool stat = SourceStat(filename, mtime, size);
+        ccl::scoped_mutex m(&mutex);
+        auto it = records.find(filename);
+        if(!stat || (it == records.end()) || (it->second.mtime != mtime) || (it->second.size != size))
+        {
+            ++misses;
+            return false;
+        }
+        record = it->second;
+        ++hits;
+        return true;
+    }
+
+    void SourceCatalog::Update(const SourceRecord &record)
+    {
+        // Files that can't be stat'd (/vsimem, URLs) can't be validated later.
+        SourceRecord entry = record;
+        if(!SourceStat(entry.filename, entry.mtime, entry.size))
+            return;
+        ccl::scoped_mutex m(&mutex);
+        records[entry.filename] = entry;
+        dirty = true;
+    }
+
     bool GDALReader::RemoveFile(std::string filename)
     {
         ccl::scoped_mutex m(&addmutex);
@@ -1129,9 +1578,7 @@ namespace gdalsampler
 
     bool CachedRasterBlock::UnloadBlock()
     {
-        m_ready = false;
-        age = 0;
-        m_ready = false;
+        m_ready.store(false, std::memory_order_release);
         age = 0;
         if(r)
             delete[] r;
@@ -28,10 +28,16 @@ DEALINGS IN THE SOFTWARE.
 
 #include <ccl/FileInfo.h>
 
+#ifndef COG_NO_IPP
 #define USE_IPP_LIBRARY 1
+#endif
 
+#ifdef USE_IPP_LIBRARY
 //#include "ipp_k0.h"
 #include "ipp.h"
+#endif
+
+#include "ip/WarpPerspective.h"
 
 
 #include <sfa/File.h>
@@ -43,6 +49,11 @@ DEALINGS IN THE SOFTWARE.
 
 GDALRasterSampler::GDALRasterSampler() : bsp(NULL)
 {
+#ifdef USE_IPP_LIBRARY
+    useIPP = true;
+#else
+    useIPP = false;
+#endif
     log.init("GDALRasterSampler", this);
     log << ccl::LERR;
     gdalsampler::LoadProjDLL();
@@ -50,6 +61,7 @@ GDALRasterSampler::GDALRasterSampler() : bsp(NULL)
     m_reader.SetDestSRS(geoSRS);
 }
 
+#ifdef USE_IPP_LIBRARY
 
 IppStatus WarpPerspective_8u_C3R(Ipp8u *pSrc, IppiSize srcSize, Ipp32s srcStep,
     Ipp8u *pDst, IppiSize dstSize,
@@ -230,6 +242,8 @@ IppStatus WarpPerspective_32f_C1R(Ipp32f *pSrc, IppiSize srcSize, Ipp32s srcStep
     return status;
 }
 
+#endif
+
 gdalsampler::GDALRasterFileList GDALRasterSampler::GetFilesInAOI(gdalsampler::Quad &aoi)
 {
     gdalsampler::GDALRasterFileList ret;
@@ -283,7 +297,7 @@ bool GDALRasterSampler::BuildBSP(bool rebuild)
         delete bsp;
         bsp = NULL;
     }
-    bsp = new sfa::BSP;
+    bsp = new sfa::PackedRTree;
     aoimap_t::iterator aoi_iter = aoiFileMap.begin();
     while (aoi_iter != aoiFileMap.end())
     {
@@ -293,6 +307,7 @@ bool GDALRasterSampler::BuildBSP(bool rebuild)
     aoiFileMap.clear();
     gdalsampler::GDALRasterFileList &files = m_reader.GetFiles();
     //printf("Putting %d files in a bsp\n", files.size());
+    bsp->reserve(files.size());
     gdalsampler::GDALRasterFileList::iterator file_iter = files.begin();
     while (file_iter != files.end())
     {
@@ -315,8 +330,7 @@ bool GDALRasterSampler::BuildBSP(bool rebuild)
         aoiFileMap[aoi_poly] = file;
         bsp->addGeometry(aoi_poly);
     }
-    std::map<sfa::Geometry *, sfa::LineString *> envelopes;
-    bsp->generate(envelopes);
+    bsp->generate();
     bspMutex.unlock();
     return true;
 }
@@ -398,24 +412,67 @@ bool GDALRasterSampler::AddCoverageFile(std::string shapefile)
 
 bool GDALRasterSampler::Sample(const gdalsampler::GeoExtents &window, u_char *buf)
 {
-#ifdef USE_IPP_LIBRARY
-    return SampleIPP(window,buf);
-#else
-    return SampleSoftware(window,buf);
-#endif
+    if(useIPP)
+        return SampleIPP(window,buf);
+    return SampleNative(window,buf);
 }
 
 bool GDALRasterSampler::Sample(const gdalsampler::GeoExtents &window, float *buf)
+{
+    // IPP has no masked warp, and its warps blend no-data posts into their neighbours, so
+    // elevation always takes the native composite.
+    return SampleNative(window,buf);
+}
+
+bool GDALRasterSampler::SetUseIPP(bool value)
 {
 #ifdef USE_IPP_LIBRARY
-    return SampleIPP(window,buf);
+    useIPP = value;
+    return true;
 #else
-    return SampleSoftware(window,buf);
+    useIPP = false;
+    return !value;
 #endif
 }
 
 
 int dbg_no = 0;
+int GDALRasterSampler::PrefetchBlocks(const gdalsampler::GeoExtents &window)
+{
+    if (!bsp)
+    {
+        BuildBSP(false);
+    }
+
+    gdalsampler::Quad aoi;
+    aoi.ll.setX(window.west);
+    aoi.ul.setX(window.west);
+    aoi.lr.setX(window.east);
+    aoi.ur.setX(window.east);
+    aoi.lr.setY(window.south);
+    aoi.ll.setY(window.south);
+    aoi.ur.setY(window.north);
+    aoi.ul.setY(window.north);
+
+    int count = 0;
+    gdalsampler::GDALRasterFileList files = GetFilesInAOI(aoi);
+    gdalsampler::GDALRasterFileList::iterator file_iter = files.begin();
+    while(file_iter!=files.end())
+    {
+        gdalsampler::GDALRasterFilePtr file = *file_iter++;
+        gdalsampler::CachedRasterBlockList blocks;
+        file->GetOverlappingBlocks(aoi,blocks);
+        gdalsampler::CachedRasterBlockList::iterator iter = blocks.begin();
+        while(iter!=blocks.end())
+        {
+            gdalsampler::CachedRasterBlockPtr block = *iter++;
+            gdalsampler::CacheManager::getInstance()->PageBlock(block);
+            ++count;
+        }
+    }
+    return count;
+}
+
 std::vector<gdalsampler::GeoExtents> GDALRasterSampler::GetFileExtents()
 {
     sfa::FeatureList features;
@@ -753,21 +810,19 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, u_char
     return ret;
 }
 
-bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, float *buf)
+bool GDALRasterSampler::SampleNative(const gdalsampler::GeoExtents &window, u_char *buf)
 {
     bool ret = false;
-#ifdef USE_IPP_LIBRARY
 
     if (!bsp)
     {
         BuildBSP(false);
     }
 
+    int scratchlen = window.width*window.height;
+    std::vector<u_char> scratch(scratchlen*3);
+    std::vector<u_char> interleavedbuf;
 
-    int scratchlen = window.width * window.height;
-    float *scratch = new float[scratchlen];
-    memset(scratch,0,sizeof(float)*scratchlen);
-    
     gdalsampler::CachedRasterBlockList blocks;
     gdalsampler::Quad aoi;
     aoi.ll.setX(window.west);
@@ -775,16 +830,15 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, float *
     aoi.lr.setX(window.east);
     aoi.ur.setX(window.east);
     aoi.lr.setY(window.south);
-    aoi.ll.setY(window.south);    
-    aoi.ur.setY(window.north);    
+    aoi.ll.setY(window.south);
+    aoi.ur.setY(window.north);
     aoi.ul.setY(window.north);
-    
 
-    gdalsampler::GDALRasterFileList files = GetFilesInAOI(aoi);//m_reader.GetFiles();
-    //printf("Found %d files in aoi\n", files.size());
+    gdalsampler::GDALRasterFileList files = GetFilesInAOI(aoi);
     gdalsampler::GDALRasterFileList::iterator file_iter = files.begin();
     while(file_iter!=files.end())
     {
+        memset(&scratch[0],0,scratchlen*3);
         gdalsampler::GDALRasterFilePtr file = *file_iter++;
         sfa::Polygon geoarea = file->GetValidArea();
         sfa::Polygon pixelArea;
@@ -797,21 +851,17 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, float *
             {
                 pixelArea = ProjectToPixelSpace(geoarea,window);
             }
-            //printf("Destination block intersects with %d tiles from %s.\n",blocks.size(),file->GetFilename().c_str());
         }
-
-        int index = 0;
         gdalsampler::CachedRasterBlockList::iterator iter = blocks.begin();
         while(iter!=blocks.end())
         {
             gdalsampler::CachedRasterBlockPtr block = *iter++;
             gdalsampler::CacheManager::getInstance()->PageBlock(block);
             // Don't do anything crazy if the source block doesn't match the expected type.
-            if (block->elev == nullptr)
+            if (block->r == nullptr || block->g == nullptr || block->b == nullptr)
                 continue;
-
-            IppiRect srcroi = { 0, 0, block->xsize, block->ysize };
-            IppiRect dstroi = { 0, 0, window.width, window.height };
+            interleavedbuf.resize(block->xsize*block->ysize*3);
+            block->GetInterleavedPixels(&interleavedbuf[0]);
 
             gdalsampler::Quad srcGeoQuad  = block->GetDestCoverage();
 
@@ -822,56 +872,117 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, float *
             window.GeoToPixel(srcGeoQuad.lr,pixQuad.lr);
             window.GeoToPixel(srcGeoQuad.ll,pixQuad.ll);
 
-            double srcquad[4][2];// source tile quadrangle in destination pixel space.
-            srcquad[0][0] = pixQuad.ul.X();
-            srcquad[0][1] = pixQuad.ul.Y();
+            double srcquad[4][2] = {
+                { pixQuad.ul.X(), pixQuad.ul.Y() },
+                { pixQuad.ur.X(), pixQuad.ur.Y() },
+                { pixQuad.lr.X(), pixQuad.lr.Y() },
+                { pixQuad.ll.X(), pixQuad.ll.Y() }
+            };
 
-            srcquad[1][0] = pixQuad.ur.X();
-            srcquad[1][1] = pixQuad.ur.Y();
+            double coeff[3][3];
+            if(ip::GetPerspectiveTransform(block->xsize,block->ysize,srcquad,coeff))
+            {
+                ip::WarpPerspective_8u_C3(&interleavedbuf[0], block->xsize, block->ysize, block->xsize*3,
+                    &scratch[0], window.width, window.height, window.width*3, coeff, ip::WARP_CUBIC);
+            }
+        }
+        if(blocks.size()>0)
+        {
+            ret = true;
+            if(!pixelArea.isEmpty())
+            {
+                CopyPixelsInsidePoly(&scratch[0],buf,window.width,window.height,3,pixelArea);
+            }
+            else
+            {
+                CopyNonBlackPixels(&scratch[0],buf,scratchlen);
+            }
+        }
+    }
+    return ret;
+}
 
-            srcquad[2][0] = pixQuad.lr.X();
-            srcquad[2][1] = pixQuad.lr.Y();
+bool GDALRasterSampler::SampleNative(const gdalsampler::GeoExtents &window, float *buf)
+{
+    bool ret = false;
 
-            srcquad[3][0] = pixQuad.ll.X();
-            srcquad[3][1] = pixQuad.ll.Y();
+    if (!bsp)
+    {
+        BuildBSP(false);
+    }
+
+    // Pixels already written by a higher priority source.
+    std::vector<u_char> filled(window.width * window.height, 0);
+
+    gdalsampler::CachedRasterBlockList blocks;
+    gdalsampler::Quad aoi;
+    aoi.ll.setX(window.west);
+    aoi.ul.setX(window.west);
+    aoi.lr.setX(window.east);
+    aoi.ur.setX(window.east);
+    aoi.lr.setY(window.south);
+    aoi.ll.setY(window.south);
+    aoi.ur.setY(window.north);
+    aoi.ul.setY(window.north);
+
+    // Later files take priority, so composite them first and let earlier files fill what is left.
+    gdalsampler::GDALRasterFileList files = GetFilesInAOI(aoi);
+    gdalsampler::GDALRasterFileList::reverse_iterator file_iter = files.rbegin();
+    while(file_iter!=files.rend())
+    {
+        gdalsampler::GDALRasterFilePtr file = *file_iter++;
+
+        blocks.clear();
+        file->GetOverlappingBlocks(aoi,blocks);
+
+        // Blocks overlap by at most a pixel; walk them backwards too so the last one still wins.
+        gdalsampler::CachedRasterBlockList::reverse_iterator iter = blocks.rbegin();
+        while(iter!=blocks.rend())
+        {
+            gdalsampler::CachedRasterBlockPtr block = *iter++;
+            gdalsampler::CacheManager::getInstance()->PageBlock(block);
+            // Don't do anything crazy if the source block doesn't match the expected type.
+            if (block->elev == nullptr)
+                continue;
+
+            gdalsampler::Quad srcGeoQuad  = block->GetDestCoverage();
+
+            gdalsampler::Quad pixQuad;
+            // Get the source quad in dest pixel coordinates
+            window.GeoToPixel(srcGeoQuad.ul,pixQuad.ul);
+            window.GeoToPixel(srcGeoQuad.ur,pixQuad.ur);
+            window.GeoToPixel(srcGeoQuad.lr,pixQuad.lr);
+            window.GeoToPixel(srcGeoQuad.ll,pixQuad.ll);
+
+            double srcquad[4][2] = {
+                { pixQuad.ul.X(), pixQuad.ul.Y() },
+                { pixQuad.ur.X(), pixQuad.ur.Y() },
+                { pixQuad.lr.X(), pixQuad.lr.Y() },
+                { pixQuad.ll.X(), pixQuad.ll.Y() }
+            };
 
-            int srcStep = block->xsize * sizeof(ipp32f);
-            IppiSize srcNumPix = { block->xsize, block->ysize };
-            int destStep = window.width * sizeof(ipp32f);
-            IppiSize destNumPix = { window.width, window.height };
-            // Get the transform from the quad
             double coeff[3][3];
-            IppStatus istatus = ippiGetPerspectiveTransform(srcroi,srcquad,coeff);
-            if(istatus==ippStsNoErr)
+            if(ip::GetPerspectiveTransform(block->xsize,block->ysize,srcquad,coeff))
             {
-                IppiSize srcNumPix = {block->xsize,block->ysize};
-                
-                // Now use the coeff to warp the source on to the dest.
-                //istatus=WarpPerspective_32f_C1R(block->elev, srcNumPix, srcStep, scratch, destNumPix, destStep, coeff, ippCubic);
-                istatus=WarpPerspective_32f_C1R(block->elev, srcNumPix, srcStep, scratch, destNumPix, destStep, coeff, ippLinear);
-                //istatus=WarpPerspective_32f_C1R(block->elev, srcNumPix, srcStep, scratch, destNumPix, destStep, coeff, ippNearest);
-                if(istatus!=ippStsNoErr)
+                if(!ip::WarpComposite_32f_C1(block->elev, block->xsize, block->ysize, block->xsize*sizeof(float),
+                    buf, window.width, window.height, window.width*sizeof(float), &filled[0], window.width, coeff, ELEVATION_NODATA_THRESHOLD))
                 {
-                    printf("WarpPerspective_32f_C1R returned %d\n", istatus);
+                    log << ccl::LWARNING << "WarpComposite_32f_C1 failed for " << file->GetFilename() << log.endl;
                 }
-
-                CopyNonNoDataPixels(scratch, buf, scratchlen);
             }
         }
 
         if(blocks.size()>0)
         {
             ret = true;
+            // Lower priority files can't change anything once every pixel is written.
+            if(std::find(filled.begin(), filled.end(), 0) == filled.end())
+                break;
         }
     }
-    delete[] scratch;
-#else
-    throw std::runtime_error("Attempt to call SampleIPP when IPP support was not compiled in!.");
-#endif
     return ret;
 }
 
-
 bool GDALRasterSampler::SampleSoftware(const gdalsampler::GeoExtents &window, u_char *buf)
 {
     // Get the blocks spatial extents
@@ -0,0 +1,343 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+
+
+#include "ip/PyramidReduce.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define IP_REDUCE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IP_REDUCE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ip
+{
+
+    namespace
+    {
+        inline bool IsValid(float value, float noData)
+        {
+            return (value == value) && (value != noData);
+        }
+
+        // a and b are two consecutive source rows; all row functions handle dstWidth pixels.
+
+        void ReduceRow_8u_C3_Scalar(const u_char *a, const u_char *b, u_char *dst, int dstWidth)
+        {
+            for(int x = 0; x < dstWidth; ++x)
+            {
+                for(int c = 0; c < 3; ++c)
+                {
+                    const int i = (x * 6) + c;
+                    dst[(x * 3) + c] = (u_char)((a[i] + a[i + 3] + b[i] + b[i + 3] + 2) >> 2);
+                }
+            }
+        }
+
+        void ReduceRowMean_32f_Scalar(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            for(int x = 0; x < dstWidth; ++x)
+            {
+                const float v[4] = { a[x * 2], a[(x * 2) + 1], b[x * 2], b[(x * 2) + 1] };
+                float sum = 0.0f;
+                float count = 0.0f;
+                for(int i = 0; i < 4; ++i)
+                {
+                    if(IsValid(v[i], noData))
+                    {
+                        sum += v[i];
+                        count += 1.0f;
+                    }
+                }
+                dst[x] = (count > 0.0f) ? (sum / count) : noData;
+            }
+        }
+
+        void ReduceRowMin_32f_Scalar(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            for(int x = 0; x < dstWidth; ++x)
+            {
+                const float v[4] = { a[x * 2], a[(x * 2) + 1], b[x * 2], b[(x * 2) + 1] };
+                float result = std::numeric_limits<float>::infinity();
+                bool valid = false;
+                for(int i = 0; i < 4; ++i)
+                {
+                    if(IsValid(v[i], noData))
+                    {
+                        result = std::min<float>(result, v[i]);
+                        valid = true;
+                    }
+                }
+                dst[x] = valid ? result : noData;
+            }
+        }
+
+#ifdef IP_REDUCE_SSE2
+
+        void ReduceRow_8u_C3_SSE2(const u_char *a, const u_char *b, u_char *dst, int dstWidth)
+        {
+            // Interleaved RGB doesn't pair up in SSE2 registers, so each chunk is done in three
+            // passes: vertical sums, each sum plus the one a pixel (3 bytes) to its right, then
+            // every other pixel is kept. The scratch rows are padded for the overlapping loads.
+            const int chunk = 64;
+            uint16_t sums[(chunk * 6) + 16];
+            u_char pairs[(chunk * 6) + 16];
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i two = _mm_set1_epi16(2);
+            if(dstWidth < 8)
+                return ReduceRow_8u_C3_Scalar(a, b, dst, dstWidth);
+            for(int x0 = 0; x0 < dstWidth; x0 += chunk)
+            {
+                const int count = std::min<int>(chunk, dstWidth - x0);
+                const int n = count * 6;
+                const u_char *ra = a + (x0 * 6);
+                const u_char *rb = b + (x0 * 6);
+                int i = 0;
+                for(; i + 16 <= n; i += 16)
+                {
+                    const __m128i va = _mm_loadu_si128((const __m128i *)(ra + i));
+                    const __m128i vb = _mm_loadu_si128((const __m128i *)(rb + i));
+                    _mm_storeu_si128((__m128i *)(sums + i), _mm_add_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero)));
+                    _mm_storeu_si128((__m128i *)(sums + i + 8), _mm_add_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero)));
+                }
+                for(; i < n; ++i)
+                    sums[i] = ra[i] + rb[i];
+                for(; i < n + 16; ++i)
+                    sums[i] = 0;
+                for(i = 0; i < n; i += 8)
+                {
+                    __m128i s = _mm_add_epi16(_mm_loadu_si128((const __m128i *)(sums + i)), _mm_loadu_si128((const __m128i *)(sums + i + 3)));
+                    s = _mm_srli_epi16(_mm_add_epi16(s, two), 2);
+                    _mm_storel_epi64((__m128i *)(pairs + i), _mm_packus_epi16(s, s));
+                }
+                u_char *out = dst + (x0 * 3);
+                for(int x = 0; x < count; ++x)
+                {
+                    out[(x * 3) + 0] = pairs[(x * 6) + 0];
+                    out[(x * 3) + 1] = pairs[(x * 6) + 1];
+                    out[(x * 3) + 2] = pairs[(x * 6) + 2];
+                }
+            }
+        }
+
+        // Splits 8 consecutive floats into their even and odd elements, with the validity mask of each.
+        inline void LoadPairs(const float *src, __m128 noData, __m128 &even, __m128 &odd, __m128 &evenValid, __m128 &oddValid)
+        {
+            const __m128 lo = _mm_loadu_ps(src);
+            const __m128 hi = _mm_loadu_ps(src + 4);
+            even = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+            odd = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+            evenValid = _mm_and_ps(_mm_cmpneq_ps(even, noData), _mm_cmpord_ps(even, even));
+            oddValid = _mm_and_ps(_mm_cmpneq_ps(odd, noData), _mm_cmpord_ps(odd, odd));
+        }
+
+        inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        void ReduceRowMean_32f_SSE2(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            const __m128 nd = _mm_set1_ps(noData);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 zero = _mm_setzero_ps();
+            int x = 0;
+            for(; x + 4 <= dstWidth; x += 4)
+            {
+                __m128 p, q, r, s, mp, mq, mr, ms;
+                LoadPairs(a + (x * 2), nd, p, q, mp, mq);
+                LoadPairs(b + (x * 2), nd, r, s, mr, ms);
+                // same summation order as the scalar version
+                __m128 sum = _mm_and_ps(mp, p);
+                sum = _mm_add_ps(sum, _mm_and_ps(mq, q));
+                sum = _mm_add_ps(sum, _mm_and_ps(mr, r));
+                sum = _mm_add_ps(sum, _mm_and_ps(ms, s));
+                __m128 count = _mm_and_ps(mp, one);
+                count = _mm_add_ps(count, _mm_and_ps(mq, one));
+                count = _mm_add_ps(count, _mm_and_ps(mr, one));
+                count = _mm_add_ps(count, _mm_and_ps(ms, one));
+                const __m128 valid = _mm_cmpgt_ps(count, zero);
+                const __m128 mean = _mm_div_ps(sum, _mm_max_ps(count, one));
+                _mm_storeu_ps(dst + x, Select(valid, mean, nd));
+            }
+            if(x < dstWidth)
+                ReduceRowMean_32f_Scalar(a + (x * 2), b + (x * 2), dst + x, dstWidth - x, noData);
+        }
+
+        void ReduceRowMin_32f_SSE2(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            const __m128 nd = _mm_set1_ps(noData);
+            const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            int x = 0;
+            for(; x + 4 <= dstWidth; x += 4)
+            {
+                __m128 p, q, r, s, mp, mq, mr, ms;
+                LoadPairs(a + (x * 2), nd, p, q, mp, mq);
+                LoadPairs(b + (x * 2), nd, r, s, mr, ms);
+                __m128 result = _mm_min_ps(Select(mp, p, inf), Select(mq, q, inf));
+                result = _mm_min_ps(result, _mm_min_ps(Select(mr, r, inf), Select(ms, s, inf)));
+                const __m128 valid = _mm_or_ps(_mm_or_ps(mp, mq), _mm_or_ps(mr, ms));
+                _mm_storeu_ps(dst + x, Select(valid, result, nd));
+            }
+            if(x < dstWidth)
+                ReduceRowMin_32f_Scalar(a + (x * 2), b + (x * 2), dst + x, dstWidth - x, noData);
+        }
+
+#endif
+
+#ifdef IP_REDUCE_NEON
+
+        void ReduceRow_8u_C3_NEON(const u_char *a, const u_char *b, u_char *dst, int dstWidth)
+        {
+            int x = 0;
+            for(; x + 8 <= dstWidth; x += 8)
+            {
+                const uint8x16x3_t va = vld3q_u8(a + (x * 6));
+                const uint8x16x3_t vb = vld3q_u8(b + (x * 6));
+                uint8x8x3_t out;
+                for(int c = 0; c < 3; ++c)
+                    out.val[c] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(va.val[c]), vpaddlq_u8(vb.val[c])), 2);
+                vst3_u8(dst + (x * 3), out);
+            }
+            if(x < dstWidth)
+                ReduceRow_8u_C3_Scalar(a + (x * 6), b + (x * 6), dst + (x * 3), dstWidth - x);
+        }
+
+        inline uint32x4_t ValidMask(float32x4_t v, float32x4_t noData)
+        {
+            return vandq_u32(vmvnq_u32(vceqq_f32(v, noData)), vceqq_f32(v, v));
+        }
+
+        void ReduceRowMean_32f_NEON(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            const float32x4_t nd = vdupq_n_f32(noData);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            int x = 0;
+            for(; x + 4 <= dstWidth; x += 4)
+            {
+                const float32x4x2_t va = vld2q_f32(a + (x * 2));
+                const float32x4x2_t vb = vld2q_f32(b + (x * 2));
+                const float32x4_t v[4] = { va.val[0], va.val[1], vb.val[0], vb.val[1] };
+                float32x4_t sum = zero;
+                float32x4_t count = zero;
+                for(int i = 0; i < 4; ++i)
+                {
+                    const uint32x4_t m = ValidMask(v[i], nd);
+                    sum = vaddq_f32(sum, vbslq_f32(m, v[i], zero));
+                    count = vaddq_f32(count, vbslq_f32(m, one, zero));
+                }
+                const float32x4_t mean = vdivq_f32(sum, vmaxq_f32(count, one));
+                vst1q_f32(dst + x, vbslq_f32(vcgtq_f32(count, zero), mean, nd));
+            }
+            if(x < dstWidth)
+                ReduceRowMean_32f_Scalar(a + (x * 2), b + (x * 2), dst + x, dstWidth - x, noData);
+        }
+
+        void ReduceRowMin_32f_NEON(const float *a, const float *b, float *dst, int dstWidth, float noData)
+        {
+            const float32x4_t nd = vdupq_n_f32(noData);
+            const float32x4_t inf = vdupq_n_f32(std::numeric_limits<float>::infinity());
+            int x = 0;
+            for(; x + 4 <= dstWidth; x += 4)
+            {
+                const float32x4x2_t va = vld2q_f32(a + (x * 2));
+                const float32x4x2_t vb = vld2q_f32(b + (x * 2));
+                const float32x4_t v[4] = { va.val[0], va.val[1], vb.val[0], vb.val[1] };
+                float32x4_t result = inf;
+                uint32x4_t valid = vdupq_n_u32(0);
+                for(int i = 0; i < 4; ++i)
+                {
+                    const uint32x4_t m = ValidMask(v[i], nd);
+                    result = vminq_f32(result, vbslq_f32(m, v[i], inf));
+                    valid = vorrq_u32(valid, m);
+                }
+                vst1q_f32(dst + x, vbslq_f32(valid, result, nd));
+            }
+            if(x < dstWidth)
+                ReduceRowMin_32f_Scalar(a + (x * 2), b + (x * 2), dst + x, dstWidth - x, noData);
+        }
+
+#endif
+
+#if defined(IP_REDUCE_SSE2)
+        const char *isa = "sse2";
+        void (*reduceRow_8u_C3)(const u_char *, const u_char *, u_char *, int) = ReduceRow_8u_C3_SSE2;
+        void (*reduceRowMean_32f)(const float *, const float *, float *, int, float) = ReduceRowMean_32f_SSE2;
+        void (*reduceRowMin_32f)(const float *, const float *, float *, int, float) = ReduceRowMin_32f_SSE2;
+#elif defined(IP_REDUCE_NEON)
+        const char *isa = "neon";
+        void (*reduceRow_8u_C3)(const u_char *, const u_char *, u_char *, int) = ReduceRow_8u_C3_NEON;
+        void (*reduceRowMean_32f)(const float *, const float *, float *, int, float) = ReduceRowMean_32f_NEON;
+        void (*reduceRowMin_32f)(const float *, const float *, float *, int, float) = ReduceRowMin_32f_NEON;
+#else
+        const char *isa = "scalar";
+        void (*reduceRow_8u_C3)(const u_char *, const u_char *, u_char *, int) = ReduceRow_8u_C3_Scalar;
+        void (*reduceRowMean_32f)(const float *, const float *, float *, int, float) = ReduceRowMean_32f_Scalar;
+        void (*reduceRowMin_32f)(const float *, const float *, float *, int, float) = ReduceRowMin_32f_Scalar;
+#endif
+
+        template <typename T>
+        const T *Row(const T *base, int step, int y)
+        {
+            return (const T *)((const u_char *)base + ((size_t)step * y));
+        }
+
+        template <typename T>
+        T *Row(T *base, int step, int y)
+        {
+            return (T *)((u_char *)base + ((size_t)step * y));
+        }
+    }
+
+    void Reduce2x2_8u_C3(const u_char *src, int srcStep, u_char *dst, int dstWidth, int dstHeight, int dstStep)
+    {
+        for(int y = 0; y < dstHeight; ++y)
+            reduceRow_8u_C3(Row(src, srcStep, y * 2), Row(src, srcStep, (y * 2) + 1), Row(dst, dstStep, y), dstWidth);
+    }
+
+    void Reduce2x2Mean_32f_C1(const float *src, int srcStep, float *dst, int dstWidth, int dstHeight, int dstStep, float noData)
+    {
+        for(int y = 0; y < dstHeight; ++y)
+            reduceRowMean_32f(Row(src, srcStep, y * 2), Row(src, srcStep, (y * 2) + 1), Row(dst, dstStep, y), dstWidth, noData);
+    }
+
+    void Reduce2x2Min_32f_C1(const float *src, int srcStep, float *dst, int dstWidth, int dstHeight, int dstStep, float noData)
+    {
+        for(int y = 0; y < dstHeight; ++y)
+            reduceRowMin_32f(Row(src, srcStep, y * 2), Row(src, srcStep, (y * 2) + 1), Row(dst, dstStep, y), dstWidth, noData);
+    }
+
+    const char *Reduce2x2ISA()
+    {
+        return isa;
+    }
+
+}
@@ -0,0 +1,1138 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+
+#include "ip/WarpPerspective.h"
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IP_WARP_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IP_WARP_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define IP_WARP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define IP_WARP_TARGET(isa)
+#endif
+
+namespace ip
+{
+
+    namespace
+    {
+        // Maps destination row y, columns [x0, x0+count), back into source pixel coordinates.
+        typedef void (*MapRowFunc)(const double inv[3][3], int y, int x0, int count, float *sx, float *sy);
+
+        // Bilinear 32f C1 row; srcStride is in elements.
+        typedef void (*LinearRow32fFunc)(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count);
+
+        // Bilinear 32f C1 row that skips filled pixels and taps at or below noData, marking what it writes.
+        typedef void (*CompositeRow32fFunc)(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float noData, float *dst, u_char *filled, int count);
+
+        // Bilinear or cubic 8u C3 row; srcStride is in bytes.
+        typedef void (*Row8uC3Func)(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count);
+
+        struct WarpKernels
+        {
+            const char *name;
+            MapRowFunc mapRow;
+            LinearRow32fFunc linearRow32f;
+            CompositeRow32fFunc compositeRow32f;
+            Row8uC3Func linearRow8uC3;
+            Row8uC3Func cubicRow8uC3;
+        };
+
+        inline bool InsideSource(float x, float y, int srcWidth, int srcHeight)
+        {
+            // pixel footprints, so adjacent source blocks tile the destination without gaps or overlap
+            return (x >= -0.5f) && (x < srcWidth - 0.5f) && (y >= -0.5f) && (y < srcHeight - 0.5f);
+        }
+
+        inline int Clamp(int value, int lo, int hi)
+        {
+            return std::min<int>(std::max<int>(value, lo), hi);
+        }
+
+        inline void StoreValue(u_char *dst, float value)
+        {
+            value = floorf(value + 0.5f);
+            *dst = (u_char)std::min<float>(std::max<float>(value, 0.0f), 255.0f);
+        }
+
+        inline void StoreValue(float *dst, float value)
+        {
+            *dst = value;
+        }
+
+        void MapRow_Scalar(const double inv[3][3], int y, int x0, int count, float *sx, float *sy)
+        {
+            const double bx = inv[0][1] * y + inv[0][2];
+            const double by = inv[1][1] * y + inv[1][2];
+            const double bw = inv[2][1] * y + inv[2][2];
+            for(int i = 0; i < count; ++i)
+            {
+                const double x = x0 + i;
+                const double w = inv[2][0] * x + bw;
+                const double rw = 1.0 / w;
+                sx[i] = float((inv[0][0] * x + bx) * rw);
+                sy[i] = float((inv[1][0] * x + by) * rw);
+            }
+        }
+
+        inline float LinearSample32f(const float *src, int srcWidth, int srcHeight, int srcStride, float x, float y)
+        {
+            const float fx = floorf(x);
+            const float fy = floorf(y);
+            const float ax = x - fx;
+            const float ay = y - fy;
+            const int ix0 = Clamp(int(fx), 0, srcWidth - 1);
+            const int ix1 = Clamp(int(fx) + 1, 0, srcWidth - 1);
+            const int iy0 = Clamp(int(fy), 0, srcHeight - 1);
+            const int iy1 = Clamp(int(fy) + 1, 0, srcHeight - 1);
+            const float *row0 = src + (size_t)iy0 * srcStride;
+            const float *row1 = src + (size_t)iy1 * srcStride;
+            const float top = row0[ix0] + ax * (row0[ix1] - row0[ix0]);
+            const float bottom = row1[ix0] + ax * (row1[ix1] - row1[ix0]);
+            return top + ay * (bottom - top);
+        }
+
+        void LinearRow32f_Scalar(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    dst[i] = LinearSample32f(src, srcWidth, srcHeight, srcStride, sx[i], sy[i]);
+            }
+        }
+
+        void CompositeRow32f_Scalar(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float noData, float *dst, u_char *filled, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(filled[i] || !InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                const float ax = sx[i] - fx;
+                const float ay = sy[i] - fy;
+                const int ix0 = Clamp(int(fx), 0, srcWidth - 1);
+                const int ix1 = Clamp(int(fx) + 1, 0, srcWidth - 1);
+                const float *row0 = src + (size_t)Clamp(int(fy), 0, srcHeight - 1) * srcStride;
+                const float *row1 = src + (size_t)Clamp(int(fy) + 1, 0, srcHeight - 1) * srcStride;
+                const float p00 = row0[ix0];
+                const float p01 = row0[ix1];
+                const float p10 = row1[ix0];
+                const float p11 = row1[ix1];
+                if(std::min<float>(std::min<float>(p00, p01), std::min<float>(p10, p11)) <= noData)
+                    continue;
+                const float top = p00 + ax * (p01 - p00);
+                const float bottom = p10 + ax * (p11 - p10);
+                dst[i] = top + ay * (bottom - top);
+                filled[i] = 1;
+            }
+        }
+
+        inline void MarkFilled(u_char *filled, int mask, int lanes)
+        {
+            for(int k = 0; k < lanes; ++k)
+            {
+                if(mask & (1 << k))
+                    filled[k] = 1;
+            }
+        }
+
+        void CubicWeights(float t, float w[4])
+        {
+            // Catmull-Rom
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+            w[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+            w[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+            w[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+            w[3] = 0.5f * (t3 - t2);
+        }
+
+        template<typename T, int CHANNELS>
+        void NearestRow(const T *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, T *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const int ix = Clamp(int(floorf(sx[i] + 0.5f)), 0, srcWidth - 1);
+                const int iy = Clamp(int(floorf(sy[i] + 0.5f)), 0, srcHeight - 1);
+                const T *pixel = src + (size_t)iy * srcStride + ix * CHANNELS;
+                for(int c = 0; c < CHANNELS; ++c)
+                    dst[i * CHANNELS + c] = pixel[c];
+            }
+        }
+
+        template<typename T, int CHANNELS>
+        void LinearRow(const T *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, T *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                const float ax = sx[i] - fx;
+                const float ay = sy[i] - fy;
+                const int ix0 = Clamp(int(fx), 0, srcWidth - 1) * CHANNELS;
+                const int ix1 = Clamp(int(fx) + 1, 0, srcWidth - 1) * CHANNELS;
+                const T *row0 = src + (size_t)Clamp(int(fy), 0, srcHeight - 1) * srcStride;
+                const T *row1 = src + (size_t)Clamp(int(fy) + 1, 0, srcHeight - 1) * srcStride;
+                for(int c = 0; c < CHANNELS; ++c)
+                {
+                    const float top = row0[ix0 + c] + ax * (float(row0[ix1 + c]) - float(row0[ix0 + c]));
+                    const float bottom = row1[ix0 + c] + ax * (float(row1[ix1 + c]) - float(row1[ix0 + c]));
+                    StoreValue(&dst[i * CHANNELS + c], top + ay * (bottom - top));
+                }
+            }
+        }
+
+        template<typename T, int CHANNELS>
+        void CubicRow(const T *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, T *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                float wx[4], wy[4];
+                CubicWeights(sx[i] - fx, wx);
+                CubicWeights(sy[i] - fy, wy);
+                int cols[4];
+                const T *rows[4];
+                for(int k = 0; k < 4; ++k)
+                {
+                    cols[k] = Clamp(int(fx) - 1 + k, 0, srcWidth - 1) * CHANNELS;
+                    rows[k] = src + (size_t)Clamp(int(fy) - 1 + k, 0, srcHeight - 1) * srcStride;
+                }
+                for(int c = 0; c < CHANNELS; ++c)
+                {
+                    float value = 0.0f;
+                    for(int r = 0; r < 4; ++r)
+                    {
+                        const T *row = rows[r] + c;
+                        value += wy[r] * (wx[0] * row[cols[0]] + wx[1] * row[cols[1]] + wx[2] * row[cols[2]] + wx[3] * row[cols[3]]);
+                    }
+                    StoreValue(&dst[i * CHANNELS + c], value);
+                }
+            }
+        }
+
+#ifdef IP_WARP_X86
+
+        IP_WARP_TARGET("avx2,fma")
+        void MapRow_AVX2(const double inv[3][3], int y, int x0, int count, float *sx, float *sy)
+        {
+            const __m256d ax = _mm256_set1_pd(inv[0][0]);
+            const __m256d ay = _mm256_set1_pd(inv[1][0]);
+            const __m256d aw = _mm256_set1_pd(inv[2][0]);
+            const __m256d bx = _mm256_set1_pd(inv[0][1] * y + inv[0][2]);
+            const __m256d by = _mm256_set1_pd(inv[1][1] * y + inv[1][2]);
+            const __m256d bw = _mm256_set1_pd(inv[2][1] * y + inv[2][2]);
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d step = _mm256_set1_pd(4.0);
+            __m256d xs = _mm256_setr_pd(x0, x0 + 1, x0 + 2, x0 + 3);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                const __m256d rw = _mm256_div_pd(one, _mm256_fmadd_pd(aw, xs, bw));
+                _mm_storeu_ps(sx + i, _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_fmadd_pd(ax, xs, bx), rw)));
+                _mm_storeu_ps(sy + i, _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_fmadd_pd(ay, xs, by), rw)));
+                xs = _mm256_add_pd(xs, step);
+            }
+            if(i < count)
+                MapRow_Scalar(inv, y, x0 + i, count - i, sx + i, sy + i);
+        }
+
+        IP_WARP_TARGET("avx2,fma")
+        void LinearRow32f_AVX2(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count)
+        {
+            const __m256 lo = _mm256_set1_ps(-0.5f);
+            const __m256 hix = _mm256_set1_ps(srcWidth - 0.5f);
+            const __m256 hiy = _mm256_set1_ps(srcHeight - 0.5f);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i one = _mm256_set1_epi32(1);
+            const __m256i maxx = _mm256_set1_epi32(srcWidth - 1);
+            const __m256i maxy = _mm256_set1_epi32(srcHeight - 1);
+            const __m256i stride = _mm256_set1_epi32(srcStride);
+            int i = 0;
+            for(; i + 8 <= count; i += 8)
+            {
+                __m256 x = _mm256_loadu_ps(sx + i);
+                __m256 y = _mm256_loadu_ps(sy + i);
+                const __m256 valid = _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hix, _CMP_LT_OQ)),
+                    _mm256_and_ps(_mm256_cmp_ps(y, lo, _CMP_GE_OQ), _mm256_cmp_ps(y, hiy, _CMP_LT_OQ)));
+                if(_mm256_movemask_ps(valid) == 0)
+                    continue;
+                // zero the lanes we won't write so the gathers stay inside the source
+                x = _mm256_and_ps(x, valid);
+                y = _mm256_and_ps(y, valid);
+                const __m256 fx = _mm256_floor_ps(x);
+                const __m256 fy = _mm256_floor_ps(y);
+                const __m256 wx = _mm256_sub_ps(x, fx);
+                const __m256 wy = _mm256_sub_ps(y, fy);
+                const __m256i ix = _mm256_cvttps_epi32(fx);
+                const __m256i iy = _mm256_cvttps_epi32(fy);
+                const __m256i ix0 = _mm256_max_epi32(ix, zero);
+                const __m256i ix1 = _mm256_min_epi32(_mm256_add_epi32(ix, one), maxx);
+                const __m256i row0 = _mm256_mullo_epi32(_mm256_max_epi32(iy, zero), stride);
+                const __m256i row1 = _mm256_mullo_epi32(_mm256_min_epi32(_mm256_add_epi32(iy, one), maxy), stride);
+                const __m256 p00 = _mm256_i32gather_ps(src, _mm256_add_epi32(row0, ix0), 4);
+                const __m256 p01 = _mm256_i32gather_ps(src, _mm256_add_epi32(row0, ix1), 4);
+                const __m256 p10 = _mm256_i32gather_ps(src, _mm256_add_epi32(row1, ix0), 4);
+                const __m256 p11 = _mm256_i32gather_ps(src, _mm256_add_epi32(row1, ix1), 4);
+                const __m256 top = _mm256_fmadd_ps(wx, _mm256_sub_ps(p01, p00), p00);
+                const __m256 bottom = _mm256_fmadd_ps(wx, _mm256_sub_ps(p11, p10), p10);
+                const __m256 value = _mm256_fmadd_ps(wy, _mm256_sub_ps(bottom, top), top);
+                _mm256_maskstore_ps(dst + i, _mm256_castps_si256(valid), value);
+            }
+            if(i < count)
+                LinearRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, dst + i, count - i);
+        }
+
+        IP_WARP_TARGET("avx2,fma")
+        void CompositeRow32f_AVX2(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float noData, float *dst, u_char *filled, int count)
+        {
+            const __m256 lo = _mm256_set1_ps(-0.5f);
+            const __m256 hix = _mm256_set1_ps(srcWidth - 0.5f);
+            const __m256 hiy = _mm256_set1_ps(srcHeight - 0.5f);
+            const __m256 nodata = _mm256_set1_ps(noData);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i one = _mm256_set1_epi32(1);
+            const __m256i maxx = _mm256_set1_epi32(srcWidth - 1);
+            const __m256i maxy = _mm256_set1_epi32(srcHeight - 1);
+            const __m256i stride = _mm256_set1_epi32(srcStride);
+            int i = 0;
+            for(; i + 8 <= count; i += 8)
+            {
+                const __m128i done = _mm_loadl_epi64((const __m128i *)(filled + i));
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(done, _mm_setzero_si128())) == 0)
+                    continue;
+                __m256 x = _mm256_loadu_ps(sx + i);
+                __m256 y = _mm256_loadu_ps(sy + i);
+                const __m256 open = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(done), zero));
+                __m256 valid = _mm256_and_ps(open, _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hix, _CMP_LT_OQ)),
+                    _mm256_and_ps(_mm256_cmp_ps(y, lo, _CMP_GE_OQ), _mm256_cmp_ps(y, hiy, _CMP_LT_OQ))));
+                if(_mm256_movemask_ps(valid) == 0)
+                    continue;
+                x = _mm256_and_ps(x, valid);
+                y = _mm256_and_ps(y, valid);
+                const __m256 fx = _mm256_floor_ps(x);
+                const __m256 fy = _mm256_floor_ps(y);
+                const __m256 wx = _mm256_sub_ps(x, fx);
+                const __m256 wy = _mm256_sub_ps(y, fy);
+                const __m256i ix = _mm256_cvttps_epi32(fx);
+                const __m256i iy = _mm256_cvttps_epi32(fy);
+                const __m256i ix0 = _mm256_max_epi32(ix, zero);
+                const __m256i ix1 = _mm256_min_epi32(_mm256_add_epi32(ix, one), maxx);
+                const __m256i row0 = _mm256_mullo_epi32(_mm256_max_epi32(iy, zero), stride);
+                const __m256i row1 = _mm256_mullo_epi32(_mm256_min_epi32(_mm256_add_epi32(iy, one), maxy), stride);
+                const __m256 p00 = _mm256_i32gather_ps(src, _mm256_add_epi32(row0, ix0), 4);
+                const __m256 p01 = _mm256_i32gather_ps(src, _mm256_add_epi32(row0, ix1), 4);
+                const __m256 p10 = _mm256_i32gather_ps(src, _mm256_add_epi32(row1, ix0), 4);
+                const __m256 p11 = _mm256_i32gather_ps(src, _mm256_add_epi32(row1, ix1), 4);
+                const __m256 lowest = _mm256_min_ps(_mm256_min_ps(p00, p01), _mm256_min_ps(p10, p11));
+                valid = _mm256_and_ps(valid, _mm256_cmp_ps(lowest, nodata, _CMP_GT_OQ));
+                const int mask = _mm256_movemask_ps(valid);
+                if(mask == 0)
+                    continue;
+                const __m256 top = _mm256_fmadd_ps(wx, _mm256_sub_ps(p01, p00), p00);
+                const __m256 bottom = _mm256_fmadd_ps(wx, _mm256_sub_ps(p11, p10), p10);
+                const __m256 value = _mm256_fmadd_ps(wy, _mm256_sub_ps(bottom, top), top);
+                _mm256_maskstore_ps(dst + i, _mm256_castps_si256(valid), value);
+                MarkFilled(filled + i, mask, 8);
+            }
+            if(i < count)
+                CompositeRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, noData, dst + i, filled + i, count - i);
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        void MapRow_SSE41(const double inv[3][3], int y, int x0, int count, float *sx, float *sy)
+        {
+            const __m128d ax = _mm_set1_pd(inv[0][0]);
+            const __m128d ay = _mm_set1_pd(inv[1][0]);
+            const __m128d aw = _mm_set1_pd(inv[2][0]);
+            const __m128d bx = _mm_set1_pd(inv[0][1] * y + inv[0][2]);
+            const __m128d by = _mm_set1_pd(inv[1][1] * y + inv[1][2]);
+            const __m128d bw = _mm_set1_pd(inv[2][1] * y + inv[2][2]);
+            const __m128d one = _mm_set1_pd(1.0);
+            const __m128d step = _mm_set1_pd(4.0);
+            __m128d xs0 = _mm_setr_pd(x0, x0 + 1);
+            __m128d xs1 = _mm_setr_pd(x0 + 2, x0 + 3);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                const __m128d rw0 = _mm_div_pd(one, _mm_add_pd(_mm_mul_pd(aw, xs0), bw));
+                const __m128d rw1 = _mm_div_pd(one, _mm_add_pd(_mm_mul_pd(aw, xs1), bw));
+                const __m128 x0f = _mm_cvtpd_ps(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(ax, xs0), bx), rw0));
+                const __m128 x1f = _mm_cvtpd_ps(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(ax, xs1), bx), rw1));
+                const __m128 y0f = _mm_cvtpd_ps(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(ay, xs0), by), rw0));
+                const __m128 y1f = _mm_cvtpd_ps(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(ay, xs1), by), rw1));
+                _mm_storeu_ps(sx + i, _mm_movelh_ps(x0f, x1f));
+                _mm_storeu_ps(sy + i, _mm_movelh_ps(y0f, y1f));
+                xs0 = _mm_add_pd(xs0, step);
+                xs1 = _mm_add_pd(xs1, step);
+            }
+            if(i < count)
+                MapRow_Scalar(inv, y, x0 + i, count - i, sx + i, sy + i);
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        void LinearRow32f_SSE41(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count)
+        {
+            const __m128 lo = _mm_set1_ps(-0.5f);
+            const __m128 hix = _mm_set1_ps(srcWidth - 0.5f);
+            const __m128 hiy = _mm_set1_ps(srcHeight - 0.5f);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i one = _mm_set1_epi32(1);
+            const __m128i maxx = _mm_set1_epi32(srcWidth - 1);
+            const __m128i maxy = _mm_set1_epi32(srcHeight - 1);
+            const __m128i stride = _mm_set1_epi32(srcStride);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                __m128 x = _mm_loadu_ps(sx + i);
+                __m128 y = _mm_loadu_ps(sy + i);
+                const __m128 valid = _mm_and_ps(
+                    _mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmplt_ps(x, hix)),
+                    _mm_and_ps(_mm_cmpge_ps(y, lo), _mm_cmplt_ps(y, hiy)));
+                const int mask = _mm_movemask_ps(valid);
+                if(mask == 0)
+                    continue;
+                x = _mm_and_ps(x, valid);
+                y = _mm_and_ps(y, valid);
+                const __m128 fx = _mm_floor_ps(x);
+                const __m128 fy = _mm_floor_ps(y);
+                const __m128 wx = _mm_sub_ps(x, fx);
+                const __m128 wy = _mm_sub_ps(y, fy);
+                const __m128i ix = _mm_cvttps_epi32(fx);
+                const __m128i iy = _mm_cvttps_epi32(fy);
+                const __m128i ix0 = _mm_max_epi32(ix, zero);
+                const __m128i ix1 = _mm_min_epi32(_mm_add_epi32(ix, one), maxx);
+                const __m128i row0 = _mm_mullo_epi32(_mm_max_epi32(iy, zero), stride);
+                const __m128i row1 = _mm_mullo_epi32(_mm_min_epi32(_mm_add_epi32(iy, one), maxy), stride);
+                alignas(16) int i00[4], i01[4], i10[4], i11[4];
+                _mm_store_si128((__m128i *)i00, _mm_add_epi32(row0, ix0));
+                _mm_store_si128((__m128i *)i01, _mm_add_epi32(row0, ix1));
+                _mm_store_si128((__m128i *)i10, _mm_add_epi32(row1, ix0));
+                _mm_store_si128((__m128i *)i11, _mm_add_epi32(row1, ix1));
+                const __m128 p00 = _mm_setr_ps(src[i00[0]], src[i00[1]], src[i00[2]], src[i00[3]]);
+                const __m128 p01 = _mm_setr_ps(src[i01[0]], src[i01[1]], src[i01[2]], src[i01[3]]);
+                const __m128 p10 = _mm_setr_ps(src[i10[0]], src[i10[1]], src[i10[2]], src[i10[3]]);
+                const __m128 p11 = _mm_setr_ps(src[i11[0]], src[i11[1]], src[i11[2]], src[i11[3]]);
+                const __m128 top = _mm_add_ps(p00, _mm_mul_ps(wx, _mm_sub_ps(p01, p00)));
+                const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(wx, _mm_sub_ps(p11, p10)));
+                const __m128 value = _mm_add_ps(top, _mm_mul_ps(wy, _mm_sub_ps(bottom, top)));
+                if(mask == 0xF)
+                    _mm_storeu_ps(dst + i, value);
+                else
+                    _mm_storeu_ps(dst + i, _mm_blendv_ps(_mm_loadu_ps(dst + i), value, valid));
+            }
+            if(i < count)
+                LinearRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, dst + i, count - i);
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        void CompositeRow32f_SSE41(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float noData, float *dst, u_char *filled, int count)
+        {
+            const __m128 lo = _mm_set1_ps(-0.5f);
+            const __m128 hix = _mm_set1_ps(srcWidth - 0.5f);
+            const __m128 hiy = _mm_set1_ps(srcHeight - 0.5f);
+            const __m128 nodata = _mm_set1_ps(noData);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i one = _mm_set1_epi32(1);
+            const __m128i maxx = _mm_set1_epi32(srcWidth - 1);
+            const __m128i maxy = _mm_set1_epi32(srcHeight - 1);
+            const __m128i stride = _mm_set1_epi32(srcStride);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                int done;
+                memcpy(&done, filled + i, sizeof(done));
+                if(done == 0x01010101)
+                    continue;
+                __m128 x = _mm_loadu_ps(sx + i);
+                __m128 y = _mm_loadu_ps(sy + i);
+                const __m128 open = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(done)), zero));
+                __m128 valid = _mm_and_ps(open, _mm_and_ps(
+                    _mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmplt_ps(x, hix)),
+                    _mm_and_ps(_mm_cmpge_ps(y, lo), _mm_cmplt_ps(y, hiy))));
+                if(_mm_movemask_ps(valid) == 0)
+                    continue;
+                x = _mm_and_ps(x, valid);
+                y = _mm_and_ps(y, valid);
+                const __m128 fx = _mm_floor_ps(x);
+                const __m128 fy = _mm_floor_ps(y);
+                const __m128 wx = _mm_sub_ps(x, fx);
+                const __m128 wy = _mm_sub_ps(y, fy);
+                const __m128i ix = _mm_cvttps_epi32(fx);
+                const __m128i iy = _mm_cvttps_epi32(fy);
+                const __m128i ix0 = _mm_max_epi32(ix, zero);
+                const __m128i ix1 = _mm_min_epi32(_mm_add_epi32(ix, one), maxx);
+                const __m128i row0 = _mm_mullo_epi32(_mm_max_epi32(iy, zero), stride);
+                const __m128i row1 = _mm_mullo_epi32(_mm_min_epi32(_mm_add_epi32(iy, one), maxy), stride);
+                alignas(16) int i00[4], i01[4], i10[4], i11[4];
+                _mm_store_si128((__m128i *)i00, _mm_add_epi32(row0, ix0));
+                _mm_store_si128((__m128i *)i01, _mm_add_epi32(row0, ix1));
+                _mm_store_si128((__m128i *)i10, _mm_add_epi32(row1, ix0));
+                _mm_store_si128((__m128i *)i11, _mm_add_epi32(row1, ix1));
+                const __m128 p00 = _mm_setr_ps(src[i00[0]], src[i00[1]], src[i00[2]], src[i00[3]]);
+                const __m128 p01 = _mm_setr_ps(src[i01[0]], src[i01[1]], src[i01[2]], src[i01[3]]);
+                const __m128 p10 = _mm_setr_ps(src[i10[0]], src[i10[1]], src[i10[2]], src[i10[3]]);
+                const __m128 p11 = _mm_setr_ps(src[i11[0]], src[i11[1]], src[i11[2]], src[i11[3]]);
+                const __m128 lowest = _mm_min_ps(_mm_min_ps(p00, p01), _mm_min_ps(p10, p11));
+                valid = _mm_and_ps(valid, _mm_cmpgt_ps(lowest, nodata));
+                const int mask = _mm_movemask_ps(valid);
+                if(mask == 0)
+                    continue;
+                const __m128 top = _mm_add_ps(p00, _mm_mul_ps(wx, _mm_sub_ps(p01, p00)));
+                const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(wx, _mm_sub_ps(p11, p10)));
+                const __m128 value = _mm_add_ps(top, _mm_mul_ps(wy, _mm_sub_ps(bottom, top)));
+                _mm_storeu_ps(dst + i, _mm_blendv_ps(_mm_loadu_ps(dst + i), value, valid));
+                MarkFilled(filled + i, mask, 4);
+            }
+            if(i < count)
+                CompositeRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, noData, dst + i, filled + i, count - i);
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        inline __m128 LoadRGB_SSE41(const u_char *pixel)
+        {
+            // exactly three bytes, so the last pixel of a buffer is not over-read; assembled in a
+            // register because a 3-byte memcpy goes through the stack and stalls the load
+            const int value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+            return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(value)));
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        inline void StoreRGB_SSE41(u_char *dst, __m128 value)
+        {
+            // rounds and saturates as StoreValue() does
+            const __m128i rounded = _mm_cvttps_epi32(_mm_floor_ps(_mm_add_ps(value, _mm_set1_ps(0.5f))));
+            const __m128i words = _mm_packus_epi32(rounded, rounded);
+            const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+            dst[0] = (u_char)bytes;
+            dst[1] = (u_char)(bytes >> 8);
+            dst[2] = (u_char)(bytes >> 16);
+        }
+
+        // The 8u C3 kernels keep one pixel's three channels in the lanes of a register, so
+        // they evaluate exactly the scalar expressions; the AVX2 tier uses them as well.
+        IP_WARP_TARGET("sse4.1")
+        void LinearRow8uC3_SSE41(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                const __m128 ax = _mm_set1_ps(sx[i] - fx);
+                const __m128 ay = _mm_set1_ps(sy[i] - fy);
+                const int ix0 = Clamp(int(fx), 0, srcWidth - 1) * 3;
+                const int ix1 = Clamp(int(fx) + 1, 0, srcWidth - 1) * 3;
+                const u_char *row0 = src + (size_t)Clamp(int(fy), 0, srcHeight - 1) * srcStride;
+                const u_char *row1 = src + (size_t)Clamp(int(fy) + 1, 0, srcHeight - 1) * srcStride;
+                const __m128 p00 = LoadRGB_SSE41(row0 + ix0);
+                const __m128 p01 = LoadRGB_SSE41(row0 + ix1);
+                const __m128 p10 = LoadRGB_SSE41(row1 + ix0);
+                const __m128 p11 = LoadRGB_SSE41(row1 + ix1);
+                const __m128 top = _mm_add_ps(p00, _mm_mul_ps(ax, _mm_sub_ps(p01, p00)));
+                const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(ax, _mm_sub_ps(p11, p10)));
+                StoreRGB_SSE41(dst + i * 3, _mm_add_ps(top, _mm_mul_ps(ay, _mm_sub_ps(bottom, top))));
+            }
+        }
+
+        IP_WARP_TARGET("sse4.1")
+        void CubicRow8uC3_SSE41(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                float wx[4], wy[4];
+                CubicWeights(sx[i] - fx, wx);
+                CubicWeights(sy[i] - fy, wy);
+                int cols[4];
+                for(int k = 0; k < 4; ++k)
+                    cols[k] = Clamp(int(fx) - 1 + k, 0, srcWidth - 1) * 3;
+                __m128 value = _mm_setzero_ps();
+                for(int r = 0; r < 4; ++r)
+                {
+                    const u_char *row = src + (size_t)Clamp(int(fy) - 1 + r, 0, srcHeight - 1) * srcStride;
+                    __m128 sum = _mm_mul_ps(_mm_set1_ps(wx[0]), LoadRGB_SSE41(row + cols[0]));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(wx[1]), LoadRGB_SSE41(row + cols[1])));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(wx[2]), LoadRGB_SSE41(row + cols[2])));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(wx[3]), LoadRGB_SSE41(row + cols[3])));
+                    value = _mm_add_ps(value, _mm_mul_ps(_mm_set1_ps(wy[r]), sum));
+                }
+                StoreRGB_SSE41(dst + i * 3, value);
+            }
+        }
+
+        bool CPUSupportsAVX2()
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if(info[0] < 7)
+                return false;
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool fma = (info[2] & (1 << 12)) != 0;
+            if(!osxsave || !fma || ((_xgetbv(0) & 6) != 6))
+                return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        bool CPUSupportsSSE41()
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("sse4.1");
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 19)) != 0;
+#else
+            return false;
+#endif
+        }
+
+#endif
+
+#ifdef IP_WARP_NEON
+
+        void MapRow_NEON(const double inv[3][3], int y, int x0, int count, float *sx, float *sy)
+        {
+            const float64x2_t ax = vdupq_n_f64(inv[0][0]);
+            const float64x2_t ay = vdupq_n_f64(inv[1][0]);
+            const float64x2_t aw = vdupq_n_f64(inv[2][0]);
+            const float64x2_t bx = vdupq_n_f64(inv[0][1] * y + inv[0][2]);
+            const float64x2_t by = vdupq_n_f64(inv[1][1] * y + inv[1][2]);
+            const float64x2_t bw = vdupq_n_f64(inv[2][1] * y + inv[2][2]);
+            const float64x2_t one = vdupq_n_f64(1.0);
+            const float64x2_t step = vdupq_n_f64(2.0);
+            const double start[2] = { double(x0), double(x0 + 1) };
+            float64x2_t xs = vld1q_f64(start);
+            int i = 0;
+            for(; i + 2 <= count; i += 2)
+            {
+                const float64x2_t rw = vdivq_f64(one, vfmaq_f64(bw, aw, xs));
+                vst1_f32(sx + i, vcvt_f32_f64(vmulq_f64(vfmaq_f64(bx, ax, xs), rw)));
+                vst1_f32(sy + i, vcvt_f32_f64(vmulq_f64(vfmaq_f64(by, ay, xs), rw)));
+                xs = vaddq_f64(xs, step);
+            }
+            if(i < count)
+                MapRow_Scalar(inv, y, x0 + i, count - i, sx + i, sy + i);
+        }
+
+        void LinearRow32f_NEON(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count)
+        {
+            const float32x4_t lo = vdupq_n_f32(-0.5f);
+            const float32x4_t hix = vdupq_n_f32(srcWidth - 0.5f);
+            const float32x4_t hiy = vdupq_n_f32(srcHeight - 0.5f);
+            const int32x4_t zero = vdupq_n_s32(0);
+            const int32x4_t one = vdupq_n_s32(1);
+            const int32x4_t maxx = vdupq_n_s32(srcWidth - 1);
+            const int32x4_t maxy = vdupq_n_s32(srcHeight - 1);
+            const int32x4_t stride = vdupq_n_s32(srcStride);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                float32x4_t x = vld1q_f32(sx + i);
+                float32x4_t y = vld1q_f32(sy + i);
+                const uint32x4_t valid = vandq_u32(
+                    vandq_u32(vcgeq_f32(x, lo), vcltq_f32(x, hix)),
+                    vandq_u32(vcgeq_f32(y, lo), vcltq_f32(y, hiy)));
+                if(vmaxvq_u32(valid) == 0)
+                    continue;
+                x = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), valid));
+                y = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), valid));
+                const float32x4_t fx = vrndmq_f32(x);
+                const float32x4_t fy = vrndmq_f32(y);
+                const float32x4_t wx = vsubq_f32(x, fx);
+                const float32x4_t wy = vsubq_f32(y, fy);
+                const int32x4_t ix = vcvtq_s32_f32(fx);
+                const int32x4_t iy = vcvtq_s32_f32(fy);
+                const int32x4_t ix0 = vmaxq_s32(ix, zero);
+                const int32x4_t ix1 = vminq_s32(vaddq_s32(ix, one), maxx);
+                const int32x4_t row0 = vmulq_s32(vmaxq_s32(iy, zero), stride);
+                const int32x4_t row1 = vmulq_s32(vminq_s32(vaddq_s32(iy, one), maxy), stride);
+                int32_t i00[4], i01[4], i10[4], i11[4];
+                vst1q_s32(i00, vaddq_s32(row0, ix0));
+                vst1q_s32(i01, vaddq_s32(row0, ix1));
+                vst1q_s32(i10, vaddq_s32(row1, ix0));
+                vst1q_s32(i11, vaddq_s32(row1, ix1));
+                const float v00[4] = { src[i00[0]], src[i00[1]], src[i00[2]], src[i00[3]] };
+                const float v01[4] = { src[i01[0]], src[i01[1]], src[i01[2]], src[i01[3]] };
+                const float v10[4] = { src[i10[0]], src[i10[1]], src[i10[2]], src[i10[3]] };
+                const float v11[4] = { src[i11[0]], src[i11[1]], src[i11[2]], src[i11[3]] };
+                const float32x4_t p00 = vld1q_f32(v00);
+                const float32x4_t p01 = vld1q_f32(v01);
+                const float32x4_t p10 = vld1q_f32(v10);
+                const float32x4_t p11 = vld1q_f32(v11);
+                const float32x4_t top = vfmaq_f32(p00, wx, vsubq_f32(p01, p00));
+                const float32x4_t bottom = vfmaq_f32(p10, wx, vsubq_f32(p11, p10));
+                const float32x4_t value = vfmaq_f32(top, wy, vsubq_f32(bottom, top));
+                vst1q_f32(dst + i, vbslq_f32(valid, value, vld1q_f32(dst + i)));
+            }
+            if(i < count)
+                LinearRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, dst + i, count - i);
+        }
+
+        void CompositeRow32f_NEON(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float noData, float *dst, u_char *filled, int count)
+        {
+            const float32x4_t lo = vdupq_n_f32(-0.5f);
+            const float32x4_t hix = vdupq_n_f32(srcWidth - 0.5f);
+            const float32x4_t hiy = vdupq_n_f32(srcHeight - 0.5f);
+            const float32x4_t nodata = vdupq_n_f32(noData);
+            const int32x4_t zero = vdupq_n_s32(0);
+            const int32x4_t one = vdupq_n_s32(1);
+            const int32x4_t maxx = vdupq_n_s32(srcWidth - 1);
+            const int32x4_t maxy = vdupq_n_s32(srcHeight - 1);
+            const int32x4_t stride = vdupq_n_s32(srcStride);
+            int i = 0;
+            for(; i + 4 <= count; i += 4)
+            {
+                if(filled[i] && filled[i + 1] && filled[i + 2] && filled[i + 3])
+                    continue;
+                const uint32_t done[4] = { filled[i], filled[i + 1], filled[i + 2], filled[i + 3] };
+                float32x4_t x = vld1q_f32(sx + i);
+                float32x4_t y = vld1q_f32(sy + i);
+                uint32x4_t valid = vandq_u32(vceqq_u32(vld1q_u32(done), vdupq_n_u32(0)), vandq_u32(
+                    vandq_u32(vcgeq_f32(x, lo), vcltq_f32(x, hix)),
+                    vandq_u32(vcgeq_f32(y, lo), vcltq_f32(y, hiy))));
+                if(vmaxvq_u32(valid) == 0)
+                    continue;
+                x = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), valid));
+                y = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), valid));
+                const float32x4_t fx = vrndmq_f32(x);
+                const float32x4_t fy = vrndmq_f32(y);
+                const float32x4_t wx = vsubq_f32(x, fx);
+                const float32x4_t wy = vsubq_f32(y, fy);
+                const int32x4_t ix = vcvtq_s32_f32(fx);
+                const int32x4_t iy = vcvtq_s32_f32(fy);
+                const int32x4_t ix0 = vmaxq_s32(ix, zero);
+                const int32x4_t ix1 = vminq_s32(vaddq_s32(ix, one), maxx);
+                const int32x4_t row0 = vmulq_s32(vmaxq_s32(iy, zero), stride);
+                const int32x4_t row1 = vmulq_s32(vminq_s32(vaddq_s32(iy, one), maxy), stride);
+                int32_t i00[4], i01[4], i10[4], i11[4];
+                vst1q_s32(i00, vaddq_s32(row0, ix0));
+                vst1q_s32(i01, vaddq_s32(row0, ix1));
+                vst1q_s32(i10, vaddq_s32(row1, ix0));
+                vst1q_s32(i11, vaddq_s32(row1, ix1));
+                const float v00[4] = { src[i00[0]], src[i00[1]], src[i00[2]], src[i00[3]] };
+                const float v01[4] = { src[i01[0]], src[i01[1]], src[i01[2]], src[i01[3]] };
+                const float v10[4] = { src[i10[0]], src[i10[1]], src[i10[2]], src[i10[3]] };
+                const float v11[4] = { src[i11[0]], src[i11[1]], src[i11[2]], src[i11[3]] };
+                const float32x4_t p00 = vld1q_f32(v00);
+                const float32x4_t p01 = vld1q_f32(v01);
+                const float32x4_t p10 = vld1q_f32(v10);
+                const float32x4_t p11 = vld1q_f32(v11);
+                const float32x4_t lowest = vminq_f32(vminq_f32(p00, p01), vminq_f32(p10, p11));
+                valid = vandq_u32(valid, vcgtq_f32(lowest, nodata));
+                if(vmaxvq_u32(valid) == 0)
+                    continue;
+                const float32x4_t top = vfmaq_f32(p00, wx, vsubq_f32(p01, p00));
+                const float32x4_t bottom = vfmaq_f32(p10, wx, vsubq_f32(p11, p10));
+                const float32x4_t value = vfmaq_f32(top, wy, vsubq_f32(bottom, top));
+                vst1q_f32(dst + i, vbslq_f32(valid, value, vld1q_f32(dst + i)));
+                uint32_t lanes[4];
+                vst1q_u32(lanes, valid);
+                for(int k = 0; k < 4; ++k)
+                {
+                    if(lanes[k])
+                        filled[i + k] = 1;
+                }
+            }
+            if(i < count)
+                CompositeRow32f_Scalar(src, srcWidth, srcHeight, srcStride, sx + i, sy + i, noData, dst + i, filled + i, count - i);
+        }
+
+        inline float32x4_t LoadRGB_NEON(const u_char *pixel)
+        {
+            const uint32_t value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+            return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(value)))));
+        }
+
+        inline void StoreRGB_NEON(u_char *dst, float32x4_t value)
+        {
+            // vcvtq_u32_f32 and the narrowing moves saturate, as StoreValue() clamps
+            const uint32x4_t rounded = vcvtq_u32_f32(vrndmq_f32(vaddq_f32(value, vdupq_n_f32(0.5f))));
+            const uint8x8_t packed = vqmovn_u16(vcombine_u16(vqmovn_u32(rounded), vdup_n_u16(0)));
+            dst[0] = vget_lane_u8(packed, 0);
+            dst[1] = vget_lane_u8(packed, 1);
+            dst[2] = vget_lane_u8(packed, 2);
+        }
+
+        void LinearRow8uC3_NEON(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                const float32x4_t ax = vdupq_n_f32(sx[i] - fx);
+                const float32x4_t ay = vdupq_n_f32(sy[i] - fy);
+                const int ix0 = Clamp(int(fx), 0, srcWidth - 1) * 3;
+                const int ix1 = Clamp(int(fx) + 1, 0, srcWidth - 1) * 3;
+                const u_char *row0 = src + (size_t)Clamp(int(fy), 0, srcHeight - 1) * srcStride;
+                const u_char *row1 = src + (size_t)Clamp(int(fy) + 1, 0, srcHeight - 1) * srcStride;
+                const float32x4_t p00 = LoadRGB_NEON(row0 + ix0);
+                const float32x4_t p01 = LoadRGB_NEON(row0 + ix1);
+                const float32x4_t p10 = LoadRGB_NEON(row1 + ix0);
+                const float32x4_t p11 = LoadRGB_NEON(row1 + ix1);
+                const float32x4_t top = vfmaq_f32(p00, ax, vsubq_f32(p01, p00));
+                const float32x4_t bottom = vfmaq_f32(p10, ax, vsubq_f32(p11, p10));
+                StoreRGB_NEON(dst + i * 3, vfmaq_f32(top, ay, vsubq_f32(bottom, top)));
+            }
+        }
+
+        void CubicRow8uC3_NEON(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                if(!InsideSource(sx[i], sy[i], srcWidth, srcHeight))
+                    continue;
+                const float fx = floorf(sx[i]);
+                const float fy = floorf(sy[i]);
+                float wx[4], wy[4];
+                CubicWeights(sx[i] - fx, wx);
+                CubicWeights(sy[i] - fy, wy);
+                int cols[4];
+                for(int k = 0; k < 4; ++k)
+                    cols[k] = Clamp(int(fx) - 1 + k, 0, srcWidth - 1) * 3;
+                float32x4_t value = vdupq_n_f32(0.0f);
+                for(int r = 0; r < 4; ++r)
+                {
+                    const u_char *row = src + (size_t)Clamp(int(fy) - 1 + r, 0, srcHeight - 1) * srcStride;
+                    float32x4_t sum = vmulq_n_f32(LoadRGB_NEON(row + cols[0]), wx[0]);
+                    sum = vfmaq_n_f32(sum, LoadRGB_NEON(row + cols[1]), wx[1]);
+                    sum = vfmaq_n_f32(sum, LoadRGB_NEON(row + cols[2]), wx[2]);
+                    sum = vfmaq_n_f32(sum, LoadRGB_NEON(row + cols[3]), wx[3]);
+                    value = vfmaq_n_f32(value, sum, wy[r]);
+                }
+                StoreRGB_NEON(dst + i * 3, value);
+            }
+        }
+
+#endif
+
+        WarpKernels SelectKernels()
+        {
+            WarpKernels kernels = { "scalar", MapRow_Scalar, LinearRow32f_Scalar, CompositeRow32f_Scalar, LinearRow<u_char, 3>, CubicRow<u_char, 3> };
+            // COG_WARP_ISA caps the selection so the tiers can be compared on one machine
+            const char *cap = getenv("COG_WARP_ISA");
+            if(cap && (strcmp(cap, "scalar") == 0))
+                return kernels;
+#if defined(IP_WARP_X86)
+            if(!(cap && (strcmp(cap, "sse4.1") == 0)) && CPUSupportsAVX2())
+            {
+                kernels.name = "avx2";
+                kernels.mapRow = MapRow_AVX2;
+                kernels.linearRow32f = LinearRow32f_AVX2;
+                kernels.compositeRow32f = CompositeRow32f_AVX2;
+                kernels.linearRow8uC3 = LinearRow8uC3_SSE41;
+                kernels.cubicRow8uC3 = CubicRow8uC3_SSE41;
+            }
+            else if(CPUSupportsSSE41())
+            {
+                kernels.name = "sse4.1";
+                kernels.mapRow = MapRow_SSE41;
+                kernels.linearRow32f = LinearRow32f_SSE41;
+                kernels.compositeRow32f = CompositeRow32f_SSE41;
+                kernels.linearRow8uC3 = LinearRow8uC3_SSE41;
+                kernels.cubicRow8uC3 = CubicRow8uC3_SSE41;
+            }
+#elif defined(IP_WARP_NEON)
+            kernels.name = "neon";
+            kernels.mapRow = MapRow_NEON;
+            kernels.linearRow32f = LinearRow32f_NEON;
+            kernels.compositeRow32f = CompositeRow32f_NEON;
+            kernels.linearRow8uC3 = LinearRow8uC3_NEON;
+            kernels.cubicRow8uC3 = CubicRow8uC3_NEON;
+#endif
+            return kernels;
+        }
+
+        const WarpKernels &Kernels()
+        {
+            static const WarpKernels kernels = SelectKernels();
+            return kernels;
+        }
+
+        // 32f C1 bilinear and 8u C3 bilinear/cubic go through the vectorised kernels, everything else through the templates
+        template<typename T, int CHANNELS>
+        void SampleLinearRow(const T *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, T *dst, int count)
+        {
+            LinearRow<T, CHANNELS>(src, srcWidth, srcHeight, srcStride, sx, sy, dst, count);
+        }
+
+        template<>
+        void SampleLinearRow<float, 1>(const float *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, float *dst, int count)
+        {
+            Kernels().linearRow32f(src, srcWidth, srcHeight, srcStride, sx, sy, dst, count);
+        }
+
+        template<>
+        void SampleLinearRow<u_char, 3>(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            Kernels().linearRow8uC3(src, srcWidth, srcHeight, srcStride, sx, sy, dst, count);
+        }
+
+        template<typename T, int CHANNELS>
+        void SampleCubicRow(const T *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, T *dst, int count)
+        {
+            CubicRow<T, CHANNELS>(src, srcWidth, srcHeight, srcStride, sx, sy, dst, count);
+        }
+
+        template<>
+        void SampleCubicRow<u_char, 3>(const u_char *src, int srcWidth, int srcHeight, int srcStride, const float *sx, const float *sy, u_char *dst, int count)
+        {
+            Kernels().cubicRow8uC3(src, srcWidth, srcHeight, srcStride, sx, sy, dst, count);
+        }
+
+        bool InvertTransform(const double m[3][3], double inv[3][3])
+        {
+            const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+            const double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+            const double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+            const double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+            if(fabs(det) < DBL_EPSILON * DBL_EPSILON)
+                return false;
+            const double rdet = 1.0 / det;
+            inv[0][0] = c00 * rdet;
+            inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * rdet;
+            inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * rdet;
+            inv[1][0] = c01 * rdet;
+            inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * rdet;
+            inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * rdet;
+            inv[2][0] = c02 * rdet;
+            inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * rdet;
+            inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * rdet;
+            return true;
+        }
+
+        // Destination pixel rectangle touched by the source footprint; false if it misses the destination entirely.
+        bool DestinationBounds(const double m[3][3], int srcWidth, int srcHeight, int dstWidth, int dstHeight, int &xmin, int &xmax, int &ymin, int &ymax)
+        {
+            const double corners[4][2] = {
+                { -0.5, -0.5 },
+                { srcWidth - 0.5, -0.5 },
+                { srcWidth - 0.5, srcHeight - 0.5 },
+                { -0.5, srcHeight - 0.5 }
+            };
+            double left = DBL_MAX;
+            double right = -DBL_MAX;
+            double bottom = DBL_MAX;
+            double top = -DBL_MAX;
+            for(int i = 0; i < 4; ++i)
+            {
+                const double x = corners[i][0];
+                const double y = corners[i][1];
+                const double w = m[2][0] * x + m[2][1] * y + m[2][2];
+                if(w <= 0.0)
+                {
+                    // the footprint crosses the horizon; let the per-pixel test sort it out
+                    xmin = 0;
+                    xmax = dstWidth - 1;
+                    ymin = 0;
+                    ymax = dstHeight - 1;
+                    return true;
+                }
+                const double dx = (m[0][0] * x + m[0][1] * y + m[0][2]) / w;
+                const double dy = (m[1][0] * x + m[1][1] * y + m[1][2]) / w;
+                left = std::min<double>(left, dx);
+                right = std::max<double>(right, dx);
+                bottom = std::min<double>(bottom, dy);
+                top = std::max<double>(top, dy);
+            }
+            if((right < -1.0) || (top < -1.0) || (left > dstWidth) || (bottom > dstHeight))
+                return false;
+            xmin = std::max<int>(0, int(floor(left)));
+            xmax = std::min<int>(dstWidth - 1, int(ceil(right)));
+            ymin = std::max<int>(0, int(floor(bottom)));
+            ymax = std::min<int>(dstHeight - 1, int(ceil(top)));
+            return (xmin <= xmax) && (ymin <= ymax);
+        }
+
+        template<typename T, int CHANNELS>
+        bool WarpPerspective(const T *src, int srcWidth, int srcHeight, int srcStep, T *dst, int dstWidth, int dstHeight, int dstStep, const double coeffs[3][3], WarpInterpolation interpolation)
+        {
+            if(!src || !dst || (srcWidth < 1) || (srcHeight < 1) || (dstWidth < 1) || (dstHeight < 1))
+                return false;
+            double inv[3][3];
+            if(!InvertTransform(coeffs, inv))
+                return false;
+            int xmin, xmax, ymin, ymax;
+            if(!DestinationBounds(coeffs, srcWidth, srcHeight, dstWidth, dstHeight, xmin, xmax, ymin, ymax))
+                return true;
+
+            const WarpKernels &kernels = Kernels();
+            const int srcStride = srcStep / sizeof(T);
+            const int count = xmax - xmin + 1;
+            std::vector<float> sx(count);
+            std::vector<float> sy(count);
+            for(int y = ymin; y <= ymax; ++y)
+            {
+                kernels.mapRow(inv, y, xmin, count, &sx[0], &sy[0]);
+                T *row = (T *)((u_char *)dst + (size_t)y * dstStep) + xmin * CHANNELS;
+                switch(interpolation)
+                {
+                case WARP_NEAREST:
+                    NearestRow<T, CHANNELS>(src, srcWidth, srcHeight, srcStride, &sx[0], &sy[0], row, count);
+                    break;
+                case WARP_LINEAR:
+                    SampleLinearRow<T, CHANNELS>(src, srcWidth, srcHeight, srcStride, &sx[0], &sy[0], row, count);
+                    break;
+                case WARP_CUBIC:
+                    SampleCubicRow<T, CHANNELS>(src, srcWidth, srcHeight, srcStride, &sx[0], &sy[0], row, count);
+                    break;
+                default:
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }
+
+    bool GetPerspectiveTransform(int srcWidth, int srcHeight, const double quad[4][2], double coeffs[3][3])
+    {
+        if((srcWidth < 2) || (srcHeight < 2))
+            return false;
+
+        // unit square to quad (Heckbert), then scale the source rectangle down to the unit square
+        const double x0 = quad[0][0], y0 = quad[0][1];
+        const double x1 = quad[1][0], y1 = quad[1][1];
+        const double x2 = quad[2][0], y2 = quad[2][1];
+        const double x3 = quad[3][0], y3 = quad[3][1];
+        const double sx = x0 - x1 + x2 - x3;
+        const double sy = y0 - y1 + y2 - y3;
+        double g = 0.0;
+        double h = 0.0;
+        if((sx != 0.0) || (sy != 0.0))
+        {
+            const double dx1 = x1 - x2;
+            const double dx2 = x3 - x2;
+            const double dy1 = y1 - y2;
+            const double dy2 = y3 - y2;
+            const double det = dx1 * dy2 - dx2 * dy1;
+            if(det == 0.0)
+                return false;
+            g = (sx * dy2 - dx2 * sy) / det;
+            h = (dx1 * sy - sx * dy1) / det;
+        }
+        const double su = 1.0 / (srcWidth - 1);
+        const double sv = 1.0 / (srcHeight - 1);
+        coeffs[0][0] = (x1 - x0 + g * x1) * su;
+        coeffs[0][1] = (x3 - x0 + h * x3) * sv;
+        coeffs[0][2] = x0;
+        coeffs[1][0] = (y1 - y0 + g * y1) * su;
+        coeffs[1][1] = (y3 - y0 + h * y3) * sv;
+        coeffs[1][2] = y0;
+        coeffs[2][0] = g * su;
+        coeffs[2][1] = h * sv;
+        coeffs[2][2] = 1.0;
+        return true;
+    }
+
+    bool WarpPerspective_8u_C3(const u_char *src, int srcWidth, int srcHeight, int srcStep,
+        u_char *dst, int dstWidth, int dstHeight, int dstStep,
+        const double coeffs[3][3], WarpInterpolation interpolation)
+    {
+        return WarpPerspective<u_char, 3>(src, srcWidth, srcHeight, srcStep, dst, dstWidth, dstHeight, dstStep, coeffs, interpolation);
+    }
+
+    bool WarpPerspective_32f_C1(const float *src, int srcWidth, int srcHeight, int srcStep,
+        float *dst, int dstWidth, int dstHeight, int dstStep,
+        const double coeffs[3][3], WarpInterpolation interpolation)
+    {
+        return WarpPerspective<float, 1>(src, srcWidth, srcHeight, srcStep, dst, dstWidth, dstHeight, dstStep, coeffs, interpolation);
+    }
+
+    bool WarpComposite_32f_C1(const float *src, int srcWidth, int srcHeight, int srcStep,
+        float *dst, int dstWidth, int dstHeight, int dstStep, u_char *filled, int filledStep,
+        const double coeffs[3][3], float noData)
+    {
+        if(!src || !dst || !filled || (srcWidth < 1) || (srcHeight < 1) || (dstWidth < 1) || (dstHeight < 1))
+            return false;
+        double inv[3][3];
+        if(!InvertTransform(coeffs, inv))
+            return false;
+        int xmin, xmax, ymin, ymax;
+        if(!DestinationBounds(coeffs, srcWidth, srcHeight, dstWidth, dstHeight, xmin, xmax, ymin, ymax))
+            return true;
+
+        const WarpKernels &kernels = Kernels();
+        const int srcStride = srcStep / sizeof(float);
+        const int count = xmax - xmin + 1;
+        std::vector<float> sx(count);
+        std::vector<float> sy(count);
+        for(int y = ymin; y <= ymax; ++y)
+        {
+            u_char *mask = filled + (size_t)y * filledStep + xmin;
+            // rows a higher priority source already covered cost nothing
+            if(!memchr(mask, 0, count))
+                continue;
+            kernels.mapRow(inv, y, xmin, count, &sx[0], &sy[0]);
+            float *row = (float *)((u_char *)dst + (size_t)y * dstStep) + xmin;
+            kernels.compositeRow32f(src, srcWidth, srcHeight, srcStride, &sx[0], &sy[0], noData, row, mask, count);
+        }
+        return true;
+    }
+
+    const char *WarpPerspectiveISA()
+    {
+        return Kernels().name;
+    }
+
+}
@@ -245,4 +245,43 @@ namespace ip {
         return true;
     }
 
+    bool EncodeJPG24(const ip::ImageInfo &info, const unsigned char *pixels, std::vector<unsigned char> &jpeg, int jpeg_quality)
+    {
+        struct jpeg_compress_struct cinfo;
+        struct my_error_mgr jerr;
+        JSAMPROW row_pointer[1];
+        unsigned char *outbuffer = NULL;
+        unsigned long outsize = 0;
+
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = my_error_exit;
+        jerr.pub.output_message = my_output_message;
+        if (setjmp(jerr.setjmp_buffer))
+        {
+            jpeg_destroy_compress(&cinfo);
+            free(outbuffer);
+            return false;
+        }
+        jpeg_create_compress(&cinfo);
+        cinfo.image_width = info.width;
+        cinfo.image_height = info.height;
+        cinfo.input_components = info.depth;
+        cinfo.in_color_space = JCS_RGB;
+
+        jpeg_mem_dest(&cinfo, &outbuffer, &outsize);
+        jpeg_set_defaults(&cinfo);
+        jpeg_set_quality(&cinfo, jpeg_quality, TRUE);
+        jpeg_start_compress(&cinfo, TRUE);
+        while (cinfo.next_scanline < cinfo.image_height)
+        {
+            row_pointer[0] = (unsigned char *)&pixels[cinfo.next_scanline * cinfo.image_width * cinfo.input_components];
+            jpeg_write_scanlines(&cinfo, row_pointer, 1);
+        }
+        jpeg_finish_compress(&cinfo);
+        jpeg.assign(outbuffer, outbuffer + outsize);
+        jpeg_destroy_compress(&cinfo);
+        free(outbuffer);
+        return true;
+    }
+
 }
@@ -22,13 +22,337 @@ DEALINGS IN THE SOFTWARE.
 
 #include "scenegraph/DrapeVisitor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
 namespace scenegraph
 {
+    namespace
+    {
+        struct DrapeTriangle
+        {
+            double x[3];
+            double y[3];
+            double z[3];
+            double minX, maxX, minY, maxY;
+        };
+
+        struct DrapeCrossing
+        {
+            double t;
+            double z;
+            bool operator<(const DrapeCrossing &other) const { return t < other.t; }
+        };
+
+        const double DRAPE_OFFSET = 0.5f;
+        const double DRAPE_EPSILON = 1e-9;
+
+        bool interpolateTriangle(const DrapeTriangle &tri, double x, double y, double &z)
+        {
+            if((x < tri.minX) || (x > tri.maxX) || (y < tri.minY) || (y > tri.maxY))
+                return false;
+            double denom = (tri.y[1] - tri.y[2]) * (tri.x[0] - tri.x[2]) + (tri.x[2] - tri.x[1]) * (tri.y[0] - tri.y[2]);
+            double a = ((tri.y[1] - tri.y[2]) * (x - tri.x[2]) + (tri.x[2] - tri.x[1]) * (y - tri.y[2])) / denom;
+            double b = ((tri.y[2] - tri.y[0]) * (x - tri.x[2]) + (tri.x[0] - tri.x[2]) * (y - tri.y[2])) / denom;
+            double c = 1.0 - a - b;
+            if((a < -DRAPE_EPSILON) || (b < -DRAPE_EPSILON) || (c < -DRAPE_EPSILON))
+                return false;
+            z = a * tri.z[0] + b * tri.z[1] + c * tri.z[2];
+            return true;
+        }
+    }
+
+    // Terrain triangles in a uniform grid of roughly one triangle per cell, stored as cell offsets into one index list.
+    struct DrapeTerrainIndex
+    {
+        std::vector<DrapeTriangle> triangles;
+        std::vector<uint32_t> cellStart;
+        std::vector<uint32_t> cellTriangles;
+        double minX, minY, maxX, maxY;
+        double scaleX, scaleY;
+        int cols, rows;
+
+        explicit DrapeTerrainIndex(const Scene *terrain)
+            : minX(0), minY(0), maxX(0), maxY(0), scaleX(0), scaleY(0), cols(1), rows(1)
+        {
+            for(FaceList::const_iterator it = terrain->faces.begin(), end = terrain->faces.end(); it != end; ++it)
+            {
+                const std::vector<sfa::Point> &verts = it->verts;
+                for(size_t i = 2, c = verts.size(); i < c; ++i)
+                {
+                    const sfa::Point *p[3] = { &verts[0], &verts[i - 1], &verts[i] };
+                    DrapeTriangle tri;
+                    for(int k = 0; k < 3; ++k)
+                    {
+                        tri.x[k] = p[k]->X();
+                        tri.y[k] = p[k]->Y();
+                        tri.z[k] = p[k]->Z();
+                    }
+                    double area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.x[2] - tri.x[0]) * (tri.y[1] - tri.y[0]);
+                    if(area == 0)
+                        continue;
+                    tri.minX = std::min<double>(tri.x[0], std::min<double>(tri.x[1], tri.x[2]));
+                    tri.maxX = std::max<double>(tri.x[0], std::max<double>(tri.x[1], tri.x[2]));
+                    tri.minY = std::min<double>(tri.y[0], std::min<double>(tri.y[1], tri.y[2]));
+                    tri.maxY = std::max<double>(tri.y[0], std::max<double>(tri.y[1], tri.y[2]));
+                    // keep the containment test inclusive of points a rounding error outside the edges
+                    double padX = (tri.maxX - tri.minX) * DRAPE_EPSILON;
+                    double padY = (tri.maxY - tri.minY) * DRAPE_EPSILON;
+                    tri.minX -= padX;
+                    tri.maxX += padX;
+                    tri.minY -= padY;
+                    tri.maxY += padY;
+                    triangles.push_back(tri);
+                }
+            }
+            if(triangles.empty())
+                return;
+
+            minX = minY = std::numeric_limits<double>::max();
+            maxX = maxY = -std::numeric_limits<double>::max();
+            for(size_t i = 0, c = triangles.size(); i < c; ++i)
+            {
+                minX = std::min<double>(minX, triangles[i].minX);
+                maxX = std::max<double>(maxX, triangles[i].maxX);
+                minY = std::min<double>(minY, triangles[i].minY);
+                maxY = std::max<double>(maxY, triangles[i].maxY);
+            }
+            double width = maxX - minX;
+            double height = maxY - minY;
+            double cells = double(triangles.size());
+            if((width > 0) && (height > 0))
+            {
+                cols = int(std::ceil(std::sqrt(cells * width / height)));
+                rows = int(std::ceil(cells / cols));
+            }
+            else if(width > 0)
+                cols = int(cells);
+            else if(height > 0)
+                rows = int(cells);
+            cols = std::max<int>(1, std::min<int>(cols, 4096));
+            rows = std::max<int>(1, std::min<int>(rows, 4096));
+            scaleX = (width > 0) ? cols / width : 0;
+            scaleY = (height > 0) ? rows / height : 0;
+
+            cellStart.assign(size_t(cols) * rows + 1, 0);
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                if(pass == 1)
+                {
+                    for(size_t i = 1; i < cellStart.size(); ++i)
+                        cellStart[i] += cellStart[i - 1];
+                    cellTriangles.resize(cellStart.back());
+                }
+                for(size_t i = 0, c = triangles.size(); i < c; ++i)
+                {
+                    const DrapeTriangle &tri = triangles[i];
+                    int col0 = col(tri.minX), col1 = col(tri.maxX);
+                    int row0 = row(tri.minY), row1 = row(tri.maxY);
+                    for(int r = row0; r <= row1; ++r)
+                    {
+                        for(int q = col0; q <= col1; ++q)
+                        {
+                            size_t cell = size_t(r) * cols + q;
+                            if(pass == 0)
+                                ++cellStart[cell + 1];
+                            else
+                                cellTriangles[cellStart[cell]++] = uint32_t(i);
+                        }
+                    }
+                }
+            }
+            // the fill pass advanced each start to the next cell's start
+            for(size_t i = cellStart.size() - 1; i > 0; --i)
+                cellStart[i] = cellStart[i - 1];
+            cellStart[0] = 0;
+        }
+
+        int col(double x) const { return std::max<int>(0, std::min<int>(cols - 1, int((x - minX) * scaleX))); }
+        int row(double y) const { return std::max<int>(0, std::min<int>(rows - 1, int((y - minY) * scaleY))); }
+
+        // Height of the first terrain triangle (in terrain face order) containing the point.
+        bool height(double x, double y, double &z) const
+        {
+            if(triangles.empty() || (x < minX) || (x > maxX) || (y < minY) || (y > maxY))
+                return false;
+            size_t cell = size_t(row(y)) * cols + col(x);
+            for(uint32_t i = cellStart[cell], end = cellStart[cell + 1]; i < end; ++i)
+            {
+                if(interpolateTriangle(triangles[cellTriangles[i]], x, y, z))
+                    return true;
+            }
+            return false;
+        }
+
+        // Terrain triangles in the cells the segment passes through, row by row.
+        void candidates(double x0, double y0, double x1, double y1, std::vector<uint32_t> &result) const
+        {
+            result.clear();
+            if(triangles.empty())
+                return;
+            if((std::max<double>(x0, x1) < minX) || (std::min<double>(x0, x1) > maxX) || (std::max<double>(y0, y1) < minY) || (std::min<double>(y0, y1) > maxY))
+                return;
+            double gx0 = (x0 - minX) * scaleX, gx1 = (x1 - minX) * scaleX;
+            double gy0 = (y0 - minY) * scaleY, gy1 = (y1 - minY) * scaleY;
+            int row0 = row(std::min<double>(y0, y1)), row1 = row(std::max<double>(y0, y1));
+            for(int r = row0; r <= row1; ++r)
+            {
+                double t0 = 0, t1 = 1;
+                if(gy1 != gy0)
+                {
+                    double lo = (r == 0) ? -std::numeric_limits<double>::max() : double(r);
+                    double hi = (r == rows - 1) ? std::numeric_limits<double>::max() : double(r + 1);
+                    double ta = (lo - gy0) / (gy1 - gy0);
+                    double tb = (hi - gy0) / (gy1 - gy0);
+                    t0 = std::max<double>(0, std::min<double>(ta, tb));
+                    t1 = std::min<double>(1, std::max<double>(ta, tb));
+                    if(t0 > t1)
+                        continue;
+                }
+                double ga = gx0 + (gx1 - gx0) * t0;
+                double gb = gx0 + (gx1 - gx0) * t1;
+                int col0 = std::max<int>(0, std::min<int>(cols - 1, int(std::floor(std::min<double>(ga, gb)))));
+                int col1 = std::max<int>(0, std::min<int>(cols - 1, int(std::floor(std::max<double>(ga, gb)))));
+                for(int q = col0; q <= col1; ++q)
+                {
+                    size_t cell = size_t(r) * cols + q;
+                    result.insert(result.end(), cellTriangles.begin() + cellStart[cell], cellTriangles.begin() + cellStart[cell + 1]);
+                }
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+        }
+
+        // Points in (0,1) along the segment where it crosses a terrain edge, with the terrain height there.
+        void crossings(const sfa::Point &a, const sfa::Point &b, std::vector<uint32_t> &scratch, std::vector<DrapeCrossing> &result) const
+        {
+            result.clear();
+            candidates(a.X(), a.Y(), b.X(), b.Y(), scratch);
+            double dx = b.X() - a.X();
+            double dy = b.Y() - a.Y();
+            for(size_t i = 0, c = scratch.size(); i < c; ++i)
+            {
+                const DrapeTriangle &tri = triangles[scratch[i]];
+                for(int k = 0; k < 3; ++k)
+                {
+                    int n = (k + 1) % 3;
+                    double ex = tri.x[n] - tri.x[k];
+                    double ey = tri.y[n] - tri.y[k];
+                    double denom = dx * ey - dy * ex;
+                    if(std::fabs(denom) <= DRAPE_EPSILON * (std::fabs(dx * ey) + std::fabs(dy * ex)))
+                        continue;
+                    double wx = tri.x[k] - a.X();
+                    double wy = tri.y[k] - a.Y();
+                    double t = (wx * ey - wy * ex) / denom;
+                    double u = (wx * dy - wy * dx) / denom;
+                    if((t <= DRAPE_EPSILON) || (t >= 1 - DRAPE_EPSILON) || (u < -DRAPE_EPSILON) || (u > 1 + DRAPE_EPSILON))
+                        continue;
+                    u = std::max<double>(0, std::min<double>(1, u));
+                    DrapeCrossing crossing = { t, tri.z[k] + (tri.z[n] - tri.z[k]) * u };
+                    result.push_back(crossing);
+                }
+            }
+            std::sort(result.begin(), result.end());
+            // shared terrain edges and terrain vertices on the segment report the same point more than once
+            size_t kept = 0;
+            for(size_t i = 0, c = result.size(); i < c; ++i)
+            {
+                if(kept && (result[i].t - result[kept - 1].t <= DRAPE_EPSILON))
+                    continue;
+                result[kept++] = result[i];
+            }
+            result.resize(kept);
+        }
+    };
+
+    namespace
+    {
+        void drapeFace(const DrapeTerrainIndex &index, Face &face, bool splitEdges, std::vector<uint32_t> &scratch, std::vector<DrapeCrossing> &crossings)
+        {
+            size_t numVerts = face.verts.size();
+            if(!splitEdges || (numVerts < 2))
+            {
+                for(size_t i = 0; i < numVerts; ++i)
+                {
+                    sfa::Point &point = face.verts[i];
+                    double z;
+                    if(index.height(point.X(), point.Y(), z))
+                        point.setZ(z + DRAPE_OFFSET);
+                }
+                return;
+            }
+
+            bool hasNormals = (face.vertexNormals.size() == numVerts);
+            std::vector<bool> hasUVs(face.textures.size());
+            for(size_t k = 0; k < face.textures.size(); ++k)
+                hasUVs[k] = (face.textures[k].uvs.size() == numVerts);
+
+            std::vector<sfa::Point> verts;
+            std::vector<sfa::Point> normals;
+            std::vector<std::vector<sfa::Point> > uvs(face.textures.size());
+            // two vertices are a line; anything more is a closed ring without a repeated first vertex
+            size_t numEdges = (numVerts == 2) ? 1 : numVerts;
+            for(size_t i = 0; i < numVerts; ++i)
+            {
+                const sfa::Point &a = face.verts[i];
+                sfa::Point draped(a);
+                double z;
+                if(index.height(a.X(), a.Y(), z))
+                    draped.setZ(z + DRAPE_OFFSET);
+                verts.push_back(draped);
+                if(hasNormals)
+                    normals.push_back(face.vertexNormals[i]);
+                for(size_t k = 0; k < uvs.size(); ++k)
+                {
+                    if(hasUVs[k])
+                        uvs[k].push_back(face.textures[k].uvs[i]);
+                }
+                if(i >= numEdges)
+                    continue;
+
+                size_t j = (i + 1) % numVerts;
+                const sfa::Point &b = face.verts[j];
+                index.crossings(a, b, scratch, crossings);
+                for(size_t c = 0; c < crossings.size(); ++c)
+                {
+                    double t = crossings[c].t;
+                    sfa::Point point(a.X() + (b.X() - a.X()) * t, a.Y() + (b.Y() - a.Y()) * t, crossings[c].z + DRAPE_OFFSET);
+                    verts.push_back(point);
+                    if(hasNormals)
+                    {
+                        sfa::Point normal = face.vertexNormals[i] + (face.vertexNormals[j] - face.vertexNormals[i]) * t;
+                        normal.normalize();
+                        normals.push_back(normal);
+                    }
+                    // the face is planar before draping, so its texture mapping is linear along the edge
+                    for(size_t k = 0; k < uvs.size(); ++k)
+                    {
+                        if(hasUVs[k])
+                            uvs[k].push_back(face.textures[k].uvs[i] + (face.textures[k].uvs[j] - face.textures[k].uvs[i]) * t);
+                    }
+                }
+            }
+            face.verts.swap(verts);
+            if(hasNormals)
+                face.vertexNormals.swap(normals);
+            for(size_t k = 0; k < uvs.size(); ++k)
+            {
+                if(hasUVs[k])
+                    face.textures[k].uvs.swap(uvs[k]);
+            }
+        }
+    }
+
     DrapeVisitor::~DrapeVisitor(void)
     {
     }
 
-    DrapeVisitor::DrapeVisitor(Scene *terrainScene) : terrainScene(terrainScene)
+    DrapeVisitor::DrapeVisitor(Scene *terrainScene) : terrainScene(terrainScene), indexed(false), splitEdges(false), threads(0)
     {
     }
 
@@ -37,6 +361,13 @@ namespace scenegraph
         if(!terrainScene)
             return;
 
+        if(indexed)
+        {
+            drapeIndexed(scene);
+            traverse(scene);
+            return;
+        }
+
         for(FaceList::iterator terrainIT = terrainScene->faces.begin(), terrainEND = terrainScene->faces.end(); terrainIT != terrainEND; ++terrainIT)
         {
             Face &terrainFace = *terrainIT;
@@ -62,10 +393,53 @@ namespace scenegraph
         traverse(scene);
     }
 
-    void DrapeVisitor::setTerrainScene(Scene *scene)
+    void DrapeVisitor::drapeIndexed(Scene *scene)
+    {
+        if(scene->faces.empty())
+            return;
+        // the index is built on the first scene visited and kept for the rest of the traversal
+        if(!terrainIndex)
+            terrainIndex.reset(new DrapeTerrainIndex(terrainScene));
+        const DrapeTerrainIndex &index = *terrainIndex;
+
+        size_t workers = (threads > 0) ? size_t(threads) : std::max<size_t>(1, std::thread::hardware_concurrency());
+        workers = std::min(workers, scene->faces.size());
+        std::atomic<size_t> next { 0 };
+        auto drape = [&]()
+        {
+            std::vector<uint32_t> scratch;
+            std::vector<DrapeCrossing> crossings;
+            for(auto i = next++; i < scene->faces.size(); i = next++)
+                drapeFace(index, scene->faces[i], splitEdges, scratch, crossings);
+        };
+        std::vector<std::thread> workerThreads;
+        for(size_t i = 1; i < workers; ++i)
+            workerThreads.emplace_back(drape);
+        drape();
+        for(auto &thread : workerThreads)
+            thread.join();
+    }
+
+    void DrapeVisitor::setTerrainScene(Scene *terrainScene)
     {
         this->terrainScene = terrainScene;
+        terrainIndex.reset();
+    }
+
+    void DrapeVisitor::setIndexed(bool indexed)
+    {
+        this->indexed = indexed;
+    }
+
+    void DrapeVisitor::setSplitEdges(bool splitEdges)
+    {
+        this->splitEdges = splitEdges;
+    }
+
+    void DrapeVisitor::setThreads(int threads)
+    {
+        this->threads = threads;
     }
 
 
-}
\ No newline at end of file
+}
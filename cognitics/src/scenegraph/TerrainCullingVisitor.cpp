@@ -21,6 +21,7 @@ DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 
 #include "scenegraph/TerrainCullingVisitor.h"
+#include <sfa/PreparedPolygon.h>
 
 namespace scenegraph
 {
@@ -34,21 +35,35 @@ namespace scenegraph
 
     void TerrainCullingVisitor::visiting(Scene *scene)
     {
-        for(FaceList::iterator it = scene->faces.begin(), end = scene->faces.end(); it != end; ++it)
+        std::vector<sfa::PreparedPolygon> prepared(polygons.size());
+        for(size_t i = 0, c = polygons.size(); i < c; ++i)
+            prepared[i].assign(&polygons[i]);
+
+        // compact the kept faces in place rather than erasing from the middle of the vector
+        size_t kept = 0;
+        for(size_t f = 0, fc = scene->faces.size(); f < fc; ++f)
         {
-            Face &face = *it;
-            if(face.verts.empty())
-                continue;
-            sfa::Polygon terrainPolygon = face.getPolygon();
-            for(size_t i = 0, c = polygons.size(); i < c; ++i)
+            Face &face = scene->faces[f];
+            bool culled = false;
+            if(!face.verts.empty())
             {
-                if(polygons[i].contains(&terrainPolygon))
+                sfa::Polygon terrainPolygon = face.getPolygon();
+                for(size_t i = 0, c = prepared.size(); i < c; ++i)
                 {
-                    it = scene->faces.erase(it);
-                    break;
+                    if(prepared[i].contains(&terrainPolygon))
+                    {
+                        culled = true;
+                        break;
+                    }
                 }
             }
+            if(culled)
+                continue;
+            if(kept != f)
+                scene->faces[kept] = std::move(face);
+            ++kept;
         }
+        scene->faces.erase(scene->faces.begin() + kept, scene->faces.end());
 
         traverse(scene);
     }
@@ -10,7 +10,10 @@
 #include <ccl/FileInfo.h>
 #include <ccl/StringUtils.h>
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <thread>
 #ifdef COG_USE_GL
 #include <GL/glew.h>
 #include <GL/gl.h>
@@ -194,31 +197,301 @@ namespace cognitics {
         norms = newNorms;
     }
 
+    namespace
+    {
+        // Files are read this many bytes at a time; each block is split at line boundaries and parsed on all cores
+        const size_t OBJ_BLOCK_SIZE = 256 * 1024 * 1024;
+        const double OBJ_MAX_RESERVE_SCALE = 64.0;      // largest multiple of the first block's counts reserved up front
+
+        const double POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        inline bool isBlank(char c)
+        {
+            return (c == ' ') || (c == '\t');
+        }
+
+        // Lines end at LF, CR or CRLF; a CRLF just reads as a line and an empty one
+        inline bool isLineBreak(char c)
+        {
+            return (c == 0x0a) || (c == 0x0d);
+        }
+
+        inline const char *findLineBreak(const char *begin, const char *end)
+        {
+            const char *lf = (const char *)memchr(begin, 0x0a, end - begin);
+            if (!lf)
+                lf = end;
+            const char *cr = (const char *)memchr(begin, 0x0d, lf - begin);
+            return cr ? cr : lf;
+        }
+
+        // Returns the next blank-separated token in [pos, end) and advances pos past it
+        inline bool nextToken(const char *&pos, const char *end, const char *&tokenBegin, const char *&tokenEnd)
+        {
+            while ((pos < end) && isBlank(*pos))
+                ++pos;
+            if (pos == end)
+                return false;
+            tokenBegin = pos;
+            while ((pos < end) && !isBlank(*pos))
+                ++pos;
+            tokenEnd = pos;
+            return true;
+        }
+
+        inline bool tokenIs(const char *begin, const char *end, const char *keyword)
+        {
+            size_t len = strlen(keyword);
+            return (size_t(end - begin) == len) && (memcmp(begin, keyword, len) == 0);
+        }
+
+        // Same result as atof() on the token. Values that fit a 53-bit mantissa and a power of ten
+        // up to 1e22 are exact in double arithmetic; anything else goes through strtod.
+        double parseDouble(const char *begin, const char *end)
+        {
+            const char *p = begin;
+            bool negative = false;
+            if ((p < end) && ((*p == '-') || (*p == '+')))
+                negative = (*p++ == '-');
+            uint64_t mantissa = 0;
+            int significant = 0;
+            int exponent = 0;
+            bool anyDigits = false;
+            bool truncated = false;
+            for (; (p < end) && (*p >= '0') && (*p <= '9'); ++p)
+            {
+                anyDigits = true;
+                if ((mantissa == 0) && (*p == '0'))
+                    continue;
+                if (significant < 19)
+                {
+                    mantissa = (mantissa * 10) + (*p - '0');
+                    ++significant;
+                }
+                else
+                {
+                    ++exponent;
+                    truncated |= (*p != '0');
+                }
+            }
+            if ((p < end) && (*p == '.'))
+            {
+                for (++p; (p < end) && (*p >= '0') && (*p <= '9'); ++p)
+                {
+                    anyDigits = true;
+                    if ((mantissa == 0) && (*p == '0'))
+                    {
+                        --exponent;
+                        continue;
+                    }
+                    if (significant < 19)
+                    {
+                        mantissa = (mantissa * 10) + (*p - '0');
+                        ++significant;
+                        --exponent;
+                    }
+                    else
+                        truncated |= (*p != '0');
+                }
+            }
+            if (anyDigits && (p < end) && ((*p == 'e') || (*p == 'E')))
+            {
+                const char *q = p + 1;
+                bool negativeExponent = false;
+                if ((q < end) && ((*q == '-') || (*q == '+')))
+                    negativeExponent = (*q++ == '-');
+                if ((q < end) && (*q >= '0') && (*q <= '9'))
+                {
+                    int e = 0;
+                    for (; (q < end) && (*q >= '0') && (*q <= '9'); ++q)
+                        e = std::min(e * 10 + (*q - '0'), 100000);
+                    exponent += negativeExponent ? -e : e;
+                }
+            }
+            if (anyDigits && !truncated && (mantissa < (uint64_t(1) << 53)))
+            {
+                if (mantissa == 0)
+                    return negative ? -0.0 : 0.0;
+                if ((exponent >= -22) && (exponent <= 22))
+                {
+                    double value = double(mantissa);
+                    value = (exponent < 0) ? value / POW10[-exponent] : value * POW10[exponent];
+                    return negative ? -value : value;
+                }
+            }
+            char buffer[64];
+            size_t len = size_t(end - begin);
+            if (len < sizeof(buffer))
+            {
+                memcpy(buffer, begin, len);
+                buffer[len] = 0;
+                return strtod(buffer, NULL);
+            }
+            return strtod(std::string(begin, end).c_str(), NULL);
+        }
+
+        // Same result as atoi() on the token
+        inline int64_t parseIndex(const char *p, const char *end)
+        {
+            bool negative = false;
+            if ((p < end) && ((*p == '-') || (*p == '+')))
+                negative = (*p++ == '-');
+            int64_t value = 0;
+            for (; (p < end) && (*p >= '0') && (*p <= '9'); ++p)
+                value = (value * 10) + (*p - '0');
+            return negative ? -value : value;
+        }
+
+        // The result of parsing one chunk of an OBJ file, merged into the QuickObj in file order
+        struct ObjChunk
+        {
+            // A usemtl starts a new group; group 0 continues whatever submesh the previous chunk ended in
+            struct Group
+            {
+                bool newSubMesh;
+                std::string materialName;
+                size_t vertIdx;
+                size_t uvIdx;
+                size_t normIdx;
+            };
+
+            std::vector<QuickVert> verts;
+            std::vector<QuickVert> uvs;
+            std::vector<QuickVert> norms;
+            std::vector<uint32_t> vertIdxs;
+            std::vector<uint32_t> uvIdxs;
+            std::vector<uint32_t> normIdxs;
+            // Positions of negative (relative) indices, stored relative to the chunk's first element
+            std::vector<size_t> relativeVertIdxs;
+            std::vector<size_t> relativeUvIdxs;
+            std::vector<size_t> relativeNormIdxs;
+            std::vector<Group> groups;
+            std::vector<std::string> materialLibraries;
+            float minX, maxX, minY, maxY, minZ, maxZ;
+
+            ObjChunk() : minX(FLT_MAX), maxX(-FLT_MAX), minY(FLT_MAX), maxY(-FLT_MAX), minZ(FLT_MAX), maxZ(-FLT_MAX)
+            {
+                groups.push_back(Group{ false, std::string(), 0, 0, 0 });
+            }
+        };
+
+        inline void pushIndex(const char *begin, const char *end, size_t count, std::vector<uint32_t> &idxs, std::vector<size_t> &relative)
+        {
+            int64_t idx = parseIndex(begin, end);
+            if (idx < 0)
+            {
+                relative.push_back(idxs.size());
+                idx += int64_t(count) + 1;
+            }
+            idxs.push_back(uint32_t(idx));
+        }
+
+        void parseObjChunk(const char *begin, const char *end, const sfa::Point &offset, ObjChunk &chunk)
+        {
+            const char *tokenBegin;
+            const char *tokenEnd;
+            const char *lineBegin = begin;
+            while (lineBegin < end)
+            {
+                const char *lineEnd = findLineBreak(lineBegin, end);
+                const char *next = lineEnd + ((lineEnd < end) ? 1 : 0);
+                const char *pos = lineBegin;
+                lineBegin = next;
+                while ((lineEnd > pos) && (lineEnd[-1] == 0))
+                    --lineEnd;
+                if (!nextToken(pos, lineEnd, tokenBegin, tokenEnd))
+                    continue;
+
+                const char *x0, *x1, *y0, *y1, *z0, *z1;
+                if (tokenIs(tokenBegin, tokenEnd, "v"))
+                {
+                    if (!nextToken(pos, lineEnd, x0, x1) || !nextToken(pos, lineEnd, y0, y1))
+                        continue;
+                    QuickVert v;
+                    v.x = parseDouble(x0, x1) + offset.X();
+                    v.y = parseDouble(y0, y1) + offset.Y();
+                    if (nextToken(pos, lineEnd, z0, z1))
+                        v.z = parseDouble(z0, z1) + offset.Z();
+                    else
+                        v.z = offset.Z();
+                    chunk.minX = std::min<float>(chunk.minX, v.x);
+                    chunk.minY = std::min<float>(chunk.minY, v.y);
+                    chunk.minZ = std::min<float>(chunk.minZ, v.z);
+                    chunk.maxX = std::max<float>(chunk.maxX, v.x);
+                    chunk.maxY = std::max<float>(chunk.maxY, v.y);
+                    chunk.maxZ = std::max<float>(chunk.maxZ, v.z);
+                    chunk.verts.push_back(v);
+                }
+                else if (tokenIs(tokenBegin, tokenEnd, "vt"))
+                {
+                    if (!nextToken(pos, lineEnd, x0, x1) || !nextToken(pos, lineEnd, y0, y1))
+                        continue;
+                    QuickVert vt;
+                    vt.x = parseDouble(x0, x1);
+                    vt.y = parseDouble(y0, y1);
+                    vt.z = 0;
+                    chunk.uvs.push_back(vt);
+                }
+                else if (tokenIs(tokenBegin, tokenEnd, "vn"))
+                {
+                    if (!nextToken(pos, lineEnd, x0, x1) || !nextToken(pos, lineEnd, y0, y1))
+                        continue;
+                    QuickVert vn;
+                    vn.x = parseDouble(x0, x1);
+                    vn.y = parseDouble(y0, y1);
+                    vn.z = nextToken(pos, lineEnd, z0, z1) ? parseDouble(z0, z1) : 0;
+                    chunk.norms.push_back(vn);
+                }
+                else if (tokenIs(tokenBegin, tokenEnd, "f"))
+                {
+                    // v, v/vt, v/vt/vn or v//vn; an empty vt reads as index 0, as atoi() did
+                    while (nextToken(pos, lineEnd, tokenBegin, tokenEnd))
+                    {
+                        const char *slash1 = (const char *)memchr(tokenBegin, '/', tokenEnd - tokenBegin);
+                        const char *slash2 = slash1 ? (const char *)memchr(slash1 + 1, '/', tokenEnd - slash1 - 1) : NULL;
+                        const char *slash3 = slash2 ? (const char *)memchr(slash2 + 1, '/', tokenEnd - slash2 - 1) : NULL;
+                        pushIndex(tokenBegin, slash1 ? slash1 : tokenEnd, chunk.verts.size(), chunk.vertIdxs, chunk.relativeVertIdxs);
+                        if (slash1)
+                            pushIndex(slash1 + 1, slash2 ? slash2 : tokenEnd, chunk.uvs.size(), chunk.uvIdxs, chunk.relativeUvIdxs);
+                        if (slash2)
+                            pushIndex(slash2 + 1, slash3 ? slash3 : tokenEnd, chunk.norms.size(), chunk.normIdxs, chunk.relativeNormIdxs);
+                    }
+                }
+                else if (tokenIs(tokenBegin, tokenEnd, "mtllib"))
+                {
+                    if (nextToken(pos, lineEnd, x0, x1))
+                        chunk.materialLibraries.push_back(std::string(x0, x1));
+                }
+                else if (tokenIs(tokenBegin, tokenEnd, "usemtl"))
+                {
+                    std::string material;
+                    if (nextToken(pos, lineEnd, x0, x1))
+                        material.assign(x0, x1);
+                    chunk.groups.push_back(ObjChunk::Group{ true, material, chunk.vertIdxs.size(), chunk.uvIdxs.size(), chunk.normIdxs.size() });
+                }
+            }
+        }
+
+        void appendIndices(std::vector<uint32_t> &dst, std::vector<uint32_t> &global, const std::vector<uint32_t> &src, size_t begin, size_t end)
+        {
+            dst.insert(dst.end(), src.begin() + begin, src.begin() + end);
+            global.insert(global.end(), src.begin() + begin, src.begin() + end);
+        }
+    }
+
     bool QuickObj::parseOBJ(bool loadTextures)
     {
         log.init("QuickObj", this);
         ccl::FileInfo fi(objFilename);
         std::string objFilePath = fi.getDirName();
-        //Get the file size
-        auto fileSize = ccl::getFileSize(objFilename);
-        if (fileSize > (1024 * 1024 * 1024))
-        {
-            log << "File size of " << fileSize << " for " << objFilename << " exceeds the max of 1gb" << log.endl;
-            return false;
-        }
-        //Make a buffer for the text
-        char *fileContents = new char[fileSize + 1];
-        //Open the file
+        uint64_t fileSize = ccl::getFileSize(objFilename);
         FILE *f = fopen(objFilename.c_str(), "rb");
         if (!f)
         {
-            delete[] fileContents;
             log << "Unable to open " << objFilename << ". error: " << strerror(errno) << log.endl;
             return false;
         }
-        //Read the entire file
-        fread(fileContents, 1, fileSize, f);
-        int pos = 0;
 
         //OBJ indexes start at 1, so we put a placeholder in 0
         QuickVert placeholder3;
@@ -227,152 +500,128 @@ namespace cognitics {
         uvs.push_back(placeholder3);
         norms.push_back(placeholder3);
 
-        while (pos < fileSize)
+        size_t workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+        std::vector<char> block;
+        size_t carry = 0;
+        uint64_t bytesRead = 0;
+        bool reserved = false;
+        while (true)
         {
-            int lineStart = pos;
-
-            //line by line
-            while (fileContents[pos] != 0x0a && fileContents[pos] != 0x0d && fileContents[pos] != 0 && pos < fileSize)
-            {
-                pos++;
-            }
-            //Null terminate the line
-            fileContents[pos] = 0;
-
-            int lineEnd = pos;
-            //Process between lineStart and lineEnd
-            char *tok = strtok(fileContents + lineStart, " ");
-            if (strcmp(tok, "v") == 0)
-            {
-                char *x = strtok(NULL, " ");
-                if (!x)
-                    continue;
-                char *y = strtok(NULL, " ");
-                if (!y)
-                    continue;
-                QuickVert v;
-
-                v.x = atof(x) + srs.offsetPt.X();
-                v.y = atof(y) + srs.offsetPt.Y();
-                char *z = strtok(NULL, " ");
-                if (!z)
-                    v.z = srs.offsetPt.Z();
-                else
-                    v.z = atof(z) + srs.offsetPt.Z();
-
-                minX = std::min<float>(minX, v.x);
-                minY = std::min<float>(minY, v.y);
-                minZ = std::min<float>(minZ, v.z);
-
-                maxX = std::max<float>(maxX, v.x);
-                maxY = std::max<float>(maxY, v.y);
-                maxZ = std::max<float>(maxZ, v.z);
-
-                verts.push_back(v);
-            }
-            else if (strcmp(tok, "vt") == 0)
+            // Keep the partial line left over from the previous block at the front
+            block.resize(carry + OBJ_BLOCK_SIZE);
+            size_t count = fread(block.data() + carry, 1, OBJ_BLOCK_SIZE, f);
+            bytesRead += count;
+            size_t size = carry + count;
+            bool last = (count < OBJ_BLOCK_SIZE);
+            size_t parseSize = size;
+            if (!last)
             {
-                char *x = strtok(NULL, " ");
-                if (!x)
-                    continue;
-                char *y = strtok(NULL, " ");
-                if (!y)
+                while ((parseSize > 0) && !isLineBreak(block[parseSize - 1]))
+                    --parseSize;
+                if (parseSize == 0)
+                {
+                    // A single line longer than the block; read more rather than split it
+                    carry = size;
                     continue;
-                QuickVert vt;
-                vt.x = atof(x);
-                vt.y = atof(y);
-                vt.z = 0;
-                uvs.push_back(vt);
+                }
             }
-            else if (strcmp(tok, "vn") == 0)
+
+            // Split at line boundaries and parse the pieces in parallel
+            std::vector<size_t> bounds(1, 0);
+            size_t step = std::max<size_t>(parseSize / workers, 1);
+            for (size_t i = 1; i < workers; ++i)
             {
-                char *x = strtok(NULL, " ");
-                if (!x)
-                    continue;
-                char *y = strtok(NULL, " ");
-                if (!y)
-                    continue;
-                QuickVert vn;
-                vn.x = atof(x);
-                vn.y = atof(y);
-                char *z = strtok(NULL, " ");
-                if (!z)
-                    vn.z = 0;
-                else
-                    vn.z = atof(z);
-                norms.push_back(vn);
+                size_t split = std::max(bounds.back(), std::min(i * step, parseSize));
+                while ((split < parseSize) && !isLineBreak(block[split - 1]))
+                    ++split;
+                if (split > bounds.back() && split < parseSize)
+                    bounds.push_back(split);
             }
-            else if (strcmp(tok, "f") == 0)
+            bounds.push_back(parseSize);
+            std::vector<ObjChunk> chunks(bounds.size() - 1);
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < chunks.size(); ++i)
+                threads.emplace_back(parseObjChunk, block.data() + bounds[i], block.data() + bounds[i + 1], std::cref(srs.offsetPt), std::ref(chunks[i]));
+            parseObjChunk(block.data() + bounds[0], block.data() + bounds[1], srs.offsetPt, chunks[0]);
+            for (auto &thread : threads)
+                thread.join();
+
+            for (auto &chunk : chunks)
             {
-                tok = strtok(NULL, " ");
-                while (tok)
+                // Relative indices count back from the last element defined before the face
+                uint32_t vertBase = uint32_t(verts.size() - 1);
+                uint32_t uvBase = uint32_t(uvs.size() - 1);
+                uint32_t normBase = uint32_t(norms.size() - 1);
+                for (size_t i : chunk.relativeVertIdxs)
+                    chunk.vertIdxs[i] += vertBase;
+                for (size_t i : chunk.relativeUvIdxs)
+                    chunk.uvIdxs[i] += uvBase;
+                for (size_t i : chunk.relativeNormIdxs)
+                    chunk.normIdxs[i] += normBase;
+
+                verts.insert(verts.end(), chunk.verts.begin(), chunk.verts.end());
+                uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+                norms.insert(norms.end(), chunk.norms.begin(), chunk.norms.end());
+                minX = std::min<float>(minX, chunk.minX);
+                minY = std::min<float>(minY, chunk.minY);
+                minZ = std::min<float>(minZ, chunk.minZ);
+                maxX = std::max<float>(maxX, chunk.maxX);
+                maxY = std::max<float>(maxY, chunk.maxY);
+                maxZ = std::max<float>(maxZ, chunk.maxZ);
+
+                for (auto &library : chunk.materialLibraries)
                 {
-                    char *vp = tok;
-                    char *vtp = NULL;
-                    char *vnp = NULL;
-                    while (*tok != 0)
-                    {
-                        if (*tok == '/')
-                        {
-                            //Terminate the previous pointer
-                            if (vtp == NULL)
-                                vtp = tok + 1;
-                            else if (vnp == NULL)
-                                vnp = tok + 1;
-                            else
-                                break;
-                            *tok = 0;
-                        }
-                        tok++;
-                    }
-                    uint32_t vertId = atoi(vp);
-                    vertIdxs.push_back(vertId);
-                    auto &lastMesh = subMeshes.back();
-                    lastMesh.vertIdxs.push_back(vertId);
+                    materialFilename = ccl::joinPaths(objFilePath, library);
+                    if (loadTextures)
+                        parseMtlFile(materialFilename);
+                }
 
-                    if (vtp)
-                    {
-                        uint32_t uvId = atoi(vtp);
-                        uvIdxs.push_back(uvId);
-                        lastMesh.uvIdxs.push_back(uvId);
-                    }
-                    if (vnp)
+                for (size_t g = 0, gc = chunk.groups.size(); g < gc; ++g)
+                {
+                    const auto &group = chunk.groups[g];
+                    size_t vertEnd = (g + 1 < gc) ? chunk.groups[g + 1].vertIdx : chunk.vertIdxs.size();
+                    size_t uvEnd = (g + 1 < gc) ? chunk.groups[g + 1].uvIdx : chunk.uvIdxs.size();
+                    size_t normEnd = (g + 1 < gc) ? chunk.groups[g + 1].normIdx : chunk.normIdxs.size();
+                    if (group.newSubMesh)
                     {
-                        uint32_t normId = atoi(vnp);
-                        normIdxs.push_back(normId);
-                        lastMesh.normIdxs.push_back(normId);
+                        //Defines a new material from this point on
+                        materialName = group.materialName;
+                        QuickSubMesh submesh;
+                        submesh.materialName = materialName;
+                        subMeshes.push_back(submesh);
                     }
-                    tok = strtok(NULL, " ");
+                    else if ((vertEnd == group.vertIdx) && (uvEnd == group.uvIdx) && (normEnd == group.normIdx))
+                        continue;
+                    else if (subMeshes.empty())
+                        subMeshes.push_back(QuickSubMesh());
+                    auto &lastMesh = subMeshes.back();
+                    appendIndices(lastMesh.vertIdxs, vertIdxs, chunk.vertIdxs, group.vertIdx, vertEnd);
+                    appendIndices(lastMesh.uvIdxs, uvIdxs, chunk.uvIdxs, group.uvIdx, uvEnd);
+                    appendIndices(lastMesh.normIdxs, normIdxs, chunk.normIdxs, group.normIdx, normEnd);
                 }
             }
-            else if (strcmp(tok, "mtllib") == 0)
-            {
-                char *materialFile = strtok(NULL, " ");
-                materialFilename = ccl::joinPaths(objFilePath, materialFile);
-                if (loadTextures)
-                    parseMtlFile(materialFilename);
-            }
-            else if (strcmp(tok, "usemtl") == 0)
-            {
-                //Defines a new material from this point on
-                char *material = strtok(NULL, " ");
-                materialName = std::string(material);
-                QuickSubMesh submesh;
-                submesh.materialName = materialName;
-                subMeshes.push_back(submesh);
-                auto lastMesh = subMeshes.back();
-            }
-            //Skip and remaining cr/lf
-            while ((pos < fileSize) &&
-                (fileContents[pos] == 0x0a || fileContents[pos] == 0x0d || fileContents[pos] == 0))
+
+            // Size the output from the first block so large files don't grow the arrays by doubling.
+            // The estimate is capped in case the size is wrong or the first block isn't typical.
+            if (!reserved && !last && (fileSize > bytesRead))
             {
-                pos++;
+                double scale = std::min<double>((double(fileSize) / double(bytesRead)) * 1.05, OBJ_MAX_RESERVE_SCALE);
+                verts.reserve(size_t(verts.size() * scale));
+                uvs.reserve(size_t(uvs.size() * scale));
+                norms.reserve(size_t(norms.size() * scale));
+                vertIdxs.reserve(size_t(vertIdxs.size() * scale));
+                uvIdxs.reserve(size_t(uvIdxs.size() * scale));
+                normIdxs.reserve(size_t(normIdxs.size() * scale));
+                reserved = true;
             }
 
-        }//end of while parsing lines
+            if (last)
+                break;
+            carry = size - parseSize;
+            memmove(block.data(), block.data() + parseSize, carry);
+        }
         fclose(f);
         _isValid = true;
-        delete[] fileContents;
         //Transform if needed. If there is no WKT, assume it's already in ENU
         if (srs.srsWKT.size() > 0 && srs.srsWKT != "ENU")
         {
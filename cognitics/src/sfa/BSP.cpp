@@ -422,6 +422,33 @@ namespace sfa
         }
     }
 
+    /***************************************************************************************************
+    This method extracts all of the geometries of a PackedRTree that touch the above specified bounding
+    box and places them into the results list. The method expects one argument:
+
+    tree    This is a PackedRTree that was filled with addGeometry() and then generated. Items that were
+            added without a geometry are skipped.
+
+    The geometries are appended in the order they were added to the tree, so callers that let later
+    results override earlier ones (such as overlapping raster sources) do not depend on the tree layout.
+
+    The method does not have a return value.
+    ****************************************************************************************************/
+    void BSPCollectGeometriesVisitor::visiting(PackedRTree *tree)
+    {
+        if (!tree)
+            return;
+        std::vector<size_t> items;
+        tree->search(minX, minY, maxX, maxY, items);
+        std::sort(items.begin(), items.end());
+        for (size_t i = 0, c = items.size(); i < c; ++i)
+        {
+            Geometry *geometry = tree->getGeometry(items[i]);
+            if (geometry)
+                results.push_back(geometry);
+        }
+    }
+
     BSPCollectGeometriesInPolygonVisitor::BSPCollectGeometriesInPolygonVisitor(void) : minX(-DBL_MAX), maxX(DBL_MAX), minY(-DBL_MAX), maxY(DBL_MAX), window(NULL)
     {
     }
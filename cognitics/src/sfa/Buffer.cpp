@@ -29,10 +29,12 @@ DEALINGS IN THE SOFTWARE.
 #include "sfa/PolyhedralSurface.h"
 #include "sfa/GeometryCollection.h"
 #include "sfa/RingMath.h"
+#include "sfa/CoordinateSequence.h"
 #include "sfa/PointMath.h"
 #include "sfa/SegmentIntersector.h"
 #include "sfa/BSP.h"
 #include "sfa/File.h"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <boost/foreach.hpp>
@@ -393,14 +395,11 @@ namespace sfa {
               * Sum over the edges, (x2 - x1)(y2 + y1). If the result is positive the curve is clockwise, 
               * if it's negative the curve is counter-clockwise. (The result is twice the enclosed area, with a +/- convention.)
             **/
-            int numPoints = line->getNumPoints();
+            CoordinateSequence ring(line, false, false);
+            const double* p = ring.data();
             double sum = 0;
-            for (int i = 1; i < numPoints; i++)
-            {
-                Point p1 = line->getPointN(i - 1);
-                Point p2 = line->getPointN(i);
-                sum += ((p2.X() - p1.X())*(p2.Y() + p1.Y()));
-            }
+            for (int i = 1, c = ring.getNumPoints(); i < c; i++, p += 2)
+                sum += ((p[2] - p[0])*(p[3] + p[1]));
             if (sum <= 0)
                 return true;
             return false;
@@ -752,13 +751,10 @@ namespace sfa {
                 Node *n = pair.first;
                 Node *neighbor = pair.second;                
 
-                NodeSegment seg1(n, neighbor);
                 BSPCollectGeometriesVisitor collector;
-                sfa::LineString *env = dynamic_cast<sfa::LineString*>(seg1.getEnvelope());
-                sfa::Point *lsMin = dynamic_cast<sfa::Point *>(env->getPointN(0));
-                sfa::Point *lsMax = dynamic_cast<sfa::Point *>(env->getPointN(1));
-                collector.setBounds(lsMin->X(), lsMin->Y(), lsMax->X(), lsMax->Y());
-                delete env;
+                //    Envelope of the segment from n to neighbor
+                collector.setBounds(std::min<double>(n->pt.X(), neighbor->pt.X()), std::min<double>(n->pt.Y(), neighbor->pt.Y()),
+                    std::max<double>(n->pt.X(), neighbor->pt.X()), std::max<double>(n->pt.Y(), neighbor->pt.Y()));
                 collector.visiting(&bsp);
                 std::list<sfa::Geometry *> results = collector.results;
 
@@ -0,0 +1,251 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#include "sfa/CoordinateSequence.h"
+#include "sfa/LineString.h"
+#include "sfa/Polygon.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sfa
+{
+    namespace
+    {
+        void SwapDoubles(unsigned char* bytes, size_t count)
+        {
+            for (size_t i = 0; i < count; i++, bytes += sizeof(double))
+                std::reverse(bytes, bytes + sizeof(double));
+        }
+
+        bool NeedsSwap(WKBByteOrder byteOrder)
+        {
+            return (byteOrder == wkbXDR) == ccl::machLittleEndian();
+        }
+    }
+
+    CoordinateSequence::~CoordinateSequence(void)
+    {
+    }
+
+    CoordinateSequence::CoordinateSequence(bool withZ, bool withM) : hasZ(withZ), hasM(withM), stride(2 + (withZ ? 1 : 0) + (withM ? 1 : 0))
+    {
+    }
+
+    CoordinateSequence::CoordinateSequence(const LineString* line, bool withZ, bool withM) : hasZ(withZ), hasM(withM), stride(2 + (withZ ? 1 : 0) + (withM ? 1 : 0))
+    {
+        assign(line, withZ, withM);
+    }
+
+    void CoordinateSequence::assign(const LineString* line, bool withZ, bool withM)
+    {
+        hasZ = withZ;
+        hasM = withM;
+        stride = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+        coords.clear();
+        if (!line)
+            return;
+        int numPoints = line->getNumPoints();
+        coords.resize(size_t(numPoints) * stride);
+        double* dst = coords.data();
+        for (int i = 0; i < numPoints; i++)
+        {
+            const Point* point = line->getPointN(i);
+            *dst++ = point->X();
+            *dst++ = point->Y();
+            if (withZ)
+                *dst++ = point->Z();
+            if (withM)
+                *dst++ = point->M();
+        }
+    }
+
+    void CoordinateSequence::clear(void)
+    {
+        coords.clear();
+    }
+
+    void CoordinateSequence::reserve(int numPoints)
+    {
+        coords.reserve(size_t(numPoints) * stride);
+    }
+
+    void CoordinateSequence::addPoint(double x, double y, double z, double m)
+    {
+        coords.push_back(x);
+        coords.push_back(y);
+        if (hasZ)
+            coords.push_back(z);
+        if (hasM)
+            coords.push_back(m);
+    }
+
+    void CoordinateSequence::addPoint(const Point& point)
+    {
+        addPoint(point.X(), point.Y(), point.Z(), point.M());
+    }
+
+    Point CoordinateSequence::getPointN(int n) const
+    {
+        Point point(X(n), Y(n));
+        if (hasZ)
+            point.setZ(Z(n));
+        if (hasM)
+            point.setM(M(n));
+        return point;
+    }
+
+    bool CoordinateSequence::isClosed(void) const
+    {
+        if (coords.empty())
+            return false;
+        int last = getNumPoints() - 1;
+        double dx = X(0) - X(last);
+        double dy = Y(0) - Y(last);
+        return dx*dx + dy*dy < SFA_EPSILON*SFA_EPSILON;
+    }
+
+    bool CoordinateSequence::getEnvelope(double& minX, double& minY, double& maxX, double& maxY) const
+    {
+        if (coords.empty())
+            return false;
+        minX = maxX = coords[0];
+        minY = maxY = coords[1];
+        for (size_t i = stride, c = coords.size(); i < c; i += stride)
+        {
+            minX = std::min<double>(minX, coords[i]);
+            maxX = std::max<double>(maxX, coords[i]);
+            minY = std::min<double>(minY, coords[i + 1]);
+            maxY = std::max<double>(maxY, coords[i + 1]);
+        }
+        return true;
+    }
+
+    void CoordinateSequence::appendTo(LineString* line) const
+    {
+        for (int i = 0, c = getNumPoints(); i < c; i++)
+            line->addPoint(new Point(getPointN(i)));
+    }
+
+    void CoordinateSequence::toBinary(std::ostream &os, WKBByteOrder byteOrder) const
+    {
+        ccl::uint32_t count = ccl::uint32_t(getNumPoints());
+        if (byteOrder == wkbXDR)
+        {
+            ccl::BigEndian<ccl::uint32_t> numPoints(count);
+            os << numPoints;
+        }
+        else
+        {
+            ccl::LittleEndian<ccl::uint32_t> numPoints(count);
+            os << numPoints;
+        }
+        if (coords.empty())
+            return;
+        if (!NeedsSwap(byteOrder))
+        {
+            os.write((const char*)coords.data(), std::streamsize(coords.size() * sizeof(double)));
+            return;
+        }
+        std::vector<double> swapped(coords);
+        SwapDoubles((unsigned char*)swapped.data(), swapped.size());
+        os.write((const char*)swapped.data(), std::streamsize(swapped.size() * sizeof(double)));
+    }
+
+    void CoordinateSequence::fromBinary(std::istream &is, WKBByteOrder byteOrder, bool withZ, bool withM)
+    {
+        hasZ = withZ;
+        hasM = withM;
+        stride = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+        coords.clear();
+
+        ccl::uint32_t numPoints;
+        if (byteOrder == wkbXDR)
+        {
+            ccl::BigEndian<ccl::uint32_t> tempPoints;
+            is >> tempPoints;
+            numPoints = tempPoints;
+        }
+        else
+        {
+            ccl::LittleEndian<ccl::uint32_t> tempPoints;
+            is >> tempPoints;
+            numPoints = tempPoints;
+        }
+
+        // Read in blocks so a corrupt count cannot allocate more than the stream holds.
+        const size_t blockPoints = 65536;
+        for (size_t done = 0; done < numPoints && is.good(); )
+        {
+            size_t count = std::min<size_t>(blockPoints, numPoints - done);
+            size_t offset = coords.size();
+            coords.resize(offset + count * stride);
+            is.read((char*)(coords.data() + offset), std::streamsize(count * stride * sizeof(double)));
+            size_t values = size_t(is.gcount()) / sizeof(double);
+            size_t points = values / stride;
+            coords.resize(offset + points * stride);
+            done += points;
+            if (points < count)
+                break;
+        }
+        if (NeedsSwap(byteOrder))
+            SwapDoubles((unsigned char*)coords.data(), coords.size());
+    }
+
+    size_t CoordinateSequence::fromBinary(const unsigned char* wkb, size_t size, WKBByteOrder byteOrder, bool withZ, bool withM)
+    {
+        hasZ = withZ;
+        hasM = withM;
+        stride = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+        coords.clear();
+
+        if (!wkb || size < 4)
+            return 0;
+        unsigned char countBytes[4];
+        memcpy(countBytes, wkb, 4);
+        if (NeedsSwap(byteOrder))
+            std::reverse(countBytes, countBytes + 4);
+        ccl::uint32_t numPoints;
+        memcpy(&numPoints, countBytes, 4);
+
+        size_t bytes = size_t(numPoints) * stride * sizeof(double);
+        if (bytes > size - 4)
+            return 0;
+        coords.resize(size_t(numPoints) * stride);
+        if (bytes)
+            memcpy(coords.data(), wkb + 4, bytes);
+        if (NeedsSwap(byteOrder))
+            SwapDoubles((unsigned char*)coords.data(), coords.size());
+        return 4 + bytes;
+    }
+
+    void GetPolygonCoordinates(const Polygon* polygon, CoordinateSequenceList& rings, bool withZ)
+    {
+        rings.clear();
+        if (!polygon || polygon->isEmpty())
+            return;
+        rings.resize(size_t(polygon->getNumInteriorRing()) + 1);
+        rings[0].assign(polygon->getExteriorRing(), withZ, false);
+        for (int i = 0; i < polygon->getNumInteriorRing(); i++)
+            rings[i + 1].assign(polygon->getInteriorRingN(i), withZ, false);
+    }
+
+}
@@ -22,6 +22,11 @@ DEALINGS IN THE SOFTWARE.
 #include "sfa/EdgeIntersector.h"
 #include "sfa/PointMath.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
 namespace sfa {
 
     bool EdgeIntersector::isTrivial(EdgeNode* a, int ai, EdgeNode* b, int bi)
@@ -196,24 +201,172 @@ namespace sfa {
         }
     }
      
+    namespace
+    {
+        // Bounds of one segment; lo/hi are along the sweep axis, the others across it.
+        struct SweepSegment
+        {
+            double lo;
+            double hi;
+            double across_min;
+            double across_max;
+            int edge;
+            int index;
+            bool fromA;
+            int strip0;
+            int strip1;
+        };
+
+        struct SegmentPair
+        {
+            int ea;
+            int eb;
+            int i;
+            int j;
+            bool operator<(const SegmentPair& rhs) const
+            {
+                if (ea != rhs.ea) return ea < rhs.ea;
+                if (eb != rhs.eb) return eb < rhs.eb;
+                if (i != rhs.i) return i < rhs.i;
+                return j < rhs.j;
+            }
+        };
+
+        void AddSegments(const EdgeNodeList& edges, bool fromA, bool sweepY, std::vector<SweepSegment>& segments)
+        {
+            for (int e = 0; e < int(edges.size()); e++)
+            {
+                for (int i = 0; i < edges[e]->getNumPoints() - 1; i++)
+                {
+                    const Point* p1 = edges[e]->getPointN(i)->getPoint();
+                    const Point* p2 = edges[e]->getPointN(i+1)->getPoint();
+                    double x1 = sweepY ? p1->Y() : p1->X();
+                    double x2 = sweepY ? p2->Y() : p2->X();
+                    double y1 = sweepY ? p1->X() : p1->Y();
+                    double y2 = sweepY ? p2->X() : p2->Y();
+                    SweepSegment segment = { std::min<double>(x1,x2), std::max<double>(x1,x2), std::min<double>(y1,y2), std::max<double>(y1,y2), e, i, fromA, 0, 0 };
+                    segments.push_back(segment);
+                }
+            }
+        }
+
+        void ExtendRange(const EdgeNodeList& edges, double range[4])
+        {
+            for (int e = 0; e < int(edges.size()); e++)
+            {
+                for (int i = 0; i < edges[e]->getNumPoints(); i++)
+                {
+                    const Point* p = edges[e]->getPointN(i)->getPoint();
+                    range[0] = std::min<double>(range[0], p->X());
+                    range[1] = std::max<double>(range[1], p->X());
+                    range[2] = std::min<double>(range[2], p->Y());
+                    range[3] = std::max<double>(range[3], p->Y());
+                }
+            }
+        }
+    }
+
 /*
-    Brute force for now, will make SL later
+    Sweep over segment envelopes along the longer axis of the input. The active segments are kept in strips
+    across the sweep, sized to a few segments, so each new segment only looks at the active segments of the
+    other list near it; a pair spanning several strips is reported from the first strip they share. Only
+    pairs whose envelopes are within twice the tolerance of isDisjoint are kept, and they are then run in the
+    same order as the brute force loops so that the label updates for collinear edges come out the same.
 */
     EdgeIntersector::EdgeIntersector(EdgeNodeList A, EdgeNodeList B, bool selfTest)
     {
-        for (int ea = 0; ea < int(A.size()); ea++)
+        double range[4] = { DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX };
+        ExtendRange(A, range);
+        ExtendRange(B, range);
+        bool sweepY = (range[3] - range[2]) > (range[1] - range[0]);
+        double acrossMin = sweepY ? range[0] : range[2];
+        double acrossRange = sweepY ? (range[1] - range[0]) : (range[3] - range[2]);
+
+        // The usual self test passes the same list twice; sweep it once and emit each pair the ways the loops would.
+        bool sameLists = selfTest && (A == B);
+
+        std::vector<SweepSegment> segments;
+        AddSegments(A, true, sweepY, segments);
+        if (!sameLists)
+            AddSegments(B, false, sweepY, segments);
+        if (segments.empty())
+            return;
+        std::sort(segments.begin(), segments.end(), [](const SweepSegment& a, const SweepSegment& b) { return a.lo < b.lo; });
+
+        const double tolerance = 2 * SFA_EPSILON;
+        double meanExtent = 0;
+        for (size_t n = 0; n < segments.size(); n++)
+            meanExtent += segments[n].across_max - segments[n].across_min + 2 * tolerance;
+        meanExtent /= segments.size();
+        int strips = 1;
+        if (acrossRange > 0 && meanExtent > 0)
         {
-            for (int eb = (selfTest ? ea : 0); eb < int(B.size()); eb++)
+            double maxStrips = std::min<double>(4096, std::sqrt(double(segments.size())));
+            strips = int(std::max<double>(1, std::min<double>(maxStrips, acrossRange / (2 * meanExtent))));
+        }
+        double stripScale = (acrossRange > 0) ? (strips / acrossRange) : 0;
+        for (size_t n = 0; n < segments.size(); n++)
+        {
+            SweepSegment& segment = segments[n];
+            segment.strip0 = std::max<int>(0, std::min<int>(strips - 1, int((segment.across_min - tolerance - acrossMin) * stripScale)));
+            segment.strip1 = std::max<int>(0, std::min<int>(strips - 1, int((segment.across_max + tolerance - acrossMin) * stripScale)));
+        }
+
+        std::vector<SegmentPair> pairs;
+        std::vector<std::vector<const SweepSegment*> > active[2];
+        active[0].resize(strips);
+        active[1].resize(strips);
+        for (size_t n = 0; n < segments.size(); n++)
+        {
+            const SweepSegment& segment = segments[n];
+            int otherList = (segment.fromA && !sameLists) ? 1 : 0;
+            int ownList = (segment.fromA || sameLists) ? 0 : 1;
+            for (int strip = segment.strip0; strip <= segment.strip1; strip++)
             {
-                for (int i = 0; i < (A[ea])->getNumPoints() - 1; i++)
+                std::vector<const SweepSegment*>& others = active[otherList][strip];
+                size_t kept = 0;
+                for (size_t k = 0; k < others.size(); k++)
                 {
-                    for (int j = 0; j < (B[eb])->getNumPoints() - 1; j++)
+                    const SweepSegment* other = others[k];
+                    if (other->hi + tolerance < segment.lo)
+                        continue;
+                    others[kept++] = other;
+                    if (std::max<int>(other->strip0, segment.strip0) != strip) continue;
+                    if (other->across_min > segment.across_max + tolerance) continue;
+                    if (other->across_max < segment.across_min - tolerance) continue;
+                    if (sameLists)
                     {
-                        addIntersection(A[ea],i,B[eb],j);
+                        const SweepSegment* a = (other->edge < segment.edge) ? other : &segment;
+                        const SweepSegment* b = (other->edge < segment.edge) ? &segment : other;
+                        SegmentPair pair = { a->edge, b->edge, a->index, b->index };
+                        pairs.push_back(pair);
+                        if (a->edge == b->edge)
+                        {
+                            SegmentPair reverse = { a->edge, b->edge, b->index, a->index };
+                            pairs.push_back(reverse);
+                        }
+                        continue;
                     }
+                    const SweepSegment* a = segment.fromA ? &segment : other;
+                    const SweepSegment* b = segment.fromA ? other : &segment;
+                    if (selfTest && b->edge < a->edge)
+                        continue;
+                    SegmentPair pair = { a->edge, b->edge, a->index, b->index };
+                    pairs.push_back(pair);
                 }
+                others.resize(kept);
+                active[ownList][strip].push_back(&segment);
+            }
+            if (sameLists)
+            {
+                SegmentPair pair = { segment.edge, segment.edge, segment.index, segment.index };
+                pairs.push_back(pair);
             }
         }
+
+        std::sort(pairs.begin(), pairs.end());
+        for (size_t n = 0; n < pairs.size(); n++)
+            addIntersection(A[pairs[n].ea], pairs[n].i, B[pairs[n].eb], pairs[n].j);
     }
 
-}
\ No newline at end of file
+}
@@ -40,7 +40,19 @@ DEALINGS IN THE SOFTWARE.
 
 namespace sfa
 {
-
+    namespace
+    {
+        //    Reads the WKB in place instead of copying it into a stringstream.
+        class BinaryBuffer : public std::streambuf
+        {
+        public:
+            BinaryBuffer(const ccl::binary &wkb)
+            {
+                char *data = const_cast<char *>(reinterpret_cast<const char *>(wkb.data()));
+                setg(data, data, data + wkb.size());
+            }
+        };
+    }
 
     Geometry* getGeometryFromText(const std::string wkt)
     {
@@ -83,11 +95,10 @@ namespace sfa
     }
 
 
-    Geometry* getGeometryFromBinary(const ccl::binary wkb)
+    Geometry* getGeometryFromBinary(const ccl::binary &wkb)
     {
-        std::string wkb_string(wkb.begin(),wkb.end());
-        std::stringstream is(wkb_string, std::stringstream::binary | std::stringstream::in);
-        is.seekg(0);
+        BinaryBuffer buffer(wkb);
+        std::istream is(&buffer);
 
         ccl::uint32_t geometryType = 0;
         WKBByteOrder byteOrder = (WKBByteOrder)is.get();
@@ -24,6 +24,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include <float.h>
 #include "sfa/LineString.h"
+#include "sfa/CoordinateSequence.h"
 
 #include "sfa/ConvexHull.h"
 #include "sfa/ConvexHull3D.h"
@@ -183,41 +184,22 @@ namespace sfa
 
     void LineString::toBinary(std::ostream &os, WKBByteOrder byteOrder, bool withZ, bool withM) const
     {
-        if(byteOrder == wkbXDR)
-        {
-            ccl::BigEndian<ccl::uint32_t> numPoints(ccl::uint32_t(points.size()));
-            os << numPoints;
-        }
-        else
-        {
-            ccl::LittleEndian<ccl::uint32_t> numPoints(ccl::uint32_t(points.size()));
-            os << numPoints;
-        }
-        for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
-        {
-            (*it)->toBinary(os, byteOrder, withZ, withM);
-        }
+        CoordinateSequence(this, withZ, withM).toBinary(os, byteOrder);
     }
 
     void LineString::fromBinary(std::istream &is, WKBByteOrder byteOrder, bool withZ, bool withM)
     {
-        ccl::uint32_t numPoints;
-        if(byteOrder == wkbXDR)
-        {
-            ccl::BigEndian<ccl::uint32_t> tempPoints;
-            is >> tempPoints;
-            numPoints = tempPoints;
-        }
-        else
-        {
-            ccl::LittleEndian<ccl::uint32_t> tempPoints;
-            is >> tempPoints;
-            numPoints = tempPoints;
-        }
-        for(ccl::uint32_t i = 0; i < numPoints; ++i)
-        {
-            Point* point = new Point();
-            point->fromBinary(is, byteOrder, withZ, withM);
+        CoordinateSequence coordinates;
+        coordinates.fromBinary(is, byteOrder, withZ, withM);
+        int numPoints = coordinates.getNumPoints();
+        points.reserve(points.size() + numPoints);
+        for(int i = 0; i < numPoints; ++i)
+        {
+            Point* point = new Point(coordinates.X(i), coordinates.Y(i));
+            if(withZ)
+                point->setZ(coordinates.Z(i));
+            if(withM)
+                point->setM(coordinates.M(i));
             addPoint(point);
         }
     }
@@ -314,14 +314,22 @@ namespace sfa {
     {
         PolygonList result;
         LineStringList interior;
+        //    Packed rings and exterior envelope of each result polygon, kept in step with the rings added to it
+        std::vector<CoordinateSequenceList> packed;
+        std::vector<std::vector<double> > envelopes;
         //    Sort rings
         for (LineStringList::iterator it = rings.begin(); it != rings.end(); ++it)
         {
+            CoordinateSequence ring(*it, false, false);
             if (ComputeOrientation(*it) == ORIENTATION_C_CW)
             {
                 Polygon* next = new Polygon;
                 next->addRing(new LineString(*it));
                 result.push_back(next);
+                std::vector<double> envelope(4);
+                ring.getEnvelope(envelope[0], envelope[1], envelope[2], envelope[3]);
+                envelopes.push_back(envelope);
+                packed.push_back(CoordinateSequenceList(1, ring));
             }
             else interior.push_back(*it);
         }
@@ -329,12 +337,21 @@ namespace sfa {
         //    Add interior rings to their parent polygons.
         for (LineStringList::iterator line = interior.begin(); line != interior.end(); ++line)
         {
-        //    Find the polygon to insert this ring into with a point in polygon test
-            for (PolygonList::iterator polygon = result.begin(); polygon != result.end(); ++polygon)
+        //    Find the polygon to insert this ring into with a point in polygon test; this is Point::intersects(), which
+        //    is an envelope check followed by PointInPolygon()
+            const Point* start = (*line)->getStartPoint();
+            if (!start)
+                continue;
+            CoordinateSequence ring(*line, false, false);
+            for (size_t i = 0; i < result.size(); ++i)
             {
-                if ((*line)->getStartPoint()->intersects(*polygon))
+                const std::vector<double>& envelope = envelopes[i];
+                if (start->X() > envelope[2] + SFA_EPSILON || start->Y() > envelope[3] + SFA_EPSILON) continue;
+                if (start->X() < envelope[0] - SFA_EPSILON || start->Y() < envelope[1] - SFA_EPSILON) continue;
+                if (PointInPolygon(*start, packed[i]))
                 {
-                    (*polygon)->addRing(new LineString(*line));
+                    result[i]->addRing(new LineString(*line));
+                    packed[i].push_back(ring);
                 }
             }
         }
@@ -0,0 +1,312 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#include "sfa/PackedRTree.h"
+#include "sfa/LineString.h"
+#include <cstdint>
+#include <cstring>
+#include <float.h>
+#include <fstream>
+#include <stdexcept>
+
+namespace sfa
+{
+    namespace
+    {
+        const char PackedRTreeMagic[8] = { 'S', 'F', 'A', 'R', 'T', 'R', 'E', 'E' };
+        const uint32_t PackedRTreeVersion = 1;
+
+        // Position of (x, y) along a Hilbert curve filling a 65536 x 65536 grid.
+        uint32_t HilbertIndex(uint32_t x, uint32_t y)
+        {
+            const uint32_t n = 1 << 16;
+            uint32_t d = 0;
+            for (uint32_t s = n / 2; s > 0; s /= 2)
+            {
+                uint32_t rx = (x & s) ? 1 : 0;
+                uint32_t ry = (y & s) ? 1 : 0;
+                d += s * s * ((3 * rx) ^ ry);
+                if (ry == 0)
+                {
+                    if (rx == 1)
+                    {
+                        x = n - 1 - x;
+                        y = n - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return d;
+        }
+
+        // Node count of each level for numItems leaves, leaves first and ending with the root.
+        void ComputeLevelEnds(size_t numItems, size_t nodeSize, std::vector<size_t> &levelEnds)
+        {
+            levelEnds.clear();
+            size_t count = numItems;
+            size_t numNodes = numItems;
+            levelEnds.push_back(numNodes);
+            do
+            {
+                count = (count + nodeSize - 1) / nodeSize;
+                numNodes += count;
+                levelEnds.push_back(numNodes);
+            } while (count != 1);
+        }
+
+        struct HilbertItem
+        {
+            uint32_t value;
+            size_t item;
+            bool operator<(const HilbertItem &other) const
+            {
+                return (value < other.value) || ((value == other.value) && (item < other.item));
+            }
+        };
+    }
+
+    PackedRTree::~PackedRTree(void)
+    {
+    }
+
+    PackedRTree::PackedRTree(size_t nodeSize) : nodeSize(std::max<size_t>(nodeSize, 2)), numItems(0), generated(false)
+    {
+    }
+
+    void PackedRTree::clear(void)
+    {
+        numItems = 0;
+        generated = false;
+        boxes.clear();
+        indices.clear();
+        levelEnds.clear();
+        geometries.clear();
+    }
+
+    void PackedRTree::reserve(size_t numItems)
+    {
+        boxes.reserve(numItems * 4);
+        geometries.reserve(numItems);
+    }
+
+    size_t PackedRTree::add(double minX, double minY, double maxX, double maxY)
+    {
+        if (generated)
+            throw std::runtime_error("PackedRTree::add() called after generate()");
+        boxes.push_back(minX);
+        boxes.push_back(minY);
+        boxes.push_back(maxX);
+        boxes.push_back(maxY);
+        geometries.push_back(NULL);
+        return numItems++;
+    }
+
+    bool PackedRTree::addGeometry(Geometry *geometry)
+    {
+        if (!geometry || geometry->isEmpty())
+            return false;
+        LineString *envelope = dynamic_cast<LineString *>(geometry->getEnvelope());
+        bool valid = envelope && (envelope->getNumPoints() == 2);
+        if (valid)
+        {
+            Point *minPoint = envelope->getPointN(0);
+            Point *maxPoint = envelope->getPointN(1);
+            add(minPoint->X(), minPoint->Y(), maxPoint->X(), maxPoint->Y());
+            geometries.back() = geometry;
+        }
+        delete envelope;
+        return valid;
+    }
+
+    void PackedRTree::generate(void)
+    {
+        if (generated)
+            return;
+        double minX, minY, maxX, maxY;
+        bool empty = !getEnvelope(minX, minY, maxX, maxY);
+        generated = true;
+        if (empty)
+            return;
+
+        double scaleX = (maxX > minX) ? 65535.0 / (maxX - minX) : 0.0;
+        double scaleY = (maxY > minY) ? 65535.0 / (maxY - minY) : 0.0;
+
+        std::vector<HilbertItem> order(numItems);
+        for (size_t i = 0; i < numItems; ++i)
+        {
+            const double *box = &boxes[i * 4];
+            double cx = (box[0] + box[2]) / 2;
+            double cy = (box[1] + box[3]) / 2;
+            order[i].value = HilbertIndex(uint32_t((cx - minX) * scaleX), uint32_t((cy - minY) * scaleY));
+            order[i].item = i;
+        }
+        std::sort(order.begin(), order.end());
+
+        ComputeLevelEnds(numItems, nodeSize, levelEnds);
+        size_t numNodes = levelEnds.back();
+        std::vector<double> packed(numNodes * 4);
+        indices.assign(numNodes, 0);
+        for (size_t i = 0; i < numItems; ++i)
+        {
+            memcpy(&packed[i * 4], &boxes[order[i].item * 4], 4 * sizeof(double));
+            indices[i] = order[i].item;
+        }
+        boxes.swap(packed);
+
+        // each parent covers the next nodeSize nodes of the level below it
+        size_t parent = numItems;
+        for (size_t level = 0; level + 1 < levelEnds.size(); ++level)
+        {
+            size_t begin = level ? levelEnds[level - 1] : 0;
+            size_t end = levelEnds[level];
+            for (size_t first = begin; first < end; first += nodeSize, ++parent)
+            {
+                double *box = &boxes[parent * 4];
+                box[0] = DBL_MAX;
+                box[1] = DBL_MAX;
+                box[2] = -DBL_MAX;
+                box[3] = -DBL_MAX;
+                for (size_t child = first, last = std::min<size_t>(first + nodeSize, end); child < last; ++child)
+                {
+                    const double *childBox = &boxes[child * 4];
+                    box[0] = std::min<double>(box[0], childBox[0]);
+                    box[1] = std::min<double>(box[1], childBox[1]);
+                    box[2] = std::max<double>(box[2], childBox[2]);
+                    box[3] = std::max<double>(box[3], childBox[3]);
+                }
+                indices[parent] = first;
+            }
+        }
+    }
+
+    Geometry *PackedRTree::getGeometry(size_t item) const
+    {
+        return (item < geometries.size()) ? geometries[item] : NULL;
+    }
+
+    bool PackedRTree::getEnvelope(double &minX, double &minY, double &maxX, double &maxY) const
+    {
+        if (!numItems)
+            return false;
+        if (generated)
+        {
+            const double *box = &boxes[(levelEnds.back() - 1) * 4];
+            minX = box[0];
+            minY = box[1];
+            maxX = box[2];
+            maxY = box[3];
+            return true;
+        }
+        minX = DBL_MAX;
+        minY = DBL_MAX;
+        maxX = -DBL_MAX;
+        maxY = -DBL_MAX;
+        for (size_t i = 0; i < numItems; ++i)
+        {
+            const double *box = &boxes[i * 4];
+            minX = std::min<double>(minX, box[0]);
+            minY = std::min<double>(minY, box[1]);
+            maxX = std::max<double>(maxX, box[2]);
+            maxY = std::max<double>(maxY, box[3]);
+        }
+        return true;
+    }
+
+    void PackedRTree::search(double minX, double minY, double maxX, double maxY, std::vector<size_t> &results) const
+    {
+        search(minX, minY, maxX, maxY, [&results](size_t item) { results.push_back(item); return true; });
+    }
+
+    bool PackedRTree::write(std::ostream &os) const
+    {
+        if (!generated)
+            return false;
+        uint32_t header[2] = { PackedRTreeVersion, uint32_t(nodeSize) };
+        uint64_t count = numItems;
+        os.write(PackedRTreeMagic, sizeof(PackedRTreeMagic));
+        os.write((const char *)header, sizeof(header));
+        os.write((const char *)&count, sizeof(count));
+        if (numItems)
+        {
+            std::vector<uint64_t> links(indices.begin(), indices.end());
+            os.write((const char *)boxes.data(), boxes.size() * sizeof(double));
+            os.write((const char *)links.data(), links.size() * sizeof(uint64_t));
+        }
+        return bool(os);
+    }
+
+    bool PackedRTree::write(const std::string &filename) const
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        return outfile.good() && write(outfile);
+    }
+
+    bool PackedRTree::read(std::istream &is)
+    {
+        clear();
+        char magic[sizeof(PackedRTreeMagic)];
+        uint32_t header[2];
+        uint64_t count = 0;
+        is.read(magic, sizeof(magic));
+        is.read((char *)header, sizeof(header));
+        is.read((char *)&count, sizeof(count));
+        if (!is || memcmp(magic, PackedRTreeMagic, sizeof(magic)) || (header[0] != PackedRTreeVersion) || (header[1] < 2))
+            return false;
+        nodeSize = header[1];
+        numItems = size_t(count);
+        generated = true;
+        if (!numItems)
+            return true;
+
+        ComputeLevelEnds(numItems, nodeSize, levelEnds);
+        size_t numNodes = levelEnds.back();
+        std::vector<uint64_t> links(numNodes);
+        boxes.resize(numNodes * 4);
+        is.read((char *)boxes.data(), boxes.size() * sizeof(double));
+        is.read((char *)links.data(), links.size() * sizeof(uint64_t));
+        bool valid = bool(is);
+        indices.assign(links.begin(), links.end());
+
+        // leaves must name items and branches must start inside the level below them
+        for (size_t i = 0; valid && (i < numItems); ++i)
+            valid = indices[i] < numItems;
+        for (size_t level = 1; valid && (level < levelEnds.size()); ++level)
+        {
+            size_t begin = (level > 1) ? levelEnds[level - 2] : 0;
+            for (size_t node = levelEnds[level - 1]; valid && (node < levelEnds[level]); ++node)
+                valid = (indices[node] >= begin) && (indices[node] < levelEnds[level - 1]);
+        }
+        if (!valid)
+        {
+            clear();
+            return false;
+        }
+        geometries.assign(numItems, NULL);
+        return true;
+    }
+
+    bool PackedRTree::read(const std::string &filename)
+    {
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        return infile.good() && read(infile);
+    }
+
+}
@@ -29,13 +29,44 @@ DEALINGS IN THE SOFTWARE.
 #include "sfa/PointMath.h"
 #include "sfa/RingMath.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace sfa {
 
     bool PointLocator::PointOnLine(const Point* p, const LineString* line)
     {
-        for (int i = 0; i < line->getNumPoints() - 1; i++)
-            if (Collinear(line->getPointN(i),line->getPointN(i+1),p))
-                if (Between(line->getPointN(i),line->getPointN(i+1),p)) return true;
+        return PointOnLine(p, CoordinateSequence(line, true, false));
+    }
+
+    bool PointLocator::PointOnLine(const Point* p, const CoordinateSequence& line)
+    {
+        const double px = p->X();
+        const double py = p->Y();
+        const double* a = line.data();
+        const int stride = line.getStride();
+        const double e = SFA_EPSILON;
+        for (int i = 0, c = line.getNumPoints() - 1; i < c; i++, a += stride)
+        {
+            const double* b = a + stride;
+
+        //    Collinear(), as PointLineIntersector::apply() returning neither LEFT nor RIGHT
+            double nx = b[0] - a[0];
+            double ny = b[1] - a[1];
+            double nz = (stride > 2) ? b[2] - a[2] : 0;
+            double rx = px - a[0];
+            double ry = py - a[1];
+            double nlength = sqrt(nx*nx + ny*ny + nz*nz);
+            double d = (rx*ny - ry*nx) / nlength;
+            if (d < -e || d > e) continue;
+
+        //    Between()
+            if (px > std::max<double>(a[0], b[0]) + e) continue;
+            if (px < std::min<double>(a[0], b[0]) - e) continue;
+            if (py > std::max<double>(a[1], b[1]) + e) continue;
+            if (py < std::min<double>(a[1], b[1]) - e) continue;
+            return true;
+        }
 
         return false;
     }
@@ -65,13 +96,14 @@ namespace sfa {
 
     Location PointLocator::Point_Polygon(const Point* p, const Geometry* geom)
     {
-        const Polygon* poly = dynamic_cast<const Polygon*>(geom);
-        if (PointOnLine(p,poly->getExteriorRing())) return BOUNDARY;
-        //    Repeat for holes
-        for (int i = 0; i < poly->getNumInteriorRing(); i++)
-            if (PointOnLine(p,poly->getInteriorRingN(i))) return BOUNDARY;
-
-        return PointInPolygon(p,poly) ? INTERIOR : EXTERIOR;
+        const Polygon* poly = static_cast<const Polygon*>(geom);
+        //    Pack the rings once for the boundary and interior tests
+        CoordinateSequenceList rings;
+        GetPolygonCoordinates(poly, rings, true);
+        for (size_t i = 0; i < rings.size(); i++)
+            if (PointOnLine(p,rings[i])) return BOUNDARY;
+
+        return PointInPolygon(*p,rings) ? INTERIOR : EXTERIOR;
     }
 
     Location PointLocator::Point_Geometry(const Point* p, const Geometry* geom)
@@ -0,0 +1,315 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#include "sfa/PreparedPolygon.h"
+#include "sfa/CoordinateSequence.h"
+#include "sfa/RingMath.h"
+#include <algorithm>
+#include <float.h>
+
+namespace sfa
+{
+    namespace
+    {
+        // Twice the signed area of a, b, c; positive if c is left of a->b.
+        inline double Orient(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        }
+
+        // True if (px, py) is within e of the segment a->b.
+        inline bool NearSegment(double px, double py, double ax, double ay, double bx, double by, double e)
+        {
+            if ((px < std::min<double>(ax, bx) - e) || (px > std::max<double>(ax, bx) + e))
+                return false;
+            if ((py < std::min<double>(ay, by) - e) || (py > std::max<double>(ay, by) + e))
+                return false;
+            double dx = bx - ax;
+            double dy = by - ay;
+            double length2 = dx * dx + dy * dy;
+            double t = (length2 > 0) ? ((px - ax) * dx + (py - ay) * dy) / length2 : 0;
+            t = std::max<double>(0, std::min<double>(1, t));
+            double ex = ax + t * dx - px;
+            double ey = ay + t * dy - py;
+            return (ex * ex + ey * ey) <= e * e;
+        }
+
+        // How segment a->b meets segment c->d, with the same meaning as PreparedPolygon::SegmentRelation.
+        inline int RelateSegments(const double* ab, const double* cd, double e)
+        {
+            if (NearSegment(ab[0], ab[1], cd[0], cd[1], cd[2], cd[3], e) || NearSegment(ab[2], ab[3], cd[0], cd[1], cd[2], cd[3], e)
+                || NearSegment(cd[0], cd[1], ab[0], ab[1], ab[2], ab[3], e) || NearSegment(cd[2], cd[3], ab[0], ab[1], ab[2], ab[3], e))
+                return PreparedPolygon::SEGMENT_TOUCHES;
+            double c = Orient(ab[0], ab[1], ab[2], ab[3], cd[0], cd[1]);
+            double d = Orient(ab[0], ab[1], ab[2], ab[3], cd[2], cd[3]);
+            if ((c > 0) == (d > 0))
+                return PreparedPolygon::SEGMENT_DISJOINT;
+            double a = Orient(cd[0], cd[1], cd[2], cd[3], ab[0], ab[1]);
+            double b = Orient(cd[0], cd[1], cd[2], cd[3], ab[2], ab[3]);
+            if ((a > 0) == (b > 0))
+                return PreparedPolygon::SEGMENT_DISJOINT;
+            return PreparedPolygon::SEGMENT_CROSSES;
+        }
+
+        // Location of (x, y) in a closed ring by walking every edge; for the small side of contains().
+        Location LocateInRing(double x, double y, const CoordinateSequence& ring, double e)
+        {
+            bool inside = false;
+            const double* a = ring.data();
+            const int stride = ring.getStride();
+            for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, a += stride)
+            {
+                const double* b = a + stride;
+                if (NearSegment(x, y, a[0], a[1], b[0], b[1], e))
+                    return BOUNDARY;
+                if (((a[1] > y) != (b[1] > y)) && (x < a[0] + (y - a[1]) * (b[0] - a[0]) / (b[1] - a[1])))
+                    inside = !inside;
+            }
+            return inside ? INTERIOR : EXTERIOR;
+        }
+    }
+
+    PreparedPolygon::~PreparedPolygon(void)
+    {
+    }
+
+    PreparedPolygon::PreparedPolygon(const Polygon* polygon) : polygon(NULL), minX(DBL_MAX), minY(DBL_MAX), maxX(-DBL_MAX), maxY(-DBL_MAX), bandHeight(0)
+    {
+        assign(polygon);
+    }
+
+    void PreparedPolygon::assign(const Polygon* polygon)
+    {
+        this->polygon = polygon;
+        edges.clear();
+        bandStart.clear();
+        bandEdges.clear();
+        minX = minY = DBL_MAX;
+        maxX = maxY = -DBL_MAX;
+        bandHeight = 0;
+        if (!polygon || polygon->isEmpty())
+            return;
+
+        CoordinateSequenceList rings;
+        GetPolygonCoordinates(polygon, rings);
+        for (size_t r = 0; r < rings.size(); r++)
+        {
+            const CoordinateSequence& ring = rings[r];
+            const double* a = ring.data();
+            for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, a += 2)
+            {
+                edges.insert(edges.end(), a, a + 4);
+                minX = std::min<double>(minX, std::min<double>(a[0], a[2]));
+                maxX = std::max<double>(maxX, std::max<double>(a[0], a[2]));
+                minY = std::min<double>(minY, std::min<double>(a[1], a[3]));
+                maxY = std::max<double>(maxY, std::max<double>(a[1], a[3]));
+            }
+        }
+        int numEdges = int(edges.size() / 4);
+        if (!numEdges)
+            return;
+
+    //    About one band per edge, fewer if tall edges would be listed in too many bands
+        int numBands = std::min<int>(numEdges, 1 << 16);
+        for ( ; ; numBands /= 2)
+        {
+            bandHeight = (maxY > minY) ? (maxY - minY) / numBands : 1;
+            bandStart.assign(numBands + 1, 0);
+            size_t total = 0;
+            for (int i = 0; i < numEdges; i++)
+            {
+                const double* edge = &edges[i * 4];
+                int first, last;
+                getBands(std::min<double>(edge[1], edge[3]), std::max<double>(edge[1], edge[3]), first, last);
+                total += last - first + 1;
+            }
+            if ((numBands == 1) || (total <= size_t(numEdges) * 16))
+                break;
+        }
+
+        for (int i = 0; i < numEdges; i++)
+        {
+            const double* edge = &edges[i * 4];
+            int first, last;
+            getBands(std::min<double>(edge[1], edge[3]), std::max<double>(edge[1], edge[3]), first, last);
+            for (int b = first; b <= last; b++)
+                bandStart[b + 1]++;
+        }
+        for (int b = 0; b < numBands; b++)
+            bandStart[b + 1] += bandStart[b];
+        bandEdges.resize(bandStart[numBands]);
+        std::vector<int> next(bandStart.begin(), bandStart.end() - 1);
+        for (int i = 0; i < numEdges; i++)
+        {
+            const double* edge = &edges[i * 4];
+            int first, last;
+            getBands(std::min<double>(edge[1], edge[3]), std::max<double>(edge[1], edge[3]), first, last);
+            for (int b = first; b <= last; b++)
+                bandEdges[next[b]++] = i;
+        }
+    }
+
+    void PreparedPolygon::getBands(double y0, double y1, int& first, int& last) const
+    {
+        int numBands = int(bandStart.size()) - 1;
+        double f = (y0 - minY) / bandHeight;
+        double l = (y1 - minY) / bandHeight;
+        first = (f <= 0) ? 0 : int(std::min<double>(f, numBands - 1));
+        last = (l <= 0) ? 0 : int(std::min<double>(l, numBands - 1));
+    }
+
+    Location PreparedPolygon::locate(double x, double y) const
+    {
+        const double e = SFA_EPSILON;
+        if (edges.empty() || (x < minX - e) || (x > maxX + e) || (y < minY - e) || (y > maxY + e))
+            return EXTERIOR;
+
+    //    The band holding y has every edge that spans y; its neighbours within e may hold edges that only come near it
+        int first, last, band, unused;
+        getBands(y - e, y + e, first, last);
+        getBands(y, y, band, unused);
+        bool inside = false;
+        for (int b = first; b <= last; b++)
+        {
+            for (int j = bandStart[b], c = bandStart[b + 1]; j < c; j++)
+            {
+                const double* edge = &edges[bandEdges[j] * 4];
+                if (NearSegment(x, y, edge[0], edge[1], edge[2], edge[3], e))
+                    return BOUNDARY;
+                if ((b == band) && ((edge[1] > y) != (edge[3] > y)) && (x < edge[0] + (y - edge[1]) * (edge[2] - edge[0]) / (edge[3] - edge[1])))
+                    inside = !inside;
+            }
+        }
+        return inside ? INTERIOR : EXTERIOR;
+    }
+
+    Location PreparedPolygon::locate(const Point* point) const
+    {
+        return locate(point->X(), point->Y());
+    }
+
+    PreparedPolygon::SegmentRelation PreparedPolygon::relateSegment(double ax, double ay, double bx, double by) const
+    {
+        const double e = SFA_EPSILON;
+        if (edges.empty())
+            return SEGMENT_DISJOINT;
+        double segment[4] = { ax, ay, bx, by };
+        double sMinX = std::min<double>(ax, bx) - e;
+        double sMaxX = std::max<double>(ax, bx) + e;
+        double sMinY = std::min<double>(ay, by) - e;
+        double sMaxY = std::max<double>(ay, by) + e;
+        if ((sMaxX < minX) || (sMinX > maxX) || (sMaxY < minY) || (sMinY > maxY))
+            return SEGMENT_DISJOINT;
+
+        SegmentRelation result = SEGMENT_DISJOINT;
+        int first, last;
+        getBands(sMinY, sMaxY, first, last);
+        for (int b = first; b <= last; b++)
+        {
+            for (int j = bandStart[b], c = bandStart[b + 1]; j < c; j++)
+            {
+                const double* edge = &edges[bandEdges[j] * 4];
+                if ((std::max<double>(edge[0], edge[2]) < sMinX) || (std::min<double>(edge[0], edge[2]) > sMaxX)
+                    || (std::max<double>(edge[1], edge[3]) < sMinY) || (std::min<double>(edge[1], edge[3]) > sMaxY))
+                    continue;
+                int relation = RelateSegments(segment, edge, e);
+                if (relation == SEGMENT_CROSSES)
+                    return SEGMENT_CROSSES;
+                if (relation == SEGMENT_TOUCHES)
+                    result = SEGMENT_TOUCHES;
+            }
+        }
+        return result;
+    }
+
+    bool PreparedPolygon::contains(const Geometry* other) const
+    {
+        if (!polygon || !other)
+            return false;
+        if (edges.empty() || other->isEmpty())
+            return polygon->contains(other);
+
+        const Point* point = dynamic_cast<const Point*>(other);
+        if (point)
+        {
+            Location loc = locate(point);
+            if (loc == BOUNDARY)
+                return polygon->contains(other);
+            return (loc == INTERIOR);
+        }
+
+        const Polygon* area = dynamic_cast<const Polygon*>(other);
+        if (!area || (area->getNumInteriorRing() > 0))
+            return polygon->contains(other);
+
+        const double e = SFA_EPSILON;
+        CoordinateSequence ring(area->getExteriorRing(), false, false);
+        double rMinX, rMinY, rMaxX, rMaxY;
+        if ((ring.getNumPoints() < 4) || !ring.isClosed() || !ring.getEnvelope(rMinX, rMinY, rMaxX, rMaxY))
+            return polygon->contains(other);
+        if ((rMinX < minX - e) || (rMaxX > maxX + e) || (rMinY < minY - e) || (rMaxY > maxY + e))
+            return false;
+        if (std::abs(GetRingArea(ring)) <= e * e)
+            return polygon->contains(other);
+
+    /*
+        The ring is inside the polygon if its vertices are and no polygon edge crosses it or has a vertex inside it. Anything that
+        comes within SFA_EPSILON of the other boundary is left to the full relate.
+    */
+        bool touches = false;
+        const double* a = ring.data();
+        for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, a += 2)
+        {
+            Location loc = locate(a[0], a[1]);
+            if (loc == EXTERIOR)
+                return false;
+            if (loc == BOUNDARY)
+                touches = true;
+        }
+        a = ring.data();
+        for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, a += 2)
+        {
+            SegmentRelation relation = relateSegment(a[0], a[1], a[2], a[3]);
+            if (relation == SEGMENT_CROSSES)
+                return false;
+            if (relation == SEGMENT_TOUCHES)
+                touches = true;
+        }
+        int first, last;
+        getBands(rMinY - e, rMaxY + e, first, last);
+        for (int b = first; b <= last; b++)
+        {
+            for (int j = bandStart[b], c = bandStart[b + 1]; j < c; j++)
+            {
+                const double* edge = &edges[bandEdges[j] * 4];
+                if ((edge[0] < rMinX - e) || (edge[0] > rMaxX + e) || (edge[1] < rMinY - e) || (edge[1] > rMaxY + e))
+                    continue;
+                Location loc = LocateInRing(edge[0], edge[1], ring, e);
+                if (loc == INTERIOR)
+                    return false;
+                if (loc == BOUNDARY)
+                    touches = true;
+            }
+        }
+        return touches ? polygon->contains(other) : true;
+    }
+
+}
@@ -0,0 +1,522 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#include "sfa/RectangleClipper.h"
+#include "sfa/Point.h"
+#include "sfa/LineString.h"
+#include "sfa/Polygon.h"
+#include "sfa/MultiPoint.h"
+#include "sfa/MultiLineString.h"
+#include "sfa/MultiPolygon.h"
+#include "sfa/GeometryCollection.h"
+#include "sfa/RingMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sfa {
+
+    namespace
+    {
+        struct Vertex
+        {
+            double x;
+            double y;
+            double z;
+            double m;
+        };
+
+        typedef std::vector<Vertex> VertexList;
+
+        struct Rectangle
+        {
+            double xmin;
+            double xmax;
+            double ymin;
+            double ymax;
+            bool hasZ;
+            bool hasM;
+        };
+
+        Vertex interpolate(const Vertex& a, const Vertex& b, double t)
+        {
+            return Vertex { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.m + (b.m - a.m) * t };
+        }
+
+        void getVertices(const LineString* linestring, VertexList& vertices)
+        {
+            vertices.clear();
+            int count = linestring->getNumPoints();
+            vertices.reserve(count);
+            for(int i = 0; i < count; ++i)
+            {
+                Point* p = linestring->getPointN(i);
+                vertices.push_back(Vertex { p->X(), p->Y(), p->Z(), p->M() });
+            }
+        }
+
+        Point toPoint(const Rectangle& rect, const Vertex& v)
+        {
+            Point p(v.x, v.y);
+            if(rect.hasZ)
+                p.setZ(v.z);
+            if(rect.hasM)
+                p.setM(v.m);
+            return p;
+        }
+
+        LineString* toLineString(const Rectangle& rect, const VertexList& vertices)
+        {
+            LineString* result = new LineString;
+            for(const Vertex& v : vertices)
+                result->addPoint(toPoint(rect, v));
+            return result;
+        }
+
+        bool contains(const Rectangle& rect, double x, double y)
+        {
+            return (x >= rect.xmin) && (x <= rect.xmax) && (y >= rect.ymin) && (y <= rect.ymax);
+        }
+
+        // 0 if the vertices are outside the rectangle, 1 if they are all inside, -1 if they straddle it
+        int classify(const Rectangle& rect, const VertexList& vertices)
+        {
+            if(vertices.empty())
+                return 0;
+            double xmin = vertices[0].x, xmax = xmin, ymin = vertices[0].y, ymax = ymin;
+            for(const Vertex& v : vertices)
+            {
+                xmin = std::min(xmin, v.x);
+                xmax = std::max(xmax, v.x);
+                ymin = std::min(ymin, v.y);
+                ymax = std::max(ymax, v.y);
+            }
+            if((xmin > rect.xmax) || (xmax < rect.xmin) || (ymin > rect.ymax) || (ymax < rect.ymin))
+                return 0;
+            if((xmin >= rect.xmin) && (xmax <= rect.xmax) && (ymin >= rect.ymin) && (ymax <= rect.ymax))
+                return 1;
+            return -1;
+        }
+
+        // Liang-Barsky test for one boundary, p * t <= q
+        bool clipTest(double p, double q, double& t0, double& t1)
+        {
+            if(p == 0)
+                return q >= 0;
+            double t = q / p;
+            if(p < 0)
+            {
+                if(t > t1)
+                    return false;
+                if(t > t0)
+                    t0 = t;
+            }
+            else
+            {
+                if(t < t0)
+                    return false;
+                if(t < t1)
+                    t1 = t;
+            }
+            return true;
+        }
+
+        Vertex clampVertex(const Rectangle& rect, Vertex v)
+        {
+            v.x = std::min(std::max(v.x, rect.xmin), rect.xmax);
+            v.y = std::min(std::max(v.y, rect.ymin), rect.ymax);
+            return v;
+        }
+
+        void finishPart(VertexList& part, std::vector<VertexList>& parts)
+        {
+            if(part.size() >= 2)
+                parts.push_back(part);
+            part.clear();
+        }
+
+        void appendVertex(VertexList& part, const Vertex& v)
+        {
+            if(part.empty() || (part.back().x != v.x) || (part.back().y != v.y))
+                part.push_back(v);
+        }
+
+        void clipLine(const Rectangle& rect, const VertexList& vertices, std::vector<VertexList>& parts)
+        {
+            if(vertices.size() == 1)
+                return;
+            VertexList part;
+            for(size_t i = 1, c = vertices.size(); i < c; ++i)
+            {
+                const Vertex& a = vertices[i - 1];
+                const Vertex& b = vertices[i];
+                double dx = b.x - a.x;
+                double dy = b.y - a.y;
+                double t0 = 0.0;
+                double t1 = 1.0;
+                if(!clipTest(-dx, a.x - rect.xmin, t0, t1) || !clipTest(dx, rect.xmax - a.x, t0, t1)
+                    || !clipTest(-dy, a.y - rect.ymin, t0, t1) || !clipTest(dy, rect.ymax - a.y, t0, t1))
+                {
+                    finishPart(part, parts);
+                    continue;
+                }
+                if(part.empty() || (t0 > 0.0))
+                {
+                    finishPart(part, parts);
+                    part.push_back((t0 > 0.0) ? clampVertex(rect, interpolate(a, b, t0)) : a);
+                }
+                appendVertex(part, (t1 < 1.0) ? clampVertex(rect, interpolate(a, b, t1)) : b);
+                if(t1 < 1.0)
+                    finishPart(part, parts);
+            }
+            finishPart(part, parts);
+        }
+
+        // One Sutherland-Hodgman pass; the ring is open (no repeated closing vertex).
+        template <typename Inside, typename Intersect>
+        void clipRingEdge(const VertexList& input, VertexList& output, Inside inside, Intersect intersect)
+        {
+            output.clear();
+            if(input.empty())
+                return;
+            Vertex prev = input.back();
+            bool prev_inside = inside(prev);
+            for(const Vertex& v : input)
+            {
+                bool v_inside = inside(v);
+                if(v_inside != prev_inside)
+                    output.push_back(intersect(prev, v));
+                if(v_inside)
+                    output.push_back(v);
+                prev = v;
+                prev_inside = v_inside;
+            }
+        }
+
+        // True if two edges along the same side of the rectangle overlap. This is how
+        // Sutherland-Hodgman joins pieces of a ring that crosses the rectangle more than once.
+        bool hasOverlappingBoundaryEdges(const Rectangle& rect, const VertexList& ring)
+        {
+            std::vector<std::pair<double, double>> sides[4];
+            for(size_t i = 0, c = ring.size(); i < c; ++i)
+            {
+                const Vertex& p = ring[i];
+                const Vertex& q = ring[(i + 1) % c];
+                if((p.x == q.x) && ((p.x == rect.xmin) || (p.x == rect.xmax)) && (p.y != q.y))
+                    sides[(p.x == rect.xmin) ? 0 : 1].push_back(std::make_pair(std::min(p.y, q.y), std::max(p.y, q.y)));
+                else if((p.y == q.y) && ((p.y == rect.ymin) || (p.y == rect.ymax)) && (p.x != q.x))
+                    sides[(p.y == rect.ymin) ? 2 : 3].push_back(std::make_pair(std::min(p.x, q.x), std::max(p.x, q.x)));
+            }
+            for(auto& side : sides)
+            {
+                std::sort(side.begin(), side.end());
+                for(size_t i = 1, c = side.size(); i < c; ++i)
+                {
+                    if(side[i].first < side[i - 1].second)
+                        return true;
+                    side[i].second = std::max(side[i].second, side[i - 1].second);
+                }
+            }
+            return false;
+        }
+
+        // clipped is set if the ring crossed the rectangle and something is left of it;
+        // joined is set if what is left is several pieces joined along the boundary.
+        LineString* clipRing(const Rectangle& rect, const LineString* ring, bool& clipped, bool& joined)
+        {
+            clipped = false;
+            joined = false;
+            VertexList a, b;
+            getVertices(ring, a);
+            int state = classify(rect, a);
+            if(state == 0)
+                return NULL;
+            if(state == 1)
+                return new LineString(ring);
+
+            if((a.size() > 1) && (a.front().x == a.back().x) && (a.front().y == a.back().y))
+                a.pop_back();
+
+            clipRingEdge(a, b, [&](const Vertex& v) { return v.x >= rect.xmin; }, [&](const Vertex& p, const Vertex& q)
+                {
+                    Vertex v = interpolate(p, q, (rect.xmin - p.x) / (q.x - p.x));
+                    v.x = rect.xmin;
+                    return v;
+                });
+            clipRingEdge(b, a, [&](const Vertex& v) { return v.x <= rect.xmax; }, [&](const Vertex& p, const Vertex& q)
+                {
+                    Vertex v = interpolate(p, q, (rect.xmax - p.x) / (q.x - p.x));
+                    v.x = rect.xmax;
+                    return v;
+                });
+            clipRingEdge(a, b, [&](const Vertex& v) { return v.y >= rect.ymin; }, [&](const Vertex& p, const Vertex& q)
+                {
+                    Vertex v = interpolate(p, q, (rect.ymin - p.y) / (q.y - p.y));
+                    v.y = rect.ymin;
+                    return v;
+                });
+            clipRingEdge(b, a, [&](const Vertex& v) { return v.y <= rect.ymax; }, [&](const Vertex& p, const Vertex& q)
+                {
+                    Vertex v = interpolate(p, q, (rect.ymax - p.y) / (q.y - p.y));
+                    v.y = rect.ymax;
+                    return v;
+                });
+
+            b.clear();
+            for(const Vertex& v : a)
+                appendVertex(b, v);
+            while((b.size() > 1) && (b.front().x == b.back().x) && (b.front().y == b.back().y))
+                b.pop_back();
+            if(b.size() < 3)
+                return NULL;
+
+            // A ring that only touched the rectangle collapses onto its boundary.
+            double area = 0.0;
+            for(size_t i = 0, c = b.size(); i < c; ++i)
+            {
+                const Vertex& p = b[i];
+                const Vertex& q = b[(i + 1) % c];
+                area += (p.x * q.y) - (q.x * p.y);
+            }
+            if(area == 0.0)
+                return NULL;
+
+            clipped = true;
+            joined = hasOverlappingBoundaryEdges(rect, b);
+            b.push_back(b.front());
+            return toLineString(rect, b);
+        }
+
+        Geometry* intersectRectangle(const Rectangle& rect, const Geometry* geometry)
+        {
+            LineString* ring = new LineString;
+            ring->addPoint(Point(rect.xmin, rect.ymin));
+            ring->addPoint(Point(rect.xmax, rect.ymin));
+            ring->addPoint(Point(rect.xmax, rect.ymax));
+            ring->addPoint(Point(rect.xmin, rect.ymax));
+            ring->addPoint(Point(rect.xmin, rect.ymin));
+            Polygon box;
+            box.addRing(ring);
+            Geometry* result = box.intersection(geometry);
+            if(result && result->isEmpty())
+            {
+                delete result;
+                result = NULL;
+            }
+            return result;
+        }
+
+        Polygon* toPolygon(const Rectangle& rect, const Polygon* polygon)
+        {
+            Polygon* result = new Polygon;
+            VertexList vertices;
+            getVertices(polygon->getExteriorRing(), vertices);
+            result->addRing(toLineString(rect, vertices));
+            for(int i = 0, c = polygon->getNumInteriorRing(); i < c; ++i)
+            {
+                getVertices(polygon->getInteriorRingN(i), vertices);
+                result->addRing(toLineString(rect, vertices));
+            }
+            return result;
+        }
+
+        // Exact clip for the polygons Sutherland-Hodgman can't represent. intersection() expects
+        // CCW exteriors and CW holes, so it gets a corrected copy; only the polygons of its result
+        // are kept, with the dimensions of the input.
+        Geometry* splitPolygon(const Rectangle& rect, const Polygon* polygon)
+        {
+            Polygon corrected(polygon);
+            CorrectPolygon(corrected);
+            Geometry* overlay = intersectRectangle(rect, &corrected);
+            if(!overlay)
+                return NULL;
+            std::vector<Polygon*> pieces;
+            if(overlay->getWKBGeometryType() == wkbPolygon)
+                pieces.push_back(toPolygon(rect, static_cast<Polygon*>(overlay)));
+            GeometryCollection* collection = dynamic_cast<GeometryCollection*>(overlay);
+            for(int i = 1, c = collection ? collection->getNumGeometries() : 0; i <= c; ++i)
+            {
+                Geometry* part = collection->getGeometryN(i);
+                if(part->getWKBGeometryType() == wkbPolygon)
+                    pieces.push_back(toPolygon(rect, static_cast<Polygon*>(part)));
+            }
+            delete overlay;
+            if(pieces.size() < 2)
+                return pieces.empty() ? NULL : pieces.front();
+            MultiPolygon* result = new MultiPolygon;
+            for(Polygon* piece : pieces)
+                result->addGeometry(piece);
+            return result;
+        }
+
+        // A Polygon, or a MultiPolygon when the polygon falls apart into several pieces.
+        // Those, and polygons with a hole crossing the rectangle (which would leave the hole
+        // touching the exterior along the boundary), are rare enough to go through splitPolygon().
+        Geometry* clipPolygon(const Rectangle& rect, const Polygon* polygon)
+        {
+            LineString* exterior = polygon->getExteriorRing();
+            if(!exterior)
+                return NULL;
+            bool clipped = false;
+            bool joined = false;
+            LineString* ring = clipRing(rect, exterior, clipped, joined);
+            if(!ring)
+                return NULL;
+            Polygon* result = new Polygon;
+            result->addRing(ring);
+            if(joined)
+            {
+                delete result;
+                return splitPolygon(rect, polygon);
+            }
+            for(int i = 0, c = polygon->getNumInteriorRing(); i < c; ++i)
+            {
+                ring = clipRing(rect, polygon->getInteriorRingN(i), clipped, joined);
+                if(ring)
+                    result->addRing(ring);
+                if(clipped)
+                {
+                    delete result;
+                    return splitPolygon(rect, polygon);
+                }
+            }
+            return result;
+        }
+
+        void clipLineString(const Rectangle& rect, const LineString* linestring, std::vector<VertexList>& parts)
+        {
+            VertexList vertices;
+            getVertices(linestring, vertices);
+            int state = classify(rect, vertices);
+            if(state == 1)
+                parts.push_back(vertices);
+            else if(state == -1)
+                clipLine(rect, vertices, parts);
+        }
+
+        Geometry* clip(const Rectangle& rect, const Geometry* geometry)
+        {
+            switch(geometry->getWKBGeometryType())
+            {
+                case wkbPoint:
+                {
+                    const Point* point = static_cast<const Point*>(geometry);
+                    return contains(rect, point->X(), point->Y()) ? new Point(point) : NULL;
+                }
+                case wkbMultiPoint:
+                {
+                    const MultiPoint* multipoint = static_cast<const MultiPoint*>(geometry);
+                    MultiPoint* result = new MultiPoint;
+                    for(int i = 1, c = multipoint->getNumGeometries(); i <= c; ++i)
+                    {
+                        const Point* point = static_cast<const Point*>(multipoint->getGeometryN(i));
+                        if(contains(rect, point->X(), point->Y()))
+                            result->addGeometry(new Point(point));
+                    }
+                    if(result->getNumGeometries() > 0)
+                        return result;
+                    delete result;
+                    return NULL;
+                }
+                case wkbLineString:
+                {
+                    std::vector<VertexList> parts;
+                    clipLineString(rect, static_cast<const LineString*>(geometry), parts);
+                    if(parts.empty())
+                        return NULL;
+                    if(parts.size() == 1)
+                        return toLineString(rect, parts.front());
+                    MultiLineString* result = new MultiLineString;
+                    for(const VertexList& part : parts)
+                        result->addGeometry(toLineString(rect, part));
+                    return result;
+                }
+                case wkbMultiLineString:
+                {
+                    const MultiLineString* multilinestring = static_cast<const MultiLineString*>(geometry);
+                    std::vector<VertexList> parts;
+                    for(int i = 1, c = multilinestring->getNumGeometries(); i <= c; ++i)
+                        clipLineString(rect, static_cast<const LineString*>(multilinestring->getGeometryN(i)), parts);
+                    if(parts.empty())
+                        return NULL;
+                    MultiLineString* result = new MultiLineString;
+                    for(const VertexList& part : parts)
+                        result->addGeometry(toLineString(rect, part));
+                    return result;
+                }
+                case wkbPolygon:
+                    return clipPolygon(rect, static_cast<const Polygon*>(geometry));
+                case wkbMultiPolygon:
+                {
+                    const MultiPolygon* multipolygon = static_cast<const MultiPolygon*>(geometry);
+                    MultiPolygon* result = new MultiPolygon;
+                    for(int i = 1, c = multipolygon->getNumGeometries(); i <= c; ++i)
+                    {
+                        Geometry* part = clipPolygon(rect, static_cast<const Polygon*>(multipolygon->getGeometryN(i)));
+                        if(!part)
+                            continue;
+                        if(part->getWKBGeometryType(false, false) == wkbPolygon)
+                        {
+                            result->addGeometry(part);
+                            continue;
+                        }
+                        MultiPolygon* pieces = dynamic_cast<MultiPolygon*>(part);
+                        for(int j = 1, d = pieces ? pieces->getNumGeometries() : 0; j <= d; ++j)
+                            result->addGeometry(pieces->getGeometryN(j)->copy());
+                        delete part;
+                    }
+                    if(result->getNumGeometries() > 0)
+                        return result;
+                    delete result;
+                    return NULL;
+                }
+                case wkbGeometryCollection:
+                {
+                    const GeometryCollection* collection = static_cast<const GeometryCollection*>(geometry);
+                    GeometryCollection* result = new GeometryCollection;
+                    for(int i = 1, c = collection->getNumGeometries(); i <= c; ++i)
+                    {
+                        Geometry* part = clip(rect, collection->getGeometryN(i));
+                        if(part)
+                            result->addGeometry(part);
+                    }
+                    if(result->getNumGeometries() > 0)
+                        return result;
+                    delete result;
+                    return NULL;
+                }
+                default:
+                    break;
+            }
+            return intersectRectangle(rect, geometry);
+        }
+    }
+
+    Geometry* clipToRectangle(const Geometry* geometry, double xmin, double xmax, double ymin, double ymax)
+    {
+        if(!geometry || geometry->isEmpty())
+            return NULL;
+        Rectangle rect { xmin, xmax, ymin, ymax, geometry->is3D(), geometry->isMeasured() };
+        return clip(rect, geometry);
+    }
+
+}
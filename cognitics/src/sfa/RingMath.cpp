@@ -31,10 +31,18 @@ namespace sfa {
 
     double GetRingArea(const LineString* ring)
     {
-        if(!ring || !ring->isClosed()) return 0;
+        if(!ring) return 0;
+        return GetRingArea(CoordinateSequence(ring, false, false));
+    }
+
+    double GetRingArea(const CoordinateSequence& ring)
+    {
+        if(!ring.isClosed()) return 0;
+        const double* p = ring.data();
+        const int stride = ring.getStride();
         double area = 0;
-        for (int i = 0; i < ring->getNumPoints() - 1; i++)
-            area += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*(ring->getPointN(i)->Y() - ring->getPointN(i+1)->Y());
+        for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, p += stride)
+            area += (p[0] + p[stride])*(p[1] - p[stride + 1]);
         return -area*0.5;
     }
 
@@ -50,17 +58,33 @@ namespace sfa {
     Centroid Algorithms
 ****************************************************************************/
 
+    namespace
+    {
+        //    Adds the centroid contribution of each edge of the ring, before dividing by six times the area.
+        void AddRingCentroid(const CoordinateSequence& ring, double& x, double& y)
+        {
+            const double* p = ring.data();
+            const int stride = ring.getStride();
+            for (int i = 0, c = ring.getNumPoints() - 1; i < c; i++, p += stride)
+            {
+                double b = p[0]*p[stride + 1] - p[1]*p[stride];
+                x += (p[0] + p[stride])*b;
+                y += (p[1] + p[stride + 1])*b;
+            }
+        }
+    }
+
     Point GetRingCentroid(const LineString* ring)
+    {
+        return GetRingCentroid(CoordinateSequence(ring, false, false));
+    }
+
+    Point GetRingCentroid(const CoordinateSequence& ring)
     {
         double x = 0;
         double y = 0;
 
-        for (int i = 0; i < ring->getNumPoints() - 1; i++)
-        {
-            double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-            x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-            y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-        }
+        AddRingCentroid(ring, x, y);
 
         double area = GetRingArea(ring);
         x /= 6*area;
@@ -74,30 +98,17 @@ namespace sfa {
         double    x = 0;
         double    y = 0;
 
-    //    Add contribution of exterior ring
-        LineString* ring = polygon->getExteriorRing();
-
-        for (int i = 0; i < ring->getNumPoints() - 1; i++)
-        {
-            double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-            x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-            y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-        }
-
-    //    Add contribution of interior rings
-        for (int j = 0; j < polygon->getNumInteriorRing(); j++)
+    //    Add contribution of exterior and interior rings
+        CoordinateSequenceList rings;
+        GetPolygonCoordinates(polygon, rings);
+        double area = 0;
+        for (size_t j = 0; j < rings.size(); j++)
         {
-            ring = polygon->getInteriorRingN(j);
-            for (int i = 0; i < ring->getNumPoints() - 1; i++)
-            {
-                double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-                x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-                y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-            }
+            AddRingCentroid(rings[j], x, y);
+            area += GetRingArea(rings[j]);
         }
 
     //    Factor in area
-        double area = GetPolygonArea(polygon);
         x /= 6*area;
         y /= 6*area;
 
@@ -183,29 +194,34 @@ namespace sfa {
     Point Location Algorithms
 ****************************************************************************/
 
-    bool UpdateCount(const Point& point, const LineString& ring, int& Rcross, int& Lcross)
+    bool UpdateCount(const Point& point, const CoordinateSequence& ring, int& Rcross, int& Lcross)
     {
-        for (int i = 1; i < ring.getNumPoints(); i++)
+        const double px = point.X();
+        const double height = point.Y();
+        const double* p = ring.data();
+        const int stride = ring.getStride();
+        for (int i = 1, c = ring.getNumPoints(); i < c; i++, p += stride)
         {
-            Point p1 = *(ring.getPointN(i-1));
-            Point p2 = *(ring.getPointN(i));
+            const double x1 = p[0], y1 = p[1];
+            const double x2 = p[stride], y2 = p[stride + 1];
 
-            if (point.equals(&p1)) return true;
+            double dx = px - x1;
+            double dy = height - y1;
+            if (dx*dx + dy*dy < SFA_EPSILON*SFA_EPSILON) return true;
 
-            double    height = point.Y();
             double    x;
             double    Rstrad;
             double    Lstrad;
 
             //Rstrad is false if the point only touches ray, but is mostly below it                
             //Lstrad is false if the point only touches ray, but is mostly above it
-            Rstrad = ( p2.Y() > height - SFA_EPSILON ) != ( p1.Y() > height - SFA_EPSILON );                
-            Lstrad = ( p2.Y() < height + SFA_EPSILON ) != ( p1.Y() < height + SFA_EPSILON );
+            Rstrad = ( y2 > height - SFA_EPSILON ) != ( y1 > height - SFA_EPSILON );                
+            Lstrad = ( y2 < height + SFA_EPSILON ) != ( y1 < height + SFA_EPSILON );
 
             if (Rstrad || Lstrad)
             {
-                x = ( (p2.X()-point.X())*(p1.Y()-height) - (p1.X()-point.X())*(p2.Y()-height) ) 
-                    / ( p1.Y() - p2.Y() );
+                x = ( (x2-px)*(y1-height) - (x1-px)*(y2-height) ) 
+                    / ( y1 - y2 );
                 if ( Rstrad && x > SFA_EPSILON ) Rcross++;
                 if ( Lstrad && x < -SFA_EPSILON ) Lcross++;
                 if (abs(x) < SFA_EPSILON)
@@ -222,6 +238,11 @@ namespace sfa {
     }
 
     bool PointInRing(const Point& point, const LineString& ring)
+    {
+        return PointInRing(point, CoordinateSequence(&ring, false, false));
+    }
+
+    bool PointInRing(const Point& point, const CoordinateSequence& ring)
     {
         int Rcross = 0;
         int Lcross = 0;
@@ -240,18 +261,26 @@ namespace sfa {
     }
 
     bool PointInPolygon(const Point& point, const Polygon& polygon)
+    {
+        if(polygon.getExteriorRing() == NULL)
+            return false;
+
+        CoordinateSequenceList rings;
+        GetPolygonCoordinates(&polygon, rings);
+        return PointInPolygon(point, rings);
+    }
+
+    bool PointInPolygon(const Point& point, const CoordinateSequenceList& rings)
     {
         int Rcross = 0;
         int Lcross = 0;
         
-        if(polygon.getExteriorRing() == NULL)
+        if(rings.empty())
             return false;
 
-        if (UpdateCount(point,*(polygon.getExteriorRing()),Rcross,Lcross)) return true;
-
-        for (int j = 0; j < polygon.getNumInteriorRing(); j++)
+        for (size_t j = 0; j < rings.size(); j++)
         {
-            if (UpdateCount(point,*(polygon.getInteriorRingN(j)),Rcross,Lcross)) return true;
+            if (UpdateCount(point,rings[j],Rcross,Lcross)) return true;
         }
 
     //check cross countings to determine intersection
@@ -260,4 +289,4 @@ namespace sfa {
         else                                    return false;
     }
 
-}
\ No newline at end of file
+}
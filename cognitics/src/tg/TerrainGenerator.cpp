@@ -929,112 +929,23 @@ namespace cognitics
 
         ExportFeaturesMetaData();
 
-        ctl::PointList boundaryPoints;
-        {
-            sfa::LineString boundaryLineString;
-            // Left boundary
-            int col = 0;
-            double lon = west;
-            double localPostX = flatEarth.convertGeoToLocalX(lon);
-            for (int row = 0; row < height; row++)
-            {   // Go from pixel space to geo
-                double lat = (row * spacingY) + north;
-                // Go from geo to local                
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, grid[(row*width)+col]));
-            }
-            // Right boundary
-            col = width - 1;
-            lon = east;
-            localPostX = flatEarth.convertGeoToLocalX(lon);
-            for (int row = 0; row < height; row++)
-            {   // Go from pixel space to geo
-                double lat = (row * spacingY) + north;
-                // Go from geo to local
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, grid[(row*width) + col]));
-            }
-            // Bottom boundary
-            double lat = south;
-            double localPostY = flatEarth.convertGeoToLocalY(lat);
-            for (int col = 0; col < width; col++)
-            {   // Go from pixel space to geo
-                double lon = (col * spacingX) + west;
-                // Go from geo to local
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, grid[(width*(height-1)) + col]));
-            }
-            // Top boundary
-            lat = north;
-            localPostY = flatEarth.convertGeoToLocalY(lat);
-            for (int col = 0; col < width; col++)
-            {   // Go from pixel space to geo
-                double lon = (col * spacingX) + west;
-                // Go from geo to local
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, grid[col]));
-            }
-
-//            boundaryLineString.removeColinearPoints(0, 0.5);
-            for (int i = 0, c = boundaryLineString.getNumPoints(); i < c; ++i)
-            {
-                sfa::Point *p = boundaryLineString.getPointN(i);
-                boundaryPoints.push_back(ctl::Point(p->X(), p->Y(), p->Z()));
-            }
-        }
-
 		if (format == ".obj" || format == "obj")
 		{
             BuildFromTriangulation(outputName, width, height, spacingX, spacingY, localWidth, localHeight, grid);
 			return;
 		}
 
-        ctl::PointList workingPoints;
-
-        int delaunayResizeIncrement = 100;
-        {
-            for (int row = 1; row < height-2; ++row)
-            {
-                printf("");
-                for (int col = 1; col < width-2; ++col)
-                {
-                    // Go from pixel space to geo
-                    double lat = (row * spacingY) + north;
-                    double lon = (col * spacingX) + west;
-                    // Go from geo to local
-                    double localPostX = flatEarth.convertGeoToLocalX(lon);
-                    double localPostY = flatEarth.convertGeoToLocalY(lat);
-                    workingPoints.push_back(ctl::Point(localPostX, localPostY, grid[(row*width) + col]));
-                }
-            }
-
-            delaunayResizeIncrement = (height * width) / 8;
-        }
-
-        // TODO: Allocate this based on a polygon budget
-        ctl::DelaunayTriangulation *dt = new ctl::DelaunayTriangulation(gamingArea, delaunayResizeIncrement);
-
-        //Randomly the order of point insertions to avoid worst case performance of DelaunayTriangulation
-        std::random_shuffle(boundaryPoints.begin(), boundaryPoints.end());
-        std::random_shuffle(workingPoints.begin(), workingPoints.end());
-
-        {
-            //Alternate inserting boundary and working points to avoid worst case performance of DelaunayTriangulation
-            size_t i = 0;
-            size_t j = 0;
-            while (i < boundaryPoints.size() || j < workingPoints.size())
-            {
-                if (i < boundaryPoints.size())
-                    dt->InsertConstrainedPoint(boundaryPoints[i++]);
-                if (j < workingPoints.size())
-                    dt->InsertWorkingPoint(workingPoints[j++]);
-            }
-        }
-
-        //dt->Simplify(1, float(0.05));    // simplify based on coplanar points
-        //dt->Simplify(20000, 0.5);        // if we still have over 20k triangles, simplify using the triangle budget
-
-        ctl::TIN *tin = new ctl::TIN(dt);
+        // The last row and column are pinned to the MBR edges
+        std::vector<double> postsX(width);
+        for (int col = 0; col < width - 1; ++col)
+            postsX[col] = flatEarth.convertGeoToLocalX((col * spacingX) + west);
+        postsX[width - 1] = flatEarth.convertGeoToLocalX(east);
+        std::vector<double> postsY(height);
+        for (int row = 0; row < height - 1; ++row)
+            postsY[row] = flatEarth.convertGeoToLocalY((row * spacingY) + north);
+        postsY[height - 1] = flatEarth.convertGeoToLocalY(south);
+
+        ctl::TIN *tin = triangulateTerrain(ctl::GridTIN(postsX, postsY, grid), gamingArea, std::vector<ctl::PointList>(), 0);
         scenegraph::Scene *scene = new scenegraph::Scene;
         scene->faces.reserve(tin->triangles.size() / 3);
         for (size_t i = 0, c = tin->triangles.size() / 3; i < c; ++i)
@@ -1099,7 +1010,6 @@ namespace cognitics
         master.externalReferences.push_back(ext);
 
 		delete tin;
-        delete dt;
     }
 
     void TerrainGenerator::generateFixedGrid(const std::string &imgFile, const std::string &outputPath, const std::string &outputName, std::string format, elev::Elevation_DSM& edsm, double north, double south, double east, double west)
@@ -1166,8 +1076,6 @@ namespace cognitics
         double spacingX = (north - south) / nSamples;
         double spacingY = -(east - west) / nSamples;
 		
-		ctl::PointList workingPoints;
-
         sfa::Point p;
         ctl::PointList gamingArea;
         {
@@ -1194,120 +1102,38 @@ namespace cognitics
             gamingArea.push_back(northwest);
         }
 
-        ctl::PointList boundaryPoints;
+        // Posts follow the old boundary and working point layout: nSamples rows and columns from the
+        // northwest corner, plus a last row and column on the south and east edges.
+        std::vector<double> postsX(nSamples + 1);
+        std::vector<double> postsY(nSamples + 1);
+        std::vector<double> postsLon(nSamples + 1);
+        std::vector<double> postsLat(nSamples + 1);
+        for (int i = 0; i < nSamples; ++i)
         {
-            sfa::LineString boundaryLineString;
-            // Left boundary
-            int col = 0;
-            double lon = west;
-            p.setX(lon);
-            double localPostX = flatEarth.convertGeoToLocalX(lon);
-            for (int row = 0; row < nSamples; row++)
-            {   // Go from pixel space to geo
-                double lat = (row * spacingY) + north;
-                // Go from geo to local                
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
-                p.setY(lat);
-                edsm.Get(&p);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
-            }
-            // Right boundary
-            col = nSamples - 1;
-            lon = east;
-            p.setX(lon);
-            localPostX = flatEarth.convertGeoToLocalX(lon);
-            for (int row = 0; row < nSamples; row++)
-            {   // Go from pixel space to geo
-                double lat = (row * spacingY) + north;
-                // Go from geo to local
-                p.setY(lat);
-                edsm.Get(&p);
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
-            }
-            // Bottom boundary
-            double lat = south;
-            p.setY(lat);
-            double localPostY = flatEarth.convertGeoToLocalY(lat);
-            for (int col = 0; col < nSamples; col++)
-            {   // Go from pixel space to geo
-                double lon = (col * spacingX) + west;
-                // Go from geo to local
-                p.setX(lon);
-                edsm.Get(&p);
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
-            }
-            // Top boundary
-            lat = north;
-            p.setY(lat);
-            localPostY = flatEarth.convertGeoToLocalY(lat);
-            for (int col = 0; col < nSamples; col++)
-            {   // Go from pixel space to geo
-                double lon = (col * spacingX) + west;
-                // Go from geo to local
-                p.setX(lon);
-                edsm.Get(&p);
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
-                boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
-            }
-
-            //            boundaryLineString.removeColinearPoints(0, 0.5);
-            for (int i = 0, c = boundaryLineString.getNumPoints(); i < c; ++i)
-            {
-                sfa::Point *p = boundaryLineString.getPointN(i);
-                boundaryPoints.push_back(ctl::Point(p->X(), p->Y(), p->Z()));
-            }
+            postsLon[i] = (i * spacingX) + west;
+            postsLat[i] = (i * spacingY) + north;
         }
-
-
-        int delaunayResizeIncrement = 100;
+        postsLon[nSamples] = east;
+        postsLat[nSamples] = south;
+        for (int i = 0; i <= nSamples; ++i)
         {
-            for (int row = 1; row < nSamples - 2; ++row)
-            {
-                printf("");
-                for (int col = 1; col < nSamples - 2; ++col)
-                {
-                    // Go from pixel space to geo
-                    double lat = (row * spacingY) + north;
-                    double lon = (col * spacingX) + west;
-                    // Go from geo to local
-                    double localPostX = flatEarth.convertGeoToLocalX(lon);
-                    double localPostY = flatEarth.convertGeoToLocalY(lat);
-                    p.setX(lon);
-                    p.setY(lat);
-                    edsm.Get(&p);
-                    workingPoints.push_back(ctl::Point(localPostX, localPostY, p.Z()));
-                }
-            }
-
-            delaunayResizeIncrement = (nSamples * nSamples) / 8;
+            postsX[i] = flatEarth.convertGeoToLocalX(postsLon[i]);
+            postsY[i] = flatEarth.convertGeoToLocalY(postsLat[i]);
         }
-
-        // TODO: Allocate this based on a polygon budget
-        ctl::DelaunayTriangulation *dt = new ctl::DelaunayTriangulation(gamingArea, delaunayResizeIncrement);
-
-        //Randomly the order of point insertions to avoid worst case performance of DelaunayTriangulation
-        std::random_shuffle(boundaryPoints.begin(), boundaryPoints.end());
-        std::random_shuffle(workingPoints.begin(), workingPoints.end());
-
+        std::vector<double> postsZ((nSamples + 1) * (nSamples + 1));
+        for (int row = 0; row <= nSamples; ++row)
         {
-            //Alternate inserting boundary and working points to avoid worst case performance of DelaunayTriangulation
-            size_t i = 0;
-            size_t j = 0;
-            while (i < boundaryPoints.size() || j < workingPoints.size())
+            p.setY(postsLat[row]);
+            for (int col = 0; col <= nSamples; ++col)
             {
-                if (i < boundaryPoints.size())
-                    dt->InsertConstrainedPoint(boundaryPoints[i++]);
-                if (j < workingPoints.size())
-                    dt->InsertWorkingPoint(workingPoints[j++]);
+                p.setX(postsLon[col]);
+                edsm.Get(&p);
+                postsZ[(row * (nSamples + 1)) + col] = p.Z();
             }
         }
 
-        dt->Simplify(1, float(0.05));    // simplify based on coplanar points
-        //dt->Simplify(20000, 0.5);        // if we still have over 20k triangles, simplify using the triangle budget
-
-        ctl::TIN *tin = new ctl::TIN(dt);
+        // Drop posts within 5cm of the surface, as DelaunayTriangulation::Simplify(1, 0.05) did
+        ctl::TIN *tin = triangulateTerrain(ctl::GridTIN(postsX, postsY, postsZ), gamingArea, std::vector<ctl::PointList>(), 0.05);
         scenegraph::Scene *scene = new scenegraph::Scene;
         scene->faces.reserve(tin->triangles.size() / 3);
         for (size_t i = 0, c = tin->triangles.size() / 3; i < c; ++i)
@@ -1384,14 +1210,7 @@ namespace cognitics
             {
                 for (int col = 0; col < nSamples; ++col)
                 {
-                    // Go from pixel space to geo
-                    double lat = (row * spacingY) + north;
-                    double lon = (col * spacingX) + west;
-					sfa::Point p1;
-					p1.setX(lon);
-                    p1.setY(lat);
-                    edsm.Get(&p1);
-                    auto z = p1.Z();
+                    auto z = postsZ[(row * (nSamples + 1)) + col];
                     minElev = std::min(z, minElev);
                     maxElev = std::max(z, maxElev);
                 }
@@ -1415,7 +1234,6 @@ namespace cognitics
             delete scene;
         }*/
         delete tin;
-        delete dt;
 	}
 
 	/*void TerrainGenerator::generateFeatures(const std::string &featureFile, const std::string &outputName, GsBuildings *features, const std::vector<double> &grid, int spacingX, int spacingY, int width)
@@ -1669,6 +1487,60 @@ namespace cognitics
         return elevationSampler.Get(&p) ? p.Z() : 0.0f;
     }
 
+    ctl::TIN *TerrainGenerator::triangulateTerrain(const ctl::GridTIN &grid, const ctl::PointList &gamingArea, const std::vector<ctl::PointList> &constraints, double tolerance)
+    {
+        ctl::TIN *tin = new ctl::TIN;
+        if (constraints.empty())
+        {
+            grid.Triangulate(*tin, tolerance);
+            return tin;
+        }
+
+        // Constraint edges have to be cut in, so the posts go through the constrained triangulation
+        ctl::PointList boundaryPoints;
+        ctl::PointList workingPoints;
+        int rows = grid.getNumRows();
+        int cols = grid.getNumColumns();
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                bool boundary = (row == 0) || (col == 0) || (row == rows - 1) || (col == cols - 1);
+                (boundary ? boundaryPoints : workingPoints).push_back(grid.getPoint(row, col));
+            }
+        }
+
+        ctl::DelaunayTriangulation *dt = new ctl::DelaunayTriangulation(gamingArea, std::max(100, (rows * cols) / 8));
+
+        //Randomly the order of point insertions to avoid worst case performance of DelaunayTriangulation
+        std::random_shuffle(boundaryPoints.begin(), boundaryPoints.end());
+        std::random_shuffle(workingPoints.begin(), workingPoints.end());
+
+        {
+            //Alternate inserting boundary and working points to avoid worst case performance of DelaunayTriangulation
+            size_t i = 0;
+            size_t j = 0;
+            while (i < boundaryPoints.size() || j < workingPoints.size())
+            {
+                if (i < boundaryPoints.size())
+                    dt->InsertConstrainedPoint(boundaryPoints[i++]);
+                if (j < workingPoints.size())
+                    dt->InsertWorkingPoint(workingPoints[j++]);
+            }
+        }
+
+        for (size_t i = 0, c = constraints.size(); i < c; ++i)
+            dt->InsertConstrainedLineString(constraints[i]);
+
+        if (tolerance > 0)
+            dt->Simplify(1, float(tolerance));
+
+        delete tin;
+        tin = new ctl::TIN(dt);
+        delete dt;
+        return tin;
+    }
+
     void TerrainGenerator::parseFeatures(const std::string &outputPath)
     {
         //ParseCapabilities(featurePath + "capabilities.xml");